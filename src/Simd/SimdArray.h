@@ -37,25 +37,28 @@ namespace Simd
         SIMD_INLINE Array(size_t size_ = 0, bool clear = false, size_t align = SIMD_ALIGN)
             : data(0)
             , size(0)
+            , _shared(false)
         {
             Resize(size_, clear);
         }
 
         SIMD_INLINE ~Array()
         {
-            if (data)
+            if (data && !_shared)
                 Simd::Free(data);
         }
 
         SIMD_INLINE void Resize(size_t size_, bool clear = false, size_t align = SIMD_ALIGN)
         {
-            if (size_ != size)
+            if (size_ != size || _shared)
             {
                 if (data)
                 {
-                    Simd::Free(data);
+                    if (!_shared)
+                        Simd::Free(data);
                     *(T**)&data = 0;
                 }
+                _shared = false;
                 *(size_t*)&size = size_;
                 if (size_)
                     *(T**)&data = (T*)Simd::Allocate(RawSize(), align);
@@ -71,6 +74,19 @@ namespace Simd
                 memcpy(data, src, RawSize());
         }
 
+        SIMD_INLINE void Share(const T * src, size_t size_)
+        {
+            Resize(0);
+            *(T**)&data = (T*)src;
+            *(size_t*)&size = size_;
+            _shared = src != NULL;
+        }
+
+        SIMD_INLINE bool Shared() const
+        {
+            return _shared;
+        }
+
         SIMD_INLINE void Clear()
         {
             memset(data, 0, RawSize());
@@ -80,6 +96,7 @@ namespace Simd
         {
             Simd::Swap((T*&)data, (T*&)(array.data));
             Simd::Swap((size_t&)size, (size_t&)(array.size));
+            Simd::Swap((bool&)_shared, (bool&)(array._shared));
         }
 
         SIMD_INLINE T & operator[] (size_t i)
@@ -109,6 +126,9 @@ namespace Simd
             *(size_t*)&size = 0;
             return released;
         }
+
+    private:
+        bool _shared;
     };
 
     typedef Array<int8_t> Array8i;
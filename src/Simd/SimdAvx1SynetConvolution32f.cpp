@@ -348,12 +348,12 @@ namespace Simd
         SynetConvolution32fGemmNN::SynetConvolution32fGemmNN(const ConvParam32f & p)
             : Sse41::SynetConvolution32fGemmNN(p)
         {
-            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNN, "Avx"));
+            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNN, "Avx"), "Gemm32fNN");
             if (_param.trans && _param.group == 1)
             {
                 if (GemmRuntime())
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Avx::Gemm32fNNcbBufferSize, Avx::Gemm32fNNcbReorderB, Avx::Gemm32fNNcbRun, "Avx", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Avx::Gemm32fNNcbBufferSize, Avx::Gemm32fNNcbReorderB, Avx::Gemm32fNNcbRun, "Avx", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcWeight.Resize(_gemmCb.At(0).BufferSize(_M*_merge, _N, _K));
                 }
                 else
@@ -576,7 +576,7 @@ namespace Simd
         SynetConvolution32fGemmNT::SynetConvolution32fGemmNT(const ConvParam32f & p)
             : Sse41::SynetConvolution32fGemmNT(p)
         {
-            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNT, "Avx"));
+            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNT, "Avx"), "Gemm32fNT");
             _biasAndActivation = Avx::ConvolutionBiasAndActivation;
         }
 
@@ -647,12 +647,12 @@ namespace Simd
             }
             else
                 assert(0);
-            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNN, "Avx"));
+            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNN, "Avx"), "Gemm32fNN");
             if (_param.trans)
             {
                 if (NHWC_GEMM_RUNTIME)
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Avx::Gemm32fNNcbBufferSize, Avx::Gemm32fNNcbReorderB, Avx::Gemm32fNNcbRun, "Avx", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Avx::Gemm32fNNcbBufferSize, Avx::Gemm32fNNcbReorderB, Avx::Gemm32fNNcbRun, "Avx", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcStrideW = _gemmCb.At(0).BufferSize(_M*_merge, _N, _K);
                 }
                 else
@@ -751,7 +751,7 @@ namespace Simd
                     if (!SetRt(p, funcs.back().alg))
                         return;
                 }
-                _run.Init(funcs);
+                _run.Init(funcs, "NhwcDirect");
             }
         }
 
@@ -782,6 +782,8 @@ namespace Simd
                 else
                     return new Base::SynetConvolution32fBf16Gemm(param);
             }
+            else if (Base::Fp16Soft(compatibility) && Base::SynetConvolution32fFp16Nhwc::Preferable(param))
+                return new Base::SynetConvolution32fFp16Nhwc(param);
             else if (SynetConvolution32fDepthwiseDotProduct::Preferable(param))
                 return new SynetConvolution32fDepthwiseDotProduct(param);
             else if (SynetConvolution32fWinograd::Preferable(param))
@@ -39,12 +39,12 @@ namespace Simd
         SynetDeconvolution32fGemmNN::SynetDeconvolution32fGemmNN(const DeconvParam32f & p)
             : Sse41::SynetDeconvolution32fGemmNN(p)
         {
-            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNN, "Avx"));
+            _gemm.Init(InitGemmFuncs(Avx::Gemm32fNN, "Avx"), "Gemm32fNN");
             if (_param.trans && _param.group == 1)
             {
                 if (NHWC_GEMM_RUNTIME)
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Avx::Gemm32fNNcbBufferSize, Avx::Gemm32fNNcbReorderB, Avx::Gemm32fNNcbRun, "Avx", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Avx::Gemm32fNNcbBufferSize, Avx::Gemm32fNNcbReorderB, Avx::Gemm32fNNcbRun, "Avx", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcWeight.Resize(_gemmCb.At(0).BufferSize(_M*_merge, _N, _K));
                 }
                 else
@@ -58,7 +58,8 @@ namespace Simd
             {
                 _cbRun = Avx::Gemm32fNNcbRun;
                 _cbPack = Avx::Gemm32fNNcbReorderB;
-                _cbWeight.Resize(Avx::Gemm32fNNcbBufferSize(_M, _N, _K, GemmKernelAny, NHWC_GEMM_COMPATIBLE));
+                _cbSize = Avx::Gemm32fNNcbBufferSize(_M, _N, _K, GemmKernelAny, NHWC_GEMM_COMPATIBLE);
+                _cbWeight.Resize(_cbSize);
             }
         }
 
@@ -222,9 +223,16 @@ namespace Simd
 
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation)
         {
-            InnerProductParam32f param(batch, input, output, transpose, activation);
+            return SynetInnerProduct32fInitV2(batch, input, output, transpose, activation, SimdSynetCompatibilityDefault);
+        }
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+        {
+            InnerProductParam32f param(batch, input, output, transpose, activation, compatibility);
             if (!param.Valid())
                 return NULL;
+            if (Base::Fp16Soft(compatibility))
+                return new Base::SynetInnerProduct32fFp16(param);
             if (SynetInnerProduct32fProd::Preferable(param))
                 return new SynetInnerProduct32fProd(param);
             else
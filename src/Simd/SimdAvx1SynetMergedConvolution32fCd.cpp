@@ -48,9 +48,9 @@ namespace Simd
 				size_t srcW = p.srcW * F, weightS = p.kernelY * p.kernelX * F, strideXF = strideX * F;
 				size_t srcM = (bufH[0] - 1), srcS = bufH[0] * srcW, dstS = p.dstW * p.dstC;
 				size_t noseY = (p.padY + p.strideY - 1) / p.strideY;
-				size_t bodyY = (p.srcH + p.padY + p.strideY - p.kernelY) / p.strideY;
+				size_t bodyY = (p.srcH + p.padY + p.strideY - (p.kernelY - 1) * p.dilationY - 1) / p.strideY;
 				size_t noseX = (p.padX + p.strideX - 1) / p.strideX;
-				size_t bodyX = (p.srcW + p.padX + p.strideX - p.kernelX) / p.strideX;
+				size_t bodyX = (p.srcW + p.padX + p.strideX - (p.kernelX - 1) * p.dilationX - 1) / p.strideX;
 				size_t bodyX2 = AlignLo(bodyX - noseX, 2) + noseX;
 				size_t bodyX4 = AlignLo(bodyX - noseX, 4) + noseX;
 				size_t bodyX8 = AlignLo(bodyX - noseX, 8) + noseX;
@@ -79,12 +79,12 @@ namespace Simd
 								__m256 sum = _bias;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * strideY + ky - padY;
+									size_t sy = dy * strideY + ky * p.dilationY - padY;
 									if (sy < p.srcH)
 									{
 										for (size_t kx = 0; kx < p.kernelX; ++kx)
 										{
-											size_t sx = dx * strideX + kx - padX;
+											size_t sx = dx * strideX + kx * p.dilationX - padX;
 											if (sx < p.srcW)
 											{
 												const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -111,10 +111,10 @@ namespace Simd
 									__m256 sum = _bias;
 									for (size_t ky = 0; ky < p.kernelY; ++ky)
 									{
-										size_t sy = dy * p.strideY + ky - padY;
+										size_t sy = dy * p.strideY + ky * p.dilationY - padY;
 										for (size_t kx = 0; kx < p.kernelX; ++kx)
 										{
-											size_t sx = dx * p.strideX + kx - padX;
+											size_t sx = dx * p.strideX + kx * p.dilationX - padX;
 											if (sx < p.srcW)
 											{
 												const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -138,9 +138,9 @@ namespace Simd
 									const float* pw = weight;
 									for (size_t ky = 0; ky < p.kernelY; ++ky)
 									{
-										size_t sy = dy * strideY + ky - padY;
+										size_t sy = dy * strideY + ky * p.dilationY - padY;
 										const float* ps = src + ((sy & srcM) * p.srcW + dx * strideX - padX) * F;
-										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += F, pw += F)
+										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * F, pw += F)
 										{
 											__m256 w0 = _mm256_loadu_ps(pw);
 											sum0 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps + 0 * strideXF), w0), sum0);
@@ -171,9 +171,9 @@ namespace Simd
 									const float* pw = weight;
 									for (size_t ky = 0; ky < p.kernelY; ++ky)
 									{
-										size_t sy = dy * strideY + ky - padY;
+										size_t sy = dy * strideY + ky * p.dilationY - padY;
 										const float* ps = src + ((sy & srcM) * p.srcW + dx * strideX - padX) * F;
-										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += F, pw += F)
+										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * F, pw += F)
 										{
 											__m256 w0 = _mm256_loadu_ps(pw);
 											sum0 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps + 0 * strideXF), w0), sum0);
@@ -194,9 +194,9 @@ namespace Simd
 									const float* pw = weight;
 									for (size_t ky = 0; ky < p.kernelY; ++ky)
 									{
-										size_t sy = dy * strideY + ky - padY;
+										size_t sy = dy * strideY + ky * p.dilationY - padY;
 										const float* ps = src + ((sy & srcM) * p.srcW + dx * strideX - padX) * F;
-										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += F, pw += F)
+										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * F, pw += F)
 										{
 											__m256 w0 = _mm256_loadu_ps(pw);
 											sum0 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps + 0 * strideXF), w0), sum0);
@@ -212,9 +212,9 @@ namespace Simd
 									const float* pw = weight;
 									for (size_t ky = 0; ky < p.kernelY; ++ky)
 									{
-										size_t sy = dy * strideY + ky - padY;
+										size_t sy = dy * strideY + ky * p.dilationY - padY;
 										const float* ps = src + ((sy & srcM) * p.srcW + dx * strideX - padX) * F;
-										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += F, pw += F)
+										for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * F, pw += F)
 										{
 											__m256 w0 = _mm256_loadu_ps(pw);
 											sum = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps), w0), sum);
@@ -227,10 +227,10 @@ namespace Simd
 									__m256 sum = _bias;
 									for (size_t ky = 0; ky < p.kernelY; ++ky)
 									{
-										size_t sy = dy * strideY + ky - padY;
+										size_t sy = dy * strideY + ky * p.dilationY - padY;
 										for (size_t kx = 0; kx < p.kernelX; ++kx)
 										{
-											size_t sx = dx * strideX + kx - padX;
+											size_t sx = dx * strideX + kx * p.dilationX - padX;
 											if (sx < p.srcW)
 											{
 												const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -249,12 +249,12 @@ namespace Simd
 									__m256 sum = _bias;
 									for (size_t ky = 0; ky < p.kernelY; ++ky)
 									{
-										size_t sy = dy * strideY + ky - padY;
+										size_t sy = dy * strideY + ky * p.dilationY - padY;
 										if (sy < p.srcH)
 										{
 											for (size_t kx = 0; kx < p.kernelX; ++kx)
 											{
-												size_t sx = dx * strideX + kx - padX;
+												size_t sx = dx * strideX + kx * p.dilationX - padX;
 												if (sx < p.srcW)
 												{
 													const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -453,7 +453,7 @@ namespace Simd
 				switch (t)
 				{
 				case 1:
-					if (p.conv[i].kernelY == 3 && Aligned(p.conv[i].dstC, F))
+					if (IsKernel(p.conv[i], 3) && IsDilation(p.conv[i], 1) && Aligned(p.conv[i].dstC, F))
 						c[i] = DepthwiseConvolution3x3<type>;
 					else
 						c[i] = DepthwiseConvolution<type>;
@@ -40,9 +40,9 @@ namespace Simd
 				size_t srcX = p.srcC, srcW = p.srcW * srcX, dstW = p.dstW * F, weightS = p.kernelY * p.kernelX * F, strideXC = strideX * srcX;
 				size_t dstM = (bufH[1] - 1), dstS = bufH[1] * dstW;
 				size_t noseY = (p.padY + p.strideY - 1) / p.strideY;
-				size_t bodyY = (p.srcH + p.padY + p.strideY - p.kernelY) / p.strideY;
+				size_t bodyY = (p.srcH + p.padY + p.strideY - (p.kernelY - 1) * p.dilationY - 1) / p.strideY;
 				size_t noseX = (p.padX + p.strideX - 1) / p.strideX;
-				size_t bodyX = (p.srcW + p.padX + p.strideX - p.kernelX) / p.strideX;
+				size_t bodyX = (p.srcW + p.padX + p.strideX - (p.kernelX - 1) * p.dilationX - 1) / p.strideX;
 				size_t bodyX2 = AlignLo(bodyX - noseX, 2) + noseX;
 				size_t bodyX4 = AlignLo(bodyX - noseX, 4) + noseX;
 				size_t bodyX8 = AlignLo(bodyX - noseX, 8) + noseX;
@@ -70,10 +70,10 @@ namespace Simd
 								__m256 sum = _bias;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * p.strideY + ky - padY;
+									size_t sy = dy * p.strideY + ky * p.dilationY - padY;
 									for (size_t kx = 0; kx < p.kernelX; ++kx)
 									{
-										size_t sx = dx * p.strideX + kx - padX;
+										size_t sx = dx * p.strideX + kx * p.dilationX - padX;
 										if (sx < p.srcW)
 										{
 											const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -97,9 +97,9 @@ namespace Simd
 								const float* pw = weight;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * strideY + ky - padY;
+									size_t sy = dy * strideY + ky * p.dilationY - padY;
 									const float* ps = src + sy * srcW + (dx * strideX - padX) * srcX;
-									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += srcX, pw += F)
+									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * srcX, pw += F)
 									{
 										__m256 w0 = _mm256_loadu_ps(pw);
 										sum0 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps + 0 * strideXC), w0), sum0);
@@ -130,9 +130,9 @@ namespace Simd
 								const float* pw = weight;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * strideY + ky - padY;
+									size_t sy = dy * strideY + ky * p.dilationY - padY;
 									const float* ps = src + sy * srcW + (dx * strideX - padX) * srcX;
-									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += srcX, pw += F)
+									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * srcX, pw += F)
 									{
 										__m256 w0 = _mm256_loadu_ps(pw);
 										sum0 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps + 0 * strideXC), w0), sum0);
@@ -153,9 +153,9 @@ namespace Simd
 								const float* pw = weight;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * strideY + ky - padY;
+									size_t sy = dy * strideY + ky * p.dilationY - padY;
 									const float* ps = src + sy * srcW + (dx * strideX - padX) * srcX;
-									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += srcX, pw += F)
+									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * srcX, pw += F)
 									{
 										__m256 w0 = _mm256_loadu_ps(pw);
 										sum0 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps + 0 * strideXC), w0), sum0);
@@ -171,9 +171,9 @@ namespace Simd
 								const float* pw = weight;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * strideY + ky - padY;
+									size_t sy = dy * strideY + ky * p.dilationY - padY;
 									const float* ps = src + sy * srcW + (dx * strideX - padX) * srcX;
-									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += srcX, pw += F)
+									for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * srcX, pw += F)
 									{
 										__m256 w0 = _mm256_loadu_ps(pw);
 										sum = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(ps), w0), sum);
@@ -186,10 +186,10 @@ namespace Simd
 								__m256 sum = _bias;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * strideY + ky - padY;
+									size_t sy = dy * strideY + ky * p.dilationY - padY;
 									for (size_t kx = 0; kx < p.kernelX; ++kx)
 									{
-										size_t sx = dx * strideX + kx - padX;
+										size_t sx = dx * strideX + kx * p.dilationX - padX;
 										if (sx < p.srcW)
 										{
 											const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -208,12 +208,12 @@ namespace Simd
 								__m256 sum = _bias;
 								for (size_t ky = 0; ky < p.kernelY; ++ky)
 								{
-									size_t sy = dy * strideY + ky - padY;
+									size_t sy = dy * strideY + ky * p.dilationY - padY;
 									if (sy < p.srcH)
 									{
 										for (size_t kx = 0; kx < p.kernelX; ++kx)
 										{
-											size_t sx = dx * strideX + kx - padX;
+											size_t sx = dx * strideX + kx * p.dilationX - padX;
 											if (sx < p.srcW)
 											{
 												const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -412,7 +412,7 @@ namespace Simd
 				switch (t)
 				{
 				case 1:
-					if (p.conv[i].kernelY == 3)
+					if (IsKernel(p.conv[i], 3) && IsDilation(p.conv[i], 1))
 						c[i + 0] = DepthwiseConvolution3x3<type>;
 					else
 						c[i + 0] = DepthwiseConvolution<type>;
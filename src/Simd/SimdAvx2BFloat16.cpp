@@ -88,6 +88,17 @@ namespace Simd
             for (; i < size; ++i)
                 dst[i] = Base::BFloat16ToFloat32(src[i]);
         }
+
+        //---------------------------------------------------------------------------------------------
+
+        void RoundToBFloat16(const float* src, size_t size, float* dst)
+        {
+            size_t sizeF = Simd::AlignLo(size, F), i = 0;
+            for (; i < sizeF; i += F)
+                _mm256_storeu_ps(dst + i, RoundToBFloat16(_mm256_loadu_ps(src + i)));
+            for (; i < size; ++i)
+                dst[i] = Base::RoundToBFloat16(src[i]);
+        }
     }
 #endif
 }
@@ -0,0 +1,90 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdDescrInt.h"
+#include "Simd/SimdDescrIntCommon.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        SIMD_INLINE __m256i Popcount8(__m256i value)
+        {
+            const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(value, K8_0F));
+            __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(value, 4), K8_0F));
+            return _mm256_add_epi8(lo, hi);
+        }
+
+        SIMD_INLINE uint32_t ExtractSum64(__m256i value)
+        {
+            __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+            return uint32_t(_mm_cvtsi128_si32(sum) + _mm_extract_epi32(sum, 2));
+        }
+
+        template<int bits> void CosineDistanceBits(const uint8_t* a, const uint8_t* b, size_t size, float* distance)
+        {
+            size_t plane = size / 8, plane32 = AlignLo(plane, 32), i = 0;
+            const uint8_t* pa = a + 16, * pb = b + 16;
+            __m256i sums[2 * bits - 1], va[bits], vb[bits];
+            for (int k = 0; k < 2 * bits - 1; ++k)
+                sums[k] = _mm256_setzero_si256();
+            for (; i < plane32; i += 32)
+            {
+                for (int p = 0; p < bits; ++p)
+                {
+                    va[p] = _mm256_loadu_si256((__m256i*)(pa + p * plane + i));
+                    vb[p] = _mm256_loadu_si256((__m256i*)(pb + p * plane + i));
+                }
+                for (int p = 0; p < bits; ++p)
+                    for (int q = 0; q < bits; ++q)
+                        sums[p + q] = _mm256_add_epi64(sums[p + q], _mm256_sad_epu8(Popcount8(_mm256_and_si256(va[p], vb[q])), K_ZERO));
+            }
+            uint32_t abSum = 0;
+            for (int k = 0; k < 2 * bits - 1; ++k)
+                abSum += ExtractSum64(sums[k]) << k;
+            if (i < plane)
+            {
+                for (int p = 0; p < bits; ++p)
+                    for (int q = 0; q < bits; ++q)
+                        abSum += Sse41::PopcountAnd(pa + p * plane + i, pb + q * plane + i, plane - i) << (p + q);
+            }
+            Base::DecodeCosineDistance(a, b, float(abSum), distance);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        Base::DescrInt::CosineDistancePtr GetCosineDistanceBits(size_t depth)
+        {
+            switch (depth)
+            {
+            case 1: return CosineDistanceBits<1>;
+            case 2: return CosineDistanceBits<2>;
+            case 3: return CosineDistanceBits<3>;
+            default: assert(0); return NULL;
+            }
+        }
+    }
+#endif
+}
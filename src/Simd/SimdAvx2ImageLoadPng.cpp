@@ -0,0 +1,129 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdImageLoadPng.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) 
+    namespace Avx2
+    {
+        static void DecodeLine2(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        {
+            if (srcN == dstN)
+            {
+                size_t size = size_t(width) * srcN, sizeA = AlignLo(size, A), i = 0;
+                for (; i < sizeA; i += A)
+                {
+                    __m256i _curr = _mm256_loadu_si256((__m256i*)(curr + i));
+                    __m256i _prev = _mm256_loadu_si256((__m256i*)(prev + i));
+                    _mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi8(_curr, _prev));
+                }
+                for (; i < size; ++i)
+                    dst[i] = curr[i] + prev[i];
+            }
+            else
+                Base::DecodeLine2(curr, prev, width, srcN, dstN, dst);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        static void ExpandPalette(const uint8_t* src, size_t size, int outN, const uint8_t* palette, uint8_t* dst)
+        {
+            if (outN == 4)
+            {
+                size_t size8 = AlignLo(size, 8), i = 0;
+                const int32_t* pal = (const int32_t*)palette;
+                for (; i < size8; i += 8)
+                {
+                    __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(src + i)));
+                    _mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_i32gather_epi32(pal, index, 4));
+                }
+                for (; i < size; ++i)
+                    memcpy(dst + i * 4, pal + src[i], 4);
+            }
+            else
+                Base::ExpandPalette(src, size, outN, palette, dst);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        static Base::ImagePngLoader::ConverterPtr GetConverter(int channels, SimdPixelFormatType format)
+        {
+            switch (channels)
+            {
+            case 1:
+                switch (format)
+                {
+                case SimdPixelFormatGray8: return Base::PngCopy<1>;
+                case SimdPixelFormatBgr24: return Avx2::GrayToBgr;
+                case SimdPixelFormatRgb24: return Avx2::GrayToBgr;
+                case SimdPixelFormatBgra32: return Base::PngToOpaque<Avx2::GrayToBgra>;
+                case SimdPixelFormatRgba32: return Base::PngToOpaque<Avx2::GrayToBgra>;
+                default: return NULL;
+                }
+            case 3:
+                switch (format)
+                {
+                case SimdPixelFormatBgr24: return Avx2::BgrToRgb;
+                case SimdPixelFormatRgb24: return Base::PngCopy<3>;
+                case SimdPixelFormatBgra32: return Base::PngToOpaque<Avx2::RgbToBgra>;
+                case SimdPixelFormatRgba32: return Base::PngToOpaque<Avx2::BgrToBgra>;
+                default: return NULL;
+                }
+            case 4:
+                switch (format)
+                {
+                case SimdPixelFormatBgr24: return Avx2::BgraToRgb;
+                case SimdPixelFormatRgb24: return Avx2::BgraToBgr;
+                case SimdPixelFormatBgra32: return Avx2::BgraToRgba;
+                case SimdPixelFormatRgba32: return Base::PngCopy<4>;
+                default: return NULL;
+                }
+            default:
+                return NULL;
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        ImagePngLoader::ImagePngLoader(const ImageLoaderParam& param)
+            : Sse41::ImagePngLoader(param)
+        {
+            _decodeLine[2] = Avx2::DecodeLine2;
+            if (!SlowGather)
+                _expandPalette = Avx2::ExpandPalette;
+        }
+
+        void ImagePngLoader::SetConverter()
+        {
+            _converter = _depth <= 8 && _width >= A ? GetConverter(_outN, _param.format) : NULL;
+            if (_converter == NULL)
+                Sse41::ImagePngLoader::SetConverter();
+        }
+    }
+#endif
+}
@@ -148,7 +148,7 @@ namespace Simd
             assert(_xn == 0 && _xt == _param.dstW);
             size_t step = 4 / N * 2;
             size_t body = AlignLoAny(_param.dstW - (N == 3 ? 1 : 0), step);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -266,9 +266,9 @@ namespace Simd
         template<int N> void ResizerByteBicubic::RunB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
         {
             int32_t prev = -1;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
-                int32_t sy = _iy[dy], next = prev;
+                int32_t sy = _iy[dy], next = Simd::Max(prev, sy - 1);
                 for (int32_t curr = sy - 1, end = sy + 3; curr < end; ++curr)
                 {
                     if (curr < prev)
@@ -0,0 +1,203 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetAttention32f.h"
+#include "Simd/SimdExp.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx2
+    {
+        SIMD_INLINE void Save2(float* C, __m256 c0, __m256 c1, int update)
+        {
+            if (update)
+            {
+                c0 = _mm256_add_ps(_mm256_loadu_ps(C + 0), c0);
+                c1 = _mm256_add_ps(_mm256_loadu_ps(C + F), c1);
+            }
+            _mm256_storeu_ps(C + 0, c0);
+            _mm256_storeu_ps(C + F, c1);
+        }
+
+        template<int M> void AttentionMul_2xM(size_t K, const float* A0, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, int update)
+        {
+            __m256 c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51, b0, b1, a0;
+            const float* A1 = A0 + 1 * strideM;
+            const float* A2 = A0 + 2 * strideM;
+            const float* A3 = A0 + 3 * strideM;
+            const float* A4 = A0 + 4 * strideM;
+            const float* A5 = A0 + 5 * strideM;
+            if (M > 0) c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+            if (M > 1) c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+            if (M > 2) c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            if (M > 3) c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+            if (M > 4) c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+            if (M > 5) c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+            for (size_t k = 0, o = 0; k < K; ++k, o += strideK)
+            {
+                b0 = _mm256_loadu_ps(B + 0);
+                b1 = _mm256_loadu_ps(B + F);
+                if (M > 0) a0 = _mm256_set1_ps(A0[o]), c00 = _mm256_fmadd_ps(a0, b0, c00), c01 = _mm256_fmadd_ps(a0, b1, c01);
+                if (M > 1) a0 = _mm256_set1_ps(A1[o]), c10 = _mm256_fmadd_ps(a0, b0, c10), c11 = _mm256_fmadd_ps(a0, b1, c11);
+                if (M > 2) a0 = _mm256_set1_ps(A2[o]), c20 = _mm256_fmadd_ps(a0, b0, c20), c21 = _mm256_fmadd_ps(a0, b1, c21);
+                if (M > 3) a0 = _mm256_set1_ps(A3[o]), c30 = _mm256_fmadd_ps(a0, b0, c30), c31 = _mm256_fmadd_ps(a0, b1, c31);
+                if (M > 4) a0 = _mm256_set1_ps(A4[o]), c40 = _mm256_fmadd_ps(a0, b0, c40), c41 = _mm256_fmadd_ps(a0, b1, c41);
+                if (M > 5) a0 = _mm256_set1_ps(A5[o]), c50 = _mm256_fmadd_ps(a0, b0, c50), c51 = _mm256_fmadd_ps(a0, b1, c51);
+                B += ldb;
+            }
+            if (M > 0) Save2(C, c00, c01, update), C += ldc;
+            if (M > 1) Save2(C, c10, c11, update), C += ldc;
+            if (M > 2) Save2(C, c20, c21, update), C += ldc;
+            if (M > 3) Save2(C, c30, c31, update), C += ldc;
+            if (M > 4) Save2(C, c40, c41, update), C += ldc;
+            if (M > 5) Save2(C, c50, c51, update), C += ldc;
+        }
+
+        typedef void(*AttentionMul_2xM_Ptr)(size_t K, const float* A0, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, int update);
+
+        AttentionMul_2xM_Ptr GetAttentionMul_2xM(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return AttentionMul_2xM<1>;
+            case 2: return AttentionMul_2xM<2>;
+            case 3: return AttentionMul_2xM<3>;
+            case 4: return AttentionMul_2xM<4>;
+            case 5: return AttentionMul_2xM<5>;
+            case 6: return AttentionMul_2xM<6>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        static void AttentionMul(size_t M, size_t N, size_t K, const float* A, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, int update)
+        {
+            size_t m = 6, MM = AlignLoAny(M, m), tail = M - MM;
+            AttentionMul_2xM_Ptr mul_2xM = GetAttentionMul_2xM(m);
+            AttentionMul_2xM_Ptr mul_2xT = GetAttentionMul_2xM(tail);
+            assert(N % DF == 0);
+            for (size_t j = 0; j < N; j += DF)
+            {
+                size_t i = 0;
+                for (; i < MM; i += m)
+                    mul_2xM(K, A + i * strideM, strideM, strideK, B + j, ldb, C + i * ldc + j, ldc, update);
+                if (tail)
+                    mul_2xT(K, A + i * strideM, strideM, strideK, B + j, ldb, C + i * ldc + j, ldc, update);
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        static void AttentionSoftmax(float* src, size_t stride, size_t rows, size_t cols, ptrdiff_t first, float scale, float* max, float* sum, float* corr)
+        {
+            assert(cols % F == 0);
+            const __m256 _scale = _mm256_set1_ps(scale), _lane = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+            for (size_t i = 0; i < cols; i += F)
+                _mm256_storeu_ps(corr + i, _mm256_loadu_ps(max + i));
+            for (size_t j = 0; j < rows; ++j)
+            {
+                float* s = src + j * stride;
+                ptrdiff_t beg = first + j;
+                for (size_t i = 0; i < cols; i += F)
+                {
+                    __m256 _s = _mm256_mul_ps(_mm256_loadu_ps(s + i), _scale);
+                    _mm256_storeu_ps(s + i, _s);
+                    __m256 _max = _mm256_loadu_ps(corr + i);
+                    if (beg <= (ptrdiff_t)i)
+                        _mm256_storeu_ps(corr + i, _mm256_max_ps(_max, _s));
+                    else if (beg < ptrdiff_t(i + F))
+                    {
+                        __m256 valid = _mm256_cmp_ps(_mm256_add_ps(_lane, _mm256_set1_ps(float(ptrdiff_t(i) - beg))), _mm256_setzero_ps(), _CMP_GE_OQ);
+                        _mm256_storeu_ps(corr + i, _mm256_blendv_ps(_max, _mm256_max_ps(_max, _s), valid));
+                    }
+                }
+            }
+            Exp exp;
+            for (size_t i = 0; i < cols; i += F)
+            {
+                __m256 _new = _mm256_loadu_ps(corr + i);
+                __m256 _corr = exp.Exponent(_mm256_sub_ps(_mm256_loadu_ps(max + i), _new));
+                _mm256_storeu_ps(corr + i, _corr);
+                _mm256_storeu_ps(sum + i, _mm256_mul_ps(_mm256_loadu_ps(sum + i), _corr));
+                _mm256_storeu_ps(max + i, _new);
+            }
+            for (size_t j = 0; j < rows; ++j)
+            {
+                float* s = src + j * stride;
+                ptrdiff_t beg = first + j;
+                for (size_t i = 0; i < cols; i += F)
+                {
+                    __m256 e;
+                    if (beg < ptrdiff_t(i + F))
+                    {
+                        e = exp.Exponent(_mm256_sub_ps(_mm256_loadu_ps(s + i), _mm256_loadu_ps(max + i)));
+                        if (beg > (ptrdiff_t)i)
+                        {
+                            __m256 valid = _mm256_cmp_ps(_mm256_add_ps(_lane, _mm256_set1_ps(float(ptrdiff_t(i) - beg))), _mm256_setzero_ps(), _CMP_GE_OQ);
+                            e = _mm256_and_ps(e, valid);
+                        }
+                        _mm256_storeu_ps(sum + i, _mm256_add_ps(_mm256_loadu_ps(sum + i), e));
+                    }
+                    else
+                        e = _mm256_setzero_ps();
+                    _mm256_storeu_ps(s + i, e);
+                }
+            }
+        }
+
+        static void AttentionScale(const float* src, size_t size, float scale, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m256 _scale = _mm256_set1_ps(scale);
+            for (; i < sizeF; i += F)
+                _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), _scale));
+            for (; i < size; ++i)
+                dst[i] = src[i] * scale;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetAttention32f::SynetAttention32f(const AttentionParam32f& p)
+            : Base::SynetAttention32f(p)
+        {
+            _mul = AttentionMul;
+            _softmax = AttentionSoftmax;
+            _scale = AttentionScale;
+            _round = RoundToBFloat16;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility)
+        {
+            AttentionParam32f param(batch, heads, lenQ, lenKV, depth, scale, causal, compatibility);
+            if (!param.Valid())
+                return NULL;
+            return new SynetAttention32f(param);
+        }
+    }
+#endif
+}
@@ -23,6 +23,7 @@
 */
 #include "Simd/SimdSynetConvolution32f.h"
 #include "Simd/SimdSynetConvolution32fCommon.h"
+#include "Simd/SimdSynetInnerProduct32f.h"
 #include "Simd/SimdSet.h"
 #include "Simd/SimdLoad.h"
 #include "Simd/SimdAvx1.h"
@@ -232,12 +233,12 @@ namespace Simd
                 }
                 _start[kx] = int(kx * p.dilationX - p.padX + _nose[kx] * p.strideX);
             }
-            _gemm.Init(InitGemmFuncs(Avx2::Gemm32fNN, "Avx2"));
+            _gemm.Init(InitGemmFuncs(Avx2::Gemm32fNN, "Avx2"), "Gemm32fNN");
             if (_param.trans && _param.group == 1)
             {
                 if (GemmRuntime())
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Avx2::Gemm32fNNcbBufferSize, Avx2::Gemm32fNNcbReorderB, Avx2::Gemm32fNNcbRun, "Avx2", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Avx2::Gemm32fNNcbBufferSize, Avx2::Gemm32fNNcbReorderB, Avx2::Gemm32fNNcbRun, "Avx2", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcWeight.Resize(_gemmCb.At(0).BufferSize(_M*_merge, _N, _K));
                 }
                 else
@@ -316,7 +317,7 @@ namespace Simd
         SynetConvolution32fGemmNT::SynetConvolution32fGemmNT(const ConvParam32f & p)
             : Avx::SynetConvolution32fGemmNT(p)
         {
-            _gemm.Init(InitGemmFuncs(Avx2::Gemm32fNT, "Avx2"));
+            _gemm.Init(InitGemmFuncs(Avx2::Gemm32fNT, "Avx2"), "Gemm32fNT");
             _biasAndActivation = Avx::ConvolutionBiasAndActivation;
         }
 
@@ -386,12 +387,12 @@ namespace Simd
             }
             else
                 assert(0);
-            _gemm.Init(InitGemmFuncs(Avx2::Gemm32fNN, "Avx2"));
+            _gemm.Init(InitGemmFuncs(Avx2::Gemm32fNN, "Avx2"), "Gemm32fNN");
             if (_param.trans)
             {
                 if (NHWC_GEMM_RUNTIME)
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Avx2::Gemm32fNNcbBufferSize, Avx2::Gemm32fNNcbReorderB, Avx2::Gemm32fNNcbRun, "Avx2", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Avx2::Gemm32fNNcbBufferSize, Avx2::Gemm32fNNcbReorderB, Avx2::Gemm32fNNcbRun, "Avx2", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcStrideW = _gemmCb.At(0).BufferSize(_M*_merge, _N, _K);
                 }
                 else
@@ -408,6 +409,8 @@ namespace Simd
         SynetConvolution32fNhwcDirect::SynetConvolution32fNhwcDirect(const ConvParam32f& p)
             : Avx::SynetConvolution32fNhwcDirect(p)
         {
+            _sparse.gemm = Avx2::SynetSparse32fGemm;
+            _biasAndActivation = Avx2::ConvolutionBiasAndActivation;
             if (p.dstC <= Sse41::F)
                 return;
             //_old.enable = true;
@@ -426,7 +429,7 @@ namespace Simd
                     if (!SetRt(p, funcs.back().alg))
                         return;
                 }
-                _run.Init(funcs);
+                _run.Init(funcs, "NhwcDirect");
             }
         }
 
@@ -443,6 +446,16 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        SynetConvolution32fFp16Nhwc::SynetConvolution32fFp16Nhwc(const ConvParam32f& p)
+            : Base::SynetConvolution32fFp16Nhwc(p)
+        {
+            SetSize(DF);
+            _gemm = SynetInnerProduct32fFp16Gemm;
+            _biasAndActivation = Avx2::ConvolutionBiasAndActivation;
+        }
+
+        //---------------------------------------------------------------------
+
         void * SynetConvolution32fInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
         {
             ConvParam32f param(batch, conv, compatibility);
@@ -455,6 +468,8 @@ namespace Simd
                 else
                     return new Base::SynetConvolution32fBf16Gemm(param);
             }
+            else if ((Base::Fp16Soft(compatibility) || Base::Fp16Hard(compatibility)) && Base::SynetConvolution32fFp16Nhwc::Preferable(param))
+                return new SynetConvolution32fFp16Nhwc(param);
             else if (Avx::SynetConvolution32fDepthwiseDotProduct::Preferable(param))
                 return new Avx::SynetConvolution32fDepthwiseDotProduct(param);
             else if (SynetConvolution32fWinograd::Preferable(param))
@@ -22,6 +22,7 @@
 * SOFTWARE.
 */
 #include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetGemm8i.h"
 #include "Simd/SimdSynetConvolution8iCommon.h"
 #include "Simd/SimdSynet.h"
 #include "Simd/SimdMath.h"
@@ -56,11 +57,20 @@ namespace Simd
             else if (SynetConvolution8iNhwcDepthwise::Preferable(param))
                 return new SynetConvolution8iNhwcDepthwise(param);
 #endif
+            else if (SynetConvolution8iWinograd::Preferable(param))
+                return new SynetConvolution8iWinograd(param);
             else if (SynetConvolution8iNhwcDirect::Preferable(param))
                 return new SynetConvolution8iNhwcDirect(param);
             else
                 return new Base::SynetConvolution8iGemmNN(param);
         }
+
+        //---------------------------------------------------------------------
+
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+        {
+            return Simd::SynetGemm8iInit(Gemm8iParam(M, N, K, srcT, dstT, activation, compatibility), SynetConvolution8iInit);
+        }
     }
 #endif
 }
@@ -0,0 +1,218 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetConvolution8iCommon.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdLoad.h"
+#include "Simd/SimdStore.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx2
+    {
+        SIMD_INLINE void WinogradKernel3x3Block2x2SetInput8i16(const uint8_t* const* src, size_t c, int16_t* dst, size_t dstStride)
+        {
+            __m256i s[16], t[16];
+            for (size_t i = 0; i < 16; ++i)
+                s[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(src[i] + c)));
+            for (size_t j = 0; j < 4; ++j)
+            {
+                t[0 + j] = _mm256_sub_epi16(s[0 + j], s[8 + j]);
+                t[4 + j] = _mm256_add_epi16(s[4 + j], s[8 + j]);
+                t[8 + j] = _mm256_sub_epi16(s[8 + j], s[4 + j]);
+                t[12 + j] = _mm256_sub_epi16(s[4 + j], s[12 + j]);
+            }
+            for (size_t i = 0; i < 16; i += 4)
+            {
+                _mm256_storeu_si256((__m256i*)(dst + (i + 0) * dstStride), _mm256_sub_epi16(t[i + 0], t[i + 2]));
+                _mm256_storeu_si256((__m256i*)(dst + (i + 1) * dstStride), _mm256_add_epi16(t[i + 1], t[i + 2]));
+                _mm256_storeu_si256((__m256i*)(dst + (i + 2) * dstStride), _mm256_sub_epi16(t[i + 2], t[i + 1]));
+                _mm256_storeu_si256((__m256i*)(dst + (i + 3) * dstStride), _mm256_sub_epi16(t[i + 1], t[i + 3]));
+            }
+        }
+
+        static void WinogradKernel3x3Block2x2SetInput8i(const uint8_t* src, const ConvParam8i& p, const uint8_t* zero, size_t tileW, size_t tyBeg, size_t tyEnd, int16_t* dst, size_t dstStride)
+        {
+            size_t srcC2 = AlignHi(p.srcC, 2), srcC16 = AlignLo(p.srcC, 16);
+            const uint8_t* ptrs[16];
+            for (size_t ty = tyBeg; ty < tyEnd; ++ty)
+            {
+                for (size_t tx = 0; tx < tileW; ++tx)
+                {
+                    Base::WinogradKernel3x3Block2x2SetSrc8i(src, p, zero, ty, tx, ptrs);
+                    size_t c = 0;
+                    for (; c < srcC16; c += 16)
+                        WinogradKernel3x3Block2x2SetInput8i16(ptrs, c, dst + c, dstStride);
+                    for (; c < p.srcC; ++c)
+                        Base::WinogradKernel3x3Block2x2SetInput8i1(ptrs, c, dst + c, dstStride);
+                    for (; c < srcC2; ++c)
+                        for (size_t i = 0; i < 16; ++i)
+                            dst[i * dstStride + c] = 0;
+                    dst += srcC2;
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        template<int M> void WinogradKernel3x3Block2x2Gemm8iMx16(const int16_t* src, size_t K, const int16_t* weight, size_t N, int32_t* dst)
+        {
+            __m256i d00, d01, d10, d11, d20, d21, d30, d31, d40, d41, d50, d51, s0, w0, w1;
+            const int16_t* src0 = src + 0 * K, * src1 = src + 1 * K, * src2 = src + 2 * K;
+            const int16_t* src3 = src + 3 * K, * src4 = src + 4 * K, * src5 = src + 5 * K;
+            if (M > 0) d00 = _mm256_setzero_si256(), d01 = _mm256_setzero_si256();
+            if (M > 1) d10 = _mm256_setzero_si256(), d11 = _mm256_setzero_si256();
+            if (M > 2) d20 = _mm256_setzero_si256(), d21 = _mm256_setzero_si256();
+            if (M > 3) d30 = _mm256_setzero_si256(), d31 = _mm256_setzero_si256();
+            if (M > 4) d40 = _mm256_setzero_si256(), d41 = _mm256_setzero_si256();
+            if (M > 5) d50 = _mm256_setzero_si256(), d51 = _mm256_setzero_si256();
+            for (size_t k = 0; k < K; k += 2, weight += 2 * N)
+            {
+                w0 = _mm256_loadu_si256((__m256i*)weight + 0);
+                w1 = _mm256_loadu_si256((__m256i*)weight + 1);
+                if (M > 0) s0 = _mm256_set1_epi32(*(int32_t*)(src0 + k)), d00 = _mm256_add_epi32(d00, _mm256_madd_epi16(s0, w0)), d01 = _mm256_add_epi32(d01, _mm256_madd_epi16(s0, w1));
+                if (M > 1) s0 = _mm256_set1_epi32(*(int32_t*)(src1 + k)), d10 = _mm256_add_epi32(d10, _mm256_madd_epi16(s0, w0)), d11 = _mm256_add_epi32(d11, _mm256_madd_epi16(s0, w1));
+                if (M > 2) s0 = _mm256_set1_epi32(*(int32_t*)(src2 + k)), d20 = _mm256_add_epi32(d20, _mm256_madd_epi16(s0, w0)), d21 = _mm256_add_epi32(d21, _mm256_madd_epi16(s0, w1));
+                if (M > 3) s0 = _mm256_set1_epi32(*(int32_t*)(src3 + k)), d30 = _mm256_add_epi32(d30, _mm256_madd_epi16(s0, w0)), d31 = _mm256_add_epi32(d31, _mm256_madd_epi16(s0, w1));
+                if (M > 4) s0 = _mm256_set1_epi32(*(int32_t*)(src4 + k)), d40 = _mm256_add_epi32(d40, _mm256_madd_epi16(s0, w0)), d41 = _mm256_add_epi32(d41, _mm256_madd_epi16(s0, w1));
+                if (M > 5) s0 = _mm256_set1_epi32(*(int32_t*)(src5 + k)), d50 = _mm256_add_epi32(d50, _mm256_madd_epi16(s0, w0)), d51 = _mm256_add_epi32(d51, _mm256_madd_epi16(s0, w1));
+            }
+            if (M > 0) _mm256_storeu_si256((__m256i*)(dst + 0 * N) + 0, d00), _mm256_storeu_si256((__m256i*)(dst + 0 * N) + 1, d01);
+            if (M > 1) _mm256_storeu_si256((__m256i*)(dst + 1 * N) + 0, d10), _mm256_storeu_si256((__m256i*)(dst + 1 * N) + 1, d11);
+            if (M > 2) _mm256_storeu_si256((__m256i*)(dst + 2 * N) + 0, d20), _mm256_storeu_si256((__m256i*)(dst + 2 * N) + 1, d21);
+            if (M > 3) _mm256_storeu_si256((__m256i*)(dst + 3 * N) + 0, d30), _mm256_storeu_si256((__m256i*)(dst + 3 * N) + 1, d31);
+            if (M > 4) _mm256_storeu_si256((__m256i*)(dst + 4 * N) + 0, d40), _mm256_storeu_si256((__m256i*)(dst + 4 * N) + 1, d41);
+            if (M > 5) _mm256_storeu_si256((__m256i*)(dst + 5 * N) + 0, d50), _mm256_storeu_si256((__m256i*)(dst + 5 * N) + 1, d51);
+        }
+
+        typedef void(*WinogradKernel3x3Block2x2Gemm8iPtr)(const int16_t* src, size_t K, const int16_t* weight, size_t N, int32_t* dst);
+
+        static WinogradKernel3x3Block2x2Gemm8iPtr GetWinogradKernel3x3Block2x2Gemm8i(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return WinogradKernel3x3Block2x2Gemm8iMx16<1>;
+            case 2: return WinogradKernel3x3Block2x2Gemm8iMx16<2>;
+            case 3: return WinogradKernel3x3Block2x2Gemm8iMx16<3>;
+            case 4: return WinogradKernel3x3Block2x2Gemm8iMx16<4>;
+            case 5: return WinogradKernel3x3Block2x2Gemm8iMx16<5>;
+            case 6: return WinogradKernel3x3Block2x2Gemm8iMx16<6>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        static void WinogradKernel3x3Block2x2Gemm8i(const int16_t* src, size_t M, size_t K, const int16_t* weight, size_t N, int32_t* dst)
+        {
+            size_t M6 = AlignLoAny(M, 6);
+            WinogradKernel3x3Block2x2Gemm8iPtr body = WinogradKernel3x3Block2x2Gemm8iMx16<6>;
+            WinogradKernel3x3Block2x2Gemm8iPtr tail = GetWinogradKernel3x3Block2x2Gemm8i(M - M6);
+            for (size_t j = 0; j < N; j += 16)
+            {
+                size_t i = 0;
+                for (; i < M6; i += 6)
+                    body(src + i * K, K, weight + j * 2, N, dst + i * N + j);
+                if (tail)
+                    tail(src + i * K, K, weight + j * 2, N, dst + i * N + j);
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        SIMD_INLINE void WinogradKernel3x3Block2x2SetOutput8i8(const int32_t* src, size_t srcStride, __m256 norm, __m256 bias, __m256 dst[4])
+        {
+            __m256i t[8];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                __m256i s0 = _mm256_loadu_si256((__m256i*)(src + (0 + j) * srcStride));
+                __m256i s1 = _mm256_loadu_si256((__m256i*)(src + (4 + j) * srcStride));
+                __m256i s2 = _mm256_loadu_si256((__m256i*)(src + (8 + j) * srcStride));
+                __m256i s3 = _mm256_loadu_si256((__m256i*)(src + (12 + j) * srcStride));
+                t[0 + j] = _mm256_add_epi32(_mm256_add_epi32(s0, s1), s2);
+                t[4 + j] = _mm256_sub_epi32(_mm256_sub_epi32(s1, s2), s3);
+            }
+            for (size_t i = 0; i < 2; ++i)
+            {
+                __m256i y0 = _mm256_add_epi32(_mm256_add_epi32(t[i * 4 + 0], t[i * 4 + 1]), t[i * 4 + 2]);
+                __m256i y1 = _mm256_sub_epi32(_mm256_sub_epi32(t[i * 4 + 1], t[i * 4 + 2]), t[i * 4 + 3]);
+                dst[i * 2 + 0] = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(y0, 2)), norm, bias);
+                dst[i * 2 + 1] = _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(y1, 2)), norm, bias);
+            }
+        }
+
+        static void WinogradKernel3x3Block2x2SetOutput8i(const int32_t* src, size_t srcStride, const ConvParam8i& p, size_t tileW, size_t tyBeg, size_t tyEnd, size_t N, const float* norm, const float* bias, float* dst)
+        {
+            size_t dstCF = AlignLo(p.dstC, F);
+            __m256i tail = LeftNotZero32i(p.dstC - dstCF);
+            __m256 val[4];
+            for (size_t ty = tyBeg; ty < tyEnd; ++ty)
+            {
+                for (size_t tx = 0; tx < tileW; ++tx)
+                {
+                    size_t dy = ty * 2, dx = tx * 2, rows = Simd::Min<size_t>(p.dstH - dy, 2), cols = Simd::Min<size_t>(p.dstW - dx, 2);
+                    float* pDst = dst + (dy * p.dstW + dx) * p.dstC;
+                    size_t d = 0;
+                    for (; d < dstCF; d += F)
+                    {
+                        WinogradKernel3x3Block2x2SetOutput8i8(src + d, srcStride, _mm256_loadu_ps(norm + d), _mm256_loadu_ps(bias + d), val);
+                        for (size_t r = 0; r < rows; ++r)
+                            for (size_t c = 0; c < cols; ++c)
+                                _mm256_storeu_ps(pDst + (r * p.dstW + c) * p.dstC + d, val[r * 2 + c]);
+                    }
+                    if (d < p.dstC)
+                    {
+                        WinogradKernel3x3Block2x2SetOutput8i8(src + d, srcStride, _mm256_maskload_ps(norm + d, tail), _mm256_maskload_ps(bias + d, tail), val);
+                        for (size_t r = 0; r < rows; ++r)
+                            for (size_t c = 0; c < cols; ++c)
+                                _mm256_maskstore_ps(pDst + (r * p.dstW + c) * p.dstC + d, tail, val[r * 2 + c]);
+                    }
+                    src += N;
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        SynetConvolution8iWinograd::SynetConvolution8iWinograd(const ConvParam8i& p)
+            : Base::SynetConvolution8iWinograd(p)
+        {
+            _setInput = WinogradKernel3x3Block2x2SetInput8i;
+            _gemm = WinogradKernel3x3Block2x2Gemm8i;
+            _setOutput = WinogradKernel3x3Block2x2SetOutput8i;
+        }
+
+        bool SynetConvolution8iWinograd::Preferable(const ConvParam8i& p)
+        {
+            if (p.trans != SimdTrue || p.group != 1 || !p.IsKernel(3) || !p.IsStride(1) || !p.IsDilation(1))
+                return false;
+            if (!Base::Precise(p.compatibility) || p.srcC > 1024)
+                return false;
+            return p.srcC >= 32 && p.dstC >= 32 && p.dstH >= 4 && p.dstW >= 4;
+        }
+    }
+#endif
+}
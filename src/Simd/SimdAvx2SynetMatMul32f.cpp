@@ -0,0 +1,50 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetMatMul32f.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx2
+    {
+        SynetMatMul32f::SynetMatMul32f(const MatMulParam32f& p)
+            : Sse41::SynetMatMul32f(p)
+        {
+            _gemm = p.transB ? Avx2::Gemm32fNT : Avx2::Gemm32fNN;
+            _round = RoundToBFloat16;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility)
+        {
+            MatMulParam32f param(batchA, batchB, M, N, K, transB, compatibility);
+            if (!param.Valid())
+                return NULL;
+            return new SynetMatMul32f(param);
+        }
+    }
+#endif
+}
@@ -78,12 +78,12 @@ namespace Simd
                             __m256 sum = _bias;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 if (sy < p.srcH)
                                 {
                                     for (size_t kx = 0; kx < p.kernelX; ++kx)
                                     {
-                                        size_t sx = dx * strideX + kx - padX;
+                                        size_t sx = dx * strideX + kx * p.dilationX - padX;
                                         if (sx < p.srcW)
                                         {
                                             const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -109,10 +109,10 @@ namespace Simd
                             __m256 sum = _bias;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * p.strideY + ky - padY;
+                                size_t sy = dy * p.strideY + ky * p.dilationY - padY;
                                 for (size_t kx = 0; kx < p.kernelX; ++kx)
                                 {
-                                    size_t sx = dx * p.strideX + kx - padX;
+                                    size_t sx = dx * p.strideX + kx * p.dilationX - padX;
                                     if (sx < p.srcW)
                                     {
                                         const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -136,9 +136,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m256 w0 = _mm256_loadu_ps(pw);
                                     sum0 = Fmadd<nofma>(_mm256_loadu_ps(ps + 0 * ssX), w0, sum0);
@@ -169,9 +169,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m256 w0 = _mm256_loadu_ps(pw);
                                     sum0 = Fmadd<nofma>(_mm256_loadu_ps(ps + 0 * ssX), w0, sum0);
@@ -192,9 +192,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m256 w0 = _mm256_loadu_ps(pw);
                                     sum0 = Fmadd<nofma>(_mm256_loadu_ps(ps + 0 * ssX), w0, sum0);
@@ -210,9 +210,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m256 w0 = _mm256_loadu_ps(pw);
                                     sum = Fmadd<nofma>(_mm256_loadu_ps(ps), w0, sum);
@@ -225,10 +225,10 @@ namespace Simd
                             __m256 sum = _bias;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 for (size_t kx = 0; kx < p.kernelX; ++kx)
                                 {
-                                    size_t sx = dx * strideX + kx - padX;
+                                    size_t sx = dx * strideX + kx * p.dilationX - padX;
                                     if (sx < p.srcW)
                                     {
                                         const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -247,12 +247,12 @@ namespace Simd
                             __m256 sum = _bias;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 if (sy < p.srcH)
                                 {
                                     for (size_t kx = 0; kx < p.kernelX; ++kx)
                                     {
-                                        size_t sx = dx * strideX + kx - padX;
+                                        size_t sx = dx * strideX + kx * p.dilationX - padX;
                                         if (sx < p.srcW)
                                         {
                                             const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -25,6 +25,7 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdMath.h"
 #include "Simd/SimdExtract.h"
+#include "Simd/SimdAvx2.h"
 
 namespace Simd
 {
@@ -503,6 +504,64 @@ namespace Simd
             else
                 assert(0);
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE void LayerNorm32f(const float* src, size_t size, const float* scale, const float* shift, float k, float eps, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i;
+            __m256 _sum = _mm256_setzero_ps();
+            for (i = 0; i < sizeF; i += F)
+                _sum = _mm256_add_ps(_mm256_loadu_ps(src + i), _sum);
+            float sum = Avx::ExtractSum(_sum);
+            for (; i < size; ++i)
+                sum += src[i];
+            float mean = sum * k;
+            __m256 _mean = _mm256_set1_ps(mean), _sqsum = _mm256_setzero_ps();
+            for (i = 0; i < sizeF; i += F)
+            {
+                __m256 _dst = _mm256_sub_ps(_mm256_loadu_ps(src + i), _mean);
+                _mm256_storeu_ps(dst + i, _dst);
+                _sqsum = _mm256_fmadd_ps(_dst, _dst, _sqsum);
+            }
+            float sqsum = Avx::ExtractSum(_sqsum);
+            for (; i < size; ++i)
+            {
+                dst[i] = src[i] - mean;
+                sqsum += Simd::Square(dst[i]);
+            }
+            float norm = 1.0f / ::sqrt(sqsum * k + eps);
+            __m256 _norm = _mm256_set1_ps(norm);
+            for (i = 0; i < sizeF; i += F)
+                _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_mul_ps(_mm256_loadu_ps(dst + i), _norm), _mm256_loadu_ps(scale + i), _mm256_loadu_ps(shift + i)));
+            for (; i < size; ++i)
+                dst[i] = dst[i] * norm * scale[i] + shift[i];
+        }
+
+        void SynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst)
+        {
+            float k = 1.0f / float(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                LayerNorm32f(src, size, scale, shift, k, *eps, dst);
+                src += size;
+                dst += size;
+            }
+        }
+
+        void SynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst)
+        {
+            float k = 1.0f / float(size);
+            Array32f buf(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                BFloat16ToFloat32(src, size, buf.data);
+                LayerNorm32f(buf.data, size, scale, shift, k, *eps, buf.data);
+                Float32ToBFloat16(buf.data, size, dst);
+                src += size;
+                dst += size;
+            }
+        }
     }
 #endif
 }
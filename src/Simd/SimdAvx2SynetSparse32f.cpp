@@ -0,0 +1,181 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetSparse32f.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdCpu.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx2
+    {
+        const size_t SF = SynetSparse32f::F, SKb = SynetSparse32f::Kb;
+
+        SIMD_INLINE void SynetSparse32fSave(float* dst, __m256 d0, __m256 d1, size_t size)
+        {
+            if (size == SF)
+            {
+                _mm256_storeu_ps(dst + 0, d0);
+                _mm256_storeu_ps(dst + F, d1);
+            }
+            else
+            {
+                _mm256_maskstore_ps(dst + 0, LeftNotZero32i(size), d0);
+                _mm256_maskstore_ps(dst + F, LeftNotZero32i(size - F), d1);
+            }
+        }
+
+        static void SynetSparse32fGemm1x16(const float* src, const int32_t* index, size_t body, size_t tail, const float* weight, const float* bias, float* dst, size_t size)
+        {
+            __m256 d00 = _mm256_loadu_ps(bias + 0), d01 = _mm256_loadu_ps(bias + F), d10 = _mm256_setzero_ps(), d11 = _mm256_setzero_ps(), s0, s1;
+            for (size_t b = 0; b < body; ++b, weight += SKb * SF)
+            {
+                const float* ps = src + index[b];
+                s0 = _mm256_set1_ps(ps[0]);
+                d00 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 0 * SF + 0), s0, d00);
+                d01 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 0 * SF + F), s0, d01);
+                s1 = _mm256_set1_ps(ps[1]);
+                d10 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 1 * SF + 0), s1, d10);
+                d11 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 1 * SF + F), s1, d11);
+                s0 = _mm256_set1_ps(ps[2]);
+                d00 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 2 * SF + 0), s0, d00);
+                d01 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 2 * SF + F), s0, d01);
+                s1 = _mm256_set1_ps(ps[3]);
+                d10 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 3 * SF + 0), s1, d10);
+                d11 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 3 * SF + F), s1, d11);
+            }
+            if (tail)
+            {
+                const float* ps = src + index[body];
+                for (size_t k = 0; k < tail; ++k, weight += SF)
+                {
+                    s0 = _mm256_set1_ps(ps[k]);
+                    d00 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + 0), s0, d00);
+                    d01 = _mm256_fmadd_ps(_mm256_loadu_ps(weight + F), s0, d01);
+                }
+            }
+            SynetSparse32fSave(dst, _mm256_add_ps(d00, d10), _mm256_add_ps(d01, d11), size);
+        }
+
+        template<int M> void SynetSparse32fGemmMx16(const float* src, size_t ldS, const int32_t* index, size_t body, size_t tail, const float* weight, const float* bias, float* dst, size_t ldD, size_t size)
+        {
+            __m256 d00, d01, d10, d11, d20, d21, d30, d31, d40, d41, d50, d51, s0, w0, w1;
+            d00 = _mm256_loadu_ps(bias + 0);
+            d01 = _mm256_loadu_ps(bias + F);
+            if (M > 1) d10 = d00, d11 = d01;
+            if (M > 2) d20 = d00, d21 = d01;
+            if (M > 3) d30 = d00, d31 = d01;
+            if (M > 4) d40 = d00, d41 = d01;
+            if (M > 5) d50 = d00, d51 = d01;
+            for (size_t b = 0; b < body; ++b)
+            {
+                const float* ps = src + index[b];
+                for (size_t k = 0; k < SKb; ++k, weight += SF)
+                {
+                    w0 = _mm256_loadu_ps(weight + 0);
+                    w1 = _mm256_loadu_ps(weight + F);
+                    s0 = _mm256_set1_ps(ps[0 * ldS + k]), d00 = _mm256_fmadd_ps(w0, s0, d00), d01 = _mm256_fmadd_ps(w1, s0, d01);
+                    if (M > 1) s0 = _mm256_set1_ps(ps[1 * ldS + k]), d10 = _mm256_fmadd_ps(w0, s0, d10), d11 = _mm256_fmadd_ps(w1, s0, d11);
+                    if (M > 2) s0 = _mm256_set1_ps(ps[2 * ldS + k]), d20 = _mm256_fmadd_ps(w0, s0, d20), d21 = _mm256_fmadd_ps(w1, s0, d21);
+                    if (M > 3) s0 = _mm256_set1_ps(ps[3 * ldS + k]), d30 = _mm256_fmadd_ps(w0, s0, d30), d31 = _mm256_fmadd_ps(w1, s0, d31);
+                    if (M > 4) s0 = _mm256_set1_ps(ps[4 * ldS + k]), d40 = _mm256_fmadd_ps(w0, s0, d40), d41 = _mm256_fmadd_ps(w1, s0, d41);
+                    if (M > 5) s0 = _mm256_set1_ps(ps[5 * ldS + k]), d50 = _mm256_fmadd_ps(w0, s0, d50), d51 = _mm256_fmadd_ps(w1, s0, d51);
+                }
+            }
+            if (tail)
+            {
+                const float* ps = src + index[body];
+                for (size_t k = 0; k < tail; ++k, weight += SF)
+                {
+                    w0 = _mm256_loadu_ps(weight + 0);
+                    w1 = _mm256_loadu_ps(weight + F);
+                    s0 = _mm256_set1_ps(ps[0 * ldS + k]), d00 = _mm256_fmadd_ps(w0, s0, d00), d01 = _mm256_fmadd_ps(w1, s0, d01);
+                    if (M > 1) s0 = _mm256_set1_ps(ps[1 * ldS + k]), d10 = _mm256_fmadd_ps(w0, s0, d10), d11 = _mm256_fmadd_ps(w1, s0, d11);
+                    if (M > 2) s0 = _mm256_set1_ps(ps[2 * ldS + k]), d20 = _mm256_fmadd_ps(w0, s0, d20), d21 = _mm256_fmadd_ps(w1, s0, d21);
+                    if (M > 3) s0 = _mm256_set1_ps(ps[3 * ldS + k]), d30 = _mm256_fmadd_ps(w0, s0, d30), d31 = _mm256_fmadd_ps(w1, s0, d31);
+                    if (M > 4) s0 = _mm256_set1_ps(ps[4 * ldS + k]), d40 = _mm256_fmadd_ps(w0, s0, d40), d41 = _mm256_fmadd_ps(w1, s0, d41);
+                    if (M > 5) s0 = _mm256_set1_ps(ps[5 * ldS + k]), d50 = _mm256_fmadd_ps(w0, s0, d50), d51 = _mm256_fmadd_ps(w1, s0, d51);
+                }
+            }
+            SynetSparse32fSave(dst + 0 * ldD, d00, d01, size);
+            if (M > 1) SynetSparse32fSave(dst + 1 * ldD, d10, d11, size);
+            if (M > 2) SynetSparse32fSave(dst + 2 * ldD, d20, d21, size);
+            if (M > 3) SynetSparse32fSave(dst + 3 * ldD, d30, d31, size);
+            if (M > 4) SynetSparse32fSave(dst + 4 * ldD, d40, d41, size);
+            if (M > 5) SynetSparse32fSave(dst + 5 * ldD, d50, d51, size);
+        }
+
+        typedef void(*SynetSparse32fGemmMx16Ptr)(const float* src, size_t ldS, const int32_t* index, size_t body, size_t tail, const float* weight, const float* bias, float* dst, size_t ldD, size_t size);
+
+        SIMD_INLINE SynetSparse32fGemmMx16Ptr GetSynetSparse32fGemmMx16(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return SynetSparse32fGemmMx16<1>;
+            case 2: return SynetSparse32fGemmMx16<2>;
+            case 3: return SynetSparse32fGemmMx16<3>;
+            case 4: return SynetSparse32fGemmMx16<4>;
+            case 5: return SynetSparse32fGemmMx16<5>;
+            case 6: return SynetSparse32fGemmMx16<6>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        void SynetSparse32fGemm(const float* src, size_t M, size_t ldS, const SynetSparse32f& weight, const float* bias, float* dst, size_t ldD)
+        {
+            const size_t R = 6;
+            size_t K = weight.K, N = weight.N, mBlock = Simd::Max(AlignLoAny(Base::AlgCacheL2() / 2 / (K * sizeof(float)), R), R);
+            SynetSparse32fGemmMx16Ptr gemmBody = GetSynetSparse32fGemmMx16(R);
+            float buf[SF];
+            for (size_t mBeg = 0; mBeg < M; mBeg += mBlock)
+            {
+                size_t mEnd = Simd::Min(M, mBeg + mBlock), mBody = mBeg + AlignLoAny(mEnd - mBeg, R);
+                SynetSparse32fGemmMx16Ptr gemmTail = GetSynetSparse32fGemmMx16(mEnd - mBody);
+                for (size_t n = 0, t = 0; n < N; n += SF, t += 1)
+                {
+                    size_t size = Simd::Min(N - n, SF), beg = weight.offset[t], body = weight.offset[t + 1] - beg, tail = 0;
+                    const int32_t* idx = weight.index.data + beg;
+                    const float* w = weight.weight.data + beg * SKb * SF;
+                    if (body && idx[body - 1] + SKb > K)
+                        tail = K - idx[--body];
+                    for (size_t f = 0; f < SF; ++f)
+                        buf[f] = bias && f < size ? bias[n + f] : 0.0f;
+                    if (M == 1)
+                    {
+                        SynetSparse32fGemm1x16(src, idx, body, tail, w, buf, dst + n, size);
+                        continue;
+                    }
+                    size_t m = mBeg;
+                    for (; m < mBody; m += R)
+                        gemmBody(src + m * ldS, ldS, idx, body, tail, w, buf, dst + m * ldD + n, ldD, size);
+                    if (gemmTail)
+                        gemmTail(src + m * ldS, ldS, idx, body, tail, w, buf, dst + m * ldD + n, ldD, size);
+                }
+            }
+        }
+    }
+#endif
+}
@@ -222,6 +222,8 @@ namespace Simd
 
         void BFloat16ToFloat32(const uint16_t* src, size_t size, float* dst);
 
+        void RoundToBFloat16(const float* src, size_t size, float* dst);
+
         void Float32ToFloat16(const float * src, size_t size, uint16_t * dst);
 
         void Float16ToFloat32(const uint16_t * src, size_t size, float * dst);
@@ -559,6 +561,10 @@ namespace Simd
         void SynetNormalizeLayerForwardV3(const float* src, size_t batch, size_t channels, size_t spatial,
             const float* scale, const float* shift, const float* eps, SimdTensorFormatType format, float* buf, float* dst);
 
+        void SynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst);
+
+        void SynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst);
+
         void SynetPoolingAverage(const float* src, size_t srcC, size_t srcH, size_t srcW, size_t kernelY, size_t kernelX,
             size_t strideY, size_t strideX, size_t padY, size_t padX, float* dst, size_t dstH, size_t dstW, SimdBool excludePad, SimdTensorFormatType format);
 
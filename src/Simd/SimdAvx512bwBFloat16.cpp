@@ -74,6 +74,20 @@ namespace Simd
                 BFloat16ToFloat32<false, true>(src + i, dst + i, srcMask, dstMask);
             }
         }
+
+        //---------------------------------------------------------------------------------------------
+
+        void RoundToBFloat16(const float* src, size_t size, float* dst)
+        {
+            size_t sizeF = Simd::AlignLo(size, F), i = 0;
+            for (; i < sizeF; i += F)
+                _mm512_storeu_ps(dst + i, RoundToBFloat16(_mm512_loadu_ps(src + i)));
+            if (i < size)
+            {
+                __mmask16 tail = TailMask16(size - sizeF);
+                _mm512_mask_storeu_ps(dst + i, tail, RoundToBFloat16(_mm512_maskz_loadu_ps(tail, src + i)));
+            }
+        }
     }
 #endif
 }
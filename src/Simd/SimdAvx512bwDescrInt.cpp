@@ -158,6 +158,11 @@ namespace Simd
         DescrInt::DescrInt(size_t size, size_t depth)
             : Avx2::DescrInt(size, depth)
         {
+            if (_depth < 4)
+            {
+                _cosineDistance = GetCosineDistanceBits(_depth);
+                return;
+            }
             _minMax32f = MinMax32f;
             _minMax16f = MinMax16f;
             _encode32f = GetEncode32f(_depth);
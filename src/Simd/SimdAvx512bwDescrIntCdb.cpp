@@ -0,0 +1,80 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdDescrInt.h"
+#include "Simd/SimdDescrIntCommon.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX512BW_ENABLE    
+    namespace Avx512bw
+    {
+        SIMD_INLINE __m512i Popcount8(__m512i value)
+        {
+            const __m512i lut = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+            __m512i lo = _mm512_shuffle_epi8(lut, _mm512_and_si512(value, K8_0F));
+            __m512i hi = _mm512_shuffle_epi8(lut, _mm512_and_si512(_mm512_srli_epi16(value, 4), K8_0F));
+            return _mm512_add_epi8(lo, hi);
+        }
+
+        template<int bits> void CosineDistanceBits(const uint8_t* a, const uint8_t* b, size_t size, float* distance)
+        {
+            size_t plane = size / 8, plane64 = AlignLo(plane, 64), i = 0;
+            __mmask64 tail = TailMask64(plane - plane64);
+            const uint8_t* pa = a + 16, * pb = b + 16;
+            __m512i sums[2 * bits - 1], va[bits], vb[bits];
+            for (int k = 0; k < 2 * bits - 1; ++k)
+                sums[k] = _mm512_setzero_si512();
+            for (; i < plane; i += 64)
+            {
+                __mmask64 mask = i < plane64 ? __mmask64(-1) : tail;
+                for (int p = 0; p < bits; ++p)
+                {
+                    va[p] = _mm512_maskz_loadu_epi8(mask, pa + p * plane + i);
+                    vb[p] = _mm512_maskz_loadu_epi8(mask, pb + p * plane + i);
+                }
+                for (int p = 0; p < bits; ++p)
+                    for (int q = 0; q < bits; ++q)
+                        sums[p + q] = _mm512_add_epi64(sums[p + q], _mm512_sad_epu8(Popcount8(_mm512_and_si512(va[p], vb[q])), K_ZERO));
+            }
+            uint32_t abSum = 0;
+            for (int k = 0; k < 2 * bits - 1; ++k)
+                abSum += uint32_t(_mm512_reduce_add_epi64(sums[k])) << k;
+            Base::DecodeCosineDistance(a, b, float(abSum), distance);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        Base::DescrInt::CosineDistancePtr GetCosineDistanceBits(size_t depth)
+        {
+            switch (depth)
+            {
+            case 1: return CosineDistanceBits<1>;
+            case 2: return CosineDistanceBits<2>;
+            case 3: return CosineDistanceBits<3>;
+            default: assert(0); return NULL;
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,137 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdImageLoadPng.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdAvx512bw.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) 
+    namespace Avx512bw
+    {
+        static void DecodeLine2(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        {
+            if (srcN == dstN)
+            {
+                size_t size = size_t(width) * srcN, sizeA = AlignLo(size, A), i = 0;
+                for (; i < sizeA; i += A)
+                {
+                    __m512i _curr = _mm512_loadu_si512((__m512i*)(curr + i));
+                    __m512i _prev = _mm512_loadu_si512((__m512i*)(prev + i));
+                    _mm512_storeu_si512((__m512i*)(dst + i), _mm512_add_epi8(_curr, _prev));
+                }
+                if (i < size)
+                {
+                    __mmask64 tail = TailMask64(size - i);
+                    __m512i _curr = _mm512_maskz_loadu_epi8(tail, curr + i);
+                    __m512i _prev = _mm512_maskz_loadu_epi8(tail, prev + i);
+                    _mm512_mask_storeu_epi8(dst + i, tail, _mm512_add_epi8(_curr, _prev));
+                }
+            }
+            else
+                Base::DecodeLine2(curr, prev, width, srcN, dstN, dst);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        static void ExpandPalette(const uint8_t* src, size_t size, int outN, const uint8_t* palette, uint8_t* dst)
+        {
+            if (outN == 4)
+            {
+                size_t size16 = AlignLo(size, 16), i = 0;
+                for (; i < size16; i += 16)
+                {
+                    __m512i index = _mm512_cvtepu8_epi32(_mm_loadu_si128((__m128i*)(src + i)));
+                    _mm512_storeu_si512((__m512i*)(dst + i * 4), _mm512_i32gather_epi32(index, palette, 4));
+                }
+                if (i < size)
+                {
+                    __mmask16 tail = TailMask16(size - i);
+                    __m512i index = _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(tail, src + i));
+                    _mm512_mask_storeu_epi32(dst + i * 4, tail, _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), tail, index, palette, 4));
+                }
+            }
+            else
+                Base::ExpandPalette(src, size, outN, palette, dst);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        static Base::ImagePngLoader::ConverterPtr GetConverter(int channels, SimdPixelFormatType format)
+        {
+            switch (channels)
+            {
+            case 1:
+                switch (format)
+                {
+                case SimdPixelFormatGray8: return Base::PngCopy<1>;
+                case SimdPixelFormatBgr24: return Avx512bw::GrayToBgr;
+                case SimdPixelFormatRgb24: return Avx512bw::GrayToBgr;
+                case SimdPixelFormatBgra32: return Base::PngToOpaque<Avx512bw::GrayToBgra>;
+                case SimdPixelFormatRgba32: return Base::PngToOpaque<Avx512bw::GrayToBgra>;
+                default: return NULL;
+                }
+            case 3:
+                switch (format)
+                {
+                case SimdPixelFormatBgr24: return Avx512bw::BgrToRgb;
+                case SimdPixelFormatRgb24: return Base::PngCopy<3>;
+                case SimdPixelFormatBgra32: return Base::PngToOpaque<Avx512bw::RgbToBgra>;
+                case SimdPixelFormatRgba32: return Base::PngToOpaque<Avx512bw::BgrToBgra>;
+                default: return NULL;
+                }
+            case 4:
+                switch (format)
+                {
+                case SimdPixelFormatBgr24: return Avx512bw::BgraToRgb;
+                case SimdPixelFormatRgb24: return Avx512bw::BgraToBgr;
+                case SimdPixelFormatBgra32: return Avx512bw::BgraToRgba;
+                case SimdPixelFormatRgba32: return Base::PngCopy<4>;
+                default: return NULL;
+                }
+            default:
+                return NULL;
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        ImagePngLoader::ImagePngLoader(const ImageLoaderParam& param)
+            : Avx2::ImagePngLoader(param)
+        {
+            _decodeLine[2] = Avx512bw::DecodeLine2;
+            if (!Avx2::SlowGather)
+                _expandPalette = Avx512bw::ExpandPalette;
+        }
+
+        void ImagePngLoader::SetConverter()
+        {
+            _converter = _depth <= 8 && _width >= A ? GetConverter(_outN, _param.format) : NULL;
+            if (_converter == NULL)
+                Avx2::ImagePngLoader::SetConverter();
+        }
+    }
+#endif
+}
@@ -137,7 +137,7 @@ namespace Simd
             assert(_xn == 0 && _xt == _param.dstW);
             size_t step = 4 / N * 4;
             size_t body = AlignLoAny(_param.dstW, step);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -191,7 +191,7 @@ namespace Simd
             size_t step = 16;
             size_t body = AlignLoAny(_param.dstW, step);
             __mmask16 tail = TailMask16(_param.dstW - body);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -251,7 +251,7 @@ namespace Simd
             size_t step = 8;
             size_t body = AlignLoAny(_param.dstW, step);
             __mmask8 tail = TailMask8(_param.dstW - body);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -322,7 +322,7 @@ namespace Simd
             srcMaskTail[3] = tail > 3 ? 0x7 : 0x0;
             srcMaskTail[4] = TailMask8(tail);
             __mmask16 dstMaskTail = TailMask16(tail * 3);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -392,7 +392,7 @@ namespace Simd
             srcMaskTail[3] = tail > 3 ? 0xF : 0x0;
             srcMaskTail[4] = TailMask8(tail);
             __mmask16 dstMaskTail = TailMask16(tail * 4);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 size_t sy = _iy[dy];
                 const uint8_t* src1 = src + sy * srcStride;
@@ -517,9 +517,9 @@ namespace Simd
             __mmask16 rowTail = TailMask16(_bx[0].size - rowBody);
 
             int32_t prev = -1;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
-                int32_t sy = _iy[dy], next = prev;
+                int32_t sy = _iy[dy], next = Simd::Max(prev, sy - 1);
                 for (int32_t curr = sy - 1, end = sy + 3; curr < end; ++curr)
                 {
                     if (curr < prev)
@@ -572,9 +572,9 @@ namespace Simd
             __mmask16 rowTail = TailMask16(_bx[0].size - rowBody);
 
             int32_t prev = -1;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
-                int32_t sy = _iy[dy], next = prev;
+                int32_t sy = _iy[dy], next = Simd::Max(prev, sy - 1);
                 for (int32_t curr = sy - 1, end = sy + 3; curr < end; ++curr)
                 {
                     if (curr < prev)
@@ -0,0 +1,234 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetAttention32f.h"
+#include "Simd/SimdExp.h"
+#include "Simd/SimdAvx512bw.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx512bw
+    {
+        SIMD_INLINE void Save2(float* C, __m512 c0, __m512 c1, __mmask16 tail, int update)
+        {
+            if (update)
+            {
+                c0 = _mm512_add_ps(_mm512_loadu_ps(C + 0), c0);
+                c1 = _mm512_add_ps(_mm512_maskz_loadu_ps(tail, C + F), c1);
+            }
+            _mm512_storeu_ps(C + 0, c0);
+            _mm512_mask_storeu_ps(C + F, tail, c1);
+        }
+
+        template<int M> void AttentionMul_2xM(size_t K, const float* A0, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, __mmask16 tail, int update)
+        {
+            __m512 c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51, c60, c61, c70, c71, c80, c81, c90, c91, cA0, cA1, cB0, cB1, b0, b1, a0;
+            const float* A1 = A0 + 1 * strideM;
+            const float* A2 = A0 + 2 * strideM;
+            const float* A3 = A0 + 3 * strideM;
+            const float* A4 = A0 + 4 * strideM;
+            const float* A5 = A0 + 5 * strideM;
+            const float* A6 = A0 + 6 * strideM;
+            const float* A7 = A0 + 7 * strideM;
+            const float* A8 = A0 + 8 * strideM;
+            const float* A9 = A0 + 9 * strideM;
+            const float* AA = A0 + 10 * strideM;
+            const float* AB = A0 + 11 * strideM;
+            if (M > 0) c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+            if (M > 1) c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+            if (M > 2) c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+            if (M > 3) c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+            if (M > 4) c40 = _mm512_setzero_ps(), c41 = _mm512_setzero_ps();
+            if (M > 5) c50 = _mm512_setzero_ps(), c51 = _mm512_setzero_ps();
+            if (M > 6) c60 = _mm512_setzero_ps(), c61 = _mm512_setzero_ps();
+            if (M > 7) c70 = _mm512_setzero_ps(), c71 = _mm512_setzero_ps();
+            if (M > 8) c80 = _mm512_setzero_ps(), c81 = _mm512_setzero_ps();
+            if (M > 9) c90 = _mm512_setzero_ps(), c91 = _mm512_setzero_ps();
+            if (M > 10) cA0 = _mm512_setzero_ps(), cA1 = _mm512_setzero_ps();
+            if (M > 11) cB0 = _mm512_setzero_ps(), cB1 = _mm512_setzero_ps();
+            for (size_t k = 0, o = 0; k < K; ++k, o += strideK)
+            {
+                b0 = _mm512_loadu_ps(B + 0);
+                b1 = _mm512_maskz_loadu_ps(tail, B + F);
+                if (M > 0) a0 = _mm512_set1_ps(A0[o]), c00 = _mm512_fmadd_ps(a0, b0, c00), c01 = _mm512_fmadd_ps(a0, b1, c01);
+                if (M > 1) a0 = _mm512_set1_ps(A1[o]), c10 = _mm512_fmadd_ps(a0, b0, c10), c11 = _mm512_fmadd_ps(a0, b1, c11);
+                if (M > 2) a0 = _mm512_set1_ps(A2[o]), c20 = _mm512_fmadd_ps(a0, b0, c20), c21 = _mm512_fmadd_ps(a0, b1, c21);
+                if (M > 3) a0 = _mm512_set1_ps(A3[o]), c30 = _mm512_fmadd_ps(a0, b0, c30), c31 = _mm512_fmadd_ps(a0, b1, c31);
+                if (M > 4) a0 = _mm512_set1_ps(A4[o]), c40 = _mm512_fmadd_ps(a0, b0, c40), c41 = _mm512_fmadd_ps(a0, b1, c41);
+                if (M > 5) a0 = _mm512_set1_ps(A5[o]), c50 = _mm512_fmadd_ps(a0, b0, c50), c51 = _mm512_fmadd_ps(a0, b1, c51);
+                if (M > 6) a0 = _mm512_set1_ps(A6[o]), c60 = _mm512_fmadd_ps(a0, b0, c60), c61 = _mm512_fmadd_ps(a0, b1, c61);
+                if (M > 7) a0 = _mm512_set1_ps(A7[o]), c70 = _mm512_fmadd_ps(a0, b0, c70), c71 = _mm512_fmadd_ps(a0, b1, c71);
+                if (M > 8) a0 = _mm512_set1_ps(A8[o]), c80 = _mm512_fmadd_ps(a0, b0, c80), c81 = _mm512_fmadd_ps(a0, b1, c81);
+                if (M > 9) a0 = _mm512_set1_ps(A9[o]), c90 = _mm512_fmadd_ps(a0, b0, c90), c91 = _mm512_fmadd_ps(a0, b1, c91);
+                if (M > 10) a0 = _mm512_set1_ps(AA[o]), cA0 = _mm512_fmadd_ps(a0, b0, cA0), cA1 = _mm512_fmadd_ps(a0, b1, cA1);
+                if (M > 11) a0 = _mm512_set1_ps(AB[o]), cB0 = _mm512_fmadd_ps(a0, b0, cB0), cB1 = _mm512_fmadd_ps(a0, b1, cB1);
+                B += ldb;
+            }
+            if (M > 0) Save2(C, c00, c01, tail, update), C += ldc;
+            if (M > 1) Save2(C, c10, c11, tail, update), C += ldc;
+            if (M > 2) Save2(C, c20, c21, tail, update), C += ldc;
+            if (M > 3) Save2(C, c30, c31, tail, update), C += ldc;
+            if (M > 4) Save2(C, c40, c41, tail, update), C += ldc;
+            if (M > 5) Save2(C, c50, c51, tail, update), C += ldc;
+            if (M > 6) Save2(C, c60, c61, tail, update), C += ldc;
+            if (M > 7) Save2(C, c70, c71, tail, update), C += ldc;
+            if (M > 8) Save2(C, c80, c81, tail, update), C += ldc;
+            if (M > 9) Save2(C, c90, c91, tail, update), C += ldc;
+            if (M > 10) Save2(C, cA0, cA1, tail, update), C += ldc;
+            if (M > 11) Save2(C, cB0, cB1, tail, update), C += ldc;
+        }
+
+        typedef void(*AttentionMul_2xM_Ptr)(size_t K, const float* A0, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, __mmask16 tail, int update);
+
+        AttentionMul_2xM_Ptr GetAttentionMul_2xM(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return AttentionMul_2xM<1>;
+            case 2: return AttentionMul_2xM<2>;
+            case 3: return AttentionMul_2xM<3>;
+            case 4: return AttentionMul_2xM<4>;
+            case 5: return AttentionMul_2xM<5>;
+            case 6: return AttentionMul_2xM<6>;
+            case 7: return AttentionMul_2xM<7>;
+            case 8: return AttentionMul_2xM<8>;
+            case 9: return AttentionMul_2xM<9>;
+            case 10: return AttentionMul_2xM<10>;
+            case 11: return AttentionMul_2xM<11>;
+            case 12: return AttentionMul_2xM<12>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        static void AttentionMul(size_t M, size_t N, size_t K, const float* A, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, int update)
+        {
+            size_t m = 12, MM = AlignLoAny(M, m), tail = M - MM;
+            AttentionMul_2xM_Ptr mul_2xM = GetAttentionMul_2xM(m);
+            AttentionMul_2xM_Ptr mul_2xT = GetAttentionMul_2xM(tail);
+            assert(N % F == 0);
+            for (size_t j = 0; j < N; j += DF)
+            {
+                __mmask16 mask = N - j > F ? __mmask16(-1) : __mmask16(0);
+                size_t i = 0;
+                for (; i < MM; i += m)
+                    mul_2xM(K, A + i * strideM, strideM, strideK, B + j, ldb, C + i * ldc + j, ldc, mask, update);
+                if (tail)
+                    mul_2xT(K, A + i * strideM, strideM, strideK, B + j, ldb, C + i * ldc + j, ldc, mask, update);
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE __mmask16 ValidMask(ptrdiff_t beg, size_t i)
+        {
+            if (beg <= (ptrdiff_t)i)
+                return __mmask16(-1);
+            if (beg >= ptrdiff_t(i + F))
+                return __mmask16(0);
+            return __mmask16(0xFFFF << (beg - (ptrdiff_t)i));
+        }
+
+        static void AttentionSoftmax(float* src, size_t stride, size_t rows, size_t cols, ptrdiff_t first, float scale, float* max, float* sum, float* corr)
+        {
+            assert(cols % F == 0);
+            const __m512 _scale = _mm512_set1_ps(scale);
+            for (size_t i = 0; i < cols; i += F)
+                _mm512_storeu_ps(corr + i, _mm512_loadu_ps(max + i));
+            for (size_t j = 0; j < rows; ++j)
+            {
+                float* s = src + j * stride;
+                ptrdiff_t beg = first + j;
+                for (size_t i = 0; i < cols; i += F)
+                {
+                    __m512 _s = _mm512_mul_ps(_mm512_loadu_ps(s + i), _scale);
+                    _mm512_storeu_ps(s + i, _s);
+                    __m512 _max = _mm512_loadu_ps(corr + i);
+                    _mm512_storeu_ps(corr + i, _mm512_mask_max_ps(_max, ValidMask(beg, i), _max, _s));
+                }
+            }
+            Exp exp;
+            for (size_t i = 0; i < cols; i += F)
+            {
+                __m512 _new = _mm512_loadu_ps(corr + i);
+                __m512 _corr = exp.Exponent(_mm512_sub_ps(_mm512_loadu_ps(max + i), _new));
+                _mm512_storeu_ps(corr + i, _corr);
+                _mm512_storeu_ps(sum + i, _mm512_mul_ps(_mm512_loadu_ps(sum + i), _corr));
+                _mm512_storeu_ps(max + i, _new);
+            }
+            for (size_t j = 0; j < rows; ++j)
+            {
+                float* s = src + j * stride;
+                ptrdiff_t beg = first + j;
+                for (size_t i = 0; i < cols; i += F)
+                {
+                    __mmask16 valid = ValidMask(beg, i);
+                    __m512 e = _mm512_setzero_ps();
+                    if (valid)
+                    {
+                        e = _mm512_maskz_mov_ps(valid, exp.Exponent(_mm512_sub_ps(_mm512_loadu_ps(s + i), _mm512_loadu_ps(max + i))));
+                        _mm512_storeu_ps(sum + i, _mm512_add_ps(_mm512_loadu_ps(sum + i), e));
+                    }
+                    _mm512_storeu_ps(s + i, e);
+                }
+            }
+        }
+
+        static void AttentionScale(const float* src, size_t size, float scale, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m512 _scale = _mm512_set1_ps(scale);
+            for (; i < sizeF; i += F)
+                _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(src + i), _scale));
+            if (i < size)
+            {
+                __mmask16 tail = TailMask16(size - sizeF);
+                _mm512_mask_storeu_ps(dst + i, tail, _mm512_mul_ps(_mm512_maskz_loadu_ps(tail, src + i), _scale));
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetAttention32f::SynetAttention32f(const AttentionParam32f& p)
+            : Avx2::SynetAttention32f(p)
+        {
+            _mul = AttentionMul;
+            _softmax = AttentionSoftmax;
+            _scale = AttentionScale;
+            _round = RoundToBFloat16;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility)
+        {
+            AttentionParam32f param(batch, heads, lenQ, lenKV, depth, scale, causal, compatibility);
+            if (!param.Valid())
+                return NULL;
+            return new SynetAttention32f(param);
+        }
+    }
+#endif
+}
@@ -22,6 +22,7 @@
 * SOFTWARE.
 */
 #include "Simd/SimdSynetConvolution32f.h"
+#include "Simd/SimdSynetInnerProduct32f.h"
 #include "Simd/SimdAvx512bw.h"
 #include "Simd/SimdSynet.h"
 #include "Simd/SimdExp.h"
@@ -615,12 +616,12 @@ namespace Simd
             }
             if (p.dstC == 8)
                 return;
-            _gemm.Init(InitGemmFuncs(Avx512bw::Gemm32fNN, "Avx512bw"));
+            _gemm.Init(InitGemmFuncs(Avx512bw::Gemm32fNN, "Avx512bw"), "Gemm32fNN");
             if (_param.trans && _param.group == 1)
             {
                 if (GemmRuntime())
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Avx512bw::Gemm32fNNcbBufferSize, Avx512bw::Gemm32fNNcbReorderB, Avx512bw::Gemm32fNNcbRun, "Avx512bw", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Avx512bw::Gemm32fNNcbBufferSize, Avx512bw::Gemm32fNNcbReorderB, Avx512bw::Gemm32fNNcbRun, "Avx512bw", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcWeight.Resize(_gemmCb.At(0).BufferSize(_M * _merge, _N, _K));
                 }
                 else
@@ -708,7 +709,7 @@ namespace Simd
         SynetConvolution32fGemmNT::SynetConvolution32fGemmNT(const ConvParam32f& p)
             : Avx2::SynetConvolution32fGemmNT(p)
         {
-            _gemm.Init(InitGemmFuncs(Avx512bw::Gemm32fNT, "Avx512bw"));
+            _gemm.Init(InitGemmFuncs(Avx512bw::Gemm32fNT, "Avx512bw"), "Gemm32fNT");
             _biasAndActivation = Avx512bw::ConvolutionBiasAndActivation;
         }
 
@@ -781,12 +782,12 @@ namespace Simd
             }
             else
                 assert(0);
-            _gemm.Init(InitGemmFuncs(Avx512bw::Gemm32fNN, "Avx512bw"));
+            _gemm.Init(InitGemmFuncs(Avx512bw::Gemm32fNN, "Avx512bw"), "Gemm32fNN");
             if (_param.trans)
             {
                 if (NHWC_GEMM_RUNTIME)
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Avx512bw::Gemm32fNNcbBufferSize, Avx512bw::Gemm32fNNcbReorderB, Avx512bw::Gemm32fNNcbRun, "Avx512bw", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Avx512bw::Gemm32fNNcbBufferSize, Avx512bw::Gemm32fNNcbReorderB, Avx512bw::Gemm32fNNcbRun, "Avx512bw", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcStrideW = _gemmCb.At(0).BufferSize(_M * _merge, _N, _K);
                 }
                 else
@@ -803,6 +804,8 @@ namespace Simd
         SynetConvolution32fNhwcDirect::SynetConvolution32fNhwcDirect(const ConvParam32f& p)
             : Avx2::SynetConvolution32fNhwcDirect(p)
         {
+            _sparse.gemm = Avx512bw::SynetSparse32fGemm;
+            _biasAndActivation = Avx512bw::ConvolutionBiasAndActivation;
             if (p.dstC <= Avx::F)
                 return;
             //_old.enable = true;
@@ -821,7 +824,7 @@ namespace Simd
                     if (!SetRt(p, funcs.back().alg))
                         return;
                 }
-                _run.Init(funcs);
+                _run.Init(funcs, "NhwcDirect");
             }
         }
 
@@ -838,6 +841,16 @@ namespace Simd
 
         //-----------------------------------------------------------------------------------------
 
+        SynetConvolution32fFp16Nhwc::SynetConvolution32fFp16Nhwc(const ConvParam32f& p)
+            : Avx2::SynetConvolution32fFp16Nhwc(p)
+        {
+            SetSize(DF);
+            _gemm = SynetInnerProduct32fFp16Gemm;
+            _biasAndActivation = Avx512bw::ConvolutionBiasAndActivation;
+        }
+
+        //-----------------------------------------------------------------------------------------
+
         void * SynetConvolution32fInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility)
         {
             ConvParam32f param(batch, conv, compatibility);
@@ -850,6 +863,8 @@ namespace Simd
                 else
                     return new Base::SynetConvolution32fBf16Gemm(param);
             }
+            else if ((Base::Fp16Soft(compatibility) || Base::Fp16Hard(compatibility)) && Base::SynetConvolution32fFp16Nhwc::Preferable(param))
+                return new SynetConvolution32fFp16Nhwc(param);
             else if (Avx::SynetConvolution32fDepthwiseDotProduct::Preferable(param))
                 return new Avx::SynetConvolution32fDepthwiseDotProduct(param);
             else if (SynetConvolution32fWinograd::Preferable(param))
@@ -0,0 +1,297 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetConvolution8iCommon.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdMath.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx512bw
+    {
+        SIMD_INLINE void WinogradKernel3x3Block2x2SetInput8i32(const uint8_t* const* src, size_t c, __mmask32 srcMask, __mmask32 dstMask, int16_t* dst, size_t dstStride)
+        {
+            __m512i s[16], t[16];
+            for (size_t i = 0; i < 16; ++i)
+                s[i] = _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(srcMask, src[i] + c));
+            for (size_t j = 0; j < 4; ++j)
+            {
+                t[0 + j] = _mm512_sub_epi16(s[0 + j], s[8 + j]);
+                t[4 + j] = _mm512_add_epi16(s[4 + j], s[8 + j]);
+                t[8 + j] = _mm512_sub_epi16(s[8 + j], s[4 + j]);
+                t[12 + j] = _mm512_sub_epi16(s[4 + j], s[12 + j]);
+            }
+            for (size_t i = 0; i < 16; i += 4)
+            {
+                _mm512_mask_storeu_epi16(dst + (i + 0) * dstStride, dstMask, _mm512_sub_epi16(t[i + 0], t[i + 2]));
+                _mm512_mask_storeu_epi16(dst + (i + 1) * dstStride, dstMask, _mm512_add_epi16(t[i + 1], t[i + 2]));
+                _mm512_mask_storeu_epi16(dst + (i + 2) * dstStride, dstMask, _mm512_sub_epi16(t[i + 2], t[i + 1]));
+                _mm512_mask_storeu_epi16(dst + (i + 3) * dstStride, dstMask, _mm512_sub_epi16(t[i + 1], t[i + 3]));
+            }
+        }
+
+        static void WinogradKernel3x3Block2x2SetInput8i(const uint8_t* src, const ConvParam8i& p, const uint8_t* zero, size_t tileW, size_t tyBeg, size_t tyEnd, int16_t* dst, size_t dstStride)
+        {
+            size_t srcC2 = AlignHi(p.srcC, 2), srcC32 = AlignLo(p.srcC, 32);
+            __mmask32 srcTail = TailMask32(p.srcC - srcC32), dstTail = TailMask32(srcC2 - srcC32);
+            const uint8_t* ptrs[16];
+            for (size_t ty = tyBeg; ty < tyEnd; ++ty)
+            {
+                for (size_t tx = 0; tx < tileW; ++tx)
+                {
+                    Base::WinogradKernel3x3Block2x2SetSrc8i(src, p, zero, ty, tx, ptrs);
+                    size_t c = 0;
+                    for (; c < srcC32; c += 32)
+                        WinogradKernel3x3Block2x2SetInput8i32(ptrs, c, __mmask32(-1), __mmask32(-1), dst + c, dstStride);
+                    if (c < srcC2)
+                        WinogradKernel3x3Block2x2SetInput8i32(ptrs, c, srcTail, dstTail, dst + c, dstStride);
+                    dst += srcC2;
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        template<int M> void WinogradKernel3x3Block2x2Gemm8iMx32(const int16_t* src, size_t K, const int16_t* weight, size_t N, int32_t* dst)
+        {
+            __m512i d00, d01, d10, d11, d20, d21, d30, d31, d40, d41, d50, d51, d60, d61, d70, d71, d80, d81, d90, d91, dA0, dA1, dB0, dB1, s0, w0, w1;
+            const int16_t* src0 = src + 0 * K, * src3 = src + 3 * K, * src6 = src + 6 * K, * src9 = src + 9 * K;
+            if (M > 0) d00 = _mm512_setzero_si512(), d01 = _mm512_setzero_si512();
+            if (M > 1) d10 = _mm512_setzero_si512(), d11 = _mm512_setzero_si512();
+            if (M > 2) d20 = _mm512_setzero_si512(), d21 = _mm512_setzero_si512();
+            if (M > 3) d30 = _mm512_setzero_si512(), d31 = _mm512_setzero_si512();
+            if (M > 4) d40 = _mm512_setzero_si512(), d41 = _mm512_setzero_si512();
+            if (M > 5) d50 = _mm512_setzero_si512(), d51 = _mm512_setzero_si512();
+            if (M > 6) d60 = _mm512_setzero_si512(), d61 = _mm512_setzero_si512();
+            if (M > 7) d70 = _mm512_setzero_si512(), d71 = _mm512_setzero_si512();
+            if (M > 8) d80 = _mm512_setzero_si512(), d81 = _mm512_setzero_si512();
+            if (M > 9) d90 = _mm512_setzero_si512(), d91 = _mm512_setzero_si512();
+            if (M > 10) dA0 = _mm512_setzero_si512(), dA1 = _mm512_setzero_si512();
+            if (M > 11) dB0 = _mm512_setzero_si512(), dB1 = _mm512_setzero_si512();
+            for (size_t k = 0; k < K; k += 2, weight += 2 * N)
+            {
+                w0 = _mm512_loadu_si512((__m512i*)weight + 0);
+                w1 = _mm512_loadu_si512((__m512i*)weight + 1);
+                if (M > 0) s0 = _mm512_set1_epi32(*(int32_t*)(src0 + k)), d00 = _mm512_add_epi32(d00, _mm512_madd_epi16(s0, w0)), d01 = _mm512_add_epi32(d01, _mm512_madd_epi16(s0, w1));
+                if (M > 1) s0 = _mm512_set1_epi32(*(int32_t*)(src0 + 1 * K + k)), d10 = _mm512_add_epi32(d10, _mm512_madd_epi16(s0, w0)), d11 = _mm512_add_epi32(d11, _mm512_madd_epi16(s0, w1));
+                if (M > 2) s0 = _mm512_set1_epi32(*(int32_t*)(src0 + 2 * K + k)), d20 = _mm512_add_epi32(d20, _mm512_madd_epi16(s0, w0)), d21 = _mm512_add_epi32(d21, _mm512_madd_epi16(s0, w1));
+                if (M > 3) s0 = _mm512_set1_epi32(*(int32_t*)(src3 + k)), d30 = _mm512_add_epi32(d30, _mm512_madd_epi16(s0, w0)), d31 = _mm512_add_epi32(d31, _mm512_madd_epi16(s0, w1));
+                if (M > 4) s0 = _mm512_set1_epi32(*(int32_t*)(src3 + 1 * K + k)), d40 = _mm512_add_epi32(d40, _mm512_madd_epi16(s0, w0)), d41 = _mm512_add_epi32(d41, _mm512_madd_epi16(s0, w1));
+                if (M > 5) s0 = _mm512_set1_epi32(*(int32_t*)(src3 + 2 * K + k)), d50 = _mm512_add_epi32(d50, _mm512_madd_epi16(s0, w0)), d51 = _mm512_add_epi32(d51, _mm512_madd_epi16(s0, w1));
+                if (M > 6) s0 = _mm512_set1_epi32(*(int32_t*)(src6 + k)), d60 = _mm512_add_epi32(d60, _mm512_madd_epi16(s0, w0)), d61 = _mm512_add_epi32(d61, _mm512_madd_epi16(s0, w1));
+                if (M > 7) s0 = _mm512_set1_epi32(*(int32_t*)(src6 + 1 * K + k)), d70 = _mm512_add_epi32(d70, _mm512_madd_epi16(s0, w0)), d71 = _mm512_add_epi32(d71, _mm512_madd_epi16(s0, w1));
+                if (M > 8) s0 = _mm512_set1_epi32(*(int32_t*)(src6 + 2 * K + k)), d80 = _mm512_add_epi32(d80, _mm512_madd_epi16(s0, w0)), d81 = _mm512_add_epi32(d81, _mm512_madd_epi16(s0, w1));
+                if (M > 9) s0 = _mm512_set1_epi32(*(int32_t*)(src9 + k)), d90 = _mm512_add_epi32(d90, _mm512_madd_epi16(s0, w0)), d91 = _mm512_add_epi32(d91, _mm512_madd_epi16(s0, w1));
+                if (M > 10) s0 = _mm512_set1_epi32(*(int32_t*)(src9 + 1 * K + k)), dA0 = _mm512_add_epi32(dA0, _mm512_madd_epi16(s0, w0)), dA1 = _mm512_add_epi32(dA1, _mm512_madd_epi16(s0, w1));
+                if (M > 11) s0 = _mm512_set1_epi32(*(int32_t*)(src9 + 2 * K + k)), dB0 = _mm512_add_epi32(dB0, _mm512_madd_epi16(s0, w0)), dB1 = _mm512_add_epi32(dB1, _mm512_madd_epi16(s0, w1));
+            }
+            if (M > 0) _mm512_storeu_si512((__m512i*)(dst + 0 * N) + 0, d00), _mm512_storeu_si512((__m512i*)(dst + 0 * N) + 1, d01);
+            if (M > 1) _mm512_storeu_si512((__m512i*)(dst + 1 * N) + 0, d10), _mm512_storeu_si512((__m512i*)(dst + 1 * N) + 1, d11);
+            if (M > 2) _mm512_storeu_si512((__m512i*)(dst + 2 * N) + 0, d20), _mm512_storeu_si512((__m512i*)(dst + 2 * N) + 1, d21);
+            if (M > 3) _mm512_storeu_si512((__m512i*)(dst + 3 * N) + 0, d30), _mm512_storeu_si512((__m512i*)(dst + 3 * N) + 1, d31);
+            if (M > 4) _mm512_storeu_si512((__m512i*)(dst + 4 * N) + 0, d40), _mm512_storeu_si512((__m512i*)(dst + 4 * N) + 1, d41);
+            if (M > 5) _mm512_storeu_si512((__m512i*)(dst + 5 * N) + 0, d50), _mm512_storeu_si512((__m512i*)(dst + 5 * N) + 1, d51);
+            if (M > 6) _mm512_storeu_si512((__m512i*)(dst + 6 * N) + 0, d60), _mm512_storeu_si512((__m512i*)(dst + 6 * N) + 1, d61);
+            if (M > 7) _mm512_storeu_si512((__m512i*)(dst + 7 * N) + 0, d70), _mm512_storeu_si512((__m512i*)(dst + 7 * N) + 1, d71);
+            if (M > 8) _mm512_storeu_si512((__m512i*)(dst + 8 * N) + 0, d80), _mm512_storeu_si512((__m512i*)(dst + 8 * N) + 1, d81);
+            if (M > 9) _mm512_storeu_si512((__m512i*)(dst + 9 * N) + 0, d90), _mm512_storeu_si512((__m512i*)(dst + 9 * N) + 1, d91);
+            if (M > 10) _mm512_storeu_si512((__m512i*)(dst + 10 * N) + 0, dA0), _mm512_storeu_si512((__m512i*)(dst + 10 * N) + 1, dA1);
+            if (M > 11) _mm512_storeu_si512((__m512i*)(dst + 11 * N) + 0, dB0), _mm512_storeu_si512((__m512i*)(dst + 11 * N) + 1, dB1);
+        }
+
+        template<int M> void WinogradKernel3x3Block2x2Gemm8iMx16(const int16_t* src, size_t K, const int16_t* weight, size_t N, int32_t* dst)
+        {
+            __m512i d00, d10, d20, d30, d40, d50, d60, d70, d80, d90, dA0, dB0, s0, w0;
+            const int16_t* src0 = src + 0 * K, * src3 = src + 3 * K, * src6 = src + 6 * K, * src9 = src + 9 * K;
+            if (M > 0) d00 = _mm512_setzero_si512();
+            if (M > 1) d10 = _mm512_setzero_si512();
+            if (M > 2) d20 = _mm512_setzero_si512();
+            if (M > 3) d30 = _mm512_setzero_si512();
+            if (M > 4) d40 = _mm512_setzero_si512();
+            if (M > 5) d50 = _mm512_setzero_si512();
+            if (M > 6) d60 = _mm512_setzero_si512();
+            if (M > 7) d70 = _mm512_setzero_si512();
+            if (M > 8) d80 = _mm512_setzero_si512();
+            if (M > 9) d90 = _mm512_setzero_si512();
+            if (M > 10) dA0 = _mm512_setzero_si512();
+            if (M > 11) dB0 = _mm512_setzero_si512();
+            for (size_t k = 0; k < K; k += 2, weight += 2 * N)
+            {
+                w0 = _mm512_loadu_si512((__m512i*)weight + 0);
+                if (M > 0) s0 = _mm512_set1_epi32(*(int32_t*)(src0 + k)), d00 = _mm512_add_epi32(d00, _mm512_madd_epi16(s0, w0));
+                if (M > 1) s0 = _mm512_set1_epi32(*(int32_t*)(src0 + 1 * K + k)), d10 = _mm512_add_epi32(d10, _mm512_madd_epi16(s0, w0));
+                if (M > 2) s0 = _mm512_set1_epi32(*(int32_t*)(src0 + 2 * K + k)), d20 = _mm512_add_epi32(d20, _mm512_madd_epi16(s0, w0));
+                if (M > 3) s0 = _mm512_set1_epi32(*(int32_t*)(src3 + k)), d30 = _mm512_add_epi32(d30, _mm512_madd_epi16(s0, w0));
+                if (M > 4) s0 = _mm512_set1_epi32(*(int32_t*)(src3 + 1 * K + k)), d40 = _mm512_add_epi32(d40, _mm512_madd_epi16(s0, w0));
+                if (M > 5) s0 = _mm512_set1_epi32(*(int32_t*)(src3 + 2 * K + k)), d50 = _mm512_add_epi32(d50, _mm512_madd_epi16(s0, w0));
+                if (M > 6) s0 = _mm512_set1_epi32(*(int32_t*)(src6 + k)), d60 = _mm512_add_epi32(d60, _mm512_madd_epi16(s0, w0));
+                if (M > 7) s0 = _mm512_set1_epi32(*(int32_t*)(src6 + 1 * K + k)), d70 = _mm512_add_epi32(d70, _mm512_madd_epi16(s0, w0));
+                if (M > 8) s0 = _mm512_set1_epi32(*(int32_t*)(src6 + 2 * K + k)), d80 = _mm512_add_epi32(d80, _mm512_madd_epi16(s0, w0));
+                if (M > 9) s0 = _mm512_set1_epi32(*(int32_t*)(src9 + k)), d90 = _mm512_add_epi32(d90, _mm512_madd_epi16(s0, w0));
+                if (M > 10) s0 = _mm512_set1_epi32(*(int32_t*)(src9 + 1 * K + k)), dA0 = _mm512_add_epi32(dA0, _mm512_madd_epi16(s0, w0));
+                if (M > 11) s0 = _mm512_set1_epi32(*(int32_t*)(src9 + 2 * K + k)), dB0 = _mm512_add_epi32(dB0, _mm512_madd_epi16(s0, w0));
+            }
+            if (M > 0) _mm512_storeu_si512((__m512i*)(dst + 0 * N) + 0, d00);
+            if (M > 1) _mm512_storeu_si512((__m512i*)(dst + 1 * N) + 0, d10);
+            if (M > 2) _mm512_storeu_si512((__m512i*)(dst + 2 * N) + 0, d20);
+            if (M > 3) _mm512_storeu_si512((__m512i*)(dst + 3 * N) + 0, d30);
+            if (M > 4) _mm512_storeu_si512((__m512i*)(dst + 4 * N) + 0, d40);
+            if (M > 5) _mm512_storeu_si512((__m512i*)(dst + 5 * N) + 0, d50);
+            if (M > 6) _mm512_storeu_si512((__m512i*)(dst + 6 * N) + 0, d60);
+            if (M > 7) _mm512_storeu_si512((__m512i*)(dst + 7 * N) + 0, d70);
+            if (M > 8) _mm512_storeu_si512((__m512i*)(dst + 8 * N) + 0, d80);
+            if (M > 9) _mm512_storeu_si512((__m512i*)(dst + 9 * N) + 0, d90);
+            if (M > 10) _mm512_storeu_si512((__m512i*)(dst + 10 * N) + 0, dA0);
+            if (M > 11) _mm512_storeu_si512((__m512i*)(dst + 11 * N) + 0, dB0);
+        }
+
+        typedef void(*WinogradKernel3x3Block2x2Gemm8iPtr)(const int16_t* src, size_t K, const int16_t* weight, size_t N, int32_t* dst);
+
+        static WinogradKernel3x3Block2x2Gemm8iPtr GetWinogradKernel3x3Block2x2Gemm8iMx32(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return WinogradKernel3x3Block2x2Gemm8iMx32<1>;
+            case 2: return WinogradKernel3x3Block2x2Gemm8iMx32<2>;
+            case 3: return WinogradKernel3x3Block2x2Gemm8iMx32<3>;
+            case 4: return WinogradKernel3x3Block2x2Gemm8iMx32<4>;
+            case 5: return WinogradKernel3x3Block2x2Gemm8iMx32<5>;
+            case 6: return WinogradKernel3x3Block2x2Gemm8iMx32<6>;
+            case 7: return WinogradKernel3x3Block2x2Gemm8iMx32<7>;
+            case 8: return WinogradKernel3x3Block2x2Gemm8iMx32<8>;
+            case 9: return WinogradKernel3x3Block2x2Gemm8iMx32<9>;
+            case 10: return WinogradKernel3x3Block2x2Gemm8iMx32<10>;
+            case 11: return WinogradKernel3x3Block2x2Gemm8iMx32<11>;
+            case 12: return WinogradKernel3x3Block2x2Gemm8iMx32<12>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        static WinogradKernel3x3Block2x2Gemm8iPtr GetWinogradKernel3x3Block2x2Gemm8iMx16(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return WinogradKernel3x3Block2x2Gemm8iMx16<1>;
+            case 2: return WinogradKernel3x3Block2x2Gemm8iMx16<2>;
+            case 3: return WinogradKernel3x3Block2x2Gemm8iMx16<3>;
+            case 4: return WinogradKernel3x3Block2x2Gemm8iMx16<4>;
+            case 5: return WinogradKernel3x3Block2x2Gemm8iMx16<5>;
+            case 6: return WinogradKernel3x3Block2x2Gemm8iMx16<6>;
+            case 7: return WinogradKernel3x3Block2x2Gemm8iMx16<7>;
+            case 8: return WinogradKernel3x3Block2x2Gemm8iMx16<8>;
+            case 9: return WinogradKernel3x3Block2x2Gemm8iMx16<9>;
+            case 10: return WinogradKernel3x3Block2x2Gemm8iMx16<10>;
+            case 11: return WinogradKernel3x3Block2x2Gemm8iMx16<11>;
+            case 12: return WinogradKernel3x3Block2x2Gemm8iMx16<12>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        static void WinogradKernel3x3Block2x2Gemm8i(const int16_t* src, size_t M, size_t K, const int16_t* weight, size_t N, int32_t* dst)
+        {
+            size_t M12 = AlignLoAny(M, 12), N32 = AlignLo(N, 32), j = 0;
+            WinogradKernel3x3Block2x2Gemm8iPtr body32 = WinogradKernel3x3Block2x2Gemm8iMx32<12>;
+            WinogradKernel3x3Block2x2Gemm8iPtr tail32 = GetWinogradKernel3x3Block2x2Gemm8iMx32(M - M12);
+            WinogradKernel3x3Block2x2Gemm8iPtr body16 = WinogradKernel3x3Block2x2Gemm8iMx16<12>;
+            WinogradKernel3x3Block2x2Gemm8iPtr tail16 = GetWinogradKernel3x3Block2x2Gemm8iMx16(M - M12);
+            for (; j < N32; j += 32)
+            {
+                size_t i = 0;
+                for (; i < M12; i += 12)
+                    body32(src + i * K, K, weight + j * 2, N, dst + i * N + j);
+                if (tail32)
+                    tail32(src + i * K, K, weight + j * 2, N, dst + i * N + j);
+            }
+            if (j < N)
+            {
+                size_t i = 0;
+                for (; i < M12; i += 12)
+                    body16(src + i * K, K, weight + j * 2, N, dst + i * N + j);
+                if (tail16)
+                    tail16(src + i * K, K, weight + j * 2, N, dst + i * N + j);
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        SIMD_INLINE void WinogradKernel3x3Block2x2SetOutput8i16(const int32_t* src, size_t srcStride, __m512 norm, __m512 bias, __m512 dst[4])
+        {
+            __m512i t[8];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                __m512i s0 = _mm512_loadu_si512((__m512i*)(src + (0 + j) * srcStride));
+                __m512i s1 = _mm512_loadu_si512((__m512i*)(src + (4 + j) * srcStride));
+                __m512i s2 = _mm512_loadu_si512((__m512i*)(src + (8 + j) * srcStride));
+                __m512i s3 = _mm512_loadu_si512((__m512i*)(src + (12 + j) * srcStride));
+                t[0 + j] = _mm512_add_epi32(_mm512_add_epi32(s0, s1), s2);
+                t[4 + j] = _mm512_sub_epi32(_mm512_sub_epi32(s1, s2), s3);
+            }
+            for (size_t i = 0; i < 2; ++i)
+            {
+                __m512i y0 = _mm512_add_epi32(_mm512_add_epi32(t[i * 4 + 0], t[i * 4 + 1]), t[i * 4 + 2]);
+                __m512i y1 = _mm512_sub_epi32(_mm512_sub_epi32(t[i * 4 + 1], t[i * 4 + 2]), t[i * 4 + 3]);
+                dst[i * 2 + 0] = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_mm512_srai_epi32(y0, 2)), norm, bias);
+                dst[i * 2 + 1] = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_mm512_srai_epi32(y1, 2)), norm, bias);
+            }
+        }
+
+        static void WinogradKernel3x3Block2x2SetOutput8i(const int32_t* src, size_t srcStride, const ConvParam8i& p, size_t tileW, size_t tyBeg, size_t tyEnd, size_t N, const float* norm, const float* bias, float* dst)
+        {
+            __m512 val[4];
+            for (size_t ty = tyBeg; ty < tyEnd; ++ty)
+            {
+                for (size_t tx = 0; tx < tileW; ++tx)
+                {
+                    size_t dy = ty * 2, dx = tx * 2, rows = Simd::Min<size_t>(p.dstH - dy, 2), cols = Simd::Min<size_t>(p.dstW - dx, 2);
+                    float* pDst = dst + (dy * p.dstW + dx) * p.dstC;
+                    for (size_t d = 0; d < p.dstC; d += F)
+                    {
+                        __mmask16 tail = TailMask16(p.dstC - d);
+                        WinogradKernel3x3Block2x2SetOutput8i16(src + d, srcStride, _mm512_maskz_loadu_ps(tail, norm + d), _mm512_maskz_loadu_ps(tail, bias + d), val);
+                        for (size_t r = 0; r < rows; ++r)
+                            for (size_t c = 0; c < cols; ++c)
+                                _mm512_mask_storeu_ps(pDst + (r * p.dstW + c) * p.dstC + d, tail, val[r * 2 + c]);
+                    }
+                    src += N;
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        SynetConvolution8iWinograd::SynetConvolution8iWinograd(const ConvParam8i& p)
+            : Avx2::SynetConvolution8iWinograd(p)
+        {
+            _setInput = WinogradKernel3x3Block2x2SetInput8i;
+            _gemm = WinogradKernel3x3Block2x2Gemm8i;
+            _setOutput = WinogradKernel3x3Block2x2SetOutput8i;
+        }
+    }
+#endif
+}
@@ -38,6 +38,7 @@ namespace Simd
             : Avx2::SynetInnerProduct32fGemm(p)
         {
             _biasAndActivation = Avx512bw::ConvolutionBiasAndActivation;
+            _sparseGemm = Avx512bw::SynetSparse32fGemm;
             if (_param.transpose)
             {
                 if (_param.input > Avx::F)
@@ -58,7 +59,8 @@ namespace Simd
             {
                 _cbRun = Avx512bw::Gemm32fNNcbRun;
                 _cbPack = Avx512bw::Gemm32fNNcbReorderB;
-                _cbWeight.Resize(Avx512bw::Gemm32fNNcbBufferSize(_M, _N, _K, GemmKernelAny, NHWC_GEMM_COMPATIBLE));
+                _cbSize = Avx512bw::Gemm32fNNcbBufferSize(_M, _N, _K, GemmKernelAny, NHWC_GEMM_COMPATIBLE);
+                _cbWeight.Resize(_cbSize);
             }
         }
 
@@ -387,9 +389,16 @@ namespace Simd
 
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation)
         {
-            InnerProductParam32f param(batch, input, output, transpose, activation);
+            return SynetInnerProduct32fInitV2(batch, input, output, transpose, activation, SimdSynetCompatibilityDefault);
+        }
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+        {
+            InnerProductParam32f param(batch, input, output, transpose, activation, compatibility);
             if (!param.Valid())
                 return NULL;
+            if (Base::Fp16Soft(compatibility) || Base::Fp16Hard(compatibility))
+                return new SynetInnerProduct32fFp16(param);
             if (SynetInnerProduct32fProd::Preferable(param))
                 return new SynetInnerProduct32fProd(param);
             else
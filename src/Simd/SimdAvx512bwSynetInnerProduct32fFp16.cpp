@@ -0,0 +1,179 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetInnerProduct32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdCpu.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx512bw
+    {
+        SIMD_INLINE void InnerProduct32fFp16Save(float* dst, __m512 d0, __m512 d1, size_t tail)
+        {
+            if (tail == DF)
+            {
+                _mm512_storeu_ps(dst + 0, d0);
+                _mm512_storeu_ps(dst + F, d1);
+            }
+            else
+            {
+                _mm512_mask_storeu_ps(dst + 0, TailMask16(tail), d0);
+                _mm512_mask_storeu_ps(dst + F, TailMask16(tail - F), d1);
+            }
+        }
+
+        static void InnerProduct32fFp16_1xDF(const float* src, size_t K, const uint16_t* weight, const float* bias, float* dst, size_t tail)
+        {
+            __m512 d00 = _mm512_loadu_ps(bias + 0), d01 = _mm512_loadu_ps(bias + F), d10 = _mm512_setzero_ps(), d11 = _mm512_setzero_ps(), s0, s1;
+            size_t K2 = AlignLo(K, 2), k = 0;
+            for (; k < K2; k += 2, weight += 2 * DF)
+            {
+                s0 = _mm512_set1_ps(src[k + 0]);
+                s1 = _mm512_set1_ps(src[k + 1]);
+                d00 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + 0 * F))), s0, d00);
+                d01 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + 1 * F))), s0, d01);
+                d10 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + 2 * F))), s1, d10);
+                d11 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + 3 * F))), s1, d11);
+            }
+            for (; k < K; k += 1, weight += DF)
+            {
+                s0 = _mm512_set1_ps(src[k]);
+                d00 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + 0 * F))), s0, d00);
+                d01 = _mm512_fmadd_ps(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + 1 * F))), s0, d01);
+            }
+            InnerProduct32fFp16Save(dst, _mm512_add_ps(d00, d10), _mm512_add_ps(d01, d11), tail);
+        }
+
+        template<int M> void InnerProduct32fFp16MxDF(const float* src, size_t K, const uint16_t* weight, const float* bias, float* dst, size_t N, size_t tail)
+        {
+            __m512 d00, d01, d10, d11, d20, d21, d30, d31, d40, d41, d50, d51, d60, d61, d70, d71, d80, d81, d90, d91, da0, da1, db0, db1, s0, w0, w1;
+            d00 = _mm512_loadu_ps(bias + 0);
+            d01 = _mm512_loadu_ps(bias + F);
+            if (M > 1) d10 = d00, d11 = d01;
+            if (M > 2) d20 = d00, d21 = d01;
+            if (M > 3) d30 = d00, d31 = d01;
+            if (M > 4) d40 = d00, d41 = d01;
+            if (M > 5) d50 = d00, d51 = d01;
+            if (M > 6) d60 = d00, d61 = d01;
+            if (M > 7) d70 = d00, d71 = d01;
+            if (M > 8) d80 = d00, d81 = d01;
+            if (M > 9) d90 = d00, d91 = d01;
+            if (M > 10) da0 = d00, da1 = d01;
+            if (M > 11) db0 = d00, db1 = d01;
+            for (size_t k = 0; k < K; k += 1, weight += DF)
+            {
+                w0 = _mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + 0)));
+                w1 = _mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)(weight + F)));
+                s0 = _mm512_set1_ps(src[0 * K + k]), d00 = _mm512_fmadd_ps(w0, s0, d00), d01 = _mm512_fmadd_ps(w1, s0, d01);
+                if (M > 1) s0 = _mm512_set1_ps(src[1 * K + k]), d10 = _mm512_fmadd_ps(w0, s0, d10), d11 = _mm512_fmadd_ps(w1, s0, d11);
+                if (M > 2) s0 = _mm512_set1_ps(src[2 * K + k]), d20 = _mm512_fmadd_ps(w0, s0, d20), d21 = _mm512_fmadd_ps(w1, s0, d21);
+                if (M > 3) s0 = _mm512_set1_ps(src[3 * K + k]), d30 = _mm512_fmadd_ps(w0, s0, d30), d31 = _mm512_fmadd_ps(w1, s0, d31);
+                if (M > 4) s0 = _mm512_set1_ps(src[4 * K + k]), d40 = _mm512_fmadd_ps(w0, s0, d40), d41 = _mm512_fmadd_ps(w1, s0, d41);
+                if (M > 5) s0 = _mm512_set1_ps(src[5 * K + k]), d50 = _mm512_fmadd_ps(w0, s0, d50), d51 = _mm512_fmadd_ps(w1, s0, d51);
+                if (M > 6) s0 = _mm512_set1_ps(src[6 * K + k]), d60 = _mm512_fmadd_ps(w0, s0, d60), d61 = _mm512_fmadd_ps(w1, s0, d61);
+                if (M > 7) s0 = _mm512_set1_ps(src[7 * K + k]), d70 = _mm512_fmadd_ps(w0, s0, d70), d71 = _mm512_fmadd_ps(w1, s0, d71);
+                if (M > 8) s0 = _mm512_set1_ps(src[8 * K + k]), d80 = _mm512_fmadd_ps(w0, s0, d80), d81 = _mm512_fmadd_ps(w1, s0, d81);
+                if (M > 9) s0 = _mm512_set1_ps(src[9 * K + k]), d90 = _mm512_fmadd_ps(w0, s0, d90), d91 = _mm512_fmadd_ps(w1, s0, d91);
+                if (M > 10) s0 = _mm512_set1_ps(src[10 * K + k]), da0 = _mm512_fmadd_ps(w0, s0, da0), da1 = _mm512_fmadd_ps(w1, s0, da1);
+                if (M > 11) s0 = _mm512_set1_ps(src[11 * K + k]), db0 = _mm512_fmadd_ps(w0, s0, db0), db1 = _mm512_fmadd_ps(w1, s0, db1);
+            }
+            InnerProduct32fFp16Save(dst + 0 * N, d00, d01, tail);
+            if (M > 1) InnerProduct32fFp16Save(dst + 1 * N, d10, d11, tail);
+            if (M > 2) InnerProduct32fFp16Save(dst + 2 * N, d20, d21, tail);
+            if (M > 3) InnerProduct32fFp16Save(dst + 3 * N, d30, d31, tail);
+            if (M > 4) InnerProduct32fFp16Save(dst + 4 * N, d40, d41, tail);
+            if (M > 5) InnerProduct32fFp16Save(dst + 5 * N, d50, d51, tail);
+            if (M > 6) InnerProduct32fFp16Save(dst + 6 * N, d60, d61, tail);
+            if (M > 7) InnerProduct32fFp16Save(dst + 7 * N, d70, d71, tail);
+            if (M > 8) InnerProduct32fFp16Save(dst + 8 * N, d80, d81, tail);
+            if (M > 9) InnerProduct32fFp16Save(dst + 9 * N, d90, d91, tail);
+            if (M > 10) InnerProduct32fFp16Save(dst + 10 * N, da0, da1, tail);
+            if (M > 11) InnerProduct32fFp16Save(dst + 11 * N, db0, db1, tail);
+        }
+
+        typedef void(*InnerProduct32fFp16MxDFPtr)(const float* src, size_t K, const uint16_t* weight, const float* bias, float* dst, size_t N, size_t tail);
+
+        SIMD_INLINE InnerProduct32fFp16MxDFPtr GetInnerProduct32fFp16MxDF(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return InnerProduct32fFp16MxDF<1>;
+            case 2: return InnerProduct32fFp16MxDF<2>;
+            case 3: return InnerProduct32fFp16MxDF<3>;
+            case 4: return InnerProduct32fFp16MxDF<4>;
+            case 5: return InnerProduct32fFp16MxDF<5>;
+            case 6: return InnerProduct32fFp16MxDF<6>;
+            case 7: return InnerProduct32fFp16MxDF<7>;
+            case 8: return InnerProduct32fFp16MxDF<8>;
+            case 9: return InnerProduct32fFp16MxDF<9>;
+            case 10: return InnerProduct32fFp16MxDF<10>;
+            case 11: return InnerProduct32fFp16MxDF<11>;
+            case 12: return InnerProduct32fFp16MxDF<12>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        void SynetInnerProduct32fFp16Gemm(const float* src, size_t M, size_t K, const uint16_t* weight, size_t N, const float* bias, float* dst)
+        {
+            const size_t R = 12;
+            size_t mBlock = Simd::Max(AlignLoAny(Base::AlgCacheL2() / 2 / (K * sizeof(float)), R), R);
+            if (M == 1)
+            {
+                for (size_t n = 0; n < N; n += DF)
+                    InnerProduct32fFp16_1xDF(src, K, weight + n * K, bias + n, dst + n, Simd::Min(N - n, DF));
+                return;
+            }
+            InnerProduct32fFp16MxDFPtr body = GetInnerProduct32fFp16MxDF(R);
+            for (size_t mBeg = 0; mBeg < M; mBeg += mBlock)
+            {
+                size_t mEnd = Simd::Min(M, mBeg + mBlock), mBody = mBeg + AlignLoAny(mEnd - mBeg, R);
+                InnerProduct32fFp16MxDFPtr tail = GetInnerProduct32fFp16MxDF(mEnd - mBody);
+                for (size_t n = 0; n < N; n += DF)
+                {
+                    size_t size = Simd::Min(N - n, DF);
+                    const uint16_t* w = weight + n * K;
+                    size_t m = mBeg;
+                    for (; m < mBody; m += R)
+                        body(src + m * K, K, w, bias + n, dst + m * N + n, N, size);
+                    if (tail)
+                        tail(src + m * K, K, w, bias + n, dst + m * N + n, N, size);
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        SynetInnerProduct32fFp16::SynetInnerProduct32fFp16(const InnerProductParam32f& p)
+            : Avx2::SynetInnerProduct32fFp16(p)
+        {
+            SetSize(DF);
+            _gemm = SynetInnerProduct32fFp16Gemm;
+        }
+    }
+#endif
+}
@@ -78,10 +78,10 @@ namespace Simd
                             __m512 sum = _bias;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * p.strideY + ky - padY;
+                                size_t sy = dy * p.strideY + ky * p.dilationY - padY;
                                 for (size_t kx = 0; kx < p.kernelX; ++kx)
                                 {
-                                    size_t sx = dx * p.strideX + kx - padX;
+                                    size_t sx = dx * p.strideX + kx * p.dilationX - padX;
                                     if (sx < p.srcW)
                                     {
                                         const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -105,9 +105,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m512 w0 = _mm512_loadu_ps(pw);
                                     sum0 = Fmadd<nofma>(_mm512_loadu_ps(ps + 0 * ssX), w0, sum0);
@@ -138,9 +138,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m512 w0 = _mm512_loadu_ps(pw);
                                     sum0 = Fmadd<nofma>(_mm512_loadu_ps(ps + 0 * ssX), w0, sum0);
@@ -161,9 +161,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m512 w0 = _mm512_loadu_ps(pw);
                                     sum0 = Fmadd<nofma>(_mm512_loadu_ps(ps + 0 * ssX), w0, sum0);
@@ -179,9 +179,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m512 w0 = _mm512_loadu_ps(pw);
                                     sum = Fmadd<nofma>(_mm512_loadu_ps(ps), w0, sum);
@@ -194,10 +194,10 @@ namespace Simd
                             __m512 sum = _bias;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 for (size_t kx = 0; kx < p.kernelX; ++kx)
                                 {
-                                    size_t sx = dx * strideX + kx - padX;
+                                    size_t sx = dx * strideX + kx * p.dilationX - padX;
                                     if (sx < p.srcW)
                                     {
                                         const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -216,12 +216,12 @@ namespace Simd
                             __m512 sum = _bias;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 if (sy < p.srcH)
                                 {
                                     for (size_t kx = 0; kx < p.kernelX; ++kx)
                                     {
-                                        size_t sx = dx * strideX + kx - padX;
+                                        size_t sx = dx * strideX + kx * p.dilationX - padX;
                                         if (sx < p.srcW)
                                         {
                                             const float* pw = weight + (ky * p.kernelX + kx) * F;
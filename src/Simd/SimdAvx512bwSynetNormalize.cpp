@@ -25,6 +25,7 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdMath.h"
 #include "Simd/SimdExtract.h"
+#include "Simd/SimdAvx512bw.h"
 
 namespace Simd
 {
@@ -530,6 +531,63 @@ namespace Simd
             else
                 assert(0);
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE void LayerNorm32f(const float* src, size_t size, const float* scale, const float* shift, float k, float eps, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i;
+            __mmask16 tail = TailMask16(size - sizeF);
+            __m512 _sum = _mm512_setzero_ps();
+            for (i = 0; i < sizeF; i += F)
+                _sum = _mm512_add_ps(_mm512_loadu_ps(src + i), _sum);
+            if (i < size)
+                _sum = _mm512_add_ps(_mm512_maskz_loadu_ps(tail, src + i), _sum);
+            __m512 mean = _mm512_set1_ps(ExtractSum(_sum) * k), _sqsum = _mm512_setzero_ps();
+            for (i = 0; i < sizeF; i += F)
+            {
+                __m512 _dst = _mm512_sub_ps(_mm512_loadu_ps(src + i), mean);
+                _mm512_storeu_ps(dst + i, _dst);
+                _sqsum = _mm512_fmadd_ps(_dst, _dst, _sqsum);
+            }
+            if (i < size)
+            {
+                __m512 _dst = _mm512_maskz_sub_ps(tail, _mm512_maskz_loadu_ps(tail, src + i), mean);
+                _mm512_mask_storeu_ps(dst + i, tail, _dst);
+                _sqsum = _mm512_fmadd_ps(_dst, _dst, _sqsum);
+            }
+            __m512 norm = _mm512_set1_ps(1.0f / ::sqrt(ExtractSum(_sqsum) * k + eps));
+            for (i = 0; i < sizeF; i += F)
+                _mm512_storeu_ps(dst + i, _mm512_fmadd_ps(_mm512_mul_ps(_mm512_loadu_ps(dst + i), norm), _mm512_loadu_ps(scale + i), _mm512_loadu_ps(shift + i)));
+            if (i < size)
+                _mm512_mask_storeu_ps(dst + i, tail, _mm512_fmadd_ps(_mm512_mul_ps(_mm512_maskz_loadu_ps(tail, dst + i), norm),
+                    _mm512_maskz_loadu_ps(tail, scale + i), _mm512_maskz_loadu_ps(tail, shift + i)));
+        }
+
+        void SynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst)
+        {
+            float k = 1.0f / float(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                LayerNorm32f(src, size, scale, shift, k, *eps, dst);
+                src += size;
+                dst += size;
+            }
+        }
+
+        void SynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst)
+        {
+            float k = 1.0f / float(size);
+            Array32f buf(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                BFloat16ToFloat32(src, size, buf.data);
+                LayerNorm32f(buf.data, size, scale, shift, k, *eps, buf.data);
+                Float32ToBFloat16(buf.data, size, dst);
+                src += size;
+                dst += size;
+            }
+        }
     }
 #endif
 }
@@ -0,0 +1,189 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetSparse32f.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdCpu.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_SYNET_ENABLE)
+    namespace Avx512bw
+    {
+        const size_t SF = SynetSparse32f::F, SKb = SynetSparse32f::Kb;
+
+        SIMD_INLINE void SynetSparse32fSave(float* dst, __m512 d0, size_t size)
+        {
+            _mm512_mask_storeu_ps(dst, TailMask16(size), d0);
+        }
+
+        static void SynetSparse32fGemm1x16(const float* src, const int32_t* index, size_t body, size_t tail, const float* weight, const float* bias, float* dst, size_t size)
+        {
+            __m512 d0 = _mm512_loadu_ps(bias), d1 = _mm512_setzero_ps(), d2 = _mm512_setzero_ps(), d3 = _mm512_setzero_ps();
+            for (size_t b = 0; b < body; ++b, weight += SKb * SF)
+            {
+                const float* ps = src + index[b];
+                d0 = _mm512_fmadd_ps(_mm512_loadu_ps(weight + 0 * SF), _mm512_set1_ps(ps[0]), d0);
+                d1 = _mm512_fmadd_ps(_mm512_loadu_ps(weight + 1 * SF), _mm512_set1_ps(ps[1]), d1);
+                d2 = _mm512_fmadd_ps(_mm512_loadu_ps(weight + 2 * SF), _mm512_set1_ps(ps[2]), d2);
+                d3 = _mm512_fmadd_ps(_mm512_loadu_ps(weight + 3 * SF), _mm512_set1_ps(ps[3]), d3);
+            }
+            if (tail)
+            {
+                const float* ps = src + index[body];
+                for (size_t k = 0; k < tail; ++k, weight += SF)
+                {
+                    d0 = _mm512_fmadd_ps(_mm512_loadu_ps(weight), _mm512_set1_ps(ps[k]), d0);
+                }
+            }
+            SynetSparse32fSave(dst, _mm512_add_ps(_mm512_add_ps(d0, d1), _mm512_add_ps(d2, d3)), size);
+        }
+
+        template<int M> void SynetSparse32fGemmMx16(const float* src, size_t ldS, const int32_t* index, size_t body, size_t tail, const float* weight, const float* bias, float* dst, size_t ldD, size_t size)
+        {
+            __m512 d0, d1, d2, d3, d4, d5, d6, d7, d8, d9, da, db, w0;
+            d0 = _mm512_loadu_ps(bias);
+            if (M > 1) d1 = d0;
+            if (M > 2) d2 = d0;
+            if (M > 3) d3 = d0;
+            if (M > 4) d4 = d0;
+            if (M > 5) d5 = d0;
+            if (M > 6) d6 = d0;
+            if (M > 7) d7 = d0;
+            if (M > 8) d8 = d0;
+            if (M > 9) d9 = d0;
+            if (M > 10) da = d0;
+            if (M > 11) db = d0;
+            for (size_t b = 0; b < body; ++b)
+            {
+                const float* ps = src + index[b];
+                for (size_t k = 0; k < SKb; ++k, weight += SF)
+                {
+                    w0 = _mm512_loadu_ps(weight);
+                    d0 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[0 * ldS + k]), d0);
+                    if (M > 1) d1 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[1 * ldS + k]), d1);
+                    if (M > 2) d2 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[2 * ldS + k]), d2);
+                    if (M > 3) d3 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[3 * ldS + k]), d3);
+                    if (M > 4) d4 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[4 * ldS + k]), d4);
+                    if (M > 5) d5 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[5 * ldS + k]), d5);
+                    if (M > 6) d6 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[6 * ldS + k]), d6);
+                    if (M > 7) d7 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[7 * ldS + k]), d7);
+                    if (M > 8) d8 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[8 * ldS + k]), d8);
+                    if (M > 9) d9 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[9 * ldS + k]), d9);
+                    if (M > 10) da = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[10 * ldS + k]), da);
+                    if (M > 11) db = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[11 * ldS + k]), db);
+                }
+            }
+            if (tail)
+            {
+                const float* ps = src + index[body];
+                for (size_t k = 0; k < tail; ++k, weight += SF)
+                {
+                    w0 = _mm512_loadu_ps(weight);
+                    d0 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[0 * ldS + k]), d0);
+                    if (M > 1) d1 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[1 * ldS + k]), d1);
+                    if (M > 2) d2 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[2 * ldS + k]), d2);
+                    if (M > 3) d3 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[3 * ldS + k]), d3);
+                    if (M > 4) d4 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[4 * ldS + k]), d4);
+                    if (M > 5) d5 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[5 * ldS + k]), d5);
+                    if (M > 6) d6 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[6 * ldS + k]), d6);
+                    if (M > 7) d7 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[7 * ldS + k]), d7);
+                    if (M > 8) d8 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[8 * ldS + k]), d8);
+                    if (M > 9) d9 = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[9 * ldS + k]), d9);
+                    if (M > 10) da = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[10 * ldS + k]), da);
+                    if (M > 11) db = _mm512_fmadd_ps(w0, _mm512_set1_ps(ps[11 * ldS + k]), db);
+                }
+            }
+            SynetSparse32fSave(dst + 0 * ldD, d0, size);
+            if (M > 1) SynetSparse32fSave(dst + 1 * ldD, d1, size);
+            if (M > 2) SynetSparse32fSave(dst + 2 * ldD, d2, size);
+            if (M > 3) SynetSparse32fSave(dst + 3 * ldD, d3, size);
+            if (M > 4) SynetSparse32fSave(dst + 4 * ldD, d4, size);
+            if (M > 5) SynetSparse32fSave(dst + 5 * ldD, d5, size);
+            if (M > 6) SynetSparse32fSave(dst + 6 * ldD, d6, size);
+            if (M > 7) SynetSparse32fSave(dst + 7 * ldD, d7, size);
+            if (M > 8) SynetSparse32fSave(dst + 8 * ldD, d8, size);
+            if (M > 9) SynetSparse32fSave(dst + 9 * ldD, d9, size);
+            if (M > 10) SynetSparse32fSave(dst + 10 * ldD, da, size);
+            if (M > 11) SynetSparse32fSave(dst + 11 * ldD, db, size);
+        }
+
+        typedef void(*SynetSparse32fGemmMx16Ptr)(const float* src, size_t ldS, const int32_t* index, size_t body, size_t tail, const float* weight, const float* bias, float* dst, size_t ldD, size_t size);
+
+        SIMD_INLINE SynetSparse32fGemmMx16Ptr GetSynetSparse32fGemmMx16(size_t M)
+        {
+            switch (M)
+            {
+            case 0: return NULL;
+            case 1: return SynetSparse32fGemmMx16<1>;
+            case 2: return SynetSparse32fGemmMx16<2>;
+            case 3: return SynetSparse32fGemmMx16<3>;
+            case 4: return SynetSparse32fGemmMx16<4>;
+            case 5: return SynetSparse32fGemmMx16<5>;
+            case 6: return SynetSparse32fGemmMx16<6>;
+            case 7: return SynetSparse32fGemmMx16<7>;
+            case 8: return SynetSparse32fGemmMx16<8>;
+            case 9: return SynetSparse32fGemmMx16<9>;
+            case 10: return SynetSparse32fGemmMx16<10>;
+            case 11: return SynetSparse32fGemmMx16<11>;
+            case 12: return SynetSparse32fGemmMx16<12>;
+            }
+            assert(0);
+            return NULL;
+        }
+
+        void SynetSparse32fGemm(const float* src, size_t M, size_t ldS, const SynetSparse32f& weight, const float* bias, float* dst, size_t ldD)
+        {
+            const size_t R = 12;
+            size_t K = weight.K, N = weight.N, mBlock = Simd::Max(AlignLoAny(Base::AlgCacheL2() / 2 / (K * sizeof(float)), R), R);
+            SynetSparse32fGemmMx16Ptr gemmBody = GetSynetSparse32fGemmMx16(R);
+            float buf[SF];
+            for (size_t mBeg = 0; mBeg < M; mBeg += mBlock)
+            {
+                size_t mEnd = Simd::Min(M, mBeg + mBlock), mBody = mBeg + AlignLoAny(mEnd - mBeg, R);
+                SynetSparse32fGemmMx16Ptr gemmTail = GetSynetSparse32fGemmMx16(mEnd - mBody);
+                for (size_t n = 0, t = 0; n < N; n += SF, t += 1)
+                {
+                    size_t size = Simd::Min(N - n, SF), beg = weight.offset[t], body = weight.offset[t + 1] - beg, tail = 0;
+                    const int32_t* idx = weight.index.data + beg;
+                    const float* w = weight.weight.data + beg * SKb * SF;
+                    if (body && idx[body - 1] + SKb > K)
+                        tail = K - idx[--body];
+                    for (size_t f = 0; f < SF; ++f)
+                        buf[f] = bias && f < size ? bias[n + f] : 0.0f;
+                    if (M == 1)
+                    {
+                        SynetSparse32fGemm1x16(src, idx, body, tail, w, buf, dst + n, size);
+                        continue;
+                    }
+                    size_t m = mBeg;
+                    for (; m < mBody; m += R)
+                        gemmBody(src + m * ldS, ldS, idx, body, tail, w, buf, dst + m * ldD + n, ldD, size);
+                    if (gemmTail)
+                        gemmTail(src + m * ldS, ldS, idx, body, tail, w, buf, dst + m * ldD + n, ldD, size);
+                }
+            }
+        }
+    }
+#endif
+}
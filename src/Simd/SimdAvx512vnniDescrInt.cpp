@@ -38,7 +38,7 @@ namespace Simd
         DescrInt::DescrInt(size_t size, size_t depth)
             : Avx512bw::DescrInt(size, depth)
         {
-            if (_depth != 8)
+            if (_depth > 3 && _depth != 8)
             {
                 _macroCosineDistancesUnpack = GetMacroCosineDistancesUnpack(_depth);
                 _microMu = 12;
@@ -80,6 +80,11 @@ namespace Simd
         {
             return _mm_castsi128_ps(_mm_slli_epi32(value, Base::Bf16::SHIFT));
         }
+
+        SIMD_INLINE __m128 RoundToBFloat16(__m128 value)
+        {
+            return _mm_castsi128_ps(_mm_and_si128(_mm_add_epi32(_mm_castps_si128(value), Bf16::ROUND), Bf16::MASK));
+        }
     }
 #endif   
 
@@ -101,6 +106,11 @@ namespace Simd
         {
             return _mm256_castsi256_ps(_mm256_slli_epi32(value, Base::Bf16::SHIFT));
         }
+
+        SIMD_INLINE __m256 RoundToBFloat16(__m256 value)
+        {
+            return _mm256_castsi256_ps(_mm256_and_si256(_mm256_add_epi32(_mm256_castps_si256(value), Bf16::ROUND), Bf16::MASK));
+        }
     }
 #endif  
 
@@ -123,6 +133,11 @@ namespace Simd
             return _mm512_castsi512_ps(_mm512_slli_epi32(value, Base::Bf16::SHIFT));
         }
 
+        SIMD_INLINE __m512 RoundToBFloat16(__m512 value)
+        {
+            return _mm512_castsi512_ps(_mm512_and_si512(_mm512_add_epi32(_mm512_castps_si512(value), Bf16::ROUND), Bf16::MASK));
+        }
+
         template <bool align, bool mask> SIMD_INLINE void Float32ToBFloat16(const float* src, uint16_t* dst, __mmask16 srcMask[2], __mmask32 dstMask[1])
         {
             __m512 s0 = Load<align, mask>(src + 0 * F, srcMask[0]);
@@ -60,5 +60,13 @@ namespace Simd
             for (; i < size; ++i)
                 dst[i] = BFloat16ToFloat32(src[i]);
         }
+
+        //---------------------------------------------------------------------------------------------
+
+        void RoundToBFloat16(const float* src, size_t size, float* dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = RoundToBFloat16(src[i]);
+        }
     }
 }
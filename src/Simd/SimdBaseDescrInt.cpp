@@ -25,6 +25,9 @@
 #include "Simd/SimdDescrInt.h"
 #include "Simd/SimdDescrIntCommon.h"
 #include "Simd/SimdFloat16.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -528,9 +531,146 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        static void MeanNegPos32f(const float* src, size_t size, float& min, float& max)
+        {
+            float neg = 0, pos = 0;
+            size_t count = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (src[i] > 0.0f)
+                    pos += src[i], count++;
+                else
+                    neg += src[i];
+            }
+            min = count < size ? neg / float(size - count) : 0.0f;
+            max = count ? pos / float(count) : 0.0f;
+        }
+
+        static void MeanNegPos16f(const uint16_t* src, size_t size, float& min, float& max)
+        {
+            float neg = 0, pos = 0;
+            size_t count = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                float val = Float16ToFloat32(src[i]);
+                if (val > 0.0f)
+                    pos += val, count++;
+                else
+                    neg += val;
+            }
+            min = count < size ? neg / float(size - count) : 0.0f;
+            max = count ? pos / float(count) : 0.0f;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE float ToFloat32(float src)
+        {
+            return src;
+        }
+
+        SIMD_INLINE float ToFloat32(uint16_t src)
+        {
+            return Float16ToFloat32(src);
+        }
+
+        template<int bits> SIMD_INLINE int32_t EncodeBits(float src, float scale, float min, int32_t& sum, int32_t& sqsum)
+        {
+            if (bits == 1)
+            {
+                int32_t value = src > 0.0f ? 1 : 0;
+                sum += value;
+                sqsum += value;
+                return value;
+            }
+            else
+                return Encode32f(src, scale, min, sum, sqsum);
+        }
+
+        template<int bits, class T> static void EncodeBits(const T* src, float scale, float min, size_t size, int32_t& sum, int32_t& sqsum, uint8_t* dst)
+        {
+            assert(size % 8 == 0);
+            size_t plane = size / 8;
+            sum = 0, sqsum = 0;
+            for (size_t i = 0; i < size; i += 8, src += 8, dst += 1)
+            {
+                uint8_t planes[bits] = { 0 };
+                for (size_t k = 0; k < 8; ++k)
+                {
+                    int32_t value = EncodeBits<bits>(ToFloat32(src[k]), scale, min, sum, sqsum);
+                    for (int p = 0; p < bits; ++p)
+                        planes[p] |= ((value >> p) & 1) << k;
+                }
+                for (int p = 0; p < bits; ++p)
+                    dst[p * plane] = planes[p];
+            }
+        }
+
+        template<int bits> static void Encode32fBits(const float* src, float scale, float min, size_t size, int32_t& sum, int32_t& sqsum, uint8_t* dst)
+        {
+            EncodeBits<bits, float>(src, scale, min, size, sum, sqsum, dst);
+        }
+
+        template<int bits> static void Encode16fBits(const uint16_t* src, float scale, float min, size_t size, int32_t& sum, int32_t& sqsum, uint8_t* dst)
+        {
+            EncodeBits<bits, uint16_t>(src, scale, min, size, sum, sqsum, dst);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE void StoreDecoded(float value, float* dst)
+        {
+            dst[0] = value;
+        }
+
+        SIMD_INLINE void StoreDecoded(float value, uint16_t* dst)
+        {
+            dst[0] = Float32ToFloat16(value);
+        }
+
+        template<int bits, class T> static void DecodeBits(const uint8_t* src, float scale, float shift, size_t size, T* dst)
+        {
+            assert(size % 8 == 0);
+            size_t plane = size / 8;
+            for (size_t i = 0; i < size; i += 8, src += 1, dst += 8)
+            {
+                for (size_t k = 0; k < 8; ++k)
+                {
+                    int32_t value = 0;
+                    for (int p = 0; p < bits; ++p)
+                        value |= ((src[p * plane] >> k) & 1) << p;
+                    StoreDecoded(float(value) * scale + shift, dst + k);
+                }
+            }
+        }
+
+        template<int bits> static void Decode32fBits(const uint8_t* src, float scale, float shift, size_t size, float* dst)
+        {
+            DecodeBits<bits, float>(src, scale, shift, size, dst);
+        }
+
+        template<int bits> static void Decode16fBits(const uint8_t* src, float scale, float shift, size_t size, uint16_t* dst)
+        {
+            DecodeBits<bits, uint16_t>(src, scale, shift, size, dst);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        template<int bits> void CosineDistanceBits(const uint8_t* a, const uint8_t* b, size_t size, float* distance)
+        {
+            size_t plane = size / 8;
+            uint32_t abSum = 0;
+            for (int p = 0; p < bits; ++p)
+                for (int q = 0; q < bits; ++q)
+                    abSum += PopcountAnd(a + 16 + p * plane, b + 16 + q * plane, plane) << (p + q);
+            Base::DecodeCosineDistance(a, b, float(abSum), distance);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
         bool DescrInt::Valid(size_t size, size_t depth)
         {
-            if (depth < 4 || depth > 8)
+            if (depth < 1 || depth > 8)
                 return false;
             if (size == 0 || size % 8 != 0 || size > 128 * 256)
                 return false;
@@ -547,6 +687,35 @@ namespace Simd
             _minMax16f = MinMax16f;
             switch (depth)
             {
+            case 1:
+            {
+                _minMax32f = MeanNegPos32f;
+                _minMax16f = MeanNegPos16f;
+                _encode32f = Encode32fBits<1>;
+                _encode16f = Encode16fBits<1>;
+                _decode32f = Decode32fBits<1>;
+                _decode16f = Decode16fBits<1>;
+                _cosineDistance = Base::CosineDistanceBits<1>;
+                break;
+            }
+            case 2:
+            {
+                _encode32f = Encode32fBits<2>;
+                _encode16f = Encode16fBits<2>;
+                _decode32f = Decode32fBits<2>;
+                _decode16f = Decode16fBits<2>;
+                _cosineDistance = Base::CosineDistanceBits<2>;
+                break;
+            }
+            case 3:
+            {
+                _encode32f = Encode32fBits<3>;
+                _encode16f = Encode16fBits<3>;
+                _decode32f = Decode32fBits<3>;
+                _decode16f = Decode16fBits<3>;
+                _cosineDistance = Base::CosineDistanceBits<3>;
+                break;
+            }
             case 4:
             {
                 _encode32f = Encode32f4;
@@ -642,30 +811,117 @@ namespace Simd
 
         void DescrInt::CosineDistancesMxNa(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances) const
         {
-            for (size_t i = 0; i < M; ++i)
+            size_t threads = Simd::RestrictRange<size_t>(M * N * _size / (2 * 1024 * 1024), 1, Base::GetThreadNumber());
+            Simd::Parallel(0, N, [&](size_t thread, size_t begin, size_t end)
             {
-                const uint8_t* a = A[i];
-                for (size_t j = 0; j < N; ++j)
+                for (size_t i = 0; i < M; ++i)
                 {
-                    const uint8_t* b = B[j];
-                    _cosineDistance(a, b, _size, distances++);
+                    const uint8_t* a = A[i];
+                    for (size_t j = begin; j < end; ++j)
+                        _cosineDistance(a, B[j], _size, distances + i * N + j);
                 }
-            }
+            }, threads);
         }
 
         void DescrInt::CosineDistancesMxNp(size_t M, size_t N, const uint8_t* A, const uint8_t* B, float* distances) const
         {
+            size_t threads = Simd::RestrictRange<size_t>(M * N * _size / (2 * 1024 * 1024), 1, Base::GetThreadNumber());
+            Simd::Parallel(0, N, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = 0; i < M; ++i)
+                {
+                    const uint8_t* a = A + i * _encSize;
+                    for (size_t j = begin; j < end; ++j)
+                        _cosineDistance(a, B + j * _encSize, _size, distances + i * N + j);
+                }
+            }, threads);
+        }
+
+        void DescrInt::CosineDistancesTopKa(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, size_t K, float threshold, uint32_t* indices, float* distances) const
+        {
+            CosineDistancesTopK(M, N, A, B, NULL, K, threshold, indices, distances);
+        }
+
+        void DescrInt::CosineDistancesTopKp(size_t M, size_t N, const uint8_t* A, const uint8_t* B, size_t K, float threshold, uint32_t* indices, float* distances) const
+        {
+            Array8ucp a(M);
             for (size_t i = 0; i < M; ++i)
+                a[i] = A + i * _encSize;
+            CosineDistancesTopK(M, N, a.data, NULL, B, K, threshold, indices, distances);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void DescrInt::CosineDistancesTopK(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, const uint8_t* P, size_t K, float threshold, uint32_t* indices, float* distances) const
+        {
+            if (M == 0 || K == 0)
+                return;
+            const size_t L2 = Base::AlgCacheL2();
+            size_t mM = Simd::Min<size_t>(M, 256);
+            size_t mN = Simd::Max<size_t>(AlignLo(L2 / (mM * 4 + _encSize), 16), 16);
+            size_t threads = Simd::Max<size_t>(Simd::Min(Base::GetThreadNumber(), DivHi(N, mN)), 1);
+
+            Array32f heapDist(threads * M * K), bufDist(threads * mM * mN);
+            Array32u heapIndex(threads * M * K);
+            Array8ucp bufPtrs(P ? threads * mN : 0);
+            std::vector<size_t> heapSize(threads * M, 0);
+            Simd::Parallel(0, N, [&](size_t thread, size_t begin, size_t end)
             {
-                const uint8_t* a = A + i * _encSize;
-                for (size_t j = 0; j < N; ++j)
+                float* hd = heapDist.data + thread * M * K;
+                uint32_t* hi = heapIndex.data + thread * M * K;
+                size_t* hs = heapSize.data() + thread * M;
+                float* buf = bufDist.data + thread * mM * mN;
+                const uint8_t** ptrs = P ? bufPtrs.data + thread * mN : NULL;
+                for (size_t j = begin; j < end; j += mN)
                 {
-                    const uint8_t* b = B + j * _encSize;
-                    _cosineDistance(a, b, _size, distances++);
+                    size_t dN = Simd::Min(end, j + mN) - j;
+                    const uint8_t* const* b = B ? B + j : ptrs;
+                    if (P)
+                    {
+                        for (size_t k = 0; k < dN; ++k)
+                            ptrs[k] = P + (j + k) * _encSize;
+                    }
+                    for (size_t i = 0; i < M; i += mM)
+                    {
+                        size_t dM = Simd::Min(M, i + mM) - i;
+                        CosineDistancesMxNa(dM, dN, A + i, b, buf);
+                        for (size_t m = 0; m < dM; ++m)
+                        {
+                            TopKHeap heap(hd + (i + m) * K, hi + (i + m) * K, hs[i + m], K);
+                            const float* row = buf + m * dN;
+                            float bound = heap.Bound(threshold);
+                            for (size_t n = 0; n < dN; ++n)
+                            {
+                                if (row[n] <= bound)
+                                {
+                                    heap.Push(row[n], uint32_t(j + n));
+                                    bound = heap.Bound(threshold);
+                                }
+                            }
+                            hs[i + m] = heap.size;
+                        }
+                    }
                 }
+            }, threads, mN);
+
+            for (size_t m = 0; m < M; ++m)
+            {
+                float* dst = distances + m * K;
+                uint32_t* idx = indices + m * K;
+                TopKHeap heap(dst, idx, 0, K);
+                for (size_t t = 0; t < threads; ++t)
+                {
+                    const float* hd = heapDist.data + (t * M + m) * K;
+                    const uint32_t* hi = heapIndex.data + (t * M + m) * K;
+                    for (size_t k = 0, n = heapSize[t * M + m]; k < n; ++k)
+                        heap.Push(hd[k], hi[k]);
+                }
+                heap.Finalize();
             }
         }
 
+        //-------------------------------------------------------------------------------------------------
+
         void DescrInt::VectorNorm(const uint8_t* a, float* norm) const
         {
             *norm = ((float*)a)[3];
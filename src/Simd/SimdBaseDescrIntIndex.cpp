@@ -0,0 +1,387 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdDescrIntIndex.h"
+#include "Simd/SimdDescrIntCommon.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdParallel.hpp"
+
+#include <fstream>
+#include <stdio.h>
+#include <unordered_set>
+
+namespace Simd
+{
+    namespace Base
+    {
+        const uint8_t DESCR_INT_INDEX_MAGIC[8] = { 'S', 'i', 'm', 'd', 'D', 'I', 0, 1 };
+        const size_t DESCR_INT_INDEX_ALIGN = 64;
+
+        static SIMD_INLINE float DotProduct(const float* a, const float* b, size_t size)
+        {
+            float sums[4] = { 0, 0, 0, 0 };
+            size_t size4 = AlignLo(size, 4), i = 0;
+            for (; i < size4; i += 4)
+            {
+                sums[0] += a[i + 0] * b[i + 0];
+                sums[1] += a[i + 1] * b[i + 1];
+                sums[2] += a[i + 2] * b[i + 2];
+                sums[3] += a[i + 3] * b[i + 3];
+            }
+            for (; i < size; ++i)
+                sums[0] += a[i] * b[i];
+            return sums[0] + sums[1] + sums[2] + sums[3];
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void DescrIntIndex::List::Own(size_t encSize)
+        {
+            if (codes == ownCodes.data() && ids == ownIds.data())
+                return;
+            ownCodes.assign(codes, codes + size * encSize);
+            ownIds.assign(ids, ids + size);
+            codes = ownCodes.data();
+            ids = ownIds.data();
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        DescrIntIndex::DescrIntIndex(DescrInt* descrInt, size_t lists)
+            : _descrInt(descrInt)
+            , _size(descrInt->DecodedSize())
+            , _encSize(descrInt->EncodedSize())
+            , _lists(lists)
+            , _trained(false)
+            , _centroids(lists * descrInt->DecodedSize(), true)
+            , _data(lists)
+        {
+        }
+
+        DescrIntIndex::~DescrIntIndex()
+        {
+            delete _descrInt;
+        }
+
+        size_t DescrIntIndex::Size() const
+        {
+            size_t size = 0;
+            for (size_t l = 0; l < _lists; ++l)
+                size += _data[l].size;
+            return size;
+        }
+
+        void DescrIntIndex::Normalize(const float* src, float* dst) const
+        {
+            float norm = ::sqrt(DotProduct(src, src, _size));
+            float scale = 1.0f / Simd::Max(norm, SIMD_DESCR_INT_EPS);
+            for (size_t i = 0; i < _size; ++i)
+                dst[i] = src[i] * scale;
+        }
+
+        void DescrIntIndex::Nearest(const float* normalized, size_t count, uint32_t* lists) const
+        {
+            Simd::Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const float* src = normalized + i * _size;
+                    float best = -FLT_MAX;
+                    for (size_t l = 0; l < _lists; ++l)
+                    {
+                        float dot = DotProduct(src, _centroids.data + l * _size, _size);
+                        if (dot > best)
+                            best = dot, lists[i] = uint32_t(l);
+                    }
+                }
+            }, Base::GetThreadNumber(), 64);
+        }
+
+        bool DescrIntIndex::Train(size_t count, const float* data, size_t iterations)
+        {
+            if (count < _lists || Size())
+                return false;
+            Array32f normalized(count * _size), sums(_lists * _size);
+            for (size_t i = 0; i < count; ++i)
+                Normalize(data + i * _size, normalized.data + i * _size);
+            for (size_t l = 0; l < _lists; ++l)
+                memcpy(_centroids.data + l * _size, normalized.data + (l * count / _lists) * _size, _size * sizeof(float));
+            std::vector<uint32_t> assigned(count, UINT32_MAX), current(count), members(_lists);
+            for (size_t it = 0; it < Simd::Max<size_t>(iterations, 1); ++it)
+            {
+                Nearest(normalized.data, count, current.data());
+                if (current == assigned)
+                    break;
+                assigned.swap(current);
+                sums.Clear();
+                std::fill(members.begin(), members.end(), 0);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    float* sum = sums.data + assigned[i] * _size;
+                    const float* src = normalized.data + i * _size;
+                    for (size_t j = 0; j < _size; ++j)
+                        sum[j] += src[j];
+                    members[assigned[i]]++;
+                }
+                for (size_t l = 0; l < _lists; ++l)
+                {
+                    const float* src = members[l] ? sums.data + l * _size : normalized.data + ((l * 7919 + it * 104729) % count) * _size;
+                    Normalize(src, _centroids.data + l * _size);
+                }
+            }
+            _trained = true;
+            return true;
+        }
+
+        bool DescrIntIndex::Add(size_t count, const float* data, const uint32_t* ids)
+        {
+            if (!_trained)
+                return false;
+            Array32f normalized(count * _size);
+            Array8u encoded(count * _encSize);
+            Simd::Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    Normalize(data + i * _size, normalized.data + i * _size);
+                    _descrInt->Encode32f(data + i * _size, encoded.data + i * _encSize);
+                }
+            }, Base::GetThreadNumber(), 64);
+            std::vector<uint32_t> lists(count);
+            Nearest(normalized.data, count, lists.data());
+            for (size_t i = 0; i < count; ++i)
+            {
+                List& list = _data[lists[i]];
+                list.Own(_encSize);
+                list.ownCodes.insert(list.ownCodes.end(), encoded.data + i * _encSize, encoded.data + (i + 1) * _encSize);
+                list.ownIds.push_back(ids[i]);
+                list.codes = list.ownCodes.data();
+                list.ids = list.ownIds.data();
+                list.size++;
+            }
+            return true;
+        }
+
+        size_t DescrIntIndex::Remove(size_t count, const uint32_t* ids)
+        {
+            std::unordered_set<uint32_t> removed(ids, ids + count);
+            size_t total = 0;
+            for (size_t l = 0; l < _lists; ++l)
+            {
+                List& list = _data[l];
+                for (size_t i = 0; i < list.size;)
+                {
+                    if (removed.count(list.ids[i]))
+                    {
+                        list.Own(_encSize);
+                        size_t last = list.size - 1;
+                        if (i != last)
+                        {
+                            memcpy(list.ownCodes.data() + i * _encSize, list.ownCodes.data() + last * _encSize, _encSize);
+                            list.ownIds[i] = list.ownIds[last];
+                        }
+                        list.ownCodes.resize(last * _encSize);
+                        list.ownIds.resize(last);
+                        list.codes = list.ownCodes.data();
+                        list.ids = list.ownIds.data();
+                        list.size = last;
+                        total++;
+                    }
+                    else
+                        ++i;
+                }
+            }
+            return total;
+        }
+
+        void DescrIntIndex::Search(size_t M, const float* queries, size_t nprobe, size_t K, float threshold, uint32_t* ids, float* distances) const
+        {
+            if (K == 0)
+                return;
+            nprobe = _trained ? Simd::Min(nprobe, _lists) : 0;
+            size_t block = Simd::Max<size_t>(AlignLo(Base::AlgCacheL2() / (_encSize + 4), 16), 16);
+            size_t threads = Simd::Max<size_t>(Simd::Min(Base::GetThreadNumber(), M), 1);
+            size_t bufSize = _size + _lists + nprobe + block;
+            Array32f bufs(threads * bufSize);
+            Array32u probes(threads * nprobe);
+            Array8u codes(threads * _encSize);
+            Simd::Parallel(0, M, [&](size_t thread, size_t begin, size_t end)
+            {
+                float* query = bufs.data + thread * bufSize;
+                float* centroid = query + _size;
+                float* probeDist = centroid + _lists;
+                float* dist = probeDist + nprobe;
+                uint32_t* probe = probes.data + thread * nprobe;
+                uint8_t* code = codes.data + thread * _encSize;
+                for (size_t m = begin; m < end; ++m)
+                {
+                    TopKHeap heap(distances + m * K, ids + m * K, 0, K);
+                    if (nprobe)
+                    {
+                        Normalize(queries + m * _size, query);
+                        TopKHeap probeHeap(probeDist, probe, 0, nprobe);
+                        for (size_t l = 0; l < _lists; ++l)
+                            probeHeap.Push(1.0f - DotProduct(query, _centroids.data + l * _size, _size), uint32_t(l));
+                        _descrInt->Encode32f(queries + m * _size, code);
+                        for (size_t p = 0; p < probeHeap.size; ++p)
+                        {
+                            const List& list = _data[probe[p]];
+                            for (size_t j = 0; j < list.size; j += block)
+                            {
+                                size_t n = Simd::Min(list.size, j + block) - j;
+                                _descrInt->CosineDistancesMxNp(1, n, code, list.codes + j * _encSize, dist);
+                                float bound = heap.Bound(threshold);
+                                for (size_t i = 0; i < n; ++i)
+                                {
+                                    if (dist[i] <= bound)
+                                    {
+                                        heap.Push(dist[i], list.ids[j + i]);
+                                        bound = heap.Bound(threshold);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    heap.Finalize();
+                }
+            }, threads);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        static SIMD_INLINE void WritePadding(std::ofstream& ofs)
+        {
+            static const char zeros[DESCR_INT_INDEX_ALIGN] = { 0 };
+            size_t pos = (size_t)ofs.tellp();
+            ofs.write(zeros, AlignHi(pos, DESCR_INT_INDEX_ALIGN) - pos);
+        }
+
+        bool DescrIntIndex::Save(const String& path) const
+        {
+            const String tmp = path + ".tmp";
+            if (!Write(tmp))
+            {
+                ::remove(tmp.c_str());
+                return false;
+            }
+            if (::rename(tmp.c_str(), path.c_str()) != 0 && (::remove(path.c_str()) != 0 || ::rename(tmp.c_str(), path.c_str()) != 0))
+            {
+                ::remove(tmp.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        bool DescrIntIndex::Write(const String& path) const
+        {
+            std::ofstream ofs(path.c_str(), std::ofstream::binary);
+            if (!ofs.is_open())
+                return false;
+            uint64_t header[5] = { _size, _descrInt->Depth(), _encSize, _lists, _trained ? 1u : 0u };
+            ofs.write((const char*)DESCR_INT_INDEX_MAGIC, sizeof(DESCR_INT_INDEX_MAGIC));
+            ofs.write((const char*)header, sizeof(header));
+            for (size_t l = 0; l < _lists; ++l)
+            {
+                uint64_t size = _data[l].size;
+                ofs.write((const char*)&size, sizeof(size));
+            }
+            WritePadding(ofs);
+            ofs.write((const char*)_centroids.data, _lists * _size * sizeof(float));
+            WritePadding(ofs);
+            for (size_t l = 0; l < _lists; ++l)
+            {
+                const List& list = _data[l];
+                ofs.write((const char*)list.codes, list.size * _encSize);
+                WritePadding(ofs);
+                ofs.write((const char*)list.ids, list.size * sizeof(uint32_t));
+                WritePadding(ofs);
+            }
+            ofs.close();
+            return !ofs.fail();
+        }
+
+        bool DescrIntIndex::Load(const String& path)
+        {
+            std::unique_ptr<FileMapping> file(new FileMapping());
+            if (!file->Open(path, DESCR_INT_INDEX_ALIGN))
+                return false;
+            const uint8_t* src = file->Data(), * end = src + file->Size();
+            uint64_t header[5];
+            if (file->Size() < sizeof(DESCR_INT_INDEX_MAGIC) + sizeof(header) || memcmp(src, DESCR_INT_INDEX_MAGIC, sizeof(DESCR_INT_INDEX_MAGIC)))
+                return false;
+            memcpy(header, src + sizeof(DESCR_INT_INDEX_MAGIC), sizeof(header));
+            if (header[0] != _size || header[1] != _descrInt->Depth() || header[2] != _encSize || header[3] == 0)
+                return false;
+            size_t lists = (size_t)header[3];
+            const uint8_t* ptr = src + sizeof(DESCR_INT_INDEX_MAGIC) + sizeof(header);
+            if (lists > size_t(end - ptr) / sizeof(uint64_t))
+                return false;
+            std::vector<List> data(lists);
+            for (size_t l = 0; l < lists; ++l, ptr += sizeof(uint64_t))
+            {
+                uint64_t size;
+                memcpy(&size, ptr, sizeof(size));
+                data[l].size = (size_t)size;
+            }
+            ptr = src + AlignHi(ptr - src, DESCR_INT_INDEX_ALIGN);
+            if (ptr > end || lists * _size * sizeof(float) > size_t(end - ptr))
+                return false;
+            Array32f centroids(lists * _size);
+            memcpy(centroids.data, ptr, centroids.RawSize());
+            ptr = src + AlignHi(ptr - src + centroids.RawSize(), DESCR_INT_INDEX_ALIGN);
+            for (size_t l = 0; l < lists; ++l)
+            {
+                List& list = data[l];
+                if (ptr > end || list.size > size_t(end - ptr) / _encSize)
+                    return false;
+                list.codes = ptr;
+                ptr = src + AlignHi(ptr - src + list.size * _encSize, DESCR_INT_INDEX_ALIGN);
+                if (ptr > end || list.size > size_t(end - ptr) / sizeof(uint32_t))
+                    return false;
+                list.ids = (const uint32_t*)ptr;
+                ptr = src + AlignHi(ptr - src + list.size * sizeof(uint32_t), DESCR_INT_INDEX_ALIGN);
+            }
+            _lists = lists;
+            _trained = header[4] != 0;
+            _centroids.Swap(centroids);
+            _data.swap(data);
+            _file.reset(file.release());
+            return true;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* DescrIntIndexInit(void* descrInt, size_t lists)
+        {
+            if (descrInt == NULL)
+                return NULL;
+            if (lists == 0)
+            {
+                delete (DescrInt*)descrInt;
+                return NULL;
+            }
+            return new DescrIntIndex((DescrInt*)descrInt, lists);
+        }
+    }
+}
@@ -24,6 +24,8 @@
 #include "Simd/SimdMath.h"
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdFloat16.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -97,16 +99,24 @@ namespace Simd
 
         void CosineDistancesMxNa16f(size_t M, size_t N, size_t K, const uint16_t * const * A, const uint16_t * const * B, float * distances)
         {
-            for (size_t i = 0; i < M; ++i)
-                for (size_t j = 0; j < N; ++j)
-                    CosineDistance16f(A[i], B[j], K, distances + i * N + j);
+            size_t threads = Simd::RestrictRange<size_t>(M * N * K / (2 * 1024 * 1024), 1, Base::GetThreadNumber());
+            Simd::Parallel(0, N, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = 0; i < M; ++i)
+                    for (size_t j = begin; j < end; ++j)
+                        CosineDistance16f(A[i], B[j], K, distances + i * N + j);
+            }, threads);
         }
 
         void CosineDistancesMxNp16f(size_t M, size_t N, size_t K, const uint16_t* A, const uint16_t* B, float* distances)
         {
-            for (size_t i = 0; i < M; ++i)
-                for (size_t j = 0; j < N; ++j)
-                    CosineDistance16f(A + i * K, B + j * K, K, distances + i * N + j);
+            size_t threads = Simd::RestrictRange<size_t>(M * N * K / (2 * 1024 * 1024), 1, Base::GetThreadNumber());
+            Simd::Parallel(0, N, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = 0; i < M; ++i)
+                    for (size_t j = begin; j < end; ++j)
+                        CosineDistance16f(A + i * K, B + j * K, K, distances + i * N + j);
+            }, threads);
         }
 
         void VectorNorm16f(const uint16_t* data, size_t size, float* norm)
@@ -53,11 +53,12 @@ namespace Simd
 
     //-------------------------------------------------------------------------
 
-    ImageLoaderParam::ImageLoaderParam(const uint8_t* d, size_t s, SimdPixelFormatType f)
+    ImageLoaderParam::ImageLoaderParam(const uint8_t* d, size_t s, SimdPixelFormatType f, size_t sc)
         : data(d)
         , size(s)
         , format(f)
         , file(SimdImageFileUndefined)
+        , scale(sc)
     {
     }
 
@@ -90,11 +91,64 @@ namespace Simd
         }
         return
             file != SimdImageFileUndefined && 
+                (scale == 1 || scale == 2 || scale == 4 || scale == 8) &&
                 (format == SimdPixelFormatNone || format == SimdPixelFormatGray8 || 
                 format == SimdPixelFormatBgr24 || format == SimdPixelFormatBgra32 || 
                 format == SimdPixelFormatRgb24 || format == SimdPixelFormatRgba32);
     }
-        
+
+    //-------------------------------------------------------------------------
+
+    ImageDecoder::ImageDecoder(SimdPixelFormatType format, CreateImageLoaderPtr create)
+        : _format(format)
+        , _create(create)
+        , _loader(NULL)
+        , _error(false)
+    {
+    }
+
+    ImageDecoder::~ImageDecoder()
+    {
+        if (_loader)
+            delete _loader;
+    }
+
+    bool ImageDecoder::Feed(const uint8_t* data, size_t size)
+    {
+        if (_error)
+            return false;
+        if (_loader == NULL)
+        {
+            _head.insert(_head.end(), data, data + size);
+            if (_head.size() < 8)
+                return true;
+            ImageLoaderParam param(_head.data(), _head.size(), _format);
+            if (param.Validate() && (param.file == SimdImageFileJpeg || param.file == SimdImageFilePng))
+            {
+                param.data = NULL;
+                param.size = 0;
+                _loader = _create(param);
+            }
+            _error = !(_loader && _loader->Feed(_head.data(), _head.size()));
+            std::vector<uint8_t>().swap(_head);
+        }
+        else
+            _error = !_loader->Feed(data, size);
+        return !_error;
+    }
+
+    bool ImageDecoder::Info(size_t* width, size_t* height, SimdPixelFormatType* format) const
+    {
+        return _loader && !_error && _loader->Info(width, height, format);
+    }
+
+    size_t ImageDecoder::Pull(uint8_t* dst, size_t stride, size_t rows)
+    {
+        return _loader && !_error ? _loader->Pull(dst, stride, rows) : 0;
+    }
+
+    //-------------------------------------------------------------------------
+
     namespace Base
     {
         ImagePxmLoader::ImagePxmLoader(const ImageLoaderParam& param)
@@ -120,7 +174,8 @@ namespace Simd
             uint8_t byte;
             if (!(_stream.Read(byte) && byte == '\n'))
                 return false;
-            _image.Recreate(width, height, (Image::Format)_param.format);
+            if (!InitImage(width, height))
+                return false;
             _block = height;
             if (_param.file == SimdImageFilePgmTxt || _param.file == SimdImageFilePgmBin)
             {
@@ -26,6 +26,7 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -47,6 +48,75 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        float JpegIdctWeights4[4][4], JpegIdctWeights2[2][2];
+
+        static void JpegIdctWeightsInit(float* weights, int size)
+        {
+            int step = 8 / size;
+            for (int i = 0; i < size; ++i)
+            {
+                for (int u = 0; u < size; ++u)
+                {
+                    double sum = 0;
+                    for (int x = i * step; x < (i + 1) * step; ++x)
+                        sum += ::cos((2 * x + 1) * u * M_PI / 16.0);
+                    weights[i * size + u] = float(sum * (u ? 0.5 : 0.5 / ::sqrt(2.0)) / step);
+                }
+            }
+        }
+
+        bool JpegIdctWeightsInit()
+        {
+            JpegIdctWeightsInit(JpegIdctWeights4[0], 4);
+            JpegIdctWeightsInit(JpegIdctWeights2[0], 2);
+            return true;
+        }
+
+        bool JpegIdctWeightsInited = JpegIdctWeightsInit();
+
+        template<int N> SIMD_INLINE void JpegIdctReduced(uint8_t* dst, int stride, const short* src, const float(*weights)[N])
+        {
+            float tmp[N][N];
+            for (int i = 0; i < N; ++i)
+            {
+                for (int u = 0; u < N; ++u)
+                {
+                    float sum = 0;
+                    for (int v = 0; v < N; ++v)
+                        sum += weights[i][v] * src[v * 8 + u];
+                    tmp[i][u] = sum;
+                }
+            }
+            for (int i = 0; i < N; ++i)
+            {
+                for (int j = 0; j < N; ++j)
+                {
+                    float sum = 128.0f;
+                    for (int u = 0; u < N; ++u)
+                        sum += weights[j][u] * tmp[i][u];
+                    dst[j] = (uint8_t)RestrictRange(Round(sum));
+                }
+                dst += stride;
+            }
+        }
+
+        void JpegIdct4x4(uint8_t* dst, int stride, short* src)
+        {
+            JpegIdctReduced<4>(dst, stride, src, JpegIdctWeights4);
+        }
+
+        void JpegIdct2x2(uint8_t* dst, int stride, short* src)
+        {
+            JpegIdctReduced<2>(dst, stride, src, JpegIdctWeights2);
+        }
+
+        void JpegIdct1x1(uint8_t* dst, int stride, short* src)
+        {
+            dst[0] = (uint8_t)RestrictRange(Round(src[0] * 0.125f + 128.0f));
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
 #if defined(SIMD_X64_ENABLE) && !defined(SIMD_SSE41_DISABLE)
 #define JPEG_SSE2
         static int jpeg__sse2_available(void)
@@ -317,6 +387,9 @@ namespace Simd
 
             int scan_n, order[4];
             int restart_interval, todo;
+            int block; // size of decoded block: 8 or 4, 2, 1 for reduced size decoding
+            int luma_only; // only the Y component of a YCbCr image is needed (gray output)
+            int idct_n; // only the first idct_n components are transformed, the others are only entropy decoded
 
             // kernels
             void (*idct_block_kernel)(jpeg_uc* out, int out_stride, short data[64]);
@@ -1269,7 +1342,8 @@ namespace Simd
                         for (i = 0; i < w; ++i) {
                             int ha = z->img_comp[n].ha;
                             if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2, data);
+                            if (n < z->idct_n)
+                                z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * z->block + i * z->block, z->img_comp[n].w2, data);
                             // every data block is an MCU, so countdown the restart interval
                             if (--z->todo <= 0) {
                                 if (z->code_bits < 24) jpeg__grow_buffer_unsafe(z);
@@ -1294,11 +1368,12 @@ namespace Simd
                                 // by the basic H and V specified for the component
                                 for (y = 0; y < z->img_comp[n].v; ++y) {
                                     for (x = 0; x < z->img_comp[n].h; ++x) {
-                                        int x2 = (i * z->img_comp[n].h + x) * 8;
-                                        int y2 = (j * z->img_comp[n].v + y) * 8;
+                                        int x2 = (i * z->img_comp[n].h + x) * z->block;
+                                        int y2 = (j * z->img_comp[n].v + y) * z->block;
                                         int ha = z->img_comp[n].ha;
                                         if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-                                        z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
+                                        if (n < z->idct_n)
+                                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
                                     }
                                 }
                             }
@@ -1379,6 +1454,130 @@ namespace Simd
             }
         }
 
+        // decode MCUs [beg, end) of a baseline scan; the entropy decoder must be positioned at the start of the restart interval
+        static int jpeg__decode_restart_interval(jpeg__jpeg* z, int beg, int end)
+        {
+            int m, k, x, y;
+            JPEG_SIMD_ALIGN(short, data[64]);
+            jpeg__jpeg_reset(z);
+            if (z->scan_n == 1) {
+                int n = z->order[0];
+                int w = (z->img_comp[n].x + 7) >> 3;
+                int ha = z->img_comp[n].ha;
+                for (m = beg; m < end; ++m) {
+                    int i = m % w, j = m / w;
+                    if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                    if (n < z->idct_n)
+                        z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * z->block + i * z->block, z->img_comp[n].w2, data);
+                }
+            }
+            else {
+                for (m = beg; m < end; ++m) {
+                    int i = m % z->img_mcu_x, j = m / z->img_mcu_x;
+                    for (k = 0; k < z->scan_n; ++k) {
+                        int n = z->order[k];
+                        for (y = 0; y < z->img_comp[n].v; ++y) {
+                            for (x = 0; x < z->img_comp[n].h; ++x) {
+                                int x2 = (i * z->img_comp[n].h + x) * z->block;
+                                int y2 = (j * z->img_comp[n].v + y) * z->block;
+                                int ha = z->img_comp[n].ha;
+                                if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                                if (n < z->idct_n)
+                                    z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
+                            }
+                        }
+                    }
+                }
+            }
+            return 1;
+        }
+
+        // decode MCU row 'row' (of 'w' MCUs) of a baseline scan; returns 2 if the scan was ended by a non-restart marker
+        static int jpeg__decode_mcu_row(jpeg__jpeg* z, int row, int w)
+        {
+            int i, k, x, y;
+            JPEG_SIMD_ALIGN(short, data[64]);
+            for (i = 0; i < w; ++i) {
+                for (k = 0; k < z->scan_n; ++k) {
+                    int n = z->order[k];
+                    int h = z->scan_n == 1 ? 1 : z->img_comp[n].h;
+                    int v = z->scan_n == 1 ? 1 : z->img_comp[n].v;
+                    int ha = z->img_comp[n].ha;
+                    for (y = 0; y < v; ++y) {
+                        for (x = 0; x < h; ++x) {
+                            int x2 = (i * h + x) * z->block;
+                            int y2 = (row * v + y) * z->block;
+                            if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                            if (n < z->idct_n)
+                                z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
+                        }
+                    }
+                }
+                if (--z->todo <= 0) {
+                    if (z->code_bits < 24) jpeg__grow_buffer_unsafe(z);
+                    if (!JPEG__RESTART(z->marker)) return 2;
+                    jpeg__jpeg_reset(z);
+                }
+            }
+            return 1;
+        }
+
+        // Restart intervals of a baseline scan are independent: the entropy decoder and the DC prediction are reset
+        // at each RSTn marker. So if the whole stream is in memory we find the interval boundaries with a fast byte
+        // scan and decode the intervals in parallel. Returns -1 if the scan has to be decoded sequentially.
+        static int jpeg__parse_entropy_coded_data_parallel(jpeg__jpeg* z)
+        {
+            if (z->progressive || z->restart_interval == 0 || z->s->io.read)
+                return -1;
+            int total = z->scan_n == 1 ?
+                ((z->img_comp[z->order[0]].x + 7) >> 3) * ((z->img_comp[z->order[0]].y + 7) >> 3) :
+                z->img_mcu_x * z->img_mcu_y;
+            int count = (total + z->restart_interval - 1) / z->restart_interval;
+            size_t threads = Simd::Min<size_t>(Base::GetThreadNumber(), count);
+            if (threads < 2)
+                return -1;
+
+            std::vector<jpeg_uc*> bounds(1, z->s->img_buffer);
+            jpeg_uc* p = z->s->img_buffer, * e = z->s->img_buffer_end, marker = JPEG__MARKER_none;
+            for (; p + 1 < e; ++p) {
+                if (p[0] != 0xff || p[1] == 0xff)
+                    continue;
+                if (p[1] == 0x00)
+                    ++p;
+                else if (JPEG__RESTART(p[1]))
+                    bounds.push_back(++p + 1);
+                else {
+                    marker = p[1];
+                    break;
+                }
+            }
+            if (marker == JPEG__MARKER_none || (int)bounds.size() != count)
+                return -1;
+            bounds.push_back(p);
+
+            std::vector<jpeg__context> contexts(threads, *z->s);
+            std::vector<jpeg__jpeg> decoders(threads, *z);
+            std::vector<int> results(count, 0);
+            for (size_t t = 0; t < threads; ++t)
+                decoders[t].s = &contexts[t];
+            Simd::Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+            {
+                jpeg__jpeg* d = &decoders[thread];
+                for (size_t i = begin; i < end; ++i) {
+                    d->s->img_buffer = bounds[i];
+                    d->s->img_buffer_end = bounds[i + 1];
+                    results[i] = jpeg__decode_restart_interval(d, (int)i * z->restart_interval, Simd::Min((int)i * z->restart_interval + z->restart_interval, total));
+                }
+            }, threads, 1);
+            for (int i = 0; i < count; ++i)
+                if (!results[i])
+                    return 0;
+
+            z->s->img_buffer = p + 2;
+            z->marker = marker;
+            return 1;
+        }
+
         static void jpeg__jpeg_dequantize(short* data, jpeg__uint16* dequant)
         {
             int i;
@@ -1398,7 +1597,8 @@ namespace Simd
                         for (i = 0; i < w; ++i) {
                             short* data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
                             jpeg__jpeg_dequantize(data, z->dequant[z->img_comp[n].tq]);
-                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2, data);
+                            if (n < z->idct_n)
+                                z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * z->block + i * z->block, z->img_comp[n].w2, data);
                         }
                     }
                 }
@@ -1633,8 +1833,8 @@ namespace Simd
                 //
                 // img_mcu_x, img_mcu_y: <=17 bits; comp[i].h and .v are <=4 (checked earlier)
                 // so these muls can't overflow with 32-bit ints (which we require)
-                z->img_comp[i].w2 = z->img_mcu_x * z->img_comp[i].h * 8;
-                z->img_comp[i].h2 = z->img_mcu_y * z->img_comp[i].v * 8;
+                z->img_comp[i].w2 = z->img_mcu_x * z->img_comp[i].h * z->block;
+                z->img_comp[i].h2 = z->img_mcu_y * z->img_comp[i].v * z->block;
                 z->img_comp[i].coeff = 0;
                 z->img_comp[i].raw_coeff = 0;
                 z->img_comp[i].linebuf = NULL;
@@ -1644,10 +1844,9 @@ namespace Simd
                 // align blocks for idct using mmx/sse
                 z->img_comp[i].data = (jpeg_uc*)(((size_t)z->img_comp[i].raw_data + 15) & ~15);
                 if (z->progressive) {
-                    // w2, h2 are multiples of 8 (see above)
-                    z->img_comp[i].coeff_w = z->img_comp[i].w2 / 8;
-                    z->img_comp[i].coeff_h = z->img_comp[i].h2 / 8;
-                    z->img_comp[i].raw_coeff = jpeg__malloc_mad3(z->img_comp[i].w2, z->img_comp[i].h2, sizeof(short), 15);
+                    z->img_comp[i].coeff_w = z->img_mcu_x * z->img_comp[i].h;
+                    z->img_comp[i].coeff_h = z->img_mcu_y * z->img_comp[i].v;
+                    z->img_comp[i].raw_coeff = jpeg__malloc_mad3(z->img_comp[i].coeff_w * 64, z->img_comp[i].coeff_h, sizeof(short), 15);
                     if (z->img_comp[i].raw_coeff == NULL)
                         return jpeg__free_jpeg_components(z, i + 1, JpegLoadError("outofmem", "Out of memory"));
                     z->img_comp[i].coeff = (short*)(((size_t)z->img_comp[i].raw_coeff + 15) & ~15);
@@ -1691,6 +1890,17 @@ namespace Simd
         }
 
         // decode image to YCbCr format
+        static int jpeg__is_rgb(jpeg__jpeg* z)
+        {
+            return z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
+        }
+
+        // the chroma components of a YCbCr image are not transformed when only the luma is needed
+        static void jpeg__setup_idct_n(jpeg__jpeg* z)
+        {
+            z->idct_n = z->luma_only && z->s->img_n == 3 && !jpeg__is_rgb(z) ? 1 : 4;
+        }
+
         static int jpeg__decode_jpeg_image(jpeg__jpeg* j)
         {
             int m;
@@ -1704,7 +1914,10 @@ namespace Simd
             while (!jpeg__EOI(m)) {
                 if (jpeg__SOS(m)) {
                     if (!jpeg__process_scan_header(j)) return 0;
-                    if (!jpeg__parse_entropy_coded_data(j)) return 0;
+                    jpeg__setup_idct_n(j);
+                    int result = jpeg__parse_entropy_coded_data_parallel(j);
+                    if (result < 0) result = jpeg__parse_entropy_coded_data(j);
+                    if (!result) return 0;
                     if (j->marker == JPEG__MARKER_none) {
                         // handle 0s at the end of image data from IP Kamera 9060
                         while (!jpeg__at_eof(j->s)) {
@@ -1964,7 +2177,7 @@ namespace Simd
                 out[0] = (jpeg_uc)r;
                 out[1] = (jpeg_uc)g;
                 out[2] = (jpeg_uc)b;
-                out[3] = 255;
+                if (step == 4) out[3] = 255;
                 out += step;
             }
         }
@@ -2098,7 +2311,7 @@ namespace Simd
                 out[0] = (jpeg_uc)r;
                 out[1] = (jpeg_uc)g;
                 out[2] = (jpeg_uc)b;
-                out[3] = 255;
+                if (step == 4) out[3] = 255;
                 out += step;
             }
         }
@@ -2107,6 +2320,9 @@ namespace Simd
         // set up the kernels
         static void jpeg__setup_jpeg(jpeg__jpeg* j)
         {
+            j->block = 8;
+            j->luma_only = 0;
+            j->idct_n = 4;
             j->idct_block_kernel = jpeg__idct_block;
             j->YCbCr_to_RGB_kernel = jpeg__YCbCr_to_RGB_row;
             j->resample_row_hv_2_kernel = jpeg__resample_row_hv_2;
@@ -2126,6 +2342,29 @@ namespace Simd
 #endif
         }
 
+        // set up reduced size decoding: every 8x8 block is decoded to 4x4 (scale = 2), 2x2 (scale = 4) or 1x1 (scale = 8) pixels
+        static void jpeg__setup_scale(jpeg__jpeg* j, int scale)
+        {
+            j->block = 8 / scale;
+            switch (j->block) {
+            case 4: j->idct_block_kernel = Base::JpegIdct4x4; break;
+            case 2: j->idct_block_kernel = Base::JpegIdct2x2; break;
+            case 1: j->idct_block_kernel = Base::JpegIdct1x1; break;
+            }
+        }
+
+        // after reduced size decoding the image and component planes are 8 / block times smaller
+        static void jpeg__scale_dimensions(jpeg__jpeg* z)
+        {
+            int i, scale = 8 / z->block;
+            z->s->img_x = (z->s->img_x + scale - 1) / scale;
+            z->s->img_y = (z->s->img_y + scale - 1) / scale;
+            for (i = 0; i < z->s->img_n; ++i) {
+                z->img_comp[i].x = (z->img_comp[i].x + scale - 1) / scale;
+                z->img_comp[i].y = (z->img_comp[i].y + scale - 1) / scale;
+            }
+        }
+
         // clean up the temporary component buffers
         static void jpeg__cleanup_jpeg(jpeg__jpeg* j)
         {
@@ -2149,184 +2388,185 @@ namespace Simd
             return (jpeg_uc)((t + (t >> 8)) >> 8);
         }
 
-        static jpeg_uc* load_jpeg_image(jpeg__jpeg* z, int* out_x, int* out_y, int* comp, int req_comp)
-        {
-            int n, decode_n, is_rgb;
-            z->s->img_n = 0; // make jpeg__cleanup_jpeg safe
-
-            // validate req_comp
-            if (req_comp < 0 || req_comp > 4) return jpeg__errpuc("bad req_comp", "Internal error");
-
-            // load a jpeg image from whichever source, but leave in YCbCr format
-            if (!jpeg__decode_jpeg_image(z)) { jpeg__cleanup_jpeg(z); return NULL; }
-
-            // determine actual number of components to generate
-            n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
-
-            is_rgb = z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
-
-            if (z->s->img_n == 3 && n < 3 && !is_rgb)
-                decode_n = 1;
-            else
-                decode_n = z->s->img_n;
-
-            // resample and color-convert
-            {
-                int k;
-                unsigned int i, j;
-                jpeg_uc* output;
-                jpeg_uc* coutput[4] = { NULL, NULL, NULL, NULL };
-
-                jpeg__resample res_comp[4];
-
-                for (k = 0; k < decode_n; ++k) {
-                    jpeg__resample* r = &res_comp[k];
-
-                    // allocate line buffer big enough for upsampling off the edges
-                    // with upsample factor of 4
-                    z->img_comp[k].linebuf = (jpeg_uc*)jpeg__malloc(z->s->img_x + 3);
-                    if (!z->img_comp[k].linebuf) { jpeg__cleanup_jpeg(z); return jpeg__errpuc("outofmem", "Out of memory"); }
-
-                    r->hs = z->img_h_max / z->img_comp[k].h;
-                    r->vs = z->img_v_max / z->img_comp[k].v;
-                    r->ystep = r->vs >> 1;
-                    r->w_lores = (z->s->img_x + r->hs - 1) / r->hs;
-                    r->ypos = 0;
-                    r->line0 = r->line1 = z->img_comp[k].data;
-
-                    if (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
-                    else if (r->hs == 1 && r->vs == 2) r->resample = jpeg__resample_row_v_2;
-                    else if (r->hs == 2 && r->vs == 1) r->resample = jpeg__resample_row_h_2;
-                    else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
-                    else                               r->resample = jpeg__resample_row_generic;
-                }
-
-                // can't error after this so, this is safe
-                output = (jpeg_uc*)jpeg__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
-                if (!output) { jpeg__cleanup_jpeg(z); return jpeg__errpuc("outofmem", "Out of memory"); }
-
-                // now go ahead and resample
-                for (j = 0; j < z->s->img_y; ++j) {
-                    jpeg_uc* out = output + n * z->s->img_x * j;
-                    for (k = 0; k < decode_n; ++k) {
-                        jpeg__resample* r = &res_comp[k];
-                        int y_bot = r->ystep >= (r->vs >> 1);
-                        coutput[k] = r->resample(z->img_comp[k].linebuf,
-                            y_bot ? r->line1 : r->line0,
-                            y_bot ? r->line0 : r->line1,
-                            r->w_lores, r->hs);
-                        if (++r->ystep >= r->vs) {
-                            r->ystep = 0;
-                            r->line0 = r->line1;
-                            if (++r->ypos < z->img_comp[k].y)
-                                r->line1 += z->img_comp[k].w2;
+        static void jpeg__convert_row(jpeg__jpeg* z, jpeg_uc* out, jpeg_uc* coutput[4], int n, int is_rgb)
+        {
+            unsigned int i;
+            if (n >= 3) {
+                jpeg_uc* y = coutput[0];
+                if (z->s->img_n == 3) {
+                    if (is_rgb) {
+                        for (i = 0; i < z->s->img_x; ++i) {
+                            out[0] = y[i];
+                            out[1] = coutput[1][i];
+                            out[2] = coutput[2][i];
+                            if (n == 4) out[3] = 255;
+                            out += n;
                         }
                     }
-                    if (n >= 3) {
-                        jpeg_uc* y = coutput[0];
-                        if (z->s->img_n == 3) {
-                            if (is_rgb) {
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    out[0] = y[i];
-                                    out[1] = coutput[1][i];
-                                    out[2] = coutput[2][i];
-                                    out[3] = 255;
-                                    out += n;
-                                }
-                            }
-                            else {
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                            }
+                    else {
+                        z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+                    }
+                }
+                else if (z->s->img_n == 4) {
+                    if (z->app14_color_transform == 0) { // CMYK
+                        for (i = 0; i < z->s->img_x; ++i) {
+                            jpeg_uc m = coutput[3][i];
+                            out[0] = jpeg__blinn_8x8(coutput[0][i], m);
+                            out[1] = jpeg__blinn_8x8(coutput[1][i], m);
+                            out[2] = jpeg__blinn_8x8(coutput[2][i], m);
+                            if (n == 4) out[3] = 255;
+                            out += n;
                         }
-                        else if (z->s->img_n == 4) {
-                            if (z->app14_color_transform == 0) { // CMYK
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    jpeg_uc m = coutput[3][i];
-                                    out[0] = jpeg__blinn_8x8(coutput[0][i], m);
-                                    out[1] = jpeg__blinn_8x8(coutput[1][i], m);
-                                    out[2] = jpeg__blinn_8x8(coutput[2][i], m);
-                                    out[3] = 255;
-                                    out += n;
-                                }
-                            }
-                            else if (z->app14_color_transform == 2) { // YCCK
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    jpeg_uc m = coutput[3][i];
-                                    out[0] = jpeg__blinn_8x8(255 - out[0], m);
-                                    out[1] = jpeg__blinn_8x8(255 - out[1], m);
-                                    out[2] = jpeg__blinn_8x8(255 - out[2], m);
-                                    out += n;
-                                }
-                            }
-                            else { // YCbCr + alpha?  Ignore the fourth channel for now
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                            }
+                    }
+                    else if (z->app14_color_transform == 2) { // YCCK
+                        z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+                        for (i = 0; i < z->s->img_x; ++i) {
+                            jpeg_uc m = coutput[3][i];
+                            out[0] = jpeg__blinn_8x8(255 - out[0], m);
+                            out[1] = jpeg__blinn_8x8(255 - out[1], m);
+                            out[2] = jpeg__blinn_8x8(255 - out[2], m);
+                            out += n;
                         }
-                        else
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                out[0] = out[1] = out[2] = y[i];
-                                out[3] = 255; // not used if n==3
-                                out += n;
-                            }
                     }
+                    else { // YCbCr + alpha?  Ignore the fourth channel for now
+                        z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+                    }
+                }
+                else
+                    for (i = 0; i < z->s->img_x; ++i) {
+                        out[0] = out[1] = out[2] = y[i];
+                        if (n == 4) out[3] = 255;
+                        out += n;
+                    }
+            }
+            else {
+                if (is_rgb) {
+                    if (n == 1)
+                        for (i = 0; i < z->s->img_x; ++i)
+                            *out++ = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
                     else {
-                        if (is_rgb) {
-                            if (n == 1)
-                                for (i = 0; i < z->s->img_x; ++i)
-                                    *out++ = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                            else {
-                                for (i = 0; i < z->s->img_x; ++i, out += 2) {
-                                    out[0] = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                                    out[1] = 255;
-                                }
-                            }
-                        }
-                        else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                jpeg_uc m = coutput[3][i];
-                                jpeg_uc r = jpeg__blinn_8x8(coutput[0][i], m);
-                                jpeg_uc g = jpeg__blinn_8x8(coutput[1][i], m);
-                                jpeg_uc b = jpeg__blinn_8x8(coutput[2][i], m);
-                                out[0] = jpeg__compute_y(r, g, b);
-                                out[1] = 255;
-                                out += n;
-                            }
-                        }
-                        else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                out[0] = jpeg__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
-                                out[1] = 255;
-                                out += n;
-                            }
-                        }
-                        else {
-                            jpeg_uc* y = coutput[0];
-                            if (n == 1)
-                                for (i = 0; i < z->s->img_x; ++i) out[i] = y[i];
-                            else
-                                for (i = 0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
+                        for (i = 0; i < z->s->img_x; ++i, out += 2) {
+                            out[0] = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+                            out[1] = 255;
                         }
                     }
                 }
-                jpeg__cleanup_jpeg(z);
-                *out_x = z->s->img_x;
-                *out_y = z->s->img_y;
-                if (comp) *comp = z->s->img_n >= 3 ? 3 : 1; // report original components, not output
-                return output;
+                else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
+                    for (i = 0; i < z->s->img_x; ++i) {
+                        jpeg_uc m = coutput[3][i];
+                        jpeg_uc r = jpeg__blinn_8x8(coutput[0][i], m);
+                        jpeg_uc g = jpeg__blinn_8x8(coutput[1][i], m);
+                        jpeg_uc b = jpeg__blinn_8x8(coutput[2][i], m);
+                        out[0] = jpeg__compute_y(r, g, b);
+                        out[1] = 255;
+                        out += n;
+                    }
+                }
+                else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
+                    for (i = 0; i < z->s->img_x; ++i) {
+                        out[0] = jpeg__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
+                        out[1] = 255;
+                        out += n;
+                    }
+                }
+                else {
+                    jpeg_uc* y = coutput[0];
+                    if (n == 1)
+                        for (i = 0; i < z->s->img_x; ++i) out[i] = y[i];
+                    else
+                        for (i = 0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
+                }
             }
         }
 
-        static void* jpeg__jpeg_load(jpeg__context* s, int* x, int* y, int* comp, int req_comp, jpeg__result_info* ri)
+        // sets the resampler state to the state it has before output row 'row' when rows are processed in order from 0
+        static void jpeg__resample_seek(jpeg__resample* r, jpeg_uc* data, int w2, int h, int row)
         {
-            unsigned char* result;
-            jpeg__jpeg* j = (jpeg__jpeg*)jpeg__malloc(sizeof(jpeg__jpeg));
-            JPEG_NOTUSED(ri);
-            j->s = s;
-            jpeg__setup_jpeg(j);
-            result = load_jpeg_image(j, x, y, comp, req_comp);
-            JPEG_FREE(j);
-            return result;
+            int pos = (r->vs >> 1) + row;
+            r->ystep = pos % r->vs;
+            r->ypos = pos / r->vs;
+            r->line1 = data + w2 * Simd::Min(r->ypos, h - 1);
+            r->line0 = r->ypos ? data + w2 * Simd::Min(r->ypos - 1, h - 1) : data;
+        }
+
+        static void jpeg__resample_rows(jpeg__jpeg* z, const jpeg__resample* res_comp, int decode_n, jpeg_uc* output, size_t stride, int n, int is_rgb, int thread, int begin, int end)
+        {
+            int j, k;
+            jpeg_uc* coutput[4] = { NULL, NULL, NULL, NULL };
+            jpeg__resample res[4];
+            for (k = 0; k < decode_n; ++k) {
+                res[k] = res_comp[k];
+                jpeg__resample_seek(res + k, z->img_comp[k].data, z->img_comp[k].w2, z->img_comp[k].y, begin);
+            }
+            for (j = begin; j < end; ++j) {
+                jpeg_uc* out = output + stride * (j - begin);
+                for (k = 0; k < decode_n; ++k) {
+                    jpeg__resample* r = res + k;
+                    int y_bot = r->ystep >= (r->vs >> 1);
+                    coutput[k] = r->resample(z->img_comp[k].linebuf + (size_t)thread * (z->s->img_x + 3),
+                        y_bot ? r->line1 : r->line0,
+                        y_bot ? r->line0 : r->line1,
+                        r->w_lores, r->hs);
+                    if (++r->ystep >= r->vs) {
+                        r->ystep = 0;
+                        r->line0 = r->line1;
+                        if (++r->ypos < z->img_comp[k].y)
+                            r->line1 += z->img_comp[k].w2;
+                    }
+                }
+                jpeg__convert_row(z, out, coutput, n, is_rgb);
+            }
+        }
+
+        // allocates line buffers (one per thread) and sets up the resamplers of the first 'decode_n' components
+        static int jpeg__setup_resample(jpeg__jpeg* z, jpeg__resample* res_comp, int decode_n, int threads)
+        {
+            int k;
+            for (k = 0; k < decode_n; ++k) {
+                jpeg__resample* r = &res_comp[k];
+
+                // allocate line buffer (one per thread) big enough for upsampling off the edges
+                // with upsample factor of 4
+                z->img_comp[k].linebuf = (jpeg_uc*)jpeg__malloc_mad2(threads, z->s->img_x + 3, 0);
+                if (!z->img_comp[k].linebuf) return JpegLoadError("outofmem", "Out of memory");
+
+                r->hs = z->img_h_max / z->img_comp[k].h;
+                r->vs = z->img_v_max / z->img_comp[k].v;
+                r->ystep = r->vs >> 1;
+                r->w_lores = (z->s->img_x + r->hs - 1) / r->hs;
+                r->ypos = 0;
+                r->line0 = r->line1 = z->img_comp[k].data;
+
+                if (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
+                else if (r->hs == 1 && r->vs == 2) r->resample = jpeg__resample_row_v_2;
+                else if (r->hs == 2 && r->vs == 1) r->resample = jpeg__resample_row_h_2;
+                else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
+                else                               r->resample = jpeg__resample_row_generic;
+            }
+            return 1;
+        }
+
+        // decodes the image into component planes (it stays in YCbCr format), returns the number of components to generate
+        static int jpeg__decode_image(jpeg__jpeg* z, int req_comp, int* decode_n, int* is_rgb)
+        {
+            int n;
+            z->s->img_n = 0; // make jpeg__cleanup_jpeg safe
+
+            if (!jpeg__decode_jpeg_image(z)) { jpeg__cleanup_jpeg(z); return 0; }
+
+            if (z->block < 8)
+                jpeg__scale_dimensions(z);
+
+            // determine actual number of components to generate
+            n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
+
+            *is_rgb = jpeg__is_rgb(z);
+
+            if (z->s->img_n == 3 && n < 3 && !*is_rgb)
+                *decode_n = 1;
+            else
+                *decode_n = z->s->img_n;
+            return n;
         }
 
         static int jpeg__jpeg_test(jpeg__context* s)
@@ -2385,57 +2625,452 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        static void JpegRgbToAny(const uint8_t* rgb, size_t width, size_t height, size_t rgbStride, SimdPixelFormatType format, uint8_t* dst, size_t dstStride)
+        {
+            switch (format)
+            {
+            case SimdPixelFormatGray8:
+                Base::RgbToGray(rgb, width, height, rgbStride, dst, dstStride);
+                break;
+            case SimdPixelFormatBgr24:
+                Base::BgrToRgb(rgb, width, height, rgbStride, dst, dstStride);
+                break;
+            case SimdPixelFormatBgra32:
+                Base::RgbToBgra(rgb, width, height, rgbStride, dst, dstStride, 0xFF);
+                break;
+            case SimdPixelFormatRgb24:
+                Base::Copy(rgb, rgbStride, width, height, 3, dst, dstStride);
+                break;
+            case SimdPixelFormatRgba32:
+                Base::BgrToBgra(rgb, width, height, rgbStride, dst, dstStride, 0xFF);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // resamples and color-converts the decoded image band by band straight into the output image, no full size intermediate buffer is used
+        static bool JpegToImage(jpeg__jpeg* z, int n, int decode_n, int is_rgb, SimdPixelFormatType format, uint8_t* dst, size_t stride)
+        {
+            const int BAND = 16;
+            jpeg__resample res[4];
+            size_t threads = Base::GetThreadNumber();
+            if (!jpeg__setup_resample(z, res, decode_n, (int)threads))
+                return false;
+            size_t width = z->s->img_x;
+            bool direct = format == SimdPixelFormatGray8 || format == SimdPixelFormatRgb24;
+            Array8u rgb(direct ? 0 : threads * 3 * width * BAND);
+            Simd::Parallel(0, z->s->img_y, [&](size_t thread, size_t begin, size_t end)
+            {
+                if (direct)
+                    jpeg__resample_rows(z, res, decode_n, dst + begin * stride, stride, n, is_rgb, (int)thread, (int)begin, (int)end);
+                else
+                {
+                    uint8_t* buf = rgb.data + thread * 3 * width * BAND;
+                    for (size_t row = begin; row < end; row += BAND)
+                    {
+                        size_t band = Simd::Min<size_t>(end - row, BAND);
+                        jpeg__resample_rows(z, res, decode_n, buf, 3 * width, 3, is_rgb, (int)thread, (int)row, (int)(row + band));
+                        JpegRgbToAny(buf, width, band, 3 * width, format, dst + row * stride, stride);
+                    }
+                }
+            }, threads, 8);
+            return true;
+        }
+
+        //---------------------------------------------------------------------
+
+        // Incremental decoding of a baseline JPEG: the headers are parsed as soon as they are complete, then the
+        // entropy-coded data is decoded MCU row by MCU row while it arrives. A row whose decoding runs out of data
+        // is rolled back and retried after more data is fed. Progressive and non-interleaved multi-scan images are
+        // accumulated and decoded as a whole when the EOI marker has been received.
+        struct ImageJpegLoader::Decoder
+        {
+            enum Stage
+            {
+                StageHeader,
+                StageScan,
+                StageWhole,
+                StageDone,
+                StageError,
+            } stage;
+            jpeg__context s;
+            jpeg__jpeg j;
+            jpeg__resample res[4];
+            std::vector<uint8_t> data;
+            size_t pos, need, scanned;
+            int width, height, mcus, rows, decoded, pulled, decode_n, is_rgb;
+            bool eoi, whole;
+            Array8u rgb;
+
+            static const int BAND = 16;
+
+            Decoder()
+                : stage(StageHeader), pos(0), need(0), scanned(0), width(0), height(0), mcus(0), rows(0)
+                , decoded(0), pulled(0), decode_n(0), is_rgb(0), eoi(false), whole(false)
+            {
+                memset(&s, 0, sizeof(s));
+                memset(&j, 0, sizeof(j));
+            }
+
+            ~Decoder()
+            {
+                jpeg__free_jpeg_components(&j, 4, 0);
+            }
+
+            // returns true if all segments up to and including SOS (or the EOI marker) have been received
+            bool HeaderReceived() const
+            {
+                size_t p = 2, size = data.size();
+                for (;;)
+                {
+                    while (p < size && data[p] != 0xff) p++;
+                    while (p < size && data[p] == 0xff) p++;
+                    if (p >= size)
+                        return false;
+                    int m = data[p];
+                    if (m == 0xd9)
+                        return true;
+                    if (m == 0x01 || JPEG__RESTART(m) || m == 0xd8)
+                    {
+                        p++;
+                        continue;
+                    }
+                    if (p + 3 > size)
+                        return false;
+                    p += 1 + ((data[p + 1] << 8) | data[p + 2]);
+                    if (m == 0xda)
+                        return p <= size;
+                }
+            }
+
+            void Bind()
+            {
+                s.img_buffer = s.img_buffer_original = data.data() + pos;
+                s.img_buffer_end = s.img_buffer_original_end = data.data() + data.size();
+            }
+
+            bool ParseHeader(int scale, bool luma)
+            {
+                Bind();
+                j.s = &s;
+                jpeg__setup_jpeg(&j);
+                jpeg__setup_scale(&j, scale);
+                j.luma_only = luma;
+                j.restart_interval = 0;
+                if (!jpeg__decode_jpeg_header(&j, JPEG__SCAN_load))
+                    return false;
+                int m = jpeg__get_marker(&j);
+                while (!jpeg__SOS(m))
+                {
+                    if (jpeg__EOI(m))
+                        return JpegLoadError("no SOS", "Corrupt JPEG") != 0;
+                    if (!jpeg__process_marker(&j, m))
+                        return false;
+                    m = jpeg__get_marker(&j);
+                }
+                if (!jpeg__process_scan_header(&j))
+                    return false;
+                jpeg__setup_idct_n(&j);
+                width = (s.img_x + scale - 1) / scale;
+                height = (s.img_y + scale - 1) / scale;
+                pos = s.img_buffer - data.data();
+                scanned = pos;
+                if (j.progressive || j.scan_n != s.img_n)
+                {
+                    jpeg__free_jpeg_components(&j, 4, 0);
+                    stage = StageWhole;
+                    return true;
+                }
+                int n = j.order[0];
+                mcus = j.scan_n == 1 ? (j.img_comp[n].x + 7) >> 3 : j.img_mcu_x;
+                rows = j.scan_n == 1 ? (j.img_comp[n].y + 7) >> 3 : j.img_mcu_y;
+                if (j.block < 8)
+                    jpeg__scale_dimensions(&j);
+                is_rgb = jpeg__is_rgb(&j);
+                decode_n = luma && s.img_n == 3 && !is_rgb ? 1 : s.img_n;
+                if (!jpeg__setup_resample(&j, res, decode_n, 1))
+                    return false;
+                jpeg__jpeg_reset(&j);
+                stage = StageScan;
+                return true;
+            }
+
+            void FindEoi()
+            {
+                for (size_t i = Simd::Max<size_t>(scanned, 1); i < data.size() && !eoi; ++i)
+                    if (data[i - 1] == 0xff && data[i] == 0xd9)
+                        eoi = true;
+                scanned = data.size();
+            }
+
+            bool DecodeRows()
+            {
+                while (decoded < rows)
+                {
+                    size_t available = data.size() - pos;
+                    if (available < need && !eoi)
+                        break;
+                    jpeg__uint32 code_buffer = j.code_buffer;
+                    int code_bits = j.code_bits, nomore = j.nomore, todo = j.todo, dc_pred[4];
+                    unsigned char marker = j.marker;
+                    for (int k = 0; k < 4; ++k)
+                        dc_pred[k] = j.img_comp[k].dc_pred;
+                    Bind();
+                    int result = jpeg__decode_mcu_row(&j, decoded, mcus);
+                    if (s.img_buffer >= s.img_buffer_end && !j.nomore && !eoi)
+                    {
+                        j.code_buffer = code_buffer;
+                        j.code_bits = code_bits;
+                        j.nomore = nomore;
+                        j.todo = todo;
+                        j.marker = marker;
+                        for (int k = 0; k < 4; ++k)
+                            j.img_comp[k].dc_pred = dc_pred[k];
+                        need = available * 2;
+                        break;
+                    }
+                    if (result == 0)
+                        return false;
+                    need = s.img_buffer - (data.data() + pos);
+                    pos = s.img_buffer - data.data();
+                    decoded = result == 2 ? rows : decoded + 1;
+                }
+                if (decoded == rows)
+                {
+                    std::vector<uint8_t>().swap(data);
+                    pos = 0;
+                    stage = StageDone;
+                }
+                else if (pos > 0x10000 && pos * 2 > data.size())
+                {
+                    data.erase(data.begin(), data.begin() + pos);
+                    scanned -= pos;
+                    pos = 0;
+                }
+                return true;
+            }
+
+            int Available() const
+            {
+                if (stage == StageDone)
+                    return height;
+                if (stage != StageScan)
+                    return 0;
+                int available = height;
+                for (int k = 0; k < decode_n; ++k)
+                {
+                    int vs = j.img_v_max / j.img_comp[k].v;
+                    int lines = decoded * (j.scan_n == 1 ? 1 : j.img_comp[k].v) * j.block;
+                    available = Min(available, lines * vs - (vs >> 1));
+                }
+                return Max(available, 0);
+            }
+        };
+
+        //---------------------------------------------------------------------
+
         ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
             : ImageLoader(param)
+            , _decoder(NULL)
         {
             if (_param.format == SimdPixelFormatNone)
                 _param.format = SimdPixelFormatRgb24;
         }
 
+        ImageJpegLoader::~ImageJpegLoader()
+        {
+            if (_decoder)
+                delete _decoder;
+        }
+
         bool ImageJpegLoader::FromStream()
         {
-            int x, y, comp;
             jpeg__context s;
-            s.io.eof = jpeg__stdio_eof;
-            s.io.read = jpeg__stdio_read;
-            s.io.skip = jpeg__stdio_skip;
-            s.io_user_data = &_stream;
-            s.buflen = sizeof(s.buffer_start);
-            s.read_from_callbacks = 1;
+            s.io.read = NULL;
+            s.read_from_callbacks = 0;
             s.callback_already_read = 0;
-            s.img_buffer = s.img_buffer_original = s.buffer_start;
-            jpeg__refill_buffer(&s);
-            s.img_buffer_original_end = s.img_buffer_end;
-            jpeg__result_info ri;
-            uint8_t * data = (uint8_t*)jpeg__jpeg_load(&s, &x, &y, &comp, 3, &ri);
-            if (data)
+            s.img_buffer = s.img_buffer_original = (jpeg_uc*)_stream.Current();
+            s.img_buffer_end = s.img_buffer_original_end = (jpeg_uc*)_stream.Data() + _stream.Size();
+            jpeg__jpeg* j = (jpeg__jpeg*)jpeg__malloc(sizeof(jpeg__jpeg));
+            j->s = &s;
+            jpeg__setup_jpeg(j);
+            jpeg__setup_scale(j, (int)_param.scale);
+            j->luma_only = _param.format == SimdPixelFormatGray8;
+            int decode_n, is_rgb, n = jpeg__decode_image(j, j->luma_only ? 1 : 3, &decode_n, &is_rgb);
+            bool result = false;
+            if (n)
             {
-                size_t stride = 3 * x;
-                _image.Recreate(x, y, (Image::Format)_param.format);
-                switch (_param.format)
+                result = InitImage(s.img_x, s.img_y) && JpegToImage(j, n, decode_n, is_rgb, _param.format, _image.data, _image.stride);
+                jpeg__cleanup_jpeg(j);
+            }
+            JPEG_FREE(j);
+            return result;
+        }
+
+        bool ImageJpegLoader::Feed(const uint8_t* data, size_t size)
+        {
+            if (_decoder == NULL)
+                _decoder = new Decoder();
+            Decoder& d = *_decoder;
+            if (d.stage == Decoder::StageError)
+                return false;
+            if (d.stage == Decoder::StageDone)
+                return true;
+            d.data.insert(d.data.end(), data, data + size);
+            if (d.stage == Decoder::StageHeader)
+            {
+                if (!d.HeaderReceived())
+                    return true;
+                if (!d.ParseHeader((int)_param.scale, _param.format == SimdPixelFormatGray8))
                 {
-                case SimdPixelFormatGray8:
-                    Base::RgbToGray(data, x, y, stride, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatBgr24:
-                    Base::BgrToRgb(data, x, y, stride, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatBgra32:
-                    Base::RgbToBgra(data, x, y, stride, _image.data, _image.stride, 0xFF);
-                    break;
-                case SimdPixelFormatRgb24:
-                    Base::Copy(data, stride, x, y, 3, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatRgba32:
-                    Base::BgrToBgra(data, x, y, stride, _image.data, _image.stride, 0xFF);
-                    break;
-                default: 
-                    break;
+                    d.stage = Decoder::StageError;
+                    return false;
                 }
-                JPEG_FREE(data);
-                return true;
             }
-            return false;
+            d.FindEoi();
+            if (d.stage == Decoder::StageScan && !d.DecodeRows())
+            {
+                d.stage = Decoder::StageError;
+                return false;
+            }
+            if (d.stage == Decoder::StageWhole && d.eoi)
+            {
+                _stream.Init(d.data.data(), d.data.size());
+                bool result = FromStream();
+                std::vector<uint8_t>().swap(d.data);
+                d.stage = result ? Decoder::StageDone : Decoder::StageError;
+                d.whole = true;
+                return result;
+            }
+            return true;
+        }
+
+        bool ImageJpegLoader::Info(size_t* width, size_t* height, SimdPixelFormatType* format) const
+        {
+            if (_decoder == NULL || _decoder->stage == Decoder::StageHeader || _decoder->stage == Decoder::StageError)
+                return false;
+            *width = _decoder->width;
+            *height = _decoder->height;
+            *format = _param.format;
+            return true;
+        }
+
+        size_t ImageJpegLoader::Pull(uint8_t* dst, size_t stride, size_t rows)
+        {
+            if (_decoder == NULL)
+                return 0;
+            Decoder& d = *_decoder;
+            rows = Simd::Min<size_t>(rows, d.Available() - d.pulled);
+            if (d.whole)
+            {
+                size_t size = _image.width * _image.PixelSize();
+                for (size_t row = 0; row < rows; ++row)
+                    memcpy(dst + row * stride, _image.Row<uint8_t>(d.pulled + row), size);
+                d.pulled += (int)rows;
+            }
+            else if (_param.format == SimdPixelFormatGray8 || _param.format == SimdPixelFormatRgb24)
+            {
+                int n = _param.format == SimdPixelFormatGray8 ? 1 : 3;
+                jpeg__resample_rows(&d.j, d.res, d.decode_n, dst, stride, n, d.is_rgb, 0, d.pulled, d.pulled + (int)rows);
+                d.pulled += (int)rows;
+            }
+            else
+            {
+                d.rgb.Resize(3 * d.width * Decoder::BAND);
+                for (size_t row = 0; row < rows; row += Decoder::BAND)
+                {
+                    int band = (int)Simd::Min<size_t>(rows - row, Decoder::BAND);
+                    jpeg__resample_rows(&d.j, d.res, d.decode_n, d.rgb.data, 3 * d.width, 3, d.is_rgb, 0, d.pulled, d.pulled + band);
+                    JpegRgbToAny(d.rgb.data, d.width, band, 3 * d.width, _param.format, dst + row * stride, stride);
+                    d.pulled += band;
+                }
+            }
+            if (!d.whole && d.pulled == d.height)
+                jpeg__free_jpeg_components(&d.j, 4, 0);
+            return rows;
+        }
+
+        // subsamples a decoded chroma plane to 4:2:0, a plane which is already 4:2:0 is copied as is
+        static void JpegChromaToYuv420p(const jpeg__jpeg* z, int k, size_t width, size_t height, uint8_t* dst, size_t stride)
+        {
+            const uint8_t* src = z->img_comp[k].data;
+            size_t srcStride = z->img_comp[k].w2;
+            int hs = z->img_h_max / z->img_comp[k].h;
+            int vs = z->img_v_max / z->img_comp[k].v;
+            if (hs == 2 && vs == 2)
+                Base::Copy(src, srcStride, width, height, 1, dst, stride);
+            else
+            {
+                for (size_t row = 0; row < height; ++row, dst += stride)
+                {
+                    const uint8_t* src0 = src + (2 * row + 0) / vs * srcStride;
+                    const uint8_t* src1 = src + (2 * row + 1) / vs * srcStride;
+                    for (size_t col = 0; col < width; ++col)
+                    {
+                        size_t col0 = (2 * col + 0) / hs, col1 = (2 * col + 1) / hs;
+                        dst[col] = uint8_t((src0[col0] + src0[col1] + src1[col0] + src1[col1] + 2) >> 2);
+                    }
+                }
+            }
+        }
+
+        bool ImageJpegLoader::ToYuv420p(uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, size_t width, size_t height)
+        {
+            jpeg__context s;
+            s.io.read = NULL;
+            s.read_from_callbacks = 0;
+            s.callback_already_read = 0;
+            s.img_buffer = s.img_buffer_original = (jpeg_uc*)_stream.Current();
+            s.img_buffer_end = s.img_buffer_original_end = (jpeg_uc*)_stream.Data() + _stream.Size();
+            jpeg__jpeg* j = (jpeg__jpeg*)jpeg__malloc(sizeof(jpeg__jpeg));
+            j->s = &s;
+            jpeg__setup_jpeg(j);
+            jpeg__setup_scale(j, (int)_param.scale);
+            int decode_n, is_rgb, n = jpeg__decode_image(j, 3, &decode_n, &is_rgb);
+            bool result = false;
+            if (n && s.img_x == width && s.img_y == height)
+            {
+                if (s.img_n == 3 && !is_rgb)
+                {
+                    Base::Copy(j->img_comp[0].data, j->img_comp[0].w2, width, height, 1, y, yStride);
+                    JpegChromaToYuv420p(j, 1, width / 2, height / 2, u, uStride);
+                    JpegChromaToYuv420p(j, 2, width / 2, height / 2, v, vStride);
+                    result = true;
+                }
+                else if (s.img_n == 1)
+                {
+                    Base::Copy(j->img_comp[0].data, j->img_comp[0].w2, width, height, 1, y, yStride);
+                    Base::Fill(u, uStride, width / 2, height / 2, 1, 128);
+                    Base::Fill(v, vStride, width / 2, height / 2, 1, 128);
+                    result = true;
+                }
+                else
+                {
+                    Array8u bgra(width * height * 4);
+                    if (JpegToImage(j, n, decode_n, is_rgb, SimdPixelFormatBgra32, bgra.data, width * 4))
+                    {
+                        Base::BgraToYuv420pV2(bgra.data, width * 4, width, height, y, yStride, u, uStride, v, vStride, SimdYuvTrect871);
+                        result = true;
+                    }
+                }
+            }
+            if (n)
+                jpeg__cleanup_jpeg(j);
+            JPEG_FREE(j);
+            return result;
+        }
+
+        bool ImageLoadJpegToYuv420p(const uint8_t* data, size_t size, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, 
+            uint8_t* v, size_t vStride, size_t width, size_t height, SimdYuvType yuvType)
+        {
+            if (yuvType != SimdYuvTrect871 || (width & 1) || (height & 1))
+                return false;
+            ImageLoaderParam param(data, size, SimdPixelFormatNone);
+            if (!param.Validate() || param.file != SimdImageFileJpeg)
+                return false;
+            ImageJpegLoader loader(param);
+            return loader.ToYuv420p(y, yStride, u, uStride, v, vStride, width, height);
         }
     }
 }
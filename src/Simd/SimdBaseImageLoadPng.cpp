@@ -142,7 +142,20 @@ namespace Simd
                 }
             }
 
-            static int ParseHuffmanBlock(InputMemoryStream& is, const Zhuffman& zLength, const Zhuffman& zDistance, OutputMemoryStream& os)
+            // the longest length/distance pair: 15 + 5 bits of length and 15 + 13 bits of distance
+            const size_t ZSYMBOL_BITS_MAX = 48;
+
+            // matches with distance of at least 8 bytes are copied by 8-byte words and may write up to 7 bytes past their end
+            const size_t ZCOPY_SLACK = 8;
+
+            static SIMD_INLINE void CopyMatch8(const uint8_t* src, uint8_t* dst)
+            {
+                uint64_t word;
+                memcpy(&word, src, 8);
+                memcpy(dst, &word, 8);
+            }
+
+            template<bool suspend> static int ParseHuffmanBlock(InputMemoryStream& is, const Zhuffman& zLength, const Zhuffman& zDistance, OutputMemoryStream& os)
             {
                 static const int zlengthBase[31] = { 3,4,5,6,7,8,9,10,11,13, 15,17,19,23,27,31,35,43,51,59, 67,83,99,115,131,163,195,227,258,0,0 };
                 static const int zlengthExtra[31] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0,0,0 };
@@ -154,6 +167,11 @@ namespace Simd
                 uint8_t* beg = os.Data(), * dst = os.Current(), * end = beg + os.Capacity();
                 for (;;)
                 {
+                    if (suspend && (is.Size() - is.Pos()) * 8 + is.BitCount() < ZSYMBOL_BITS_MAX)
+                    {
+                        os.Seek(dst - beg);
+                        return 2;
+                    }
                     int z = ZhuffmanDecode(is, zLength);
                     if (z < 256)
                     {
@@ -161,6 +179,7 @@ namespace Simd
                             return CorruptPngError("bad huffman code");
                         if (dst >= end)
                         {
+                            os.Seek(dst - beg);
                             os.Reserve(end - beg + 1);
                             beg = os.Data();
                             dst = os.Current();
@@ -188,9 +207,10 @@ namespace Simd
                             dist += (int)is.ReadBits(zdistExtra[z]);
                         if (dst - beg < dist)
                             return CorruptPngError("bad dist");
-                        if (dst + len > end)
+                        if (dst + len + ZCOPY_SLACK > end)
                         {
-                            os.Reserve(dst - beg + len);
+                            os.Seek(dst - beg);
+                            os.Reserve(dst - beg + len + ZCOPY_SLACK);
                             beg = os.Data();
                             dst = os.Current();
                             end = beg + os.Capacity();
@@ -209,19 +229,23 @@ namespace Simd
                                 dst += len;
                             }
                         }
+                        else if (dist >= 8)
+                        {
+                            const uint8_t* src = dst - dist;
+                            uint8_t* stop = dst + len;
+                            do
+                            {
+                                CopyMatch8(src, dst);
+                                src += 8;
+                                dst += 8;
+                            } while (dst < stop);
+                            dst = stop;
+                        }
                         else
                         {
                             uint8_t* src = dst - dist;
-                            if (dist < len || len < 16)
-                            {
-                                while(len--)
-                                    *dst++ = *src++;
-                            }
-                            else
-                            {
-                                memcpy(dst, src, len);
-                                dst += len;
-                            }                        
+                            while (len--)
+                                *dst++ = *src++;
                         }
                     }
                 }
@@ -286,12 +310,20 @@ namespace Simd
                 return 1;
             }
 
-            static int ParseUncompressedBlock(InputMemoryStream& is, OutputMemoryStream& os)
+            static int ParseUncompressedHeader(InputMemoryStream& is, uint16_t & len)
             {
                 is.ClearBits();
-                uint16_t len, nlen;
+                uint16_t nlen;
                 if (!is.Read16u(len) || !is.Read16u(nlen) || nlen != (len ^ 0xffff))
                     return CorruptPngError("zlib corrupt");
+                return 1;
+            }
+
+            static int ParseUncompressedBlock(InputMemoryStream& is, OutputMemoryStream& os)
+            {
+                uint16_t len;
+                if (!ParseUncompressedHeader(is, len))
+                    return 0;
                 if (!os.Write(is, len))
                     return CorruptPngError("read past buffer");
                 return 1;
@@ -311,7 +343,7 @@ namespace Simd
                 return 1;
             }
 
-            bool Decode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader)
+            static int BuildHuffmanCodes(InputMemoryStream& is, int type, Zhuffman& zLength, Zhuffman& zDistance)
             {
                 static const uint8_t ZdefaultLength[288] = {
                    8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
@@ -328,6 +360,14 @@ namespace Simd
                    5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5
                 };
 
+                if (type == 1)
+                    return zLength.Build(ZdefaultLength, 288) && zDistance.Build(ZdefaultDistance, 32);
+                else
+                    return ComputeHuffmanCodes(is, zLength, zDistance);
+            }
+
+            bool Decode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader)
+            {
                 Zhuffman zLength, zDistance;
                 int final, type;
                 if (parseHeader)
@@ -348,23 +388,113 @@ namespace Simd
                         return false;
                     else
                     {
-                        if (type == 1)
+                        if (!BuildHuffmanCodes(is, type, zLength, zDistance))
+                            return false;
+                        if (!ParseHuffmanBlock<false>(is, zLength, zDistance, os))
+                            return false;
+                    }
+                } while (!final);
+                return true;
+            }
+
+            //-------------------------------------------------------------------------------------------------
+
+            // a dynamic block header takes at most 3 + 14 + 19 * 3 + 318 * 7 bits
+            const size_t ZBLOCK_HEADER_MAX = 320;
+
+            struct Inflater
+            {
+                enum State
+                {
+                    StateHeader,
+                    StateBlock,
+                    StateStored,
+                    StateHuffman,
+                    StateFinished,
+                } state;
+                bool final;
+                size_t stored;
+                Zhuffman zLength, zDistance;
+
+                Inflater(bool parseHeader)
+                    : state(parseHeader ? StateHeader : StateBlock)
+                    , final(false)
+                    , stored(0)
+                {
+                }
+            };
+
+            // decodes as much of the data as possible, stops at a block boundary or symbol when the input runs out;
+            // 'last' means that the input is complete
+            static bool Inflate(Inflater& z, InputMemoryStream& is, OutputMemoryStream& os, bool last)
+            {
+                for (;;)
+                {
+                    size_t available = is.Size() - is.Pos() + is.BitCount() / 8;
+                    switch (z.state)
+                    {
+                    case Inflater::StateHeader:
+                        if (available < 2 && !last)
+                            return true;
+                        if (!ParseHeader(is))
+                            return false;
+                        z.state = Inflater::StateBlock;
+                        break;
+                    case Inflater::StateBlock:
+                    {
+                        if (z.final)
                         {
-                            if (!zLength.Build(ZdefaultLength, 288))
-                                return false;
-                            if (!zDistance.Build(ZdefaultDistance, 32))
+                            z.state = Inflater::StateFinished;
+                            break;
+                        }
+                        if (available < ZBLOCK_HEADER_MAX && !last)
+                            return true;
+                        z.final = is.ReadBits(1) != 0;
+                        int type = (int)is.ReadBits(2);
+                        if (type == 0)
+                        {
+                            uint16_t len;
+                            if (!ParseUncompressedHeader(is, len))
                                 return false;
+                            z.stored = len;
+                            z.state = Inflater::StateStored;
                         }
+                        else if (type == 3)
+                            return false;
                         else
                         {
-                            if (!ComputeHuffmanCodes(is, zLength, zDistance))
+                            if (!BuildHuffmanCodes(is, type, z.zLength, z.zDistance))
                                 return false;
+                            z.state = Inflater::StateHuffman;
                         }
-                        if (!ParseHuffmanBlock(is, zLength, zDistance, os))
+                        break;
+                    }
+                    case Inflater::StateStored:
+                    {
+                        size_t size = Min(z.stored, is.Size() - is.Pos());
+                        os.Write(is.Current(), size);
+                        is.Seek(is.Pos() + size);
+                        z.stored -= size;
+                        if (z.stored)
+                            return last ? CorruptPngError("read past buffer") != 0 : true;
+                        z.state = Inflater::StateBlock;
+                        break;
+                    }
+                    case Inflater::StateHuffman:
+                    {
+                        int result = last ? ParseHuffmanBlock<false>(is, z.zLength, z.zDistance, os) :
+                            ParseHuffmanBlock<true>(is, z.zLength, z.zDistance, os);
+                        if (result == 0)
                             return false;
+                        if (result == 2)
+                            return true;
+                        z.state = Inflater::StateBlock;
+                        break;
                     }
-                } while (!final);
-                return true;
+                    case Inflater::StateFinished:
+                        return true;
+                    }
+                }
             }
         }
 
@@ -372,7 +502,7 @@ namespace Simd
 
         static const uint8_t DepthScaleTable[9] = { 0, 0xff, 0x55, 0, 0x11, 0,0,0, 0x01 };
 
-        static void DecodeLine0(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        void DecodeLine0(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
         {
             if (srcN == dstN)
                 memcpy(dst, curr, width * srcN);
@@ -391,7 +521,7 @@ namespace Simd
             }
         }
 
-        static void DecodeLine1(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        void DecodeLine1(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
         {
             if (srcN == dstN)
             {
@@ -422,7 +552,7 @@ namespace Simd
             }
         }
 
-        static void DecodeLine2(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        void DecodeLine2(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
         {
             if (srcN == dstN)
             {
@@ -445,7 +575,7 @@ namespace Simd
             }
         }
 
-        static void DecodeLine3(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        void DecodeLine3(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
         {
             if (srcN == dstN)
             {
@@ -478,7 +608,7 @@ namespace Simd
             }
         }
 
-        static void DecodeLine4(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        void DecodeLine4(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
         {
             if (srcN == dstN)
             {
@@ -511,7 +641,7 @@ namespace Simd
             }
         }
 
-        static void DecodeLine5(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        void DecodeLine5(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
         {
             if (srcN == dstN)
             {
@@ -542,7 +672,7 @@ namespace Simd
             }
         }
 
-        static void DecodeLine6(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
+        void DecodeLine6(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst)
         {
             if (srcN == dstN)
             {
@@ -600,7 +730,7 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
-        static void ExpandPalette(const uint8_t* src, size_t size, int outN, const uint8_t* palette, uint8_t* dst)
+        void ExpandPalette(const uint8_t* src, size_t size, int outN, const uint8_t* palette, uint8_t* dst)
         {
             if (outN == 3)
             {
@@ -788,6 +918,7 @@ namespace Simd
         ImagePngLoader::ImagePngLoader(const ImageLoaderParam& param)
             : ImageLoader(param)
             , _converter(NULL)
+            , _decoder(NULL)
         {
             if (_param.format == SimdPixelFormatNone)
                 _param.format = SimdPixelFormatRgba32;
@@ -840,14 +971,12 @@ namespace Simd
 
             ExpandPalette();
 
-            ConvertImage();
-
-            return true;
+            return ConvertImage();
         }
 
         bool ImagePngLoader::ParseFile()
         {
-            _first = true, _iPhone = false, _hasTrans = false;
+            _first = true, _iPhone = false, _hasTrans = false, _paletteSize = 0;
             if (!CheckHeader())
                 return false;
             for (bool run = true; run;)
@@ -896,6 +1025,12 @@ namespace Simd
                 if (!_stream.ReadBe32u(crc32))
                     return false;
             }
+            SetOutputChannels();
+            return _idats.size() != 0;
+        }
+
+        void ImagePngLoader::SetOutputChannels()
+        {
             int reqN = 4;
             if (Image::ChannelCount((Image::Format)_param.format) == _channels && _depth != 16)
                 reqN = _channels;
@@ -905,7 +1040,6 @@ namespace Simd
                 _outN = _channels + 1;
             else
                 _outN = _channels;
-            return _idats.size() != 0;
         }
 
         bool ImagePngLoader::CheckHeader()
@@ -976,8 +1110,9 @@ namespace Simd
                 return false;
             if (_stream.CanRead(chunk.size))
             {
-                _palette.Resize(length * 4);
+                _palette.Resize(256 * 4, true);
                 BgrToBgra(_stream.Current(), length, 1, length, _palette.data, _palette.size, 0xFF);
+                _paletteSize = (uint32_t)length;
                 _stream.Skip(chunk.size);
                 return true;
             }
@@ -993,7 +1128,7 @@ namespace Simd
                 return false;
             if (_paletteChannels)
             {
-                if (_palette.size == 0 || chunk.size > _palette.size || !_stream.CanRead(chunk.size))
+                if (_paletteSize == 0 || chunk.size > _paletteSize || !_stream.CanRead(chunk.size))
                     return false;
                 _paletteChannels = 4;
                 for (size_t i = 0; i < chunk.size; ++i)
@@ -1088,9 +1223,10 @@ namespace Simd
             return true;
         }
 
+        static const uint8_t FirstRowFilter[5] = { 0, 1, 0, 5, 6 };
+
         bool ImagePngLoader::CreateImageRaw(const uint8_t* data, uint32_t size, uint32_t width, uint32_t height)
         {
-            static const uint8_t FirstRowFilter[5] = { 0, 1, 0, 5, 6 };
             int bytes = (_depth == 16 ? 2 : 1);
             uint32_t i, j, stride = width * _outN * bytes;
             uint32_t img_len, img_width_bytes;
@@ -1141,82 +1277,7 @@ namespace Simd
             if (_depth < 8)
             {
                 for (j = 0; j < height; ++j)
-                {
-                    uint8_t* cur = _buffer.data + stride * j;
-                    const uint8_t* in = _buffer.data + stride * j + width * _outN - img_width_bytes;
-                    uint8_t scale = (_color == 0) ? DepthScaleTable[_depth] : 1;
-                    if (_depth == 4)
-                    {
-                        for (k = width * _channels; k >= 2; k -= 2, ++in)
-                        {
-                            *cur++ = scale * ((*in >> 4));
-                            *cur++ = scale * ((*in) & 0x0f);
-                        }
-                        if (k > 0)
-                            *cur++ = scale * ((*in >> 4));
-                    }
-                    else if (_depth == 2)
-                    {
-                        for (k = width * _channels; k >= 4; k -= 4, ++in)
-                        {
-                            *cur++ = scale * ((*in >> 6));
-                            *cur++ = scale * ((*in >> 4) & 0x03);
-                            *cur++ = scale * ((*in >> 2) & 0x03);
-                            *cur++ = scale * ((*in) & 0x03);
-                        }
-                        if (k > 0)
-                            *cur++ = scale * ((*in >> 6));
-                        if (k > 1)
-                            *cur++ = scale * ((*in >> 4) & 0x03);
-                        if (k > 2)
-                            *cur++ = scale * ((*in >> 2) & 0x03);
-                    }
-                    else if (_depth == 1)
-                    {
-                        for (k = width * _channels; k >= 8; k -= 8, ++in)
-                        {
-                            *cur++ = scale * ((*in >> 7));
-                            *cur++ = scale * ((*in >> 6) & 0x01);
-                            *cur++ = scale * ((*in >> 5) & 0x01);
-                            *cur++ = scale * ((*in >> 4) & 0x01);
-                            *cur++ = scale * ((*in >> 3) & 0x01);
-                            *cur++ = scale * ((*in >> 2) & 0x01);
-                            *cur++ = scale * ((*in >> 1) & 0x01);
-                            *cur++ = scale * ((*in) & 0x01);
-                        }
-                        if (k > 0) *cur++ = scale * ((*in >> 7));
-                        if (k > 1) *cur++ = scale * ((*in >> 6) & 0x01);
-                        if (k > 2) *cur++ = scale * ((*in >> 5) & 0x01);
-                        if (k > 3) *cur++ = scale * ((*in >> 4) & 0x01);
-                        if (k > 4) *cur++ = scale * ((*in >> 3) & 0x01);
-                        if (k > 5) *cur++ = scale * ((*in >> 2) & 0x01);
-                        if (k > 6) *cur++ = scale * ((*in >> 1) & 0x01);
-                    }
-                    if (_channels != _outN)
-                    {
-                        int q;
-                        cur = _buffer.data + stride * j;
-                        if (_channels == 1)
-                        {
-                            for (q = width - 1; q >= 0; --q)
-                            {
-                                cur[q * 2 + 1] = 255;
-                                cur[q * 2 + 0] = cur[q];
-                            }
-                        }
-                        else
-                        {
-                            assert(_channels == 3);
-                            for (q = width - 1; q >= 0; --q)
-                            {
-                                cur[q * 4 + 3] = 255;
-                                cur[q * 4 + 2] = cur[q * 3 + 2];
-                                cur[q * 4 + 1] = cur[q * 3 + 1];
-                                cur[q * 4 + 0] = cur[q * 3 + 0];
-                            }
-                        }
-                    }
-                }
+                    UnpackRow(_buffer.data + stride * j + width * _outN - img_width_bytes, width, _buffer.data + stride * j);
             }
             else if (_depth == 16)
             {
@@ -1228,6 +1289,84 @@ namespace Simd
             return 1;
         }
 
+        void ImagePngLoader::UnpackRow(const uint8_t* in, uint32_t width, uint8_t* dst)
+        {
+            uint8_t* cur = dst;
+            uint8_t scale = (_color == 0) ? DepthScaleTable[_depth] : 1;
+            int k;
+            if (_depth == 4)
+            {
+                for (k = width * _channels; k >= 2; k -= 2, ++in)
+                {
+                    *cur++ = scale * ((*in >> 4));
+                    *cur++ = scale * ((*in) & 0x0f);
+                }
+                if (k > 0)
+                    *cur++ = scale * ((*in >> 4));
+            }
+            else if (_depth == 2)
+            {
+                for (k = width * _channels; k >= 4; k -= 4, ++in)
+                {
+                    *cur++ = scale * ((*in >> 6));
+                    *cur++ = scale * ((*in >> 4) & 0x03);
+                    *cur++ = scale * ((*in >> 2) & 0x03);
+                    *cur++ = scale * ((*in) & 0x03);
+                }
+                if (k > 0)
+                    *cur++ = scale * ((*in >> 6));
+                if (k > 1)
+                    *cur++ = scale * ((*in >> 4) & 0x03);
+                if (k > 2)
+                    *cur++ = scale * ((*in >> 2) & 0x03);
+            }
+            else if (_depth == 1)
+            {
+                for (k = width * _channels; k >= 8; k -= 8, ++in)
+                {
+                    *cur++ = scale * ((*in >> 7));
+                    *cur++ = scale * ((*in >> 6) & 0x01);
+                    *cur++ = scale * ((*in >> 5) & 0x01);
+                    *cur++ = scale * ((*in >> 4) & 0x01);
+                    *cur++ = scale * ((*in >> 3) & 0x01);
+                    *cur++ = scale * ((*in >> 2) & 0x01);
+                    *cur++ = scale * ((*in >> 1) & 0x01);
+                    *cur++ = scale * ((*in) & 0x01);
+                }
+                if (k > 0) *cur++ = scale * ((*in >> 7));
+                if (k > 1) *cur++ = scale * ((*in >> 6) & 0x01);
+                if (k > 2) *cur++ = scale * ((*in >> 5) & 0x01);
+                if (k > 3) *cur++ = scale * ((*in >> 4) & 0x01);
+                if (k > 4) *cur++ = scale * ((*in >> 3) & 0x01);
+                if (k > 5) *cur++ = scale * ((*in >> 2) & 0x01);
+                if (k > 6) *cur++ = scale * ((*in >> 1) & 0x01);
+            }
+            if (_channels != _outN)
+            {
+                int q;
+                cur = dst;
+                if (_channels == 1)
+                {
+                    for (q = width - 1; q >= 0; --q)
+                    {
+                        cur[q * 2 + 1] = 255;
+                        cur[q * 2 + 0] = cur[q];
+                    }
+                }
+                else
+                {
+                    assert(_channels == 3);
+                    for (q = width - 1; q >= 0; --q)
+                    {
+                        cur[q * 4 + 3] = 255;
+                        cur[q * 4 + 2] = cur[q * 3 + 2];
+                        cur[q * 4 + 1] = cur[q * 3 + 1];
+                        cur[q * 4 + 0] = cur[q * 3 + 0];
+                    }
+                }
+            }
+        }
+
         void ImagePngLoader::ExpandPalette()
         {
             if (_paletteChannels)
@@ -1239,12 +1378,295 @@ namespace Simd
             }
         }
 
-        void ImagePngLoader::ConvertImage()
+        bool ImagePngLoader::ConvertImage()
         {
             SIMD_PERF_FUNC();
             SetConverter();
-            _image.Recreate(_width, _height, (Image::Format)_param.format);
+            if (!InitImage(_width, _height))
+                return false;
             _converter(_buffer.data, _width, _height, _width * _outN, _image.data, _image.stride);
+            return true;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        // Incremental decoding of a PNG: chunks are parsed as they arrive, IDAT payload is inflated as far as
+        // the received data allows and completed rows are unfiltered and converted when they are pulled.
+        // Interlaced images are accumulated and decoded as a whole when the IEND chunk has been received.
+        struct ImagePngLoader::Decoder
+        {
+            enum Stage
+            {
+                StageSignature,
+                StageChunks,
+                StageDone,
+                StageError,
+            } stage;
+            std::vector<uint8_t> data, zData;
+            size_t pos, idat, crc, outPos, rowSize, pulled;
+            uint32_t outN;
+            bool whole, end;
+            InputMemoryStream zIn;
+            OutputMemoryStream zOut;
+            Zlib::Inflater inflater;
+            Array8u prev, curr, row, pal;
+
+            Decoder()
+                : stage(StageSignature), pos(0), idat(0), crc(0), outPos(0), rowSize(0), pulled(0)
+                , outN(0), whole(false), end(false), inflater(true)
+            {
+            }
+
+            size_t Available() const
+            {
+                return rowSize ? (zOut.Size() - outPos) / rowSize : 0;
+            }
+        };
+
+        ImagePngLoader::~ImagePngLoader()
+        {
+            if (_decoder)
+                delete _decoder;
+        }
+
+        bool ImagePngLoader::Feed(const uint8_t* data, size_t size)
+        {
+            if (_decoder == NULL)
+            {
+                _decoder = new Decoder();
+                _first = true, _iPhone = false, _hasTrans = false, _paletteSize = 0;
+            }
+            Decoder& d = *_decoder;
+            if (d.stage == Decoder::StageError)
+                return false;
+            if (d.stage == Decoder::StageDone)
+                return true;
+            d.data.insert(d.data.end(), data, data + size);
+            _stream.Init(d.data.data(), d.data.size());
+            _stream.Seek(d.pos);
+            bool result = true;
+            if (d.stage == Decoder::StageSignature)
+            {
+                if (d.data.size() < 8)
+                    return true;
+                result = CheckHeader();
+                d.stage = Decoder::StageChunks;
+            }
+            while (result && !d.end)
+            {
+                if (d.idat)
+                {
+                    size_t n = Min(d.idat, _stream.Size() - _stream.Pos());
+                    d.zData.insert(d.zData.end(), _stream.Current(), _stream.Current() + n);
+                    _stream.Seek(_stream.Pos() + n);
+                    d.idat -= n;
+                    if (d.idat)
+                        break;
+                    d.crc = 4;
+                }
+                if (d.crc)
+                {
+                    size_t n = Min(d.crc, _stream.Size() - _stream.Pos());
+                    _stream.Seek(_stream.Pos() + n);
+                    d.crc -= n;
+                    if (d.crc)
+                        break;
+                }
+                size_t start = _stream.Pos();
+                Chunk chunk;
+                if (!(_stream.CanRead(8) && ReadChunk(chunk)))
+                    break;
+                if (chunk.type == ChunkType('I', 'D', 'A', 'T') && !d.whole)
+                {
+                    if (_first || (_paletteChannels && !_palette.size))
+                    {
+                        result = false;
+                        break;
+                    }
+                    if (_idats.empty())
+                    {
+                        SetOutputChannels();
+                        int bytes = _depth == 16 ? 2 : 1;
+                        size_t packed = (_channels * _width * _depth + 7) >> 3;
+                        size_t line = _width * _outN * bytes;
+                        d.rowSize = packed + 1;
+                        d.prev.Resize(_depth < 8 ? packed : line, true);
+                        d.curr.Resize(_depth < 8 ? packed : line);
+                        if (_depth != 8)
+                            d.row.Resize(line);
+                        d.outN = _outN;
+                        if (_paletteChannels)
+                        {
+                            d.outN = Simd::Max<uint32_t>(_paletteChannels, _outN);
+                            d.pal.Resize(_width * d.outN);
+                        }
+                        std::swap(_outN, d.outN);
+                        SetConverter();
+                        std::swap(_outN, d.outN);
+                        d.inflater = Zlib::Inflater(!_iPhone);
+                    }
+                    _idats.push_back(chunk);
+                    d.idat = chunk.size;
+                    d.crc = chunk.size ? 0 : 4;
+                    continue;
+                }
+                if (!_stream.CanRead(chunk.size + 4))
+                {
+                    _stream.Seek(start);
+                    break;
+                }
+                if (chunk.type == ChunkType('C', 'g', 'B', 'I'))
+                {
+                    _iPhone = true;
+                    _stream.Skip(chunk.size);
+                }
+                else if (chunk.type == ChunkType('I', 'H', 'D', 'R'))
+                {
+                    result = ReadHeader(chunk);
+                    d.whole = _interlace != 0;
+                }
+                else if (chunk.type == ChunkType('P', 'L', 'T', 'E'))
+                    result = ReadPalette(chunk);
+                else if (chunk.type == ChunkType('t', 'R', 'N', 'S'))
+                    result = ReadTransparency(chunk);
+                else if (chunk.type == ChunkType('I', 'D', 'A', 'T'))
+                    result = ReadData(chunk);
+                else if (chunk.type == ChunkType('I', 'E', 'N', 'D'))
+                {
+                    result = !_first && _idats.size();
+                    d.end = true;
+                }
+                else
+                {
+                    result = !(_first || (chunk.type & (1 << 29)) == 0);
+                    _stream.Skip(chunk.size);
+                }
+                _stream.Seek(chunk.offs + chunk.size + 4);
+            }
+            d.pos = _stream.Pos();
+            if (result && d.whole && d.end)
+            {
+                _idats.clear();
+                _stream.Init(d.data.data(), d.data.size());
+                result = FromStream();
+                std::vector<uint8_t>().swap(d.data);
+                d.stage = Decoder::StageDone;
+            }
+            else if (result && !d.whole)
+            {
+                if (d.pos > 0x10000 && d.pos * 2 > d.data.size())
+                {
+                    d.data.erase(d.data.begin(), d.data.begin() + d.pos);
+                    d.pos = 0;
+                }
+                if (_idats.size())
+                {
+                    d.zIn.Rebind(d.zData.data(), d.zData.size());
+                    result = Zlib::Inflate(d.inflater, d.zIn, d.zOut, d.end);
+                    if (d.zIn.Pos() > 0x10000 && d.zIn.Pos() * 2 > d.zData.size())
+                    {
+                        size_t consumed = d.zIn.Pos();
+                        d.zData.erase(d.zData.begin(), d.zData.begin() + consumed);
+                        d.zIn.Rebind(d.zData.data(), d.zData.size());
+                        d.zIn.Seek(0);
+                    }
+                }
+                if (result && d.end)
+                {
+                    if (d.inflater.state != Zlib::Inflater::StateFinished)
+                        result = CorruptPngError("unexpected end of data") != 0;
+                    else if (d.pulled + d.Available() < _height)
+                        result = CorruptPngError("not enough pixels") != 0;
+                    std::vector<uint8_t>().swap(d.data);
+                    std::vector<uint8_t>().swap(d.zData);
+                    d.stage = Decoder::StageDone;
+                }
+            }
+            if (!result)
+                d.stage = Decoder::StageError;
+            return result;
+        }
+
+        bool ImagePngLoader::Info(size_t* width, size_t* height, SimdPixelFormatType* format) const
+        {
+            if (_decoder == NULL || _decoder->stage == Decoder::StageError || _first)
+                return false;
+            *width = _width;
+            *height = _height;
+            *format = _param.format;
+            return true;
+        }
+
+        size_t ImagePngLoader::Pull(uint8_t* dst, size_t stride, size_t rows)
+        {
+            if (_decoder == NULL)
+                return 0;
+            Decoder& d = *_decoder;
+            if (d.whole)
+            {
+                rows = d.stage == Decoder::StageDone ? Min(rows, _height - d.pulled) : 0;
+                size_t size = _image.width * _image.PixelSize();
+                for (size_t r = 0; r < rows; ++r)
+                    memcpy(dst + r * stride, _image.Row<uint8_t>(d.pulled + r), size);
+                d.pulled += rows;
+                return rows;
+            }
+            rows = Min(rows, Min(d.Available(), _height - d.pulled));
+            int bytes = _depth == 16 ? 2 : 1;
+            for (size_t r = 0; r < rows; ++r, ++d.pulled, d.outPos += d.rowSize)
+            {
+                const uint8_t* src = d.zOut.Data() + d.outPos;
+                int filter = *src++;
+                if (filter > 4)
+                {
+                    CorruptPngError("invalid filter");
+                    d.stage = Decoder::StageError;
+                    return r;
+                }
+                if (d.pulled == 0)
+                    filter = FirstRowFilter[filter];
+                const uint8_t* row = d.curr.data;
+                if (_depth < 8)
+                {
+                    _decodeLine[filter](src, d.prev.data, int(d.rowSize - 1), 1, 1, d.curr.data);
+                    UnpackRow(d.curr.data, _width, d.row.data);
+                    row = d.row.data;
+                }
+                else
+                {
+                    int dstN = _channels == _outN ? _channels * bytes : _outN * bytes;
+                    _decodeLine[filter](src, d.prev.data, _width, _channels * bytes, dstN, d.curr.data);
+                    if (_depth == 16)
+                    {
+                        const uint8_t* cur = d.curr.data;
+                        uint16_t* cur16 = (uint16_t*)d.row.data;
+                        for (size_t i = 0, n = _width * _outN; i < n; ++i, cur16++, cur += 2)
+                            *cur16 = (cur[0] << 8) | cur[1];
+                        row = d.row.data;
+                    }
+                }
+                if (_hasTrans)
+                {
+                    if (_depth == 16)
+                        ComputeTransparency((uint16_t*)row, _width, _outN, _tc16);
+                    else
+                        ComputeTransparency((uint8_t*)row, _width, _outN, _tc);
+                }
+                if (_paletteChannels)
+                {
+                    _expandPalette(row, _width, d.outN, _palette.data, d.pal.data);
+                    row = d.pal.data;
+                }
+                _converter(row, _width, 1, _width * d.outN, dst + r * stride, stride);
+                d.prev.Swap(d.curr);
+            }
+            size_t window = 0x8000, discard = d.zOut.Size() > window ? Min(d.outPos, d.zOut.Size() - window) : 0;
+            if (discard > 0x10000)
+            {
+                d.zOut.Discard(discard);
+                d.outPos -= discard;
+            }
+            return rows;
         }
     }
 }
@@ -25,6 +25,7 @@
 #include "Simd/SimdImageSave.h"
 #include "Simd/SimdImageSaveJpeg.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -442,7 +443,7 @@ namespace Simd
                 _buffer.Resize(_width * _block * 3);
         }
 
-        void ImageJpegSaver::WriteHeader()
+        void ImageJpegSaver::WriteHeader(int restartInterval)
         {
             static const uint8_t DC_LUM_COD[] = { 0, 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
             static const uint8_t DC_LUM_VAL[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
@@ -488,85 +489,111 @@ namespace Simd
             _stream.Write8u(0x11); // HTUACinfo
             _stream.Write(AC_CHR_COD + 1, sizeof(AC_CHR_COD) - 1);
             _stream.Write(AC_CHR_VAL, sizeof(AC_CHR_VAL));
+            if (restartInterval)
+            {
+                const uint8_t dri[] = { 0xFF, 0xDD, 0, 4, uint8_t(restartInterval >> 8), uint8_t(restartInterval) };
+                _stream.Write(dri, sizeof(dri));
+            }
             _stream.Write(head2, sizeof(head2));
         }
 
+        // The image is split into horizontal stripes of MCU rows which are encoded in parallel into separate streams.
+        // Every stripe is a restart interval: it starts with zero DC predictions and is joined to the previous one with RSTn marker.
+        template<class Write> bool ImageJpegSaver::WriteImage(Write write)
+        {
+            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
+            int height = (int)_param.height, rows = (int)DivHi(_param.height, _block), mcus = (int)DivHi(_param.width, _block);
+            int threads = (int)Base::GetThreadNumber(), stripe = rows;
+            if (threads > 1 && rows > 1 && _param.width * _param.height >= JpegParallelAreaMin)
+                stripe = Simd::Max(Simd::Min((int)DivHi(rows, threads * 2), 0xFFFF / mcus), 1);
+            int stripes = (int)DivHi(rows, stripe);
+            WriteHeader(stripes > 1 ? stripe * mcus : 0);
+            if (stripes > 1)
+            {
+                std::vector<OutputMemoryStream> streams(stripes);
+                Simd::Parallel(0, stripes, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t s = begin; s < end; ++s)
+                    {
+                        int dc[3] = { 0, 0, 0 };
+                        for (int row = (int)s * stripe * _block, last = Simd::Min(row + stripe * _block, height); row < last; row += _block)
+                            write(streams[s], row, Simd::Min(row + _block, height) - row, thread, dc);
+                        Base::WriteBits(streams[s], FILL_BITS);
+                    }
+                }, threads, 1);
+                for (int s = 0; s < stripes; ++s)
+                {
+                    if (s)
+                    {
+                        _stream.Write8u(0xFF);
+                        _stream.Write8u(uint8_t(0xD0 + (s - 1) % 8));
+                    }
+                    _stream.Write(streams[s].Data(), streams[s].Size());
+                }
+            }
+            else
+            {
+                int dc[3] = { 0, 0, 0 };
+                for (int row = 0; row < height; row += _block)
+                    write(_stream, row, Simd::Min(row + _block, height) - row, 0, dc);
+                Base::WriteBits(_stream, FILL_BITS);
+            }
+            _stream.Write8u(0xFF);
+            _stream.Write8u(0xD9);
+            return true;
+        }
+
         bool ImageJpegSaver::ToStream(const uint8_t* src, size_t stride)
         {
             Init();
-            WriteHeader();
-            uint8_t* r = _buffer.data, * g = r + _width * _block,* b = g + _width * _block;
-            int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            size_t size = _width * _block;
+            if (_param.format != SimdPixelFormatGray8)
+                _buffer.Resize(size * 3 * Base::GetThreadNumber());
+            return WriteImage([&](OutputMemoryStream& stream, int row, int block, size_t thread, int dc[3])
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
+                const uint8_t* s = src + row * stride;
+                uint8_t* r = _buffer.data + thread * size * 3, * g = r + size, * b = g + size;
                 switch (_param.format)
                 {
                 case SimdPixelFormatBgr24:
-                    _deintBgr(src, stride, _param.width, block, b, _width, g, _width, r, _width);
+                    _deintBgr(s, stride, _param.width, block, b, _width, g, _width, r, _width);
                     break;
                 case SimdPixelFormatBgra32:
-                    _deintBgra(src, stride, _param.width, block, b, _width, g, _width, r, _width, NULL, 0);
+                    _deintBgra(s, stride, _param.width, block, b, _width, g, _width, r, _width, NULL, 0);
                     break;
                 case SimdPixelFormatRgb24:
-                    _deintBgr(src, stride, _param.width, block, r, _width, g, _width, b, _width);
+                    _deintBgr(s, stride, _param.width, block, r, _width, g, _width, b, _width);
                     break;
                 case SimdPixelFormatRgba32:
-                    _deintBgra(src, stride, _param.width, block, r, _width, g, _width, b, _width, NULL, 0);
+                    _deintBgra(s, stride, _param.width, block, r, _width, g, _width, b, _width, NULL, 0);
                     break;
-                default: 
+                default:
                     break;
                 }
-                if(_param.format == SimdPixelFormatGray8)
-                    _writeBlock(_stream, (int)_param.width, block, src, src, src, (int)stride, _fY, _fUv, dc);
+                if (_param.format == SimdPixelFormatGray8)
+                    _writeBlock(stream, (int)_param.width, block, s, s, s, (int)stride, _fY, _fUv, dc);
                 else
-                    _writeBlock(_stream, (int)_param.width, block, r, g, b, _width, _fY, _fUv, dc);
-                src += block * stride;
-            }
-            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
-            Base::WriteBits(_stream, FILL_BITS);
-            _stream.Write8u(0xFF);
-            _stream.Write8u(0xD9);
-            return true;
+                    _writeBlock(stream, (int)_param.width, block, r, g, b, _width, _fY, _fUv, dc);
+            });
         }
 
         bool ImageJpegSaver::ToStream(const uint8_t* y, size_t yStride, const uint8_t* uv, size_t uvStride)
         {
             Init();
-            WriteHeader();
-            int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            return WriteImage([&](OutputMemoryStream& stream, int row, int block, size_t thread, int dc[3])
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
-                _writeNv12Block(_stream, (int)_param.width, block, y, (int)yStride, uv, (int)uvStride, _fY, _fUv, dc);
-                y += block * yStride;
-                uv += (block / 2) * uvStride;
-            }
-            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
-            Base::WriteBits(_stream, FILL_BITS);
-            _stream.Write8u(0xFF);
-            _stream.Write8u(0xD9);
-            return true;
+                _writeNv12Block(stream, (int)_param.width, block, y + row * yStride, (int)yStride, uv + (row / 2) * uvStride, (int)uvStride, _fY, _fUv, dc);
+            });
         }
 
         bool ImageJpegSaver::ToStream(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride)
         {
             Init();
-            WriteHeader();
-            int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            return WriteImage([&](OutputMemoryStream& stream, int row, int block, size_t thread, int dc[3])
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
-                _writeYuv420pBlock(_stream, (int)_param.width, block, y, (int)yStride, u, (int)uStride, v, (int)vStride, _fY, _fUv, dc);
-                y += block * yStride;
-                u += (block / 2) * uStride;
-                v += (block / 2) * vStride;
-            }
-            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
-            Base::WriteBits(_stream, FILL_BITS);
-            _stream.Write8u(0xFF);
-            _stream.Write8u(0xD9);
-            return true;
+                _writeYuv420pBlock(stream, (int)_param.width, block, y + row * yStride, (int)yStride, 
+                    u + (row / 2) * uStride, (int)uStride, v + (row / 2) * vStride, (int)vStride, _fY, _fUv, dc);
+            });
         }
 
         //-----------------------------------------------------------------------------------------
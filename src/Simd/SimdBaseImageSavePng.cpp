@@ -26,6 +26,7 @@
 #include "Simd/SimdImageSavePng.h"
 #include "Simd/SimdBase.h"
 #include "Simd/SimdCpu.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -56,7 +57,7 @@ namespace Simd
 
 #endif
 
-        uint32_t ZlibAdler32(uint8_t* data, int size)
+        uint32_t ZlibAdler32(const uint8_t* data, int size)
         {
             uint32_t lo = 1, hi = 0;
             for (int b = 0, n = (int)(size % 5552); b < size;)
@@ -74,89 +75,9 @@ namespace Simd
             return (hi << 16) | lo;
         }
 
-        void ZlibCompress(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        void ZlibCompress(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
         {
-            const int ZHASH = 16384;
-            if (quality < 5)
-                quality = 5;
-            const int basket = quality * 2;
-            Array32i hashTable(ZHASH * basket);
-            memset(hashTable.data, -1, hashTable.RawSize());
-
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
-            stream.WriteBits(1, 2);
-
-            int i = 0, j;
-            while (i < size - 3)
-            {
-                int h = ZlibHash(data + i) & (ZHASH - 1), best = 3;
-                uint8_t* bestLoc = 0;
-                int* hList = hashTable.data + h * basket;
-                for (j = 0; hList[j] != -1 && j < basket; ++j)
-                {
-                    if (hList[j] > i - 32768)
-                    {
-                        int d = ZlibCount(data + hList[j], data + i, size - i);
-                        if (d >= best)
-                        {
-                            best = d;
-                            bestLoc = data + hList[j];
-                        }
-                    }
-                }
-                if (j == basket)
-                {
-                    memcpy(hList, hList + quality, quality * sizeof(int));
-                    memset(hList + quality, -1, quality * sizeof(int));
-                    j = quality;
-                }
-                hList[j] = i;
-
-                if (bestLoc)
-                {
-                    h = ZlibHash(data + i + 1) & (ZHASH - 1);
-                    int* hList = hashTable.data + h * basket;
-                    for (j = 0; hList[j] != -1 && j < basket; ++j)
-                    {
-                        if (hList[j] > i - 32767)
-                        {
-                            int e = ZlibCount(data + hList[j], data + i + 1, size - i - 1);
-                            if (e > best)
-                            {
-                                bestLoc = NULL;
-                                break;
-                            }
-                        }
-                    }
-                }
-
-                if (bestLoc)
-                {
-                    int d = (int)(data + i - bestLoc);
-                    assert(d <= 32767 && best <= 258);
-                    for (j = 0; best > Base::ZlibLenC[j + 1] - 1; ++j);
-                    Base::ZlibHuff(j + 257, stream);
-                    if (Base::ZlibLenEb[j])
-                        stream.WriteBits(best - Base::ZlibLenC[j], Base::ZlibLenEb[j]);
-                    for (j = 0; d > Base::ZlibDistC[j + 1] - 1; ++j);
-                    stream.WriteBits(Base::ZlibBitRev(j, 5), 5);
-                    if (Base::ZlibDistEb[j])
-                        stream.WriteBits(d - Base::ZlibDistC[j], Base::ZlibDistEb[j]);
-                    i += best;
-                }
-                else
-                {
-                    ZlibHuffB(data[i], stream);
-                    ++i;
-                }
-            }
-            for (; i < size; ++i)
-                ZlibHuffB(data[i], stream);
-            ZlibHuff(256, stream);
-            stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
+            Base::ZlibDeflate<Base::ZlibCount>(data, begin, end, quality, last, stream);
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -304,7 +225,6 @@ namespace Simd
                 _buff.Resize(_param.height * _size);
             }
             _filt.Resize((_size + 1) * _param.height);
-            _line.Resize(_size * FILTERS);
             _encode[0] = Base::EncodeLine0;
             _encode[1] = Base::EncodeLine1;
             _encode[2] = Base::EncodeLine2;
@@ -313,6 +233,7 @@ namespace Simd
             _encode[5] = Base::EncodeLine5;
             _encode[6] = Base::EncodeLine6;
             _compress = Base::ZlibCompress;
+            _adler32 = Base::ZlibAdler32;
         }
 
         bool ImagePngSaver::ToStream(const uint8_t* src, size_t stride)
@@ -323,25 +244,64 @@ namespace Simd
                 src = _buff.data;
                 stride = _size;
             }
-            for (size_t row = 0; row < _param.height; ++row)
+            size_t height = _param.height, threads = Base::GetThreadNumber(), groups = 1;
+            if (threads > 1 && height > 1 && _param.width * height >= PngParallelAreaMin)
+                groups = Simd::Min(threads, height);
+            _line.Resize(_size * FILTERS * groups);
+            Simd::Parallel(0, height, [&](size_t thread, size_t begin, size_t end)
             {
-                int bestFilter = 0, bestSum = INT_MAX;
-                for (int filter = 0; filter < FILTERS; filter++)
+                int8_t* line = _line.data + _size * FILTERS * thread;
+                for (size_t row = begin; row < end; ++row)
                 {
-                    static const int TYPES[] = { 0, 1, 0, 5, 6, 0, 1, 2, 3, 4 };
-                    int type = TYPES[filter + (row ? 1 : 0) * FILTERS];
-                    int sum = _encode[type](src + stride * row, stride, _channels, _size, _line.data + _size * filter);
-                    if (sum < bestSum)
+                    int bestFilter = 0, bestSum = INT_MAX;
+                    for (int filter = 0; filter < FILTERS; filter++)
                     {
-                        bestSum = sum;
-                        bestFilter = filter;
+                        static const int TYPES[] = { 0, 1, 0, 5, 6, 0, 1, 2, 3, 4 };
+                        int type = TYPES[filter + (row ? 1 : 0) * FILTERS];
+                        int sum = _encode[type](src + stride * row, stride, _channels, _size, line + _size * filter);
+                        if (sum < bestSum)
+                        {
+                            bestSum = sum;
+                            bestFilter = filter;
+                        }
                     }
+                    _filt[row * (_size + 1)] = (uint8_t)bestFilter;
+                    memcpy(_filt.data + row * (_size + 1) + 1, line + _size * bestFilter, _size);
                 }
-                _filt[row * (_size + 1)] = (uint8_t)bestFilter;
-                memcpy(_filt.data + row * (_size + 1) + 1, _line.data + _size * bestFilter, _size);
-            }
+            }, groups, 1);
+
+            int level = _param.quality > 0 ? Simd::RestrictRange(_param.quality * COMPRESSION / 100, 1, COMPRESSION) : COMPRESSION;
             OutputMemoryStream zlib(Simd::Min(_param.width * _param.height, Base::AlgCacheL1()));
-            _compress(_filt.data, (int)_filt.size, COMPRESSION, zlib);
+            zlib.Write8u(0x78);
+            zlib.Write8u(0x5e);
+            if (groups > 1)
+            {
+                size_t rows = DivHi(height, groups), line = _size + 1;
+                groups = DivHi(height, rows);
+                std::vector<OutputMemoryStream> streams(groups);
+                std::vector<uint32_t> adlers(groups);
+                Simd::Parallel(0, groups, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t g = begin; g < end; ++g)
+                    {
+                        int first = int(g * rows * line), last = int(Simd::Min((g + 1) * rows, height) * line);
+                        _compress(_filt.data, first, last, level, g == groups - 1, streams[g]);
+                        adlers[g] = _adler32(_filt.data + first, last - first);
+                    }
+                }, groups, 1);
+                uint32_t adler = 1;
+                for (size_t g = 0; g < groups; ++g)
+                {
+                    zlib.Write(streams[g].Data(), streams[g].Size());
+                    adler = ZlibAdler32Combine(adler, adlers[g], Simd::Min(rows, height - g * rows) * line);
+                }
+                zlib.WriteBe32u(adler);
+            }
+            else
+            {
+                _compress(_filt.data, 0, (int)_filt.size, level, true, zlib);
+                zlib.WriteBe32u(_adler32(_filt.data, (int)_filt.size));
+            }
             WriteToStream(zlib.Data(), zlib.Size());
             return true;
         }
@@ -23,6 +23,8 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdResizer.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdBase.h"
 
 namespace Simd
 {
@@ -48,6 +50,40 @@ namespace Simd
             else
                 return NULL;
         }
+
+        //---------------------------------------------------------------------------------------------
+
+        ResizerParallel::ResizerParallel(const ResParam& param, Resizer* first, ResizerInitPtr init, size_t threads)
+            : Resizer(param)
+            , _resizers(threads, first)
+        {
+            for (size_t t = 1; t < threads; ++t)
+                _resizers[t] = (Resizer*)init(param.srcW, param.srcH, param.dstW, param.dstH, param.channels, param.type, param.method);
+        }
+
+        ResizerParallel::~ResizerParallel()
+        {
+            for (size_t t = 0; t < _resizers.size(); ++t)
+                delete _resizers[t];
+        }
+
+        void ResizerParallel::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            Simd::Parallel(0, _param.dstH, [&](size_t thread, size_t begin, size_t end)
+            {
+                _resizers[thread]->Run(src, srcStride, dst, dstStride, begin, end);
+            }, _resizers.size(), 8);
+        }
+
+        void* ResizerParallelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method, ResizerInitPtr init)
+        {
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(void*));
+            size_t threads = Simd::Min<size_t>(GetThreadNumber(), dstY / 16);
+            Resizer* first = (Resizer*)init(srcX, srcY, dstX, dstY, channels, type, method);
+            if (first == NULL || threads <= 1 || dstX * dstY * param.PixelSize() < 128 * 128)
+                return first;
+            return new ResizerParallel(param, first, init, threads);
+        }
     }
 }
 
@@ -0,0 +1,104 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2022 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdRuntime.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdBase.h"
+
+#include <fstream>
+
+namespace Simd
+{
+    RuntimeCache& RuntimeCache::Global()
+    {
+        static RuntimeCache global;
+        return global;
+    }
+
+    bool RuntimeCache::Load(const String& path)
+    {
+        std::ifstream ifs(path.c_str());
+        if (!ifs.is_open())
+            return false;
+        Entries entries;
+        String line;
+        while (std::getline(ifs, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                continue;
+            size_t pos = line.rfind('\t');
+            if (std::count(line.begin(), line.end(), '\t') != 3)
+                return false;
+            entries[line.substr(0, pos)] = line.substr(pos + 1);
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (Entries::const_iterator it = entries.begin(); it != entries.end(); ++it)
+            _entries[it->first] = it->second;
+        return true;
+    }
+
+    bool RuntimeCache::Save(const String& path) const
+    {
+        std::ofstream ofs(path.c_str());
+        if (!ofs.is_open())
+            return false;
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (Entries::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+            ofs << it->first << "\t" << it->second << std::endl;
+        return (bool)ofs;
+    }
+
+    bool RuntimeCache::Find(const String& runtime, const String& info, String& name) const
+    {
+        String key = CpuId() + "\t" + runtime + "\t" + info;
+        std::lock_guard<std::mutex> lock(_mutex);
+        Entries::const_iterator it = _entries.find(key);
+        if (it == _entries.end())
+            return false;
+        name = it->second;
+        return true;
+    }
+
+    void RuntimeCache::Update(const String& runtime, const String& info, const String& name)
+    {
+        String key = CpuId() + "\t" + runtime + "\t" + info;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries[key] = name;
+    }
+
+    void RuntimeCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+    }
+
+    String RuntimeCache::CpuId()
+    {
+        std::stringstream ss;
+        ss << Cpu::CPU_MODEL << " [" << Cpu::CORE_NUMBER << "C-" << Cpu::L2_CACHE_SIZE / 1024 << "K-" << Cpu::L3_CACHE_SIZE / 1024;
+        ss << "K] T" << Base::GetThreadNumber();
+        return ss.str();
+    }
+}
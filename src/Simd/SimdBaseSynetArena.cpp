@@ -0,0 +1,122 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetConvolution32f.h"
+#include "Simd/SimdSynetDeconvolution32f.h"
+#include "Simd/SimdSynetMergedConvolution32f.h"
+#include "Simd/SimdSynetMergedConvolution8i.h"
+#include "Simd/SimdBase.h"
+
+#include <algorithm>
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace Base
+    {
+        static size_t ExternalBufferSize(SimdSynetContextType type, const void* context)
+        {
+            if (context == NULL)
+                return 0;
+            switch (type)
+            {
+            case SimdSynetContextConvolution32f: return ((SynetConvolution32f*)context)->ExternalBufferSize() * sizeof(float);
+            case SimdSynetContextConvolution8i: return ((SynetConvolution8i*)context)->ExternalBufferSize();
+            case SimdSynetContextDeconvolution32f: return ((SynetDeconvolution32f*)context)->ExternalBufferSize() * sizeof(float);
+            case SimdSynetContextMergedConvolution32f: return ((SynetMergedConvolution32f*)context)->ExternalBufferSize() * sizeof(float);
+            case SimdSynetContextMergedConvolution8i: return ((SynetMergedConvolution8i*)context)->ExternalBufferSize();
+            default: return 0;
+            }
+        }
+
+        struct ArenaItem
+        {
+            size_t size, first, last, offset, index;
+        };
+
+        SIMD_INLINE bool Overlapped(const ArenaItem& a, const ArenaItem& b)
+        {
+            return a.first <= b.last && b.first <= a.last;
+        }
+
+        size_t SynetArenaPlan(SimdSynetArenaLayer* layers, size_t layerCount, SimdSynetArenaTensor* tensors, size_t tensorCount)
+        {
+            std::vector<ArenaItem> items;
+            items.reserve(layerCount + tensorCount);
+            for (size_t i = 0; i < layerCount; ++i)
+            {
+                layers[i].size = ExternalBufferSize(layers[i].type, layers[i].context);
+                layers[i].offset = 0;
+                ArenaItem item = { AlignHi(layers[i].size, SIMD_ALIGN), i, i, 0, i };
+                if (item.size)
+                    items.push_back(item);
+            }
+            for (size_t i = 0; i < tensorCount; ++i)
+            {
+                tensors[i].offset = 0;
+                ArenaItem item = { AlignHi(tensors[i].size, SIMD_ALIGN), tensors[i].first, Simd::Max(tensors[i].first, tensors[i].last), 0, layerCount + i };
+                if (item.size)
+                    items.push_back(item);
+            }
+
+            std::stable_sort(items.begin(), items.end(), [](const ArenaItem& a, const ArenaItem& b) { return a.size > b.size; });
+
+            size_t total = 0;
+            std::vector<const ArenaItem*> placed;
+            placed.reserve(items.size());
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                ArenaItem& item = items[i];
+                std::vector<const ArenaItem*> live;
+                for (size_t j = 0; j < placed.size(); ++j)
+                    if (Overlapped(*placed[j], item))
+                        live.push_back(placed[j]);
+                std::sort(live.begin(), live.end(), [](const ArenaItem* a, const ArenaItem* b) { return a->offset < b->offset; });
+                size_t offset = 0, best = size_t(-1), bestGap = size_t(-1);
+                for (size_t j = 0; j < live.size(); ++j)
+                {
+                    if (live[j]->offset >= offset + item.size && live[j]->offset - offset < bestGap)
+                    {
+                        best = offset;
+                        bestGap = live[j]->offset - offset;
+                    }
+                    offset = Simd::Max(offset, live[j]->offset + live[j]->size);
+                }
+                item.offset = best == size_t(-1) ? offset : best;
+                total = Simd::Max(total, item.offset + item.size);
+                placed.push_back(&item);
+            }
+
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                if (items[i].index < layerCount)
+                    layers[items[i].index].offset = items[i].offset;
+                else
+                    tensors[items[i].index - layerCount].offset = items[i].offset;
+            }
+            return total;
+        }
+    }
+#endif
+}
@@ -0,0 +1,209 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetAttention32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdBFloat16.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdBase.h"
+
+#include <float.h>
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace Base
+    {
+        static void AttentionMul(size_t M, size_t N, size_t K, const float* A, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, int update)
+        {
+            for (size_t i = 0; i < M; ++i)
+            {
+                float* c = C + i * ldc;
+                if (!update)
+                    memset(c, 0, N * sizeof(float));
+                for (size_t k = 0; k < K; ++k)
+                {
+                    float a = A[i * strideM + k * strideK];
+                    const float* b = B + k * ldb;
+                    for (size_t j = 0; j < N; ++j)
+                        c[j] += a * b[j];
+                }
+            }
+        }
+
+        static void AttentionSoftmax(float* src, size_t stride, size_t rows, size_t cols, ptrdiff_t first, float scale, float* max, float* sum, float* corr)
+        {
+            for (size_t i = 0; i < cols; ++i)
+                corr[i] = max[i];
+            for (size_t j = 0; j < rows; ++j)
+            {
+                float* s = src + j * stride;
+                ptrdiff_t beg = first + j;
+                for (size_t i = 0; i < cols; ++i)
+                {
+                    s[i] *= scale;
+                    if ((ptrdiff_t)i >= beg)
+                        corr[i] = Simd::Max(corr[i], s[i]);
+                }
+            }
+            for (size_t i = 0; i < cols; ++i)
+            {
+                float m = corr[i];
+                corr[i] = ::exp(max[i] - m);
+                sum[i] *= corr[i];
+                max[i] = m;
+            }
+            for (size_t j = 0; j < rows; ++j)
+            {
+                float* s = src + j * stride;
+                ptrdiff_t beg = first + j;
+                for (size_t i = 0; i < cols; ++i)
+                {
+                    s[i] = (ptrdiff_t)i >= beg ? ::exp(s[i] - max[i]) : 0.0f;
+                    sum[i] += s[i];
+                }
+            }
+        }
+
+        static void AttentionScale(const float* src, size_t size, float scale, float* dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = src[i] * scale;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetAttention32f::SynetAttention32f(const AttentionParam32f& p)
+            : _param(p)
+        {
+            _bf16 = Bf16Soft(p.compatibility);
+            _depthA = AlignHi(p.depth, Align);
+            _blockQ = Simd::Min<size_t>(p.lenQ, 64);
+            _blockQA = AlignHi(_blockQ, Align);
+            size_t blockKV = AlignLoAny(Base::AlgCacheL2() / 2 / sizeof(float) / (p.depth + _depthA + _blockQA), Align);
+            _blockKV = Simd::RestrictRange<size_t>(blockKV, Align, 512);
+            _blockKV = Simd::Min(_blockKV, AlignHi(p.lenKV, Align));
+            _threadSize = p.depth * _blockQA + _blockKV * p.depth + _blockKV * _depthA + _blockKV * _blockQA + _blockQ * _depthA + _blockQA * 3;
+            _buffer.Resize(_threadSize * Base::GetThreadNumber());
+            _mul = AttentionMul;
+            _softmax = AttentionSoftmax;
+            _scale = AttentionScale;
+            _round = Base::RoundToBFloat16;
+        }
+
+        String SynetAttention32f::Desc() const
+        {
+            return Ext() + (_param.causal ? "::Causal" : "::Full") + (_bf16 ? "-bf16" : "");
+        }
+
+        void SynetAttention32f::Forward(const float* q, const float* k, const float* v, float* dst)
+        {
+            const AttentionParam32f& p = _param;
+            size_t tilesQ = DivHi(p.lenQ, _blockQ), tasks = p.batch * p.heads * tilesQ;
+            size_t threads = Base::GetThreadNumber();
+            if (_buffer.size < _threadSize * threads)
+                _buffer.Resize(_threadSize * threads);
+            size_t sizeQ = p.lenQ * p.depth, sizeKV = p.lenKV * p.depth;
+            Simd::Parallel(0, tasks, [&](size_t thread, size_t begin, size_t end)
+            {
+                float* buf = _buffer.data + thread * _threadSize;
+                for (size_t t = begin; t < end; ++t)
+                {
+                    size_t bh = t / tilesQ, q0 = (t % tilesQ) * _blockQ, qN = Simd::Min(_blockQ, p.lenQ - q0);
+                    ForwardTile(q + bh * sizeQ, k + bh * sizeKV, v + bh * sizeKV, q0, qN, buf, dst + bh * sizeQ);
+                }
+            }, threads);
+        }
+
+        void SynetAttention32f::ForwardTile(const float* q, const float* k, const float* v, size_t q0, size_t qN, float* buf, float* dst)
+        {
+            const AttentionParam32f& p = _param;
+            size_t D = p.depth, DA = _depthA, QA = _blockQA, BKV = _blockKV;
+            float* qt = buf, * kb = qt + D * QA, * vb = kb + BKV * D, * s = vb + BKV * DA;
+            float* o = s + BKV * QA, * max = o + _blockQ * DA, * sum = max + QA, * corr = sum + QA;
+            const float* qa = q + q0 * D;
+            for (size_t d = 0; d < D; ++d)
+            {
+                float* row = qt + d * QA;
+                for (size_t i = 0; i < qN; ++i)
+                    row[i] = qa[i * D + d];
+                for (size_t i = qN; i < QA; ++i)
+                    row[i] = 0.0f;
+            }
+            if (_bf16)
+                _round(qt, D * QA, qt);
+            memset(o, 0, qN * DA * sizeof(float));
+            for (size_t i = 0; i < QA; ++i)
+                max[i] = -FLT_MAX, sum[i] = 0.0f;
+            ptrdiff_t offset = p.causal ? p.lenKV - p.lenQ : p.lenKV;
+            size_t kvEnd = p.causal ? Simd::Min(p.lenKV, q0 + qN + offset) : p.lenKV;
+            bool directV = !_bf16 && D == DA;
+            for (size_t kv0 = 0; kv0 < kvEnd; kv0 += BKV)
+            {
+                size_t n = Simd::Min(BKV, kvEnd - kv0);
+                const float* ka = k + kv0 * D;
+                if (_bf16)
+                {
+                    _round(ka, n * D, kb);
+                    ka = kb;
+                }
+                const float* va = v + kv0 * D;
+                if (!directV)
+                {
+                    for (size_t j = 0; j < n; ++j)
+                    {
+                        memcpy(vb + j * DA, va + j * D, D * sizeof(float));
+                        memset(vb + j * DA + D, 0, (DA - D) * sizeof(float));
+                    }
+                    if (_bf16)
+                        _round(vb, n * DA, vb);
+                    va = vb;
+                }
+                _mul(n, QA, D, ka, D, 1, qt, QA, s, QA, 0);
+                _softmax(s, QA, n, QA, ptrdiff_t(kv0) - ptrdiff_t(q0) - offset, p.scale, max, sum, corr);
+                if (_bf16)
+                    _round(s, n * QA, s);
+                for (size_t i = 0; i < qN; ++i)
+                {
+                    if (corr[i] != 1.0f)
+                        _scale(o + i * DA, D, corr[i], o + i * DA);
+                }
+                _mul(qN, DA, n, s, 1, QA, va, DA, o, DA, 1);
+            }
+            for (size_t i = 0; i < qN; ++i)
+                _scale(o + i * DA, D, sum[i] > 0.0f ? 1.0f / sum[i] : 0.0f, dst + (q0 + i) * D);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility)
+        {
+            AttentionParam32f param(batch, heads, lenQ, lenKV, depth, scale, causal, compatibility);
+            if (!param.Valid())
+                return NULL;
+            return new SynetAttention32f(param);
+        }
+    }
+#endif
+}
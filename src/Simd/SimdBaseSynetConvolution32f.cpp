@@ -26,6 +26,7 @@
 #include "Simd/SimdSynet.h"
 #include "Simd/SimdBase.h"
 #include "Simd/SimdCpu.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -40,6 +41,41 @@ namespace Simd
     }
 #endif
 
+    SynetPackedWeight SynetConvolution32f::Export()
+    {
+        if (!_packed.Empty())
+            return _packed;
+        SynetPackedWeight::Visitor collect(SynetPackedWeight::Visitor::Collect);
+        Pack(collect);
+        return SynetPackedWeight(SynetPackedWeight::Key(Desc(), _param, _param.batch, _param.compatibility), collect);
+    }
+
+    bool SynetConvolution32f::SetPackedParams(const SynetPackedWeight& packed, const float* weight, const float* bias, const float* params)
+    {
+        if (packed.Empty() || packed.Key() != SynetPackedWeight::Key(Desc(), _param, _param.batch, _param.compatibility))
+            return false;
+        SynetPackedWeight::Visitor check(SynetPackedWeight::Visitor::Check, &packed);
+        Pack(check);
+        if (!check.Ok())
+            return false;
+        SynetPackedWeight::Visitor bind(SynetPackedWeight::Visitor::Bind, &packed);
+        Pack(bind);
+        _packed = packed;
+        SetParams(weight, NULL, bias, params);
+        return true;
+    }
+
+    bool SynetConvolution32f::Reshape(size_t batch, size_t srcH, size_t srcW)
+    {
+        ConvParam32f param = _param;
+        if (!param.Reshape(batch, srcH, srcW) || !SetShape(param))
+            return false;
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        _perf = NULL;
+#endif
+        return true;
+    }
+
     namespace Base
     {
         void ConvolutionBiasAndActivation(const float * bias, size_t count, size_t size, ::SimdConvolutionActivationType activation, const float * params, SimdBool trans, float * dst)
@@ -370,7 +406,7 @@ namespace Simd
                     if (_batch%merge == 0 && _M*merge*_K*sizeof(float) <= Base::AlgCacheL2())
                         _merge = merge;
             }
-            _gemm.Init(InitGemmFuncs(Base::Gemm32fNN, "Base"));
+            _gemm.Init(InitGemmFuncs(Base::Gemm32fNN, "Base"), "Gemm32fNN");
             _biasAndActivation = Base::ConvolutionBiasAndActivation;
         }
 
@@ -387,10 +423,13 @@ namespace Simd
             Simd::SynetConvolution32f::SetParams(weight, internal, bias, params);
             if (_nhwcWeight.data)
             {
-                if (_gemmCb.Size())
-                    _gemmCb.At(0).ReorderB(_M*_merge, _N, _K, weight, _nhwcWeight.data);
-                else
-                    _nhwcReorderB(_M*_merge, _N, _K, weight, _nhwcWeight.data, GemmKernelAny, NHWC_GEMM_COMPATIBLE);
+                if (_packed.Empty())
+                {
+                    if (_gemmCb.Size())
+                        _gemmCb.At(0).ReorderB(_M*_merge, _N, _K, weight, _nhwcWeight.data);
+                    else
+                        _nhwcReorderB(_M*_merge, _N, _K, weight, _nhwcWeight.data, GemmKernelAny, NHWC_GEMM_COMPATIBLE);
+                }
                 if (internal)
                     *internal = SimdTrue;
             }
@@ -615,7 +654,7 @@ namespace Simd
             _sizeS = p.srcC*p.srcH*p.srcW;
             _sizeB = p.srcC*p.kernelY*p.kernelX*p.dstH*p.dstW;
             _sizeD = p.dstC*p.dstH*p.dstW;
-            _gemm.Init(InitGemmFuncs(Base::Gemm32fNT, "Base"));
+            _gemm.Init(InitGemmFuncs(Base::Gemm32fNT, "Base"), "Gemm32fNT");
             _biasAndActivation = Base::ConvolutionBiasAndActivation;
         }
 
@@ -809,7 +848,7 @@ namespace Simd
             }
             else
                 assert(0);
-            _gemm.Init(InitGemmFuncs(Base::Gemm32fNN, "Base"));
+            _gemm.Init(InitGemmFuncs(Base::Gemm32fNN, "Base"), "Gemm32fNN");
             _biasAndActivation = Base::ConvolutionBiasAndActivation;
         }
 
@@ -833,22 +872,31 @@ namespace Simd
         void SynetConvolution32fWinograd::SetParams(const float * weight, SimdBool * internal, const float * bias, const float * params)
         {
             Simd::SynetConvolution32f::SetParams(weight, internal, bias, params);
-            _winogradWeight.Resize(_strideW*_count);
-            _setFilter(weight, _param.srcC*_param.dstC, _winogradWeight.data, _param.trans);
-            if (_nhwcWeight.data)
+            if (_packed.Empty())
             {
-                for (size_t i = 0; i < _count; ++i)
+                _winogradWeight.Resize(_strideW*_count);
+                _setFilter(weight, _param.srcC*_param.dstC, _winogradWeight.data, _param.trans);
+                if (_nhwcWeight.data)
                 {
-                    if (_gemmCb.Size())
-                        _gemmCb.At(0).ReorderB(_M * _merge, _N, _K, _winogradWeight.data + i * _strideW, _nhwcWeight.data + i * _nhwcStrideW);
-                    else
-                        _nhwcReorderB(_M * _merge, _N, _K, _winogradWeight.data + i * _strideW, _nhwcWeight.data + i * _nhwcStrideW, GemmKernelAny, NHWC_GEMM_COMPATIBLE);
+                    for (size_t i = 0; i < _count; ++i)
+                    {
+                        if (_gemmCb.Size())
+                            _gemmCb.At(0).ReorderB(_M * _merge, _N, _K, _winogradWeight.data + i * _strideW, _nhwcWeight.data + i * _nhwcStrideW);
+                        else
+                            _nhwcReorderB(_M * _merge, _N, _K, _winogradWeight.data + i * _strideW, _nhwcWeight.data + i * _nhwcStrideW, GemmKernelAny, NHWC_GEMM_COMPATIBLE);
+                    }
+                    _winogradWeight.Resize(0);
                 }
-                _winogradWeight.Resize(0);
             }
             if (internal)
                 *internal = SimdTrue;
         }
+
+        void SynetConvolution32fWinograd::Pack(SynetPackedWeight::Visitor& visitor)
+        {
+            Simd::SynetConvolution32f::Pack(visitor);
+            visitor(_winogradWeight);
+        }
         
         void SynetConvolution32fWinograd::Forward(const float * src, float * buf, float * dst)
         {
@@ -1054,6 +1102,17 @@ namespace Simd
                 return 1;
         }
 
+        bool SynetConvolution32fDirectNchw::SetShape(const ConvParam32f & p)
+        {
+            _param = p;
+            _srcH = p.padY + p.srcH + p.padH;
+            _srcW = p.padX + p.srcW + p.padW;
+            _grS = _srcC * p.srcH * p.srcW;
+            _grD = _dstC * p.dstH * p.dstW;
+            _convolutionBiasActivation = SetConvolutionBiasActivation();
+            return true;
+        }
+
         void SynetConvolution32fDirectNchw::Forward(const float * src, float * buf, float * dst)
         {
             const ConvParam32f & p = _param;
@@ -1285,6 +1344,16 @@ namespace Simd
             _convolutionBiasActivation = SetConvolutionBiasActivation();
         }
 
+        bool SynetConvolution32fDirectNhwc::SetShape(const ConvParam32f & p)
+        {
+            _param = p;
+            _batch = p.batch;
+            _sizeS = p.srcC * p.srcH * p.srcW;
+            _sizeD = p.dstC * p.dstH * p.dstW;
+            _convolutionBiasActivation = SetConvolutionBiasActivation();
+            return true;
+        }
+
         void SynetConvolution32fDirectNhwc::Forward(const float * src, float * buf, float * dst)
         {
             for (size_t b = 0; b < _batch; ++b)
@@ -1425,6 +1494,7 @@ namespace Simd
         {
             _sizeS = p.srcC*p.srcH*p.srcW;
             _sizeD = p.dstC*p.dstH*p.dstW;
+            _threads = SynetThreadNumber(p.Flop() / p.batch);
 #if defined(SIMD_RUNTIME_DISABLE)
             _old.enable = true;
 #else
@@ -1438,21 +1508,42 @@ namespace Simd
                     _old.enable = true;
             }
             _old.convolution = NULL;
+            _sparse.weight.K = p.kernelY * p.kernelX * p.srcC;
+            _sparse.weight.N = p.dstC;
+            _sparse.gemm = Base::SynetSparse32fGemm;
+            _sparse.macroM = 0;
+            _sparse.sizeB = 0;
+            _biasAndActivation = Base::ConvolutionBiasAndActivation;
+        }
+
+        size_t SynetConvolution32fNhwcDirect::ExternalBufferSize() const
+        {
+            return _sparse.weight.Enable() && _sparse.sizeB ? _sparse.sizeB : 1;
         }
 
         size_t SynetConvolution32fNhwcDirect::InternalBufferSize() const
         {
             size_t size = _buffer.size + _rWeight.size + _rBias.size + _rParams.size;
             size += _old.weight.size;
+            size += _sparse.weight.Size();
             return size;
         }
 
         void SynetConvolution32fNhwcDirect::SetParams(const float * weight, SimdBool * internal, const float * bias, const float * params)
         {
             SynetConvolution32f::SetParams(weight, internal, bias, params);
+            bool packed = !_packed.Empty();
+            if (!packed && !_old.enable && _sparse.gemm)
+            {
+                if (_sparse.weight.Init(weight, SimdFalse))
+                    _rWeight.Resize(0);
+                else if (_run.Size())
+                    _rWeight.Resize(DivHi(_param.dstC, _run.At(0).alg.F) * _run.At(0).alg.stepW);
+            }
             if (_old.enable && _old.weight.data)
             {
-                OldReorderWeight(weight, _old.weight.data);
+                if (!packed)
+                    OldReorderWeight(weight, _old.weight.data);
                 _weight = _old.weight.data;
                 if (internal)
                     *internal = SimdTrue;
@@ -1460,18 +1551,27 @@ namespace Simd
             else
             if (_rWeight.data)
             {
-                ReorderWeight(weight, _rWeight.data);
+                if (!packed)
+                    ReorderWeight(weight, _rWeight.data);
                 _weight = _rWeight.data;
                 if (internal)
                     *internal = SimdTrue;
             }
+            if (_sparse.weight.Enable())
+            {
+                SparseSetAlgParam();
+                if (internal)
+                    *internal = SimdTrue;
+            }
             if (_rBias.data)
             {
-                if (bias)
+                if (bias && !packed)
                     memcpy(_rBias.data, bias, _param.dstC * sizeof(float));
                 _bias = _rBias.data;
             }
-            if (_rParams.data)
+            if (_rParams.data && packed)
+                _params = _rParams.data;
+            else if (_rParams.data)
             {
                 const ConvParam32f& p = _param;
                 switch (p.activation)
@@ -1522,42 +1622,104 @@ namespace Simd
             }
         }
 
+        void SynetConvolution32fNhwcDirect::Pack(SynetPackedWeight::Visitor& visitor)
+        {
+            visitor(_rWeight);
+            visitor(_rBias);
+            visitor(_rParams);
+            visitor(_old.weight);
+            _sparse.weight.Pack(visitor);
+        }
+
+        static void SetMacroH(const ConvParam32f& p, SynetConvolution32fNhwcDirect::AlgParam& a)
+        {
+            for (size_t macroH = p.dstH; macroH >= 1; macroH--)
+            {
+                a.macroH = macroH;
+                if (a.macroC * p.srcW * (a.macroH * p.strideY + p.kernelY * p.dilationY - 1) * sizeof(float) <= Base::AlgCacheL2())
+                    break;
+            }
+        }
+
+        bool SynetConvolution32fNhwcDirect::SetShape(const ConvParam32f& p)
+        {
+            if ((!p.Is1x1() && p.dstW < 6 + p.padX + p.padW) || p.kernelY > p.srcH || p.kernelX > p.srcW)
+                return false;
+            _param = p;
+            _sizeS = p.srcC * p.srcH * p.srcW;
+            _sizeD = p.dstC * p.dstH * p.dstW;
+            _threads = SynetThreadNumber(p.Flop() / p.batch);
+            if (_sparse.weight.Enable())
+                SparseSetAlgParam();
+            if (_old.enable)
+                SetMacroH(p, _old.alg);
+            else if (_run.Size())
+            {
+                RunFuncs funcs;
+                for (size_t i = 0; i < _run.Size(); ++i)
+                {
+                    funcs.push_back(_run.At(i));
+                    SetMacroH(p, funcs.back().alg);
+                }
+                _run.Init(funcs, "NhwcDirect");
+            }
+            return true;
+        }
+
         void SynetConvolution32fNhwcDirect::Forward(const float * src, float * buf, float * dst)
         {
             const ConvParam32f & p = _param;
-            for (size_t b = 0; b < p.batch; ++b)
+            if (_sparse.weight.Enable())
+                SparseForward(src, _sparse.sizeB ? Buffer(buf) : NULL, dst);
+            else if (_old.enable)
             {
-                if(_old.enable)
-                    _old.convolution(src, _param, _old.alg, _weight, _bias, _params, dst);
-                else
-                _run.Run(RunArgs(src, _param, _weight, _bias, _params, dst));
-                src += _sizeS;
-                dst += _sizeD;
+                Simd::Parallel(0, p.batch, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t b = begin; b < end; ++b)
+                        _old.convolution(src + b * _sizeS, _param, _old.alg, _weight, _bias, _params, dst + b * _sizeD);
+                }, _threads);
+            }
+            else
+            {
+                for (size_t b = 0; b < p.batch; ++b)
+                {
+                    _run.Run(RunArgs(src, _param, _weight, _bias, _params, dst, _threads));
+                    src += _sizeS;
+                    dst += _sizeD;
+                }
             }
         }
 
-        void SynetConvolution32fNhwcDirect::Forward(const float* src, const ConvParam32f& p, const AlgParam& a, const float* weight, const float* bias, const float* params, float* dst)
+        void SynetConvolution32fNhwcDirect::Forward(const float* src, const ConvParam32f& p, const AlgParam& a, const float* weight, const float* bias, const float* params, float* dst, size_t threads)
         {
-            for (size_t dc = 0; dc < p.dstC; dc += a.macroD)
+            Simd::Parallel2d(p.dstH, p.dstC, a.microD, [&](size_t thread, size_t yBeg, size_t yEnd, size_t dcBeg, size_t dcEnd)
             {
-                size_t macroD = Simd::Min(p.dstC, dc + a.macroD) - dc;
+                Forward(src, p, a, dcBeg, dcEnd, yBeg, yEnd, weight, bias, params, dst);
+            }, threads);
+        }
+
+        void SynetConvolution32fNhwcDirect::Forward(const float* src, const ConvParam32f& p, const AlgParam& a, size_t dcBeg, size_t dcEnd, size_t yBeg, size_t yEnd,
+            const float* weight, const float* bias, const float* params, float* dst)
+        {
+            for (size_t dc = dcBeg; dc < dcEnd; dc += a.macroD)
+            {
+                size_t macroD = Simd::Min(dcEnd, dc + a.macroD) - dc;
+                const float* pw = weight + dc * p.kernelY * p.kernelX * p.srcC;
+                const float* pp = params + (p.activation == ::SimdConvolutionActivationPrelu ? dc : 0);
                 for (size_t sc = 0; sc < p.srcC; sc += a.macroC)
                 {
                     size_t macroC = Simd::Min(p.srcC, sc + a.macroC) - sc;
-                    for (size_t yBeg = 0; yBeg < p.dstH;)
+                    for (size_t yB = yBeg; yB < yEnd;)
                     {
-                        size_t yEnd = Simd::Min(yBeg + a.macroH, p.dstH);
+                        size_t yE = Simd::Min(yB + a.macroH, yEnd);
                         if (sc + macroC == p.srcC)
-                            a.convolutions[TermLast](src + sc, p, a, macroD, yBeg, yEnd, macroC, weight, bias + dc, params, dst + dc, macroC == p.srcC ? 1 : 0);
+                            a.convolutions[TermLast](src + sc, p, a, macroD, yB, yE, macroC, pw, bias + dc, pp, dst + dc, macroC == p.srcC ? 1 : 0);
                         else
-                            a.convolutions[TermInterim](src + sc, p, a, macroD, yBeg, yEnd, macroC, weight, bias + dc, params, dst + dc, sc == 0 ? 1 : 0);
-                        yBeg = yEnd;
+                            a.convolutions[TermInterim](src + sc, p, a, macroD, yB, yE, macroC, pw, bias + dc, pp, dst + dc, sc == 0 ? 1 : 0);
+                        yB = yE;
                     }
-                    weight += a.F * macroC;
+                    pw += a.F * macroC;
                 }
-                if (p.activation == ::SimdConvolutionActivationPrelu)
-                    params += macroD;
-                weight += p.kernelY * p.kernelY * p.srcC * macroD - p.srcC * a.F;
             }
         }
 
@@ -1567,12 +1729,7 @@ namespace Simd
             alg.F = F;
             alg.microD = F*N;
             alg.macroC = Simd::Min(Base::AlgCacheL1() / sizeof(float) / p.kernelY / p.kernelX / alg.microD, p.srcC);
-            for (size_t macroH = p.dstH; macroH >= 1; macroH--)
-            {
-                alg.macroH = macroH;
-                if (alg.macroC * p.srcW * (alg.macroH * p.strideY + p.kernelY * p.dilationY - 1) * sizeof(float) <= Base::AlgCacheL2())
-                    break;
-            }
+            SetMacroH(p, alg);
             alg.macroD = Simd::RestrictRange(AlignLoAny(Base::AlgCacheL3() / sizeof(float) / p.kernelY / p.kernelX / alg.macroC, alg.microD), 
                 alg.microD, AlignHiAny(p.dstC, alg.microD));
             alg.stepW = p.kernelY * p.kernelX * p.srcC * alg.F;
@@ -1618,12 +1775,7 @@ namespace Simd
             a.F = F;
             a.microD = a.F*2;
             a.macroC = Simd::Min(Base::AlgCacheL1() / sizeof(float) / p.kernelY / p.kernelX / a.microD, p.srcC);
-            for (size_t macroH = p.dstH; macroH >= 1; macroH--)
-            {
-                a.macroH = macroH;
-                if (a.macroC * p.srcW * (a.macroH * p.strideY + p.kernelY * p.dilationY - 1) * sizeof(float) <= Base::AlgCacheL2())
-                    break;
-            }
+            SetMacroH(p, a);
             a.macroD = Simd::RestrictRange(AlignLoAny(Base::AlgCacheL3() / sizeof(float) / p.kernelY / p.kernelX / a.macroC, a.microD), 
                 a.microD, AlignHiAny(p.dstC, a.microD));
             _old.weight.Resize(AlignHiAny(p.dstC, a.microD) * p.kernelY * p.kernelX * p.srcC);
@@ -1668,6 +1820,61 @@ namespace Simd
             }
         }
 
+        static void SparseImgToRow(const float* src, const ConvParam32f& p, size_t mBeg, size_t mEnd, float* dst)
+        {
+            size_t size = p.srcC * sizeof(float);
+            for (size_t m = mBeg; m < mEnd; ++m)
+            {
+                size_t b = m / (p.dstH * p.dstW), dy = m / p.dstW % p.dstH, dx = m % p.dstW;
+                const float* ps = src + b * p.srcH * p.srcW * p.srcC;
+                for (size_t ky = 0; ky < p.kernelY; ++ky)
+                {
+                    size_t sy = dy * p.strideY + ky * p.dilationY - p.padY;
+                    for (size_t kx = 0; kx < p.kernelX; ++kx, dst += p.srcC)
+                    {
+                        size_t sx = dx * p.strideX + kx * p.dilationX - p.padX;
+                        if (sy < p.srcH && sx < p.srcW)
+                            memcpy(dst, ps + (sy * p.srcW + sx) * p.srcC, size);
+                        else
+                            memset(dst, 0, size);
+                    }
+                }
+            }
+        }
+
+        void SynetConvolution32fNhwcDirect::SparseSetAlgParam()
+        {
+            const ConvParam32f& p = _param;
+            size_t K = _sparse.weight.K, M = p.batch * p.dstH * p.dstW;
+            _sparse.macroM = Simd::RestrictRange<size_t>(Base::AlgCacheL2() / 2 / (K * sizeof(float)), 1, DivHi(M, _threads));
+            _sparse.sizeB = p.Is1x1() ? 0 : _threads * _sparse.macroM * K;
+        }
+
+        void SynetConvolution32fNhwcDirect::SparseForward(const float* src, float* buf, float* dst)
+        {
+            const ConvParam32f& p = _param;
+            size_t K = _sparse.weight.K, N = p.dstC, M = p.batch * p.dstH * p.dstW, macroM = _sparse.macroM;
+            bool identity = p.activation == SimdConvolutionActivationIdentity;
+            Simd::Parallel(0, DivHi(M, macroM), [&](size_t thread, size_t begin, size_t end)
+            {
+                float* pb = buf ? buf + thread * macroM * K : NULL;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    size_t mBeg = i * macroM, mEnd = Simd::Min(M, mBeg + macroM);
+                    const float* ps = src + mBeg * K;
+                    if (pb)
+                    {
+                        SparseImgToRow(src, p, mBeg, mEnd, pb);
+                        ps = pb;
+                    }
+                    float* pd = dst + mBeg * N;
+                    _sparse.gemm(ps, mEnd - mBeg, K, _sparse.weight, identity ? _bias : NULL, pd, N);
+                    if (!identity)
+                        _biasAndActivation(_bias, N, mEnd - mBeg, p.activation, _params, SimdTrue, pd);
+                }
+            }, _threads);
+        }
+
         bool SynetConvolution32fNhwcDirect::Preferable(const ConvParam32f & p)
         {
             return false;
@@ -1686,6 +1893,8 @@ namespace Simd
             {
                 return new SynetConvolution32fBf16Gemm(param);
             }
+            else if (Fp16Soft(compatibility) && SynetConvolution32fFp16Nhwc::Preferable(param))
+                return new SynetConvolution32fFp16Nhwc(param);
 #if !defined(SIMD_BASE_ONLY_GEMM_NN)
             else if (SynetConvolution32fDepthwiseDotProduct::Preferable(param))
                 return new SynetConvolution32fDepthwiseDotProduct(param);
@@ -76,11 +76,17 @@ namespace Simd
         void SynetConvolution32fBf16Gemm::SetParams(const float * weight, SimdBool * internal, const float * bias, const float * params)
         {
             Simd::SynetConvolution32f::SetParams(weight, internal, bias, params);
-            Float32ToBFloat16(weight, _weight.size, _weight.data);
+            if (_packed.Empty())
+                Float32ToBFloat16(weight, _weight.size, _weight.data);
             if (internal)
                 *internal = SimdTrue;
         }
 
+        void SynetConvolution32fBf16Gemm::Pack(SynetPackedWeight::Visitor& visitor)
+        {
+            visitor(_weight);
+        }
+
         void SynetConvolution32fBf16Gemm::Forward(const float * src, float * buf_, float * dst)
         {
             const ConvParam32f & p = _param;
@@ -305,11 +311,21 @@ namespace Simd
 
         void SynetConvolution32fBf16Nhwc::SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params)
         {
-            SetWeight(weight);
+            if (_packed.Empty())
+            {
+                SetWeight(weight);
+                SetBias(bias);
+                SetParams(params);
+            }
             if (internal)
                 *internal = SimdTrue;
-            SetBias(bias);
-            SetParams(params);
+        }
+
+        void SynetConvolution32fBf16Nhwc::Pack(SynetPackedWeight::Visitor& visitor)
+        {
+            visitor(_weight);
+            visitor(_bias);
+            visitor(_params);
         }
 
         void SynetConvolution32fBf16Nhwc::SetWeight(const float * weight)
@@ -0,0 +1,100 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetConvolution32f.h"
+#include "Simd/SimdSynetInnerProduct32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace Base
+    {
+        SynetConvolution32fFp16Nhwc::SynetConvolution32fFp16Nhwc(const ConvParam32f& p)
+            : SynetConvolution32f(p)
+        {
+            SetShape(p);
+            SetSize(16);
+            _gemm = SynetInnerProduct32fFp16Gemm;
+            _biasAndActivation = Base::ConvolutionBiasAndActivation;
+        }
+
+        size_t SynetConvolution32fFp16Nhwc::InternalBufferSize() const
+        {
+            return SynetConvolution32f::InternalBufferSize() + _rWeight.RawSize() + _rBias.RawSize();
+        }
+
+        void SynetConvolution32fFp16Nhwc::SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params)
+        {
+            const ConvParam32f& p = _param;
+            SynetConvolution32f::SetParams(weight, internal, bias, params);
+            if (_packed.Empty())
+                SynetInnerProduct32fFp16Reorder(weight, p.srcC, p.dstC, SimdFalse, _F, _rWeight.data);
+            _rBias.Clear();
+            if (bias && p.activation == SimdConvolutionActivationIdentity)
+                memcpy(_rBias.data, bias, p.dstC * sizeof(float));
+            if (internal)
+                *internal = SimdTrue;
+        }
+
+        void SynetConvolution32fFp16Nhwc::Forward(const float* src, float* buf, float* dst)
+        {
+            const ConvParam32f& p = _param;
+            Simd::Parallel(0, _M, [&](size_t thread, size_t begin, size_t end)
+            {
+                _gemm(src + begin * p.srcC, end - begin, p.srcC, _rWeight.data, p.dstC, _rBias.data, dst + begin * p.dstC);
+            }, _threads);
+            if (p.activation != SimdConvolutionActivationIdentity)
+                _biasAndActivation(_bias, p.dstC, _M, p.activation, _params, SimdTrue, dst);
+        }
+
+        bool SynetConvolution32fFp16Nhwc::Preferable(const ConvParam32f& p)
+        {
+            return p.trans && p.group == 1 && p.Is1x1();
+        }
+
+        void SynetConvolution32fFp16Nhwc::Pack(SynetPackedWeight::Visitor& visitor)
+        {
+            visitor(_rWeight);
+        }
+
+        bool SynetConvolution32fFp16Nhwc::SetShape(const ConvParam32f& p)
+        {
+            _param = p;
+            _M = p.batch * p.dstH * p.dstW;
+            _threads = SynetThreadNumber(p.Flop());
+            return true;
+        }
+
+        void SynetConvolution32fFp16Nhwc::SetSize(size_t F)
+        {
+            const ConvParam32f& p = _param;
+            _F = F;
+            _rWeight.Resize(AlignHi(p.dstC, _F) * p.srcC);
+            _rBias.Resize(AlignHi(p.dstC, _F), true);
+        }
+    }
+#endif
+}
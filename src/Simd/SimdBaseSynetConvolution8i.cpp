@@ -22,12 +22,14 @@
 * SOFTWARE.
 */
 #include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetGemm8i.h"
 #include "Simd/SimdSynetConvolution8iCommon.h"
 #include "Simd/SimdSynet.h"
 #include "Simd/SimdMath.h"
 #include "Simd/SimdBase.h"
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdLog.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -101,6 +103,8 @@ namespace Simd
         const ConvParam8i& p = _param;
         _srcCvt.Init(stats[0], stats[1], p.srcC, p.compatibility);
         _dstCvt.Init(stats[2], stats[3], p.dstC, p.compatibility);
+        if (!_packed.Empty())
+            return;
         size_t G = p.group, D = p.dstC / G, C = p.srcC / G, K = p.kernelY * p.kernelX, CK = C * K, GD = G * D;
         Array32f normW(CK);
         const float* pSrcW = weight;
@@ -239,6 +243,49 @@ namespace Simd
         }
     }
 
+    void SynetConvolution8i::Pack(SynetPackedWeight::Visitor& visitor)
+    {
+        visitor(_weight);
+        visitor(_norm);
+        visitor(_bias);
+        visitor(_params);
+    }
+
+    SynetPackedWeight SynetConvolution8i::Export()
+    {
+        if (!_packed.Empty())
+            return _packed;
+        SynetPackedWeight::Visitor collect(SynetPackedWeight::Visitor::Collect);
+        Pack(collect);
+        return SynetPackedWeight(SynetPackedWeight::Key(Desc(), _param, _param.batch, _param.compatibility), collect);
+    }
+
+    bool SynetConvolution8i::SetPackedParams(const SynetPackedWeight& packed, const float* weight, const float* bias, const float* params, const float* const* stats)
+    {
+        if (packed.Empty() || packed.Key() != SynetPackedWeight::Key(Desc(), _param, _param.batch, _param.compatibility))
+            return false;
+        SynetPackedWeight::Visitor check(SynetPackedWeight::Visitor::Check, &packed);
+        Pack(check);
+        if (!check.Ok())
+            return false;
+        SynetPackedWeight::Visitor bind(SynetPackedWeight::Visitor::Bind, &packed);
+        Pack(bind);
+        _packed = packed;
+        SetParams(weight, bias, params, stats);
+        return true;
+    }
+
+    bool SynetConvolution8i::Reshape(size_t batch, size_t srcH, size_t srcW)
+    {
+        ConvParam8i param = _param;
+        if (!param.Reshape(batch, srcH, srcW) || !SetShape(param))
+            return false;
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        _perf = NULL;
+#endif
+        return true;
+    }
+
     void SynetConvolution8i::Forward(const uint8_t* src, uint8_t* buf, uint8_t* dst)
     {
         if (buf == NULL)
@@ -256,6 +303,54 @@ namespace Simd
         }
     }
 
+    void SynetConvolution8i::ActivateAndConvert(float* dst32f, uint8_t* dst)
+    {
+        const ConvParam8i& p = _param;
+        switch (p.activation)
+        {
+        case SimdConvolutionActivationIdentity:
+            break;
+        case SimdConvolutionActivationRelu:
+        {
+            float slope = 0;
+            Base::SynetRelu32f(dst32f, _merge * _sizeD, &slope, dst32f);
+            break;
+        }
+        case SimdConvolutionActivationLeakyRelu:
+            Base::SynetRelu32f(dst32f, _merge * _sizeD, _params.data, dst32f);
+            break;
+        case SimdConvolutionActivationRestrictRange:
+            Base::SynetRestrictRange32f(dst32f, _merge * _sizeD, _params.data, _params.data + 1, dst32f);
+            break;
+        case SimdConvolutionActivationPrelu:
+            for (size_t m = 0; m < _merge; ++m)
+                Base::SynetPreluLayerForward(dst32f + m * _sizeD, _params.data, p.dstC, p.dstH*p.dstW, dst32f + m * _sizeD, p.dstF);
+            break;
+        case SimdConvolutionActivationElu:
+            Base::SynetElu32f(dst32f, _merge * _sizeD, _params.data, dst32f);
+            break;
+        case SimdConvolutionActivationHswish:
+            Base::SynetHswish32f(dst32f, _merge * _sizeD, _params.data, _params.data + 1, dst32f);
+            break;
+        case SimdConvolutionActivationMish:
+            Base::SynetMish32f(dst32f, _merge * _sizeD, _params.data, dst32f);
+            break;
+        case SimdConvolutionActivationHardSigmoid:
+            Base::SynetHardSigmoid32f(dst32f, _merge * _sizeD, _params.data, _params.data + 1, dst32f);
+            break;
+        case SimdConvolutionActivationSwish:
+            Base::SynetSwish32f(dst32f, _merge * _sizeD, _params.data, dst32f);
+            break;
+        case SimdConvolutionActivationGelu:
+            Base::SynetGelu32f(dst32f, _merge * _sizeD, dst32f);
+            break;
+        default:
+            assert(0);
+        }
+        if (_dst8u)
+            Base::Convert<float, uint8_t, float>(dst32f, _merge, p.dstC, p.dstH, p.dstW, p.dstF, _dstCvt.scale.data, _dstCvt.shift.data, _dstCvt.uMin, _dstCvt.uMax, dst);
+    }
+
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
     Base::PerformanceMeasurer * SynetConvolution8i::Perf(const char* func)
     {
@@ -347,49 +442,7 @@ namespace Simd
                 }
             }
             Convert<int32_t, float, float>(sum, _merge, p.dstC, p.dstH, p.dstW, p.dstF, _norm.data, _bias.data, 0, 0, dst32f);
-            switch (p.activation)
-            {
-            case SimdConvolutionActivationIdentity:
-                break;
-            case SimdConvolutionActivationRelu:
-            {
-                float slope = 0;
-                SynetRelu32f(dst32f, _merge * _sizeD, &slope, dst32f);
-                break;
-            }
-            case SimdConvolutionActivationLeakyRelu:
-                SynetRelu32f(dst32f, _merge * _sizeD, _params.data, dst32f);
-                break;
-            case SimdConvolutionActivationRestrictRange:
-                SynetRestrictRange32f(dst32f, _merge * _sizeD, _params.data, _params.data + 1, dst32f);
-                break;
-            case SimdConvolutionActivationPrelu:
-                for (size_t m = 0; m < _merge; ++m)
-                    SynetPreluLayerForward(dst32f + m * _sizeD, _params.data, p.dstC, p.dstH*p.dstW, dst32f + m * _sizeD, p.dstF);
-                break;
-            case SimdConvolutionActivationElu:
-                SynetElu32f(dst32f, _merge * _sizeD, _params.data, dst32f);
-                break;
-            case SimdConvolutionActivationHswish:
-                SynetHswish32f(dst32f, _merge * _sizeD, _params.data, _params.data + 1, dst32f);
-                break;
-            case SimdConvolutionActivationMish:
-                SynetMish32f(dst32f, _merge * _sizeD, _params.data, dst32f);
-                break;
-            case SimdConvolutionActivationHardSigmoid:
-                SynetHardSigmoid32f(dst32f, _merge * _sizeD, _params.data, _params.data + 1, dst32f);
-                break;
-            case SimdConvolutionActivationSwish:
-                SynetSwish32f(dst32f, _merge * _sizeD, _params.data, dst32f);
-                break;
-            case SimdConvolutionActivationGelu:
-                SynetGelu32f(dst32f, _merge * _sizeD, dst32f);
-                break;
-            default:
-                assert(0);
-            }
-            if (_dst8u)
-                Convert<float, uint8_t, float>(dst32f, _merge, p.dstC, p.dstH, p.dstW, p.dstF, _dstCvt.scale.data, _dstCvt.shift.data, _dstCvt.uMin, _dstCvt.uMax, dst);
+            ActivateAndConvert(dst32f, dst);
         }
 
         //---------------------------------------------------------------------
@@ -399,6 +452,8 @@ namespace Simd
         {
             for (size_t i = 0; i < Term8iSize; ++i)
                 _convolutions[i] = NULL;
+            _threads = SynetThreadNumber(int64_t(p.kernelY * p.kernelX * p.srcC / p.group) * _sizeD * 2);
+            _microHW = 0;
         }
 
         String SynetConvolution8iNhwcDirect::Desc() const
@@ -425,7 +480,8 @@ namespace Simd
         void SynetConvolution8iNhwcDirect::SetParams(const float* weight, const float* bias, const float* params, const float* const* stats)
         {
             SynetConvolution8i::SetParams(weight, bias, params, stats);
-            ReorderWeight();
+            if (_packed.Empty())
+                ReorderWeight();
             _alg.zero = Set4(_srcCvt.zero[0]);
             _alg.upper = Set4(_dstCvt.uMax);
         }
@@ -453,6 +509,7 @@ namespace Simd
         void SynetConvolution8iNhwcDirect::SetAlgParam(size_t F, size_t microD, size_t microHW, size_t L1, size_t L2, size_t L3)
         {
             const ConvParam8i& p = _param;
+            _microHW = microHW;
             _alg.F = F;
             _alg.microD = microD;
             _alg.macroC = Simd::Min(AlignLoAny(L1 / p.kernelY / p.kernelX / microD, 4), p.srcC);
@@ -483,6 +540,18 @@ namespace Simd
             _sizeB = (_alg.macroC < p.srcC || microHW >= 32) && _dst8u ? _sizeD : 0;
         }
 
+        bool SynetConvolution8iNhwcDirect::SetShape(const ConvParam8i& p)
+        {
+            if (_microHW == 0)
+                return false;
+            _param = p;
+            _sizeS = p.srcC * p.srcH * p.srcW;
+            _sizeD = p.dstC * p.dstH * p.dstW;
+            _threads = SynetThreadNumber(int64_t(p.kernelY * p.kernelX * p.srcC / p.group) * _sizeD * 2);
+            SetAlgParam(_alg.F, _alg.microD, _microHW, Base::AlgCacheL1(), Base::AlgCacheL2(), Base::AlgCacheL3());
+            return true;
+        }
+
         void SynetConvolution8iNhwcDirect::ReorderWeight()
         {
             const ConvParam8i& p = _param;
@@ -556,44 +625,46 @@ namespace Simd
 
         void SynetConvolution8iNhwcDirect::Forward8u(const uint8_t* src, const ConvParam8i& p, int32_t* buf, uint8_t* dst)
         {
-            const int8_t* weight = _weight.data;
-            const float* norm = _norm.data;
-            const float* bias = _bias.data;
-            const float* params = _params.data;
-            const float* scale = _dstCvt.scale.data;
-            const float* shift = _dstCvt.shift.data;
-            for (size_t dc = 0; dc < p.dstC; dc += _alg.macroD)
+            Simd::Parallel2d(p.dstH, p.dstC, _alg.microD, [&](size_t thread, size_t yBeg, size_t yEnd, size_t dcBeg, size_t dcEnd)
             {
-                size_t macroD = Simd::Min(p.dstC, dc + _alg.macroD) - dc;
+                Forward8u(src, p, dcBeg, dcEnd, yBeg, yEnd, buf, dst);
+            }, _threads);
+        }
+
+        void SynetConvolution8iNhwcDirect::Forward8u(const uint8_t* src, const ConvParam8i& p, size_t dcBeg, size_t dcEnd, size_t yBeg, size_t yEnd, int32_t* buf, uint8_t* dst)
+        {
+            bool channelParams = p.activation == ::SimdConvolutionActivationLeakyRelu || p.activation == ::SimdConvolutionActivationPrelu;
+            for (size_t dc = dcBeg; dc < dcEnd; dc += _alg.macroD)
+            {
+                size_t macroD = Simd::Min(dcEnd, dc + _alg.macroD) - dc;
+                const int8_t* weight = _weight.data + p.kernelY * p.kernelX * DivHi(p.srcC, 4) * dc * 4;
+                const float* norm = _norm.data + dc;
+                const float* bias = _bias.data + dc;
+                const float* params = _params.data + (channelParams ? dc : 0);
+                const float* scale = _dstCvt.scale.data + dc;
+                const float* shift = _dstCvt.shift.data + dc;
+                int32_t* sum = buf + dc;
+                uint8_t* out = dst + dc * _alg.size;
                 for (size_t sc = 0; sc < p.srcC; sc += _alg.macroC)
                 {
                     size_t macroC = Simd::Min(p.srcC, sc + _alg.macroC) - sc;
-                    for (size_t yBeg = 0; yBeg < p.dstH;)
+                    for (size_t yB = yBeg; yB < yEnd;)
                     {
-                        size_t yEnd = Simd::Min(yBeg + _alg.macroH, p.dstH);
+                        size_t yE = Simd::Min(yB + _alg.macroH, yEnd);
                         if (sc + macroC == p.srcC)
                         {
                             int first = macroC == p.srcC ? 1 : 0;
                             if (_alg.size == 1)
-                                _convolutions[Term8iLast8u](src + sc, p, _alg, macroD, yBeg, yEnd, macroC, weight, norm, bias, params, scale, shift, buf, dst, first);
+                                _convolutions[Term8iLast8u](src + sc, p, _alg, macroD, yB, yE, macroC, weight, norm, bias, params, scale, shift, sum, out, first);
                             else
-                                _convolutions[Term8iLast32f](src + sc, p, _alg, macroD, yBeg, yEnd, macroC, weight, norm, bias, params, scale, shift, buf, dst, first);
+                                _convolutions[Term8iLast32f](src + sc, p, _alg, macroD, yB, yE, macroC, weight, norm, bias, params, scale, shift, sum, out, first);
                         }
                         else
-                            _convolutions[Term8iInterim](src + sc, p, _alg, macroD, yBeg, yEnd, macroC, weight, norm, bias, params, scale, shift, buf, dst, sc == 0 ? 1 : 0);
-                        yBeg = yEnd;
+                            _convolutions[Term8iInterim](src + sc, p, _alg, macroD, yB, yE, macroC, weight, norm, bias, params, scale, shift, sum, out, sc == 0 ? 1 : 0);
+                        yB = yE;
                     }
                     weight += DivHi(macroC, 4) * _alg.F * 4;
                 }
-                weight += p.kernelY * p.kernelX * DivHi(p.srcC, 4) * macroD * 4 - DivHi(p.srcC, 4) * _alg.F * 4;
-                norm += macroD;
-                bias += macroD;
-                if (p.activation == ::SimdConvolutionActivationLeakyRelu || p.activation == ::SimdConvolutionActivationPrelu)
-                    params += macroD;
-                shift += macroD;
-                scale += macroD;
-                buf += _alg.macroD;
-                dst += _alg.macroD * _alg.size;
             }
         }
 
@@ -652,12 +723,21 @@ namespace Simd
 #if !defined(SIMD_BASE_ONLY_GEMM_NN)
             else if (SynetConvolution8iNhwcDepthwise::Preferable(param))
                 return new SynetConvolution8iNhwcDepthwise(param);
+            else if (SynetConvolution8iWinograd::Preferable(param))
+                return new SynetConvolution8iWinograd(param);
             else if (SynetConvolution8iNhwcDirect::Preferable(param))
                 return new SynetConvolution8iNhwcDirect(param);
 #endif
             else
                 return new SynetConvolution8iGemmNN(param);
         }
+
+        //---------------------------------------------------------------------
+
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+        {
+            return Simd::SynetGemm8iInit(Gemm8iParam(M, N, K, srcT, dstT, activation, compatibility), SynetConvolution8iInit);
+        }
     }
 #endif
 }
@@ -0,0 +1,224 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetConvolution8iCommon.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdParallel.hpp"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace Base
+    {
+        static void WinogradKernel3x3Block2x2SetInput8i(const uint8_t* src, const ConvParam8i& p, const uint8_t* zero, size_t tileW, size_t tyBeg, size_t tyEnd, int16_t* dst, size_t dstStride)
+        {
+            size_t srcC2 = AlignHi(p.srcC, 2);
+            const uint8_t* ptrs[16];
+            for (size_t ty = tyBeg; ty < tyEnd; ++ty)
+            {
+                for (size_t tx = 0; tx < tileW; ++tx)
+                {
+                    WinogradKernel3x3Block2x2SetSrc8i(src, p, zero, ty, tx, ptrs);
+                    size_t c = 0;
+                    for (; c < p.srcC; ++c)
+                        WinogradKernel3x3Block2x2SetInput8i1(ptrs, c, dst + c, dstStride);
+                    for (; c < srcC2; ++c)
+                        for (size_t i = 0; i < 16; ++i)
+                            dst[i * dstStride + c] = 0;
+                    dst += srcC2;
+                }
+            }
+        }
+
+        static void WinogradKernel3x3Block2x2Gemm8i(const int16_t* src, size_t M, size_t K, const int16_t* weight, size_t N, int32_t* dst)
+        {
+            for (size_t i = 0; i < M; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    dst[j] = 0;
+                for (size_t k = 0; k < K; k += 2)
+                {
+                    int32_t s0 = src[k + 0], s1 = src[k + 1];
+                    const int16_t* w = weight + k * N;
+                    for (size_t j = 0; j < N; ++j)
+                        dst[j] += s0 * w[2 * j + 0] + s1 * w[2 * j + 1];
+                }
+                src += K;
+                dst += N;
+            }
+        }
+
+        static void WinogradKernel3x3Block2x2SetOutput8i(const int32_t* src, size_t srcStride, const ConvParam8i& p, size_t tileW, size_t tyBeg, size_t tyEnd, size_t N, const float* norm, const float* bias, float* dst)
+        {
+            int32_t sum[4];
+            for (size_t ty = tyBeg; ty < tyEnd; ++ty)
+            {
+                for (size_t tx = 0; tx < tileW; ++tx)
+                {
+                    size_t dy = ty * 2, dx = tx * 2, rows = Simd::Min<size_t>(p.dstH - dy, 2), cols = Simd::Min<size_t>(p.dstW - dx, 2);
+                    for (size_t d = 0; d < p.dstC; ++d)
+                    {
+                        WinogradKernel3x3Block2x2SetOutput8i1(src + d, srcStride, sum);
+                        for (size_t r = 0; r < rows; ++r)
+                            for (size_t c = 0; c < cols; ++c)
+                                dst[((dy + r) * p.dstW + dx + c) * p.dstC + d] = float(sum[r * 2 + c]) * norm[d] + bias[d];
+                    }
+                    src += N;
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        SynetConvolution8iWinograd::SynetConvolution8iWinograd(const ConvParam8i& p)
+            : SynetConvolution8i(p)
+        {
+            _srcC2 = AlignHi(p.srcC, 2);
+            _dstCA = AlignHi(p.dstC, 16);
+            SetAlgParam();
+            _setInput = WinogradKernel3x3Block2x2SetInput8i;
+            _gemm = WinogradKernel3x3Block2x2Gemm8i;
+            _setOutput = WinogradKernel3x3Block2x2SetOutput8i;
+        }
+
+        String SynetConvolution8iWinograd::Desc() const
+        {
+            const ConvParam8i& p = _param;
+            return Ext() + "::Winograd F(2x2,3x3)" + (Narrowed(p.compatibility) ? "-n" : "-p");
+        }
+
+        size_t SynetConvolution8iWinograd::InternalBufferSize() const
+        {
+            return SynetConvolution8i::InternalBufferSize() + _winogradWeight.RawSize();
+        }
+
+        size_t SynetConvolution8iWinograd::ExternalBufferSize() const
+        {
+            size_t size = SynetConvolution8i::ExternalBufferSize();
+            if (_dst8u)
+                size += AlignHi(_sizeD * sizeof(float), SIMD_ALIGN);
+            size += AlignHi(_strideV * _threads * sizeof(int16_t), SIMD_ALIGN);
+            size += AlignHi(_strideM * _threads * sizeof(int32_t), SIMD_ALIGN);
+            return size;
+        }
+
+        void SynetConvolution8iWinograd::SetParams(const float* weight, const float* bias, const float* params, const float* const* stats)
+        {
+            const ConvParam8i& p = _param;
+            if (_packed.Empty())
+                _weight.Resize(p.kernelY * p.kernelX * p.srcC * p.dstC);
+            SynetConvolution8i::SetParams(weight, bias, params, stats);
+            if (!_packed.Empty())
+                return;
+            assert(!Overflow(p.compatibility));
+            size_t C = p.srcC, D = p.dstC, N = _dstCA, CD = C * D;
+            _winogradWeight.Resize(16 * _srcC2 * _dstCA, true);
+            for (size_t c = 0; c < C; ++c)
+            {
+                for (size_t d = 0; d < D; ++d)
+                {
+                    const int8_t* w = _weight.data + c * D + d;
+                    int t[12];
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        int w0 = w[(0 + j) * CD], w1 = w[(3 + j) * CD], w2 = w[(6 + j) * CD];
+                        t[0 + j] = 2 * w0;
+                        t[3 + j] = w0 + w1 + w2;
+                        t[6 + j] = w0 - w1 + w2;
+                        t[9 + j] = 2 * w2;
+                    }
+                    int16_t* dst = _winogradWeight.data + c / 2 * N * 2 + d * 2 + c % 2;
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        dst[(i * 4 + 0) * _srcC2 * N] = int16_t(2 * t[i * 3 + 0]);
+                        dst[(i * 4 + 1) * _srcC2 * N] = int16_t(t[i * 3 + 0] + t[i * 3 + 1] + t[i * 3 + 2]);
+                        dst[(i * 4 + 2) * _srcC2 * N] = int16_t(t[i * 3 + 0] - t[i * 3 + 1] + t[i * 3 + 2]);
+                        dst[(i * 4 + 3) * _srcC2 * N] = int16_t(2 * t[i * 3 + 2]);
+                    }
+                }
+            }
+            _weight.Resize(0);
+        }
+
+        bool SynetConvolution8iWinograd::Preferable(const ConvParam8i& p)
+        {
+            return false;
+        }
+
+        void SynetConvolution8iWinograd::Pack(SynetPackedWeight::Visitor& visitor)
+        {
+            SynetConvolution8i::Pack(visitor);
+            visitor(_winogradWeight);
+        }
+
+        bool SynetConvolution8iWinograd::SetShape(const ConvParam8i& p)
+        {
+            _param = p;
+            _sizeS = p.srcC * p.srcH * p.srcW;
+            _sizeD = p.dstC * p.dstH * p.dstW;
+            SetAlgParam();
+            return true;
+        }
+
+        void SynetConvolution8iWinograd::SetAlgParam()
+        {
+            const ConvParam8i& p = _param;
+            _tileH = DivHi(p.dstH, 2);
+            _tileW = DivHi(p.dstW, 2);
+            size_t rowSize = 16 * _tileW * (_srcC2 * sizeof(int16_t) + _dstCA * sizeof(int32_t));
+            _tileHs = Simd::RestrictRange<size_t>(Base::AlgCacheL2() / 2 / rowSize, 1, _tileH);
+            _threads = SynetThreadNumber(int64_t(p.kernelY * p.kernelX * p.srcC) * _sizeD * 2);
+            if (_threads > DivHi(_tileH, _tileHs))
+                _tileHs = DivHi(_tileH, _threads);
+            _threads = Simd::Min(_threads, DivHi(_tileH, _tileHs));
+            _strideV = AlignHi(16 * _tileHs * _tileW * _srcC2, SIMD_ALIGN);
+            _strideM = AlignHi(16 * _tileHs * _tileW * _dstCA, SIMD_ALIGN);
+        }
+
+        void SynetConvolution8iWinograd::Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst)
+        {
+            const ConvParam8i& p = _param;
+            float* dst32f = _dst8u ? Allocate<float>(buf, _sizeD) : (float*)dst;
+            int16_t* bufV = Allocate<int16_t>(buf, _strideV * _threads);
+            int32_t* bufM = Allocate<int32_t>(buf, _strideM * _threads);
+            Simd::Parallel(0, DivHi(_tileH, _tileHs), [&](size_t thread, size_t begin, size_t end)
+            {
+                int16_t* V = bufV + thread * _strideV;
+                int32_t* M = bufM + thread * _strideM;
+                for (size_t block = begin; block < end; ++block)
+                {
+                    size_t tyBeg = block * _tileHs, tyEnd = Simd::Min(tyBeg + _tileHs, _tileH), n = (tyEnd - tyBeg) * _tileW;
+                    _setInput(src, p, _srcCvt.zero.data, _tileW, tyBeg, tyEnd, V, n * _srcC2);
+                    for (size_t i = 0; i < 16; ++i)
+                        _gemm(V + i * n * _srcC2, n, _srcC2, _winogradWeight.data + i * _srcC2 * _dstCA, _dstCA, M + i * n * _dstCA);
+                    _setOutput(M, n * _dstCA, p, _tileW, tyBeg, tyEnd, _dstCA, _norm.data, _bias.data, dst32f);
+                }
+            }, _threads);
+            ActivateAndConvert(dst32f, dst);
+        }
+    }
+#endif
+}
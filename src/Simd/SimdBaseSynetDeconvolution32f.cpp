@@ -26,6 +26,7 @@
 #include "Simd/SimdSynetConvolution32fCommon.h"
 #include "Simd/SimdSynet.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdCpu.h"
 
 namespace Simd
 {
@@ -40,6 +41,17 @@ namespace Simd
     }
 #endif
 
+    bool SynetDeconvolution32f::Reshape(size_t batch, size_t srcH, size_t srcW)
+    {
+        DeconvParam32f param = _param;
+        if (!param.Reshape(batch, srcH, srcW) || !SetShape(param))
+            return false;
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        _perf = NULL;
+#endif
+        return true;
+    }
+
     namespace Base
     {
         SynetDeconvolution32fGemmNN::SynetDeconvolution32fGemmNN(const DeconvParam32f & p)
@@ -88,7 +100,7 @@ namespace Simd
             }
             else
                 _weightT.Resize(p.srcC * p.kernelY * p.kernelX * p.dstC / p.group);
-            _gemm.Init(InitGemmFuncs(Base::Gemm32fNN, "Base"));
+            _gemm.Init(InitGemmFuncs(Base::Gemm32fNN, "Base"), "Gemm32fNN");
             _biasAndActivation = Base::ConvolutionBiasAndActivation;
         }
 
@@ -312,6 +324,17 @@ namespace Simd
                 _rParams.Resize(2, true);
         }
 
+        bool SynetDeconvolution32fNhwcDirect2x2::SetShape(const DeconvParam32f & p)
+        {
+            if (_deconvolution == NULL)
+                return false;
+            _param = p;
+            _sizeS = p.srcC * p.srcH * p.srcW;
+            _sizeD = p.dstC * p.dstH * p.dstW;
+            _alg.macroH = Simd::Min(Base::AlgCacheL2() / sizeof(float) / _alg.macroC / p.srcW, p.srcH);
+            return true;
+        }
+
         void SynetDeconvolution32fNhwcDirect2x2::ReorderWeight(const float * src, float * dst)
         {
             const DeconvParam32f & p = _param;
@@ -23,6 +23,7 @@
 */
 #include "Simd/SimdSynetInnerProduct32f.h"
 #include "Simd/SimdSynetConvolution32f.h"
+#include "Simd/SimdSynet.h"
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdBase.h"
 
@@ -68,10 +69,13 @@ namespace Simd
             : SynetInnerProduct32f(p)
             , _0(0.0f)
             , _1(1.0f)
+            , _sparse(p.input, p.output)
         {
             _M = _param.batch;
             _N = _param.output;
             _K = _param.input;
+            _sparseGemm = Base::SynetSparse32fGemm;
+            _cbSize = 0;
             _ldS = _K;
             _ldD = _N;
             _biasAndActivation = Base::ConvolutionBiasAndActivation;
@@ -92,6 +96,8 @@ namespace Simd
 
         String SynetInnerProduct32fGemm::Desc() const 
         { 
+            if (_sparse.Enable())
+                return Ext() + "::GemmSparse";
             return Ext() + "::Gemm" + (_prod ? "Prod" : 
                 String("N") + (_cbWeight.size ? "Ncb" : (_param.transpose == SimdTrue ? "T" : "N")));
         }
@@ -99,6 +105,14 @@ namespace Simd
         void SynetInnerProduct32fGemm::SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params)
         {
             Simd::SynetInnerProduct32f::SetParams(weight, internal, bias, params);
+            if (_sparseGemm && _sparse.Init(weight, _param.transpose))
+            {
+                _cbWeight.Resize(0);
+                if (internal)
+                    *internal = SimdTrue;
+                return;
+            }
+            _cbWeight.Resize(_cbSize);
             if (_cbWeight.data)
             {
                 Array32f buffer;
@@ -118,7 +132,14 @@ namespace Simd
 
         void SynetInnerProduct32fGemm::Forward(const float * src, float * dst)
         {
-            if (_prod)
+            if (_sparse.Enable())
+            {
+                bool identity = _param.activation == SimdConvolutionActivationIdentity;
+                _sparseGemm(src, _M, _K, _sparse, identity ? _bias : NULL, dst, _N);
+                if (!identity)
+                    _biasAndActivation(_bias, _N, _M, _param.activation, _params, SimdTrue, dst);
+            }
+            else if (_prod)
                 _prod(src, _weight, _bias, _N, _K, dst);
             else
             {
@@ -212,9 +233,16 @@ namespace Simd
 
         void * SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation)
         {
-            InnerProductParam32f param(batch, input, output, transpose, activation);
+            return SynetInnerProduct32fInitV2(batch, input, output, transpose, activation, SimdSynetCompatibilityDefault);
+        }
+
+        void * SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+        {
+            InnerProductParam32f param(batch, input, output, transpose, activation, compatibility);
             if (!param.Valid())
                 return NULL;
+            if (Fp16Soft(compatibility))
+                return new SynetInnerProduct32fFp16(param);
             return new SynetInnerProduct32fGemm(param);
         }
     }
@@ -0,0 +1,108 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetInnerProduct32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdFloat16.h"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace Base
+    {
+        void SynetInnerProduct32fFp16Reorder(const float* src, size_t K, size_t N, SimdBool trans, size_t F, uint16_t* dst)
+        {
+            for (size_t n = 0; n < N; n += F)
+            {
+                size_t size = Simd::Min(N, n + F) - n;
+                for (size_t k = 0; k < K; ++k)
+                {
+                    size_t f = 0;
+                    for (; f < size; ++f)
+                        *(dst++) = Float32ToFloat16(trans ? src[(n + f) * K + k] : src[k * N + n + f]);
+                    for (; f < F; ++f)
+                        *(dst++) = 0;
+                }
+            }
+        }
+
+        void SynetInnerProduct32fFp16Gemm(const float* src, size_t M, size_t K, const uint16_t* weight, size_t N, const float* bias, float* dst)
+        {
+            const size_t F = 16;
+            float buf[F];
+            for (size_t n = 0; n < N; n += F)
+            {
+                size_t size = Simd::Min(N, n + F) - n;
+                for (size_t m = 0; m < M; ++m)
+                {
+                    const float* s = src + m * K;
+                    const uint16_t* w = weight + n * K;
+                    for (size_t f = 0; f < F; ++f)
+                        buf[f] = bias[n + f];
+                    for (size_t k = 0; k < K; ++k, w += F)
+                        for (size_t f = 0; f < F; ++f)
+                            buf[f] += s[k] * Float16ToFloat32(w[f]);
+                    for (size_t f = 0; f < size; ++f)
+                        dst[m * N + n + f] = buf[f];
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+
+        SynetInnerProduct32fFp16::SynetInnerProduct32fFp16(const InnerProductParam32f& p)
+            : SynetInnerProduct32f(p)
+        {
+            _M = p.batch;
+            _N = p.output;
+            _K = p.input;
+            SetSize(16);
+            _gemm = SynetInnerProduct32fFp16Gemm;
+        }
+
+        void SynetInnerProduct32fFp16::SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params)
+        {
+            SynetInnerProduct32f::SetParams(weight, internal, bias, params);
+            SynetInnerProduct32fFp16Reorder(weight, _K, _N, _param.transpose, _F, _rWeight.data);
+            _rBias.Clear();
+            if (bias)
+                memcpy(_rBias.data, bias, _N * sizeof(float));
+            if (internal)
+                *internal = SimdTrue;
+        }
+
+        void SynetInnerProduct32fFp16::Forward(const float* src, float* dst)
+        {
+            _gemm(src, _M, _K, _rWeight.data, _N, _rBias.data, dst);
+        }
+
+        void SynetInnerProduct32fFp16::SetSize(size_t F)
+        {
+            _F = F;
+            _rWeight.Resize(AlignHi(_N, _F) * _K);
+            _rBias.Resize(AlignHi(_N, _F), true);
+        }
+    }
+#endif
+}
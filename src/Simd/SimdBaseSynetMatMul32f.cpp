@@ -0,0 +1,98 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetMatMul32f.h"
+#include "Simd/SimdSynet.h"
+#include "Simd/SimdBFloat16.h"
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace Base
+    {
+        SynetMatMul32f::SynetMatMul32f(const MatMulParam32f& p)
+            : _param(p)
+        {
+            _bf16 = Bf16Soft(p.compatibility);
+            _batchParallel = p.Batch() > 1 && p.M * p.N * p.K < 256 * 256 * 256;
+            _gemm = p.transB ? Base::Gemm32fNT : Base::Gemm32fNN;
+            _round = Base::RoundToBFloat16;
+            if (_bf16)
+            {
+                _bufA.Resize(p.batchA * p.M * p.K);
+                _bufB.Resize(p.batchB * p.K * p.N);
+            }
+        }
+
+        String SynetMatMul32f::Desc() const
+        {
+            return Ext() + (_param.transB ? "::NT" : "::NN") + (_bf16 ? "-bf16" : "");
+        }
+
+        void SynetMatMul32f::Forward(const float* A, const float* B, float* C)
+        {
+            const MatMulParam32f& p = _param;
+            if (_bf16)
+            {
+                _round(A, _bufA.size, _bufA.data);
+                _round(B, _bufB.size, _bufB.data);
+                A = _bufA.data;
+                B = _bufB.data;
+            }
+            const float alpha = 1.0f, beta = 0.0f;
+            size_t ldb = p.transB ? p.K : p.N;
+            if (p.batchB == 1)
+            {
+                _gemm(p.batchA * p.M, p.N, p.K, &alpha, A, p.K, B, ldb, &beta, C, p.N);
+                return;
+            }
+            size_t strideA = p.batchA > 1 ? p.M * p.K : 0, strideB = p.K * p.N, strideC = p.M * p.N;
+            if (_batchParallel)
+            {
+                Simd::Parallel(0, p.Batch(), [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t b = begin; b < end; ++b)
+                        _gemm(p.M, p.N, p.K, &alpha, A + b * strideA, p.K, B + b * strideB, ldb, &beta, C + b * strideC, p.N);
+                }, Base::GetThreadNumber());
+            }
+            else
+            {
+                for (size_t b = 0, n = p.Batch(); b < n; ++b)
+                    _gemm(p.M, p.N, p.K, &alpha, A + b * strideA, p.K, B + b * strideB, ldb, &beta, C + b * strideC, p.N);
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility)
+        {
+            MatMulParam32f param(batchA, batchB, M, N, K, transB, compatibility);
+            if (!param.Valid())
+                return NULL;
+            return new SynetMatMul32f(param);
+        }
+    }
+#endif
+}
@@ -27,6 +27,7 @@
 #include "Simd/SimdUpdate.h"
 #include "Simd/SimdSynet.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -124,6 +125,8 @@ namespace Simd
             _sizeD = end.dstH * end.dstW * end.dstC;
             _sizeB[0] = p.conv[1].srcH * p.conv[1].srcW * p.conv[1].srcC;
             _sizeB[1] = p.count == 3 ? p.conv[1].dstH * p.conv[1].dstW * p.conv[1].dstC : 0;
+            _threads = 1;
+            _L2 = 0;
             for (size_t i = 0; i < p.count; ++i)
             {
                 switch (p.conv[i].activation)
@@ -146,7 +149,7 @@ namespace Simd
 
         size_t SynetMergedConvolution32f::ExternalBufferSize() const
         {
-            return _sizeB[0] + _sizeB[1];
+            return (_sizeB[0] + _sizeB[1]) * _threads;
         }
 
         size_t SynetMergedConvolution32f::InternalBufferSize() const
@@ -262,6 +265,31 @@ namespace Simd
             }
         }
 
+        void SynetMergedConvolution32f::SetThreads(size_t height)
+        {
+            const MergConvParam32f& p = _param;
+            int64_t flop = 0;
+            for (size_t i = 0; i < p.count; ++i)
+            {
+                const SimdConvolutionParameters& c = p.conv[i];
+                flop += int64_t(c.kernelY * c.kernelX * c.srcC / c.group) * c.dstH * c.dstW * c.dstC * 2;
+            }
+            _threads = Simd::Min(SynetThreadNumber(flop), Simd::Max<size_t>(height / 4, 1));
+        }
+
+        bool SynetMergedConvolution32f::SetShape(const MergConvParam32f& p)
+        {
+            _param = p;
+            const SimdConvolutionParameters& beg = p.conv[0];
+            const SimdConvolutionParameters& end = p.conv[p.count - 1];
+            _sizeS = beg.srcH * beg.srcW * beg.srcC;
+            _sizeD = end.dstH * end.dstW * end.dstC;
+            _sizeB[0] = p.conv[1].srcH * p.conv[1].srcW * p.conv[1].srcC;
+            _sizeB[1] = p.count == 3 ? p.conv[1].dstH * p.conv[1].dstW * p.conv[1].dstC : 0;
+            SetSteps();
+            return true;
+        }
+
         //---------------------------------------------------------------------
 
         SynetMergedConvolution32fCdc::SynetMergedConvolution32fCdc(const MergConvParam32f & p)
@@ -278,17 +306,8 @@ namespace Simd
                 size += p.conv[i].kernelY*p.conv[i].kernelX *p.conv[i].srcC * p.conv[i].dstC / p.conv[i].group;
             size_t count = size * sizeof(float) / (L3/2) + 1;
             _maC = AlignHiAny(p.conv[0].dstC / count, 2 * _miC);
-            for (size_t yStep = p.conv[1].dstH; yStep >= 1; yStep--)
-            {
-                _yStep[1] = Simd::Max<size_t>(1, yStep);
-                for (_bufH[1] = 1; _bufH[1] < _yStep[1]; _bufH[1] *= 2);
-                _yStep[0] = _yStep[1] * p.conv[1].strideY;
-                for (_bufH[0] = 1; _bufH[0] < (_yStep[1] - 1) * p.conv[1].strideY + p.conv[1].kernelY; _bufH[0] *= 2);
-                _sizeB[0] = _bufH[0] * p.conv[0].dstW * _maC;
-                _sizeB[1] = _bufH[1] * p.conv[1].dstW * _maC;
-                if ((_sizeB[0] + _sizeB[1]) * sizeof(float) <= L2)
-                    break;
-            }
+            _L2 = L2;
+            SetSteps();
             for (size_t i = 0; i < 3; ++i)
             {
                 size_t dstC = AlignHiAny(p.conv[i].dstC, i == 1 ? _miC : 2 * _miC);
@@ -306,6 +325,23 @@ namespace Simd
             _dw[2] = AlignHiAny(p.conv[2].dstC, 2 * _miC);
         }
 
+        void SynetMergedConvolution32fCdc::SetSteps()
+        {
+            const MergConvParam32f& p = _param;
+            for (size_t yStep = p.conv[1].dstH; yStep >= 1; yStep--)
+            {
+                _yStep[1] = Simd::Max<size_t>(1, yStep);
+                for (_bufH[1] = 1; _bufH[1] < _yStep[1]; _bufH[1] *= 2);
+                _yStep[0] = _yStep[1] * p.conv[1].strideY;
+                for (_bufH[0] = 1; _bufH[0] < (_yStep[1] - 1) * p.conv[1].strideY + KernelH(p.conv[1]); _bufH[0] *= 2);
+                _sizeB[0] = _bufH[0] * p.conv[0].dstW * _maC;
+                _sizeB[1] = _bufH[1] * p.conv[1].dstW * _maC;
+                if ((_sizeB[0] + _sizeB[1]) * sizeof(float) <= _L2)
+                    break;
+            }
+            SetThreads(p.conv[1].dstH);
+        }
+
         void SynetMergedConvolution32fCdc::ReorderFirstWeight(const float * src, float * dst) const
         {
             const SimdConvolutionParameters & p = _param.conv[0];
@@ -376,32 +412,42 @@ namespace Simd
                 return;
             }
             const MergConvParam32f & p = _param;
-            float * buf0 = Buffer(buf);
-            float * buf1 = buf0 + _sizeB[0];
+            const SimdConvolutionParameters& c1 = p.conv[1];
+            size_t step = DivHi(c1.dstH, _threads);
+            buf = Buffer(buf);
             for (size_t b = 0; b < p.conv[0].batch; ++b)
             {
-                for (size_t c = 0, C = p.conv[1].dstC; c < C; c += _maC)
+                Simd::Parallel(0, DivHi(c1.dstH, step), [&](size_t thread, size_t begin, size_t end)
                 {
-                    size_t maC = Simd::Min(C, c + _maC) - c;
-                    for (size_t yBeg1 = 0, yBeg0 = 0; yBeg1 < p.conv[1].dstH;)
+                    float* buf0 = buf + thread * (_sizeB[0] + _sizeB[1]);
+                    float* buf1 = buf0 + _sizeB[0];
+                    for (size_t band = begin; band < end; ++band)
                     {
-                        size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], p.conv[1].dstH);
-                        size_t yEnd0 = Simd::Min(Simd::Max(yBeg0 + _yStep[0], (_yStep[1] - 1)*p.conv[1].strideY + p.conv[1].kernelY - p.conv[1].padY), p.conv[0].dstH);
-                        _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
-                        _convolution[1](buf0, p.conv[1], maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], buf1, 1);
-                        if (p.add && c == 0)
+                        size_t yBeg = band * step, yEnd = Simd::Min(yBeg + step, c1.dstH);
+                        for (size_t c = 0, C = c1.dstC; c < C; c += _maC)
                         {
-                            size_t offset = yBeg1 * p.conv[2].dstW * p.conv[2].dstC, size = (yEnd1 - yBeg1)*p.conv[2].dstW * p.conv[2].dstC;
-                            memcpy(dst + offset, src + offset, sizeof(float)*size);
+                            size_t maC = Simd::Min(C, c + _maC) - c;
+                            for (size_t yBeg1 = yBeg, yBeg0 = Simd::Max(yBeg * c1.strideY, c1.padY) - c1.padY; yBeg1 < yEnd;)
+                            {
+                                size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], yEnd);
+                                size_t yEnd0 = Simd::Min((yEnd1 - 1) * c1.strideY + KernelH(c1) - c1.padY, p.conv[0].dstH);
+                                _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
+                                _convolution[1](buf0, c1, maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], buf1, 1);
+                                if (p.add && c == 0)
+                                {
+                                    size_t offset = yBeg1 * p.conv[2].dstW * p.conv[2].dstC, size = (yEnd1 - yBeg1) * p.conv[2].dstW * p.conv[2].dstC;
+                                    memcpy(dst + offset, src + offset, sizeof(float) * size);
+                                }
+                                if (c + maC == C)
+                                    _convolution[2](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (maC != C || p.add) ? 0 : 1);
+                                else
+                                    _convolution[3](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (c != 0 || p.add) ? 0 : 1);
+                                yBeg1 = yEnd1;
+                                yBeg0 = yEnd0;
+                            }
                         }
-                        if(c + maC == C)
-                            _convolution[2](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (maC != C || p.add) ? 0 : 1);
-                        else
-                            _convolution[3](buf1, p.conv[2], maC, yBeg1, yEnd1, _bufH, _weight[2] + c * _dw[2], _bias[2], _params[2], dst, (c != 0 || p.add) ? 0 : 1);
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -428,16 +474,8 @@ namespace Simd
                 size += p.conv[i].kernelY * p.conv[i].kernelX * p.conv[i].srcC * p.conv[i].dstC / p.conv[i].group;
             size_t count = size * sizeof(float) / (L3 / 2) + 1;
             _maC = AlignHiAny(p.conv[0].dstC / count, 2 * _miC);
-            for (size_t yStep = p.conv[1].dstH; yStep >= 1; yStep--)
-            {
-                _yStep[1] = Simd::Max<size_t>(1, yStep);
-                _yStep[0] = _yStep[1] * p.conv[1].strideY;
-                for (_bufH[0] = 1; _bufH[0] < (_yStep[1] - 1) * p.conv[1].strideY + p.conv[1].kernelY; _bufH[0] *= 2);
-                _sizeB[0] = _bufH[0] * p.conv[0].dstW * _maC;
-                if (_sizeB[0] * sizeof(float) <= L2)
-                    break;
-            }
-            _sizeB[1] = 0;
+            _L2 = L2;
+            SetSteps();
             for (size_t i = 0; i < 2; ++i)
             {
                 size_t dstC = AlignHiAny(p.conv[i].dstC, i == 1 ? _miC : 2 * _miC);
@@ -454,6 +492,22 @@ namespace Simd
             _dw[1] = p.conv[1].kernelY * p.conv[1].kernelX;
         }
 
+        void SynetMergedConvolution32fCd::SetSteps()
+        {
+            const MergConvParam32f& p = _param;
+            for (size_t yStep = p.conv[1].dstH; yStep >= 1; yStep--)
+            {
+                _yStep[1] = Simd::Max<size_t>(1, yStep);
+                _yStep[0] = _yStep[1] * p.conv[1].strideY;
+                for (_bufH[0] = 1; _bufH[0] < (_yStep[1] - 1) * p.conv[1].strideY + KernelH(p.conv[1]); _bufH[0] *= 2);
+                _sizeB[0] = _bufH[0] * p.conv[0].dstW * _maC;
+                if (_sizeB[0] * sizeof(float) <= _L2)
+                    break;
+            }
+            _sizeB[1] = 0;
+            SetThreads(p.conv[1].dstH);
+        }
+
         void SynetMergedConvolution32fCd::ReorderFirstWeight(const float* src, float* dst) const
         {
             const SimdConvolutionParameters& p = _param.conv[0];
@@ -500,22 +554,32 @@ namespace Simd
                 return;
             }
             const MergConvParam32f& p = _param;
-            float* buf0 = Buffer(buf);
+            const SimdConvolutionParameters& c1 = p.conv[1];
+            size_t step = DivHi(c1.dstH, _threads);
+            buf = Buffer(buf);
             for (size_t b = 0; b < p.conv[0].batch; ++b)
             {
-                for (size_t c = 0, C = p.conv[1].dstC; c < C; c += _maC)
+                Simd::Parallel(0, DivHi(c1.dstH, step), [&](size_t thread, size_t begin, size_t end)
                 {
-                    size_t maC = Simd::Min(C, c + _maC) - c;
-                    for (size_t yBeg1 = 0, yBeg0 = 0; yBeg1 < p.conv[1].dstH;)
+                    float* buf0 = buf + thread * _sizeB[0];
+                    for (size_t band = begin; band < end; ++band)
                     {
-                        size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], p.conv[1].dstH);
-                        size_t yEnd0 = Simd::Min(Simd::Max(yBeg0 + _yStep[0], (_yStep[1] - 1) * p.conv[1].strideY + p.conv[1].kernelY - p.conv[1].padY), p.conv[0].dstH);
-                        _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
-                        _convolution[1](buf0, p.conv[1], maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], dst + c, 1);
-                        yBeg1 = yEnd1;
-                        yBeg0 = yEnd0;
+                        size_t yBeg = band * step, yEnd = Simd::Min(yBeg + step, c1.dstH);
+                        for (size_t c = 0, C = c1.dstC; c < C; c += _maC)
+                        {
+                            size_t maC = Simd::Min(C, c + _maC) - c;
+                            for (size_t yBeg1 = yBeg, yBeg0 = Simd::Max(yBeg * c1.strideY, c1.padY) - c1.padY; yBeg1 < yEnd;)
+                            {
+                                size_t yEnd1 = Simd::Min(yBeg1 + _yStep[1], yEnd);
+                                size_t yEnd0 = Simd::Min((yEnd1 - 1) * c1.strideY + KernelH(c1) - c1.padY, p.conv[0].dstH);
+                                _convolution[0](src, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
+                                _convolution[1](buf0, c1, maC, yBeg1, yEnd1, _bufH, _weight[1] + c * _dw[1], _bias[1] + c, _params[1] + c * _dp[1], dst + c, 1);
+                                yBeg1 = yEnd1;
+                                yBeg0 = yEnd0;
+                            }
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
@@ -542,16 +606,8 @@ namespace Simd
                 size += p.conv[i].kernelY * p.conv[i].kernelX * p.conv[i].srcC * p.conv[i].dstC / p.conv[i].group;
             size_t count = size * sizeof(float) / (L3 / 2) + 1;
             _maC = AlignHiAny(p.conv[0].dstC / count, 2 * _miC);
-            for (size_t yStep = p.conv[0].dstH; yStep >= 1; yStep--)
-            {
-                _yStep[0] = Simd::Max<size_t>(1, yStep);
-                for (_bufH[0] = 1; _bufH[0] < _yStep[0]; _bufH[0] *= 2);
-                _sizeB[0] = _bufH[0] * p.conv[0].dstW * _maC;
-                if (_sizeB[0]* sizeof(float) <= L2)
-                    break;
-            }
-            _bufH[1] = _bufH[0];
-            _sizeB[1] = 0;
+            _L2 = L2;
+            SetSteps();
             for (size_t i = 0; i < 2; ++i)
             {
                 size_t dstC = AlignHiAny(p.conv[i].dstC, i == 0 ? _miC : 2 * _miC);
@@ -567,6 +623,22 @@ namespace Simd
             _dw[1] = AlignHiAny(p.conv[1].dstC, 2 * _miC);
         }
 
+        void SynetMergedConvolution32fDc::SetSteps()
+        {
+            const MergConvParam32f& p = _param;
+            for (size_t yStep = p.conv[0].dstH; yStep >= 1; yStep--)
+            {
+                _yStep[0] = Simd::Max<size_t>(1, yStep);
+                for (_bufH[0] = 1; _bufH[0] < _yStep[0]; _bufH[0] *= 2);
+                _sizeB[0] = _bufH[0] * p.conv[0].dstW * _maC;
+                if (_sizeB[0]* sizeof(float) <= _L2)
+                    break;
+            }
+            _bufH[1] = _bufH[0];
+            _sizeB[1] = 0;
+            SetThreads(p.conv[0].dstH);
+        }
+
         void SynetMergedConvolution32fDc::ReorderFirstWeight(const float* src, float* dst) const
         {
             const SimdConvolutionParameters& p = _param.conv[0];
@@ -618,23 +690,33 @@ namespace Simd
                 return;
             }
             const MergConvParam32f& p = _param;
-            float* buf0 = Buffer(buf);
+            const SimdConvolutionParameters& c0 = p.conv[0];
+            size_t step = DivHi(c0.dstH, _threads);
+            buf = Buffer(buf);
             for (size_t b = 0; b < p.conv[0].batch; ++b)
             {
-                for (size_t c = 0, C = p.conv[0].dstC; c < C; c += _maC)
+                Simd::Parallel(0, DivHi(c0.dstH, step), [&](size_t thread, size_t begin, size_t end)
                 {
-                    size_t maC = Simd::Min(C, c + _maC) - c;
-                    for (size_t yBeg0 = 0; yBeg0 < p.conv[0].dstH;)
+                    float* buf0 = buf + thread * _sizeB[0];
+                    for (size_t band = begin; band < end; ++band)
                     {
-                        size_t yEnd0 = Simd::Min(yBeg0 + _yStep[0], p.conv[0].dstH);
-                        _convolution[0](src + c, p.conv[0], maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
-                        if (c + maC == C)
-                            _convolution[1](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, maC == C ? 1 : 0);
-                        else
-                            _convolution[2](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, c == 0 ? 1 : 0);
-                        yBeg0 = yEnd0;
+                        size_t yBeg = band * step, yEnd = Simd::Min(yBeg + step, c0.dstH);
+                        for (size_t c = 0, C = c0.dstC; c < C; c += _maC)
+                        {
+                            size_t maC = Simd::Min(C, c + _maC) - c;
+                            for (size_t yBeg0 = yBeg; yBeg0 < yEnd;)
+                            {
+                                size_t yEnd0 = Simd::Min(yBeg0 + _yStep[0], yEnd);
+                                _convolution[0](src + c, c0, maC, yBeg0, yEnd0, _bufH, _weight[0] + c * _dw[0], _bias[0] + c, _params[0] + c * _dp[0], buf0, 1);
+                                if (c + maC == C)
+                                    _convolution[1](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, maC == C ? 1 : 0);
+                                else
+                                    _convolution[2](buf0, p.conv[1], maC, yBeg0, yEnd0, _bufH, _weight[1] + c * _dw[1], _bias[1], _params[1], dst, c == 0 ? 1 : 0);
+                                yBeg0 = yEnd0;
+                            }
+                        }
                     }
-                }
+                }, _threads);
                 src += _sizeS;
                 dst += _sizeD;
             }
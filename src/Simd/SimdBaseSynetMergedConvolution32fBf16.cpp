@@ -92,7 +92,7 @@ namespace Simd
         {
             assert(p.group == p.srcC && p.group == p.dstC);
             size_t srcH = p.srcH, srcW = p.srcW, srcC = p.srcC, dstW = p.dstW;
-            size_t kernelY = p.kernelY, kernelX = p.kernelX, strideY = p.strideY, strideX = p.strideX, padY = p.padY, padX = p.padX;
+            size_t kernelY = p.kernelY, kernelX = p.kernelX, dilationY = p.dilationY, dilationX = p.dilationX, strideY = p.strideY, strideX = p.strideX, padY = p.padY, padX = p.padX;
             for (size_t dy = 0; dy < p.dstH; ++dy)
             {
                 for (size_t dx = 0; dx < dstW; ++dx)
@@ -102,12 +102,12 @@ namespace Simd
                         float sum = 0; 
                         for (size_t ky = 0; ky < kernelY; ++ky)
                         {
-                            size_t sy = dy * strideY + ky - padY;
+                            size_t sy = dy * strideY + ky * dilationY - padY;
                             if (sy < srcH)
                             {
                                 for (size_t kx = 0; kx < kernelX; ++kx)
                                 {
-                                    size_t sx = dx * strideX + kx - padX;
+                                    size_t sx = dx * strideX + kx * dilationX - padX;
                                     if (sx < srcW)
                                     {
                                         const float* pw = weight + (ky * kernelX + kx) * srcC + c;
@@ -531,12 +531,12 @@ namespace Simd
                 a.bufH[2] = Pow2Hi(a.yStep[2]);
 
                 a.yStep[1] = a.yStep[2] * c1.strideY;
-                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + c1.kernelY - c1.padY, c1.srcH);
-                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + c1.kernelY, a.yStart[1]));
+                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + KernelH(c1) - c1.padY, c1.srcH);
+                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + KernelH(c1), a.yStart[1]));
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
-                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0]));
+                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + KernelH(c0) - c0.padY, c0.srcH);
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + KernelH(c0), a.yStart[0]));
 
                 _sizeB[0] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[1] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -626,12 +626,12 @@ namespace Simd
                 a.yStart[2] = a.yStep[2];
 
                 a.yStep[1] = a.yStep[2] * c1.strideY;
-                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + c1.kernelY - c1.padY, c1.srcH);
-                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + c1.kernelY, a.yStart[1]));
+                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + KernelH(c1) - c1.padY, c1.srcH);
+                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + KernelH(c1), a.yStart[1]));
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
-                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0]));
+                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + KernelH(c0) - c0.padY, c0.srcH);
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + KernelH(c0), a.yStart[0]));
 
                 _sizeB[0] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[1] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -721,7 +721,7 @@ namespace Simd
                 a.bufH[2] = Pow2Hi(a.yStep[2]);
 
                 a.yStep[1] = a.yStep[2] * c0.strideY;
-                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
+                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c0.strideY + KernelH(c0) - c0.padY, c0.srcH);
 
                 _sizeB[2] = a.bufH[2] * p.conv[1].srcW * a.maC;
                 if (_sizeB[2] * 2 <= L2)
@@ -572,12 +572,12 @@ namespace Simd
                 a.bufH[2] = Pow2Hi(a.yStep[2]);
 
                 a.yStep[1] = a.yStep[2] * c1.strideY;
-                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + c1.kernelY - c1.padY, c1.srcH);
-                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + c1.kernelY, a.yStart[1]));
+                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + c1.KernelH() - c1.padY, c1.srcH);
+                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + c1.KernelH(), a.yStart[1]));
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
-                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0])) * (_s8u ? 0 : 1);
+                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.KernelH() - c0.padY, c0.srcH);
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.KernelH(), a.yStart[0])) * (_s8u ? 0 : 1);
 
                 _sizeB[2] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[0] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -667,12 +667,12 @@ namespace Simd
                 a.bufH[2] = Pow2Hi(a.yStep[2]);
 
                 a.yStep[1] = a.yStep[2] * c1.strideY;
-                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + c1.kernelY - c1.padY, c1.srcH);
-                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + c1.kernelY, a.yStart[1]));
+                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c1.strideY + c1.KernelH() - c1.padY, c1.srcH);
+                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c1.strideY + c1.KernelH(), a.yStart[1]));
 
                 a.yStep[0] = a.yStep[1] * c0.strideY;
-                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.kernelY, a.yStart[0])) * (_s8u ? 0 : 1);
+                a.yStart[0] = Simd::Min((a.yStart[1] - 1) * c0.strideY + c0.KernelH() - c0.padY, c0.srcH);
+                a.bufH[0] = Pow2Hi(Simd::Max((a.yStep[1] - 1) * c0.strideY + c0.KernelH(), a.yStart[0])) * (_s8u ? 0 : 1);
 
                 _sizeB[2] = a.bufH[0] * p.conv[0].srcW * p.conv[0].srcC;
                 _sizeB[0] = a.bufH[1] * p.conv[1].srcW * a.maC;
@@ -766,8 +766,8 @@ namespace Simd
                 a.bufH[2] = Pow2Hi(a.yStep[2]);
 
                 a.yStep[1] = a.yStep[2] * c0.strideY;
-                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c0.strideY + c0.kernelY - c0.padY, c0.srcH);
-                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c0.strideY + c0.kernelY, a.yStart[1])) * (_s8u ? 1 : 0);
+                a.yStart[1] = Simd::Min((a.yStart[2] - 1) * c0.strideY + c0.KernelH() - c0.padY, c0.srcH);
+                a.bufH[1] = Pow2Hi(Simd::Max((a.yStep[2] - 1) * c0.strideY + c0.KernelH(), a.yStart[1])) * (_s8u ? 1 : 0);
 
                 _sizeB[0] = a.bufH[1] * p.conv[0].srcW * a.maC;
                 _sizeB[2] = a.bufH[2] * p.conv[1].srcW * a.maC;
@@ -286,6 +286,50 @@ namespace Simd
             else
                 assert(0);
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE void LayerNorm32f(const float* src, size_t size, const float* scale, const float* shift, float k, float eps, float* dst)
+        {
+            float sum = 0;
+            for (size_t i = 0; i < size; ++i)
+                sum += src[i];
+            float mean = sum * k;
+            float sqsum = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                dst[i] = src[i] - mean;
+                sqsum += Simd::Square(dst[i]);
+            }
+            float norm = 1.0f / ::sqrt(sqsum * k + eps);
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = dst[i] * norm * scale[i] + shift[i];
+        }
+
+        void SynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst)
+        {
+            float k = 1.0f / float(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                LayerNorm32f(src, size, scale, shift, k, *eps, dst);
+                src += size;
+                dst += size;
+            }
+        }
+
+        void SynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst)
+        {
+            float k = 1.0f / float(size);
+            Array32f buf(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                BFloat16ToFloat32(src, size, buf.data);
+                LayerNorm32f(buf.data, size, scale, shift, k, *eps, buf.data);
+                Float32ToBFloat16(buf.data, size, dst);
+                src += size;
+                dst += size;
+            }
+        }
     }
 #endif
 }
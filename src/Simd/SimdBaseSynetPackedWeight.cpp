@@ -0,0 +1,196 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetPackedWeight.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdFileMapping.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace Simd
+{
+    const uint8_t PACKED_WEIGHT_MAGIC[8] = { 'S', 'i', 'm', 'd', 'P', 'W', 0, 1 };
+    const size_t PACKED_WEIGHT_ALIGN = 64;
+    // Must be increased after any change of the internal weight layout of packed Synet layers.
+    const int PACKED_WEIGHT_LAYOUT = 1;
+
+    struct SynetPackedWeight::Storage
+    {
+        String key;
+        Sections sections;
+        const uint8_t* data;
+        uint8_t* owned;
+        FileMapping file;
+
+        Storage()
+            : data(NULL)
+            , owned(NULL)
+        {
+        }
+
+        ~Storage()
+        {
+            if (owned)
+                Free(owned);
+        }
+
+        size_t Size() const
+        {
+            return sections.empty() ? 0 : sections.back().offset + sections.back().size;
+        }
+
+        bool Parse(const uint8_t* src, size_t size)
+        {
+            const uint8_t* end = src + size;
+            uint64_t value;
+            if (size < sizeof(PACKED_WEIGHT_MAGIC) + sizeof(value) || memcmp(src, PACKED_WEIGHT_MAGIC, sizeof(PACKED_WEIGHT_MAGIC)))
+                return false;
+            const uint8_t* ptr = src + sizeof(PACKED_WEIGHT_MAGIC);
+            memcpy(&value, ptr, sizeof(value)), ptr += sizeof(value);
+            if (value > size_t(end - ptr))
+                return false;
+            key.assign((const char*)ptr, (size_t)value), ptr += value;
+            if (size_t(end - ptr) < sizeof(value))
+                return false;
+            memcpy(&value, ptr, sizeof(value)), ptr += sizeof(value);
+            if (value > size_t(end - ptr) / sizeof(value) / 3)
+                return false;
+            sections.resize((size_t)value);
+            for (size_t i = 0; i < sections.size(); ++i)
+            {
+                uint64_t section[3];
+                memcpy(section, ptr, sizeof(section)), ptr += sizeof(section);
+                sections[i].item = (size_t)section[0];
+                sections[i].offset = (size_t)section[1];
+                sections[i].size = (size_t)section[2];
+            }
+            data = src + AlignHi(ptr - src, PACKED_WEIGHT_ALIGN);
+            for (size_t i = 0; i < sections.size(); ++i)
+                if (sections[i].item == 0 || sections[i].size % sections[i].item ||
+                    data > end || sections[i].offset > size_t(end - data) || sections[i].size > size_t(end - data) - sections[i].offset)
+                    return false;
+            return true;
+        }
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    SynetPackedWeight::SynetPackedWeight()
+    {
+    }
+
+    SynetPackedWeight::SynetPackedWeight(const String& key, const Visitor& collected)
+    {
+        StoragePtr storage(new Storage());
+        storage->key = key;
+        storage->sections = collected._sections;
+        size_t size = 0;
+        for (size_t i = 0; i < storage->sections.size(); ++i)
+        {
+            storage->sections[i].offset = size;
+            size += AlignHi(storage->sections[i].size, PACKED_WEIGHT_ALIGN);
+        }
+        storage->owned = (uint8_t*)Allocate(Max<size_t>(size, 1), PACKED_WEIGHT_ALIGN);
+        for (size_t i = 0; i < storage->sections.size(); ++i)
+            if (storage->sections[i].size)
+                memcpy(storage->owned + storage->sections[i].offset, collected._data[i], storage->sections[i].size);
+        storage->data = storage->owned;
+        _storage = storage;
+    }
+
+    const String& SynetPackedWeight::Key() const
+    {
+        static const String empty;
+        return _storage ? _storage->key : empty;
+    }
+
+    size_t SynetPackedWeight::Count() const
+    {
+        return _storage ? _storage->sections.size() : 0;
+    }
+
+    size_t SynetPackedWeight::Size() const
+    {
+        return _storage ? _storage->Size() : 0;
+    }
+
+    const SynetPackedWeight::Section* SynetPackedWeight::At(size_t index) const
+    {
+        return index < Count() ? _storage->sections.data() + index : NULL;
+    }
+
+    const uint8_t* SynetPackedWeight::Data(const Section& section) const
+    {
+        return section.size ? _storage->data + section.offset : NULL;
+    }
+
+    bool SynetPackedWeight::Save(const String& path) const
+    {
+        if (!_storage)
+            return false;
+        std::ofstream ofs(path.c_str(), std::ofstream::binary);
+        if (!ofs.is_open())
+            return false;
+        const Storage& s = *_storage;
+        std::stringstream header;
+        uint64_t value = s.key.size();
+        header.write((const char*)PACKED_WEIGHT_MAGIC, sizeof(PACKED_WEIGHT_MAGIC));
+        header.write((const char*)&value, sizeof(value));
+        header.write(s.key.c_str(), s.key.size());
+        value = s.sections.size();
+        header.write((const char*)&value, sizeof(value));
+        for (size_t i = 0; i < s.sections.size(); ++i)
+        {
+            uint64_t section[3] = { s.sections[i].item, s.sections[i].offset, s.sections[i].size };
+            header.write((const char*)section, sizeof(section));
+        }
+        String buffer = header.str();
+        buffer.resize(AlignHi(buffer.size(), PACKED_WEIGHT_ALIGN), 0);
+        ofs.write(buffer.c_str(), buffer.size());
+        ofs.write((const char*)s.data, s.Size());
+        return (bool)ofs;
+    }
+
+    bool SynetPackedWeight::Load(const String& path)
+    {
+        StoragePtr storage(new Storage());
+        if (!storage->file.Open(path, PACKED_WEIGHT_ALIGN))
+            return false;
+        if (!storage->Parse(storage->file.Data(), storage->file.Size()))
+            return false;
+        _storage = storage;
+        return true;
+    }
+
+    String SynetPackedWeight::Key(const String& desc, const SimdConvolutionParameters& c, size_t batch, SimdSynetCompatibilityType compatibility)
+    {
+        std::stringstream ss;
+        ss << desc << " w" << PACKED_WEIGHT_LAYOUT << " " << batch << "x" << c.srcC << "x" << c.srcH << "x" << c.srcW << "-" << c.srcT << "-" << c.srcF;
+        ss << " " << c.dstC << "x" << c.dstH << "x" << c.dstW << "-" << c.dstT << "-" << c.dstF;
+        ss << " k" << c.kernelY << "x" << c.kernelX << "-d" << c.dilationY << "x" << c.dilationX << "-s" << c.strideY << "x" << c.strideX;
+        ss << "-p" << c.padY << "x" << c.padX << "x" << c.padH << "x" << c.padW << "-g" << c.group << "-a" << c.activation;
+        ss << " c" << compatibility << " L" << Base::AlgCacheL1() << "-" << Base::AlgCacheL2() << "-" << Base::AlgCacheL3();
+        return ss.str();
+    }
+}
@@ -0,0 +1,116 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetSparse32f.h"
+#include "Simd/SimdMath.h"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    bool SynetSparse32f::Init(const float* src, SimdBool trans, float threshold)
+    {
+        size_t T = DivHi(N, F), B = DivHi(K, Kb), count = 0;
+        std::vector<uint8_t> mask(T * B, 0);
+        for (size_t k = 0; k < K; ++k)
+        {
+            for (size_t n = 0; n < N; ++n)
+            {
+                float value = trans ? src[n * K + k] : src[k * N + n];
+                if (value != 0.0f)
+                    mask[n / F * B + k / Kb] = 1;
+            }
+        }
+        for (size_t i = 0; i < mask.size(); ++i)
+            count += mask[i];
+        if (count > size_t(float(T * B) * (1.0f - threshold)))
+        {
+            Release();
+            return false;
+        }
+        offset.Resize(T + 1);
+        index.Resize(count);
+        weight.Resize(count * Kb * F, true);
+        for (size_t t = 0, i = 0; t < T; ++t)
+        {
+            offset[t] = int32_t(i);
+            size_t n0 = t * F, nF = Simd::Min(N, n0 + F);
+            for (size_t b = 0; b < B; ++b)
+            {
+                if (mask[t * B + b] == 0)
+                    continue;
+                size_t k0 = b * Kb, kK = Simd::Min(K, k0 + Kb);
+                float* dst = weight.data + i * Kb * F;
+                for (size_t k = k0; k < kK; ++k, dst += F)
+                    for (size_t n = n0; n < nF; ++n)
+                        dst[n - n0] = trans ? src[n * K + k] : src[k * N + n];
+                index[i++] = int32_t(k0);
+            }
+        }
+        offset[T] = int32_t(count);
+        return true;
+    }
+
+    void SynetSparse32f::Release()
+    {
+        offset.Resize(0);
+        index.Resize(0);
+        weight.Resize(0);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace Base
+    {
+        void SynetSparse32fGemm(const float* src, size_t M, size_t ldS, const SynetSparse32f& weight, const float* bias, float* dst, size_t ldD)
+        {
+            const size_t F = SynetSparse32f::F, Kb = SynetSparse32f::Kb;
+            size_t K = weight.K, N = weight.N;
+            float sum[F];
+            for (size_t m = 0; m < M; ++m)
+            {
+                for (size_t n = 0, t = 0; n < N; n += F, t += 1)
+                {
+                    size_t size = Simd::Min(N - n, F);
+                    for (size_t f = 0; f < F; ++f)
+                        sum[f] = bias && f < size ? bias[n + f] : 0.0f;
+                    for (int32_t b = weight.offset[t], e = weight.offset[t + 1]; b < e; ++b)
+                    {
+                        size_t k = weight.index[b], kK = Simd::Min(K, k + Kb);
+                        const float* w = weight.weight.data + b * Kb * F;
+                        for (; k < kK; ++k, w += F)
+                        {
+                            float s = src[k];
+                            for (size_t f = 0; f < F; ++f)
+                                sum[f] += s * w[f];
+                        }
+                    }
+                    for (size_t f = 0; f < size; ++f)
+                        dst[n + f] = sum[f];
+                }
+                src += ldS;
+                dst += ldD;
+            }
+        }
+    }
+#endif
+}
@@ -41,6 +41,7 @@ namespace Simd
 
             size_t DecodedSize() const { return _size; }
             size_t EncodedSize() const { return _encSize; }
+            size_t Depth() const { return _depth; }
 
             void Encode32f(const float* src, uint8_t* dst) const;
             void Encode16f(const uint16_t* src, uint8_t* dst) const;
@@ -51,6 +52,9 @@ namespace Simd
             virtual void CosineDistancesMxNa(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances) const;
             virtual void CosineDistancesMxNp(size_t M, size_t N, const uint8_t* A, const uint8_t* B, float* distances) const;
 
+            void CosineDistancesTopKa(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, size_t K, float threshold, uint32_t* indices, float* distances) const;
+            void CosineDistancesTopKp(size_t M, size_t N, const uint8_t* A, const uint8_t* B, size_t K, float threshold, uint32_t* indices, float* distances) const;
+
             void VectorNorm(const uint8_t* a, float* norm) const;
 
             typedef void (*Encode32fPtr)(const float* src, float scale, float min, size_t size, int32_t &sum, int32_t& sqsum, uint8_t* dst);
@@ -63,6 +67,8 @@ namespace Simd
             typedef void (*MinMax32fPtr)(const float* src, size_t size, float &min, float &max);
             typedef void (*MinMax16fPtr)(const uint16_t* src, size_t size, float& min, float& max);
 
+            void CosineDistancesTopK(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, const uint8_t* P, size_t K, float threshold, uint32_t* indices, float* distances) const;
+
             MinMax32fPtr _minMax32f;
             MinMax16fPtr _minMax16f;
             Encode32fPtr _encode32f;
@@ -97,12 +103,14 @@ namespace Simd
         protected:
             typedef void (*UnpackNormPtr)(size_t count, const uint8_t* const* src, float* dst, size_t stride);
 
-            void CosineDistancesDirect(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances) const;
+            void CosineDistancesDirect(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances, size_t stride) const;
+
+            void CosineDistancesBits(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances, size_t stride) const;
 
             MacroCosineDistancesDirectPtr _macroCosineDistancesDirect;
             size_t _microMd, _microNd;
 
-            void CosineDistancesUnpack(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances) const;
+            void CosineDistancesUnpack(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances, size_t stride, size_t threads) const;
 
             UnpackNormPtr _unpackNormA, _unpackNormB;
             UnpackDataPtr _unpackDataA, _unpackDataB;
@@ -120,6 +128,7 @@ namespace Simd
 
         Base::DescrInt::CosineDistancePtr GetCosineDistance(size_t depth);
         Sse41::DescrInt::MacroCosineDistancesDirectPtr GetMacroCosineDistancesDirect(size_t depth);
+        Base::DescrInt::CosineDistancePtr GetCosineDistanceBits(size_t depth);
 
         Sse41::DescrInt::UnpackDataPtr GetUnpackData(size_t depth, bool transpose);
         Sse41::DescrInt::MacroCosineDistancesUnpackPtr GetMacroCosineDistancesUnpack(size_t depth);
@@ -149,6 +158,7 @@ namespace Simd
 
         Base::DescrInt::CosineDistancePtr GetCosineDistance(size_t depth);
         Sse41::DescrInt::MacroCosineDistancesDirectPtr GetMacroCosineDistancesDirect(size_t depth);
+        Base::DescrInt::CosineDistancePtr GetCosineDistanceBits(size_t depth);
 
         Sse41::DescrInt::UnpackDataPtr GetUnpackData(size_t depth, bool transpose);
         Sse41::DescrInt::MacroCosineDistancesUnpackPtr GetMacroCosineDistancesUnpack(size_t depth);
@@ -178,6 +188,7 @@ namespace Simd
 
         Base::DescrInt::CosineDistancePtr GetCosineDistance(size_t depth);
         Sse41::DescrInt::MacroCosineDistancesDirectPtr GetMacroCosineDistancesDirect(size_t depth);
+        Base::DescrInt::CosineDistancePtr GetCosineDistanceBits(size_t depth);
 
         Sse41::DescrInt::UnpackDataPtr GetUnpackData(size_t depth, bool transpose);
         Sse41::DescrInt::MacroCosineDistancesUnpackPtr GetMacroCosineDistancesUnpack(size_t depth);
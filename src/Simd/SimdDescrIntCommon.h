@@ -47,11 +47,136 @@ namespace Simd
             float ab = abSum * aScale * bScale + aMean * bShift + bMean * aShift;
             distance[0] = Simd::RestrictRange(1.0f - ab / (aNorm * bNorm), 0.0f, 2.0f);
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE uint32_t Popcount64(uint64_t value)
+        {
+            value = value - ((value >> 1) & 0x5555555555555555ULL);
+            value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+            value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return uint32_t((value * 0x0101010101010101ULL) >> 56);
+        }
+
+        SIMD_INLINE uint32_t PopcountAnd(const uint8_t* a, const uint8_t* b, size_t size)
+        {
+            size_t size8 = AlignLo(size, 8), i = 0;
+            uint32_t sum = 0;
+            for (; i < size8; i += 8)
+            {
+                uint64_t va, vb;
+                memcpy(&va, a + i, 8);
+                memcpy(&vb, b + i, 8);
+                sum += Popcount64(va & vb);
+            }
+            for (; i < size; ++i)
+                sum += Popcount64(a[i] & b[i]);
+            return sum;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE bool TopKWorse(float d0, uint32_t i0, float d1, uint32_t i1)
+        {
+            return d0 > d1 || (d0 == d1 && i0 > i1);
+        }
+
+        struct TopKHeap
+        {
+            float* dist;
+            uint32_t* index;
+            size_t size, capacity;
+
+            SIMD_INLINE TopKHeap(float* d, uint32_t* i, size_t s, size_t c) : dist(d), index(i), size(s), capacity(c) {}
+
+            SIMD_INLINE float Bound(float threshold) const
+            {
+                return size < capacity ? threshold : dist[0];
+            }
+
+            void Push(float d, uint32_t i)
+            {
+                size_t pos = size;
+                if (size < capacity)
+                {
+                    size++;
+                    while (pos)
+                    {
+                        size_t parent = (pos - 1) / 2;
+                        if (!TopKWorse(d, i, dist[parent], index[parent]))
+                            break;
+                        dist[pos] = dist[parent], index[pos] = index[parent];
+                        pos = parent;
+                    }
+                }
+                else
+                {
+                    if (!TopKWorse(dist[0], index[0], d, i))
+                        return;
+                    pos = SiftDown(0, size, d, i);
+                }
+                dist[pos] = d, index[pos] = i;
+            }
+
+            SIMD_INLINE size_t SiftDown(size_t pos, size_t end, float d, uint32_t i)
+            {
+                for (size_t child = 2 * pos + 1; child < end; child = 2 * pos + 1)
+                {
+                    if (child + 1 < end && TopKWorse(dist[child + 1], index[child + 1], dist[child], index[child]))
+                        child++;
+                    if (!TopKWorse(dist[child], index[child], d, i))
+                        break;
+                    dist[pos] = dist[child], index[pos] = index[child];
+                    pos = child;
+                }
+                return pos;
+            }
+
+            void Sort()
+            {
+                for (size_t end = size; end > 1;)
+                {
+                    end--;
+                    float d = dist[end];
+                    uint32_t i = index[end];
+                    dist[end] = dist[0], index[end] = index[0];
+                    size_t pos = SiftDown(0, end, d, i);
+                    dist[pos] = d, index[pos] = i;
+                }
+            }
+
+            SIMD_INLINE void Finalize()
+            {
+                Sort();
+                for (size_t k = size; k < capacity; ++k)
+                    dist[k] = FLT_MAX, index[k] = UINT32_MAX;
+            }
+        };
     }
 
 #ifdef SIMD_SSE41_ENABLE
     namespace Sse41
     {
+        SIMD_INLINE uint32_t PopcountAnd(const uint8_t* a, const uint8_t* b, size_t size)
+        {
+            size_t size8 = AlignLo(size, 8), i = 0;
+            uint32_t sum = 0;
+            for (; i < size8; i += 8)
+            {
+#ifdef SIMD_X64_ENABLE
+                sum += (uint32_t)_mm_popcnt_u64(*(uint64_t*)(a + i) & *(uint64_t*)(b + i));
+#else
+                sum += _mm_popcnt_u32(*(uint32_t*)(a + i + 0) & *(uint32_t*)(b + i + 0));
+                sum += _mm_popcnt_u32(*(uint32_t*)(a + i + 4) & *(uint32_t*)(b + i + 4));
+#endif
+            }
+            for (; i < size; ++i)
+                sum += _mm_popcnt_u32(a[i] & b[i]);
+            return sum;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
         const __m128i E4_MULLO = SIMD_MM_SETR_EPI16(4096, 1, 4096, 1, 4096, 1, 4096, 1);
 
         const __m128i E5_MULLO = SIMD_MM_SETR_EPI16(256, 32, 4, 128, 16, 2, 64, 8);
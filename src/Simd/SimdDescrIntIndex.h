@@ -0,0 +1,92 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdDescrIntIndex_h__
+#define __SimdDescrIntIndex_h__
+
+#include "Simd/SimdDescrInt.h"
+#include "Simd/SimdArray.h"
+#include "Simd/SimdFileMapping.h"
+
+#include <vector>
+#include <memory>
+
+namespace Simd
+{
+    namespace Base
+    {
+        /*! Inverted file index over integer descriptors. 
+            Coarse quantizer (spherical k-means) is trained on 32-bit float descriptors. 
+            Every inverted list stores encoded descriptors and their identifiers contiguously. 
+        */
+        class DescrIntIndex : public Deletable
+        {
+        public:
+            DescrIntIndex(DescrInt* descrInt, size_t lists);
+            virtual ~DescrIntIndex();
+
+            size_t Lists() const { return _lists; }
+            size_t Size() const;
+            bool Trained() const { return _trained; }
+
+            bool Train(size_t count, const float* data, size_t iterations);
+            bool Add(size_t count, const float* data, const uint32_t* ids);
+            size_t Remove(size_t count, const uint32_t* ids);
+            void Search(size_t M, const float* queries, size_t nprobe, size_t K, float threshold, uint32_t* ids, float* distances) const;
+
+            bool Save(const String& path) const;
+            bool Load(const String& path);
+
+        private:
+            struct List
+            {
+                const uint8_t* codes;
+                const uint32_t* ids;
+                size_t size;
+                std::vector<uint8_t> ownCodes;
+                std::vector<uint32_t> ownIds;
+
+                List() : codes(NULL), ids(NULL), size(0) {}
+
+                void Own(size_t encSize);
+            };
+
+            bool Write(const String& path) const;
+            void Normalize(const float* src, float* dst) const;
+            void Nearest(const float* normalized, size_t count, uint32_t* lists) const;
+
+            DescrInt* _descrInt;
+            size_t _size, _encSize, _lists;
+            bool _trained;
+            Array32f _centroids;
+            std::vector<List> _data;
+            std::unique_ptr<FileMapping> _file;
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* DescrIntIndexInit(void* descrInt, size_t lists);
+    }
+}
+
+#endif//__SimdDescrIntIndex_h__
@@ -285,16 +285,21 @@ namespace Simd
             \param [in] roi - a 8-bit image mask which defines Region Of Interest. User can restricts detection region with using this mask.
                               The mask affects to the center of detected object.
             \param [in] threadNumber - a number of work threads. It useful for multi core CPU. Use value -1 to auto choose of thread number.
+            \param [in] parallelLevels - a flag of concurrent processing of scaled images. If it is true then scaled images and their integrals 
+                                         are estimated in parallel, and detection work of all scaled images is split into row bands of similar cost, 
+                                         which are processed together by work threads. Otherwise scaled images are processed one by one and 
+                                         only rows of large images are processed in parallel. The result of detection does not depend on this flag.
             \return a result of this operation.
         */
         bool Init(const Size & imageSize, double scaleFactor = 1.1, const Size & sizeMin = Size(0, 0),
-            const Size & sizeMax = Size(INT_MAX, INT_MAX), const View & roi = View(), ptrdiff_t threadNumber = -1)
+            const Size & sizeMax = Size(INT_MAX, INT_MAX), const View & roi = View(), ptrdiff_t threadNumber = -1, bool parallelLevels = false)
         {
             if (_data.empty())
                 return false;
             _imageSize = imageSize;
             ptrdiff_t threadNumberMax = std::thread::hardware_concurrency();
             _threadNumber = (threadNumber <= 0 || threadNumber > threadNumberMax) ? threadNumberMax : threadNumber;
+            _parallelLevels = parallelLevels;
             return InitLevels(scaleFactor, sizeMin, sizeMax, roi);
         }
 
@@ -320,31 +325,11 @@ namespace Simd
 
             FillLevels(src);
 
-            typedef std::map<Tag, Objects> Candidates;
             Candidates candidates;
-
-            for (size_t i = 0; i < _levels.size(); ++i)
-            {
-                Level & level = *_levels[i];
-                View mask = level.roi;
-                Rect rect = level.rect;
-                if (motionMask)
-                {
-                    FillMotionMask(motionRegions, level, rect);
-                    mask = level.mask;
-                }
-                if (rect.Empty())
-                    continue;
-                for (size_t j = 0; j < level.hids.size(); ++j)
-                {
-                    Hid & hid = level.hids[j];
-
-                    hid.Detect(mask, rect, level.dst, _threadNumber, level.throughColumn);
-
-                    AddObjects(candidates[hid.data->tag], level.dst, rect, hid.data->size, level.scale,
-                        level.throughColumn ? 2 : 1, hid.data->tag);
-                }
-            }
+            if (_parallelLevels)
+                DetectLevelsParallel(candidates, motionMask, motionRegions);
+            else
+                DetectLevels(candidates, motionMask, motionRegions);
 
             objects.clear();
             for (typename Candidates::iterator it = candidates.begin(); it != candidates.end(); ++it)
@@ -356,6 +341,7 @@ namespace Simd
     private:
 
         typedef void * Handle;
+        typedef std::map<Tag, Objects> Candidates;
 
         struct Data
         {
@@ -381,22 +367,37 @@ namespace Simd
             Handle handle;
             Data * data;
             DetectPtr detect;
+            View dst;
 
-            void Detect(const View & mask, const Rect & rect, View & dst, size_t threadNumber, bool throughColumn)
+            Rect Region(const Rect & rect) const
             {
-                SIMD_CHECK_PERFORMANCE();
+                return rect.Shifted(-data->size / 2).Intersection(Rect(dst.Size() - data->size));
+            }
 
-                Size s = dst.Size() - data->size;
-                View m = mask.Region(s, View::MiddleCenter);
-                Rect r = rect.Shifted(-data->size / 2).Intersection(Rect(s));
+            void Prepare()
+            {
                 Simd::Fill(dst, 0);
                 ::SimdDetectionPrepare(handle);
+            }
+
+            void Detect(const View & mask, const Rect & rect, size_t threadNumber, bool throughColumn)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                Rect r = Region(rect);
+                Prepare();
 
                 Parallel(r.top, r.bottom, [&](size_t thread, size_t begin, size_t end)
                 {
-                    detect(handle, m.data, m.stride, r.left, begin, r.right, end, dst.data, dst.stride);
+                    Detect(mask, Rect(r.left, ptrdiff_t(begin), r.right, ptrdiff_t(end)));
                 }, rect.Area() >= (data->Haar() ? 10000 : 30000) ? threadNumber : 1, throughColumn ? 2 : 1);
             }
+
+            void Detect(const View & mask, const Rect & region)
+            {
+                View m = mask.Region(dst.Size() - data->size, View::MiddleCenter);
+                detect(handle, m.data, m.stride, region.left, region.top, region.right, region.bottom, dst.data, dst.stride);
+            }
         };
         typedef std::vector<Hid> Hids;
 
@@ -415,8 +416,6 @@ namespace Simd
             View sqsum;
             View tilted;
 
-            View dst;
-
             bool throughColumn;
             bool needSqsum;
             bool needTilted;
@@ -434,6 +433,7 @@ namespace Simd
         Size _imageSize;
         bool _needNormalization;
         ptrdiff_t _threadNumber;
+        bool _parallelLevels;
         LevelPtrs _levels;
 
         bool InitLevels(double scaleFactor, const Size & sizeMin, const Size & sizeMax, const View & roi)
@@ -477,8 +477,6 @@ namespace Simd
                     level.sqsum.Recreate(scaledSize + Size(1, 1), View::Int32);
                     level.tilted.Recreate(scaledSize + Size(1, 1), View::Int32);
 
-                    level.dst.Recreate(scaledSize, View::Gray8);
-
                     level.needSqsum = false, level.needTilted = false;
                     for (size_t i = 0; i < _data.size(); ++i)
                     {
@@ -508,6 +506,8 @@ namespace Simd
                         level.needTilted = level.needTilted | _data[i].Tilted();
                         _needNormalization = _needNormalization | _data[i].Haar();
                     }
+                    for (size_t i = 0; i < level.hids.size(); ++i)
+                        level.hids[i].dst.Recreate(scaledSize, View::Gray8);
 
                     level.rect = Rect(level.roi.Size());
                     if (roi.format == View::None)
@@ -537,12 +537,17 @@ namespace Simd
             Simd::ResizeBilinear(src, _levels[0]->src);
             if (_needNormalization)
                 Simd::NormalizeHistogram(_levels[0]->src, _levels[0]->src);
-            EstimateIntegral(*_levels[0]);
-            for (size_t i = 1; i < _levels.size(); ++i)
-            {
-                Simd::ResizeBilinear(_levels[0]->src, _levels[i]->src);
-                EstimateIntegral(*_levels[i]);
-            }
+            if (_parallelLevels)
+                return;
+            for (size_t i = 0; i < _levels.size(); ++i)
+                FillLevel(i);
+        }
+
+        void FillLevel(size_t index)
+        {
+            if (index)
+                Simd::ResizeBilinear(_levels[0]->src, _levels[index]->src);
+            EstimateIntegral(*_levels[index]);
         }
 
         void EstimateIntegral(Level & level)
@@ -558,6 +563,114 @@ namespace Simd
                 Simd::Integral(level.src, level.sum);
         }
 
+        void DetectLevels(Candidates & candidates, bool motionMask, const Rects & motionRegions)
+        {
+            for (size_t i = 0; i < _levels.size(); ++i)
+            {
+                Level & level = *_levels[i];
+                View mask = level.roi;
+                Rect rect = level.rect;
+                if (motionMask)
+                {
+                    FillMotionMask(motionRegions, level, rect);
+                    mask = level.mask;
+                }
+                if (rect.Empty())
+                    continue;
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                {
+                    Hid & hid = level.hids[j];
+
+                    hid.Detect(mask, rect, _threadNumber, level.throughColumn);
+
+                    AddObjects(candidates[hid.data->tag], hid.dst, rect, hid.data->size, level.scale,
+                        level.throughColumn ? 2 : 1, hid.data->tag);
+                }
+            }
+        }
+
+        struct Band
+        {
+            Level * level;
+            Hid * hid;
+            Rect region;
+        };
+        typedef std::vector<Band> Bands;
+
+        void DetectLevelsParallel(Candidates & candidates, bool motionMask, const Rects & motionRegions)
+        {
+            SIMD_CHECK_PERFORMANCE();
+
+            Rects rects(_levels.size());
+            Parallel(0, _levels.size(), [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    Level & level = *_levels[i];
+                    FillLevel(i);
+                    rects[i] = level.rect;
+                    if (motionMask)
+                        FillMotionMask(motionRegions, level, rects[i]);
+                    if (rects[i].Empty())
+                        continue;
+                    for (size_t j = 0; j < level.hids.size(); ++j)
+                        level.hids[j].Prepare();
+                }
+            }, _threadNumber);
+
+            size_t total = 0;
+            for (size_t i = 0; i < _levels.size(); ++i)
+            {
+                Level & level = *_levels[i];
+                size_t step = level.throughColumn ? 2 : 1;
+                for (size_t j = 0; j < level.hids.size() && !rects[i].Empty(); ++j)
+                    total += level.hids[j].Region(rects[i]).Area() / (step * step);
+            }
+            size_t bandArea = std::max<size_t>(total / (_threadNumber * 4), 1);
+
+            Bands bands;
+            for (size_t i = 0; i < _levels.size(); ++i)
+            {
+                Level & level = *_levels[i];
+                ptrdiff_t step = level.throughColumn ? 2 : 1;
+                for (size_t j = 0; j < level.hids.size() && !rects[i].Empty(); ++j)
+                {
+                    Rect r = level.hids[j].Region(rects[i]);
+                    if (r.Empty())
+                        continue;
+                    size_t rows = (r.Height() + step - 1) / step, cols = (r.Width() + step - 1) / step;
+                    size_t count = std::min(std::max<size_t>(rows * cols / bandArea, 1), rows);
+                    for (size_t b = 0; b < count; ++b)
+                    {
+                        Band band = { &level, &level.hids[j], r };
+                        band.region.top = r.top + ptrdiff_t(rows * b / count) * step;
+                        band.region.bottom = std::min(r.top + ptrdiff_t(rows * (b + 1) / count) * step, r.bottom);
+                        bands.push_back(band);
+                    }
+                }
+            }
+
+            Parallel(0, bands.size(), [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const Band & band = bands[i];
+                    band.hid->Detect(motionMask ? band.level->mask : band.level->roi, band.region);
+                }
+            }, _threadNumber);
+
+            for (size_t i = 0; i < _levels.size(); ++i)
+            {
+                Level & level = *_levels[i];
+                for (size_t j = 0; j < level.hids.size() && !rects[i].Empty(); ++j)
+                {
+                    Hid & hid = level.hids[j];
+                    AddObjects(candidates[hid.data->tag], hid.dst, rects[i], hid.data->size, level.scale,
+                        level.throughColumn ? 2 : 1, hid.data->tag);
+                }
+            }
+        }
+
         void FillMotionMask(const Rects & rects, Level & level, Rect & rect) const
         {
             Simd::Fill(level.mask, 0);
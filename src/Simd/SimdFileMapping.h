@@ -0,0 +1,161 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdFileMapping_h__
+#define __SimdFileMapping_h__
+
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdPerformance.h"
+
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__GNUC__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define SIMD_FILE_MAPPING_MMAP
+#endif
+
+namespace Simd
+{
+    /*! Read-only view of whole file. The file is mapped in memory if it is possible, otherwise it is read in aligned buffer. */
+    class FileMapping
+    {
+    public:
+        SIMD_INLINE FileMapping()
+            : _data(NULL)
+            , _size(0)
+            , _map(NULL)
+            , _owned(NULL)
+        {
+        }
+
+        SIMD_INLINE ~FileMapping()
+        {
+            Close();
+        }
+
+        bool Open(const String& path, size_t align = SIMD_ALIGN)
+        {
+            Close();
+#if defined(_WIN32)
+            HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER fileSize;
+            if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+            {
+                HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping)
+                {
+                    _map = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    _size = (size_t)fileSize.QuadPart;
+                    ::CloseHandle(mapping);
+                }
+            }
+            ::CloseHandle(file);
+            if (_map == NULL)
+                return false;
+            _data = (const uint8_t*)_map;
+#elif defined(SIMD_FILE_MAPPING_MMAP)
+            int file = ::open(path.c_str(), O_RDONLY);
+            if (file == -1)
+                return false;
+            struct stat info;
+            if (::fstat(file, &info) == 0 && info.st_size > 0)
+            {
+                void* map = ::mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+                if (map != MAP_FAILED)
+                {
+                    _map = map;
+                    _size = (size_t)info.st_size;
+                }
+            }
+            ::close(file);
+            if (_map == NULL)
+                return false;
+            _data = (const uint8_t*)_map;
+#else
+            std::ifstream ifs(path.c_str(), std::ifstream::binary);
+            if (!ifs.is_open())
+                return false;
+            ifs.seekg(0, std::ios::end);
+            size_t size = (size_t)ifs.tellg();
+            ifs.seekg(0, std::ios::beg);
+            _owned = (uint8_t*)Allocate(Max<size_t>(size, 1), align);
+            if (!ifs.read((char*)_owned, size))
+            {
+                Close();
+                return false;
+            }
+            _data = _owned;
+            _size = size;
+#endif
+            return true;
+        }
+
+        void Close()
+        {
+            if (_owned)
+                Free(_owned);
+#if defined(_WIN32)
+            if (_map)
+                ::UnmapViewOfFile(_map);
+#elif defined(SIMD_FILE_MAPPING_MMAP)
+            if (_map)
+                ::munmap(_map, _size);
+#endif
+            _data = NULL;
+            _size = 0;
+            _map = NULL;
+            _owned = NULL;
+        }
+
+        SIMD_INLINE const uint8_t* Data() const
+        {
+            return _data;
+        }
+
+        SIMD_INLINE size_t Size() const
+        {
+            return _size;
+        }
+
+    private:
+        FileMapping(const FileMapping&);
+        FileMapping& operator=(const FileMapping&);
+
+        const uint8_t* _data;
+        size_t _size;
+        void* _map;
+        uint8_t* _owned;
+    };
+}
+
+#endif//__SimdFileMapping_h__
@@ -46,8 +46,9 @@ namespace Simd
         size_t size;
         SimdImageFileType file;
         SimdPixelFormatType format;
+        size_t scale;
 
-        ImageLoaderParam(const uint8_t* d, size_t s, SimdPixelFormatType f);
+        ImageLoaderParam(const uint8_t* d, size_t s, SimdPixelFormatType f, size_t sc = 1);
 
         bool Validate();
     };
@@ -60,11 +61,21 @@ namespace Simd
         ImageLoaderParam _param;
         InputMemoryStream _stream;
         Image _image;
+        bool _external;
+
+        SIMD_INLINE bool InitImage(size_t width, size_t height)
+        {
+            if (_external)
+                return _image.width == width && _image.height == height;
+            _image.Recreate(width, height, (Image::Format)_param.format);
+            return true;
+        }
         
     public:
         ImageLoader(const ImageLoaderParam& param)
             : _param(param)
             , _stream(_param.data, _param.size)
+            , _external(false)
         {
         }
 
@@ -74,6 +85,28 @@ namespace Simd
 
         virtual bool FromStream() = 0;
 
+        virtual bool Feed(const uint8_t* data, size_t size)
+        {
+            return false;
+        }
+
+        virtual bool Info(size_t* width, size_t* height, SimdPixelFormatType* format) const
+        {
+            return false;
+        }
+
+        virtual size_t Pull(uint8_t* dst, size_t stride, size_t rows)
+        {
+            return 0;
+        }
+
+        SIMD_INLINE bool FromStreamInto(uint8_t* dst, size_t stride, size_t width, size_t height)
+        {
+            _image = Image(width, height, stride, (Image::Format)_param.format, dst);
+            _external = true;
+            return FromStream();
+        }
+
         SIMD_INLINE uint8_t* Release(size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
         {
             *stride = _image.stride;
@@ -84,6 +117,28 @@ namespace Simd
         }
     };
 
+    typedef ImageLoader* (*CreateImageLoaderPtr)(const ImageLoaderParam& param);
+
+    //-------------------------------------------------------------------------
+
+    class ImageDecoder : public Deletable
+    {
+    public:
+        ImageDecoder(SimdPixelFormatType format, CreateImageLoaderPtr create);
+        virtual ~ImageDecoder();
+
+        bool Feed(const uint8_t* data, size_t size);
+        bool Info(size_t* width, size_t* height, SimdPixelFormatType* format) const;
+        size_t Pull(uint8_t* dst, size_t stride, size_t rows);
+
+    private:
+        SimdPixelFormatType _format;
+        CreateImageLoaderPtr _create;
+        std::vector<uint8_t> _head;
+        ImageLoader* _loader;
+        bool _error;
+    };
+
     namespace Base
     {
         class ImagePxmLoader : public ImageLoader
@@ -151,9 +206,14 @@ namespace Simd
         {
         public:
             ImagePngLoader(const ImageLoaderParam& param);
+            virtual ~ImagePngLoader();
 
             virtual bool FromStream();
 
+            virtual bool Feed(const uint8_t* data, size_t size);
+            virtual bool Info(size_t* width, size_t* height, SimdPixelFormatType* format) const;
+            virtual size_t Pull(uint8_t* dst, size_t stride, size_t rows);
+
             typedef void (*DecodeLinePtr)(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
             typedef void (*ExpandPalettePtr)(const uint8_t* src, size_t size, int outN, const uint8_t* palette, uint8_t* dst);
             typedef void (*ConverterPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
@@ -165,11 +225,13 @@ namespace Simd
             ConverterPtr _converter;
             virtual void SetConverter();
 
+            uint32_t _width, _height, _channels, _outN;
+            uint8_t _depth, _color, _interlace, _paletteChannels, _tc[3];
+
         private:
             bool _first, _hasTrans, _iPhone;
-            uint32_t _width, _height, _channels, _outN;
             uint16_t _tc16[3];
-            uint8_t _depth, _color, _interlace, _paletteChannels, _tc[3];
+            uint32_t _paletteSize;
             Array8u _palette, _idat, _buffer;
 
             struct Chunk
@@ -181,7 +243,11 @@ namespace Simd
             typedef std::vector<Chunk> Chunks;
             Chunks _idats;
 
+            struct Decoder;
+            Decoder* _decoder;
+
             bool ParseFile();
+            void SetOutputChannels();
             bool CheckHeader();
             bool ReadChunk(Chunk& chunk);
             bool ReadHeader(const Chunk & chunk);
@@ -191,21 +257,37 @@ namespace Simd
             InputMemoryStream MergedDataStream();
             bool CreateImage(const uint8_t* data, size_t size);
             bool CreateImageRaw(const uint8_t* data, uint32_t size, uint32_t width, uint32_t height);
+            void UnpackRow(const uint8_t* src, uint32_t width, uint8_t* dst);
             void ExpandPalette();
-            void ConvertImage();
+            bool ConvertImage();
         };
 
         class ImageJpegLoader : public ImageLoader
         {
         public:
             ImageJpegLoader(const ImageLoaderParam& param);
+            virtual ~ImageJpegLoader();
 
             virtual bool FromStream();
+
+            virtual bool Feed(const uint8_t* data, size_t size);
+            virtual bool Info(size_t* width, size_t* height, SimdPixelFormatType* format) const;
+            virtual size_t Pull(uint8_t* dst, size_t stride, size_t rows);
+
+            bool ToYuv420p(uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, size_t width, size_t height);
+
+        private:
+            struct Decoder;
+            Decoder* _decoder;
         };
 
         //---------------------------------------------------------------------
 
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
+
+        bool ImageLoadJpegToYuv420p(const uint8_t* data, size_t size, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, size_t width, size_t height, SimdYuvType yuvType);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -252,7 +334,8 @@ namespace Simd
         public:
             ImagePngLoader(const ImageLoaderParam& param);
 
-            virtual bool FromStream();
+        protected:
+            virtual void SetConverter();
         };
 
         class ImageJpegLoader : public Base::ImageJpegLoader
@@ -265,6 +348,8 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_SSE41_ENABLE
@@ -308,8 +393,19 @@ namespace Simd
             virtual void SetConverters();
         };
 
+        class ImagePngLoader : public Sse41::ImagePngLoader
+        {
+        public:
+            ImagePngLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverter();
+        };
+
         //---------------------------------------------------------------------
 
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_AVX2_ENABLE
@@ -353,8 +449,19 @@ namespace Simd
             virtual void SetConverters();
         };
 
+        class ImagePngLoader : public Avx2::ImagePngLoader
+        {
+        public:
+            ImagePngLoader(const ImageLoaderParam& param);
+
+        protected:
+            virtual void SetConverter();
+        };
+
         //---------------------------------------------------------------------
 
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_AVX512BW_ENABLE
@@ -400,6 +507,8 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        ImageLoader* CreateImageLoader(const ImageLoaderParam& param);
+
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
     }
 #endif// SIMD_NEON_ENABLE
@@ -34,6 +34,14 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        // Reduced-size IDCT (for 1/2, 1/4 and 1/8 scale decoding): writes the averages of 2x2, 4x4 or 8x8 pixel
+        // squares of the full IDCT output, it is computed from the lowest frequency coefficients only.
+        void JpegIdct4x4(uint8_t* dst, int stride, short* src);
+        void JpegIdct2x2(uint8_t* dst, int stride, short* src);
+        void JpegIdct1x1(uint8_t* dst, int stride, short* src);
+
+        //-------------------------------------------------------------------------------------------------
+
         static SIMD_INLINE int JpegLoadError(const char* text, const char* type)
         {
             std::cout << "JPEG load error: " << text << ", " << type << "!" << std::endl;
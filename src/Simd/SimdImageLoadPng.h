@@ -40,6 +40,33 @@ namespace Simd
         {
             return PngLoadError(text, "Corrupt PNG");
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void DecodeLine0(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
+        void DecodeLine1(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
+        void DecodeLine2(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
+        void DecodeLine3(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
+        void DecodeLine4(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
+        void DecodeLine5(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
+        void DecodeLine6(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
+
+        void ExpandPalette(const uint8_t* src, size_t size, int outN, const uint8_t* palette, uint8_t* dst);
+
+        //-------------------------------------------------------------------------------------------------
+
+        template<size_t N> void PngCopy(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            for (size_t row = 0; row < height; ++row)
+                memcpy(dst + row * dstStride, src + row * srcStride, width * N);
+        }
+
+        typedef void (*PngToAlphaPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride, uint8_t alpha);
+
+        template<PngToAlphaPtr convert> void PngToOpaque(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            convert(src, width, height, srcStride, dst, dstStride, 0xFF);
+        }
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -176,10 +176,12 @@ namespace Simd
             static const int TYPES = 7;
             typedef void (*ConvertPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
             typedef uint32_t (*EncodePtr)(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst);
-            typedef void (*CompressPtr)(uint8_t* data, int size, int quality, OutputMemoryStream& stream);
+            typedef void (*CompressPtr)(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream);
+            typedef uint32_t (*Adler32Ptr)(const uint8_t* data, int size);
             ConvertPtr _convert;
             EncodePtr _encode[TYPES];
             CompressPtr _compress;
+            Adler32Ptr _adler32;
             size_t _channels, _size;
             Array8u _filt, _buff;
             Array8i _line;
@@ -223,7 +225,9 @@ namespace Simd
             virtual void Init();
 
             void InitParams(bool trans);
-            void WriteHeader();
+            void WriteHeader(int restartInterval);
+
+            template<class Write> bool WriteImage(Write write);
         };
 
         //---------------------------------------------------------------------
@@ -67,6 +67,8 @@ namespace Simd
             }
         }; 
 
+        const size_t JpegParallelAreaMin = 256 * 256;
+
         extern const uint8_t JpegZigZagD[64];
         extern const uint8_t JpegZigZagT[64];
 
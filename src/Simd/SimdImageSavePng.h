@@ -147,6 +147,129 @@ namespace Simd
                 return uint8_t(b);
             return uint8_t(c);
         }
+
+        const size_t PngParallelAreaMin = 256 * 256;
+
+        SIMD_INLINE uint32_t ZlibAdler32Combine(uint32_t adler1, uint32_t adler2, size_t size2)
+        {
+            const uint32_t BASE = 65521;
+            uint32_t rem = uint32_t(size2 % BASE);
+            uint32_t lo = adler1 & 0xFFFF, hi = (rem * lo) % BASE;
+            lo += (adler2 & 0xFFFF) + BASE - 1;
+            hi += (adler1 >> 16) + (adler2 >> 16) + BASE - rem;
+            if (lo >= BASE)
+                lo -= BASE;
+            if (lo >= BASE)
+                lo -= BASE;
+            if (hi >= 2 * BASE)
+                hi -= 2 * BASE;
+            if (hi >= BASE)
+                hi -= BASE;
+            return (hi << 16) | lo;
+        }
+
+        // Compresses data[begin, end) into deflate block with fixed Huffman codes. Up to 32 KB of data before 'begin' are used as dictionary,
+        // so independent ranges can be compressed in parallel. Not last block is ended by empty stored block to be byte aligned (sync flush).
+        template<int (*Count)(const uint8_t*, const uint8_t*, int)> void ZlibDeflate(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            const int ZHASH = 16384;
+            if (quality < 1)
+                quality = 1;
+            const int basket = quality * 2;
+            Array32i hashTable(ZHASH * basket);
+            memset(hashTable.data, -1, hashTable.RawSize());
+
+            stream.WriteBits(last ? 1 : 0, 1);
+            stream.WriteBits(1, 2);
+
+            int i = Simd::Max(begin - 32768, 0), j;
+            for (; i < begin; ++i)
+            {
+                int* hList = hashTable.data + (ZlibHash(data + i) & (ZHASH - 1)) * basket;
+                for (j = 0; hList[j] != -1 && j < basket; ++j);
+                if (j == basket)
+                {
+                    memcpy(hList, hList + quality, quality * sizeof(int));
+                    memset(hList + quality, -1, quality * sizeof(int));
+                    j = quality;
+                }
+                hList[j] = i;
+            }
+            while (i < end - 3)
+            {
+                int h = ZlibHash(data + i) & (ZHASH - 1), best = 3;
+                const uint8_t* bestLoc = 0;
+                int* hList = hashTable.data + h * basket;
+                for (j = 0; hList[j] != -1 && j < basket; ++j)
+                {
+                    if (hList[j] > i - 32768)
+                    {
+                        int d = Count(data + hList[j], data + i, end - i);
+                        if (d >= best)
+                        {
+                            best = d;
+                            bestLoc = data + hList[j];
+                        }
+                    }
+                }
+                if (j == basket)
+                {
+                    memcpy(hList, hList + quality, quality * sizeof(int));
+                    memset(hList + quality, -1, quality * sizeof(int));
+                    j = quality;
+                }
+                hList[j] = i;
+
+                if (bestLoc)
+                {
+                    h = ZlibHash(data + i + 1) & (ZHASH - 1);
+                    int* hList = hashTable.data + h * basket;
+                    for (j = 0; hList[j] != -1 && j < basket; ++j)
+                    {
+                        if (hList[j] > i - 32767)
+                        {
+                            int e = Count(data + hList[j], data + i + 1, end - i - 1);
+                            if (e > best)
+                            {
+                                bestLoc = NULL;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                if (bestLoc)
+                {
+                    int d = (int)(data + i - bestLoc);
+                    assert(d <= 32767 && best <= 258);
+                    for (j = 0; best > ZlibLenC[j + 1] - 1; ++j);
+                    ZlibHuff(j + 257, stream);
+                    if (ZlibLenEb[j])
+                        stream.WriteBits(best - ZlibLenC[j], ZlibLenEb[j]);
+                    for (j = 0; d > ZlibDistC[j + 1] - 1; ++j);
+                    stream.WriteBits(ZlibBitRev(j, 5), 5);
+                    if (ZlibDistEb[j])
+                        stream.WriteBits(d - ZlibDistC[j], ZlibDistEb[j]);
+                    i += best;
+                }
+                else
+                {
+                    ZlibHuffB(data[i], stream);
+                    ++i;
+                }
+            }
+            for (; i < end; ++i)
+                ZlibHuffB(data[i], stream);
+            ZlibHuff(256, stream);
+            if (!last)
+            {
+                stream.WriteBits(0, 3);
+                stream.FlushBits();
+                stream.Write8u(0x00, 2);
+                stream.Write8u(0xFF, 2);
+            }
+            stream.FlushBits();
+        }
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -64,18 +64,23 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReasonForCall, LPVOID lpReserved)
 #include "Simd/SimdEmpty.h"
 
 #include "Simd/SimdDescrInt.h"
+#include "Simd/SimdDescrIntIndex.h"
 #include "Simd/SimdGaussianBlur.h"
 #include "Simd/SimdImageLoad.h"
 #include "Simd/SimdImageSave.h"
 #include "Simd/SimdRecursiveBilateralFilter.h"
 #include "Simd/SimdResizer.h"
+#include "Simd/SimdRuntime.h"
 #include "Simd/SimdSynetConvolution8i.h"
+#include "Simd/SimdSynetGemm8i.h"
 #include "Simd/SimdSynetConvolution32f.h"
 #include "Simd/SimdSynetDeconvolution32f.h"
 #include "Simd/SimdSynetInnerProduct32f.h"
 #include "Simd/SimdSynetMergedConvolution32f.h"
 #include "Simd/SimdSynetMergedConvolution8i.h"
 #include "Simd/SimdSynetPermute.h"
+#include "Simd/SimdSynetMatMul32f.h"
+#include "Simd/SimdSynetAttention32f.h"
 #include "Simd/SimdSynetScale8i.h"
 #include "Simd/SimdWarpAffine.h"
 
@@ -172,6 +177,16 @@ SIMD_API const char * SimdPerformanceStatistic()
 #endif
 }
 
+SIMD_API SimdBool SimdRuntimeCacheLoad(const char * path)
+{
+    return RuntimeCache::Global().Load(path) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdRuntimeCacheSave(const char * path)
+{
+    return RuntimeCache::Global().Save(path) ? SimdTrue : SimdFalse;
+}
+
 SIMD_API void * SimdAllocate(size_t size, size_t align)
 {
     return Allocate(size, align);
@@ -1992,12 +2007,72 @@ SIMD_API void SimdDescrIntCosineDistancesMxNp(const void* context, size_t M, siz
     return ((Base::DescrInt*)context)->CosineDistancesMxNp(M, N, A, B, distances);
 }
 
+SIMD_API void SimdDescrIntCosineDistancesTopKa(const void* context, size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, size_t K, float threshold, uint32_t* indices, float* distances)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrInt*)context)->CosineDistancesTopKa(M, N, A, B, K, threshold, indices, distances);
+}
+
+SIMD_API void SimdDescrIntCosineDistancesTopKp(const void* context, size_t M, size_t N, const uint8_t* A, const uint8_t* B, size_t K, float threshold, uint32_t* indices, float* distances)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrInt*)context)->CosineDistancesTopKp(M, N, A, B, K, threshold, indices, distances);
+}
+
 SIMD_API void SimdDescrIntVectorNorm(const void* context, const uint8_t* a, float* norm)
 {
     SIMD_EMPTY();
     return ((Base::DescrInt*)context)->VectorNorm(a, norm);
 }
 
+SIMD_API void* SimdDescrIntIndexInit(size_t size, size_t depth, size_t lists)
+{
+    SIMD_EMPTY();
+    return Base::DescrIntIndexInit(SimdDescrIntInit(size, depth), lists);
+}
+
+SIMD_API SimdBool SimdDescrIntIndexTrain(void* index, size_t count, const float* data, size_t iterations)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrIntIndex*)index)->Train(count, data, iterations) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdDescrIntIndexAdd(void* index, size_t count, const float* data, const uint32_t* ids)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrIntIndex*)index)->Add(count, data, ids) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API size_t SimdDescrIntIndexRemove(void* index, size_t count, const uint32_t* ids)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrIntIndex*)index)->Remove(count, ids);
+}
+
+SIMD_API size_t SimdDescrIntIndexSize(const void* index)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrIntIndex*)index)->Size();
+}
+
+SIMD_API void SimdDescrIntIndexSearch(const void* index, size_t M, const float* queries, size_t nprobe, size_t K, float threshold, uint32_t* ids, float* distances)
+{
+    SIMD_EMPTY();
+    ((Base::DescrIntIndex*)index)->Search(M, queries, nprobe, K, threshold, ids, distances);
+}
+
+SIMD_API SimdBool SimdDescrIntIndexSave(const void* index, const char* path)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrIntIndex*)index)->Save(path) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdDescrIntIndexLoad(void* index, const char* path)
+{
+    SIMD_EMPTY();
+    return ((Base::DescrIntIndex*)index)->Load(path) ? SimdTrue : SimdFalse;
+}
+
 SIMD_API void SimdDeinterleaveUv(const uint8_t * uv, size_t uvStride, size_t width, size_t height,
                     uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
 {
@@ -3426,6 +3501,46 @@ SIMD_API uint8_t* SimdImageLoadFromMemory(const uint8_t* data, size_t size, size
     return imageLoadFromMemory(data, size, stride, width, height, format);
 }
 
+SIMD_API uint8_t* SimdImageLoadFromMemoryScaled(const uint8_t* data, size_t size, size_t scale, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
+{
+    SIMD_EMPTY();
+    const static Simd::CreateImageLoaderPtr createImageLoader = SIMD_FUNC4(CreateImageLoader, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    ImageLoaderParam param(data, size, *format, scale);
+    if (param.Validate())
+    {
+        Holder<ImageLoader> loader(createImageLoader(param));
+        if (loader)
+        {
+            if (loader->FromStream())
+                return loader->Release(stride, width, height, format);
+        }
+    }
+    return NULL;
+}
+
+SIMD_API SimdBool SimdImageLoadFromMemoryInto(const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height, SimdPixelFormatType format)
+{
+    SIMD_EMPTY();
+    const static Simd::CreateImageLoaderPtr createImageLoader = SIMD_FUNC4(CreateImageLoader, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    ImageLoaderParam param(data, size, format);
+    if (format != SimdPixelFormatNone && param.Validate())
+    {
+        Holder<ImageLoader> loader(createImageLoader(param));
+        if (loader && loader->FromStreamInto(dst, stride, width, height))
+            return SimdTrue;
+    }
+    return SimdFalse;
+}
+
+SIMD_API SimdBool SimdImageLoadJpegToYuv420p(const uint8_t* data, size_t size, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride,
+    uint8_t* v, size_t vStride, size_t width, size_t height, SimdYuvType yuvType)
+{
+    SIMD_EMPTY();
+    return Base::ImageLoadJpegToYuv420p(data, size, y, yStride, u, uStride, v, vStride, width, height, yuvType) ? SimdTrue : SimdFalse;
+}
+
 SIMD_API uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
 {
     SIMD_EMPTY();
@@ -3434,6 +3549,35 @@ SIMD_API uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t
     return ImageLoadFromFile(imageLoadFromMemory, path, stride, width, height, format);
 }
 
+SIMD_API void* SimdImageDecoderInit(SimdPixelFormatType format)
+{
+    SIMD_EMPTY();
+    const static Simd::CreateImageLoaderPtr createImageLoader = SIMD_FUNC4(CreateImageLoader, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    if (format == SimdPixelFormatNone || format == SimdPixelFormatGray8 || format == SimdPixelFormatBgr24 || 
+        format == SimdPixelFormatBgra32 || format == SimdPixelFormatRgb24 || format == SimdPixelFormatRgba32)
+        return new ImageDecoder(format, createImageLoader);
+    return NULL;
+}
+
+SIMD_API SimdBool SimdImageDecoderFeed(void* decoder, const uint8_t* data, size_t size)
+{
+    SIMD_EMPTY();
+    return ((ImageDecoder*)decoder)->Feed(data, size) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdImageDecoderInfo(const void* decoder, size_t* width, size_t* height, SimdPixelFormatType* format)
+{
+    SIMD_EMPTY();
+    return ((const ImageDecoder*)decoder)->Info(width, height, format) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API size_t SimdImageDecoderPull(void* decoder, uint8_t* dst, size_t stride, size_t rows)
+{
+    SIMD_EMPTY();
+    return ((ImageDecoder*)decoder)->Pull(dst, stride, rows);
+}
+
 SIMD_API void SimdInt16ToGray(const uint8_t * src, size_t width, size_t height, size_t srcStride, uint8_t * dst, size_t dstStride)
 {
     SIMD_EMPTY();
@@ -4887,7 +5031,7 @@ SIMD_API void * SimdResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t ds
     typedef void*(*SimdResizerInitPtr) (size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
     const static SimdResizerInitPtr simdResizerInit = SIMD_FUNC5(ResizerInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
 
-    return simdResizerInit(srcX, srcY, dstX, dstY, channels, type, method);
+    return Base::ResizerParallelInit(srcX, srcY, dstX, dstY, channels, type, method, simdResizerInit);
 }
 
 SIMD_API void SimdResizerRun(const void * resizer, const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride)
@@ -5938,6 +6082,41 @@ SIMD_API void SimdSynetAdd8i(const uint8_t* aData, const float* aScale, const fl
 #endif
 }
 
+SIMD_API void* SimdSynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void* (*SimdSynetAttention32fInitPtr) (size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility);
+    const static SimdSynetAttention32fInitPtr simdSynetAttention32fInit = SIMD_FUNC2(SynetAttention32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC);
+
+    return simdSynetAttention32fInit(batch, heads, lenQ, lenKV, depth, scale, causal, compatibility);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API size_t SimdSynetAttention32fInternalBufferSize(const void* context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((Base::SynetAttention32f*)context)->InternalBufferSize();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API void SimdSynetAttention32fForward(void* context, const float* q, const float* k, const float* v, float* dst)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    ((Base::SynetAttention32f*)context)->Forward(q, k, v, dst);
+#else
+    assert(0);
+#endif
+}
+
 SIMD_API void SimdSynetConvert32fTo8u(const float* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, uint8_t* dst, SimdSynetCompatibilityType compatibility)
 {
     SIMD_EMPTY();
@@ -6033,6 +6212,65 @@ SIMD_API void SimdSynetConvolution32fForward(void * context, const float * src,
 #endif
 }
 
+SIMD_API SimdBool SimdSynetConvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetConvolution32f*)context)->Reshape(batch, srcH, srcW) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
+SIMD_API void * SimdSynetConvolution32fExportWeight(const void * context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return new SynetPackedWeight(((SynetConvolution32f*)context)->Export());
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API SimdBool SimdSynetConvolution32fSetPackedParams(void * context, const void * packed, const float * weight, const float * bias, const float * params)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetConvolution32f*)context)->SetPackedParams(*(const SynetPackedWeight*)packed, weight, bias, params) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
+SIMD_API SimdBool SimdSynetPackedWeightSave(const void * packed, const char * path)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((const SynetPackedWeight*)packed)->Save(path) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
+SIMD_API void * SimdSynetPackedWeightLoad(const char * path)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    SynetPackedWeight * packed = new SynetPackedWeight();
+    if (packed->Load(path))
+        return packed;
+    delete packed;
+    return NULL;
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
 SIMD_API void* SimdSynetConvolution8iInit(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility)
 {
     SIMD_EMPTY();
@@ -6102,6 +6340,39 @@ SIMD_API void SimdSynetConvolution8iForward(void* context, const uint8_t* src, u
 #endif
 }
 
+SIMD_API SimdBool SimdSynetConvolution8iReshape(void * context, size_t batch, size_t srcH, size_t srcW)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetConvolution8i*)context)->Reshape(batch, srcH, srcW) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
+SIMD_API void * SimdSynetConvolution8iExportWeight(const void * context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return new SynetPackedWeight(((SynetConvolution8i*)context)->Export());
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API SimdBool SimdSynetConvolution8iSetPackedParams(void * context, const void * packed, const float * weight, const float * bias, const float * params, const float * const * stats)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetConvolution8i*)context)->SetPackedParams(*(const SynetPackedWeight*)packed, weight, bias, params, stats) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
 SIMD_API void * SimdSynetDeconvolution32fInit(size_t batch, const SimdConvolutionParameters * params, SimdSynetCompatibilityType compatibility)
 {
     SIMD_EMPTY();
@@ -6171,6 +6442,17 @@ SIMD_API void SimdSynetDeconvolution32fForward(void * context, const float * src
 #endif
 }
 
+SIMD_API SimdBool SimdSynetDeconvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetDeconvolution32f*)context)->Reshape(batch, srcH, srcW) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
 SIMD_API void SimdSynetEltwiseLayerForward(float const * const * src, const float * weight, size_t count, size_t size, SimdSynetEltwiseOperationType type, float * dst)
 {
     SIMD_EMPTY();
@@ -6341,6 +6623,20 @@ SIMD_API void* SimdSynetInnerProduct32fInit(size_t batch, size_t input, size_t o
 #endif
 }
 
+SIMD_API void* SimdSynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void* (*SimdSynetInnerProduct32fInitV2Ptr) (size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    const static SimdSynetInnerProduct32fInitV2Ptr simdSynetInnerProduct32fInitV2 = SIMD_FUNC5(SynetInnerProduct32fInitV2, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    return simdSynetInnerProduct32fInitV2(batch, input, output, transpose, activation, compatibility);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
 SIMD_API size_t SimdSynetInnerProduct32fInternalBufferSize(const void* context)
 {
     SIMD_EMPTY();
@@ -6400,6 +6696,112 @@ SIMD_API void SimdSynetInnerProduct8i(size_t M, size_t N, size_t K, const uint8_
 #endif
 }
 
+SIMD_API void * SimdSynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void* (*SimdSynetGemm8iInitPtr) (size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    const static SimdSynetGemm8iInitPtr simdSynetGemm8iInit = SIMD_FUNC6(SynetGemm8iInit, SIMD_AMXBF16_FUNC, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    return simdSynetGemm8iInit(M, N, K, srcT, dstT, activation, compatibility);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API size_t SimdSynetGemm8iExternalBufferSize(const void * context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetGemm8i*)context)->ExternalBufferSize();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API size_t SimdSynetGemm8iInternalBufferSize(const void * context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetGemm8i*)context)->InternalBufferSize();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API const char* SimdSynetGemm8iInfo(const void* context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetGemm8i*)context)->Info();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API void SimdSynetGemm8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const* stats)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    ((SynetGemm8i*)context)->SetParams(weight, bias, params, stats);
+#else
+    assert(0);
+#endif
+}
+
+SIMD_API SimdBool SimdSynetGemm8iReshape(void * context, size_t M)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetGemm8i*)context)->Reshape(M) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
+SIMD_API void SimdSynetGemm8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    SynetGemm8i* g = (SynetGemm8i*)context;
+    SIMD_PERF_EXT(g);
+    g->Forward(src, buf, dst);
+#else
+    assert(0);
+#endif
+}
+
+SIMD_API void SimdSynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void(*SimdSynetLayerNorm32fPtr) (const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst);
+    const static SimdSynetLayerNorm32fPtr simdSynetLayerNorm32f = SIMD_FUNC3(SynetLayerNorm32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+
+    simdSynetLayerNorm32f(src, outer, size, scale, shift, eps, dst);
+#else
+    assert(0);
+#endif
+}
+
+SIMD_API void SimdSynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void(*SimdSynetLayerNorm16bPtr) (const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst);
+    const static SimdSynetLayerNorm16bPtr simdSynetLayerNorm16b = SIMD_FUNC3(SynetLayerNorm16b, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+
+    simdSynetLayerNorm16b(src, outer, size, scale, shift, eps, dst);
+#else
+    assert(0);
+#endif
+}
+
 SIMD_API void SimdSynetLrnLayerCrossChannels(const float * src, size_t half, size_t channels, size_t spatial, const float * k, float * dst, SimdTensorFormatType format)
 {
     SIMD_EMPTY();
@@ -6413,6 +6815,41 @@ SIMD_API void SimdSynetLrnLayerCrossChannels(const float * src, size_t half, siz
 #endif
 }
 
+SIMD_API void* SimdSynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void* (*SimdSynetMatMul32fInitPtr) (size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+    const static SimdSynetMatMul32fInitPtr simdSynetMatMul32fInit = SIMD_FUNC4(SynetMatMul32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+
+    return simdSynetMatMul32fInit(batchA, batchB, M, N, K, transB, compatibility);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API size_t SimdSynetMatMul32fInternalBufferSize(const void* context)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((Base::SynetMatMul32f*)context)->InternalBufferSize();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
+SIMD_API void SimdSynetMatMul32fForward(void* context, const float* A, const float* B, float* C)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    ((Base::SynetMatMul32f*)context)->Forward(A, B, C);
+#else
+    assert(0);
+#endif
+}
+
 SIMD_API void * SimdSynetMergedConvolution32fInit(size_t batch, const SimdConvolutionParameters * convs, size_t count, SimdBool add, SimdSynetCompatibilityType compatibility)
 {
     SIMD_EMPTY();
@@ -6482,6 +6919,17 @@ SIMD_API void SimdSynetMergedConvolution32fForward(void * context, const float *
 #endif
 }
 
+SIMD_API SimdBool SimdSynetMergedConvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((SynetMergedConvolution32f*)context)->Reshape(batch, srcH, srcW) ? SimdTrue : SimdFalse;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
 SIMD_API void* SimdSynetMergedConvolution8iInit(size_t batch, const SimdConvolutionParameters* convs, size_t count, SimdSynetCompatibilityType compatibility)
 {
     SIMD_EMPTY();
@@ -6551,6 +6999,17 @@ SIMD_API void SimdSynetMergedConvolution8iForward(void* context, const uint8_t*
 #endif
 }
 
+SIMD_API size_t SimdSynetArenaPlan(SimdSynetArenaLayer* layers, size_t layerCount, SimdSynetArenaTensor* tensors, size_t tensorCount)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return Base::SynetArenaPlan(layers, layerCount, tensors, tensorCount);
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
 SIMD_API void SimdSynetMish32f(const float* src, size_t size, const float* threshold, float* dst)
 {
     SIMD_EMPTY();
@@ -437,7 +437,7 @@ typedef enum
 
 /*! @ingroup synet_types
     Describes Synet calculation compatibility flags. This type used in functions ::SimdSynetAdd8i, ::SimdSynetScaleLayerForward, 
-    ::SimdSynetConvert32fTo8u, ::SimdSynetConvert8uTo32f, ::SimdSynetInnerProduct8i, ::SimdSynetScale8iInit,
+    ::SimdSynetConvert32fTo8u, ::SimdSynetConvert8uTo32f, ::SimdSynetInnerProduct8i, ::SimdSynetGemm8iInit, ::SimdSynetScale8iInit,
     ::SimdSynetConvolution32fInit, ::SimdSynetConvolution8iInit, ::SimdSynetMergedConvolution32fInit, ::SimdSynetMergedConvolution8iInit.
 */
 typedef enum
@@ -664,6 +664,66 @@ typedef struct SimdConvolutionParameters
     SimdConvolutionActivationType activation;
 } SimdConvolutionParameters;
 
+/*! @ingroup synet_types
+    Describes type of Synet context. It is used in ::SimdSynetArenaPlan.
+*/
+typedef enum
+{
+    SimdSynetContextConvolution32f, /*!< A context created by ::SimdSynetConvolution32fInit. */
+    SimdSynetContextConvolution8i, /*!< A context created by ::SimdSynetConvolution8iInit. */
+    SimdSynetContextDeconvolution32f, /*!< A context created by ::SimdSynetDeconvolution32fInit. */
+    SimdSynetContextMergedConvolution32f, /*!< A context created by ::SimdSynetMergedConvolution32fInit. */
+    SimdSynetContextMergedConvolution8i, /*!< A context created by ::SimdSynetMergedConvolution8iInit. */
+    SimdSynetContextInnerProduct32f, /*!< A context created by ::SimdSynetInnerProduct32fInit. It does not need external buffer. */
+    SimdSynetContextOther, /*!< Other layer without external buffer. Context is ignored. */
+} SimdSynetContextType;
+
+/*! @ingroup synet_types
+    Describes a layer (one step of network inference) for ::SimdSynetArenaPlan.
+*/
+typedef struct SimdSynetArenaLayer
+{
+    /*!
+        A type of the layer context.
+    */
+    SimdSynetContextType type;
+    /*!
+        A pointer to the layer context. Its external buffer is placed in the arena. Can be NULL.
+    */
+    const void * context;
+    /*!
+        An output: offset (in bytes) of external buffer of the layer in the arena.
+    */
+    size_t offset;
+    /*!
+        An output: size (in bytes) of external buffer of the layer.
+    */
+    size_t size;
+} SimdSynetArenaLayer;
+
+/*! @ingroup synet_types
+    Describes an intermediate tensor for ::SimdSynetArenaPlan.
+*/
+typedef struct SimdSynetArenaTensor
+{
+    /*!
+        A size (in bytes) of the tensor.
+    */
+    size_t size;
+    /*!
+        An index of the first layer which uses the tensor (usually the layer which produces it).
+    */
+    size_t first;
+    /*!
+        An index of the last layer which uses the tensor.
+    */
+    size_t last;
+    /*!
+        An output: offset (in bytes) of the tensor in the arena.
+    */
+    size_t offset;
+} SimdSynetArenaTensor;
+
 #if defined(_WIN32) && !defined(SIMD_STATIC)
 #  ifdef SIMD_EXPORTS
 #    define SIMD_API __declspec(dllexport)
@@ -769,6 +829,36 @@ extern "C"
     */
     SIMD_API const char * SimdPerformanceStatistic();
 
+    /*! @ingroup info
+
+        \fn SimdBool SimdRuntimeCacheLoad(const char * path);
+
+        \short Loads results of runtime kernel selection from file.
+
+        Some algorithms (for example GEMM in ::SimdSynetConvolution32fInit) have several implementations. 
+        The fastest of them is selected at runtime by timing of the first calls. The results of this selection are stored in 
+        process-wide database keyed by CPU model, thread number, name of the algorithm and shape of the task. 
+        Loading of the database allows to skip the timing and use the best implementation from the first call.
+        Entries of the loaded file are merged with current ones.
+
+        \param [in] path - a path to the file with database.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdRuntimeCacheLoad(const char * path);
+
+    /*! @ingroup info
+
+        \fn SimdBool SimdRuntimeCacheSave(const char * path);
+
+        \short Saves results of runtime kernel selection to file. 
+        
+        The file can be created offline (by running of typical workload) and loaded by ::SimdRuntimeCacheLoad at start of production process.
+
+        \param [in] path - a path to the file with database.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdRuntimeCacheSave(const char * path);
+
     /*! @ingroup memory
 
         \fn void * SimdAllocate(size_t size, size_t align);
@@ -847,6 +937,8 @@ extern "C"
 
         \short Sets number of threads used by Simd Library to parallelize some algorithms.
 
+        \note Parallel algorithms are executed on a persistent process-wide thread pool. This function creates missing worker threads of the pool.
+
         \param [in] threadNumber - a number of threads.
     */
     SIMD_API void SimdSetThreadNumber(size_t threadNumber);
@@ -2504,12 +2596,17 @@ extern "C"
 
         \short Initilizes Integer Descriptor Engine.
 
+        Descriptors with depth 1, 2 and 3 are stored as bit planes and their cosine distances are estimated with using of popcount. 
+        1-bit descriptors store sign of original values (and mean values of negative and positive parts for distance estimation). 
+        They are intended for fast first-stage candidate filtering with reranking by descriptors with greater depth.
+
         \param [in] size - a length of original (32-bit or 16-bit) float descriptor. It be multiple of 8. Also it must be less or equal than 32768.
-        \param [in] depth - a number of bits in encoded integer descriptor. Supported values: 4, 5, 6, 7, 8.
+        \param [in] depth - a number of bits in encoded integer descriptor. Supported values: 1, 2, 3, 4, 5, 6, 7, 8.
         \return a pointer to Integer Descriptor Engine context. On error it returns NULL. It must be released with using of function ::SimdRelease.
                 This pointer is used in functions ::SimdDescrIntEncodedSize, ::SimdDescrIntDecodedSize, 
                 ::SimdDescrIntEncode32f, ::SimdDescrIntEncode16f, ::SimdDescrIntDecode32f, ::SimdDescrIntDecode16f, 
-                ::SimdDescrIntCosineDistance, ::SimdDescrIntCosineDistancesMxNa, ::SimdDescrIntCosineDistancesMxNp, ::SimdDescrIntVectorNorm.
+                ::SimdDescrIntCosineDistance, ::SimdDescrIntCosineDistancesMxNa, ::SimdDescrIntCosineDistancesMxNp, 
+                ::SimdDescrIntCosineDistancesTopKa, ::SimdDescrIntCosineDistancesTopKp, ::SimdDescrIntVectorNorm.
     */
     SIMD_API void * SimdDescrIntInit(size_t size, size_t depth);
 
@@ -2606,6 +2703,8 @@ extern "C"
 
         \note Integer descriptor can be recieved with using of functions ::SimdDescrIntEncode32f of ::SimdDescrIntEncode16f. Its size in bytes is determined by function ::SimdDescrIntEncodedSize.
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber). B arrays are split between threads.
+
         \param [in] context - a pointer to Integer Descriptor Engine context. It must be created by function ::SimdDescrIntInit and released by function ::SimdRelease.
         \param [in] M - a number of A arrays.
         \param [in] N - a number of B arrays.
@@ -2623,6 +2722,8 @@ extern "C"
 
         \note Integer descriptor can be recieved with using of functions ::SimdDescrIntEncode32f of ::SimdDescrIntEncode16f. Its size in bytes is determined by function ::SimdDescrIntEncodedSize.
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber). B arrays are split between threads.
+
         \param [in] context - a pointer to Integer Descriptor Engine context. It must be created by function ::SimdDescrIntInit and released by function ::SimdRelease.
         \param [in] M - a number of A arrays.
         \param [in] N - a number of B arrays.
@@ -2632,6 +2733,51 @@ extern "C"
     */
     SIMD_API void SimdDescrIntCosineDistancesMxNp(const void* context, size_t M, size_t N, const uint8_t* A, const uint8_t* B, float* distances);
 
+    /*! @ingroup descrint
+
+        \fn void SimdDescrIntCosineDistancesTopKa(const void* context, size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, size_t K, float threshold, uint32_t* indices, float* distances);
+
+        \short Finds K nearest (by cosine distance) integer descriptors of B array for every integer descriptor of A array.
+
+        The gallery B is processed by cache sized blocks in several threads. Distances of each block are accumulated in bounded heaps, 
+        so the full M*N distance matrix is never stored.
+
+        \note Integer descriptor can be recieved with using of functions ::SimdDescrIntEncode32f of ::SimdDescrIntEncode16f. Its size in bytes is determined by function ::SimdDescrIntEncodedSize.
+
+        \param [in] context - a pointer to Integer Descriptor Engine context. It must be created by function ::SimdDescrIntInit and released by function ::SimdRelease.
+        \param [in] M - a number of A arrays (queries).
+        \param [in] N - a number of B arrays (gallery). It must be less than 2^32 - 1.
+        \param [in] A - a pointer to the first array with pointers to integer descriptors.
+        \param [in] B - a pointer to the second array with pointers to integer descriptors.
+        \param [in] K - a maximal number of found neighbours for every query.
+        \param [in] threshold - a maximal cosine distance of found neighbours. Use value greater than 2.0f to disable it.
+        \param [out] indices - a pointer to result array (M*K) with indices of found B descriptors. Indices of every query are sorted by ascending of distance. 
+            Unused positions are filled by value 0xFFFFFFFF.
+        \param [out] distances - a pointer to result 32-bit float array (M*K) with cosine distances of found descriptors. Unused positions are filled by FLT_MAX.
+    */
+    SIMD_API void SimdDescrIntCosineDistancesTopKa(const void* context, size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, size_t K, float threshold, uint32_t* indices, float* distances);
+
+    /*! @ingroup descrint
+
+        \fn void SimdDescrIntCosineDistancesTopKp(const void* context, size_t M, size_t N, const uint8_t* A, const uint8_t* B, size_t K, float threshold, uint32_t* indices, float* distances);
+
+        \short Finds K nearest (by cosine distance) integer descriptors of B array for every integer descriptor of A array.
+
+        It is analogue of function ::SimdDescrIntCosineDistancesTopKa for packed arrays of integer descriptors.
+
+        \param [in] context - a pointer to Integer Descriptor Engine context. It must be created by function ::SimdDescrIntInit and released by function ::SimdRelease.
+        \param [in] M - a number of A arrays (queries).
+        \param [in] N - a number of B arrays (gallery). It must be less than 2^32 - 1.
+        \param [in] A - a pointer to the first array with integer descriptors.
+        \param [in] B - a pointer to the second array with integer descriptors.
+        \param [in] K - a maximal number of found neighbours for every query.
+        \param [in] threshold - a maximal cosine distance of found neighbours. Use value greater than 2.0f to disable it.
+        \param [out] indices - a pointer to result array (M*K) with indices of found B descriptors. Indices of every query are sorted by ascending of distance.
+            Unused positions are filled by value 0xFFFFFFFF.
+        \param [out] distances - a pointer to result 32-bit float array (M*K) with cosine distances of found descriptors. Unused positions are filled by FLT_MAX.
+    */
+    SIMD_API void SimdDescrIntCosineDistancesTopKp(const void* context, size_t M, size_t N, const uint8_t* A, const uint8_t* B, size_t K, float threshold, uint32_t* indices, float* distances);
+
     /*! @ingroup descrint
 
         \fn void SimdDescrIntVectorNorm(const void* context, const uint8_t* a, float* norm);
@@ -2646,6 +2792,133 @@ extern "C"
     */
     SIMD_API void SimdDescrIntVectorNorm(const void* context, const uint8_t* a, float* norm);
 
+    /*! @ingroup descrint
+
+        \fn void * SimdDescrIntIndexInit(size_t size, size_t depth, size_t lists);
+
+        \short Initilizes inverted file (IVF) index over integer descriptors.
+
+        The index uses coarse quantizer (spherical k-means over 32-bit float descriptors) to split descriptors into inverted lists. 
+        Every list stores encoded integer descriptors and their identifiers contiguously. 
+        Search scans only nprobe lists which are nearest to the query.
+
+        \param [in] size - a length of original (32-bit or 16-bit) float descriptor. It must be multiple of 8. Also it must be less or equal than 32768.
+        \param [in] depth - a number of bits in encoded integer descriptor. Supported values: 1, 2, 3, 4, 5, 6, 7, 8.
+        \param [in] lists - a number of inverted lists (clusters of coarse quantizer). It must be greater than 0.
+        \return a pointer to IVF index context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdDescrIntIndexTrain, ::SimdDescrIntIndexAdd, ::SimdDescrIntIndexRemove, 
+            ::SimdDescrIntIndexSize, ::SimdDescrIntIndexSearch, ::SimdDescrIntIndexSave, ::SimdDescrIntIndexLoad.
+    */
+    SIMD_API void * SimdDescrIntIndexInit(size_t size, size_t depth, size_t lists);
+
+    /*! @ingroup descrint
+
+        \fn SimdBool SimdDescrIntIndexTrain(void * index, size_t count, const float * data, size_t iterations);
+
+        \short Trains coarse quantizer of IVF index.
+
+        \note The index must be empty. 
+
+        \param [in, out] index - a pointer to IVF index context. It must be created by function ::SimdDescrIntIndexInit and released by function ::SimdRelease.
+        \param [in] count - a number of train descriptors. It must be greater or equal than the number of inverted lists.
+        \param [in] data - a pointer to train 32-bit float descriptors (count * size).
+        \param [in] iterations - a maximal number of k-means iterations.
+        \return a result of the operation.
+    */
+    SIMD_API SimdBool SimdDescrIntIndexTrain(void * index, size_t count, const float * data, size_t iterations);
+
+    /*! @ingroup descrint
+
+        \fn SimdBool SimdDescrIntIndexAdd(void * index, size_t count, const float * data, const uint32_t * ids);
+
+        \short Encodes and adds descriptors to IVF index.
+
+        \note The index must be trained.
+
+        \param [in, out] index - a pointer to IVF index context. It must be created by function ::SimdDescrIntIndexInit and released by function ::SimdRelease.
+        \param [in] count - a number of added descriptors.
+        \param [in] data - a pointer to added 32-bit float descriptors (count * size).
+        \param [in] ids - a pointer to identifiers of added descriptors (count). Value 0xFFFFFFFF is reserved.
+        \return a result of the operation.
+    */
+    SIMD_API SimdBool SimdDescrIntIndexAdd(void * index, size_t count, const float * data, const uint32_t * ids);
+
+    /*! @ingroup descrint
+
+        \fn size_t SimdDescrIntIndexRemove(void * index, size_t count, const uint32_t * ids);
+
+        \short Removes descriptors with given identifiers from IVF index.
+
+        \note Every call scans all inverted lists, so it is better to remove descriptors by large batches.
+
+        \param [in, out] index - a pointer to IVF index context. It must be created by function ::SimdDescrIntIndexInit and released by function ::SimdRelease.
+        \param [in] count - a number of removed identifiers.
+        \param [in] ids - a pointer to removed identifiers (count).
+        \return a number of removed descriptors.
+    */
+    SIMD_API size_t SimdDescrIntIndexRemove(void * index, size_t count, const uint32_t * ids);
+
+    /*! @ingroup descrint
+
+        \fn size_t SimdDescrIntIndexSize(const void * index);
+
+        \short Gets number of descriptors stored in IVF index.
+
+        \param [in] index - a pointer to IVF index context. It must be created by function ::SimdDescrIntIndexInit and released by function ::SimdRelease.
+        \return a number of stored descriptors.
+    */
+    SIMD_API size_t SimdDescrIntIndexSize(const void * index);
+
+    /*! @ingroup descrint
+
+        \fn void SimdDescrIntIndexSearch(const void * index, size_t M, const float * queries, size_t nprobe, size_t K, float threshold, uint32_t * ids, float * distances);
+
+        \short Finds K nearest (by cosine distance) descriptors in IVF index for every query.
+
+        Queries are processed in parallel threads. For every query only nprobe nearest inverted lists are scanned.
+
+        \param [in] index - a pointer to IVF index context. It must be created by function ::SimdDescrIntIndexInit and released by function ::SimdRelease.
+        \param [in] M - a number of queries.
+        \param [in] queries - a pointer to 32-bit float query descriptors (M * size).
+        \param [in] nprobe - a number of scanned inverted lists for every query. 
+        \param [in] K - a maximal number of found neighbours for every query.
+        \param [in] threshold - a maximal cosine distance of found neighbours. Use value greater than 2.0f to disable it.
+        \param [out] ids - a pointer to result array (M*K) with identifiers of found descriptors. They are sorted by ascending of distance. 
+            Unused positions are filled by value 0xFFFFFFFF.
+        \param [out] distances - a pointer to result 32-bit float array (M*K) with cosine distances of found descriptors. Unused positions are filled by FLT_MAX.
+    */
+    SIMD_API void SimdDescrIntIndexSearch(const void * index, size_t M, const float * queries, size_t nprobe, size_t K, float threshold, uint32_t * ids, float * distances);
+
+    /*! @ingroup descrint
+
+        \fn SimdBool SimdDescrIntIndexSave(const void * index, const char * path);
+
+        \short Saves IVF index to file. 
+
+        Centroids, encoded descriptors and identifiers of every inverted list are stored in aligned sections, so the file can be mapped in memory by ::SimdDescrIntIndexLoad.
+        The index is written to temporary file which then replaces the file at given path, so the index can be saved to the same file it was loaded from.
+
+        \param [in] index - a pointer to IVF index context. It must be created by function ::SimdDescrIntIndexInit and released by function ::SimdRelease.
+        \param [in] path - a path to the file.
+        \return a result of the operation.
+    */
+    SIMD_API SimdBool SimdDescrIntIndexSave(const void * index, const char * path);
+
+    /*! @ingroup descrint
+
+        \fn SimdBool SimdDescrIntIndexLoad(void * index, const char * path);
+
+        \short Loads IVF index from file created by function ::SimdDescrIntIndexSave.
+
+        The file is mapped in memory (if it is supported by platform) and inverted lists are used without copying. 
+        An inverted list is copied in memory only when it is modified by ::SimdDescrIntIndexAdd or ::SimdDescrIntIndexRemove.
+
+        \param [in, out] index - a pointer to IVF index context. It must be created by function ::SimdDescrIntIndexInit (with the same size and depth) and released by function ::SimdRelease.
+        \param [in] path - a path to the file.
+        \return a result of the operation. On error the index is not changed.
+    */
+    SIMD_API SimdBool SimdDescrIntIndexLoad(void * index, const char * path);
+
     /*! @ingroup deinterleave_conversion
 
         \fn void SimdDeinterleaveUv(const uint8_t * uv, size_t uvStride, size_t width, size_t height, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride);
@@ -3387,6 +3660,8 @@ extern "C"
         distances[i, j] = 1 - Sum(A[i][k]*B[j][k])/Sqrt(Sum(A[i][k]*A[i][k])*Sum(B[j][k]*B[j][k]));
         \endverbatim
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber). B arrays are split between threads.
+
         \param [in] M - a number of A arrays.
         \param [in] N - a number of B arrays.
         \param [in] K - a size of A and B arrays.
@@ -3407,6 +3682,8 @@ extern "C"
         distances[i, j] = 1 - Sum(A[i*K + k]*B[j*K + k])/Sqrt(Sum(A[i*K + k]*A[i*K + k])*Sum(B[j*K + k]*B[j*K + k]));
         \endverbatim
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber). B arrays are split between threads.
+
         \param [in] M - a number of A arrays.
         \param [in] N - a number of B arrays.
         \param [in] K - a size of A and B arrays.
@@ -4148,6 +4425,7 @@ extern "C"
             Supported pixel formats: ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32.
         \param [in] file - a format of output image file. To auto choise format of output file set this parameter to ::SimdImageFileUndefined.
         \param [in] quality - a parameter of compression quality (if file format supports it).
+            For PNG it trades speed for size: 100 (or 0) is the best compression, lower values are faster.
         \param [out] size - a pointer to the size of output image file in bytes.
         \return a pointer to memory buffer with output image file. 
             It has to be deleted after use by function ::SimdFree. On error it returns NULL.
@@ -4235,6 +4513,78 @@ extern "C"
     */
     SIMD_API uint8_t* SimdImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format);
 
+    /*! @ingroup image_io
+
+        \fn uint8_t* SimdImageLoadFromMemoryScaled(const uint8_t* data, size_t size, size_t scale, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format);
+
+        \short Loads an image from memory buffer with reduced size.
+
+        JPEG images are decoded directly at reduced size: only low frequency DCT coefficients of every block are used, 
+        so it is much faster than decoding of full image with following downscale. Output size is equal to ceil(width / scale) x ceil(height / scale).
+        Images of other formats are loaded in original size.
+
+        \param [in] data - a pointer to memory buffer with input image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [in] scale - a scale factor of output image. It can be 1, 2, 4 or 8.
+        \param [out] stride - a pointer to row size of output image in bytes.
+        \param [out] width - a pointer to width of output image.
+        \param [out] height - a pointer to height of output image.
+        \param [in, out] format - a pointer to pixel format of output image. 
+            Here you can set desired pixel format (it can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32).
+            Or set ::SimdPixelFormatNone and use pixel format of input image file.
+        \return a pointer to pixels data of output image. 
+            It has to be deleted after use by function ::SimdFree. On error it returns NULL.
+    */
+    SIMD_API uint8_t* SimdImageLoadFromMemoryScaled(const uint8_t* data, size_t size, size_t scale, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdImageLoadFromMemoryInto(const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height, SimdPixelFormatType format);
+
+        \short Loads an image from memory buffer into preallocated output image.
+
+        The image is decoded directly into the caller's buffer, no output image is allocated. 
+        JPEG images are color-converted band by band so there is no intermediate full size buffer either,
+        and for ::SimdPixelFormatGray8 output only the luminance of YCbCr JPEG images is decoded.
+
+        \param [in] data - a pointer to memory buffer with input image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [out] dst - a pointer to pixels data of output image.
+        \param [in] stride - a row size of output image in bytes.
+        \param [in] width - a width of output image. It must be equal to the width of input image.
+        \param [in] height - a height of output image. It must be equal to the height of input image.
+        \param [in] format - a pixel format of output image. It can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, 
+            ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24 or ::SimdPixelFormatRgba32.
+        \return a result of the operation. It returns ::SimdFalse on error or if the image size does not match.
+    */
+    SIMD_API SimdBool SimdImageLoadFromMemoryInto(const uint8_t* data, size_t size, uint8_t* dst, size_t stride, size_t width, size_t height, SimdPixelFormatType format);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdImageLoadJpegToYuv420p(const uint8_t* data, size_t size, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, size_t width, size_t height, SimdYuvType yuvType);
+
+        \short Loads JPEG image from memory buffer into preallocated YUV420P planes.
+
+        The decoded YCbCr planes are written out directly without conversion to RGB: Y plane is copied, 
+        chroma planes of 4:2:0 images are copied and the ones with other subsampling are averaged to 4:2:0. 
+        Gray images get neutral chroma, RGB and CMYK images are converted.
+
+        \param [in] data - a pointer to memory buffer with input JPEG image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [out] y - a pointer to pixels data of output 8-bit image with Y color plane.
+        \param [in] yStride - a row size of the y image.
+        \param [out] u - a pointer to pixels data of output 8-bit image with U color plane.
+        \param [in] uStride - a row size of the u image.
+        \param [out] v - a pointer to pixels data of output 8-bit image with V color plane.
+        \param [in] vStride - a row size of the v image.
+        \param [in] width - a width of output image. It must be even number and equal to the width of input image.
+        \param [in] height - a height of output image. It must be even number and equal to the height of input image.
+        \param [in] yuvType - a type of output YUV image (see descriprion of ::SimdYuvType). Now only ::SimdYuvTrect871 (T-REC-T.871 format) is supported.
+        \return a result of the operation.
+    */
+    SIMD_API SimdBool SimdImageLoadJpegToYuv420p(const uint8_t* data, size_t size, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride,
+        uint8_t* v, size_t vStride, size_t width, size_t height, SimdYuvType yuvType);
+
     /*! @ingroup image_io
 
         \fn uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format);
@@ -4253,6 +4603,76 @@ extern "C"
     */
     SIMD_API uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format);
 
+    /*! @ingroup image_io
+
+        \fn void * SimdImageDecoderInit(SimdPixelFormatType format);
+
+        \short Creates context of incremental image decoder.
+
+        The decoder accepts JPEG and PNG files by parts (for example while they are received from network or read from disk) 
+        and allows to get completed rows of the image before the whole file has been received. 
+        Baseline JPEG images are decoded row of MCUs by row of MCUs, non-interlaced PNG images are decoded row by row.
+        Progressive JPEG and interlaced PNG images are decoded when the last part of the file has been received.
+
+        Typical use of the decoder:
+        \verbatim
+        void * decoder = SimdImageDecoderInit(SimdPixelFormatBgr24);
+        while (ReadNextPart(data, size) && SimdImageDecoderFeed(decoder, data, size))
+        {
+            if (SimdImageDecoderInfo(decoder, &width, &height, &format))
+                rows += SimdImageDecoderPull(decoder, image + rows * stride, stride, height - rows);
+        }
+        SimdRelease(decoder);
+        \endverbatim
+
+        \param [in] format - a desired pixel format of output image. It can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, 
+            ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32 or ::SimdPixelFormatNone (to use pixel format of input image file).
+        \return a pointer to image decoder context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdImageDecoderInit(SimdPixelFormatType format);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdImageDecoderFeed(void * decoder, const uint8_t * data, size_t size);
+
+        \short Passes next part of image file to incremental image decoder.
+
+        \param [in, out] decoder - a decoder context. It must be created by function ::SimdImageDecoderInit and released by function ::SimdRelease.
+        \param [in] data - a pointer to next part of input image file.
+        \param [in] size - a size of the part in bytes. It can be arbitrary.
+        \return ::SimdFalse if the file has unsupported format or is corrupted, otherwise ::SimdTrue.
+    */
+    SIMD_API SimdBool SimdImageDecoderFeed(void * decoder, const uint8_t * data, size_t size);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdImageDecoderInfo(const void * decoder, size_t * width, size_t * height, SimdPixelFormatType * format);
+
+        \short Gets size and pixel format of output image of incremental image decoder.
+
+        \param [in] decoder - a decoder context. It must be created by function ::SimdImageDecoderInit and released by function ::SimdRelease.
+        \param [out] width - a pointer to width of output image.
+        \param [out] height - a pointer to height of output image.
+        \param [out] format - a pointer to pixel format of output image.
+        \return ::SimdTrue if the image header has already been received and parsed, otherwise ::SimdFalse.
+    */
+    SIMD_API SimdBool SimdImageDecoderInfo(const void * decoder, size_t * width, size_t * height, SimdPixelFormatType * format);
+
+    /*! @ingroup image_io
+
+        \fn size_t SimdImageDecoderPull(void * decoder, uint8_t * dst, size_t stride, size_t rows);
+
+        \short Gets next completed rows of output image from incremental image decoder.
+
+        \param [in, out] decoder - a decoder context. It must be created by function ::SimdImageDecoderInit and released by function ::SimdRelease.
+        \param [out] dst - a pointer to buffer for next rows of output image. Rows are written in order, starting from the first row which has not been pulled yet.
+        \param [in] stride - a row size of the output buffer in bytes.
+        \param [in] rows - a maximal number of rows to write in the output buffer.
+        \return number of rows which have been written to the output buffer. It can be less than required number (or zero) 
+            if the decoder has not received enough data.
+    */
+    SIMD_API size_t SimdImageDecoderPull(void * decoder, uint8_t * dst, size_t stride, size_t rows);
+
     /*! @ingroup other_conversion
 
         \fn void SimdInt16ToGray(const uint8_t * src, size_t width, size_t height, size_t srcStride, uint8_t * dst, size_t dstStride);
@@ -5711,6 +6131,9 @@ extern "C"
 
         \short Creates resize context.
 
+        \note Resizing is performed in parallel by horizontal bands (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber). 
+            The number of threads is taken at the moment of context creation.
+
         An using example (resize of RGBA64 image):
         \verbatim
         void * resizer = SimdResizerInit(srcX, srcY, dstX, dstY, 4, SimdResizeChannelShort, SimdResizeMethodBilinear);
@@ -6680,6 +7103,68 @@ extern "C"
     SIMD_API void SimdSynetAdd8i(const uint8_t * aData, const float * aScale, const float* aShift, const uint8_t* bData, const float* bScale, const float* bShift,
         uint8_t* cData, const float* cScale, const float* cShift, size_t batch, size_t channels, size_t spatial, SimdTensorFormatType format, SimdSynetCompatibilityType compatibility);
 
+    /*! @ingroup synet_attention
+
+        \fn void* SimdSynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes fused scaled dot-product attention algorithm.
+
+        The attention is computed in blocks: products Q*K^T, softmax and multiplication by V are performed on tiles that fit in cache,
+        so the full attention matrix of size lenQ*lenKV is never stored in memory.
+
+        Algorithm's details:
+        \verbatim
+        for(b = 0; b < batch*heads; ++b)
+            for(i = 0; i < lenQ; ++i)
+            {
+                for(j = 0; j < lenKV; ++j)
+                    s[j] = (causal && j > i + lenKV - lenQ) ? -inf : scale * Dot(q[b, i], k[b, j]);
+                p = Softmax(s);
+                for(j = 0; j < lenKV; ++j)
+                    dst[b, i] += p[j] * v[b, j];
+            }
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] batch - a batch size.
+        \param [in] heads - a number of attention heads.
+        \param [in] lenQ - a length of query sequence.
+        \param [in] lenKV - a length of key and value sequences. If causal is true it must be not less then lenQ.
+        \param [in] depth - a size of each head (a length of query, key and value vectors).
+        \param [in] scale - a pointer to scale of Q*K^T product. Can be NULL (it causes usage of 1/sqrt(depth)).
+        \param [in] causal - a flag of causal mask. The mask is aligned to the end of key sequence.
+        \param [in] compatibility - a flags of calculation compatibility. ::SimdSynetCompatibility16bfSoft rounds Q, K, V and softmax output to BFloat16.
+        \return a pointer to attention context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetAttention32fInternalBufferSize, and ::SimdSynetAttention32fForward.
+    */
+    SIMD_API void* SimdSynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility);
+
+    /*! @ingroup synet_attention
+
+        \fn size_t SimdSynetAttention32fInternalBufferSize(const void* context);
+
+        \short Gets size of internal buffer used inside attention algorithm.
+
+        \param [in] context - a pointer to attention context. It must be created by function ::SimdSynetAttention32fInit and released by function ::SimdRelease.
+        \return size of internal buffer used inside attention algorithm.
+    */
+    SIMD_API size_t SimdSynetAttention32fInternalBufferSize(const void* context);
+
+    /*! @ingroup synet_attention
+
+        \fn void SimdSynetAttention32fForward(void* context, const float* q, const float* k, const float* v, float* dst);
+
+        \short Performs forward propagation of attention algorithm.
+
+        \param [in] context - a pointer to attention context. It must be created by function ::SimdSynetAttention32fInit and released by function ::SimdRelease.
+        \param [in] q - a pointer to query tensor. Its shape is [batch, heads, lenQ, depth].
+        \param [in] k - a pointer to key tensor. Its shape is [batch, heads, lenKV, depth].
+        \param [in] v - a pointer to value tensor. Its shape is [batch, heads, lenKV, depth].
+        \param [out] dst - a pointer to output tensor. Its shape is [batch, heads, lenQ, depth].
+    */
+    SIMD_API void SimdSynetAttention32fForward(void* context, const float* q, const float* k, const float* v, float* dst);
+
     /*! @ingroup synet_conversion
 
         \fn void SimdSynetConvert32fTo8u(const float * src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float * shift, uint8_t * dst, SimdSynetCompatibilityType compatibility);
@@ -6731,6 +7216,7 @@ extern "C"
         \param [in] batch - a batch size.
         \param [in] conv - a pointer to convolution parameters.
         \param [in] compatibility - a flags of calculation compatibility.
+            ::SimdSynetCompatibility16fpSoft and ::SimdSynetCompatibility16fpHard store weights of 1x1 NHWC convolutions in FP16 format (accumulation is performed in FP32).
         \return a pointer to FP32 convolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
             This pointer is used in functions ::SimdSynetConvolution32fExternalBufferSize, ::SimdSynetConvolution32fInternalBufferSize, 
             ::SimdSynetConvolution32fInfo, ::SimdSynetConvolution32fSetParams and ::SimdSynetConvolution32fForward.
@@ -6797,6 +7283,85 @@ extern "C"
     */
     SIMD_API void SimdSynetConvolution32fForward(void * context, const float * src, float * buf, float * dst);
 
+    /*! @ingroup synet_convolution_fp32
+
+        \fn SimdBool SimdSynetConvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
+        \short Changes batch size and spatial size of input tensor of FP32 convolution without its re-initialization.
+
+        Internal (reordered) weights, biases and parameters of activation function are kept, only blocking parameters of the algorithm are recomputed. 
+        Output size is calculated from the new input size and original kernel, stride, dilation and padding. 
+        Size of external buffer (see ::SimdSynetConvolution32fExternalBufferSize) can be changed after this call.
+
+        \param [in, out] context - a pointer to FP32 convolution context. It must be created by function ::SimdSynetConvolution32fInit and released by function ::SimdRelease.
+        \param [in] batch - a new batch size.
+        \param [in] srcH - a new height of input tensor.
+        \param [in] srcW - a new width of input tensor.
+        \return result of the operation. It is ::SimdFalse if the new shape is invalid or the chosen algorithm does not support reshaping (GEMM and Winograd based algorithms).
+            In this case the context is unchanged and it must be created again for the new shape.
+    */
+    SIMD_API SimdBool SimdSynetConvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
+    /*! @ingroup synet_convolution_fp32
+
+        \fn void * SimdSynetConvolution32fExportWeight(const void * context);
+
+        \short Exports internal (reordered) weights of FP32 convolution to shared read-only blob.
+
+        \note This function must be called after ::SimdSynetConvolution32fSetParams. 
+            The blob can be used in ::SimdSynetConvolution32fSetPackedParams to initialize other contexts with the same parameters 
+            without repeated reordering and without extra memory: all of them refer to the same memory.
+
+        \param [in] context - a pointer to FP32 convolution context. It must be created by function ::SimdSynetConvolution32fInit and released by function ::SimdRelease.
+        \return a pointer to the blob with packed weights. It must be released with using of function ::SimdRelease 
+            (the memory is released together with the last context or blob handle which refers to it).
+    */
+    SIMD_API void * SimdSynetConvolution32fExportWeight(const void * context);
+
+    /*! @ingroup synet_convolution_fp32
+
+        \fn SimdBool SimdSynetConvolution32fSetPackedParams(void * context, const void * packed, const float * weight, const float * bias, const float * params);
+
+        \short Sets parameters of FP32 convolution with using of shared blob with packed weights.
+
+        The context keeps a reference to the blob, so the blob handle can be released just after this call. 
+        Values stored in the blob (packed weights, and also biases and parameters of activation function for some implementations) are used instead of the given ones.
+
+        \param [in, out] context - a pointer to FP32 convolution context. It must be created by function ::SimdSynetConvolution32fInit and released by function ::SimdRelease.
+        \param [in] packed - a pointer to the blob with packed weights. It is created by function ::SimdSynetConvolution32fExportWeight or ::SimdSynetPackedWeightLoad.
+        \param [in] weight - a pointer to convolution weights. It is used only if the context does not store weights internally (see ::SimdSynetConvolution32fSetParams). Can be NULL in other case.
+        \param [in] bias - a pointer to bias. Can be NULL.
+        \param [in] params - a pointer to parameters of activation functions (see ::SimdConvolutionActivationType). Can be NULL.
+        \return result of the operation. It is ::SimdFalse if the blob was created for a context with other parameters, other implementation or on other CPU.
+            In this case the context is unchanged and ::SimdSynetConvolution32fSetParams must be used.
+    */
+    SIMD_API SimdBool SimdSynetConvolution32fSetPackedParams(void * context, const void * packed, const float * weight, const float * bias, const float * params);
+
+    /*! @ingroup synet_convolution_fp32
+
+        \fn SimdBool SimdSynetPackedWeightSave(const void * packed, const char * path);
+
+        \short Saves blob with packed weights (see ::SimdSynetConvolution32fExportWeight, ::SimdSynetConvolution8iExportWeight) to file.
+
+        \param [in] packed - a pointer to the blob with packed weights.
+        \param [in] path - a path to the file.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdSynetPackedWeightSave(const void * packed, const char * path);
+
+    /*! @ingroup synet_convolution_fp32
+
+        \fn void * SimdSynetPackedWeightLoad(const char * path);
+
+        \short Loads blob with packed weights from file saved by ::SimdSynetPackedWeightSave.
+
+        The file is mapped to memory (where it is supported), so all processes which load the same file share the same physical memory.
+
+        \param [in] path - a path to the file.
+        \return a pointer to the blob with packed weights. On error it returns NULL. It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdSynetPackedWeightLoad(const char * path);
+
     /*! @ingroup synet_convolution_int8
 
         \fn void * SimdSynetConvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
@@ -6872,6 +7437,55 @@ extern "C"
     */
     SIMD_API void SimdSynetConvolution8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst);
 
+    /*! @ingroup synet_convolution_int8
+
+        \fn SimdBool SimdSynetConvolution8iReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
+        \short Changes batch size and spatial size of input tensor of INT8 convolution without its re-initialization.
+
+        Quantized weights, biases and parameters of activation function are kept, only blocking parameters of the algorithm are recomputed. 
+        Size of external buffer (see ::SimdSynetConvolution8iExternalBufferSize) can be changed after this call.
+
+        \param [in, out] context - a pointer to INT8 convolution context. It must be created by function ::SimdSynetConvolution8iInit and released by function ::SimdRelease.
+        \param [in] batch - a new batch size.
+        \param [in] srcH - a new height of input tensor.
+        \param [in] srcW - a new width of input tensor.
+        \return result of the operation. It is ::SimdFalse if the new shape is invalid or the chosen algorithm does not support reshaping (only direct NHWC algorithm supports it).
+            In this case the context is unchanged and it must be created again for the new shape.
+    */
+    SIMD_API SimdBool SimdSynetConvolution8iReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
+    /*! @ingroup synet_convolution_int8
+
+        \fn void * SimdSynetConvolution8iExportWeight(const void * context);
+
+        \short Exports internal (quantized and reordered) weights of INT8 convolution to shared read-only blob.
+
+        \note This function must be called after ::SimdSynetConvolution8iSetParams. See also ::SimdSynetConvolution32fExportWeight.
+
+        \param [in] context - a pointer to INT8 convolution context. It must be created by function ::SimdSynetConvolution8iInit and released by function ::SimdRelease.
+        \return a pointer to the blob with packed weights. It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdSynetConvolution8iExportWeight(const void * context);
+
+    /*! @ingroup synet_convolution_int8
+
+        \fn SimdBool SimdSynetConvolution8iSetPackedParams(void * context, const void * packed, const float * weight, const float * bias, const float * params, const float * const * stats);
+
+        \short Sets parameters of INT8 convolution with using of shared blob with packed weights.
+
+        Quantized weights, biases and parameters of activation function are taken from the blob, so weight, bias and params can be NULL.
+
+        \param [in, out] context - a pointer to INT8 convolution context. It must be created by function ::SimdSynetConvolution8iInit and released by function ::SimdRelease.
+        \param [in] packed - a pointer to the blob with packed weights. It is created by function ::SimdSynetConvolution8iExportWeight or ::SimdSynetPackedWeightLoad.
+        \param [in] weight - a pointer to original (32-bit float point) convolution weights. Can be NULL.
+        \param [in] bias - a pointer to original (32-bit float point) bias. Can be NULL.
+        \param [in] params - a pointer to original (32-bit float point) parameters of activation functions. Can be NULL.
+        \param [in] stats - a pointer to pointers with statistics of input and output tensors. They must be the same as for the context the blob was exported from.
+        \return result of the operation. It is ::SimdFalse if the blob was created for a context with other parameters, other implementation or on other CPU.
+    */
+    SIMD_API SimdBool SimdSynetConvolution8iSetPackedParams(void * context, const void * packed, const float * weight, const float * bias, const float * params, const float * const * stats);
+
     /*! @ingroup synet_deconvolution_fp32
 
         \fn void * SimdSynetDeconvolution32fInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
@@ -6947,6 +7561,24 @@ extern "C"
     */
     SIMD_API void SimdSynetDeconvolution32fForward(void * context, const float * src, float * buf, float * dst);
 
+    /*! @ingroup synet_deconvolution_fp32
+
+        \fn SimdBool SimdSynetDeconvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
+        \short Changes batch size and spatial size of input tensor of FP32 deconvolution without its re-initialization.
+
+        Internal (reordered) weights, biases and parameters of activation function are kept, only blocking parameters of the algorithm are recomputed. 
+        Size of external buffer (see ::SimdSynetDeconvolution32fExternalBufferSize) can be changed after this call.
+
+        \param [in, out] context - a pointer to FP32 deconvolution context. It must be created by function ::SimdSynetDeconvolution32fInit and released by function ::SimdRelease.
+        \param [in] batch - a new batch size.
+        \param [in] srcH - a new height of input tensor.
+        \param [in] srcW - a new width of input tensor.
+        \return result of the operation. It is ::SimdFalse if the new shape is invalid or the chosen algorithm does not support reshaping (only direct NHWC 2x2 algorithm supports it).
+            In this case the context is unchanged and it must be created again for the new shape.
+    */
+    SIMD_API SimdBool SimdSynetDeconvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
     /*! @ingroup synet_other
 
         \fn void SimdSynetEltwiseLayerForward(float const * const * src, const float * weight, size_t count, size_t size, SimdSynetEltwiseOperationType type, float * dst);
@@ -7322,6 +7954,26 @@ extern "C"
     */
     SIMD_API void* SimdSynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
 
+    /*! @ingroup synet_inner_product
+
+        \fn void * SimdSynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes FP32 inner product algorithm with given compatibility flags.
+
+        It is the same as ::SimdSynetInnerProduct32fInit but allows to store weights in FP16 format.
+
+        \param [in] batch - a batch size.
+        \param [in] input - a input vector size.
+        \param [in] output - a output vector size.
+        \param [in] transpose - a flag of transposing of weight matrix.
+        \param [in] activation - an activation function type used after inner product.
+        \param [in] compatibility - a flags of calculation compatibility.
+            ::SimdSynetCompatibility16fpSoft and ::SimdSynetCompatibility16fpHard store weights in FP16 format (accumulation is performed in FP32).
+        \return a pointer to FP32 inner product context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetInnerProduct32fInternalBufferSize, :SimdSynetInnerProduct32fSetParams and ::SimdSynetInnerProduct32fForward.
+    */
+    SIMD_API void* SimdSynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+
     /*! @ingroup synet_inner_product
 
         \fn size_t SimdSynetInnerProduct32fInternalBufferSize(const void * context);
@@ -7418,6 +8070,166 @@ extern "C"
     */
     SIMD_API void SimdSynetInnerProduct8i(size_t M, size_t N, size_t K, const uint8_t * src, const int8_t * weight, int32_t * dst, SimdSynetCompatibilityType compatibility);
 
+    /*! @ingroup synet_inner_product
+
+        \fn void * SimdSynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes INT8 matrix multiplication algorithm (INT8 inner product with pre-packed weights).
+
+        Algorithm's details (quantization and dequantization are omitted):
+        \verbatim
+        for (i = 0; i < M; ++i)
+        {
+            for (j = 0; j < N; ++j)
+            {
+                sum = bias[j];
+                for (k = 0; k < K; ++k)
+                    sum += src[i * K + k] * weight[k * N + j];
+                dst[i*N + j] = Activation(sum, params, j);
+            }
+        }
+        \endverbatim
+
+        It uses the same kernels as INT8 convolution (see ::SimdSynetConvolution8iInit) with the best available instruction set (including VNNI and AMX).
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] M - a number of rows of input matrix (batch size).
+        \param [in] N - a number of columns of output matrix (output size).
+        \param [in] K - a number of columns of input matrix (input size).
+        \param [in] srcT - a type of input matrix. It can be ::SimdTensorData32f or ::SimdTensorData8u.
+        \param [in] dstT - a type of output matrix. It can be ::SimdTensorData32f or ::SimdTensorData8u.
+        \param [in] activation - an activation function type applied to output.
+        \param [in] compatibility - a flags of calculation compatibility.
+        \return a pointer to INT8 matrix multiplication context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetGemm8iExternalBufferSize, ::SimdSynetGemm8iInternalBufferSize, 
+            ::SimdSynetGemm8iInfo, ::SimdSynetGemm8iSetParams, ::SimdSynetGemm8iReshape and ::SimdSynetGemm8iForward.
+    */
+    SIMD_API void * SimdSynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+
+    /*! @ingroup synet_inner_product
+
+        \fn size_t SimdSynetGemm8iExternalBufferSize(const void * context);
+
+        \short Gets size in bytes of external temporary buffer required for INT8 matrix multiplication algorithm.
+
+        \param [in] context - a pointer to INT8 matrix multiplication context. It must be created by function ::SimdSynetGemm8iInit and released by function ::SimdRelease.
+        \return size of external temporary buffer required for INT8 matrix multiplication algorithm.
+    */
+    SIMD_API size_t SimdSynetGemm8iExternalBufferSize(const void * context);
+
+    /*! @ingroup synet_inner_product
+
+        \fn size_t SimdSynetGemm8iInternalBufferSize(const void * context);
+
+        \short Gets size of internal buffer used inside INT8 matrix multiplication algorithm.
+
+        \param [in] context - a pointer to INT8 matrix multiplication context. It must be created by function ::SimdSynetGemm8iInit and released by function ::SimdRelease.
+        \return size of internal buffer used inside INT8 matrix multiplication algorithm.
+    */
+    SIMD_API size_t SimdSynetGemm8iInternalBufferSize(const void * context);
+
+    /*! @ingroup synet_inner_product
+
+        \fn const char* SimdSynetGemm8iInfo(const void* context);
+
+        \short Gets description of internal implementation of INT8 matrix multiplication algorithm.
+
+        \param [in] context - a pointer to INT8 matrix multiplication context. It must be created by function ::SimdSynetGemm8iInit and released by function ::SimdRelease.
+        \return string with description of internal implementation of INT8 matrix multiplication algorithm.
+    */
+    SIMD_API const char* SimdSynetGemm8iInfo(const void* context);
+
+    /*! @ingroup synet_inner_product
+
+        \fn void SimdSynetGemm8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const * stats);
+
+        \short Sets weights, biases, parameters of activation function, input/output statistics required for INT8 matrix multiplication algorithm.
+
+        Weights are quantized (with per output channel scale) and packed only once in this function, so following calls of ::SimdSynetGemm8iForward don't repack them.
+
+        \param [in, out] context - a pointer to INT8 matrix multiplication context. It must be created by function ::SimdSynetGemm8iInit and released by function ::SimdRelease.
+        \param [in] weight - a pointer to original (32-bit float point) weights. The size of the array is K*N (weight[k * N + j]).
+        \param [in] bias - a pointer to original (32-bit float point) bias. The size of the array is N. Can be NULL.
+        \param [in] params - a pointer to original (32-bit float point) parameters of activation functions (see ::SimdConvolutionActivationType). Can be NULL.
+        \param [in] stats - a pointer to pointers with statistics of input(min - stats[0], max - stats[1], size K) and output(min - stats[2], max - stats[3], size N) matrices.
+    */
+    SIMD_API void SimdSynetGemm8iSetParams(void * context, const float * weight, const float * bias, const float * params, const float * const* stats);
+
+    /*! @ingroup synet_inner_product
+
+        \fn SimdBool SimdSynetGemm8iReshape(void * context, size_t M);
+
+        \short Changes number of rows of input matrix (batch size) of INT8 matrix multiplication without its re-initialization and weight repacking.
+
+        \param [in, out] context - a pointer to INT8 matrix multiplication context. It must be created by function ::SimdSynetGemm8iInit and released by function ::SimdRelease.
+        \param [in] M - a new number of rows of input matrix.
+        \return result of the operation. It is ::SimdFalse if the chosen algorithm does not support reshaping (see ::SimdSynetConvolution8iReshape).
+    */
+    SIMD_API SimdBool SimdSynetGemm8iReshape(void * context, size_t M);
+
+    /*! @ingroup synet_inner_product
+
+        \fn void SimdSynetGemm8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
+        \short Performs forward propagation of INT8 matrix multiplication algorithm.
+
+        \param [in] context - a pointer to INT8 matrix multiplication context. It must be created by function ::SimdSynetGemm8iInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to input matrix (M*K, 8-bit unsigned integer or 32-bit float).
+        \param [out] buf - a pointer to external temporary buffer. The size of the external temporary buffer is determined by function ::SimdSynetGemm8iExternalBufferSize. Can be NULL (it causes usage of internal buffer).
+        \param [out] dst - a pointer to output matrix (M*N, 8-bit unsigned integer or 32-bit float).
+    */
+    SIMD_API void SimdSynetGemm8iForward(void * context, const uint8_t * src, uint8_t * buf, uint8_t * dst);
+
+    /*! @ingroup synet_normalize
+
+        \fn void SimdSynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst);
+
+        \short Performs forward propagation of layer normalization (LayerNorm) over the last dimension.
+
+        Algorithm's details:
+        \verbatim
+        for(o = 0; o < outer; ++o)
+        {
+            mean = Sum(src[o, i]) / size;
+            var = Sum(Square(src[o, i] - mean)) / size;
+            for (i = 0; i < size; ++i)
+                dst[o, i] = (src[o, i] - mean) / Sqrt(var + eps) * scale[i] + shift[i];
+        }
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input 32-bit float tensor.
+        \param [in] outer - a number of normalized vectors (product of all dimensions except the last one).
+        \param [in] size - a size of the last dimension.
+        \param [in] scale - an array with scale parameters. The size of the array is equal to size.
+        \param [in] shift - an array with shift parameters. The size of the array is equal to size.
+        \param [in] eps - a pointer to epsilon parameter. It is used to prevent division by zero.
+        \param [out] dst - a pointer to the output 32-bit float tensor. It can be equal to src.
+    */
+    SIMD_API void SimdSynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst);
+
+    /*! @ingroup synet_normalize
+
+        \fn void SimdSynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst);
+
+        \short Performs forward propagation of layer normalization (LayerNorm) over the last dimension for BFloat16 tensors.
+
+        Statistics are accumulated in 32-bit float. Algorithm's details see in ::SimdSynetLayerNorm32f.
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] src - a pointer to the input BFloat16 tensor.
+        \param [in] outer - a number of normalized vectors (product of all dimensions except the last one).
+        \param [in] size - a size of the last dimension.
+        \param [in] scale - an array with 32-bit float scale parameters. The size of the array is equal to size.
+        \param [in] shift - an array with 32-bit float shift parameters. The size of the array is equal to size.
+        \param [in] eps - a pointer to epsilon parameter. It is used to prevent division by zero.
+        \param [out] dst - a pointer to the output BFloat16 tensor. It can be equal to src.
+    */
+    SIMD_API void SimdSynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst);
+
     /*! @ingroup synet_other
 
         \fn void SimdSynetLrnLayerCrossChannels(const float * src, size_t half, size_t channels, size_t spatial, const float * k, float * dst, SimdTensorFormatType format);
@@ -7450,6 +8262,59 @@ extern "C"
     */
     SIMD_API void SimdSynetLrnLayerCrossChannels(const float * src, size_t half, size_t channels, size_t spatial, const float * k, float * dst, SimdTensorFormatType format);
 
+    /*! @ingroup synet_matmul
+
+        \fn void* SimdSynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+
+        \short Initilizes batched matrix multiplication algorithm (C = A * B).
+
+        Algorithm's details:
+        \verbatim
+        for(b = 0; b < Max(batchA, batchB); ++b)
+            for(i = 0; i < M; ++i)
+                for(j = 0; j < N; ++j)
+                    for(k = 0; k < K; ++k)
+                        C[b, i, j] += A[batchA > 1 ? b : 0, i, k] * (transB ? B[batchB > 1 ? b : 0, j, k] : B[batchB > 1 ? b : 0, k, j]);
+        \endverbatim
+
+        \note This function is used in <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        \param [in] batchA - a batch size of matrix A.
+        \param [in] batchB - a batch size of matrix B. It must be equal to batchA or one of batches must be equal to 1 (broadcasting).
+        \param [in] M - a height of A and C matrices.
+        \param [in] N - a width of B and C matrices.
+        \param [in] K - a width of A matrix and a height of B matrix.
+        \param [in] transB - a flag of transposed B matrix (B has shape [N, K]).
+        \param [in] compatibility - a flags of calculation compatibility. ::SimdSynetCompatibility16bfSoft rounds A and B to BFloat16.
+        \return a pointer to matrix multiplication context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in functions ::SimdSynetMatMul32fInternalBufferSize, and ::SimdSynetMatMul32fForward.
+    */
+    SIMD_API void* SimdSynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+
+    /*! @ingroup synet_matmul
+
+        \fn size_t SimdSynetMatMul32fInternalBufferSize(const void* context);
+
+        \short Gets size of internal buffer used inside matrix multiplication algorithm.
+
+        \param [in] context - a pointer to matrix multiplication context. It must be created by function ::SimdSynetMatMul32fInit and released by function ::SimdRelease.
+        \return size of internal buffer used inside matrix multiplication algorithm.
+    */
+    SIMD_API size_t SimdSynetMatMul32fInternalBufferSize(const void* context);
+
+    /*! @ingroup synet_matmul
+
+        \fn void SimdSynetMatMul32fForward(void* context, const float* A, const float* B, float* C);
+
+        \short Performs forward propagation of matrix multiplication algorithm.
+
+        \param [in] context - a pointer to matrix multiplication context. It must be created by function ::SimdSynetMatMul32fInit and released by function ::SimdRelease.
+        \param [in] A - a pointer to A tensor. Its shape is [batchA, M, K].
+        \param [in] B - a pointer to B tensor. Its shape is [batchB, K, N] (or [batchB, N, K] if transB is true).
+        \param [out] C - a pointer to C tensor. Its shape is [Max(batchA, batchB), M, N].
+    */
+    SIMD_API void SimdSynetMatMul32fForward(void* context, const float* A, const float* B, float* C);
+
     /*! @ingroup synet_merged_convolution_fp32
 
         \fn void * SimdSynetMergedConvolution32fInit(size_t batch, const SimdConvolutionParameters * convs, size_t count, SimdBool add, SimdSynetCompatibilityType compatibility);
@@ -7457,7 +8322,7 @@ extern "C"
         \short Initilizes FP32 merged convolution algorithm.
 
         \param [in] batch - a batch size.
-        \param [in] convs - an array with convolutions parameters.
+        \param [in] convs - an array with convolutions parameters. Depthwise convolution may have dilation and rectangular kernel (3, 5 or 7 along each axis).
         \param [in] count - a number of merged convolutions.
         \param [in] add - a flag that signilizes if we need to add output to source value.
         \param [in] compatibility - a flags of calculation compatibility.
@@ -7528,6 +8393,25 @@ extern "C"
     */
     SIMD_API void SimdSynetMergedConvolution32fForward(void * context, const float * src, float * buf, float * dst);
 
+    /*! @ingroup synet_merged_convolution_fp32
+
+        \fn SimdBool SimdSynetMergedConvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
+        \short Changes batch size and spatial size of input tensor of FP32 merged convolution without its re-initialization.
+
+        Internal (reordered) weights, biases and parameters of activation functions are kept, only blocking parameters of the algorithm are recomputed. 
+        Sizes of all inner tensors are calculated from the new size of input tensor of the first convolution. 
+        Size of external buffer (see ::SimdSynetMergedConvolution32fExternalBufferSize) can be changed after this call.
+
+        \param [in, out] context - a pointer to FP32 merged convolution context. It must be created by function ::SimdSynetMergedConvolution32fInit and released by function ::SimdRelease.
+        \param [in] batch - a new batch size.
+        \param [in] srcH - a new height of input tensor.
+        \param [in] srcW - a new width of input tensor.
+        \return result of the operation. It is ::SimdFalse if the new shape is invalid or the chosen algorithm does not support reshaping (BF16 algorithms).
+            In this case the context is unchanged and it must be created again for the new shape.
+    */
+    SIMD_API SimdBool SimdSynetMergedConvolution32fReshape(void * context, size_t batch, size_t srcH, size_t srcW);
+
     /*! @ingroup synet_merged_convolution_int8
 
         \fn void * SimdSynetMergedConvolution8iInit(size_t batch, const SimdConvolutionParameters* convs, size_t count, SimdSynetCompatibilityType compatibility);
@@ -7535,7 +8419,7 @@ extern "C"
         \short Initilizes INT8 merged convolution algorithm.
 
         \param [in] batch - a batch size.
-        \param [in] convs - an array with convolutions parameters.
+        \param [in] convs - an array with convolutions parameters. Depthwise convolution may have dilation and rectangular kernel (3, 5 or 7 along each axis).
         \param [in] count - a number of merged convolutions.
         \param [in] compatibility - a flags of calculation compatibility.
         \return a pointer to INT8 merged convolution context. On error it returns NULL. It must be released with using of function ::SimdRelease.
@@ -7605,6 +8489,24 @@ extern "C"
     */
     SIMD_API void SimdSynetMergedConvolution8iForward(void* context, const uint8_t* src, uint8_t* buf, uint8_t* dst);
 
+    /*! @ingroup synet_other
+
+        \fn size_t SimdSynetArenaPlan(SimdSynetArenaLayer * layers, size_t layerCount, SimdSynetArenaTensor * tensors, size_t tensorCount);
+
+        \short Plans single shared memory arena for external buffers of Synet contexts and intermediate tensors of the network.
+
+        The layers are executed in the given order. External buffer of layer i is alive only during step i,
+        tensor is alive from step first to step last (inclusive). Objects which are not alive at the same time share memory.
+        All offsets are aligned by ::SimdAlignment, so the arena must be allocated with the same alignment (see ::SimdAllocate).
+
+        \param [in, out] layers - a pointer to array with layers. Their output fields (offset and size) are set by the function.
+        \param [in] layerCount - a number of layers.
+        \param [in, out] tensors - a pointer to array with intermediate tensors. Their offsets are set by the function. Can be NULL.
+        \param [in] tensorCount - a number of tensors.
+        \return total size (in bytes) of the arena.
+    */
+    SIMD_API size_t SimdSynetArenaPlan(SimdSynetArenaLayer * layers, size_t layerCount, SimdSynetArenaTensor * tensors, size_t tensorCount);
+
     /*! @ingroup synet_activation
 
         \fn void SimdSynetMish32f(const float* src, size_t size, const float* threshold, float* dst);
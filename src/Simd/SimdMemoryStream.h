@@ -55,6 +55,12 @@ namespace Simd
             _bitCount = 0;
         }
 
+        SIMD_INLINE void Rebind(const uint8_t* data, size_t size)
+        {
+            _data = data;
+            _size = size;
+        }
+
         SIMD_INLINE bool Seek(size_t pos)
         {
             if (pos <= _size)
@@ -468,6 +474,14 @@ namespace Simd
             return data;
         }
 
+        SIMD_INLINE void Discard(size_t size)
+        {
+            size = Min(size, _size);
+            memmove(_data, _data + size, _size - size);
+            _size -= size;
+            _pos = _pos > size ? _pos - size : 0;
+        }
+
         SIMD_INLINE void Reserve(size_t size)
         {
             if (size > _capacity)
@@ -25,6 +25,8 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdCpu.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -654,7 +656,7 @@ namespace Simd
         }
 #endif
 
-        void CosineDistancesMxNa16f(size_t M, size_t N, size_t K, const uint16_t* const* A, const uint16_t* const* B, float* distances)
+        static void CosineDistancesMxN16f(size_t M, size_t N, size_t K, const uint16_t* const* A, const uint16_t* const* B, float* distances, size_t stride)
         {
             const size_t L2 = Base::AlgCacheL2();
             size_t mN = AlignLoAny(L2 / 2 / K, 4);
@@ -669,37 +671,28 @@ namespace Simd
                     size_t dN = Simd::Min(N, j + mN) - j;
                     if (i == 0)
                         Squares(dN, K, B + j, bb.data + j);
-                    MacroCosineDistances(dM, dN, K, A + i, B + j, aa.data, bb.data + j, distances + i * N + j, N);
+                    MacroCosineDistances(dM, dN, K, A + i, B + j, aa.data, bb.data + j, distances + i * stride + j, stride);
                 }
             }
         }
 
-        void CosineDistancesMxNp16f(size_t M, size_t N, size_t K, const uint16_t* A, const uint16_t* B, float* distances)
+        void CosineDistancesMxNa16f(size_t M, size_t N, size_t K, const uint16_t* const* A, const uint16_t* const* B, float* distances)
         {
-            const size_t L2 = Base::AlgCacheL2();
-            size_t mN = AlignLoAny(L2 / 2 / K, 4);
-            size_t mM = AlignLoAny(L2 / 2 / K, MicroM);
-            Array32f aa(mM), bb(N);
-            Array16ucp ap(mM), bp(N);
-            for (size_t i = 0; i < M; i += mM)
+            size_t threads = Simd::RestrictRange<size_t>(M * N * K / (2 * 1024 * 1024), 1, Base::GetThreadNumber());
+            Simd::Parallel(0, N, [&](size_t thread, size_t begin, size_t end)
             {
-                size_t dM = Simd::Min(M, i + mM) - i;
-                for (size_t k = 0; k < dM; ++k)
-                    ap[k] = A + k * K;
-                Squares(dM, K, ap.data, aa.data);
-                for (size_t j = 0; j < N; j += mN)
-                {
-                    size_t dN = Simd::Min(N, j + mN) - j;
-                    if (i == 0)
-                    {
-                        for (size_t k = j, n = j + dN; k < n; ++k)
-                            bp[k] = B + k * K;
-                        Squares(dN, K, bp.data + j, bb.data + j);
-                    }
-                    MacroCosineDistances(dM, dN, K, ap.data, bp.data + j, aa.data, bb.data + j, distances + i * N + j, N);
-                }
-                A += dM * K;
-            }
+                CosineDistancesMxN16f(M, end - begin, K, A, B + begin, distances + begin, N);
+            }, threads, 4);
+        }
+
+        void CosineDistancesMxNp16f(size_t M, size_t N, size_t K, const uint16_t* A, const uint16_t* B, float* distances)
+        {
+            Array16ucp a(M), b(N);
+            for (size_t i = 0; i < M; ++i)
+                a[i] = A + i * K;
+            for (size_t j = 0; j < N; ++j)
+                b[j] = B + j * K;
+            CosineDistancesMxNa16f(M, N, K, a.data, b.data, distances);
         }
 
         void VectorNormNa16f(size_t N, size_t K, const uint16_t* const* A, float* norms)
@@ -470,15 +470,15 @@ namespace Simd
         SynetConvolution32fGemmNN::SynetConvolution32fGemmNN(const ConvParam32f & p)
             : Base::SynetConvolution32fGemmNN(p)
         {
-            _gemm.Init(InitGemmFuncs(Neon::Gemm32fNN, "Neon"));
+            _gemm.Init(InitGemmFuncs(Neon::Gemm32fNN, "Neon"), "Gemm32fNN");
             if (_param.trans && _param.group == 1)
             {
                 if (NHWC_GEMM_RUNTIME)
                 {
 #if defined(SIMD_ARM64_ENABLE)
-                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF4));
+                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF4), "Gemm32fNNcb");
 #else
-                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
 #endif
                     _nhwcWeight.Resize(_gemmCb.At(0).BufferSize(_M*_merge, _N, _K));
                 }
@@ -495,7 +495,7 @@ namespace Simd
         SynetConvolution32fGemmNT::SynetConvolution32fGemmNT(const ConvParam32f & p)
             : Base::SynetConvolution32fGemmNT(p)
         {
-            _gemm.Init(InitGemmFuncs(Neon::Gemm32fNT, "Neon"));
+            _gemm.Init(InitGemmFuncs(Neon::Gemm32fNT, "Neon"), "Gemm32fNT");
             _biasAndActivation = Neon::ConvolutionBiasAndActivation;
         }
 
@@ -575,15 +575,15 @@ namespace Simd
             }
             else
                 assert(0);
-            _gemm.Init(InitGemmFuncs(Neon::Gemm32fNN, "Neon"));
+            _gemm.Init(InitGemmFuncs(Neon::Gemm32fNN, "Neon"), "Gemm32fNN");
             if (_param.trans)
             {
                 if (NHWC_GEMM_RUNTIME)
                 {
 #if defined(SIMD_ARM64_ENABLE)
-                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF4));
+                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF4), "Gemm32fNNcb");
 #else
-                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Neon::Gemm32fNNcbBufferSize, Neon::Gemm32fNNcbReorderB, Neon::Gemm32fNNcbRun, "Neon", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
 #endif
                     _nhwcStrideW = _gemmCb.At(0).BufferSize(_M*_merge, _N, _K);
                 }
@@ -701,6 +701,7 @@ namespace Simd
         SynetConvolution32fNhwcDirect::SynetConvolution32fNhwcDirect(const ConvParam32f& p)
             : Base::SynetConvolution32fNhwcDirect(p)
         {
+            _sparse.gemm = NULL;
             //_old.enable = true;
             if (_old.enable)
             {
@@ -717,7 +718,7 @@ namespace Simd
                     if (!SetRt(p, funcs.back().alg))
                         return;
                 }
-                _run.Init(funcs);
+                _run.Init(funcs, "NhwcDirect");
             }
        }
 
@@ -757,6 +758,8 @@ namespace Simd
             {
                 return new Base::SynetConvolution32fBf16Gemm(param);
             }
+            else if (Base::Fp16Soft(compatibility) && Base::SynetConvolution32fFp16Nhwc::Preferable(param))
+                return new Base::SynetConvolution32fFp16Nhwc(param);
             else if (SynetConvolution32fDepthwiseDotProduct::Preferable(param))
                 return new SynetConvolution32fDepthwiseDotProduct(param);
             else if (SynetConvolution32fWinograd::Preferable(param))
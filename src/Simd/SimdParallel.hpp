@@ -24,14 +24,228 @@
 #ifndef __SimdParallel_hpp__
 #define __SimdParallel_hpp__
 
+#include <stdint.h>
 #include <vector>
 #include <thread>
+#include <algorithm>
 #ifndef SIMD_FUTURE_DISABLE
-#include <future>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #endif
 
 namespace Simd
 {
+#ifndef SIMD_FUTURE_DISABLE
+    /*! \brief Process-wide pool of persistent worker threads used by Simd::Parallel.
+
+        Workers are created lazily (up to std::thread::hardware_concurrency() - 1) and live until the process exits.
+        The range of every task is split into chunks, each participant owns a queue of contiguous chunks and steals 
+        chunks from the tail of other queues when its own queue is empty. Idle workers spin for a short time and then sleep.
+    */
+    class ThreadPool
+    {
+    public:
+        static ThreadPool & Global()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wakeup.notify_all();
+            for (size_t i = 0; i < _workers.size(); ++i)
+                _workers[i].join();
+        }
+
+        /*! Creates workers to be able to run tasks with given thread number (the calling thread is counted too). Returns available thread number. */
+        size_t Reserve(size_t threadNumber)
+        {
+            threadNumber = std::min<size_t>(std::min<size_t>(threadNumber, std::thread::hardware_concurrency()), size_t(QUEUE_MAX));
+            std::lock_guard<std::mutex> lock(_mutex);
+            while (_workers.size() + 1 < threadNumber)
+                _workers.push_back(std::thread(&ThreadPool::Work, this, _workers.size() + 1, _task.load(std::memory_order_acquire)));
+            return _workers.size() + 1;
+        }
+
+        /*! Executes function over range [begin, end) on the pool. Returns false if the pool is busy (nested or concurrent call). */
+        template<class Function> bool Run(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockAlign)
+        {
+            if (Inside())
+                return false;
+            std::unique_lock<std::mutex> run(_run, std::try_to_lock);
+            if (!run.owns_lock())
+                return false;
+            threadNumber = std::min<size_t>(threadNumber, Reserve(threadNumber));
+            if (threadNumber <= 1)
+                return false;
+
+            size_t size = end - begin;
+            size_t step = (size + threadNumber * CHUNK_PER_THREAD - 1) / (threadNumber * CHUNK_PER_THREAD);
+            step = std::max<size_t>((step + blockAlign - 1) / blockAlign * blockAlign, 1);
+            size_t chunks = (size + step - 1) / step;
+            threadNumber = std::min(threadNumber, chunks);
+            for (size_t t = 0; t < threadNumber; ++t)
+                _queues[t].range.store(Range(chunks * t / threadNumber, chunks * (t + 1) / threadNumber), std::memory_order_relaxed);
+
+            _function = &function;
+            _invoke = Invoke<Function>;
+            _begin = begin;
+            _end = end;
+            _step = step;
+            _pending.store(threadNumber - 1, std::memory_order_relaxed);
+            _task.store(((_task.load(std::memory_order_relaxed) >> TASK_SHIFT) + 1) << TASK_SHIFT | threadNumber, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+            }
+            _wakeup.notify_all();
+
+            Inside() = true;
+            Execute(0, threadNumber);
+            Inside() = false;
+            while (_pending.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            return true;
+        }
+
+    private:
+        enum
+        {
+            QUEUE_MAX = 256,
+            CHUNK_PER_THREAD = 4,
+            TASK_SHIFT = 16,
+            SPIN_COUNT = 1 << 10,
+        };
+
+        typedef void(*InvokePtr)(const void * function, size_t thread, size_t begin, size_t end);
+
+        struct Queue
+        {
+            std::atomic<uint64_t> range;
+            uint8_t pad[64 - sizeof(std::atomic<uint64_t>)];
+        };
+
+        Queue _queues[QUEUE_MAX];
+        std::vector<std::thread> _workers;
+        std::mutex _mutex, _run;
+        std::condition_variable _wakeup;
+        std::atomic<uint64_t> _task;
+        std::atomic<size_t> _pending;
+        const void * _function;
+        InvokePtr _invoke;
+        size_t _begin, _end, _step;
+        bool _stop;
+
+        ThreadPool()
+            : _task(0)
+            , _pending(0)
+            , _function(NULL)
+            , _invoke(NULL)
+            , _stop(false)
+        {
+        }
+
+        static bool & Inside()
+        {
+            static thread_local bool inside = false;
+            return inside;
+        }
+
+        template<class Function> static void Invoke(const void * function, size_t thread, size_t begin, size_t end)
+        {
+            (*(const Function*)function)(thread, begin, end);
+        }
+
+        static uint64_t Range(uint64_t head, uint64_t tail)
+        {
+            return tail << 32 | head;
+        }
+
+        bool PopHead(size_t queue, size_t & chunk)
+        {
+            std::atomic<uint64_t> & range = _queues[queue].range;
+            uint64_t value = range.load(std::memory_order_relaxed);
+            while (uint32_t(value) < (value >> 32))
+            {
+                if (range.compare_exchange_weak(value, value + 1, std::memory_order_acq_rel))
+                {
+                    chunk = size_t(uint32_t(value));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool PopTail(size_t queue, size_t & chunk)
+        {
+            std::atomic<uint64_t> & range = _queues[queue].range;
+            uint64_t value = range.load(std::memory_order_relaxed);
+            while (uint32_t(value) < (value >> 32))
+            {
+                if (range.compare_exchange_weak(value, value - (uint64_t(1) << 32), std::memory_order_acq_rel))
+                {
+                    chunk = size_t(value >> 32) - 1;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Execute(size_t thread, size_t threadNumber)
+        {
+            size_t chunk;
+            while (PopHead(thread, chunk))
+                Call(thread, chunk);
+            for (size_t i = 1; i < threadNumber; ++i)
+            {
+                size_t victim = (thread + i) % threadNumber;
+                while (PopTail(victim, chunk))
+                    Call(thread, chunk);
+            }
+        }
+
+        void Call(size_t thread, size_t chunk)
+        {
+            size_t begin = _begin + chunk * _step;
+            _invoke(_function, thread, begin, std::min(begin + _step, _end));
+        }
+
+        void Work(size_t thread, uint64_t done)
+        {
+            Inside() = true;
+            for (;;)
+            {
+                uint64_t task = _task.load(std::memory_order_acquire);
+                for (size_t spin = 0; (task >> TASK_SHIFT) == (done >> TASK_SHIFT) && spin < size_t(SPIN_COUNT); ++spin)
+                {
+                    std::this_thread::yield();
+                    task = _task.load(std::memory_order_acquire);
+                }
+                if ((task >> TASK_SHIFT) == (done >> TASK_SHIFT))
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wakeup.wait(lock, [&] { return _stop || (_task.load(std::memory_order_acquire) >> TASK_SHIFT) != (done >> TASK_SHIFT); });
+                    if (_stop)
+                        return;
+                    task = _task.load(std::memory_order_acquire);
+                }
+                done = task;
+                size_t threadNumber = size_t(task & ((1 << TASK_SHIFT) - 1));
+                if (thread < threadNumber)
+                {
+                    Execute(thread, threadNumber);
+                    _pending.fetch_sub(1, std::memory_order_acq_rel);
+                }
+            }
+        }
+    };
+#endif
+
     template<class Function> inline void Parallel(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockAlign = 1)
     {
 #ifdef SIMD_FUTURE_DISABLE
@@ -39,28 +253,30 @@ namespace Simd
 #else
         static const size_t threadNumberMax = std::thread::hardware_concurrency();
         threadNumber = std::min<size_t>(threadNumber, threadNumberMax);
-        if (threadNumber <= 1 || size_t(blockAlign*1.5) >= (end - begin))
+        if (threadNumber <= 1 || size_t(blockAlign*1.5) >= (end - begin) || !ThreadPool::Global().Run(begin, end, function, threadNumber, blockAlign))
             function(0, begin, end);
-        else
-        {
-            std::vector<std::future<void>> futures;
-
-            size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
-            blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
-            size_t blockBegin = begin;
-            size_t blockEnd = blockBegin + blockSize;
+#endif
+    }
 
-            for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
+    /*! Runs function(thread, yBeg, yEnd, xBeg, xEnd) over tiles of 2D range [0, sizeY) x [0, sizeX). 
+        The range is split along Y at first, X is split (in multiples of alignX) only if Y is too short to feed all threads.
+    */
+    template<class Function> inline void Parallel2d(size_t sizeY, size_t sizeX, size_t alignX, const Function & function, size_t threadNumber)
+    {
+        size_t countY = std::max<size_t>(std::min(threadNumber, sizeY), 1);
+        size_t countX = std::max<size_t>(std::min((threadNumber + countY - 1) / countY, (sizeX + alignX - 1) / alignX), 1);
+        size_t stepY = (sizeY + countY - 1) / countY;
+        size_t stepX = ((sizeX + countX - 1) / countX + alignX - 1) / alignX * alignX;
+        countY = (sizeY + stepY - 1) / stepY;
+        countX = (sizeX + stepX - 1) / stepX;
+        Parallel(0, countY * countX, [&](size_t thread, size_t begin, size_t end)
+        {
+            for (size_t tile = begin; tile < end; ++tile)
             {
-                futures.push_back(std::move(std::async(std::launch::async, [blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); })));
-                blockBegin += blockSize;
-                blockEnd = std::min(blockBegin + blockSize, end);
+                size_t y = tile / countX * stepY, x = tile % countX * stepX;
+                function(thread, y, std::min(y + stepY, sizeY), x, std::min(x + stepX, sizeX));
             }
-
-            for (size_t i = 0; i < futures.size(); ++i)
-                futures[i].wait();
-        }
-#endif
+        }, threadNumber);
     }
 }
 
@@ -27,6 +27,8 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdMath.h"
 
+#include <vector>
+
 #define SIMD_RESIZER_BICUBIC_BITS 7 // 7, 11
 
 namespace Simd
@@ -107,13 +109,25 @@ namespace Simd
     public:
         Resizer(const ResParam & param)
             : _param(param)
+            , _yBeg(0)
+            , _yEnd(param.dstH)
         {
         }
 
         virtual void Run(const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride) = 0;
 
+        void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, size_t yBeg, size_t yEnd)
+        {
+            _yBeg = yBeg;
+            _yEnd = yEnd;
+            Run(src, srcStride, dst + yBeg * dstStride, dstStride);
+            _yBeg = 0;
+            _yEnd = _param.dstH;
+        }
+
     protected:
         ResParam _param;
+        size_t _yBeg, _yEnd;
     };
 
     //---------------------------------------------------------------------------------------------
@@ -257,6 +271,23 @@ namespace Simd
         //---------------------------------------------------------------------------------------------
 
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        //---------------------------------------------------------------------------------------------
+
+        typedef void* (*ResizerInitPtr)(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        class ResizerParallel : public Resizer
+        {
+        protected:
+            std::vector<Resizer*> _resizers;
+        public:
+            ResizerParallel(const ResParam& param, Resizer* first, ResizerInitPtr init, size_t threads);
+            virtual ~ResizerParallel();
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        void* ResizerParallelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method, ResizerInitPtr init);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -31,8 +31,10 @@
 #include <limits>
 #include <algorithm>
 #include <string>
-#ifdef SIMD_RUNTIME_STATISTIC
 #include <sstream>
+#include <map>
+#include <mutex>
+#ifdef SIMD_RUNTIME_STATISTIC
 #include <iostream>
 #include <iomanip>
 #endif
@@ -41,6 +43,32 @@ namespace Simd
 {
     typedef ::std::string String;
 
+    // Process-wide database of Runtime tuning results. Each entry maps CPU identifier, name of the runtime and description 
+    // of a task (shape of its arguments) to the name of the fastest candidate, so the results can be saved to a file 
+    // and reused by other processes on the same hardware.
+    class RuntimeCache
+    {
+    public:
+        static RuntimeCache& Global();
+
+        bool Load(const String& path);
+        bool Save(const String& path) const;
+
+        bool Find(const String& runtime, const String& info, String& name) const;
+        void Update(const String& runtime, const String& info, const String& name);
+
+        void Clear();
+
+        static String CpuId();
+
+    private:
+        typedef std::map<String, String> Entries;
+        Entries _entries;
+        mutable std::mutex _mutex;
+    };
+
+    //-------------------------------------------------------------------------
+
     template <class Func, class Args> struct Runtime
     {
         SIMD_INLINE Runtime()
@@ -51,7 +79,7 @@ namespace Simd
         SIMD_INLINE ~Runtime()
         {
 #ifdef SIMD_RUNTIME_STATISTIC
-            if (!_info.empty())
+            if (!_info.empty() && _candidates.size() > 1 && _candidates[0].count)
             {
                 std::sort(_candidates.begin(), _candidates.end(), [](const Candidate & a, const Candidate & b) { return a.Mean() < b.Mean(); });
                 std::cout << "Simd::Runtime " << _info << " : ";
@@ -66,20 +94,24 @@ namespace Simd
 #endif
         }
 
-        SIMD_INLINE void Init(const Func & func)
+        SIMD_INLINE void Init(const Func & func, const String & name)
         {
             _candidates.clear();
             _candidates.push_back(Candidate(func));
             _best = &_candidates[0].func;
+            _name = name;
+            _info.clear();
         }
 
-        SIMD_INLINE void Init(const std::vector<Func> & funcs)
+        SIMD_INLINE void Init(const std::vector<Func> & funcs, const String & name)
         {
             assert(funcs.size() >= 1);
             _candidates.clear();
             for (size_t i = 0; i < funcs.size(); ++i)
                 _candidates.push_back(Candidate(funcs[i]));
             _best = funcs.size() == 1 ? &_candidates[0].func : NULL;
+            _name = name;
+            _info.clear();
         }
 
         SIMD_INLINE void Run(const Args & args)
@@ -140,18 +172,24 @@ namespace Simd
 
         Func * _best;
         Candidates _candidates;
-        String _info;
+        String _name, _info;
 
         SIMD_INLINE void Test(const Args & args)
         {
             assert(_candidates.size());
+            if (_info.empty())
+            {
+                _info = _candidates[0].func.Info(args);
+                _best = Cached();
+                if (_best)
+                {
+                    _best->Run(args);
+                    return;
+                }
+            }
             Candidate * current = Current();
             if (current)
             {
-#ifdef SIMD_RUNTIME_STATISTIC
-                if (_info.empty())
-                    _info = current->func.Info(args);
-#endif
                 int64_t start = Simd::TimeCounter();
                 current->func.Run(args);
                 current->Update(Simd::TimeCounter() - start);
@@ -159,10 +197,23 @@ namespace Simd
             else
             {
                 _best = &Best()->func;
+                RuntimeCache::Global().Update(_name, _info, _best->Name());
                 _best->Run(args);
             }
         }
 
+        SIMD_INLINE Func * Cached()
+        {
+            String name;
+            if (RuntimeCache::Global().Find(_name, _info, name))
+            {
+                for (size_t i = 0; i < _candidates.size(); ++i)
+                    if (_candidates[i].func.Name() == name)
+                        return &_candidates[i].func;
+            }
+            return NULL;
+        }
+
         SIMD_INLINE Candidate * Current()
         {
             size_t min = TEST_COUNT;
@@ -222,14 +273,12 @@ namespace Simd
             _func(args.M, args.N, args.K, args.alpha, args.A, args.lda, args.B, args.ldb, args.beta, args.C, args.ldc);
         }
 
-#ifdef SIMD_RUNTIME_STATISTIC
         SIMD_INLINE String Info(const GemmArgs & args) const
         {
             std::stringstream ss;
             ss << "Gemm [" << args.M << ", " << args.N << ", " << args.K << "]";
             return ss.str();
         }
-#endif
 
     private:
         Func _func;
@@ -280,14 +329,12 @@ namespace Simd
             _run(args.M, args.N, args.K, args.A, args.pB, args.C, _type, _type != GemmKernelAny);
         }
 
-#ifdef SIMD_RUNTIME_STATISTIC
         SIMD_INLINE String Info(const GemmCbArgs & args) const
         {
             std::stringstream ss;
             ss << "GemmCb [" << args.M << ", " << args.N << ", " << args.K << "]";
             return ss.str();
         }
-#endif 
         
         SIMD_INLINE GemmKernelType Type() const { return _type; }
 
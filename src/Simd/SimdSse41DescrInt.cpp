@@ -30,6 +30,8 @@
 #include "Simd/SimdDescrIntCommon.h"
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdFloat16.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -114,6 +116,11 @@ namespace Simd
         DescrInt::DescrInt(size_t size, size_t depth)
             : Base::DescrInt(size, depth)
         {
+            if (_depth < 4)
+            {
+                _cosineDistance = GetCosineDistanceBits(_depth);
+                return;
+            }
             _minMax32f = MinMax32f;
             _minMax16f = MinMax16f;
             _encode32f = GetEncode32f(_depth);
@@ -139,10 +146,19 @@ namespace Simd
 
         void DescrInt::CosineDistancesMxNa(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances) const
         {
-            if(_unpSize * _microNu > Base::AlgCacheL1() || N * 2 < _microNu || _depth == 8)
-                CosineDistancesDirect(M, N, A, B, distances);
-            else
-                CosineDistancesUnpack(M, N, A, B, distances);
+            bool bits = _depth < 4, direct = _unpSize * _microNu > Base::AlgCacheL1() || N * 2 < _microNu || _depth == 8;
+            size_t align = bits ? 4 : (direct ? _microNd : _microNu);
+            size_t threads = Simd::RestrictRange<size_t>(M * N * _size / (2 * 1024 * 1024), 1, Base::GetThreadNumber());
+            Simd::Parallel(0, N, [&](size_t thread, size_t begin, size_t end)
+            {
+                size_t dN = end - begin;
+                if (bits)
+                    CosineDistancesBits(M, dN, A, B + begin, distances + begin, N);
+                else if (direct)
+                    CosineDistancesDirect(M, dN, A, B + begin, distances + begin, N);
+                else
+                    CosineDistancesUnpack(M, dN, A, B + begin, distances + begin, N, threads);
+            }, threads, align);
         }
 
         void DescrInt::CosineDistancesMxNp(size_t M, size_t N, const uint8_t* A, const uint8_t* B, float* distances) const
@@ -156,7 +172,7 @@ namespace Simd
             CosineDistancesMxNa(M, N, a.data, b.data, distances);
         }
 
-        void DescrInt::CosineDistancesDirect(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances) const
+        void DescrInt::CosineDistancesDirect(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances, size_t stride) const
         {
             const size_t L2 = Base::AlgCacheL2();
             size_t mN = AlignLoAny(L2 / _encSize, _microNd);
@@ -167,15 +183,32 @@ namespace Simd
                 for (size_t j = 0; j < N; j += mN)
                 {
                     size_t dN = Simd::Min(N, j + mN) - j;
-                    _macroCosineDistancesDirect(dM, dN, A + i, B + j, _size, distances + i * N + j, N);
+                    _macroCosineDistancesDirect(dM, dN, A + i, B + j, _size, distances + i * stride + j, stride);
+                }
+            }
+        }
+
+        void DescrInt::CosineDistancesBits(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances, size_t stride) const
+        {
+            size_t mN = Simd::Max<size_t>(AlignLoAny(Base::AlgCacheL2() / _encSize, 4), 4);
+            for (size_t j = 0; j < N; j += mN)
+            {
+                size_t dN = Simd::Min(N, j + mN) - j;
+                for (size_t i = 0; i < M; ++i)
+                {
+                    const uint8_t* a = A[i];
+                    float* d = distances + i * stride + j;
+                    for (size_t n = 0; n < dN; ++n)
+                        _cosineDistance(a, B[j + n], _size, d + n);
                 }
             }
         }
 
-        void DescrInt::CosineDistancesUnpack(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances) const
+        void DescrInt::CosineDistancesUnpack(size_t M, size_t N, const uint8_t* const* A, const uint8_t* const* B, float* distances, size_t stride, size_t threads) const
         {
-            size_t macroM = AlignLoAny(Base::AlgCacheL2() / _unpSize, _microMu);
-            size_t macroN = AlignLoAny(Base::AlgCacheL3() / _unpSize, _microNu);
+            const size_t L2 = Base::AlgCacheL2(), L3 = Base::AlgCacheL3();
+            size_t macroM = AlignLoAny(L2 / _unpSize, _microMu);
+            size_t macroN = AlignLoAny((threads > 1 ? L2 : L3) / _unpSize, _microNu);
             size_t sizeA = Min(macroM, M), sizeB = AlignHi(Min(macroN, N), _microNu);
             Array8u dA(sizeA * _unpSize), dB(sizeB * _unpSize);
             Array32f nA(sizeA * 4), nB(sizeB * 4);
@@ -189,7 +222,7 @@ namespace Simd
                     size_t dN = Simd::Min(N, j + macroN) - j;
                     _unpackNormB(dN, B + j, nB.data, dN);
                     _unpackDataB(dN, B + j, _size, dB.data, 1);
-                    _macroCosineDistancesUnpack(dM, dN, _size, dA.data, nA.data, dB.data, nB.data, distances + i * N + j, N);
+                    _macroCosineDistancesUnpack(dM, dN, _size, dA.data, nA.data, dB.data, nB.data, distances + i * stride + j, stride);
                 }
             }
         }
@@ -0,0 +1,56 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdDescrInt.h"
+#include "Simd/SimdDescrIntCommon.h"
+
+namespace Simd
+{
+#ifdef SIMD_SSE41_ENABLE    
+    namespace Sse41
+    {
+        template<int bits> void CosineDistanceBits(const uint8_t* a, const uint8_t* b, size_t size, float* distance)
+        {
+            size_t plane = size / 8;
+            uint32_t abSum = 0;
+            for (int p = 0; p < bits; ++p)
+                for (int q = 0; q < bits; ++q)
+                    abSum += PopcountAnd(a + 16 + p * plane, b + 16 + q * plane, plane) << (p + q);
+            Base::DecodeCosineDistance(a, b, float(abSum), distance);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        Base::DescrInt::CosineDistancePtr GetCosineDistanceBits(size_t depth)
+        {
+            switch (depth)
+            {
+            case 1: return CosineDistanceBits<1>;
+            case 2: return CosineDistanceBits<2>;
+            case 3: return CosineDistanceBits<3>;
+            default: assert(0); return NULL;
+            }
+        }
+    }
+#endif
+}
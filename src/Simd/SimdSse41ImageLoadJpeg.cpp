@@ -26,6 +26,7 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 #include "Simd/SimdSse41.h"
 
 namespace Simd
@@ -309,6 +310,9 @@ namespace Simd
 
             int scan_n, order[4];
             int restart_interval, todo;
+            int block; // size of decoded block: 8 or 4, 2, 1 for reduced size decoding
+            int luma_only; // only the Y component of a YCbCr image is needed (gray output)
+            int idct_n; // only the first idct_n components are transformed, the others are only entropy decoded
 
             // kernels
             void (*idct_block_kernel)(jpeg_uc* out, int out_stride, short data[64]);
@@ -1053,7 +1057,8 @@ namespace Simd
                         for (i = 0; i < w; ++i) {
                             int ha = z->img_comp[n].ha;
                             if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2, data);
+                            if (n < z->idct_n)
+                                z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * z->block + i * z->block, z->img_comp[n].w2, data);
                             // every data block is an MCU, so countdown the restart interval
                             if (--z->todo <= 0) {
                                 if (z->code_bits < 24) jpeg__grow_buffer_unsafe(z);
@@ -1078,11 +1083,12 @@ namespace Simd
                                 // by the basic H and V specified for the component
                                 for (y = 0; y < z->img_comp[n].v; ++y) {
                                     for (x = 0; x < z->img_comp[n].h; ++x) {
-                                        int x2 = (i * z->img_comp[n].h + x) * 8;
-                                        int y2 = (j * z->img_comp[n].v + y) * 8;
+                                        int x2 = (i * z->img_comp[n].h + x) * z->block;
+                                        int y2 = (j * z->img_comp[n].v + y) * z->block;
                                         int ha = z->img_comp[n].ha;
                                         if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-                                        z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
+                                        if (n < z->idct_n)
+                                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
                                     }
                                 }
                             }
@@ -1163,6 +1169,100 @@ namespace Simd
             }
         }
 
+        // decode MCUs [beg, end) of a baseline scan; the entropy decoder must be positioned at the start of the restart interval
+        static int jpeg__decode_restart_interval(jpeg__jpeg* z, int beg, int end)
+        {
+            int m, k, x, y;
+            JPEG_SIMD_ALIGN(short, data[64]);
+            jpeg__jpeg_reset(z);
+            if (z->scan_n == 1) {
+                int n = z->order[0];
+                int w = (z->img_comp[n].x + 7) >> 3;
+                int ha = z->img_comp[n].ha;
+                for (m = beg; m < end; ++m) {
+                    int i = m % w, j = m / w;
+                    if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                    if (n < z->idct_n)
+                        z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * z->block + i * z->block, z->img_comp[n].w2, data);
+                }
+            }
+            else {
+                for (m = beg; m < end; ++m) {
+                    int i = m % z->img_mcu_x, j = m / z->img_mcu_x;
+                    for (k = 0; k < z->scan_n; ++k) {
+                        int n = z->order[k];
+                        for (y = 0; y < z->img_comp[n].v; ++y) {
+                            for (x = 0; x < z->img_comp[n].h; ++x) {
+                                int x2 = (i * z->img_comp[n].h + x) * z->block;
+                                int y2 = (j * z->img_comp[n].v + y) * z->block;
+                                int ha = z->img_comp[n].ha;
+                                if (!jpeg__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                                if (n < z->idct_n)
+                                    z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
+                            }
+                        }
+                    }
+                }
+            }
+            return 1;
+        }
+
+        // Restart intervals of a baseline scan are independent: the entropy decoder and the DC prediction are reset
+        // at each RSTn marker. So if the whole stream is in memory we find the interval boundaries with a fast byte
+        // scan and decode the intervals in parallel. Returns -1 if the scan has to be decoded sequentially.
+        static int jpeg__parse_entropy_coded_data_parallel(jpeg__jpeg* z)
+        {
+            if (z->progressive || z->restart_interval == 0 || z->s->io.read)
+                return -1;
+            int total = z->scan_n == 1 ?
+                ((z->img_comp[z->order[0]].x + 7) >> 3) * ((z->img_comp[z->order[0]].y + 7) >> 3) :
+                z->img_mcu_x * z->img_mcu_y;
+            int count = (total + z->restart_interval - 1) / z->restart_interval;
+            size_t threads = Simd::Min<size_t>(Base::GetThreadNumber(), count);
+            if (threads < 2)
+                return -1;
+
+            std::vector<jpeg_uc*> bounds(1, z->s->img_buffer);
+            jpeg_uc* p = z->s->img_buffer, * e = z->s->img_buffer_end, marker = JPEG__MARKER_none;
+            for (; p + 1 < e; ++p) {
+                if (p[0] != 0xff || p[1] == 0xff)
+                    continue;
+                if (p[1] == 0x00)
+                    ++p;
+                else if (JPEG__RESTART(p[1]))
+                    bounds.push_back(++p + 1);
+                else {
+                    marker = p[1];
+                    break;
+                }
+            }
+            if (marker == JPEG__MARKER_none || (int)bounds.size() != count)
+                return -1;
+            bounds.push_back(p);
+
+            std::vector<jpeg__context> contexts(threads, *z->s);
+            std::vector<jpeg__jpeg> decoders(threads, *z);
+            std::vector<int> results(count, 0);
+            for (size_t t = 0; t < threads; ++t)
+                decoders[t].s = &contexts[t];
+            Simd::Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+            {
+                jpeg__jpeg* d = &decoders[thread];
+                for (size_t i = begin; i < end; ++i) {
+                    d->s->img_buffer = bounds[i];
+                    d->s->img_buffer_end = bounds[i + 1];
+                    results[i] = jpeg__decode_restart_interval(d, (int)i * z->restart_interval, Simd::Min((int)i * z->restart_interval + z->restart_interval, total));
+                }
+            }, threads, 1);
+            for (int i = 0; i < count; ++i)
+                if (!results[i])
+                    return 0;
+
+            z->s->img_buffer = p + 2;
+            z->marker = marker;
+            return 1;
+        }
+
         static void jpeg__jpeg_dequantize(short* data, jpeg__uint16* dequant)
         {
             int i;
@@ -1182,7 +1282,8 @@ namespace Simd
                         for (i = 0; i < w; ++i) {
                             short* data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
                             jpeg__jpeg_dequantize(data, z->dequant[z->img_comp[n].tq]);
-                            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2, data);
+                            if (n < z->idct_n)
+                                z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * z->block + i * z->block, z->img_comp[n].w2, data);
                         }
                     }
                 }
@@ -1417,8 +1518,8 @@ namespace Simd
                 //
                 // img_mcu_x, img_mcu_y: <=17 bits; comp[i].h and .v are <=4 (checked earlier)
                 // so these muls can't overflow with 32-bit ints (which we require)
-                z->img_comp[i].w2 = z->img_mcu_x * z->img_comp[i].h * 8;
-                z->img_comp[i].h2 = z->img_mcu_y * z->img_comp[i].v * 8;
+                z->img_comp[i].w2 = z->img_mcu_x * z->img_comp[i].h * z->block;
+                z->img_comp[i].h2 = z->img_mcu_y * z->img_comp[i].v * z->block;
                 z->img_comp[i].coeff = 0;
                 z->img_comp[i].raw_coeff = 0;
                 z->img_comp[i].linebuf = NULL;
@@ -1428,10 +1529,9 @@ namespace Simd
                 // align blocks for idct using mmx/sse
                 z->img_comp[i].data = (jpeg_uc*)(((size_t)z->img_comp[i].raw_data + 15) & ~15);
                 if (z->progressive) {
-                    // w2, h2 are multiples of 8 (see above)
-                    z->img_comp[i].coeff_w = z->img_comp[i].w2 / 8;
-                    z->img_comp[i].coeff_h = z->img_comp[i].h2 / 8;
-                    z->img_comp[i].raw_coeff = jpeg__malloc_mad3(z->img_comp[i].w2, z->img_comp[i].h2, sizeof(short), 15);
+                    z->img_comp[i].coeff_w = z->img_mcu_x * z->img_comp[i].h;
+                    z->img_comp[i].coeff_h = z->img_mcu_y * z->img_comp[i].v;
+                    z->img_comp[i].raw_coeff = jpeg__malloc_mad3(z->img_comp[i].coeff_w * 64, z->img_comp[i].coeff_h, sizeof(short), 15);
                     if (z->img_comp[i].raw_coeff == NULL)
                         return jpeg__free_jpeg_components(z, i + 1, JpegLoadError("outofmem", "Out of memory"));
                     z->img_comp[i].coeff = (short*)(((size_t)z->img_comp[i].raw_coeff + 15) & ~15);
@@ -1475,6 +1575,17 @@ namespace Simd
         }
 
         // decode image to YCbCr format
+        static int jpeg__is_rgb(jpeg__jpeg* z)
+        {
+            return z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
+        }
+
+        // the chroma components of a YCbCr image are not transformed when only the luma is needed
+        static void jpeg__setup_idct_n(jpeg__jpeg* z)
+        {
+            z->idct_n = z->luma_only && z->s->img_n == 3 && !jpeg__is_rgb(z) ? 1 : 4;
+        }
+
         static int jpeg__decode_jpeg_image(jpeg__jpeg* j)
         {
             int m;
@@ -1488,7 +1599,10 @@ namespace Simd
             while (!jpeg__EOI(m)) {
                 if (jpeg__SOS(m)) {
                     if (!jpeg__process_scan_header(j)) return 0;
-                    if (!jpeg__parse_entropy_coded_data(j)) return 0;
+                    jpeg__setup_idct_n(j);
+                    int result = jpeg__parse_entropy_coded_data_parallel(j);
+                    if (result < 0) result = jpeg__parse_entropy_coded_data(j);
+                    if (!result) return 0;
                     if (j->marker == JPEG__MARKER_none) {
                         // handle 0s at the end of image data from IP Kamera 9060
                         while (!jpeg__at_eof(j->s)) {
@@ -1748,7 +1862,7 @@ namespace Simd
                 out[0] = (jpeg_uc)r;
                 out[1] = (jpeg_uc)g;
                 out[2] = (jpeg_uc)b;
-                out[3] = 255;
+                if (step == 4) out[3] = 255;
                 out += step;
             }
         }
@@ -1882,7 +1996,7 @@ namespace Simd
                 out[0] = (jpeg_uc)r;
                 out[1] = (jpeg_uc)g;
                 out[2] = (jpeg_uc)b;
-                out[3] = 255;
+                if (step == 4) out[3] = 255;
                 out += step;
             }
         }
@@ -1891,6 +2005,9 @@ namespace Simd
         // set up the kernels
         static void jpeg__setup_jpeg(jpeg__jpeg* j)
         {
+            j->block = 8;
+            j->luma_only = 0;
+            j->idct_n = 4;
             j->idct_block_kernel = jpeg__idct_block;
             j->YCbCr_to_RGB_kernel = jpeg__YCbCr_to_RGB_row;
             j->resample_row_hv_2_kernel = jpeg__resample_row_hv_2;
@@ -1910,6 +2027,29 @@ namespace Simd
 #endif
         }
 
+        // set up reduced size decoding: every 8x8 block is decoded to 4x4 (scale = 2), 2x2 (scale = 4) or 1x1 (scale = 8) pixels
+        static void jpeg__setup_scale(jpeg__jpeg* j, int scale)
+        {
+            j->block = 8 / scale;
+            switch (j->block) {
+            case 4: j->idct_block_kernel = Base::JpegIdct4x4; break;
+            case 2: j->idct_block_kernel = Base::JpegIdct2x2; break;
+            case 1: j->idct_block_kernel = Base::JpegIdct1x1; break;
+            }
+        }
+
+        // after reduced size decoding the image and component planes are 8 / block times smaller
+        static void jpeg__scale_dimensions(jpeg__jpeg* z)
+        {
+            int i, scale = 8 / z->block;
+            z->s->img_x = (z->s->img_x + scale - 1) / scale;
+            z->s->img_y = (z->s->img_y + scale - 1) / scale;
+            for (i = 0; i < z->s->img_n; ++i) {
+                z->img_comp[i].x = (z->img_comp[i].x + scale - 1) / scale;
+                z->img_comp[i].y = (z->img_comp[i].y + scale - 1) / scale;
+            }
+        }
+
         // clean up the temporary component buffers
         static void jpeg__cleanup_jpeg(jpeg__jpeg* j)
         {
@@ -1933,184 +2073,184 @@ namespace Simd
             return (jpeg_uc)((t + (t >> 8)) >> 8);
         }
 
-        static jpeg_uc* load_jpeg_image(jpeg__jpeg* z, int* out_x, int* out_y, int* comp, int req_comp)
-        {
-            int n, decode_n, is_rgb;
-            z->s->img_n = 0; // make jpeg__cleanup_jpeg safe
-
-            // validate req_comp
-            if (req_comp < 0 || req_comp > 4) return jpeg__errpuc("bad req_comp", "Internal error");
-
-            // load a jpeg image from whichever source, but leave in YCbCr format
-            if (!jpeg__decode_jpeg_image(z)) { jpeg__cleanup_jpeg(z); return NULL; }
-
-            // determine actual number of components to generate
-            n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
-
-            is_rgb = z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
-
-            if (z->s->img_n == 3 && n < 3 && !is_rgb)
-                decode_n = 1;
-            else
-                decode_n = z->s->img_n;
-
-            // resample and color-convert
-            {
-                int k;
-                unsigned int i, j;
-                jpeg_uc* output;
-                jpeg_uc* coutput[4] = { NULL, NULL, NULL, NULL };
-
-                jpeg__resample res_comp[4];
-
-                for (k = 0; k < decode_n; ++k) {
-                    jpeg__resample* r = &res_comp[k];
-
-                    // allocate line buffer big enough for upsampling off the edges
-                    // with upsample factor of 4
-                    z->img_comp[k].linebuf = (jpeg_uc*)jpeg__malloc(z->s->img_x + 3);
-                    if (!z->img_comp[k].linebuf) { jpeg__cleanup_jpeg(z); return jpeg__errpuc("outofmem", "Out of memory"); }
-
-                    r->hs = z->img_h_max / z->img_comp[k].h;
-                    r->vs = z->img_v_max / z->img_comp[k].v;
-                    r->ystep = r->vs >> 1;
-                    r->w_lores = (z->s->img_x + r->hs - 1) / r->hs;
-                    r->ypos = 0;
-                    r->line0 = r->line1 = z->img_comp[k].data;
-
-                    if (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
-                    else if (r->hs == 1 && r->vs == 2) r->resample = jpeg__resample_row_v_2;
-                    else if (r->hs == 2 && r->vs == 1) r->resample = jpeg__resample_row_h_2;
-                    else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
-                    else                               r->resample = jpeg__resample_row_generic;
-                }
-
-                // can't error after this so, this is safe
-                output = (jpeg_uc*)jpeg__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
-                if (!output) { jpeg__cleanup_jpeg(z); return jpeg__errpuc("outofmem", "Out of memory"); }
-
-                // now go ahead and resample
-                for (j = 0; j < z->s->img_y; ++j) {
-                    jpeg_uc* out = output + n * z->s->img_x * j;
-                    for (k = 0; k < decode_n; ++k) {
-                        jpeg__resample* r = &res_comp[k];
-                        int y_bot = r->ystep >= (r->vs >> 1);
-                        coutput[k] = r->resample(z->img_comp[k].linebuf,
-                            y_bot ? r->line1 : r->line0,
-                            y_bot ? r->line0 : r->line1,
-                            r->w_lores, r->hs);
-                        if (++r->ystep >= r->vs) {
-                            r->ystep = 0;
-                            r->line0 = r->line1;
-                            if (++r->ypos < z->img_comp[k].y)
-                                r->line1 += z->img_comp[k].w2;
+        static void jpeg__convert_row(jpeg__jpeg* z, jpeg_uc* out, jpeg_uc* coutput[4], int n, int is_rgb)
+        {
+            unsigned int i;
+            if (n >= 3) {
+                jpeg_uc* y = coutput[0];
+                if (z->s->img_n == 3) {
+                    if (is_rgb) {
+                        for (i = 0; i < z->s->img_x; ++i) {
+                            out[0] = y[i];
+                            out[1] = coutput[1][i];
+                            out[2] = coutput[2][i];
+                            if (n == 4) out[3] = 255;
+                            out += n;
                         }
                     }
-                    if (n >= 3) {
-                        jpeg_uc* y = coutput[0];
-                        if (z->s->img_n == 3) {
-                            if (is_rgb) {
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    out[0] = y[i];
-                                    out[1] = coutput[1][i];
-                                    out[2] = coutput[2][i];
-                                    out[3] = 255;
-                                    out += n;
-                                }
-                            }
-                            else {
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                            }
+                    else {
+                        z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+                    }
+                }
+                else if (z->s->img_n == 4) {
+                    if (z->app14_color_transform == 0) { // CMYK
+                        for (i = 0; i < z->s->img_x; ++i) {
+                            jpeg_uc m = coutput[3][i];
+                            out[0] = jpeg__blinn_8x8(coutput[0][i], m);
+                            out[1] = jpeg__blinn_8x8(coutput[1][i], m);
+                            out[2] = jpeg__blinn_8x8(coutput[2][i], m);
+                            if (n == 4) out[3] = 255;
+                            out += n;
                         }
-                        else if (z->s->img_n == 4) {
-                            if (z->app14_color_transform == 0) { // CMYK
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    jpeg_uc m = coutput[3][i];
-                                    out[0] = jpeg__blinn_8x8(coutput[0][i], m);
-                                    out[1] = jpeg__blinn_8x8(coutput[1][i], m);
-                                    out[2] = jpeg__blinn_8x8(coutput[2][i], m);
-                                    out[3] = 255;
-                                    out += n;
-                                }
-                            }
-                            else if (z->app14_color_transform == 2) { // YCCK
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                                for (i = 0; i < z->s->img_x; ++i) {
-                                    jpeg_uc m = coutput[3][i];
-                                    out[0] = jpeg__blinn_8x8(255 - out[0], m);
-                                    out[1] = jpeg__blinn_8x8(255 - out[1], m);
-                                    out[2] = jpeg__blinn_8x8(255 - out[2], m);
-                                    out += n;
-                                }
-                            }
-                            else { // YCbCr + alpha?  Ignore the fourth channel for now
-                                z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                            }
+                    }
+                    else if (z->app14_color_transform == 2) { // YCCK
+                        z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+                        for (i = 0; i < z->s->img_x; ++i) {
+                            jpeg_uc m = coutput[3][i];
+                            out[0] = jpeg__blinn_8x8(255 - out[0], m);
+                            out[1] = jpeg__blinn_8x8(255 - out[1], m);
+                            out[2] = jpeg__blinn_8x8(255 - out[2], m);
+                            out += n;
                         }
-                        else
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                out[0] = out[1] = out[2] = y[i];
-                                out[3] = 255; // not used if n==3
-                                out += n;
-                            }
                     }
+                    else { // YCbCr + alpha?  Ignore the fourth channel for now
+                        z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+                    }
+                }
+                else
+                    for (i = 0; i < z->s->img_x; ++i) {
+                        out[0] = out[1] = out[2] = y[i];
+                        if (n == 4) out[3] = 255;
+                        out += n;
+                    }
+            }
+            else {
+                if (is_rgb) {
+                    if (n == 1)
+                        for (i = 0; i < z->s->img_x; ++i)
+                            *out++ = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
                     else {
-                        if (is_rgb) {
-                            if (n == 1)
-                                for (i = 0; i < z->s->img_x; ++i)
-                                    *out++ = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                            else {
-                                for (i = 0; i < z->s->img_x; ++i, out += 2) {
-                                    out[0] = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                                    out[1] = 255;
-                                }
-                            }
-                        }
-                        else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                jpeg_uc m = coutput[3][i];
-                                jpeg_uc r = jpeg__blinn_8x8(coutput[0][i], m);
-                                jpeg_uc g = jpeg__blinn_8x8(coutput[1][i], m);
-                                jpeg_uc b = jpeg__blinn_8x8(coutput[2][i], m);
-                                out[0] = jpeg__compute_y(r, g, b);
-                                out[1] = 255;
-                                out += n;
-                            }
-                        }
-                        else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
-                            for (i = 0; i < z->s->img_x; ++i) {
-                                out[0] = jpeg__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
-                                out[1] = 255;
-                                out += n;
-                            }
-                        }
-                        else {
-                            jpeg_uc* y = coutput[0];
-                            if (n == 1)
-                                for (i = 0; i < z->s->img_x; ++i) out[i] = y[i];
-                            else
-                                for (i = 0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
+                        for (i = 0; i < z->s->img_x; ++i, out += 2) {
+                            out[0] = jpeg__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+                            out[1] = 255;
                         }
                     }
                 }
-                jpeg__cleanup_jpeg(z);
-                *out_x = z->s->img_x;
-                *out_y = z->s->img_y;
-                if (comp) *comp = z->s->img_n >= 3 ? 3 : 1; // report original components, not output
-                return output;
+                else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
+                    for (i = 0; i < z->s->img_x; ++i) {
+                        jpeg_uc m = coutput[3][i];
+                        jpeg_uc r = jpeg__blinn_8x8(coutput[0][i], m);
+                        jpeg_uc g = jpeg__blinn_8x8(coutput[1][i], m);
+                        jpeg_uc b = jpeg__blinn_8x8(coutput[2][i], m);
+                        out[0] = jpeg__compute_y(r, g, b);
+                        out[1] = 255;
+                        out += n;
+                    }
+                }
+                else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
+                    for (i = 0; i < z->s->img_x; ++i) {
+                        out[0] = jpeg__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
+                        out[1] = 255;
+                        out += n;
+                    }
+                }
+                else {
+                    jpeg_uc* y = coutput[0];
+                    if (n == 1)
+                        for (i = 0; i < z->s->img_x; ++i) out[i] = y[i];
+                    else
+                        for (i = 0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
+                }
+            }
+        }
+
+        // sets the resampler state to the state it has before output row 'row' when rows are processed in order from 0
+        static void jpeg__resample_seek(jpeg__resample* r, jpeg_uc* data, int w2, int h, int row)
+        {
+            int pos = (r->vs >> 1) + row;
+            r->ystep = pos % r->vs;
+            r->ypos = pos / r->vs;
+            r->line1 = data + w2 * Simd::Min(r->ypos, h - 1);
+            r->line0 = r->ypos ? data + w2 * Simd::Min(r->ypos - 1, h - 1) : data;
+        }
+
+        static void jpeg__resample_rows(jpeg__jpeg* z, const jpeg__resample* res_comp, int decode_n, jpeg_uc* output, size_t stride, int n, int is_rgb, int thread, int begin, int end)
+        {
+            int j, k;
+            jpeg_uc* coutput[4] = { NULL, NULL, NULL, NULL };
+            jpeg__resample res[4];
+            for (k = 0; k < decode_n; ++k) {
+                res[k] = res_comp[k];
+                jpeg__resample_seek(res + k, z->img_comp[k].data, z->img_comp[k].w2, z->img_comp[k].y, begin);
+            }
+            for (j = begin; j < end; ++j) {
+                jpeg_uc* out = output + stride * (j - begin);
+                for (k = 0; k < decode_n; ++k) {
+                    jpeg__resample* r = res + k;
+                    int y_bot = r->ystep >= (r->vs >> 1);
+                    coutput[k] = r->resample(z->img_comp[k].linebuf + (size_t)thread * (z->s->img_x + 3),
+                        y_bot ? r->line1 : r->line0,
+                        y_bot ? r->line0 : r->line1,
+                        r->w_lores, r->hs);
+                    if (++r->ystep >= r->vs) {
+                        r->ystep = 0;
+                        r->line0 = r->line1;
+                        if (++r->ypos < z->img_comp[k].y)
+                            r->line1 += z->img_comp[k].w2;
+                    }
+                }
+                jpeg__convert_row(z, out, coutput, n, is_rgb);
             }
         }
 
-        static void* jpeg__jpeg_load(jpeg__context* s, int* x, int* y, int* comp, int req_comp, jpeg__result_info* ri)
+        // decodes the image into component planes (it stays in YCbCr format), returns the number of components to generate
+        static int jpeg__decode_image(jpeg__jpeg* z, int req_comp, int* decode_n, int* is_rgb)
         {
-            unsigned char* result;
-            jpeg__jpeg* j = (jpeg__jpeg*)jpeg__malloc(sizeof(jpeg__jpeg));
-            JPEG_NOTUSED(ri);
-            j->s = s;
-            jpeg__setup_jpeg(j);
-            result = load_jpeg_image(j, x, y, comp, req_comp);
-            JPEG_FREE(j);
-            return result;
+            int n;
+            z->s->img_n = 0; // make jpeg__cleanup_jpeg safe
+
+            if (!jpeg__decode_jpeg_image(z)) { jpeg__cleanup_jpeg(z); return 0; }
+
+            if (z->block < 8)
+                jpeg__scale_dimensions(z);
+
+            // determine actual number of components to generate
+            n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
+
+            *is_rgb = jpeg__is_rgb(z);
+
+            if (z->s->img_n == 3 && n < 3 && !*is_rgb)
+                *decode_n = 1;
+            else
+                *decode_n = z->s->img_n;
+            return n;
+        }
+
+        static int jpeg__setup_resample(jpeg__jpeg* z, jpeg__resample* res_comp, int decode_n, int threads)
+        {
+            int k;
+            for (k = 0; k < decode_n; ++k) {
+                jpeg__resample* r = &res_comp[k];
+
+                // allocate line buffer (one per thread) big enough for upsampling off the edges
+                // with upsample factor of 4
+                z->img_comp[k].linebuf = (jpeg_uc*)jpeg__malloc_mad2(threads, z->s->img_x + 3, 0);
+                if (!z->img_comp[k].linebuf) return JpegLoadError("outofmem", "Out of memory");
+
+                r->hs = z->img_h_max / z->img_comp[k].h;
+                r->vs = z->img_v_max / z->img_comp[k].v;
+                r->ystep = r->vs >> 1;
+                r->w_lores = (z->s->img_x + r->hs - 1) / r->hs;
+                r->ypos = 0;
+                r->line0 = r->line1 = z->img_comp[k].data;
+
+                if (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
+                else if (r->hs == 1 && r->vs == 2) r->resample = jpeg__resample_row_v_2;
+                else if (r->hs == 2 && r->vs == 1) r->resample = jpeg__resample_row_h_2;
+                else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
+                else                               r->resample = jpeg__resample_row_generic;
+            }
+            return 1;
         }
 
         static int jpeg__jpeg_test(jpeg__context* s)
@@ -2169,6 +2309,61 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        static void JpegRgbToAny(const uint8_t* rgb, size_t width, size_t height, size_t rgbStride, SimdPixelFormatType format, uint8_t* dst, size_t dstStride)
+        {
+            switch (format)
+            {
+            case SimdPixelFormatGray8:
+                Sse41::RgbToGray(rgb, width, height, rgbStride, dst, dstStride);
+                break;
+            case SimdPixelFormatBgr24:
+                Sse41::BgrToRgb(rgb, width, height, rgbStride, dst, dstStride);
+                break;
+            case SimdPixelFormatBgra32:
+                Sse41::RgbToBgra(rgb, width, height, rgbStride, dst, dstStride, 0xFF);
+                break;
+            case SimdPixelFormatRgb24:
+                Base::Copy(rgb, rgbStride, width, height, 3, dst, dstStride);
+                break;
+            case SimdPixelFormatRgba32:
+                Sse41::BgrToBgra(rgb, width, height, rgbStride, dst, dstStride, 0xFF);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // resamples and color-converts the decoded image band by band straight into the output image, no full size intermediate buffer is used
+        static bool JpegToImage(jpeg__jpeg* z, int n, int decode_n, int is_rgb, SimdPixelFormatType format, uint8_t* dst, size_t stride)
+        {
+            const int BAND = 16;
+            jpeg__resample res[4];
+            size_t threads = Base::GetThreadNumber();
+            if (!jpeg__setup_resample(z, res, decode_n, (int)threads))
+                return false;
+            size_t width = z->s->img_x;
+            bool direct = format == SimdPixelFormatGray8 || format == SimdPixelFormatRgb24;
+            Array8u rgb(direct ? 0 : threads * 3 * width * BAND);
+            Simd::Parallel(0, z->s->img_y, [&](size_t thread, size_t begin, size_t end)
+            {
+                if (direct)
+                    jpeg__resample_rows(z, res, decode_n, dst + begin * stride, stride, n, is_rgb, (int)thread, (int)begin, (int)end);
+                else
+                {
+                    uint8_t* buf = rgb.data + thread * 3 * width * BAND;
+                    for (size_t row = begin; row < end; row += BAND)
+                    {
+                        size_t band = Simd::Min<size_t>(end - row, BAND);
+                        jpeg__resample_rows(z, res, decode_n, buf, 3 * width, 3, is_rgb, (int)thread, (int)row, (int)(row + band));
+                        JpegRgbToAny(buf, width, band, 3 * width, format, dst + row * stride, stride);
+                    }
+                }
+            }, threads, 8);
+            return true;
+        }
+
+        //---------------------------------------------------------------------
+
         ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
             : Base::ImageJpegLoader(param)
         {
@@ -2178,48 +2373,26 @@ namespace Simd
 
         bool ImageJpegLoader::FromStream()
         {
-            int x, y, comp;
             jpeg__context s;
-            s.io.eof = jpeg__stdio_eof;
-            s.io.read = jpeg__stdio_read;
-            s.io.skip = jpeg__stdio_skip;
-            s.io_user_data = &_stream;
-            s.buflen = sizeof(s.buffer_start);
-            s.read_from_callbacks = 1;
+            s.io.read = NULL;
+            s.read_from_callbacks = 0;
             s.callback_already_read = 0;
-            s.img_buffer = s.img_buffer_original = s.buffer_start;
-            jpeg__refill_buffer(&s);
-            s.img_buffer_original_end = s.img_buffer_end;
-            jpeg__result_info ri;
-            uint8_t * data = (uint8_t*)jpeg__jpeg_load(&s, &x, &y, &comp, 3, &ri);
-            if (data)
+            s.img_buffer = s.img_buffer_original = (jpeg_uc*)_stream.Current();
+            s.img_buffer_end = s.img_buffer_original_end = (jpeg_uc*)_stream.Data() + _stream.Size();
+            jpeg__jpeg* j = (jpeg__jpeg*)jpeg__malloc(sizeof(jpeg__jpeg));
+            j->s = &s;
+            jpeg__setup_jpeg(j);
+            jpeg__setup_scale(j, (int)_param.scale);
+            j->luma_only = _param.format == SimdPixelFormatGray8;
+            int decode_n, is_rgb, n = jpeg__decode_image(j, j->luma_only ? 1 : 3, &decode_n, &is_rgb);
+            bool result = false;
+            if (n)
             {
-                size_t stride = 3 * x;
-                _image.Recreate(x, y, (Image::Format)_param.format);
-                switch (_param.format)
-                {
-                case SimdPixelFormatGray8:
-                    Sse41::RgbToGray(data, x, y, stride, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatBgr24:
-                    Sse41::BgrToRgb(data, x, y, stride, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatBgra32:
-                    Sse41::RgbToBgra(data, x, y, stride, _image.data, _image.stride, 0xFF);
-                    break;
-                case SimdPixelFormatRgb24:
-                    Base::Copy(data, stride, x, y, 3, _image.data, _image.stride);
-                    break;
-                case SimdPixelFormatRgba32:
-                    Sse41::BgrToBgra(data, x, y, stride, _image.data, _image.stride, 0xFF);
-                    break;
-                default: 
-                    break;
-                }
-                JPEG_FREE(data);
-                return true;
+                result = InitImage(s.img_x, s.img_y) && JpegToImage(j, n, decode_n, is_rgb, _param.format, _image.data, _image.stride);
+                jpeg__cleanup_jpeg(j);
             }
-            return false;
+            JPEG_FREE(j);
+            return result;
         }
     }
 #endif
@@ -470,12 +470,12 @@ namespace Simd
         SynetConvolution32fGemmNN::SynetConvolution32fGemmNN(const ConvParam32f& p)
             : Base::SynetConvolution32fGemmNN(p)
         {
-            _gemm.Init(InitGemmFuncs(Sse41::Gemm32fNN, "Sse41"));
+            _gemm.Init(InitGemmFuncs(Sse41::Gemm32fNN, "Sse41"), "Gemm32fNN");
             if (_param.trans && _param.group == 1)
             {
                 if (GemmRuntime())
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Sse41::Gemm32fNNcbBufferSize, Sse41::Gemm32fNNcbReorderB, Sse41::Gemm32fNNcbRun, "Sse41", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Sse41::Gemm32fNNcbBufferSize, Sse41::Gemm32fNNcbReorderB, Sse41::Gemm32fNNcbRun, "Sse41", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcWeight.Resize(_gemmCb.At(0).BufferSize(_M * _merge, _N, _K));
                 }
                 else
@@ -491,7 +491,7 @@ namespace Simd
         SynetConvolution32fGemmNT::SynetConvolution32fGemmNT(const ConvParam32f& p)
             : Base::SynetConvolution32fGemmNT(p)
         {
-            _gemm.Init(InitGemmFuncs(Sse41::Gemm32fNT, "Sse41"));
+            _gemm.Init(InitGemmFuncs(Sse41::Gemm32fNT, "Sse41"), "Gemm32fNT");
             _biasAndActivation = Sse41::ConvolutionBiasAndActivation;
         }
 
@@ -562,12 +562,12 @@ namespace Simd
             }
             else
                 assert(0);
-            _gemm.Init(InitGemmFuncs(Sse41::Gemm32fNN, "Sse41"));
+            _gemm.Init(InitGemmFuncs(Sse41::Gemm32fNN, "Sse41"), "Gemm32fNN");
             if (_param.trans)
             {
                 if (NHWC_GEMM_RUNTIME)
                 {
-                    _gemmCb.Init(InitGemmCbFuncs(Sse41::Gemm32fNNcbBufferSize, Sse41::Gemm32fNNcbReorderB, Sse41::Gemm32fNNcbRun, "Sse41", GemmKernelF2, GemmKernelF3));
+                    _gemmCb.Init(InitGemmCbFuncs(Sse41::Gemm32fNNcbBufferSize, Sse41::Gemm32fNNcbReorderB, Sse41::Gemm32fNNcbRun, "Sse41", GemmKernelF2, GemmKernelF3), "Gemm32fNNcb");
                     _nhwcStrideW = _gemmCb.At(0).BufferSize(_M * _merge, _N, _K);
                 }
                 else
@@ -648,6 +648,7 @@ namespace Simd
         SynetConvolution32fNhwcDirect::SynetConvolution32fNhwcDirect(const ConvParam32f& p)
             : Base::SynetConvolution32fNhwcDirect(p)
         {
+            _sparse.gemm = NULL;
             //_old.enable = true;
             if (_old.enable)
             {
@@ -664,7 +665,7 @@ namespace Simd
                     if (!SetRt(p, funcs.back().alg))
                         return;
                 }
-                _run.Init(funcs);
+                _run.Init(funcs, "NhwcDirect");
             }
         }
 
@@ -711,6 +712,8 @@ namespace Simd
                 else
                     return new Base::SynetConvolution32fBf16Gemm(param);
             }
+            else if (Base::Fp16Soft(compatibility) && Base::SynetConvolution32fFp16Nhwc::Preferable(param))
+                return new Base::SynetConvolution32fFp16Nhwc(param);
             else if (SynetConvolution32fDepthwiseDotProduct::Preferable(param))
                 return new SynetConvolution32fDepthwiseDotProduct(param);
             else if (SynetConvolution32fWinograd::Preferable(param))
@@ -38,6 +38,7 @@ namespace Simd
             : Base::SynetInnerProduct32fGemm(p)
         {
             _biasAndActivation = Sse41::ConvolutionBiasAndActivation;
+            _sparseGemm = NULL;
             if (_param.transpose)
             {
                 _gemm = Sse41::Gemm32fNT;
@@ -54,7 +55,8 @@ namespace Simd
             {
                 _cbRun = Sse41::Gemm32fNNcbRun;
                 _cbPack = Sse41::Gemm32fNNcbReorderB;
-                _cbWeight.Resize(Sse41::Gemm32fNNcbBufferSize(_M, _N, _K, GemmKernelAny, NHWC_GEMM_COMPATIBLE));
+                _cbSize = Sse41::Gemm32fNNcbBufferSize(_M, _N, _K, GemmKernelAny, NHWC_GEMM_COMPATIBLE);
+                _cbWeight.Resize(_cbSize);
             }
         }
 
@@ -218,9 +220,16 @@ namespace Simd
 
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation)
         {
-            InnerProductParam32f param(batch, input, output, transpose, activation);
+            return SynetInnerProduct32fInitV2(batch, input, output, transpose, activation, SimdSynetCompatibilityDefault);
+        }
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+        {
+            InnerProductParam32f param(batch, input, output, transpose, activation, compatibility);
             if (!param.Valid())
                 return NULL;
+            if (Base::Fp16Soft(compatibility))
+                return new Base::SynetInnerProduct32fFp16(param);
             if (SynetInnerProduct32fProd::Preferable(param))
                 return new SynetInnerProduct32fProd(param);
             else
@@ -75,12 +75,12 @@ namespace Simd
                             __m128 sum = _mm_setzero_ps();
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 if (sy < p.srcH)
                                 {
                                     for (size_t kx = 0; kx < p.kernelX; ++kx)
                                     {
-                                        size_t sx = dx * strideX + kx - padX;
+                                        size_t sx = dx * strideX + kx * p.dilationX - padX;
                                         if (sx < p.srcW)
                                         {
                                             const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -106,10 +106,10 @@ namespace Simd
                             __m128 sum = _mm_setzero_ps();
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * p.strideY + ky - padY;
+                                size_t sy = dy * p.strideY + ky * p.dilationY - padY;
                                 for (size_t kx = 0; kx < p.kernelX; ++kx)
                                 {
-                                    size_t sx = dx * p.strideX + kx - padX;
+                                    size_t sx = dx * p.strideX + kx * p.dilationX - padX;
                                     if (sx < p.srcW)
                                     {
                                         const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -133,9 +133,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m128 w0 = _mm_loadu_ps(pw);
                                     sum0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ps + 0 * ssX), w0), sum0);
@@ -166,9 +166,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m128 w0 = _mm_loadu_ps(pw);
                                     sum0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ps + 0 * ssX), w0), sum0);
@@ -189,9 +189,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m128 w0 = _mm_loadu_ps(pw);
                                     sum0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ps + 0 * ssX), w0), sum0);
@@ -207,9 +207,9 @@ namespace Simd
                             const float* pw = weight;
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 const float* ps = src + (sy & sM) * sY + (dx * strideX - padX) * sX;
-                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += sX, pw += F)
+                                for (size_t kx = 0; kx < p.kernelX; ++kx, ps += p.dilationX * sX, pw += F)
                                 {
                                     __m128 w0 = _mm_loadu_ps(pw);
                                     sum = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ps), w0), sum);
@@ -222,10 +222,10 @@ namespace Simd
                             __m128 sum = _mm_setzero_ps();
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 for (size_t kx = 0; kx < p.kernelX; ++kx)
                                 {
-                                    size_t sx = dx * strideX + kx - padX;
+                                    size_t sx = dx * strideX + kx * p.dilationX - padX;
                                     if (sx < p.srcW)
                                     {
                                         const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -244,12 +244,12 @@ namespace Simd
                             __m128 sum = _mm_setzero_ps();
                             for (size_t ky = 0; ky < p.kernelY; ++ky)
                             {
-                                size_t sy = dy * strideY + ky - padY;
+                                size_t sy = dy * strideY + ky * p.dilationY - padY;
                                 if (sy < p.srcH)
                                 {
                                     for (size_t kx = 0; kx < p.kernelX; ++kx)
                                     {
-                                        size_t sx = dx * strideX + kx - padX;
+                                        size_t sx = dx * strideX + kx * p.dilationX - padX;
                                         if (sx < p.srcW)
                                         {
                                             const float* pw = weight + (ky * p.kernelX + kx) * F;
@@ -25,6 +25,7 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdMath.h"
 #include "Simd/SimdExtract.h"
+#include "Simd/SimdSse41.h"
 
 namespace Simd
 {
@@ -501,6 +502,64 @@ namespace Simd
             else
                 assert(0);
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE void LayerNorm32f(const float* src, size_t size, const float* scale, const float* shift, float k, float eps, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i;
+            __m128 _sum = _mm_setzero_ps();
+            for (i = 0; i < sizeF; i += F)
+                _sum = _mm_add_ps(_mm_loadu_ps(src + i), _sum);
+            float sum = ExtractSum(_sum);
+            for (; i < size; ++i)
+                sum += src[i];
+            float mean = sum * k;
+            __m128 _mean = _mm_set1_ps(mean), _sqsum = _mm_setzero_ps();
+            for (i = 0; i < sizeF; i += F)
+            {
+                __m128 _dst = _mm_sub_ps(_mm_loadu_ps(src + i), _mean);
+                _mm_storeu_ps(dst + i, _dst);
+                _sqsum = _mm_add_ps(_mm_mul_ps(_dst, _dst), _sqsum);
+            }
+            float sqsum = ExtractSum(_sqsum);
+            for (; i < size; ++i)
+            {
+                dst[i] = src[i] - mean;
+                sqsum += Simd::Square(dst[i]);
+            }
+            float norm = 1.0f / ::sqrt(sqsum * k + eps);
+            __m128 _norm = _mm_set1_ps(norm);
+            for (i = 0; i < sizeF; i += F)
+                _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(dst + i), _norm), _mm_loadu_ps(scale + i)), _mm_loadu_ps(shift + i)));
+            for (; i < size; ++i)
+                dst[i] = dst[i] * norm * scale[i] + shift[i];
+        }
+
+        void SynetLayerNorm32f(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst)
+        {
+            float k = 1.0f / float(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                LayerNorm32f(src, size, scale, shift, k, *eps, dst);
+                src += size;
+                dst += size;
+            }
+        }
+
+        void SynetLayerNorm16b(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst)
+        {
+            float k = 1.0f / float(size);
+            Array32f buf(size);
+            for (size_t o = 0; o < outer; ++o)
+            {
+                BFloat16ToFloat32(src, size, buf.data);
+                LayerNorm32f(buf.data, size, scale, shift, k, *eps, buf.data);
+                Float32ToBFloat16(buf.data, size, dst);
+                src += size;
+                dst += size;
+            }
+        }
     }
 #endif
 }
@@ -26,6 +26,7 @@
 
 #include "Simd/SimdMath.h"
 #include "Simd/SimdUnpack.h"
+#include "Simd/SimdBase.h"
 
 namespace Simd
 {
@@ -115,6 +116,23 @@ namespace Simd
             return (compatibility & SimdSynetCompatibility16bfMask) == SimdSynetCompatibility16bfHard;
         }
 
+        SIMD_INLINE bool Fp16Soft(SimdSynetCompatibilityType compatibility)
+        {
+            return (compatibility & SimdSynetCompatibility16fpMask) == SimdSynetCompatibility16fpSoft;
+        }
+
+        SIMD_INLINE bool Fp16Hard(SimdSynetCompatibilityType compatibility)
+        {
+            return (compatibility & SimdSynetCompatibility16fpMask) == SimdSynetCompatibility16fpHard;
+        }
+
+        const int64_t SYNET_THREAD_FLOP_MIN = 4 * 1024 * 1024;
+
+        SIMD_INLINE size_t SynetThreadNumber(int64_t flop)
+        {
+            return Simd::Max<size_t>(Simd::Min<size_t>(Base::GetThreadNumber(), size_t(flop / SYNET_THREAD_FLOP_MIN)), 1);
+        }
+
         //---------------------------------------------------------------------
 
         SIMD_INLINE uint8_t SynetConvert32fTo8u(float value, float scale, float shift, int lower, int upper)
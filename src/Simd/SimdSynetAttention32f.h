@@ -0,0 +1,127 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetAttention32f_h__
+#define __SimdSynetAttention32f_h__
+
+#include "Simd/SimdArray.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdPerformance.h"
+
+namespace Simd
+{
+    struct AttentionParam32f
+    {
+        size_t batch, heads, lenQ, lenKV, depth;
+        float scale;
+        SimdBool causal;
+        SimdSynetCompatibilityType compatibility;
+
+        AttentionParam32f(size_t b, size_t h, size_t q, size_t kv, size_t d, const float* s, SimdBool c, SimdSynetCompatibilityType comp)
+            : batch(b), heads(h), lenQ(q), lenKV(kv), depth(d), causal(c), compatibility(comp)
+        {
+            scale = s ? *s : (d ? 1.0f / ::sqrt(float(d)) : 1.0f);
+        }
+
+        bool Valid() const
+        {
+            return batch && heads && lenQ && lenKV && depth && (!causal || lenKV >= lenQ);
+        }
+    };
+
+    namespace Base
+    {
+        class SynetAttention32f : public Deletable
+        {
+        public:
+            SynetAttention32f(const AttentionParam32f& p);
+            virtual String Ext() const { return "Base"; }
+            virtual String Desc() const;
+
+            size_t InternalBufferSize() const
+            {
+                return _buffer.RawSize();
+            }
+
+            void Forward(const float* q, const float* k, const float* v, float* dst);
+
+            typedef void(*MulPtr)(size_t M, size_t N, size_t K, const float* A, size_t strideM, size_t strideK, const float* B, size_t ldb, float* C, size_t ldc, int update);
+            typedef void(*SoftmaxPtr)(float* src, size_t stride, size_t rows, size_t cols, ptrdiff_t first, float scale, float* max, float* sum, float* corr);
+            typedef void(*ScalePtr)(const float* src, size_t size, float scale, float* dst);
+            typedef void(*RoundPtr)(const float* src, size_t size, float* dst);
+
+            static const size_t Align = 16;
+
+        protected:
+            void ForwardTile(const float* q, const float* k, const float* v, size_t q0, size_t qN, float* buf, float* dst);
+
+            AttentionParam32f _param;
+            bool _bf16;
+            size_t _blockQ, _blockQA, _blockKV, _depthA, _threadSize;
+            Array32f _buffer;
+            MulPtr _mul;
+            SoftmaxPtr _softmax;
+            ScalePtr _scale;
+            RoundPtr _round;
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility);
+    }
+
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        class SynetAttention32f : public Base::SynetAttention32f
+        {
+        public:
+            SynetAttention32f(const AttentionParam32f& p);
+            virtual String Ext() const { return "Avx2"; }
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+    namespace Avx512bw
+    {
+        class SynetAttention32f : public Avx2::SynetAttention32f
+        {
+        public:
+            SynetAttention32f(const AttentionParam32f& p);
+            virtual String Ext() const { return "Avx512bw"; }
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetAttention32fInit(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+}
+
+#endif
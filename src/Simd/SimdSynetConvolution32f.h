@@ -28,6 +28,8 @@
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdRuntime.h"
 #include "Simd/SimdGemm.h"
+#include "Simd/SimdSynetPackedWeight.h"
+#include "Simd/SimdSynetSparse32f.h"
 
 #ifdef _N
 #undef _N
@@ -94,6 +96,16 @@ namespace Simd
         return (p.padX + p.srcW - (p.kernelX - 1) * p.dilationX - 1) / p.strideX + 1;
     }
 
+    SIMD_INLINE size_t KernelH(const SimdConvolutionParameters& p)
+    {
+        return (p.kernelY - 1) * p.dilationY + 1;
+    }
+
+    SIMD_INLINE size_t KernelW(const SimdConvolutionParameters& p)
+    {
+        return (p.kernelX - 1) * p.dilationX + 1;
+    }
+
     //---------------------------------------------------------------------------------------------
 
     struct ConvParam32f : public SimdConvolutionParameters
@@ -122,6 +134,19 @@ namespace Simd
                 srcT == SimdTensorData32f && dstT == SimdTensorData32f && srcF == dstF && (srcF == SimdTensorFormatNchw || srcF == SimdTensorFormatNhwc);
         }
 
+        bool Reshape(size_t batch, size_t srcH, size_t srcW)
+        {
+            size_t kernelH = dilationY * (kernelY - 1) + 1, kernelW = dilationX * (kernelX - 1) + 1;
+            if (batch == 0 || srcH + padY + padH < kernelH || srcW + padX + padW < kernelW)
+                return false;
+            this->batch = batch;
+            this->srcH = srcH;
+            this->srcW = srcW;
+            this->dstH = (srcH + padY + padH - kernelH) / strideY + 1;
+            this->dstW = (srcW + padX + padW - kernelW) / strideX + 1;
+            return Valid();
+        }
+
         SIMD_INLINE bool IsKernel(size_t value) const
         {
             return kernelY == value && kernelX == value;
@@ -259,6 +284,11 @@ namespace Simd
 
         virtual void Forward(const float * src, float * buf, float * dst) = 0;
 
+        SynetPackedWeight Export();
+        bool SetPackedParams(const SynetPackedWeight & packed, const float * weight, const float * bias, const float * params);
+
+        bool Reshape(size_t batch, size_t srcH, size_t srcW);
+
         float * Buffer(float * buffer)
         {
             if (buffer)
@@ -285,6 +315,16 @@ namespace Simd
         typedef void(*NhwcRun)(size_t M, size_t N, size_t K, const float * A, const float * B, float * C, GemmKernelType type, bool compatibility);
         typedef void(*BiasAndActivation)(const float * bias, size_t count, size_t size, ::SimdConvolutionActivationType activation, const float * params, SimdBool trans, float * dst);
 
+        virtual void Pack(SynetPackedWeight::Visitor & visitor)
+        {
+            visitor(_nhwcWeight);
+        }
+
+        virtual bool SetShape(const ConvParam32f & p)
+        {
+            return false;
+        }
+
         ConvParam32f _param;
         Array32f _buffer;
         float _0, _1;
@@ -295,6 +335,7 @@ namespace Simd
         NhwcRun _nhwcRun;
         NhwcReorderB _nhwcReorderB;
         BiasAndActivation _biasAndActivation;
+        SynetPackedWeight _packed;
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
         Base::PerformanceMeasurer * _perf;
 #endif
@@ -371,6 +412,8 @@ namespace Simd
                 return p.batch * _count * p.srcC * _tileH * _tileW * p.dstC * 2 ;
             }
 #endif
+            virtual void Pack(SynetPackedWeight::Visitor& visitor);
+
             size_t _count, _blockY, _blockX, _tileH, _tileW, _strideW, _strideS, _strideD, _M, _N, _K, _batch, _sizeS, _sizeD, _nhwcStrideW, _merge, _split, _tileHs;
             Array32f _winogradWeight;
             SetFilter _setFilter;
@@ -393,6 +436,7 @@ namespace Simd
         protected:
             void Pad(const float * src, float * dst) const;
             virtual ConvolutionBiasActivationPtr SetConvolutionBiasActivation();
+            virtual bool SetShape(const ConvParam32f & p);
 
             size_t _grW, _grS, _grD, _srcC, _srcH, _srcW, _dstC;
             int _pad;
@@ -412,6 +456,7 @@ namespace Simd
             typedef void(*ConvolutionBiasActivationPtr)(const float * src, const ConvParam32f & p, const float * weight, const float * bias, const float * params, float * dst);
         protected:
             virtual ConvolutionBiasActivationPtr SetConvolutionBiasActivation(); 
+            virtual bool SetShape(const ConvParam32f & p);
 
             size_t _batch, _sizeS, _sizeD;
             ConvolutionBiasActivationPtr _convolutionBiasActivation;
@@ -437,6 +482,7 @@ namespace Simd
             SynetConvolution32fNhwcDirect(const ConvParam32f & p);
             virtual String Ext() const { return "Base"; }
             virtual String Desc() const { return Ext() + "::NhwcDirect" + (_old.enable ? "-f" : "-r"); }
+            virtual size_t ExternalBufferSize() const;
             virtual size_t InternalBufferSize() const;
             virtual void SetParams(const float * weight, SimdBool * internal, const float * bias, const float * params);
             virtual void Forward(const float * src, float * buf, float * dst);
@@ -458,16 +504,21 @@ namespace Simd
             typedef void(*OldConvolutionPtr)(const float* src, const ConvParam32f& p, const AlgParam& a, const float* weight, const float* bias, const float* params, float* dst);
 
         protected:
-            size_t _sizeS, _sizeD;
+            virtual void Pack(SynetPackedWeight::Visitor& visitor);
+            virtual bool SetShape(const ConvParam32f& p);
+
+            size_t _sizeS, _sizeD, _threads;
             Array32f _rWeight, _rBias, _rParams;
 
-            static void Forward(const float* src, const ConvParam32f& p, const AlgParam& a, const float* weight, const float* bias, const float* params, float* dst);
+            static void Forward(const float* src, const ConvParam32f& p, const AlgParam& a, const float* weight, const float* bias, const float* params, float* dst, size_t threads);
+            static void Forward(const float* src, const ConvParam32f& p, const AlgParam& a, size_t dcBeg, size_t dcEnd, size_t yBeg, size_t yEnd, 
+                const float* weight, const float* bias, const float* params, float* dst);
 
             struct RunArgs
             {
-                const float* src; const ConvParam32f& p; const float* weight; const float* bias; const float* params; float* dst;
-                SIMD_INLINE RunArgs(const float* src_, const ConvParam32f& p_, const float* weight_, const float* bias_, const float* params_, float* dst_)
-                    :src(src_), p(p_), weight(weight_), bias(bias_), params(params_), dst(dst_)
+                const float* src; const ConvParam32f& p; const float* weight; const float* bias; const float* params; float* dst; size_t threads;
+                SIMD_INLINE RunArgs(const float* src_, const ConvParam32f& p_, const float* weight_, const float* bias_, const float* params_, float* dst_, size_t threads_)
+                    :src(src_), p(p_), weight(weight_), bias(bias_), params(params_), dst(dst_), threads(threads_)
                 {}
             };
 
@@ -482,17 +533,15 @@ namespace Simd
 
                 SIMD_INLINE void Run(const RunArgs& args)
                 {
-                    Forward(args.src, args.p, alg, args.weight, args.bias, args.params, args.dst);
+                    Forward(args.src, args.p, alg, args.weight, args.bias, args.params, args.dst, args.threads);
                 }
 
-#ifdef SIMD_RUNTIME_STATISTIC
                 SIMD_INLINE String Info(const RunArgs& args) const
                 {
                     std::stringstream ss;
                     ss << "NhwcDirect [" << args.p.Info() << "]";
                     return ss.str();
                 }
-#endif
 
                 AlgParam alg;
             private:
@@ -512,6 +561,15 @@ namespace Simd
             void OldSetAlgParam(size_t F);
             void OldReorderWeight(const float* src, float* dst);
 
+            struct Sparse
+            {
+                SynetSparse32f weight;
+                SynetSparse32f::GemmPtr gemm;
+                size_t macroM, sizeB;
+            } _sparse;
+            void SparseSetAlgParam();
+            void SparseForward(const float* src, float* buf, float* dst);
+
             void SetAlgParam(size_t F, size_t N, AlgParam & alg);
             void ReorderWeight(const float* src, float* dst);
         };
@@ -532,6 +590,7 @@ namespace Simd
             void ImgToCol(const float* src, uint16_t* dst);
             void ImgToRow(const float* src, uint16_t* dst);
             void GemmNN(size_t M, size_t N, size_t K, const uint16_t* A, size_t lda, const uint16_t* B, size_t ldb, float* C, size_t ldc);
+            virtual void Pack(SynetPackedWeight::Visitor& visitor);
 
             Array16u _weight;
             size_t _M, _N, _K, _ldW, _ldS, _ldD, _grW, _grS, _grD, _batch, _sizeS, _sizeB, _sizeD;
@@ -571,6 +630,7 @@ namespace Simd
             void ForwardConv(const float* src, uint16_t* buf, float* dst);
             void ForwardGemm(const float* src, uint16_t* buf, float* dst);
             size_t Offset(size_t yBeg, size_t cBeg, size_t cEnd);
+            virtual void Pack(SynetPackedWeight::Visitor& visitor);
 
             Array16u _weight;
             Array32f _bias, _params;
@@ -581,6 +641,33 @@ namespace Simd
 
         //-----------------------------------------------------------------------------------------
 
+        class SynetConvolution32fFp16Nhwc : public SynetConvolution32f
+        {
+        public:
+            SynetConvolution32fFp16Nhwc(const ConvParam32f& p);
+            virtual String Ext() const { return "Base"; }
+            virtual String Desc() const { return Ext() + "::Fp16Nhwc"; }
+            virtual size_t InternalBufferSize() const;
+            virtual void SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params);
+            virtual void Forward(const float* src, float* buf, float* dst);
+
+            static bool Preferable(const ConvParam32f& p);
+
+            typedef void(*GemmPtr)(const float* src, size_t M, size_t K, const uint16_t* weight, size_t N, const float* bias, float* dst);
+
+        protected:
+            virtual void Pack(SynetPackedWeight::Visitor& visitor);
+            virtual bool SetShape(const ConvParam32f& p);
+            void SetSize(size_t F);
+
+            GemmPtr _gemm;
+            Array16u _rWeight;
+            Array32f _rBias;
+            size_t _F, _M, _threads;
+        };
+
+        //-----------------------------------------------------------------------------------------
+
         void * SynetConvolution32fInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
     }
 
@@ -817,6 +904,16 @@ namespace Simd
 
         //-----------------------------------------------------------------------------------------
 
+        class SynetConvolution32fFp16Nhwc : public Base::SynetConvolution32fFp16Nhwc
+        {
+        public:
+            SynetConvolution32fFp16Nhwc(const ConvParam32f& p);
+
+            virtual String Ext() const { return "Avx2"; }
+        };
+
+        //-----------------------------------------------------------------------------------------
+
         void * SynetConvolution32fInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
     }
 #endif//SIMD_AVX2_ENABLE
@@ -905,6 +1002,16 @@ namespace Simd
 
         //-----------------------------------------------------------------------------------------
 
+        class SynetConvolution32fFp16Nhwc : public Avx2::SynetConvolution32fFp16Nhwc
+        {
+        public:
+            SynetConvolution32fFp16Nhwc(const ConvParam32f& p);
+
+            virtual String Ext() const { return "Avx512bw"; }
+        };
+
+        //-----------------------------------------------------------------------------------------
+
         void* SynetConvolution32fInit(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
     }
 #endif
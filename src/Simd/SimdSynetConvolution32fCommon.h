@@ -103,7 +103,7 @@ namespace Simd
         {
             assert(p.group == p.srcC && p.group == p.dstC);
             size_t srcH = p.srcH, srcW = p.srcW, srcC = p.srcC, dstW = p.dstW;
-            size_t kernelY = p.kernelY, kernelX = p.kernelX, strideY = p.strideY, strideX = p.strideX, padY = p.padY, padX = p.padX;
+            size_t kernelY = p.kernelY, kernelX = p.kernelX, dilationY = p.dilationY, dilationX = p.dilationX, strideY = p.strideY, strideX = p.strideX, padY = p.padY, padX = p.padX;
             for (size_t dy = yBeg; dy < yEnd; ++dy)
             {
                 for (size_t dx = 0; dx < dstW; ++dx)
@@ -113,12 +113,12 @@ namespace Simd
                         float sum = bias ? bias[c] : 0;
                         for (size_t ky = 0; ky < kernelY; ++ky)
                         {
-                            size_t sy = dy * strideY + ky - padY;
+                            size_t sy = dy * strideY + ky * dilationY - padY;
                             if (sy < srcH)
                             {
                                 for (size_t kx = 0; kx < kernelX; ++kx)
                                 {
-                                    size_t sx = dx * strideX + kx - padX;
+                                    size_t sx = dx * strideX + kx * dilationX - padX;
                                     if (sx < srcW)
                                     {
                                         const float* pw = weight + (ky * kernelX + kx) * srcC + c;
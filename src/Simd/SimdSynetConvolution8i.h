@@ -26,6 +26,7 @@
 
 #include "Simd/SimdArray.h"
 #include "Simd/SimdPerformance.h"
+#include "Simd/SimdSynetPackedWeight.h"
 
 #ifdef _N
 #undef _N
@@ -60,6 +61,19 @@ namespace Simd
                 srcF == dstF && (srcF == SimdTensorFormatNchw || srcF == SimdTensorFormatNhwc);
         }
 
+        bool Reshape(size_t batch, size_t srcH, size_t srcW)
+        {
+            size_t kernelH = dilationY * (kernelY - 1) + 1, kernelW = dilationX * (kernelX - 1) + 1;
+            if (batch == 0 || srcH + padY + padH < kernelH || srcW + padX + padW < kernelW)
+                return false;
+            this->batch = batch;
+            this->srcH = srcH;
+            this->srcW = srcW;
+            this->dstH = (srcH + padY + padH - kernelH) / strideY + 1;
+            this->dstW = (srcW + padX + padW - kernelW) / strideX + 1;
+            return Valid();
+        }
+
         SIMD_INLINE bool IsKernel(size_t value) const
         {
             return kernelY == value && kernelX == value;
@@ -115,6 +129,16 @@ namespace Simd
             return (padX + srcW - (kernelX - 1) * dilationX - 1) / strideX + 1;
         }
 
+        SIMD_INLINE size_t KernelH() const
+        {
+            return (kernelY - 1) * dilationY + 1;
+        }
+
+        SIMD_INLINE size_t KernelW() const
+        {
+            return (kernelX - 1) * dilationX + 1;
+        }
+
 #ifdef SIMD_PERFORMANCE_STATISTIC
         String Info() const
         {
@@ -170,6 +194,11 @@ namespace Simd
 
         virtual void Forward(const uint8_t * src, uint8_t * buf, uint8_t * dst);
 
+        SynetPackedWeight Export();
+        bool SetPackedParams(const SynetPackedWeight& packed, const float* weight, const float* bias, const float* params, const float* const* stats);
+
+        bool Reshape(size_t batch, size_t srcH, size_t srcW);
+
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
         Base::PerformanceMeasurer* Perf(const char* func);
 #endif
@@ -182,6 +211,9 @@ namespace Simd
 
     protected:
         virtual void Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst) = 0;
+        virtual void Pack(SynetPackedWeight::Visitor& visitor);
+        virtual bool SetShape(const ConvParam8i& p) { return false; }
+        void ActivateAndConvert(float* dst32f, uint8_t* dst);
 
         typedef void(*Convert32fTo8u)(const float* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, uint8_t* dst, SimdSynetCompatibilityType compatibility);
 
@@ -195,6 +227,7 @@ namespace Simd
         CvtParam _srcCvt, _dstCvt;
         Array8i _weight;
         Array32f _norm, _bias, _params; 
+        SynetPackedWeight _packed;
         bool _src8u, _dst8u;
         size_t _merge, _sizeS, _sizeD;
     };
@@ -244,10 +277,12 @@ namespace Simd
             void PadInput(const uint8_t* src, uint8_t* dst);
 
             virtual void Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst);
+            virtual bool SetShape(const ConvParam8i& p);
             void Forward8u(const uint8_t* src, const ConvParam8i & p, int32_t* buf, uint8_t* dst);
+            void Forward8u(const uint8_t* src, const ConvParam8i& p, size_t dcBeg, size_t dcEnd, size_t yBeg, size_t yEnd, int32_t* buf, uint8_t* dst);
 
             AlgParam _alg;
-            size_t _sizeP, _sizeB;
+            size_t _sizeP, _sizeB, _threads, _microHW;
             ConvParam8i _paramP;
             ConvolutionPtr _convolutions[3];
         };
@@ -278,6 +313,35 @@ namespace Simd
             ConvolutionPtr _convolution;
         };
 
+        class SynetConvolution8iWinograd : public SynetConvolution8i
+        {
+        public:
+            SynetConvolution8iWinograd(const ConvParam8i& p);
+            virtual String Ext() const { return "Base"; }
+            virtual String Desc() const;
+            virtual size_t InternalBufferSize() const;
+            virtual size_t ExternalBufferSize() const;
+            virtual void SetParams(const float* weight, const float* bias, const float* params, const float* const* stats);
+
+            static bool Preferable(const ConvParam8i& p);
+
+            typedef void(*SetInputPtr)(const uint8_t* src, const ConvParam8i& p, const uint8_t* zero, size_t tileW, size_t tyBeg, size_t tyEnd, int16_t* dst, size_t dstStride);
+            typedef void(*GemmPtr)(const int16_t* src, size_t M, size_t K, const int16_t* weight, size_t N, int32_t* dst);
+            typedef void(*SetOutputPtr)(const int32_t* src, size_t srcStride, const ConvParam8i& p, size_t tileW, size_t tyBeg, size_t tyEnd, size_t N, const float* norm, const float* bias, float* dst);
+
+        protected:
+            virtual void Forward8u(const uint8_t* src, uint8_t* buf, uint8_t* dst);
+            virtual void Pack(SynetPackedWeight::Visitor& visitor);
+            virtual bool SetShape(const ConvParam8i& p);
+            void SetAlgParam();
+
+            size_t _tileH, _tileW, _tileHs, _srcC2, _dstCA, _strideV, _strideM, _threads;
+            Array16i _winogradWeight;
+            SetInputPtr _setInput;
+            GemmPtr _gemm;
+            SetOutputPtr _setOutput;
+        };
+
         void * SynetConvolution8iInit(size_t batch, const SimdConvolutionParameters * conv, SimdSynetCompatibilityType compatibility);
     }
 
@@ -339,6 +403,16 @@ namespace Simd
         };
 #endif
 
+        class SynetConvolution8iWinograd : public Base::SynetConvolution8iWinograd
+        {
+        public:
+            SynetConvolution8iWinograd(const ConvParam8i& p);
+
+            virtual String Ext() const { return "Avx2"; }
+
+            static bool Preferable(const ConvParam8i& p);
+        };
+
         void* SynetConvolution8iInit(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
     }
 #endif
@@ -368,6 +442,14 @@ namespace Simd
         };
 #endif
 
+        class SynetConvolution8iWinograd : public Avx2::SynetConvolution8iWinograd
+        {
+        public:
+            SynetConvolution8iWinograd(const ConvParam8i& p);
+
+            virtual String Ext() const { return "Avx512bw"; }
+        };
+
         void* SynetConvolution8iInit(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
     }
 #endif
@@ -314,6 +314,50 @@ namespace Simd
                 dst += ldd;
             }
         }
+
+        //---------------------------------------------------------------------
+
+        SIMD_INLINE void WinogradKernel3x3Block2x2SetSrc8i(const uint8_t* src, const ConvParam8i& p, const uint8_t* zero, size_t ty, size_t tx, const uint8_t** dst)
+        {
+            for (size_t r = 0, sy = ty * 2 - p.padY; r < 4; ++r, ++sy)
+                for (size_t c = 0, sx = tx * 2 - p.padX; c < 4; ++c, ++sx)
+                    dst[r * 4 + c] = sy < p.srcH && sx < p.srcW ? src + (sy * p.srcW + sx) * p.srcC : zero;
+        }
+
+        SIMD_INLINE void WinogradKernel3x3Block2x2SetInput8i1(const uint8_t* const* src, size_t c, int16_t* dst, size_t dstStride)
+        {
+            int t[16];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                t[0 + j] = src[0 + j][c] - src[8 + j][c];
+                t[4 + j] = src[4 + j][c] + src[8 + j][c];
+                t[8 + j] = src[8 + j][c] - src[4 + j][c];
+                t[12 + j] = src[4 + j][c] - src[12 + j][c];
+            }
+            for (size_t i = 0; i < 16; i += 4)
+            {
+                dst[(i + 0) * dstStride] = int16_t(t[i + 0] - t[i + 2]);
+                dst[(i + 1) * dstStride] = int16_t(t[i + 1] + t[i + 2]);
+                dst[(i + 2) * dstStride] = int16_t(t[i + 2] - t[i + 1]);
+                dst[(i + 3) * dstStride] = int16_t(t[i + 1] - t[i + 3]);
+            }
+        }
+
+        SIMD_INLINE void WinogradKernel3x3Block2x2SetOutput8i1(const int32_t* src, size_t srcStride, int32_t* dst)
+        {
+            int64_t t[8];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                int64_t s0 = src[(0 + j) * srcStride], s1 = src[(4 + j) * srcStride];
+                int64_t s2 = src[(8 + j) * srcStride], s3 = src[(12 + j) * srcStride];
+                t[0 + j] = s0 + s1 + s2;
+                t[4 + j] = s1 - s2 - s3;
+            }
+            dst[0] = int32_t((t[0] + t[1] + t[2]) >> 2);
+            dst[1] = int32_t((t[1] - t[2] - t[3]) >> 2);
+            dst[2] = int32_t((t[4] + t[5] + t[6]) >> 2);
+            dst[3] = int32_t((t[5] - t[6] - t[7]) >> 2);
+        }
     }
 
 #if defined(SIMD_SSE41_ENABLE)   
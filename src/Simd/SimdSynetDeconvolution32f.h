@@ -58,6 +58,22 @@ namespace Simd
                 srcF == dstF && (srcF == SimdTensorFormatNchw || (srcF == SimdTensorFormatNhwc && group == 1));
         }
 
+        bool Reshape(size_t batch, size_t srcH, size_t srcW)
+        {
+            if (batch == 0 || srcH == 0 || srcW == 0)
+                return false;
+            size_t fullH = strideY * (srcH - 1) + dilationY * (kernelY - 1) + 1;
+            size_t fullW = strideX * (srcW - 1) + dilationX * (kernelX - 1) + 1;
+            if (fullH <= padY + padH || fullW <= padX + padW)
+                return false;
+            this->batch = batch;
+            this->srcH = srcH;
+            this->srcW = srcW;
+            this->dstH = fullH - padY - padH;
+            this->dstW = fullW - padX - padW;
+            return Valid();
+        }
+
         SIMD_INLINE bool IsKernel(size_t value) const
         {
             return kernelY == value && kernelX == value;
@@ -149,6 +165,8 @@ namespace Simd
 
         virtual void Forward(const float * src, float * buf, float * dst) = 0;
 
+        bool Reshape(size_t batch, size_t srcH, size_t srcW);
+
         float * Buffer(float * buffer)
         {
             if (buffer)
@@ -175,6 +193,8 @@ namespace Simd
         typedef void(*NhwcRun)(size_t M, size_t N, size_t K, const float * A, const float * B, float * C, GemmKernelType type, bool compatibility);
         typedef void(*BiasAndActivation)(const float * bias, size_t count, size_t size, ::SimdConvolutionActivationType activation, const float * params, SimdBool trans, float * dst);
 
+        virtual bool SetShape(const DeconvParam32f & p) { return false; }
+
         DeconvParam32f _param;
         Array32f _buffer;
         float _0, _1;
@@ -232,6 +252,7 @@ namespace Simd
         protected:
             void SetAlgParam(size_t F, size_t L1, size_t L2, size_t L3);
             void ReorderWeight(const float * src, float * dst);
+            virtual bool SetShape(const DeconvParam32f & p);
 
             size_t _sizeS, _sizeD;
             AlgParam _alg;
@@ -0,0 +1,203 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetGemm8i_h__
+#define __SimdSynetGemm8i_h__
+
+#include "Simd/SimdSynetConvolution8i.h"
+
+namespace Simd
+{
+    struct Gemm8iParam
+    {
+        size_t M, N, K;
+        SimdTensorDataType srcT, dstT;
+        SimdConvolutionActivationType activation;
+        SimdSynetCompatibilityType compatibility;
+
+        Gemm8iParam(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility)
+        {
+            this->M = M;
+            this->N = N;
+            this->K = K;
+            this->srcT = srcT;
+            this->dstT = dstT;
+            this->activation = activation;
+            this->compatibility = compatibility;
+        }
+
+        bool Valid() const
+        {
+            return M > 0 && N > 0 && K > 0 &&
+                (srcT == SimdTensorData32f || srcT == SimdTensorData8u) && (dstT == SimdTensorData32f || dstT == SimdTensorData8u);
+        }
+
+        SimdConvolutionParameters Conv() const
+        {
+            SimdConvolutionParameters conv;
+            conv.srcC = K;
+            conv.srcH = M;
+            conv.srcW = 1;
+            conv.srcT = srcT;
+            conv.srcF = SimdTensorFormatNhwc;
+            conv.dstC = N;
+            conv.dstH = M;
+            conv.dstW = 1;
+            conv.dstT = dstT;
+            conv.dstF = SimdTensorFormatNhwc;
+            conv.kernelY = 1;
+            conv.kernelX = 1;
+            conv.dilationY = 1;
+            conv.dilationX = 1;
+            conv.strideY = 1;
+            conv.strideX = 1;
+            conv.padY = 0;
+            conv.padX = 0;
+            conv.padH = 0;
+            conv.padW = 0;
+            conv.group = 1;
+            conv.activation = activation;
+            return conv;
+        }
+    };
+
+    class SynetGemm8i : public Deletable
+    {
+    public:
+        SynetGemm8i(const Gemm8iParam& p, SynetConvolution8i* conv)
+            : _param(p)
+            , _conv(conv)
+        {
+        }
+
+        virtual ~SynetGemm8i()
+        {
+            delete _conv;
+        }
+
+        const Gemm8iParam& Param() const { return _param; }
+
+        String Desc() const { return _conv->Desc() + "-Gemm"; }
+
+        const char* Info() const
+        {
+            _info = Desc();
+            return _info.c_str();
+        }
+
+        size_t ExternalBufferSize() const { return _conv->ExternalBufferSize(); }
+        size_t InternalBufferSize() const { return _conv->InternalBufferSize(); }
+
+        void SetParams(const float* weight, const float* bias, const float* params, const float* const* stats)
+        {
+            _conv->SetParams(weight, bias, params, stats);
+        }
+
+        bool Reshape(size_t M)
+        {
+            if (!_conv->Reshape(1, M, 1))
+                return false;
+            _param.M = M;
+            return true;
+        }
+
+        void Forward(const uint8_t* src, uint8_t* buf, uint8_t* dst)
+        {
+            _conv->Forward(src, buf, dst);
+        }
+
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        Base::PerformanceMeasurer* Perf(const char* func)
+        {
+            return _conv->Perf(func);
+        }
+#endif
+
+    protected:
+        Gemm8iParam _param;
+        SynetConvolution8i* _conv;
+        mutable String _info;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    typedef void* (*SynetConvolution8iInitPtr)(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
+
+    SIMD_INLINE void* SynetGemm8iInit(const Gemm8iParam& param, SynetConvolution8iInitPtr init)
+    {
+        if (!param.Valid())
+            return NULL;
+        SimdConvolutionParameters conv = param.Conv();
+        SynetConvolution8i* context = (SynetConvolution8i*)init(1, &conv, param.compatibility);
+        return context ? new SynetGemm8i(param, context) : NULL;
+    }
+
+    namespace Base
+    {
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    }
+
+#ifdef SIMD_SSE41_ENABLE    
+    namespace Sse41
+    {
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE    
+    namespace Avx512bw
+    {
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX512VNNI_ENABLE    
+    namespace Avx512vnni
+    {
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#if defined(SIMD_AMXBF16_ENABLE) || (defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_AMX_EMULATE))    
+    namespace AmxBf16
+    {
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_NEON_ENABLE    
+    namespace Neon
+    {
+        void* SynetGemm8iInit(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+}
+
+#endif//__SimdSynetGemm8i_h__
@@ -27,6 +27,7 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdGemm.h"
+#include "Simd/SimdSynetSparse32f.h"
 
 namespace Simd
 {
@@ -37,14 +38,16 @@ namespace Simd
         size_t output;
         SimdBool transpose;
         SimdConvolutionActivationType activation;
+        SimdSynetCompatibilityType compatibility;
 
-        InnerProductParam32f(size_t b, size_t i, size_t o, SimdBool t, SimdConvolutionActivationType a)
+        InnerProductParam32f(size_t b, size_t i, size_t o, SimdBool t, SimdConvolutionActivationType a, SimdSynetCompatibilityType c)
         {
             batch = b;
             input = i;
             output = o;
             transpose = t;
             activation = a;
+            compatibility = c;
         }
 
         bool Valid()
@@ -123,7 +126,7 @@ namespace Simd
             SynetInnerProduct32fGemm(const InnerProductParam32f & p);
             virtual String Ext() const { return "Base"; }
             virtual String Desc() const;
-            virtual size_t InternalBufferSize() const { return _cbWeight.size; }
+            virtual size_t InternalBufferSize() const { return _cbWeight.size + _sparse.Size(); }
             virtual void SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params);
             virtual void Forward(const float * src, float * dst);
 
@@ -139,9 +142,12 @@ namespace Simd
             BiasAndActivationPtr _biasAndActivation;
             ProdPtr _prod;
             size_t _M, _N, _K, _ldW, _ldS, _ldD;
+            size_t _cbSize;
             Array32f _cbWeight;
             CbPackPtr _cbPack;
             CbRunPtr _cbRun;
+            SynetSparse32f _sparse;
+            SynetSparse32f::GemmPtr _sparseGemm;
         };
 
         class SynetInnerProduct32fProd : public SynetInnerProduct32f
@@ -167,7 +173,34 @@ namespace Simd
             void ReorderWeight(const float* src, float* dst);
         };
 
+        class SynetInnerProduct32fFp16 : public SynetInnerProduct32f
+        {
+        public:
+            SynetInnerProduct32fFp16(const InnerProductParam32f& p);
+            virtual String Ext() const { return "Base"; }
+            virtual String Desc() const { return Ext() + "::Fp16"; }
+            virtual size_t InternalBufferSize() const { return _rWeight.RawSize() + _rBias.RawSize(); }
+            virtual void SetParams(const float* weight, SimdBool* internal, const float* bias, const float* params);
+            virtual void Forward(const float* src, float* dst);
+
+            typedef void(*GemmPtr)(const float* src, size_t M, size_t K, const uint16_t* weight, size_t N, const float* bias, float* dst);
+
+        protected:
+            GemmPtr _gemm;
+            Array16u _rWeight;
+            Array32f _rBias;
+            size_t _F, _M, _N, _K;
+
+            void SetSize(size_t F);
+        };
+
+        void SynetInnerProduct32fFp16Reorder(const float* src, size_t K, size_t N, SimdBool trans, size_t F, uint16_t* dst);
+
+        void SynetInnerProduct32fFp16Gemm(const float* src, size_t M, size_t K, const uint16_t* weight, size_t N, const float* bias, float* dst);
+
         void * SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
+
+        void * SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -190,6 +223,8 @@ namespace Simd
         };
 
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
     }
 #endif//SIMD_SSE41_ENABLE
 
@@ -213,6 +248,8 @@ namespace Simd
         };
 
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
     }
 #endif//SIMD_AVX_ENABLE
 
@@ -235,7 +272,19 @@ namespace Simd
             virtual String Ext() const { return "Avx2"; }
         };
 
+        class SynetInnerProduct32fFp16 : public Base::SynetInnerProduct32fFp16
+        {
+        public:
+            SynetInnerProduct32fFp16(const InnerProductParam32f& p);
+
+            virtual String Ext() const { return "Avx2"; }
+        };
+
+        void SynetInnerProduct32fFp16Gemm(const float* src, size_t M, size_t K, const uint16_t* weight, size_t N, const float* bias, float* dst);
+
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
     }
 #endif//SIMD_AVX2_ENABLE
 
@@ -258,7 +307,19 @@ namespace Simd
             virtual String Ext() const { return "Avx512bw"; }
         };
 
+        class SynetInnerProduct32fFp16 : public Avx2::SynetInnerProduct32fFp16
+        {
+        public:
+            SynetInnerProduct32fFp16(const InnerProductParam32f& p);
+
+            virtual String Ext() const { return "Avx512bw"; }
+        };
+
+        void SynetInnerProduct32fFp16Gemm(const float* src, size_t M, size_t K, const uint16_t* weight, size_t N, const float* bias, float* dst);
+
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
     }
 #endif
 
@@ -283,6 +344,8 @@ namespace Simd
         };
 
         void* SynetInnerProduct32fInit(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
+
+        void* SynetInnerProduct32fInitV2(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
     }
 #endif//SIMD_NEON_ENABLE
 }
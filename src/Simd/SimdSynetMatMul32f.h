@@ -0,0 +1,153 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetMatMul32f_h__
+#define __SimdSynetMatMul32f_h__
+
+#include "Simd/SimdArray.h"
+#include "Simd/SimdMath.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdPerformance.h"
+
+namespace Simd
+{
+    struct MatMulParam32f
+    {
+        size_t batchA, batchB, M, N, K;
+        SimdBool transB;
+        SimdSynetCompatibilityType compatibility;
+
+        MatMulParam32f(size_t ba, size_t bb, size_t m, size_t n, size_t k, SimdBool t, SimdSynetCompatibilityType c)
+            : batchA(ba), batchB(bb), M(m), N(n), K(k), transB(t), compatibility(c)
+        {
+        }
+
+        bool Valid() const
+        {
+            return M && N && K && batchA && batchB && (batchA == batchB || batchA == 1 || batchB == 1);
+        }
+
+        size_t Batch() const
+        {
+            return Simd::Max(batchA, batchB);
+        }
+    };
+
+    namespace Base
+    {
+        class SynetMatMul32f : public Deletable
+        {
+        public:
+            SynetMatMul32f(const MatMulParam32f& p);
+            virtual String Ext() const { return "Base"; }
+            virtual String Desc() const;
+
+            size_t InternalBufferSize() const
+            {
+                return _bufA.RawSize() + _bufB.RawSize();
+            }
+
+            void Forward(const float* A, const float* B, float* C);
+
+            typedef void(*GemmPtr)(size_t M, size_t N, size_t K, const float* alpha, const float* A, size_t lda, const float* B, size_t ldb, const float* beta, float* C, size_t ldc);
+            typedef void(*RoundPtr)(const float* src, size_t size, float* dst);
+
+        protected:
+            MatMulParam32f _param;
+            bool _bf16, _batchParallel;
+            GemmPtr _gemm;
+            RoundPtr _round;
+            Array32f _bufA, _bufB;
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+    }
+
+#ifdef SIMD_SSE41_ENABLE    
+    namespace Sse41
+    {
+        class SynetMatMul32f : public Base::SynetMatMul32f
+        {
+        public:
+            SynetMatMul32f(const MatMulParam32f& p);
+            virtual String Ext() const { return "Sse41"; }
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        class SynetMatMul32f : public Sse41::SynetMatMul32f
+        {
+        public:
+            SynetMatMul32f(const MatMulParam32f& p);
+            virtual String Ext() const { return "Avx2"; }
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+    namespace Avx512bw
+    {
+        class SynetMatMul32f : public Avx2::SynetMatMul32f
+        {
+        public:
+            SynetMatMul32f(const MatMulParam32f& p);
+            virtual String Ext() const { return "Avx512bw"; }
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+
+#ifdef SIMD_NEON_ENABLE    
+    namespace Neon
+    {
+        class SynetMatMul32f : public Base::SynetMatMul32f
+        {
+        public:
+            SynetMatMul32f(const MatMulParam32f& p);
+            virtual String Ext() const { return "Neon"; }
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetMatMul32fInit(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+    }
+#endif
+}
+
+#endif
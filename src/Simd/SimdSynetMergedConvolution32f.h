@@ -40,6 +40,7 @@ namespace Simd
         SimdBool add;
         size_t count;
         ConvParam32f conv[3];
+        SimdConvolutionParameters origin[3];
 
         MergConvParam32f(size_t batch, const SimdConvolutionParameters * convs, size_t count, SimdBool add, SimdSynetCompatibilityType compatibility)
         {
@@ -47,7 +48,15 @@ namespace Simd
             this->add = add;
             this->count = count;
             for (size_t i = 0; i < count; ++i)
+            {
                 this->conv[i] = ConvParam32f(batch, convs + i, compatibility);
+                this->origin[i] = convs[i];
+            }
+        }
+
+        static SIMD_INLINE bool ValidDepthwiseKernel(const SimdConvolutionParameters& c)
+        {
+            return (c.kernelY == 3 || c.kernelY == 5 || c.kernelY == 7) && (c.kernelX == 3 || c.kernelX == 5 || c.kernelX == 7);
         }
 
         bool Valid()
@@ -63,25 +72,30 @@ namespace Simd
                     return false;
                 if (c.dstH != (c.srcH + c.padY + c.padH - (c.dilationY * (c.kernelY - 1) + 1)) / c.strideY + 1 || c.dstH == 0)
                     return false;
-                if (c.dstW != (c.srcW + c.padX + c.padW - (c.dilationY * (c.kernelX - 1) + 1)) / c.strideX + 1 || c.dstW == 0)
+                if (c.dstW != (c.srcW + c.padX + c.padW - (c.dilationX * (c.kernelX - 1) + 1)) / c.strideX + 1 || c.dstW == 0)
                     return false;
-                if (c.kernelY != c.kernelX || !(c.kernelY == 1 || c.kernelY == 3 || c.kernelY == 5 || c.kernelY == 7))
+                if (c.group == 1)
+                {
+                    if (c.kernelY != c.kernelX || !(c.kernelY == 1 || c.kernelY == 3 || c.kernelY == 5 || c.kernelY == 7))
+                        return false;
+                    if (c.dilationY != 1 || c.dilationX != 1)
+                        return false;
+                }
+                else if (!ValidDepthwiseKernel(c))
                     return false;
                 if (/*c.strideY != c.strideX ||*/ !(c.strideY == 1 || c.strideY == 2 || c.strideY == 3))
                     return false;
-                if (c.dilationY != 1 || c.dilationX != 1)
-                    return false;
 
                 if (c.dstH == (c.srcH + c.padY + c.padH - (c.dilationY * (c.kernelY - 1) + 1) - 1) / c.strideY + 1)
                     c.padH--;
-                if (c.dstW == (c.srcW + c.padX + c.padW - (c.dilationY * (c.kernelX - 1) + 1) - 1) / c.strideX + 1)
+                if (c.dstW == (c.srcW + c.padX + c.padW - (c.dilationX * (c.kernelX - 1) + 1) - 1) / c.strideX + 1)
                     c.padW--;
             }
             if (count == 3)
             {
                 if (conv[0].group != 1 || (conv[0].kernelY != 1 && conv[0].kernelY != 3))
                     return false;
-                if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC || (conv[1].kernelY != 3 && conv[1].kernelY != 5 && conv[1].kernelY != 7))
+                if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC)
                     return false;
                 if (conv[2].group != 1 || conv[2].kernelY != 1 || conv[2].strideY != 1)
                     return false;
@@ -94,12 +108,12 @@ namespace Simd
                 {
                     if (conv[0].kernelY != 1 && conv[0].kernelY != 3)
                         return false;
-                    if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC || (conv[1].kernelY != 3 && conv[1].kernelY != 5 && conv[1].kernelY != 7))
+                    if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC)
                         return false;
                 }
                 else
                 {
-                    if (conv[0].group != conv[0].srcC || conv[0].group != conv[0].dstC || (conv[0].kernelY != 3 && conv[0].kernelY != 5 && conv[0].kernelY != 7))
+                    if (conv[0].group != conv[0].srcC || conv[0].group != conv[0].dstC)
                         return false;
                     if (conv[1].group != 1 || conv[1].kernelY != 1 || conv[1].strideY != 1)
                         return false;
@@ -108,6 +122,25 @@ namespace Simd
             return true;
         }
 
+        bool Reshape(size_t batch, size_t srcH, size_t srcW)
+        {
+            if (batch == 0)
+                return false;
+            for (size_t i = 0; i < count; ++i)
+            {
+                SimdConvolutionParameters c = origin[i];
+                c.srcH = i ? conv[i - 1].dstH : srcH;
+                c.srcW = i ? conv[i - 1].dstW : srcW;
+                size_t kernelH = c.dilationY * (c.kernelY - 1) + 1, kernelW = c.dilationX * (c.kernelX - 1) + 1;
+                if (c.srcH + c.padY + c.padH < kernelH || c.srcW + c.padX + c.padW < kernelW)
+                    return false;
+                c.dstH = (c.srcH + c.padY + c.padH - kernelH) / c.strideY + 1;
+                c.dstW = (c.srcW + c.padX + c.padW - kernelW) / c.strideX + 1;
+                conv[i] = ConvParam32f(batch, &c, conv[i].compatibility);
+            }
+            return Valid();
+        }
+
         SIMD_INLINE bool IsPad(size_t index, size_t value) const
         {
             return conv[index].padY == value && conv[index].padX == value && conv[index].padH == value && conv[index].padW == value;
@@ -162,6 +195,17 @@ namespace Simd
 
         virtual void Forward(const float * src, float * buf, float * dst) = 0;
 
+        bool Reshape(size_t batch, size_t srcH, size_t srcW)
+        {
+            MergConvParam32f param = _param;
+            if (!param.Reshape(batch, srcH, srcW) || !SetShape(param))
+                return false;
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+            _perf = NULL;
+#endif
+            return true;
+        }
+
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
         virtual Base::PerformanceMeasurer* Perf(const char* func)
         {
@@ -185,6 +229,8 @@ namespace Simd
         MergConvParam32f _param;
         Array32f _buffer;
 
+        virtual bool SetShape(const MergConvParam32f& p) { return false; }
+
         float* Buffer(float* buffer)
         {
             if (buffer)
@@ -224,13 +270,17 @@ namespace Simd
             virtual void ReorderFirstWeight(const float* src, float* dst) const {}
             virtual void ReorderSecondWeight(const float* src, float* dst) const {}
             virtual void ReorderThirdWeight(const float* src, float* dst) const {}
+            virtual bool SetShape(const MergConvParam32f& p);
+            virtual void SetSteps() {}
+
+            void SetThreads(size_t height);
 
             ConvolutionPtr _convolution[4];
-            size_t _sizeS, _sizeD, _sizeB[2];
+            size_t _sizeS, _sizeD, _sizeB[2], _threads;
             Array32f _rWeight[3], _rBias[3], _rParams[3];
             const float * _weight[3], * _bias[3], * _params[3];
 
-            size_t _miC, _maC, _yStep[2], _bufH[2], _dp[2], _dw[3];
+            size_t _miC, _maC, _yStep[2], _bufH[2], _dp[2], _dw[3], _L2;
         };
 
         class SynetMergedConvolution32fCdc : public SynetMergedConvolution32f
@@ -244,6 +294,7 @@ namespace Simd
 
         protected:
             void SetSize(size_t L1, size_t L2, size_t L3, size_t F);
+            virtual void SetSteps();
             virtual void ReorderFirstWeight(const float* src, float* dst) const;
             virtual void ReorderSecondWeight(const float* src, float* dst) const;
             virtual void ReorderThirdWeight(const float* src, float* dst) const;
@@ -260,6 +311,7 @@ namespace Simd
 
         protected:
             void SetSize(size_t L1, size_t L2, size_t L3, size_t F);
+            virtual void SetSteps();
             virtual void ReorderFirstWeight(const float* src, float* dst) const;
             virtual void ReorderSecondWeight(const float* src, float* dst) const;
         };
@@ -275,6 +327,7 @@ namespace Simd
 
         protected:
             void SetSize(size_t L1, size_t L2, size_t L3, size_t F);
+            virtual void SetSteps();
             virtual void ReorderFirstWeight(const float* src, float* dst) const;
             virtual void ReorderSecondWeight(const float* src, float* dst) const;
         };
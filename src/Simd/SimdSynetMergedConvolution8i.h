@@ -48,6 +48,11 @@ namespace Simd
                 this->conv[i] = ConvParam8i(batch, convs + i, compatibility);
         }
 
+        static SIMD_INLINE bool ValidDepthwiseKernel(const SimdConvolutionParameters& c)
+        {
+            return (c.kernelY == 3 || c.kernelY == 5 || c.kernelY == 7) && (c.kernelX == 3 || c.kernelX == 5 || c.kernelX == 7);
+        }
+
         bool Valid()
         {
             if (count < 2 || count > 3)
@@ -59,16 +64,21 @@ namespace Simd
                     return false;
                 if (c.srcF != SimdTensorFormatNhwc)
                     return false;
-                if (c.kernelY != c.kernelX || !(c.kernelY == 1 || c.kernelY == 3 || c.kernelY == 5 || c.kernelY == 7))
+                if (c.group == 1)
+                {
+                    if (c.kernelY != c.kernelX || !(c.kernelY == 1 || c.kernelY == 3 || c.kernelY == 5 || c.kernelY == 7))
+                        return false;
+                    if (c.dilationY != 1 || c.dilationX != 1)
+                        return false;
+                }
+                else if (!ValidDepthwiseKernel(c))
                     return false;
                 if (c.strideY != c.strideX || !(c.strideY == 1 || c.strideY == 2 || c.strideY == 3))
                     return false;
-                if (c.dilationY != 1 || c.dilationX != 1)
-                    return false;
 
                 if (c.dstH == (c.srcH + c.padY + c.padH - (c.dilationY * (c.kernelY - 1) + 1) - 1) / c.strideY + 1)
                     c.padH--;
-                if (c.dstW == (c.srcW + c.padX + c.padW - (c.dilationY * (c.kernelX - 1) + 1) - 1) / c.strideX + 1)
+                if (c.dstW == (c.srcW + c.padX + c.padW - (c.dilationX * (c.kernelX - 1) + 1) - 1) / c.strideX + 1)
                     c.padW--;
                 if (c.IsDepthwise() && i != count - 1)
                     c.dstT = SimdTensorData8u;
@@ -77,7 +87,7 @@ namespace Simd
             {
                 if (conv[0].group != 1 || (conv[0].kernelY != 1 && conv[0].kernelY != 3))
                     return false;
-                if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC || (conv[1].kernelY != 3 && conv[1].kernelY != 5 && conv[1].kernelY != 7))
+                if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC)
                     return false;
                 if (conv[2].group != 1 || conv[2].kernelY != 1 || conv[2].strideY != 1)
                     return false;
@@ -88,12 +98,12 @@ namespace Simd
                 {
                     if (conv[0].kernelY != 1 && conv[0].kernelY != 3)
                         return false;
-                    if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC || (conv[1].kernelY != 3 && conv[1].kernelY != 5 && conv[1].kernelY != 7))
+                    if (conv[1].group != conv[1].srcC || conv[1].group != conv[1].dstC)
                         return false;
                 }
                 else
                 {
-                    if (conv[0].group != conv[0].srcC || conv[0].group != conv[0].dstC || (conv[0].kernelY != 3 && conv[0].kernelY != 5 && conv[0].kernelY != 7))
+                    if (conv[0].group != conv[0].srcC || conv[0].group != conv[0].dstC)
                         return false;
                     if (conv[1].group != 1 || conv[1].kernelY != 1 || conv[1].strideY != 1)
                         return false;
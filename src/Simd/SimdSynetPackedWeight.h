@@ -0,0 +1,129 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetPackedWeight_h__
+#define __SimdSynetPackedWeight_h__
+
+#include "Simd/SimdArray.h"
+#include "Simd/SimdPerformance.h"
+
+#include <vector>
+#include <memory>
+
+namespace Simd
+{
+    /*! Read-only blob with internal (reordered) weights of Synet layer.
+        Copies of the handle share the same storage, which is released together with the last copy.
+    */
+    class SynetPackedWeight : public Deletable
+    {
+        struct Section
+        {
+            size_t item, offset, size;
+        };
+        typedef std::vector<Section> Sections;
+
+        struct Storage;
+        typedef std::shared_ptr<Storage> StoragePtr;
+
+    public:
+        /*! Enumerates internal arrays of Synet layer: collects them for export, checks or binds them to shared storage at import. */
+        class Visitor
+        {
+        public:
+            enum Mode
+            {
+                Collect,
+                Check,
+                Bind,
+            };
+
+            SIMD_INLINE Visitor(Mode mode, const SynetPackedWeight* packed = NULL)
+                : _mode(mode)
+                , _packed(packed)
+                , _index(0)
+                , _ok(true)
+            {
+            }
+
+            template<class T> SIMD_INLINE void operator()(Array<T>& array)
+            {
+                if (_mode == Collect)
+                {
+                    Section section = { sizeof(T), 0, array.RawSize() };
+                    _sections.push_back(section);
+                    _data.push_back(array.data);
+                }
+                else
+                {
+                    const Section* section = _packed->At(_index);
+                    if (section == NULL || section->item != sizeof(T))
+                        _ok = false;
+                    else if (_mode == Bind)
+                        array.Share((const T*)_packed->Data(*section), section->size / sizeof(T));
+                }
+                _index++;
+            }
+
+            SIMD_INLINE bool Ok() const
+            {
+                return _ok && (_mode == Collect || _index == _packed->Count());
+            }
+
+        private:
+            friend class SynetPackedWeight;
+
+            Mode _mode;
+            const SynetPackedWeight* _packed;
+            size_t _index;
+            bool _ok;
+            Sections _sections;
+            std::vector<const void*> _data;
+        };
+
+        SynetPackedWeight();
+        SynetPackedWeight(const String& key, const Visitor& collected);
+
+        SIMD_INLINE bool Empty() const
+        {
+            return !_storage;
+        }
+
+        const String& Key() const;
+        size_t Count() const;
+        size_t Size() const;
+
+        bool Save(const String& path) const;
+        bool Load(const String& path);
+
+        static String Key(const String& desc, const SimdConvolutionParameters& conv, size_t batch, SimdSynetCompatibilityType compatibility);
+
+    private:
+        const Section* At(size_t index) const;
+        const uint8_t* Data(const Section& section) const;
+
+        StoragePtr _storage;
+    };
+}
+
+#endif//__SimdSynetPackedWeight_h__
@@ -0,0 +1,92 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetSparse32f_h__
+#define __SimdSynetSparse32f_h__
+
+#include "Simd/SimdSynetPackedWeight.h"
+
+namespace Simd
+{
+    /*! Block-sparse FP32 weight of Synet layer. 
+        Matrix [K][N] is split into tiles of F output channels x Kb input channels, only non-zero tiles are stored.
+    */
+    struct SynetSparse32f
+    {
+        static const size_t F = 16, Kb = 4;
+
+        typedef void(*GemmPtr)(const float* src, size_t M, size_t ldS, const SynetSparse32f& weight, const float* bias, float* dst, size_t ldD);
+
+        size_t K, N;
+        Array32i offset, index;
+        Array32f weight;
+
+        SynetSparse32f(size_t k = 0, size_t n = 0)
+            : K(k)
+            , N(n)
+        {
+        }
+
+        SIMD_INLINE bool Enable() const
+        {
+            return offset.size != 0;
+        }
+
+        SIMD_INLINE size_t Size() const
+        {
+            return offset.size + index.size + weight.size;
+        }
+
+        bool Init(const float* src, SimdBool trans, float threshold = 0.5f);
+
+        void Release();
+
+        SIMD_INLINE void Pack(SynetPackedWeight::Visitor& visitor)
+        {
+            visitor(offset);
+            visitor(index);
+            visitor(weight);
+        }
+    };
+
+    namespace Base
+    {
+        void SynetSparse32fGemm(const float* src, size_t M, size_t ldS, const SynetSparse32f& weight, const float* bias, float* dst, size_t ldD);
+    }
+
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        void SynetSparse32fGemm(const float* src, size_t M, size_t ldS, const SynetSparse32f& weight, const float* bias, float* dst, size_t ldD);
+    }
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE    
+    namespace Avx512bw
+    {
+        void SynetSparse32fGemm(const float* src, size_t M, size_t ldS, const SynetSparse32f& weight, const float* bias, float* dst, size_t ldD);
+    }
+#endif
+}
+
+#endif//__SimdSynetSparse32f_h__
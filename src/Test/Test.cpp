@@ -170,6 +170,10 @@ namespace Test
     TEST_ADD_GROUP_A0(DescrIntCosineDistance);
     TEST_ADD_GROUP_A0(DescrIntCosineDistancesMxNa);
     TEST_ADD_GROUP_A0(DescrIntCosineDistancesMxNp);
+    TEST_ADD_GROUP_A0(DescrIntCosineDistancesMxNThreads);
+    TEST_ADD_GROUP_A0(DescrIntCosineDistancesTopK);
+    TEST_ADD_GROUP_A0(DescrIntCosineDistancesTopKa);
+    TEST_ADD_GROUP_A0(DescrIntIndex);
 
     TEST_ADD_GROUP_A0(DeinterleaveUv);
     TEST_ADD_GROUP_A0(DeinterleaveBgr);
@@ -181,6 +185,7 @@ namespace Test
     TEST_ADD_GROUP_A0(DetectionLbpDetect32fi);
     TEST_ADD_GROUP_A0(DetectionLbpDetect16ip);
     TEST_ADD_GROUP_A0(DetectionLbpDetect16ii);
+    TEST_ADD_GROUP_A0(DetectionParallelLevels);
     TEST_ADD_GROUP_0S(Detection);
 
     TEST_ADD_GROUP_A0(AlphaBlending);
@@ -231,9 +236,17 @@ namespace Test
     TEST_ADD_GROUP_A0(Gemm32fNT);
 
     TEST_ADD_GROUP_A0(ImageSaveToMemory);
+    TEST_ADD_GROUP_A0(ImageSaveJpegThreads);
+    TEST_ADD_GROUP_A0(ImageSavePngThreads);
     TEST_ADD_GROUP_A0(Nv12SaveAsJpegToMemory);
     TEST_ADD_GROUP_A0(Yuv420pSaveAsJpegToMemory);
     TEST_ADD_GROUP_AS(ImageLoadFromMemory);
+    TEST_ADD_GROUP_A0(ImageLoadPng16);
+    TEST_ADD_GROUP_A0(ImageLoadJpegRestart);
+    TEST_ADD_GROUP_A0(ImageLoadFromMemoryScaled);
+    TEST_ADD_GROUP_A0(ImageDecoder);
+    TEST_ADD_GROUP_A0(ImageLoadFromMemoryInto);
+    TEST_ADD_GROUP_A0(ImageLoadJpegToYuv420p);
 
     TEST_ADD_GROUP_A0(MeanFilter3x3);
     TEST_ADD_GROUP_A0(MedianFilterRhomb3x3);
@@ -326,6 +339,8 @@ namespace Test
     TEST_ADD_GROUP_A0(OperationBinary16i);
     TEST_ADD_GROUP_A0(VectorProduct);
 
+    TEST_ADD_GROUP_A0(Parallel);
+
     TEST_ADD_GROUP_A0(ReduceColor2x2);
     TEST_ADD_GROUP_A0(ReduceGray2x2);
     TEST_ADD_GROUP_A0(ReduceGray3x3);
@@ -338,8 +353,11 @@ namespace Test
 
     TEST_ADD_GROUP_AS(ResizeBilinear);
     TEST_ADD_GROUP_A0(Resizer);
+    TEST_ADD_GROUP_A0(ResizerThreads);
     TEST_ADD_GROUP_0S(ResizeYuv420p);
 
+    TEST_ADD_GROUP_A0(RuntimeCache);
+
     TEST_ADD_GROUP_A0(SegmentationShrinkRegion);
     TEST_ADD_GROUP_A0(SegmentationFillSingleHoles);
     TEST_ADD_GROUP_A0(SegmentationChangeIndex);
@@ -375,6 +393,7 @@ namespace Test
     TEST_ADD_GROUP_A0(SynetEltwiseLayerForward);
     TEST_ADD_GROUP_A0(SynetLrnLayerCrossChannels);
     TEST_ADD_GROUP_A0(SynetShuffleLayerForward);
+    TEST_ADD_GROUP_A0(SynetArenaPlan);
 
     TEST_ADD_GROUP_A0(SynetElu32f);
     TEST_ADD_GROUP_A0(SynetGelu32f);
@@ -389,15 +408,27 @@ namespace Test
     TEST_ADD_GROUP_A0(SynetSwish32f);
     TEST_ADD_GROUP_A0(SynetTanh32f);
 
+    TEST_ADD_GROUP_A0(SynetAttention32fForward);
+    TEST_ADD_GROUP_A0(SynetAttention32fReference);
+
     TEST_ADD_GROUP_A0(SynetConvert32fTo8u);
     TEST_ADD_GROUP_A0(SynetConvert8uTo32f);
     TEST_ADD_GROUP_A0(SynetSetInput);
 
     TEST_ADD_GROUP_A0(SynetConvolution8iForward);
+    TEST_ADD_GROUP_A0(SynetConvolution8iWinograd);
+    TEST_ADD_GROUP_A0(SynetConvolution8iThreads);
+    TEST_ADD_GROUP_A0(SynetConvolution8iPackedWeight);
+    TEST_ADD_GROUP_A0(SynetConvolution8iReshape);
 
     TEST_ADD_GROUP_A0(SynetConvolution32fForward);
+    TEST_ADD_GROUP_A0(SynetConvolution32fThreads);
+    TEST_ADD_GROUP_A0(SynetConvolution32fSparseVsDense);
+    TEST_ADD_GROUP_A0(SynetConvolution32fPackedWeight);
+    TEST_ADD_GROUP_A0(SynetConvolution32fReshape);
 
     TEST_ADD_GROUP_A0(SynetDeconvolution32fForward);
+    TEST_ADD_GROUP_A0(SynetDeconvolution32fReshape);
 
     TEST_ADD_GROUP_A0(SynetFusedLayerForward0);
     TEST_ADD_GROUP_A0(SynetFusedLayerForward1);
@@ -408,16 +439,25 @@ namespace Test
     TEST_ADD_GROUP_A0(SynetFusedLayerForward9);
 
     TEST_ADD_GROUP_A0(SynetInnerProduct32fForward);
+    TEST_ADD_GROUP_A0(SynetInnerProduct32fFp16);
     TEST_ADD_GROUP_A0(SynetInnerProductLayerForward);
     TEST_ADD_GROUP_A0(SynetInnerProduct8i);
+    TEST_ADD_GROUP_A0(SynetGemm8iForward);
+    TEST_ADD_GROUP_A0(SynetGemm8iReshape);
+
+    TEST_ADD_GROUP_A0(SynetMatMul32fForward);
 
     TEST_ADD_GROUP_A0(SynetMergedConvolution8iForward);
 
     TEST_ADD_GROUP_A0(SynetMergedConvolution32fForward);
+    TEST_ADD_GROUP_A0(SynetMergedConvolution32fThreads);
+    TEST_ADD_GROUP_A0(SynetMergedConvolution32fReshape);
 
     TEST_ADD_GROUP_A0(SynetNormalizeLayerForward);
     TEST_ADD_GROUP_A0(SynetNormalizeLayerForwardV2);
     TEST_ADD_GROUP_A0(SynetNormalizeLayerForwardV3);
+    TEST_ADD_GROUP_A0(SynetLayerNorm32f);
+    TEST_ADD_GROUP_A0(SynetLayerNorm16b);
 
     TEST_ADD_GROUP_A0(SynetPermute);
 
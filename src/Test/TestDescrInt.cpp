@@ -24,6 +24,7 @@
 #include "Test/TestCompare.h"
 #include "Test/TestPerformance.h"
 #include "Test/TestRandom.h"
+#include "Test/TestString.h"
 #include "Test/TestTensor.h"
 
 #include "Simd/SimdDescrInt.h"
@@ -31,6 +32,7 @@
 namespace Test
 {
     typedef std::vector<uint8_t*> U8Ptrs;
+    typedef std::vector<uint32_t> Idx32u;
 
     static void InitEncoded(const void* c, View& u8, size_t h, float lo, float hi, int gap = 0, U8Ptrs* u8p = NULL)
     {
@@ -124,6 +126,18 @@ namespace Test
                 TEST_PERFORMANCE_TEST(desc);
                 SimdDescrIntCosineDistancesMxNp(context, a.height, b.height, a.data, b.data, d.Data());
             }
+
+            void CosineDistancesTopKa(const void* context, const U8Ptrs& a, const U8Ptrs& b, size_t K, float threshold, Idx32u& i, Tensor32f& d) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                SimdDescrIntCosineDistancesTopKa(context, a.size(), b.size(), a.data(), b.data(), K, threshold, i.data(), d.Data());
+            }
+
+            void CosineDistancesTopKp(const void* context, const View& a, const View& b, size_t K, float threshold, Idx32u& i, Tensor32f& d) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                SimdDescrIntCosineDistancesTopKp(context, a.height, b.height, a.data, b.data, K, threshold, i.data(), d.Data());
+            }
         };
     }
 
@@ -171,7 +185,7 @@ namespace Test
         bool result = true;
 
         size_t size = Simd::Min(H * W, 128 * 256);
-        for (size_t depth = 4; depth <= 8; depth++)
+        for (size_t depth = 1; depth <= 8; depth++)
         {
             //result = result && DescrIntEncode32fAutoTest(256, depth, f1, f2);
             //result = result && DescrIntEncode32fAutoTest(512, depth, f1, f2);
@@ -255,7 +269,7 @@ namespace Test
         bool result = true;
 
         size_t size = Simd::Min(H * W, 128 * 256);
-        for (size_t depth = 4; depth <= 8; depth++)
+        for (size_t depth = 1; depth <= 8; depth++)
         {
             //result = result && DescrIntEncode16fAutoTest(256, depth, f1, f2);
             //result = result && DescrIntEncode16fAutoTest(512, depth, f1, f2);
@@ -309,7 +323,8 @@ namespace Test
         void* context2 = f2.func(size, depth);
 
         View orig(size, 1, View::Float, NULL, TEST_ALIGN(SIMD_ALIGN));
-        const float lo = -17.0f, hi = 13.0f, eps = (hi - lo) * 0.0021f * (1 << (8 - depth));
+        const float lo = -17.0f, hi = 13.0f;
+        const float eps = depth < 4 ? (hi - lo) * 0.6f / ((1 << depth) - 1) : (hi - lo) * 0.0021f * (1 << (8 - depth));
         FillRandom32f(orig, lo, hi);
 
         View src(SimdDescrIntEncodedSize(context2), 1, View::Gray8, NULL, TEST_ALIGN(SIMD_ALIGN));
@@ -340,7 +355,7 @@ namespace Test
         bool result = true;
 
         size_t size = Simd::Min(H * W, 128 * 256);
-        for (size_t depth = 4; depth <= 8; depth++)
+        for (size_t depth = 1; depth <= 8; depth++)
         {
             //result = result && DescrIntDecode32fAutoTest(256, depth, f1, f2);
             //result = result && DescrIntDecode32fAutoTest(512, depth, f1, f2);
@@ -422,7 +437,7 @@ namespace Test
         bool result = true;
 
         size_t size = Simd::Min(H * W, 128 * 256);
-        for (size_t depth = 4; depth <= 8; depth++)
+        for (size_t depth = 1; depth <= 8; depth++)
         {
             //result = result && DescrIntDecode16fAutoTest(256, depth, f1, f2);
             //result = result && DescrIntDecode16fAutoTest(512, depth, f1, f2);
@@ -495,7 +510,8 @@ namespace Test
         result = result && Compare(d1, d2, EPS * 0.1f * (1 << (8 - depth)), true, DifferenceRelative, "d1 & d2");
 
         ::SimdCosineDistance32f((float*)oA.data, (float*)oB.data, size, &d3);
-        result = result && Compare(d2, d3, EPS * 1.0f * (1 << (8 - depth)), true, DifferenceRelative, "d2 & d3");
+        const float approx = depth < 4 ? 0.2f : EPS * 1.0f * (1 << (8 - depth));
+        result = result && Compare(d2, d3, approx, true, DifferenceRelative, "d2 & d3");
 
         return result;
     }
@@ -505,7 +521,7 @@ namespace Test
         bool result = true;
 
         size_t size = Simd::Min(H * W, 128 * 256);
-        for (size_t depth = 4; depth <= 8; depth++)
+        for (size_t depth = 1; depth <= 8; depth++)
         {
             //result = result && DescrIntCosineDistanceAutoTest(256, depth, f1, f2);
             //result = result && DescrIntCosineDistanceAutoTest(512, depth, f1, f2);
@@ -580,7 +596,7 @@ namespace Test
     {
         bool result = true;
 
-        for (size_t depth = 4; depth <= 8; depth++)
+        for (size_t depth = 1; depth <= 8; depth++)
         {
             //result = result && DescrIntCosineDistancesMxNaAutoTest(127, 129, 520, depth, f1, f2);
             result = result && DescrIntCosineDistancesMxNaAutoTest(256, 128, 256, depth, f1, f2);
@@ -659,7 +675,7 @@ namespace Test
     {
         bool result = true;
 
-        for (size_t depth = 4; depth <= 8; depth++)
+        for (size_t depth = 1; depth <= 8; depth++)
         {
             result = result && DescrIntCosineDistancesMxNpAutoTest(256, 128, 256, depth, f1, f2);
             result = result && DescrIntCosineDistancesMxNpAutoTest(128, 128, 512, depth, f1, f2);
@@ -701,4 +717,410 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool DescrIntCosineDistancesMxNThreadsAutoTest(size_t M, size_t N, size_t size, size_t depth, FuncDI f)
+    {
+        bool result = true;
+
+        f.Update("CosineDistancesMxNThreads", M, N, size, depth);
+
+        TEST_LOG_SS(Info, "Test " << f.desc << ".");
+
+        void* context = f.func(size, depth);
+
+        View ai, bi, ap, bp;
+        U8Ptrs a, b;
+        InitEncoded(context, ai, M, -17.0, 13.0, 1024, &a);
+        InitEncoded(context, bi, N, -15.0, 17.0, 1024, &b);
+        InitEncoded(context, ap, M, -17.0, 13.0, 0, NULL);
+        InitEncoded(context, bp, N, -15.0, 17.0, 0, NULL);
+
+        size_t threads = SimdGetThreadNumber();
+        Tensor32f a1({ M, N, }), p1({ M, N, }), a2({ M, N, }), p2({ M, N, });
+        SimdSetThreadNumber(1);
+        f.CosineDistancesMxNa(context, a, b, a1);
+        f.CosineDistancesMxNp(context, ap, bp, p1);
+        for (size_t number = 2; number <= 8 && result; number *= 2)
+        {
+            SimdSetThreadNumber(number);
+            f.CosineDistancesMxNa(context, a, b, a2);
+            f.CosineDistancesMxNp(context, ap, bp, p2);
+            result = result && Compare(a1, a2, 0.0f, true, 32, DifferenceAbsolute, "MxNa threads " + ToString(number));
+            result = result && Compare(p1, p2, 0.0f, true, 32, DifferenceAbsolute, "MxNp threads " + ToString(number));
+        }
+        SimdSetThreadNumber(threads);
+
+        ::SimdRelease(context);
+
+        return result;
+    }
+
+    bool DescrIntCosineDistancesMxNThreadsAutoTest(const FuncDI& f)
+    {
+        bool result = true;
+
+        for (size_t depth = 4; depth <= 8; depth += 2)
+        {
+            result = result && DescrIntCosineDistancesMxNThreadsAutoTest(64, 1000, 512, depth, f);
+            result = result && DescrIntCosineDistancesMxNThreadsAutoTest(127, 333, 256, depth, f);
+        }
+
+        return result;
+    }
+
+    bool DescrIntCosineDistancesMxNThreadsAutoTest()
+    {
+        bool result = true;
+
+        result = result && DescrIntCosineDistancesMxNThreadsAutoTest(FUNC_DI(Simd::Base::DescrIntInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && DescrIntCosineDistancesMxNThreadsAutoTest(FUNC_DI(Simd::Sse41::DescrIntInit));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DescrIntCosineDistancesMxNThreadsAutoTest(FUNC_DI(Simd::Avx2::DescrIntInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && DescrIntCosineDistancesMxNThreadsAutoTest(FUNC_DI(Simd::Avx512bw::DescrIntInit));
+#endif
+
+#if defined(SIMD_AVX512VNNI_ENABLE) && !defined(SIMD_AMX_EMULATE)
+        if (Simd::Avx512vnni::Enable)
+            result = result && DescrIntCosineDistancesMxNThreadsAutoTest(FUNC_DI(Simd::Avx512vnni::DescrIntInit));
+#endif
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static bool CheckTopK(const Tensor32f& dense, size_t M, size_t N, size_t K, float threshold, const Idx32u& i, const Tensor32f& d, const String& desc)
+    {
+        const float eps = EPS * EPS * 2;
+        for (size_t m = 0; m < M; ++m)
+        {
+            std::vector<float> row(dense.Data() + m * N, dense.Data() + m * N + N);
+            std::sort(row.begin(), row.end());
+            for (size_t k = 0; k < K; ++k)
+            {
+                size_t o = m * K + k;
+                float expected = k < N && row[k] <= threshold ? row[k] : FLT_MAX;
+                if (expected == FLT_MAX)
+                {
+                    if (i[o] != UINT32_MAX && ::fabs(d.Data()[o] - threshold) > eps)
+                    {
+                        TEST_LOG_SS(Error, desc << " : unexpected neighbour [" << m << ", " << k << "] = " << i[o] << " with distance " << d.Data()[o] << " !");
+                        return false;
+                    }
+                    continue;
+                }
+                if (i[o] >= N || ::fabs(d.Data()[o] - expected) > eps || ::fabs(dense.Data()[m * N + i[o]] - d.Data()[o]) > eps)
+                {
+                    TEST_LOG_SS(Error, desc << " : wrong neighbour [" << m << ", " << k << "] = " << i[o] << " with distance " << d.Data()[o] << " instead of " << expected << " !");
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool DescrIntCosineDistancesTopKAutoTest(size_t M, size_t N, size_t K, float threshold, size_t size, size_t depth, FuncDI f1, FuncDI f2)
+    {
+        bool result = true;
+
+        f1.Update("CosineDistancesTopK", M, N, size, depth);
+        f2.Update("CosineDistancesTopK", M, N, size, depth);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [K=" << K << ", threshold=" << threshold << "].");
+
+        void* context1 = f1.func(size, depth);
+        void* context2 = f2.func(size, depth);
+
+        View a, b;
+        InitEncoded(context2, a, M, -17.0, 13.0, 0, NULL);
+        InitEncoded(context2, b, N, -15.0, 17.0, 0, NULL);
+
+        Tensor32f dense({ M, N, });
+        ::SimdDescrIntCosineDistancesMxNp(context1, M, N, a.data, b.data, dense.Data());
+
+        Idx32u i1(M * K), i2(M * K);
+        Tensor32f d1({ M, K, });
+        Tensor32f d2({ M, K, });
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.CosineDistancesTopKp(context1, a, b, K, threshold, i1, d1));
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.CosineDistancesTopKp(context2, a, b, K, threshold, i2, d2));
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        result = result && CheckTopK(dense, M, N, K, threshold, i1, d1, f1.desc);
+        result = result && CheckTopK(dense, M, N, K, threshold, i2, d2, f2.desc);
+
+        return result;
+    }
+
+    bool DescrIntCosineDistancesTopKAutoTest(const FuncDI& f1, const FuncDI& f2)
+    {
+        bool result = true;
+
+        for (size_t depth = 1; depth <= 8; depth++)
+        {
+            result = result && DescrIntCosineDistancesTopKAutoTest(64, 4000, 10, 3.0f, 256, depth, f1, f2);
+            result = result && DescrIntCosineDistancesTopKAutoTest(7, 20000, 32, 0.95f, 512, depth, f1, f2);
+        }
+        result = result && DescrIntCosineDistancesTopKAutoTest(5, 17, 25, 3.0f, 256, 7, f1, f2);
+
+        return result;
+    }
+
+    bool DescrIntCosineDistancesTopKAutoTest()
+    {
+        bool result = true;
+
+        result = result && DescrIntCosineDistancesTopKAutoTest(FUNC_DI(Simd::Base::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && DescrIntCosineDistancesTopKAutoTest(FUNC_DI(Simd::Sse41::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DescrIntCosineDistancesTopKAutoTest(FUNC_DI(Simd::Avx2::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && DescrIntCosineDistancesTopKAutoTest(FUNC_DI(Simd::Avx512bw::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+#if defined(SIMD_AVX512VNNI_ENABLE) && !defined(SIMD_AMX_EMULATE)
+        if (Simd::Avx512vnni::Enable)
+            result = result && DescrIntCosineDistancesTopKAutoTest(FUNC_DI(Simd::Avx512vnni::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static bool CheckTopKa(const void* context, const U8Ptrs& a, const U8Ptrs& b, size_t K, float threshold, const Idx32u& i, const Tensor32f& d, const String& desc)
+    {
+        const float eps = EPS * EPS * 2;
+        size_t M = a.size(), N = b.size();
+        std::vector<float> dist(N);
+        std::vector<uint32_t> order(N);
+        for (size_t m = 0; m < M; ++m)
+        {
+            for (size_t n = 0; n < N; ++n)
+            {
+                ::SimdDescrIntCosineDistance(context, a[m], b[n], dist.data() + n);
+                order[n] = uint32_t(n);
+            }
+            std::stable_sort(order.begin(), order.end(), [&dist](uint32_t l, uint32_t r) { return dist[l] < dist[r]; });
+            std::vector<bool> used(N, false);
+            for (size_t k = 0; k < K; ++k)
+            {
+                size_t o = m * K + k;
+                uint32_t index = i[o];
+                float distance = d.Data()[o];
+                if (k >= N || dist[order[k]] > threshold)
+                {
+                    if (index == UINT32_MAX ? distance != FLT_MAX : (index >= N || used[index] || ::fabs(dist[index] - threshold) > eps))
+                    {
+                        TEST_LOG_SS(Error, desc << " : unexpected neighbour [" << m << ", " << k << "] = " << index << " with distance " << distance << " !");
+                        return false;
+                    }
+                    if (index != UINT32_MAX)
+                        used[index] = true;
+                    continue;
+                }
+                uint32_t expected = order[k];
+                if (index >= N || used[index] || ::fabs(distance - dist[expected]) > eps || ::fabs(dist[index] - distance) > eps || 
+                    (index != expected && dist[index] == dist[expected]))
+                {
+                    TEST_LOG_SS(Error, desc << " : wrong neighbour [" << m << ", " << k << "] = " << index << " with distance " << distance 
+                        << " instead of " << expected << " with distance " << dist[expected] << " !");
+                    return false;
+                }
+                used[index] = true;
+            }
+        }
+        return true;
+    }
+
+    bool DescrIntCosineDistancesTopKaAutoTest(size_t M, size_t N, size_t K, float threshold, size_t size, size_t depth, FuncDI f1, FuncDI f2)
+    {
+        bool result = true;
+
+        f1.Update("CosineDistancesTopKa", M, N, size, depth);
+        f2.Update("CosineDistancesTopKa", M, N, size, depth);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [K=" << K << ", threshold=" << threshold << "].");
+
+        void* context1 = f1.func(size, depth);
+        void* context2 = f2.func(size, depth);
+
+        View ai, bi;
+        U8Ptrs a, b;
+        InitEncoded(context2, ai, M, -17.0, 13.0, 1024, &a);
+        InitEncoded(context2, bi, N, -15.0, 17.0, 1024, &b);
+        for (size_t n = 2; n < N; n += 3)
+            b[n] = b[n - 2];
+
+        Idx32u i1(M * K), i2(M * K);
+        Tensor32f d1({ M, K, });
+        Tensor32f d2({ M, K, });
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.CosineDistancesTopKa(context1, a, b, K, threshold, i1, d1));
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.CosineDistancesTopKa(context2, a, b, K, threshold, i2, d2));
+
+        result = result && CheckTopKa(context1, a, b, K, threshold, i1, d1, f1.desc);
+        result = result && CheckTopKa(context2, a, b, K, threshold, i2, d2, f2.desc);
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        return result;
+    }
+
+    bool DescrIntCosineDistancesTopKaAutoTest(const FuncDI& f1, const FuncDI& f2)
+    {
+        bool result = true;
+
+        for (size_t depth = 4; depth <= 8; depth += 4)
+        {
+            result = result && DescrIntCosineDistancesTopKaAutoTest(17, 3000, 10, 3.0f, 256, depth, f1, f2);
+            result = result && DescrIntCosineDistancesTopKaAutoTest(5, 5000, 32, 0.95f, 512, depth, f1, f2);
+        }
+        result = result && DescrIntCosineDistancesTopKaAutoTest(5, 17, 25, 3.0f, 256, 7, f1, f2);
+        result = result && DescrIntCosineDistancesTopKaAutoTest(3, 1, 4, 3.0f, 128, 6, f1, f2);
+
+        return result;
+    }
+
+    bool DescrIntCosineDistancesTopKaAutoTest()
+    {
+        bool result = true;
+
+        result = result && DescrIntCosineDistancesTopKaAutoTest(FUNC_DI(Simd::Base::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && DescrIntCosineDistancesTopKaAutoTest(FUNC_DI(Simd::Sse41::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DescrIntCosineDistancesTopKaAutoTest(FUNC_DI(Simd::Avx2::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && DescrIntCosineDistancesTopKaAutoTest(FUNC_DI(Simd::Avx512bw::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+#if defined(SIMD_AVX512VNNI_ENABLE) && !defined(SIMD_AMX_EMULATE)
+        if (Simd::Avx512vnni::Enable)
+            result = result && DescrIntCosineDistancesTopKaAutoTest(FUNC_DI(Simd::Avx512vnni::DescrIntInit), FUNC_DI(SimdDescrIntInit));
+#endif
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool DescrIntIndexAutoTest(size_t size, size_t depth, size_t lists, size_t N, size_t M, size_t K)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test DescrIntIndex [" << size << "-" << depth << "-" << lists << "-" << N << "-" << M << "-" << K << "].");
+
+        void* context = ::SimdDescrIntInit(size, depth);
+        void* index = ::SimdDescrIntIndexInit(size, depth, lists);
+        size_t encSize = ::SimdDescrIntEncodedSize(context);
+
+        Tensor32f gallery({ N, size }), queries({ M, size });
+        FillRandom(gallery, -15.0f, 17.0f);
+        FillRandom(queries, -17.0f, 13.0f);
+        Tensor8u a({ M, encSize }), b({ N, encSize });
+        for (size_t i = 0; i < N; ++i)
+            ::SimdDescrIntEncode32f(context, gallery.Data() + i * size, b.Data() + i * encSize);
+        for (size_t i = 0; i < M; ++i)
+            ::SimdDescrIntEncode32f(context, queries.Data() + i * size, a.Data() + i * encSize);
+        Tensor32f dense({ M, N });
+        ::SimdDescrIntCosineDistancesMxNp(context, M, N, a.Data(), b.Data(), dense.Data());
+        ::SimdRelease(context);
+
+        Idx32u ids(N), i1(M * K), i2(M * K);
+        for (size_t i = 0; i < N; ++i)
+            ids[i] = uint32_t(i);
+        Tensor32f d1({ M, K }), d2({ M, K });
+
+        result = result && ::SimdDescrIntIndexAdd(index, N, gallery.Data(), ids.data()) == SimdFalse;
+        result = result && ::SimdDescrIntIndexTrain(index, N, gallery.Data(), 10) == SimdTrue;
+        result = result && ::SimdDescrIntIndexAdd(index, N, gallery.Data(), ids.data()) == SimdTrue;
+        result = result && ::SimdDescrIntIndexSize(index) == N;
+
+        ::SimdDescrIntIndexSearch(index, M, queries.Data(), lists, K, 3.0f, i1.data(), d1.Data());
+        result = result && CheckTopK(dense, M, N, K, 3.0f, i1, d1, "DescrIntIndex");
+
+        Idx32u removed;
+        for (size_t i = 0; i < N; i += 3)
+        {
+            removed.push_back(uint32_t(i));
+            for (size_t m = 0; m < M; ++m)
+                dense.Data()[m * N + i] = FLT_MAX;
+        }
+        result = result && ::SimdDescrIntIndexRemove(index, removed.size(), removed.data()) == removed.size();
+        result = result && ::SimdDescrIntIndexSize(index) == N - removed.size();
+        ::SimdDescrIntIndexSearch(index, M, queries.Data(), lists, K, 0.95f, i1.data(), d1.Data());
+        result = result && CheckTopK(dense, M, N, K, 0.95f, i1, d1, "DescrIntIndex removed");
+
+        const String path = "descr_int_index.bin";
+        size_t nprobe = Simd::Max<size_t>(lists / 4, 1);
+        ::SimdDescrIntIndexSearch(index, M, queries.Data(), nprobe, K, 3.0f, i1.data(), d1.Data());
+        result = result && ::SimdDescrIntIndexSave(index, path.c_str()) == SimdTrue;
+        ::SimdRelease(index);
+
+        index = ::SimdDescrIntIndexInit(size, depth, 1);
+        result = result && ::SimdDescrIntIndexLoad(index, path.c_str()) == SimdTrue;
+        result = result && ::SimdDescrIntIndexSize(index) == N - removed.size();
+        ::SimdDescrIntIndexSearch(index, M, queries.Data(), nprobe, K, 3.0f, i2.data(), d2.Data());
+        result = result && i1 == i2 && Compare(d1, d2, 0.0f, true, 32, DifferenceAbsolute, "loaded");
+
+        result = result && ::SimdDescrIntIndexSave(index, path.c_str()) == SimdTrue;
+        ::SimdDescrIntIndexSearch(index, M, queries.Data(), nprobe, K, 3.0f, i2.data(), d2.Data());
+        result = result && i1 == i2 && Compare(d1, d2, 0.0f, true, 32, DifferenceAbsolute, "saved over loaded");
+        ::SimdRelease(index);
+
+        index = ::SimdDescrIntIndexInit(size, depth, 1);
+        result = result && ::SimdDescrIntIndexLoad(index, path.c_str()) == SimdTrue;
+        result = result && ::SimdDescrIntIndexSize(index) == N - removed.size();
+        ::SimdDescrIntIndexSearch(index, M, queries.Data(), nprobe, K, 3.0f, i2.data(), d2.Data());
+        result = result && i1 == i2 && Compare(d1, d2, 0.0f, true, 32, DifferenceAbsolute, "reloaded");
+        ::SimdRelease(index);
+        ::remove(path.c_str());
+
+        if (!result)
+            TEST_LOG_SS(Error, "DescrIntIndex test failed!");
+
+        return result;
+    }
+
+    bool DescrIntIndexAutoTest()
+    {
+        bool result = true;
+
+        result = result && DescrIntIndexAutoTest(256, 8, 16, 3000, 17, 10);
+        result = result && DescrIntIndexAutoTest(512, 6, 32, 5000, 9, 32);
+        result = result && DescrIntIndexAutoTest(128, 4, 7, 500, 5, 5);
+
+        return result;
+    }
 }
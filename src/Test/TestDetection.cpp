@@ -440,7 +440,7 @@ namespace Test
     typedef Simd::Detection<Simd::Allocator> Detection;
     typedef Detection::Objects Objects;
 
-    static void DetectionSpecialTest(Detection & detection, Objects & objects, int threadNumber)
+    static void DetectionSpecialTest(Detection & detection, Objects & objects, int threadNumber, bool parallelLevels = false)
     {
         View src = GetSample(Size(W, H), true);
 
@@ -449,8 +449,9 @@ namespace Test
         Simd::Fill(roi.Region(Size(W/3, H/2), View::MiddleRight).Ref(), 0);
 
         double time = GetTime();
-        detection.Init(src.Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), roi, threadNumber);
-        TEST_LOG_SS(Info, "Init for " << threadNumber << " : " << (GetTime() - time) * 1000 << " ms ");
+        detection.Init(src.Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), roi, threadNumber, parallelLevels);
+        String desc = ToString(threadNumber) + (parallelLevels ? "-p" : "");
+        TEST_LOG_SS(Info, "Init for " << desc << " : " << (GetTime() - time) * 1000 << " ms ");
 
         Detection::Rects rects;
         size_t B = O + E;
@@ -458,7 +459,7 @@ namespace Test
 
         time = GetTime();
         detection.Detect(src, objects, 3, 0.2, true, rects);
-        TEST_LOG_SS(Info, "Detect for " << threadNumber << " : " << (GetTime() - time) * 1000 << " ms " << std::endl);
+        TEST_LOG_SS(Info, "Detect for " << desc << " : " << (GetTime() - time) * 1000 << " ms " << std::endl);
 
         View dst(src.Size(), View::Gray8);
         Simd::Copy(src, dst);
@@ -468,7 +469,7 @@ namespace Test
             Size s = objects[i].rect.Size();
             Simd::DrawRectangle(dst, objects[i].rect, uint8_t(255));
         }
-        dst.Save(String("faces_") + ToString(threadNumber) + ".pgm");
+        dst.Save(String("faces_") + desc + ".pgm");
 
 #ifdef TEST_PERFORMANCE_TEST_ENABLE
         TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.ConsoleReport(false, true));
@@ -476,29 +477,8 @@ namespace Test
 #endif
     }
 
-    bool DetectionSpecialTest()
+    static bool DetectionCompare(const Objects & os, const Objects & om, const String & desc)
     {
-        Detection detection;
-
-        double time = GetTime();
-        detection.Load(ROOT_PATH + "/data/cascade/haar_face_0.xml", 0);
-        detection.Load(ROOT_PATH + "/data/cascade/haar_face_1.xml", 1);
-        detection.Load(ROOT_PATH + "/data/cascade/lbp_face.xml", 2);
-        TEST_LOG_SS(Info, "Load: " << (GetTime() - time) * 1000 << " ms " << std::endl);
-
-        Objects os, om;
-
-        DetectionSpecialTest(detection, os, 1);
-
-        if (std::thread::hardware_concurrency() >= 2)
-            DetectionSpecialTest(detection, om, 2);
-
-        if(std::thread::hardware_concurrency() >= 4)
-            DetectionSpecialTest(detection, om, 4);
-
-        if (std::thread::hardware_concurrency() >= 8)
-            DetectionSpecialTest(detection, om, 8);
-
         bool result = true;
         if (os.size() != om.size())
             result = false;
@@ -523,7 +503,7 @@ namespace Test
                     << os[i].rect.right << ", " << os[i].rect.bottom << ") - " << os[i].weight);
             }
 
-            TEST_LOG_SS(Error, "Detection multi threads: ");
+            TEST_LOG_SS(Error, "Detection " << desc << ": ");
             for (size_t i = 0; i < om.size(); ++i)
             {
                 TEST_LOG_SS(Error, "(" << om[i].rect.left << ", " << om[i].rect.top << ", "
@@ -533,5 +513,87 @@ namespace Test
 
         return result;
     }
+
+    static bool DetectionParallelLevelsAutoTest(Detection & detection, const Size & size, bool motionMask)
+    {
+        TEST_LOG_SS(Info, "Test Detection parallel levels [" << size.x << "x" << size.y << (motionMask ? "-m" : "") << "].");
+
+        View src = GetSample(size, false);
+
+        View roi(src.Size(), View::Gray8);
+        Simd::Fill(roi, 255);
+        Simd::Fill(roi.Region(Size(size.x / 3, size.y / 2), View::MiddleRight).Ref(), 0);
+
+        Detection::Rects rects;
+        if (motionMask)
+        {
+            size_t B = O + E;
+            rects.push_back(Rect(B, B, size.x - B, size.y - B));
+        }
+
+        Objects os, op;
+        if (!detection.Init(src.Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), roi, 1, false) || !detection.Detect(src, os, 3, 0.2, motionMask, rects))
+        {
+            TEST_LOG_SS(Error, "Can't detect objects in serial mode!");
+            return false;
+        }
+        if (!detection.Init(src.Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), roi, 4, true) || !detection.Detect(src, op, 3, 0.2, motionMask, rects))
+        {
+            TEST_LOG_SS(Error, "Can't detect objects in parallel levels mode!");
+            return false;
+        }
+
+        return DetectionCompare(os, op, "parallel levels");
+    }
+
+    bool DetectionParallelLevelsAutoTest()
+    {
+        Detection detection;
+        if (!detection.Load(ROOT_PATH + "/data/cascade/haar_face_0.xml", 0) || !detection.Load(ROOT_PATH + "/data/cascade/haar_face_1.xml", 1) || 
+            !detection.Load(ROOT_PATH + "/data/cascade/lbp_face.xml", 2))
+        {
+            TEST_LOG_SS(Error, "Can't load cascades!");
+            return false;
+        }
+
+        bool result = true;
+
+        result = result && DetectionParallelLevelsAutoTest(detection, Size(W, H), false);
+        result = result && DetectionParallelLevelsAutoTest(detection, Size(W + O, H - O), true);
+
+        return result;
+    }
+
+    bool DetectionSpecialTest()
+    {
+        Detection detection;
+
+        double time = GetTime();
+        detection.Load(ROOT_PATH + "/data/cascade/haar_face_0.xml", 0);
+        detection.Load(ROOT_PATH + "/data/cascade/haar_face_1.xml", 1);
+        detection.Load(ROOT_PATH + "/data/cascade/lbp_face.xml", 2);
+        TEST_LOG_SS(Info, "Load: " << (GetTime() - time) * 1000 << " ms " << std::endl);
+
+        Objects os, om;
+
+        DetectionSpecialTest(detection, os, 1);
+
+        if (std::thread::hardware_concurrency() >= 2)
+            DetectionSpecialTest(detection, om, 2);
+
+        if(std::thread::hardware_concurrency() >= 4)
+            DetectionSpecialTest(detection, om, 4);
+
+        if (std::thread::hardware_concurrency() >= 8)
+            DetectionSpecialTest(detection, om, 8);
+
+        bool result = DetectionCompare(os, om, "multi threads");
+
+        Objects op;
+        DetectionSpecialTest(detection, op, -1, true);
+        result = result && DetectionCompare(os, op, "parallel levels");
+
+        return result;
+    }
 }
 
@@ -23,6 +23,8 @@
 */
 #include "Test/TestFile.h"
 
+#include <atomic>
+
 #if defined(_WIN32)
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -137,4 +139,22 @@ namespace Test
         }
         return result;
     }
+
+    String TempPath(const String& name)
+    {
+        static std::atomic<size_t> counter(0);
+        std::stringstream ss;
+#if defined(_WIN32)
+        char dir[MAX_PATH + 1];
+        DWORD size = ::GetTempPathA(MAX_PATH + 1, dir);
+        ss << String(dir, size) << "simd_" << ::GetCurrentProcessId();
+#elif defined(__linux__)
+        const char* dir = ::getenv("TMPDIR");
+        ss << MakePath(dir && dir[0] ? dir : "/tmp", "simd_") << ::getpid();
+#else
+        ss << "simd_";
+#endif
+        ss << "_" << counter++ << "_" << name;
+        return ss.str();
+    }
 }
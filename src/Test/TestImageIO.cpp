@@ -260,6 +260,139 @@ namespace Test
 
     //-----------------------------------------------------------------------
 
+    bool ImageSaveJpegThreadsAutoTest(size_t width, size_t height, View::Format format, int quality)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdImageSaveToMemory[" << ToString(format) << "-Jpeg-" << quality << "] by thread number [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        ::srand(0);
+        View buffer(src.Size(), src.format);
+        FillRandom(buffer);
+        Simd::MeanFilter3x3(buffer, src);
+
+        size_t threads = SimdGetThreadNumber();
+        View dst1;
+        for (size_t number = 1; number <= 8 && result; number *= 2)
+        {
+            SimdSetThreadNumber(number);
+            size_t size = 0, count = 0;
+            uint8_t* data = NULL;
+            double time = ExecuteForTime([&]()
+            {
+                if (data)
+                    SimdFree(data);
+                data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, SimdImageFileJpeg, quality, &size);
+                return data != NULL;
+            }, count);
+            if (data == NULL)
+            {
+                TEST_LOG_SS(Error, "Can't encode JPEG!");
+                result = false;
+                break;
+            }
+            TEST_LOG_SS(Info, "Threads: " << number << ", speed: " << ToString(double(src.width * src.height * src.PixelSize() * count) / time / 1000000.0, 1, false) << " MB/s.");
+
+            View dst2;
+            SimdSetThreadNumber(1);
+            if (!dst2.Load(data, size, format))
+            {
+                TEST_LOG_SS(Error, "Can't decode JPEG encoded with " << number << " threads!");
+                result = false;
+            }
+            else if (number == 1)
+                dst1.Swap(dst2);
+            else
+                result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+            SimdFree(data);
+        }
+        SimdSetThreadNumber(threads);
+
+        return result;
+    }
+
+    bool ImageSaveJpegThreadsAutoTest()
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && ImageSaveJpegThreadsAutoTest(W, H, formats[format], 95);
+            result = result && ImageSaveJpegThreadsAutoTest(W + O, H - O, formats[format], 65);
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool ImageSavePngThreadsAutoTest(size_t width, size_t height, View::Format format, int quality)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdImageSaveToMemory[" << ToString(format) << "-Png-" << quality << "] by thread number [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        ::srand(0);
+        View buffer(src.Size(), src.format);
+        FillRandom(buffer);
+        Simd::MeanFilter3x3(buffer, src);
+
+        size_t threads = SimdGetThreadNumber();
+        for (size_t number = 1; number <= 8 && result; number *= 2)
+        {
+            SimdSetThreadNumber(number);
+            size_t size = 0, count = 0;
+            uint8_t* data = NULL;
+            double time = ExecuteForTime([&]()
+            {
+                if (data)
+                    SimdFree(data);
+                data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, SimdImageFilePng, quality, &size);
+                return data != NULL;
+            }, count);
+            if (data == NULL)
+            {
+                TEST_LOG_SS(Error, "Can't encode PNG!");
+                result = false;
+                break;
+            }
+            TEST_LOG_SS(Info, "Threads: " << number << ", speed: " << ToString(double(src.width * src.height * src.PixelSize() * count) / time / 1000000.0, 1, false) << " MB/s, size: " << size << " bytes.");
+
+            View dst;
+            SimdSetThreadNumber(1);
+            if (!dst.Load(data, size, format))
+            {
+                TEST_LOG_SS(Error, "Can't decode PNG encoded with " << number << " threads!");
+                result = false;
+            }
+            else
+                result = result && Compare(src, dst, 0, true, 64, 0, "src & dst");
+            SimdFree(data);
+        }
+        SimdSetThreadNumber(threads);
+
+        return result;
+    }
+
+    bool ImageSavePngThreadsAutoTest()
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && ImageSavePngThreadsAutoTest(W, H, formats[format], 100);
+            result = result && ImageSavePngThreadsAutoTest(W + O, H - O, formats[format], 10);
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
     namespace
     {
         struct FuncSNJM
@@ -665,7 +798,7 @@ namespace Test
         std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
         for (size_t format = 0; format < formats.size(); format++)
         {
-            for (int file = (int)SimdImageFileJpeg; file <= (int)SimdImageFileJpeg; file++)
+            for (int file = (int)SimdImageFilePng; file <= (int)SimdImageFileJpeg; file++)
             {
                 if (file == SimdImageFileJpeg)
                 {
@@ -711,6 +844,623 @@ namespace Test
 
     //-----------------------------------------------------------------------
 
+    namespace
+    {
+        void AppendPngChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data)
+        {
+            std::vector<uint8_t> chunk(type, type + 4);
+            chunk.insert(chunk.end(), data.begin(), data.end());
+            uint32_t size = (uint32_t)data.size(), crc = SimdCrc32(chunk.data(), chunk.size());
+            for (int i = 3; i >= 0; --i)
+                png.push_back(uint8_t(size >> (8 * i)));
+            png.insert(png.end(), chunk.begin(), chunk.end());
+            for (int i = 3; i >= 0; --i)
+                png.push_back(uint8_t(crc >> (8 * i)));
+        }
+
+        // Writes random 16-bit PNG with random row filters. Image data is stored in uncompressed deflate blocks.
+        void MakePng16(size_t width, size_t height, int color, std::vector<uint8_t>& png)
+        {
+            size_t channels = (color & 2 ? 3 : 1) + (color & 4 ? 1 : 0), row = width * channels * 2 + 1;
+            std::vector<uint8_t> raw(row * height);
+            for (size_t y = 0; y < height; ++y)
+            {
+                raw[y * row] = uint8_t(::rand() % 5);
+                for (size_t x = 1; x < row; ++x)
+                    raw[y * row + x] = uint8_t(::rand());
+            }
+
+            std::vector<uint8_t> z = { 0x78, 0x01 };
+            for (size_t offs = 0; offs < raw.size();)
+            {
+                size_t size = std::min<size_t>(raw.size() - offs, 0xFFFF);
+                z.push_back(offs + size == raw.size() ? 1 : 0);
+                z.push_back(uint8_t(size));
+                z.push_back(uint8_t(size >> 8));
+                z.push_back(uint8_t(~size));
+                z.push_back(uint8_t(~size >> 8));
+                z.insert(z.end(), raw.begin() + offs, raw.begin() + offs + size);
+                offs += size;
+            }
+            uint32_t a = 1, b = 0;
+            for (size_t i = 0; i < raw.size(); ++i)
+            {
+                a = (a + raw[i]) % 65521;
+                b = (b + a) % 65521;
+            }
+            uint32_t adler = (b << 16) | a;
+            for (int i = 3; i >= 0; --i)
+                z.push_back(uint8_t(adler >> (8 * i)));
+
+            std::vector<uint8_t> header;
+            for (int i = 3; i >= 0; --i)
+                header.push_back(uint8_t(width >> (8 * i)));
+            for (int i = 3; i >= 0; --i)
+                header.push_back(uint8_t(height >> (8 * i)));
+            header.insert(header.end(), { 16, uint8_t(color), 0, 0, 0 });
+
+            png.assign({ 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A });
+            AppendPngChunk(png, "IHDR", header);
+            AppendPngChunk(png, "IDAT", z);
+            AppendPngChunk(png, "IEND", std::vector<uint8_t>());
+        }
+    }
+
+    bool ImageLoadPng16AutoTest(size_t width, size_t height, int color, View::Format format, FuncLM f1, FuncLM f2)
+    {
+        bool result = true;
+
+        f1.Update(format, SimdImageFilePng, 0);
+        f2.Update(format, SimdImageFilePng, 0);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " for 16-bit PNG (color type " << color << ") [" << width << ", " << height << "].");
+
+        std::vector<uint8_t> png;
+        MakePng16(width, height, color, png);
+
+        View dst1, dst2;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (dst1.data) Simd::Free(dst1.data); f1.Call(png.data(), png.size(), format, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (dst2.data) SimdFree(dst2.data); f2.Call(png.data(), png.size(), format, dst2));
+
+        if (dst1.data == NULL || dst2.data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't decode 16-bit PNG!");
+            result = false;
+        }
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+
+        if (dst1.data)
+            Simd::Free(dst1.data);
+        if (dst2.data)
+            SimdFree(dst2.data);
+
+        return result;
+    }
+
+    bool ImageLoadPng16AutoTest(const FuncLM& f1, const FuncLM& f2)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        std::vector<int> colors = { 0, 2, 4, 6 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (size_t color = 0; color < colors.size(); color++)
+            {
+                result = result && ImageLoadPng16AutoTest(W, H, colors[color], formats[format], f1, f2);
+                result = result && ImageLoadPng16AutoTest(W + O, H - O, colors[color], formats[format], f1, f2);
+            }
+        }
+
+        return result;
+    }
+
+    bool ImageLoadPng16AutoTest()
+    {
+        bool result = true;
+
+        result = result && ImageLoadPng16AutoTest(FUNC_LM(Simd::Base::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ImageLoadPng16AutoTest(FUNC_LM(Simd::Sse41::ImageLoadFromMemory), FUNC_LM(SimdImageLoadFromMemory));
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        // Encodes every MCU row of the image as a separate strip (so the DC prediction of each strip starts from zero)
+        // and joins the entropy-coded segments of the strips with RSTn markers into one JPEG with a restart interval.
+        bool MakeJpegWithRestarts(const View& src, int quality, std::vector<uint8_t>& jpeg)
+        {
+            size_t size = 0;
+            uint8_t* data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, SimdImageFileJpeg, quality, &size);
+            if (data == NULL)
+                return false;
+            size_t pos = 2, sof = 0, sos = 0;
+            while (sos == 0 && pos + 4 < size && data[pos] == 0xFF)
+            {
+                if (data[pos + 1] == 0xC0)
+                    sof = pos;
+                if (data[pos + 1] == 0xDA)
+                    sos = pos;
+                pos += 2 + (data[pos + 2] << 8 | data[pos + 3]);
+            }
+            if (sof == 0 || sos == 0)
+            {
+                SimdFree(data);
+                return false;
+            }
+            size_t block = (data[sof + 11] & 0xF) * 8, interval = (src.width + block - 1) / block;
+            const uint8_t dri[] = { 0xFF, 0xDD, 0x00, 0x04, uint8_t(interval >> 8), uint8_t(interval) };
+            jpeg.assign(data, data + sos);
+            jpeg.insert(jpeg.end(), dri, dri + sizeof(dri));
+            jpeg.insert(jpeg.end(), data + sos, data + pos);
+            SimdFree(data);
+            for (size_t row = 0, i = 0; row < src.height; row += block, ++i)
+            {
+                View strip = src.Region(0, row, src.width, row + block);
+                data = SimdImageSaveToMemory(strip.data, strip.stride, strip.width, strip.height, (SimdPixelFormatType)strip.format, SimdImageFileJpeg, quality, &size);
+                if (data == NULL)
+                    return false;
+                if (i)
+                {
+                    jpeg.push_back(0xFF);
+                    jpeg.push_back(uint8_t(0xD0 + (i - 1) % 8));
+                }
+                jpeg.insert(jpeg.end(), data + pos, data + size - 2);
+                SimdFree(data);
+            }
+            jpeg.push_back(0xFF);
+            jpeg.push_back(0xD9);
+            return true;
+        }
+    }
+
+    bool ImageLoadJpegRestartAutoTest(size_t width, size_t height, View::Format format, int quality, FuncLM f)
+    {
+        bool result = true;
+
+        f.Update(format, SimdImageFileJpeg, quality);
+
+        TEST_LOG_SS(Info, "Test " << f.desc << " with restart markers [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        ::srand(0);
+        View buffer(src.Size(), src.format);
+        FillRandom(buffer);
+        Simd::MeanFilter3x3(buffer, src);
+
+        size_t size = 0;
+        uint8_t* data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, SimdImageFileJpeg, quality, &size);
+        std::vector<uint8_t> restarts;
+        if (data == NULL || !MakeJpegWithRestarts(src, quality, restarts))
+        {
+            TEST_LOG_SS(Error, "Can't create JPEG with restart markers!");
+            SimdFree(data);
+            return false;
+        }
+
+        View dst1, dst2;
+
+        f.Call(data, size, format, dst1);
+
+        size_t threads = SimdGetThreadNumber();
+        SimdSetThreadNumber(std::max<size_t>(threads, 4));
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (dst2.data) SimdFree(dst2.data); f.Call(restarts.data(), restarts.size(), format, dst2));
+        SimdSetThreadNumber(threads);
+
+        if (dst1.data == NULL || dst2.data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't decode JPEG!");
+            result = false;
+        }
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+
+        if (dst1.data)
+            SimdFree(dst1.data);
+        if (dst2.data)
+            SimdFree(dst2.data);
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool ImageLoadJpegRestartAutoTest(const FuncLM& f)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && ImageLoadJpegRestartAutoTest(W, H, formats[format], 95, f);
+            result = result && ImageLoadJpegRestartAutoTest(W + O, H - O, formats[format], 65, f);
+        }
+
+        return result;
+    }
+
+    bool ImageLoadJpegRestartAutoTest()
+    {
+        bool result = true;
+
+        result = result && ImageLoadJpegRestartAutoTest(FUNC_LM(Simd::Base::ImageLoadFromMemory));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && ImageLoadJpegRestartAutoTest(FUNC_LM(Simd::Sse41::ImageLoadFromMemory));
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    static void ReduceBox(const View& src, size_t scale, View& dst)
+    {
+        size_t channels = src.ChannelCount();
+        dst.Recreate(Simd::DivHi(src.width, scale), Simd::DivHi(src.height, scale), src.format);
+        for (size_t dy = 0; dy < dst.height; ++dy)
+        {
+            size_t sy0 = dy * scale, sy1 = std::min(sy0 + scale, src.height);
+            for (size_t dx = 0; dx < dst.width; ++dx)
+            {
+                size_t sx0 = dx * scale, sx1 = std::min(sx0 + scale, src.width);
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    size_t sum = 0;
+                    for (size_t sy = sy0; sy < sy1; ++sy)
+                        for (size_t sx = sx0; sx < sx1; ++sx)
+                            sum += src.At<uint8_t>(sx * channels + c, sy);
+                    size_t area = (sy1 - sy0) * (sx1 - sx0);
+                    dst.At<uint8_t>(dx * channels + c, dy) = uint8_t((sum + area / 2) / area);
+                }
+            }
+        }
+    }
+
+    bool ImageLoadFromMemoryScaledAutoTest(size_t width, size_t height, View::Format format, int quality, size_t scale)
+    {
+        bool result = true;
+
+        String desc = String("SimdImageLoadFromMemoryScaled[") + ToString(format) + "-" + ToString(quality) + "-" + ToString(scale) + "]";
+
+        TEST_LOG_SS(Info, "Test " << desc << " [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        size_t channels = src.ChannelCount();
+        for (size_t y = 0; y < height; ++y)
+            for (size_t x = 0; x < width; ++x)
+                for (size_t c = 0; c < channels; ++c)
+                    src.At<uint8_t>(x * channels + c, y) = uint8_t(128.0 + 100.0 * ::sin(0.005 * x * (c + 1) + 0.0025 * y * (3 - c)));
+
+        size_t size = 0;
+        uint8_t* data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, SimdImageFileJpeg, quality, &size);
+        if (data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't encode JPEG!");
+            return false;
+        }
+
+        View full, dst1, dst2;
+        ((View::Format&)full.format) = format;
+        *(uint8_t**)&full.data = SimdImageLoadFromMemory(data, size, (size_t*)&full.stride, (size_t*)&full.width, (size_t*)&full.height, (SimdPixelFormatType*)&full.format);
+        ((View::Format&)dst2.format) = format;
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            *(uint8_t**)&dst2.data = SimdImageLoadFromMemoryScaled(data, size, scale, (size_t*)&dst2.stride, (size_t*)&dst2.width, (size_t*)&dst2.height, (SimdPixelFormatType*)&dst2.format);
+        }
+
+        if (full.data == NULL || dst2.data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't decode JPEG!");
+            result = false;
+        }
+        else if (dst2.width != Simd::DivHi(width, scale) || dst2.height != Simd::DivHi(height, scale) || dst2.format != format)
+        {
+            TEST_LOG_SS(Error, "Wrong size of scaled image: [" << dst2.width << ", " << dst2.height << "] != [" << Simd::DivHi(width, scale) << ", " << Simd::DivHi(height, scale) << "]!");
+            result = false;
+        }
+        else
+        {
+            ReduceBox(full, scale, dst1);
+            result = result && Compare(dst1, dst2, GetMaxJpegError(quality), true, 64, 0, "dst1 & dst2");
+        }
+
+        if (full.data)
+            SimdFree(full.data);
+        if (dst2.data)
+            SimdFree(dst2.data);
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool ImageLoadFromMemoryScaledAutoTest()
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (size_t scale = 1; scale <= 8; scale *= 2)
+            {
+                result = result && ImageLoadFromMemoryScaledAutoTest(W, H, formats[format], 95, scale);
+                result = result && ImageLoadFromMemoryScaledAutoTest(W + O, H - O, formats[format], 65, scale);
+            }
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool ImageDecoderAutoTest(size_t width, size_t height, View::Format format, SimdImageFileType file, int quality, bool restarts)
+    {
+        bool result = true;
+
+        String desc = String("SimdImageDecoder[") + ToString(format) + "-" + ToString(file) +
+            (file == SimdImageFileJpeg ? String("-") + ToString(quality) + (restarts ? "-rst" : "") : String("")) + "]";
+
+        TEST_LOG_SS(Info, "Test " << desc << " [" << width << ", " << height << "].");
+
+        View src(width, height, format, NULL, TEST_ALIGN(width));
+        ::srand(0);
+        View buffer(src.Size(), src.format);
+        FillRandom(buffer);
+        Simd::MeanFilter3x3(buffer, src);
+
+        std::vector<uint8_t> encoded;
+        if (restarts)
+            result = MakeJpegWithRestarts(src, quality, encoded);
+        else
+        {
+            size_t size = 0;
+            uint8_t* data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, file, quality, &size);
+            if (data)
+                encoded.assign(data, data + size);
+            result = data != NULL;
+            SimdFree(data);
+        }
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Can't encode image!");
+            return false;
+        }
+
+        View dst1;
+        ((View::Format&)dst1.format) = format;
+        *(uint8_t**)&dst1.data = SimdImageLoadFromMemory(encoded.data(), encoded.size(), (size_t*)&dst1.stride, (size_t*)&dst1.width, (size_t*)&dst1.height, (SimdPixelFormatType*)&dst1.format);
+        if (dst1.data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't decode image!");
+            return false;
+        }
+
+        View dst2(dst1.width, dst1.height, dst1.format);
+        size_t rows = 0, early = 0;
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            void* decoder = SimdImageDecoderInit((SimdPixelFormatType)format);
+            rows = 0;
+            for (size_t pos = 0, part; result && pos < encoded.size(); pos += part)
+            {
+                part = std::min<size_t>(1 + ::rand() % 4096, encoded.size() - pos);
+                early = rows;
+                result = decoder && SimdImageDecoderFeed(decoder, encoded.data() + pos, part) == SimdTrue;
+                size_t w, h;
+                SimdPixelFormatType f;
+                if (result && SimdImageDecoderInfo(decoder, &w, &h, &f))
+                {
+                    if (w != dst2.width || h != dst2.height || f != (SimdPixelFormatType)dst2.format)
+                    {
+                        TEST_LOG_SS(Error, "Wrong image info: [" << w << ", " << h << "] != [" << dst2.width << ", " << dst2.height << "]!");
+                        result = false;
+                    }
+                    else
+                        rows += SimdImageDecoderPull(decoder, dst2.Row<uint8_t>(rows), dst2.stride, std::min<size_t>(1 + ::rand() % 64, h - rows));
+                }
+            }
+            if (result)
+            {
+                while (rows < dst2.height)
+                {
+                    size_t pulled = SimdImageDecoderPull(decoder, dst2.Row<uint8_t>(rows), dst2.stride, dst2.height - rows);
+                    if (pulled == 0)
+                        break;
+                    rows += pulled;
+                }
+            }
+            if (decoder)
+                SimdRelease(decoder);
+        }
+
+        if (!result || rows != dst2.height)
+        {
+            TEST_LOG_SS(Error, "Can't decode image incrementally: " << rows << " rows of " << dst2.height << " are decoded!");
+            result = false;
+        }
+        else if (early == 0)
+        {
+            TEST_LOG_SS(Error, "No rows are decoded before the end of the image file!");
+            result = false;
+        }
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+
+        SimdFree(dst1.data);
+
+        return result;
+    }
+
+    bool ImageDecoderAutoTest()
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && ImageDecoderAutoTest(W, H, formats[format], SimdImageFileJpeg, 95, false);
+            result = result && ImageDecoderAutoTest(W + O, H - O, formats[format], SimdImageFileJpeg, 65, false);
+            result = result && ImageDecoderAutoTest(W, H, formats[format], SimdImageFileJpeg, 85, true);
+            result = result && ImageDecoderAutoTest(W, H, formats[format], SimdImageFilePng, 0, false);
+            result = result && ImageDecoderAutoTest(W + O, H - O, formats[format], SimdImageFilePng, 0, false);
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool ImageLoadFromMemoryIntoAutoTest(size_t width, size_t height, SimdImageFileType file, View::Format format)
+    {
+        bool result = true;
+
+        String desc = String("SimdImageLoadFromMemoryInto[") + ToString(file) + "-" + ToString(format) + "]";
+
+        TEST_LOG_SS(Info, "Test " << desc << " [" << width << ", " << height << "].");
+
+        View src(width, height, View::Bgr24, NULL, TEST_ALIGN(width));
+        ::srand(0);
+        View buffer(src.Size(), src.format);
+        FillRandom(buffer);
+        Simd::MeanFilter3x3(buffer, src);
+
+        size_t size = 0;
+        uint8_t* data = SimdImageSaveToMemory(src.data, src.stride, src.width, src.height, (SimdPixelFormatType)src.format, file, 85, &size);
+        if (data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't encode image!");
+            return false;
+        }
+
+        View dst1;
+        ((View::Format&)dst1.format) = format;
+        *(uint8_t**)&dst1.data = SimdImageLoadFromMemory(data, size, (size_t*)&dst1.stride, (size_t*)&dst1.width, (size_t*)&dst1.height, (SimdPixelFormatType*)&dst1.format);
+
+        std::vector<uint8_t> external((width * View::PixelSize(format) + 3) * height, 0x5A);
+        View dst2(width, height, width * View::PixelSize(format) + 3, format, external.data());
+        SimdBool loaded = SimdFalse;
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            loaded = SimdImageLoadFromMemoryInto(data, size, dst2.data, dst2.stride, dst2.width, dst2.height, (SimdPixelFormatType)format);
+        }
+        View dst3(width + 1, height, format);
+        SimdBool mismatch = SimdImageLoadFromMemoryInto(data, size, dst3.data, dst3.stride, dst3.width, dst3.height, (SimdPixelFormatType)format);
+
+        if (dst1.data == NULL || loaded == SimdFalse)
+        {
+            TEST_LOG_SS(Error, "Can't decode image!");
+            result = false;
+        }
+        else if (mismatch == SimdTrue)
+        {
+            TEST_LOG_SS(Error, "Image is decoded into buffer of wrong size!");
+            result = false;
+        }
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+
+        if (dst1.data)
+            SimdFree(dst1.data);
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool ImageLoadFromMemoryIntoAutoTest()
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && ImageLoadFromMemoryIntoAutoTest(W, H, SimdImageFileJpeg, formats[format]);
+            result = result && ImageLoadFromMemoryIntoAutoTest(W + O, H - O, SimdImageFileJpeg, formats[format]);
+            result = result && ImageLoadFromMemoryIntoAutoTest(W + O, H - O, SimdImageFilePng, formats[format]);
+            result = result && ImageLoadFromMemoryIntoAutoTest(W, H, SimdImageFilePpmBin, formats[format]);
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool ImageLoadJpegToYuv420pAutoTest(size_t width, size_t height, bool yuv, int quality)
+    {
+        bool result = true;
+
+        String desc = String("SimdImageLoadJpegToYuv420p[") + (yuv ? "yuv420p" : "bgr24") + "-" + ToString(quality) + "]";
+
+        TEST_LOG_SS(Info, "Test " << desc << " [" << width << ", " << height << "].");
+
+        View bgr(width, height, View::Bgr24, NULL, TEST_ALIGN(width));
+        for (size_t y = 0; y < height; ++y)
+            for (size_t x = 0; x < width; ++x)
+                for (size_t c = 0; c < 3; ++c)
+                    bgr.At<uint8_t>(x * 3 + c, y) = uint8_t(128.0 + 100.0 * ::sin(0.005 * x * (c + 1) + 0.0025 * y * (3 - c)));
+
+        View bgra(width, height, View::Bgra32);
+        Simd::BgrToBgra(bgr, bgra);
+        View y1(width, height, View::Gray8), u1(width / 2, height / 2, View::Gray8), v1(width / 2, height / 2, View::Gray8);
+        SimdBgraToYuv420pV2(bgra.data, bgra.stride, width, height, y1.data, y1.stride, u1.data, u1.stride, v1.data, v1.stride, SimdYuvTrect871);
+
+        size_t size = 0;
+        uint8_t* data = yuv ?
+            SimdYuv420pSaveAsJpegToMemory(y1.data, y1.stride, u1.data, u1.stride, v1.data, v1.stride, width, height, SimdYuvTrect871, quality, &size) :
+            SimdImageSaveToMemory(bgr.data, bgr.stride, width, height, SimdPixelFormatBgr24, SimdImageFileJpeg, quality, &size);
+        if (data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't encode image!");
+            return false;
+        }
+
+        View y2(width, height, View::Gray8), u2(width / 2, height / 2, View::Gray8), v2(width / 2, height / 2, View::Gray8);
+        SimdBool loaded = SimdFalse;
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            loaded = SimdImageLoadJpegToYuv420p(data, size, y2.data, y2.stride, u2.data, u2.stride, v2.data, v2.stride, width, height, SimdYuvTrect871);
+        }
+        if (loaded == SimdFalse)
+        {
+            TEST_LOG_SS(Error, "Can't decode image!");
+            result = false;
+        }
+        else
+        {
+            int differenceMax = GetMaxJpegError(quality);
+            result = result && Compare(y1, y2, differenceMax, true, 64, 0, "y1 & y2");
+            result = result && Compare(u1, u2, differenceMax, true, 64, 0, "u1 & u2");
+            result = result && Compare(v1, v2, differenceMax, true, 64, 0, "v1 & v2");
+        }
+
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool ImageLoadJpegToYuv420pAutoTest()
+    {
+        bool result = true;
+
+        result = result && ImageLoadJpegToYuv420pAutoTest(W, H, true, 95);
+        result = result && ImageLoadJpegToYuv420pAutoTest(W + E, H - E, true, 85);
+        result = result && ImageLoadJpegToYuv420pAutoTest(W, H, false, 95);
+        result = result && ImageLoadJpegToYuv420pAutoTest(W + E, H - E, false, 85);
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
     bool ImageLoadFromMemorySpecialTest(const String & name, View::Format format, const FuncLM& f1, const FuncLM& f2)
     {
         bool result = true;
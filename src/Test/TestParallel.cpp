@@ -0,0 +1,130 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+
+#include "Simd/SimdParallel.hpp"
+
+#include <future>
+#include <atomic>
+
+namespace Test
+{
+    namespace
+    {
+        template<class Function> void ParallelAsync(size_t begin, size_t end, const Function& function, size_t threadNumber, size_t blockAlign = 1)
+        {
+            threadNumber = std::min<size_t>(threadNumber, std::thread::hardware_concurrency());
+            if (threadNumber <= 1 || size_t(blockAlign * 1.5) >= (end - begin))
+                function(0, begin, end);
+            else
+            {
+                std::vector<std::future<void>> futures;
+                size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
+                blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
+                size_t blockBegin = begin;
+                size_t blockEnd = blockBegin + blockSize;
+                for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
+                {
+                    futures.push_back(std::async(std::launch::async, [blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); }));
+                    blockBegin += blockSize;
+                    blockEnd = std::min(blockBegin + blockSize, end);
+                }
+                for (size_t i = 0; i < futures.size(); ++i)
+                    futures[i].wait();
+            }
+        }
+
+        struct Work
+        {
+            std::vector<uint8_t> visits;
+            std::atomic<size_t> errors;
+
+            Work(size_t size) : visits(size, 0), errors(0) {}
+
+            void operator()(size_t thread, size_t begin, size_t end, size_t threadNumber, size_t blockAlign)
+            {
+                if (thread >= threadNumber || begin % blockAlign || end <= begin)
+                    errors++;
+                for (size_t i = begin; i < end; ++i)
+                    visits[i]++;
+            }
+
+            size_t Check()
+            {
+                size_t count = errors;
+                for (size_t i = 0; i < visits.size(); ++i)
+                    count += visits[i] != 1 ? 1 : 0, visits[i] = 0;
+                errors = 0;
+                return count;
+            }
+        };
+    }
+
+    bool ParallelAutoTest(size_t size, size_t threadNumber, size_t blockAlign)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test Simd::Parallel for size = " << size << ", threads = " << threadNumber << ", align = " << blockAlign << ".");
+
+        Work work(size);
+        size_t errors1 = 0, errors2 = 0;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(
+        {
+            TEST_PERFORMANCE_TEST("Parallel<std::async>");
+            ParallelAsync(0, size, [&](size_t thread, size_t begin, size_t end) { work(thread, begin, end, threadNumber, blockAlign); }, threadNumber, blockAlign);
+            errors1 += work.Check();
+        });
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(
+        {
+            TEST_PERFORMANCE_TEST("Parallel<ThreadPool>");
+            Simd::Parallel(0, size, [&](size_t thread, size_t begin, size_t end) { work(thread, begin, end, threadNumber, blockAlign); }, threadNumber, blockAlign);
+            errors2 += work.Check();
+        });
+
+        if (errors1 || errors2)
+        {
+            TEST_LOG_SS(Error, "Error: " << errors1 << " wrong blocks for std::async and " << errors2 << " wrong blocks for thread pool!");
+            result = false;
+        }
+
+        return result;
+    }
+
+    bool ParallelAutoTest()
+    {
+        bool result = true;
+
+        size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+        result = result && ParallelAutoTest(1024, threads, 1);
+        result = result && ParallelAutoTest(1000, threads, 16);
+        result = result && ParallelAutoTest(37, threads, 3);
+        result = result && ParallelAutoTest(W * H, threads, 1);
+
+        return result;
+    }
+}
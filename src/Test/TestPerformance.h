@@ -30,6 +30,22 @@ namespace Test
 {
     double GetTime();
 
+    /* Calls func() repeatedly until it returns false or at least minimal seconds pass.
+       Returns spent time and number of successful calls in count. */
+    template<class Func> double ExecuteForTime(Func func, size_t & count, double minimal = 0.1)
+    {
+        double start = GetTime(), time = 0;
+        count = 0;
+        do
+        {
+            if (!func())
+                break;
+            count++;
+            time = GetTime() - start;
+        } while (time < minimal);
+        return time;
+    }
+
     //-------------------------------------------------------------------------
 
     class PerformanceMeasurer
@@ -217,6 +217,23 @@ namespace Test
 
 //#define TEST_RESIZE_REAL_IMAGE
 
+    static View::Format ResizerFormat(SimdResizeChannelType type, size_t channels)
+    {
+        if (type == SimdResizeChannelFloat)
+            return View::Float;
+        if (type == SimdResizeChannelShort)
+            return View::Int16;
+        switch (channels)
+        {
+        case 1: return View::Gray8;
+        case 2: return View::Uv16;
+        case 3: return View::Bgr24;
+        case 4: return View::Bgra32;
+        default:
+            assert(0); return View::None;
+        }
+    }
+
     bool ResizerAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH, FuncRS f1, FuncRS f2)
     {
         bool result = true;
@@ -226,33 +243,12 @@ namespace Test
 
         TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << srcW << ", " << srcH << "] -> [" << dstW << ", " << dstH << "].");
 
-        View::Format format;
-        if (type == SimdResizeChannelFloat)
-        {
-            format = View::Float;
-            srcW *= channels;
-            dstW *= channels;
-        }
-        else if (type == SimdResizeChannelShort)
+        View::Format format = ResizerFormat(type, channels);
+        if (type != SimdResizeChannelByte)
         {
-            format = View::Int16;
             srcW *= channels;
             dstW *= channels;
         }
-        else if (type == SimdResizeChannelByte)
-        {
-            switch (channels)
-            {
-            case 1: format = View::Gray8; break;
-            case 2: format = View::Uv16; break;
-            case 3: format = View::Bgr24; break;
-            case 4: format = View::Bgra32; break;
-            default:
-                assert(0);
-            }
-        }
-        else
-            assert(0);
 
         View src(srcW, srcH, format, NULL, TEST_ALIGN(srcW));
         if (format == View::Float)
@@ -406,6 +402,130 @@ namespace Test
 
     //---------------------------------------------------------------------------------------------
 
+    static bool ResizerRun(const View& src, View& dst, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
+    {
+        size_t srcW = src.width, dstW = dst.width;
+        if (type != SimdResizeChannelByte)
+        {
+            srcW /= channels;
+            dstW /= channels;
+        }
+        void* resizer = SimdResizerInit(srcW, src.height, dstW, dst.height, channels, type, method);
+        if (resizer)
+        {
+            SimdResizerRun(resizer, src.data, src.stride, dst.data, dst.stride);
+            SimdRelease(resizer);
+        }
+        return resizer != NULL;
+    }
+
+    bool ResizerThreadsAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH)
+    {
+        bool result = true;
+
+        String desc = String("[") + ToString(channels) + ":" + ToString(srcW) + "x" + ToString(srcH) + "->" + 
+            ToString(dstW) + "x" + ToString(dstH) + ":" + ToString(method) + "-" + ToString(type) + "]";
+        TEST_LOG_SS(Info, "Test SimdResizerRun threads " << desc << ".");
+
+        View::Format format = ResizerFormat(type, channels);
+        if (type != SimdResizeChannelByte)
+        {
+            srcW *= channels;
+            dstW *= channels;
+        }
+
+        View src(srcW, srcH, format, NULL, TEST_ALIGN(srcW));
+        if (format == View::Float)
+            FillRandom32f(src);
+        else if (format == View::Int16)
+            FillRandom16u(src);
+        else
+            FillRandom(src);
+
+        View dst1(dstW, dstH, format, NULL, TEST_ALIGN(dstW));
+        View dst2(dstW, dstH, format, NULL, TEST_ALIGN(dstW));
+        Simd::Fill(dst1, 0x01);
+
+        size_t threads = SimdGetThreadNumber();
+        SimdSetThreadNumber(1);
+        bool supported = ResizerRun(src, dst1, channels, type, method);
+        for (size_t number = 2; number <= 7 && result && supported; number++)
+        {
+            SimdSetThreadNumber(number);
+            Simd::Fill(dst2, 0x02);
+            ResizerRun(src, dst2, channels, type, method);
+            result = result && Compare(dst1, dst2, 0, true, 64, 0, desc + " threads " + ToString(number));
+        }
+        SimdSetThreadNumber(threads);
+
+        return result;
+    }
+
+    bool ResizerThreadsPerformanceTest(size_t srcW, size_t srcH, size_t dstW, size_t dstH)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdResizerRun threads performance [4:" << srcW << "x" << srcH << "->" << dstW << "x" << dstH << ":" << ToString(SimdResizeMethodBilinear) << "].");
+
+        View src(srcW, srcH, View::Bgra32, NULL, TEST_ALIGN(srcW));
+        FillRandom(src);
+        View dst(dstW, dstH, View::Bgra32, NULL, TEST_ALIGN(dstW));
+
+        size_t threads = SimdGetThreadNumber();
+        for (size_t number = 1; number <= 8 && result; number *= 2)
+        {
+            SimdSetThreadNumber(number);
+            void* resizer = SimdResizerInit(srcW, srcH, dstW, dstH, 4, SimdResizeChannelByte, SimdResizeMethodBilinear);
+            if (resizer == NULL)
+            {
+                TEST_LOG_SS(Error, "Can't create resizer!");
+                result = false;
+                break;
+            }
+            size_t count = 0;
+            double time = ExecuteForTime([&]()
+            {
+                SimdResizerRun(resizer, src.data, src.stride, dst.data, dst.stride);
+                return true;
+            }, count);
+            SimdRelease(resizer);
+            TEST_LOG_SS(Info, "Threads: " << number << ", speed: " << ToString(double(dstW * dstH * count) / time / 1000000.0, 1, false) << " MP/s.");
+        }
+        SimdSetThreadNumber(threads);
+
+        return result;
+    }
+
+    bool ResizerThreadsAutoTest()
+    {
+        bool result = true;
+
+        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodNearest, SimdResizeMethodNearestPytorch, SimdResizeMethodBilinear, 
+            SimdResizeMethodBilinearCaffe, SimdResizeMethodBilinearPytorch, SimdResizeMethodBicubic, SimdResizeMethodArea, SimdResizeMethodAreaFast };
+        for (size_t m = 0; m < methods.size(); ++m)
+        {
+            for (size_t c = 1; c <= 4; ++c)
+            {
+                result = result && ResizerThreadsAutoTest(methods[m], SimdResizeChannelByte, c, 124, 93, 319, 239);
+                result = result && ResizerThreadsAutoTest(methods[m], SimdResizeChannelByte, c, 1999, 1499, 319, 239);
+            }
+            if (methods[m] == SimdResizeMethodBicubic || methods[m] == SimdResizeMethodArea || methods[m] == SimdResizeMethodAreaFast)
+                continue;
+            for (size_t c = 1; c <= 4; ++c)
+            {
+                result = result && ResizerThreadsAutoTest(methods[m], SimdResizeChannelShort, c, 999, 749, 319, 239);
+                if (c == 1 || c == 3)
+                    result = result && ResizerThreadsAutoTest(methods[m], SimdResizeChannelFloat, c, 999, 749, 319, 239);
+            }
+        }
+
+        result = result && ResizerThreadsPerformanceTest(3840, 2160, 1920, 1080);
+
+        return result;
+    }
+
+    //---------------------------------------------------------------------------------------------
+
     bool ResizeSpecialTest(View::Format format, const Size & src, const Size & dst, const FuncRB & f1, const FuncRB & f2)
     {
         bool result = true;
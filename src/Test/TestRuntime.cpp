@@ -0,0 +1,129 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestTensor.h"
+#include "Test/TestRandom.h"
+#include "Test/TestFile.h"
+
+#include "Simd/SimdRuntime.h"
+#include "Simd/SimdBase.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace Test
+{
+    static void RuntimeCacheTune(Simd::RuntimeGemm& gemm, const String& name, size_t M, size_t N, size_t K)
+    {
+        Tensor32f a({ M, K }), b({ K, N }), c({ M, N });
+        FillRandom(a.Data(), a.Size(), -1.0f, 1.0f);
+        FillRandom(b.Data(), b.Size(), -1.0f, 1.0f);
+        const float alpha = 1.0f, beta = 0.0f;
+        gemm.Init(Simd::InitGemmFuncs(Simd::Base::Gemm32fNN, "First", Simd::Base::Gemm32fNN, "Second"), name);
+        for (size_t i = 0; i < 16; ++i)
+            gemm.Run(Simd::GemmArgs(M, N, K, &alpha, a.Data(), K, b.Data(), N, &beta, c.Data(), N));
+    }
+
+    bool RuntimeCacheAutoTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test Simd::RuntimeCache save and load.");
+
+        const size_t M = 17, N = 19, K = 23;
+        const String path = TempPath("runtime_cache.txt");
+        std::stringstream ss;
+        ss << "Gemm [" << M << ", " << N << ", " << K << "]";
+        const String info = ss.str();
+
+        Simd::RuntimeCache& cache = Simd::RuntimeCache::Global();
+        Simd::RuntimeGemm gemm;
+        RuntimeCacheTune(gemm, "TestGemmNN", M, N, K);
+
+        String best, other;
+        if (!cache.Find("TestGemmNN", info, best))
+        {
+            TEST_LOG_SS(Error, "Tuning result of TestGemmNN is not stored in the cache!");
+            return false;
+        }
+        if (cache.Find("TestGemmNT", info, other))
+        {
+            TEST_LOG_SS(Error, "Runtimes TestGemmNN and TestGemmNT with the same arguments share the cache entry!");
+            result = false;
+        }
+
+        if (!SimdRuntimeCacheSave(path.c_str()))
+        {
+            TEST_LOG_SS(Error, "Can't save runtime cache to '" << path << "'!");
+            return false;
+        }
+        cache.Clear();
+        if (cache.Find("TestGemmNN", info, other))
+        {
+            TEST_LOG_SS(Error, "Runtime cache is not cleared!");
+            result = false;
+        }
+        if (!SimdRuntimeCacheLoad(path.c_str()))
+        {
+            TEST_LOG_SS(Error, "Can't load runtime cache from '" << path << "'!");
+            result = false;
+        }
+        else if (!cache.Find("TestGemmNN", info, other) || other != best)
+        {
+            TEST_LOG_SS(Error, "Loaded runtime cache has no hit for TestGemmNN: '" << other << "' instead of '" << best << "'!");
+            result = false;
+        }
+
+        String text;
+        {
+            std::ifstream ifs(path.c_str(), std::ifstream::binary);
+            text.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        }
+        {
+            std::ofstream ofs(path.c_str(), std::ofstream::binary);
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                if (text[i] == '\n' && (i == 0 || text[i - 1] != '\r'))
+                    ofs << '\r';
+                ofs << text[i];
+            }
+        }
+        cache.Clear();
+        if (!SimdRuntimeCacheLoad(path.c_str()))
+        {
+            TEST_LOG_SS(Error, "Can't load runtime cache with CRLF line endings from '" << path << "'!");
+            result = false;
+        }
+        else if (!cache.Find("TestGemmNN", info, other) || other != best)
+        {
+            TEST_LOG_SS(Error, "Loaded runtime cache with CRLF line endings has no hit for TestGemmNN: '" << other << "' instead of '" << best << "'!");
+            result = false;
+        }
+        ::remove(path.c_str());
+
+        return result;
+    }
+}
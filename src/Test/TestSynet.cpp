@@ -354,5 +354,122 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static SimdConvolutionParameters ArenaConvParam(size_t srcC, size_t srcH, size_t srcW, size_t dstC, size_t kernel, size_t stride)
+    {
+        SimdConvolutionParameters c;
+        c.srcC = srcC;
+        c.srcH = srcH;
+        c.srcW = srcW;
+        c.srcT = SimdTensorData32f;
+        c.srcF = SimdTensorFormatNhwc;
+        c.dstC = dstC;
+        c.kernelY = kernel;
+        c.kernelX = kernel;
+        c.dilationY = 1;
+        c.dilationX = 1;
+        c.strideY = stride;
+        c.strideX = stride;
+        c.padY = kernel / 2;
+        c.padX = kernel / 2;
+        c.padH = kernel / 2;
+        c.padW = kernel / 2;
+        c.group = 1;
+        c.activation = SimdConvolutionActivationRelu;
+        c.dstH = (srcH + c.padY + c.padH - kernel) / stride + 1;
+        c.dstW = (srcW + c.padX + c.padW - kernel) / stride + 1;
+        c.dstT = SimdTensorData32f;
+        c.dstF = SimdTensorFormatNhwc;
+        return c;
+    }
+
+    bool SynetArenaPlanAutoTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdSynetArenaPlan.");
+
+        const size_t n = 4;
+        SimdConvolutionParameters convs[n] = {
+            ArenaConvParam(16, 40, 40, 32, 3, 1),
+            ArenaConvParam(32, 40, 40, 32, 1, 1),
+            ArenaConvParam(32, 40, 40, 64, 3, 2),
+            ArenaConvParam(64, 20, 20, 32, 3, 1) };
+
+        void* contexts[n];
+        Tensor32f weights[n], biases[n], tensors[n + 1];
+        SimdSynetArenaLayer layers[n];
+        SimdSynetArenaTensor arena[n + 1];
+        tensors[0].Reshape({ convs[0].srcH, convs[0].srcW, convs[0].srcC });
+        FillRandom(tensors[0], -1.0f, 1.0f);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const SimdConvolutionParameters& c = convs[i];
+            weights[i].Reshape({ c.kernelY, c.kernelX, c.srcC, c.dstC });
+            biases[i].Reshape({ c.dstC });
+            FillRandom(weights[i], -0.1f, 0.1f);
+            FillRandom(biases[i], -0.1f, 0.1f);
+            tensors[i + 1].Reshape({ c.dstH, c.dstW, c.dstC });
+            contexts[i] = ::SimdSynetConvolution32fInit(1, &c, SimdSynetCompatibilityDefault);
+            ::SimdSynetConvolution32fSetParams(contexts[i], weights[i].Data(), NULL, biases[i].Data(), NULL);
+            ::SimdSynetConvolution32fForward(contexts[i], tensors[i].Data(), NULL, tensors[i + 1].Data());
+            layers[i].type = SimdSynetContextConvolution32f;
+            layers[i].context = contexts[i];
+        }
+        for (size_t i = 0; i <= n; ++i)
+        {
+            arena[i].size = tensors[i].Size() * sizeof(float);
+            arena[i].first = i == 0 ? 0 : i - 1;
+            arena[i].last = i == n ? n - 1 : i;
+        }
+
+        size_t size = ::SimdSynetArenaPlan(layers, n, arena, n + 1), sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += layers[i].size;
+        for (size_t i = 0; i <= n; ++i)
+            sum += arena[i].size;
+        TEST_LOG_SS(Info, "Arena size: " << size << " bytes, separate buffers: " << sum << " bytes.");
+
+        for (size_t i = 0; i < 2 * n + 1 && result; ++i)
+        {
+            size_t iBeg = i < n ? layers[i].offset : arena[i - n].offset;
+            size_t iEnd = iBeg + (i < n ? layers[i].size : arena[i - n].size);
+            size_t iFirst = i < n ? i : arena[i - n].first, iLast = i < n ? i : arena[i - n].last;
+            if (iEnd > size || iBeg % SIMD_ALIGN)
+            {
+                TEST_LOG_SS(Error, "Item " << i << " [" << iBeg << ", " << iEnd << ") is out of arena or unaligned!");
+                result = false;
+            }
+            for (size_t j = 0; j < i && result; ++j)
+            {
+                size_t jBeg = j < n ? layers[j].offset : arena[j - n].offset;
+                size_t jEnd = jBeg + (j < n ? layers[j].size : arena[j - n].size);
+                size_t jFirst = j < n ? j : arena[j - n].first, jLast = j < n ? j : arena[j - n].last;
+                if (iFirst <= jLast && jFirst <= iLast && iBeg < jEnd && jBeg < iEnd)
+                {
+                    TEST_LOG_SS(Error, "Live items " << j << " and " << i << " overlap in arena!");
+                    result = false;
+                }
+            }
+        }
+
+        uint8_t* data = (uint8_t*)::SimdAllocate(size, ::SimdAlignment());
+        memcpy(data + arena[0].offset, tensors[0].Data(), arena[0].size);
+        for (size_t i = 0; i < n; ++i)
+            ::SimdSynetConvolution32fForward(contexts[i], (float*)(data + arena[i].offset),
+                (float*)(data + layers[i].offset), (float*)(data + arena[i + 1].offset));
+        Tensor32f dst(tensors[n].Shape());
+        memcpy(dst.Data(), data + arena[n].offset, arena[n].size);
+        ::SimdFree(data);
+
+        for (size_t i = 0; i < n; ++i)
+            ::SimdRelease(contexts[i]);
+
+        result = result && Compare(tensors[n], dst, 0.0f, true, 64, DifferenceAbsolute);
+
+        return result;
+    }
 #endif
 }
@@ -0,0 +1,250 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestTensor.h"
+#include "Test/TestString.h"
+#include "Test/TestRandom.h"
+
+#include "Simd/SimdSynetAttention32f.h"
+#include "Simd/SimdSynet.h"
+
+#include <cfloat>
+
+namespace Test
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace
+    {
+        struct FuncAT
+        {
+            typedef void*(*FuncPtr)(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, SimdSynetCompatibilityType compatibility);
+
+            FuncPtr func;
+            String desc;
+
+            FuncAT(const FuncPtr & f, const String & d) : func(f), desc(d) {}
+
+            void Update(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, SimdBool causal, SimdSynetCompatibilityType compatibility)
+            {
+                std::stringstream ss;
+                ss << desc << "[" << batch << "x" << heads << "x" << lenQ << "x" << lenKV << "x" << depth;
+                ss << (causal ? "-c" : "") << (Simd::Base::Bf16Soft(compatibility) ? "-bf16" : "") << "]";
+                desc = ss.str();
+            }
+
+            void Call(void * context, const float* q, const float* k, const float* v, float* dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                SimdSynetAttention32fForward(context, q, k, v, dst);
+            }
+        };
+
+        void AttentionReference(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, float scale, bool causal,
+            const float* q, const float* k, const float* v, float* dst)
+        {
+            std::vector<double> s(lenKV);
+            for (size_t b = 0; b < batch * heads; ++b)
+            {
+                const float* pq = q + b * lenQ * depth, * pk = k + b * lenKV * depth, * pv = v + b * lenKV * depth;
+                float* pd = dst + b * lenQ * depth;
+                for (size_t i = 0; i < lenQ; ++i)
+                {
+                    size_t end = causal ? i + lenKV - lenQ + 1 : lenKV;
+                    double max = -DBL_MAX, sum = 0;
+                    for (size_t j = 0; j < end; ++j)
+                    {
+                        double dot = 0;
+                        for (size_t d = 0; d < depth; ++d)
+                            dot += double(pq[i * depth + d]) * pk[j * depth + d];
+                        s[j] = dot * scale;
+                        max = std::max(max, s[j]);
+                    }
+                    for (size_t j = 0; j < end; ++j)
+                    {
+                        s[j] = ::exp(s[j] - max);
+                        sum += s[j];
+                    }
+                    for (size_t d = 0; d < depth; ++d)
+                    {
+                        double val = 0;
+                        for (size_t j = 0; j < end; ++j)
+                            val += s[j] * pv[j * depth + d];
+                        pd[i * depth + d] = float(val / sum);
+                    }
+                }
+            }
+        }
+    }
+
+#define FUNC_AT(function) FuncAT(function, #function)
+
+    bool SynetAttention32fForwardAutoTest(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, SimdBool causal, SimdSynetCompatibilityType compatibility, FuncAT f1, FuncAT f2)
+    {
+        bool result = true;
+
+        f1.Update(batch, heads, lenQ, lenKV, depth, causal, compatibility);
+        f2.Update(batch, heads, lenQ, lenKV, depth, causal, compatibility);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " .");
+
+        Tensor32f q(Shp(batch, heads, lenQ, depth));
+        Tensor32f k(Shp(batch, heads, lenKV, depth));
+        Tensor32f v(Shp(batch, heads, lenKV, depth));
+        Tensor32f dst1(Shp(batch, heads, lenQ, depth), SimdTensorFormatUnknown, 1.0f);
+        Tensor32f dst2(Shp(batch, heads, lenQ, depth), SimdTensorFormatUnknown, 2.0f);
+
+        FillRandom(q.Data(), q.Size(), -1.0, 1.0);
+        FillRandom(k.Data(), k.Size(), -1.0, 1.0);
+        FillRandom(v.Data(), v.Size(), -1.0, 1.0);
+
+        void* context1 = f1.func(batch, heads, lenQ, lenKV, depth, NULL, causal, compatibility);
+        void* context2 = f2.func(batch, heads, lenQ, lenKV, depth, NULL, causal, compatibility);
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(context1, q.Data(), k.Data(), v.Data(), dst1.Data()));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(context2, q.Data(), k.Data(), v.Data(), dst2.Data()));
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        float eps = Simd::Base::Bf16Soft(compatibility) ? 0.01f : EPS;
+        result = result && Compare(dst1, dst2, eps, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetAttention32fForwardAutoTest(SimdSynetCompatibilityType c, const FuncAT& f1, const FuncAT& f2)
+    {
+        bool result = true;
+
+        result = result && SynetAttention32fForwardAutoTest(1, 12, 197, 197, 64, SimdFalse, c, f1, f2);
+        result = result && SynetAttention32fForwardAutoTest(2, 8, 128, 128, 64, SimdTrue, c, f1, f2);
+        result = result && SynetAttention32fForwardAutoTest(1, 4, 7, 1031, 40, SimdTrue, c, f1, f2);
+        result = result && SynetAttention32fForwardAutoTest(3, 2, 65, 33, 17, SimdFalse, c, f1, f2);
+
+        return result;
+    }
+
+    bool SynetAttention32fForwardAutoTest(const FuncAT& f1, const FuncAT& f2)
+    {
+        bool result = true;
+
+        result = result && SynetAttention32fForwardAutoTest(SimdSynetCompatibilityDefault, f1, f2);
+        result = result && SynetAttention32fForwardAutoTest(SimdSynetCompatibility16bfSoft, f1, f2);
+
+        return result;
+    }
+
+    bool SynetAttention32fReferenceAutoTest(size_t batch, size_t heads, size_t lenQ, size_t lenKV, size_t depth, const float* scale, SimdBool causal, FuncAT f)
+    {
+        bool result = true;
+
+        f.Update(batch, heads, lenQ, lenKV, depth, causal, SimdSynetCompatibilityDefault);
+
+        TEST_LOG_SS(Info, "Test " << f.desc << " & reference" << (scale ? " (scale " + ToString(*scale, 3, false) + ")" : String()) << ".");
+
+        Tensor32f q(Shp(batch, heads, lenQ, depth));
+        Tensor32f k(Shp(batch, heads, lenKV, depth));
+        Tensor32f v(Shp(batch, heads, lenKV, depth));
+        Tensor32f dst1(Shp(batch, heads, lenQ, depth), SimdTensorFormatUnknown, 1.0f);
+        Tensor32f dst2(Shp(batch, heads, lenQ, depth), SimdTensorFormatUnknown, 2.0f);
+
+        FillRandom(q.Data(), q.Size(), -1.0, 1.0);
+        FillRandom(k.Data(), k.Size(), -1.0, 1.0);
+        FillRandom(v.Data(), v.Size(), -1.0, 1.0);
+
+        AttentionReference(batch, heads, lenQ, lenKV, depth, scale ? *scale : 1.0f / ::sqrt(float(depth)), causal == SimdTrue,
+            q.Data(), k.Data(), v.Data(), dst1.Data());
+
+        void* context = f.func(batch, heads, lenQ, lenKV, depth, scale, causal, SimdSynetCompatibilityDefault);
+        if (context == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't create attention context!");
+            return false;
+        }
+        f.Call(context, q.Data(), k.Data(), v.Data(), dst2.Data());
+        ::SimdRelease(context);
+
+        result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetAttention32fReferenceAutoTest(const FuncAT& f)
+    {
+        bool result = true;
+
+        const float scale = 0.3f;
+        result = result && SynetAttention32fReferenceAutoTest(2, 3, 33, 33, 32, NULL, SimdFalse, f);
+        result = result && SynetAttention32fReferenceAutoTest(2, 3, 33, 33, 32, NULL, SimdTrue, f);
+        result = result && SynetAttention32fReferenceAutoTest(1, 4, 7, 1031, 40, NULL, SimdTrue, f);
+        result = result && SynetAttention32fReferenceAutoTest(2, 2, 17, 81, 17, &scale, SimdTrue, f);
+        result = result && SynetAttention32fReferenceAutoTest(3, 2, 65, 33, 17, &scale, SimdFalse, f);
+
+        return result;
+    }
+
+    bool SynetAttention32fReferenceAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetAttention32fReferenceAutoTest(FUNC_AT(Simd::Base::SynetAttention32fInit));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetAttention32fReferenceAutoTest(FUNC_AT(Simd::Avx2::SynetAttention32fInit));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetAttention32fReferenceAutoTest(FUNC_AT(Simd::Avx512bw::SynetAttention32fInit));
+#endif
+
+        return result;
+    }
+
+    bool SynetAttention32fForwardAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetAttention32fForwardAutoTest(FUNC_AT(Simd::Base::SynetAttention32fInit), FUNC_AT(SimdSynetAttention32fInit));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetAttention32fForwardAutoTest(FUNC_AT(Simd::Avx2::SynetAttention32fInit), FUNC_AT(SimdSynetAttention32fInit));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetAttention32fForwardAutoTest(FUNC_AT(Simd::Avx512bw::SynetAttention32fInit), FUNC_AT(SimdSynetAttention32fInit));
+#endif
+
+        return result;
+    }
+#endif
+}
@@ -26,10 +26,15 @@
 #include "Test/TestTensor.h"
 #include "Test/TestSynetConvolutionParam.h"
 #include "Test/TestRandom.h"
+#include "Test/TestString.h"
+#include "Test/TestFile.h"
 
 #include "Simd/SimdSynetConvolution32f.h"
 #include "Simd/SimdSynet.h"
 
+#include <fstream>
+#include <iterator>
+
 namespace Test
 {
 #if defined(SIMD_SYNET_ENABLE)
@@ -48,7 +53,7 @@ namespace Test
 
             void Update(const Param & p, SimdSynetCompatibilityType c)
             {
-                desc = desc + p.Decription(Simd::Base::Bf16Soft(c) ? "-bf16" : "-fp32");
+                desc = desc + p.Decription(Simd::Base::Bf16Soft(c) ? "-bf16" : (Simd::Base::Fp16Soft(c) ? "-fp16" : "-fp32"));
             }
 
             void Call(void * context, const Tensor32f & src, Tensor32f & buf, Tensor32f & dst) const
@@ -62,12 +67,17 @@ namespace Test
 #define FUNC_C(function) \
     FuncC(function, std::string(#function))
 
-    bool SynetConvolution32fForwardAutoTest(float eps, const Param & p, SimdSynetCompatibilityType comp, FuncC f1, FuncC f2)
+    bool SynetConvolution32fForwardAutoTest(float eps, const Param & p, SimdSynetCompatibilityType comp, FuncC f1, FuncC f2, float sparse = 0.0f)
     {
         bool result = true;
 
         f1.Update(p, comp);
         f2.Update(p, comp);
+        if (sparse > 0.0f)
+        {
+            f1.desc += "-s" + ToString(int(sparse * 100));
+            f2.desc += "-s" + ToString(int(sparse * 100));
+        }
 
         TEST_LOG_SS(Info, "Test [" << f1.desc << " & " << f2.desc << "].");
 
@@ -78,6 +88,8 @@ namespace Test
         Tensor32f weight({ p.trans ? c.kernelY : c.dstC, p.trans ? c.kernelX : c.srcC / c.group,
             p.trans ? c.srcC / c.group : c.kernelY, p.trans ? c.dstC : c.kernelX });
         FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        if (sparse > 0.0f && p.trans && c.group == 1)
+            SetSparse(c.kernelY * c.kernelX * c.srcC, c.dstC, SimdFalse, sparse, weight.Data());
 
         Tensor32f bias({ c.dstC });
         FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
@@ -587,12 +599,30 @@ namespace Test
         return result;
     }
 
+    bool SynetConvolution32fSparseAutoTest(float eps, SimdConvolutionActivationType a, const FuncC& f1, const FuncC& f2)
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        SimdBool t = SimdTrue;
+        SimdSynetCompatibilityType c = SimdSynetCompatibilityDefault;
+
+        result = result && SynetConvolution32fForwardAutoTest(eps, Param(1, 128, 16, 16, 128, _1, _1, _1, _0, _0, 1, a, t), c, f1, f2, 0.00f);
+        result = result && SynetConvolution32fForwardAutoTest(eps, Param(1, 128, 16, 16, 128, _1, _1, _1, _0, _0, 1, a, t), c, f1, f2, 0.75f);
+        result = result && SynetConvolution32fForwardAutoTest(eps, Param(1, 64, 14, 14, 64, _3, _1, _1, _1, _1, 1, a, t), c, f1, f2, 0.00f);
+        result = result && SynetConvolution32fForwardAutoTest(eps, Param(1, 64, 14, 14, 64, _3, _1, _1, _1, _1, 1, a, t), c, f1, f2, 0.75f);
+        result = result && SynetConvolution32fForwardAutoTest(eps, Param(1, 35, 15, 20, 63, _3, _1, _2, _1, _1, 1, a, t), c, f1, f2, 0.90f);
+
+        return result;
+    }
+
     bool SynetConvolution32fForwardAutoTest(float eps, const FuncC & f1, const FuncC & f2)
     {
         bool result = true;
 
         SimdSynetCompatibilityType fp32 = SimdSynetCompatibilityDefault;
         SimdSynetCompatibilityType bf16 = SimdSynetCompatibility16bfSoft;
+        SimdSynetCompatibilityType fp16 = SimdSynetCompatibility16fpSoft;
 
 #ifdef NDEBUG
         //result = result && SynetConvolution32fForwardAutoTest(eps, SimdConvolutionActivationIdentity, SimdTrue, fp32, f1, f2);
@@ -614,10 +644,12 @@ namespace Test
         result = result && SynetConvolution32fForwardAutoTest(eps, SimdConvolutionActivationGelu, SimdTrue, fp32, f1, f2);
         result = result && SynetConvolution32fForwardAutoTest(eps, SimdConvolutionActivationGelu, SimdFalse, bf16, f1, f2);
         result = result && SynetConvolution32fForwardAutoTest(eps, SimdConvolutionActivationGelu, SimdTrue, bf16, f1, f2);
+        result = result && SynetConvolution32fForwardAutoTest(eps, SimdConvolutionActivationRelu, SimdTrue, fp16, f1, f2);
 #else
         result = result && SynetConvolution32fForwardAutoTest(eps, SimdConvolutionActivationGelu, SimdFalse, bf16, f1, f2);
         result = result && SynetConvolution32fForwardAutoTest(eps, SimdConvolutionActivationGelu, SimdTrue, bf16, f1, f2);
 #endif
+        result = result && SynetConvolution32fSparseAutoTest(eps, SimdConvolutionActivationRelu, f1, f2);
 
         return result;
     }
@@ -666,5 +698,315 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetConvolution32fThreadsAutoTest(const Param& p)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c = p.conv;
+        double flop = double(p.batch) * c.dstH * c.dstW * c.dstC * c.kernelY * c.kernelX * c.srcC / c.group * 2;
+
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution32fForward" << p.Decription("-fp32") << " by thread number.");
+
+        Tensor32f src({ p.batch, c.srcH, c.srcW, c.srcC });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+        Tensor32f weight({ c.kernelY, c.kernelX, c.srcC / c.group, c.dstC });
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+
+        Tensor32f dst1({ p.batch, c.dstH, c.dstW, c.dstC }), dst2({ p.batch, c.dstH, c.dstW, c.dstC }), buf;
+
+        size_t threads = SimdGetThreadNumber();
+        for (size_t number = 1; number <= 8 && result; number *= 2)
+        {
+            SimdSetThreadNumber(number);
+            void* context = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+            if (context == NULL)
+            {
+                TEST_LOG_SS(Error, "Can't create convolution context!");
+                result = false;
+                break;
+            }
+            buf.Extend({ ::SimdSynetConvolution32fExternalBufferSize(context) });
+            ::SimdSynetConvolution32fSetParams(context, weight.Data(), NULL, bias.Data(), params.Data());
+            Tensor32f& dst = number == 1 ? dst1 : dst2;
+            size_t count = 0;
+            double time = ExecuteForTime([&]() { ::SimdSynetConvolution32fForward(context, src.Data(), buf.Data(), dst.Data()); return true; }, count);
+            ::SimdRelease(context);
+            TEST_LOG_SS(Info, "Threads: " << number << ", speed: " << ToString(flop * count / time / 1000000000.0, 1, false) << " GFlops.");
+            if (number > 1)
+                result = result && Compare(dst1, dst2, 0.001f, true, 64, DifferenceBoth);
+        }
+        SimdSetThreadNumber(threads);
+
+        return result;
+    }
+
+    bool SynetConvolution32fThreadsAutoTest()
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        ::SimdConvolutionActivationType a = ::SimdConvolutionActivationRelu;
+
+        result = result && SynetConvolution32fThreadsAutoTest(Param(1, 64, 56, 56, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue));
+        result = result && SynetConvolution32fThreadsAutoTest(Param(1, 256, 7, 7, 512, _3, _1, _1, _1, _1, 1, a, SimdTrue));
+        result = result && SynetConvolution32fThreadsAutoTest(Param(1, 128, 28, 28, 256, _1, _1, _1, _0, _0, 1, a, SimdTrue));
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetConvolution32fSparseVsDenseAutoTest(const Param& p, float sparse)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c = p.conv;
+        double flop = double(p.batch) * c.dstH * c.dstW * c.dstC * c.kernelY * c.kernelX * c.srcC * 2;
+
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution32fForward" << p.Decription("-fp32") << " sparse (" << int(sparse * 100) << "%) vs dense.");
+
+        Tensor32f src({ p.batch, c.srcH, c.srcW, c.srcC });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+        Tensor32f dense({ c.kernelY, c.kernelX, c.srcC, c.dstC }), weight({ c.kernelY, c.kernelX, c.srcC, c.dstC });
+        FillRandom(dense.Data(), dense.Size(), -1.0, 1.0f);
+        memcpy(weight.Data(), dense.Data(), dense.Size() * sizeof(float));
+        SetSparse(c.kernelY * c.kernelX * c.srcC, c.dstC, SimdFalse, sparse, weight.Data());
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+
+        Tensor32f dst0({ p.batch, c.dstH, c.dstW, c.dstC }), dst1(dst0.Shape()), dst2(dst0.Shape()), dst3(dst0.Shape()), buf;
+
+        void* context0 = Simd::Base::SynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        void* context1 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        void* context2 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        ::SimdSynetConvolution32fSetParams(context0, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fSetParams(context2, dense.Data(), NULL, bias.Data(), params.Data());
+        buf.Extend({ ::SimdSynetConvolution32fExternalBufferSize(context0) });
+        buf.Extend({ ::SimdSynetConvolution32fExternalBufferSize(context1) });
+        buf.Extend({ ::SimdSynetConvolution32fExternalBufferSize(context2) });
+        FillRandom(buf.Data(), buf.Size(), -1.0, 1.0f);
+
+        ::SimdSynetConvolution32fForward(context0, src.Data(), buf.Data(), dst0.Data());
+        size_t count1 = 0, count2 = 0;
+        double time1 = ExecuteForTime([&]() { ::SimdSynetConvolution32fForward(context1, src.Data(), buf.Data(), dst1.Data()); return true; }, count1);
+        double time2 = ExecuteForTime([&]() { ::SimdSynetConvolution32fForward(context2, src.Data(), buf.Data(), dst2.Data()); return true; }, count2);
+        TEST_LOG_SS(Info, "Sparse: " << ToString(time1 / count1 * 1000.0, 3, false) << " ms, dense: " << ToString(time2 / count2 * 1000.0, 3, false) << " ms, speedup: "
+            << ToString(time2 * count1 / time1 / count2, 2, false) << ", dense speed: " << ToString(flop * count2 / time2 / 1000000000.0, 1, false) << " GFlops.");
+        result = result && Compare(dst0, dst1, 0.001f, true, 64, DifferenceBoth, "sparse");
+
+        ::SimdSynetConvolution32fSetParams(context1, dense.Data(), NULL, bias.Data(), params.Data());
+        buf.Extend({ ::SimdSynetConvolution32fExternalBufferSize(context1) });
+        ::SimdSynetConvolution32fForward(context1, src.Data(), buf.Data(), dst3.Data());
+        result = result && Compare(dst2, dst3, 0.0f, true, 64, DifferenceAbsolute, "dense after sparse");
+
+        ::SimdRelease(context0);
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        return result;
+    }
+
+    bool SynetConvolution32fSparseVsDenseAutoTest()
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        ::SimdConvolutionActivationType a = ::SimdConvolutionActivationRelu;
+
+        result = result && SynetConvolution32fSparseVsDenseAutoTest(Param(1, 128, 28, 28, 128, _1, _1, _1, _0, _0, 1, a, SimdTrue), 0.75f);
+        result = result && SynetConvolution32fSparseVsDenseAutoTest(Param(1, 64, 56, 56, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue), 0.75f);
+        result = result && SynetConvolution32fSparseVsDenseAutoTest(Param(1, 256, 14, 14, 256, _3, _1, _1, _1, _1, 1, a, SimdTrue), 0.90f);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetConvolution32fPackedWeightAutoTest(const Param& p)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c = p.conv;
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution32fSetPackedParams" << p.Decription("-fp32") << ".");
+
+        Tensor32f src({ p.batch, p.trans ? c.srcH : c.srcC, p.trans ? c.srcW : c.srcH, p.trans ? c.srcC : c.srcW });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+        Tensor32f weight({ p.trans ? c.kernelY : c.dstC, p.trans ? c.kernelX : c.srcC / c.group,
+            p.trans ? c.srcC / c.group : c.kernelY, p.trans ? c.dstC : c.kernelX });
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+
+        Tensor32f dst1({ p.batch, p.trans ? c.dstH : c.dstC, p.trans ? c.dstW : c.dstH, p.trans ? c.dstC : c.dstW });
+        Tensor32f dst2(dst1.Shape()), dst3(dst1.Shape());
+
+        void* context1 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        SimdBool internal = SimdFalse;
+        ::SimdSynetConvolution32fSetParams(context1, weight.Data(), &internal, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fForward(context1, src.Data(), NULL, dst1.Data());
+        void* packed = ::SimdSynetConvolution32fExportWeight(context1);
+        ::SimdRelease(context1);
+
+        const String path = TempPath("packed_weight.bin");
+        result = result && ::SimdSynetPackedWeightSave(packed, path.c_str()) == SimdTrue;
+
+        const float* shared = internal ? NULL : weight.Data();
+        void* context2 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        result = result && ::SimdSynetConvolution32fSetPackedParams(context2, packed, shared, bias.Data(), params.Data()) == SimdTrue;
+        ::SimdRelease(packed);
+        if (result)
+        {
+            ::SimdSynetConvolution32fForward(context2, src.Data(), NULL, dst2.Data());
+            result = result && Compare(dst1, dst2, 0.0f, true, 64, DifferenceAbsolute, "exported");
+        }
+        ::SimdRelease(context2);
+
+        void* loaded = ::SimdSynetPackedWeightLoad(path.c_str());
+        void* context3 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+        result = result && loaded && ::SimdSynetConvolution32fSetPackedParams(context3, loaded, shared, bias.Data(), params.Data()) == SimdTrue;
+        if (result)
+        {
+            ::SimdSynetConvolution32fForward(context3, src.Data(), NULL, dst3.Data());
+            result = result && Compare(dst1, dst3, 0.0f, true, 64, DifferenceAbsolute, "loaded");
+        }
+        ::SimdRelease(context3);
+        if (loaded)
+            ::SimdRelease(loaded);
+
+        if (result)
+        {
+            std::string data;
+            {
+                std::ifstream ifs(path.c_str(), std::ifstream::binary);
+                data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            }
+            size_t layout = data.find(" w1 ");
+            result = result && layout != std::string::npos;
+            if (layout != std::string::npos)
+                data[layout + 2] = '0';
+            {
+                std::ofstream ofs(path.c_str(), std::ofstream::binary);
+                ofs.write(data.data(), data.size());
+            }
+            void* broken = ::SimdSynetPackedWeightLoad(path.c_str());
+            void* context4 = ::SimdSynetConvolution32fInit(p.batch, &p.conv, SimdSynetCompatibilityDefault);
+            if (broken && ::SimdSynetConvolution32fSetPackedParams(context4, broken, shared, bias.Data(), params.Data()) == SimdTrue)
+            {
+                TEST_LOG_SS(Error, "Packed weight with old layout version is accepted!");
+                result = false;
+            }
+            ::SimdRelease(context4);
+            if (broken)
+                ::SimdRelease(broken);
+        }
+        ::remove(path.c_str());
+
+        if (!result)
+            TEST_LOG_SS(Error, "Packed weight test failed!");
+
+        return result;
+    }
+
+    bool SynetConvolution32fPackedWeightAutoTest()
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        ::SimdConvolutionActivationType a = ::SimdConvolutionActivationPrelu;
+
+        result = result && SynetConvolution32fPackedWeightAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue));
+        result = result && SynetConvolution32fPackedWeightAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdFalse));
+        result = result && SynetConvolution32fPackedWeightAutoTest(Param(1, 32, 20, 20, 48, _1, _1, _1, _0, _0, 1, a, SimdTrue));
+        result = result && SynetConvolution32fPackedWeightAutoTest(Param(1, 3, 40, 40, 16, _3, _1, _2, _1, _1, 1, a, SimdTrue));
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetConvolution32fReshapeAutoTest(const Param& p1, const Param& p2)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c1 = p1.conv, & c2 = p2.conv;
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution32fReshape" << p1.Decription("-fp32") << " -> " << p2.batch << "x" << c2.srcH << "x" << c2.srcW << ".");
+
+        Tensor32f src1({ p1.batch, p1.trans ? c1.srcH : c1.srcC, p1.trans ? c1.srcW : c1.srcH, p1.trans ? c1.srcC : c1.srcW });
+        Tensor32f src2({ p2.batch, p2.trans ? c2.srcH : c2.srcC, p2.trans ? c2.srcW : c2.srcH, p2.trans ? c2.srcC : c2.srcW });
+        FillRandom(src1.Data(), src1.Size(), -1.0, 1.0f);
+        FillRandom(src2.Data(), src2.Size(), -1.0, 1.0f);
+        Tensor32f weight({ p1.trans ? c1.kernelY : c1.dstC, p1.trans ? c1.kernelX : c1.srcC / c1.group,
+            p1.trans ? c1.srcC / c1.group : c1.kernelY, p1.trans ? c1.dstC : c1.kernelX });
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c1.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c1.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+
+        Tensor32f dst1({ p1.batch, p1.trans ? c1.dstH : c1.dstC, p1.trans ? c1.dstW : c1.dstH, p1.trans ? c1.dstC : c1.dstW });
+        Tensor32f dst2({ p2.batch, p2.trans ? c2.dstH : c2.dstC, p2.trans ? c2.dstW : c2.dstH, p2.trans ? c2.dstC : c2.dstW });
+        Tensor32f dst3(dst2.Shape()), dst4(dst1.Shape()), buf;
+
+        void* context1 = ::SimdSynetConvolution32fInit(p1.batch, &p1.conv, SimdSynetCompatibilityDefault);
+        ::SimdSynetConvolution32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetConvolution32fForward(context1, src1.Data(), NULL, dst1.Data());
+        String desc = ::SimdSynetConvolution32fInfo(context1);
+        bool expected = desc.find("::DirectNchw") != String::npos || desc.find("::DirectNhwc") != String::npos ||
+            desc.find("::NhwcDirect") != String::npos || desc.find("::Fp16Nhwc") != String::npos;
+        bool reshaped = ::SimdSynetConvolution32fReshape(context1, p2.batch, c2.srcH, c2.srcW) == SimdTrue;
+        if (reshaped != expected)
+        {
+            TEST_LOG_SS(Error, "Algorithm " << desc << (expected ? " must support" : " must not support") << " reshaping!");
+            result = false;
+        }
+        if (reshaped)
+        {
+            buf.Extend({ ::SimdSynetConvolution32fExternalBufferSize(context1) });
+            ::SimdSynetConvolution32fForward(context1, src2.Data(), buf.Data(), dst2.Data());
+
+            void* context2 = ::SimdSynetConvolution32fInit(p2.batch, &p2.conv, SimdSynetCompatibilityDefault);
+            ::SimdSynetConvolution32fSetParams(context2, weight.Data(), NULL, bias.Data(), params.Data());
+            ::SimdSynetConvolution32fForward(context2, src2.Data(), NULL, dst3.Data());
+            ::SimdRelease(context2);
+
+            result = result && Compare(dst2, dst3, 0.001f, true, 64, DifferenceBoth);
+        }
+        else
+        {
+            ::SimdSynetConvolution32fForward(context1, src1.Data(), NULL, dst4.Data());
+            result = result && Compare(dst1, dst4, 0.0f, true, 64, DifferenceAbsolute, "unchanged");
+        }
+        ::SimdRelease(context1);
+
+        return result;
+    }
+
+    bool SynetConvolution32fReshapeAutoTest()
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        ::SimdConvolutionActivationType a = ::SimdConvolutionActivationPrelu;
+
+        result = result && SynetConvolution32fReshapeAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue), Param(1, 64, 40, 36, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue));
+        result = result && SynetConvolution32fReshapeAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue), Param(3, 64, 20, 24, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue));
+        result = result && SynetConvolution32fReshapeAutoTest(Param(1, 32, 20, 20, 48, _1, _1, _1, _0, _0, 1, a, SimdTrue), Param(2, 32, 30, 18, 48, _1, _1, _1, _0, _0, 1, a, SimdTrue));
+        result = result && SynetConvolution32fReshapeAutoTest(Param(1, 3, 40, 40, 16, _3, _1, _2, _1, _1, 1, a, SimdTrue), Param(1, 3, 57, 61, 16, _3, _1, _2, _1, _1, 1, a, SimdTrue));
+        result = result && SynetConvolution32fReshapeAutoTest(Param(1, 16, 30, 30, 16, _3, _1, _1, _1, _1, 16, a, SimdFalse), Param(2, 16, 22, 34, 16, _3, _1, _1, _1, _1, 16, a, SimdFalse));
+
+        return result;
+    }
 #endif
 }
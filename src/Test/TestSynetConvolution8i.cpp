@@ -27,6 +27,8 @@
 #include "Test/TestTensor.h"
 #include "Test/TestSynetConvolutionParam.h"
 #include "Test/TestRandom.h"
+#include "Test/TestString.h"
+#include "Test/TestFile.h"
 
 #include "Simd/SimdSynetConvolution8i.h"
 #include "Simd/SimdSynet.h"
@@ -247,6 +249,7 @@ namespace Test
         //result = result && SynetConvolution8iForwardAutoTest(e, Param(1, 5000, 30, 30, 400, _1, _1, _1, _0, _0, 1, aRe, t1, f32, u8), 0, c, f1, f2);
         //result = result && SynetConvolution8iForwardAutoTest(e, Param(1, 2000, 30, 30, 64, _1, _1, _1, _0, _0, 1, aLr, t1, u8, f32), 1, c, f1, f2);
         result = result && SynetConvolution8iForwardAutoTest(e, Param(1, 256, 16, 16, 128, _1, _1, _1, _0, _0, 1, aGe, t1, u8, f32), 1, c, f1, f2);
+        result = result && SynetConvolution8iForwardAutoTest(e, Param(1, 99, 19, 21, 70, _3, _1, _1, _1, _1, 1, aRe, t1, u8, u8), 1, c, f1, f2);
 #endif
 #else
         //result = result && SynetConvolution8iForwardAutoTest(e, Param(1, 2000, 30, 30, 64, _1, _1, _1, _0, _0, 1, aRe, t1, f32, u8), 0, c, f1, f2);
@@ -256,6 +259,67 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        template<class Convolution> void* NhwcDirectInit(size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility)
+        {
+            return new Convolution(Simd::ConvParam8i(batch, conv, compatibility));
+        }
+    }
+
+    bool SynetConvolution8iWinogradAutoTest(const Param& p, int neg, SimdSynetCompatibilityType comp, const FuncC& f1, const FuncC& f2)
+    {
+        void* context = f2.func(p.batch, &p.conv, comp);
+        String desc = context ? ::SimdSynetConvolution8iInfo(context) : String("NULL");
+        if (context)
+            ::SimdRelease(context);
+        if (desc.find("::Winograd") == String::npos)
+        {
+            TEST_LOG_SS(Error, f2.desc << p.Decription("-int8") << " selects " << desc << " instead of Winograd!");
+            return false;
+        }
+        return SynetConvolution8iForwardAutoTest(EPS, p, neg, comp, f1, f2);
+    }
+
+    bool SynetConvolution8iWinogradAutoTest(const FuncC& f1, const FuncC& f2)
+    {
+        bool result = true;
+
+        const Size _0(0, 0), _1(1, 1), _3(3, 3);
+        const SimdBool t1 = SimdTrue;
+        const SimdTensorDataType f32 = SimdTensorData32f, u8 = SimdTensorData8u;
+        const SimdConvolutionActivationType aId = SimdConvolutionActivationIdentity, aRe = SimdConvolutionActivationRelu, aPr = SimdConvolutionActivationPrelu;
+        const SimdSynetCompatibilityType p = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iPrecise | SimdSynetCompatibilityFmaUse);
+
+        result = result && SynetConvolution8iWinogradAutoTest(Param(1, 32, 9, 11, 32, _3, _1, _1, _0, _0, 1, aRe, t1, u8, u8), 0, p, f1, f2);
+        result = result && SynetConvolution8iWinogradAutoTest(Param(1, 32, 9, 11, 32, _3, _1, _1, _1, _1, 1, aRe, t1, u8, u8), 1, p, f1, f2);
+        result = result && SynetConvolution8iWinogradAutoTest(Param(2, 64, 15, 17, 48, _3, _1, _1, _1, _1, 1, aPr, t1, u8, u8), 0, p, f1, f2);
+        result = result && SynetConvolution8iWinogradAutoTest(Param(3, 33, 10, 8, 35, _3, _1, _1, _0, _0, 1, aId, t1, u8, f32), 1, p, f1, f2);
+        result = result && SynetConvolution8iWinogradAutoTest(Param(1, 1021, 9, 9, 64, _3, _1, _1, _1, _1, 1, aRe, t1, u8, f32), 0, p, f1, f2);
+        result = result && SynetConvolution8iWinogradAutoTest(Param(2, 1024, 7, 7, 96, _3, _1, _1, _1, _1, 1, aRe, t1, u8, u8), 0, p, f1, f2);
+
+        return result;
+    }
+
+    bool SynetConvolution8iWinogradAutoTest()
+    {
+        bool result = true;
+
+#if defined(SIMD_INT8_DEBUG_ENABLE)
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetConvolution8iWinogradAutoTest(FUNC_C(NhwcDirectInit<Simd::Avx2::SynetConvolution8iNhwcDirect>), FUNC_C(Simd::Avx2::SynetConvolution8iInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetConvolution8iWinogradAutoTest(FUNC_C(NhwcDirectInit<Simd::Avx512bw::SynetConvolution8iNhwcDirect>), FUNC_C(Simd::Avx512bw::SynetConvolution8iInit));
+#endif
+#endif
+
+        return result;
+    }
+
     bool SynetConvolution8iForwardAutoTest(const FuncC& f1, const FuncC& f2)
     {
         bool result = true;
@@ -310,5 +374,233 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetConvolution8iThreadsAutoTest(const Param& p, int neg, SimdSynetCompatibilityType comp)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c = p.conv;
+        double flop = double(p.batch) * c.dstH * c.dstW * c.dstC * c.kernelY * c.kernelX * c.srcC / c.group * 2;
+
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution8iForward" << p.Decription("-int8") << " by thread number.");
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), -3.0f, 3.0f);
+
+        Tensor32f srcMin({ c.srcC }), srcMax({ c.srcC }), dstMin({ c.dstC }), dstMax({ c.dstC });
+        Tensor32f src32f(p.SrcShape(), c.srcF), dst32f(p.DstShape(), c.dstF), buf32f;
+        Tensor8u src8u(p.SrcShape(), c.srcF), dst8u1(p.DstShape(), c.dstF), dst8u2(p.DstShape(), c.dstF), buf8u;
+
+        FillRandom(src32f, srcMin.Data(), srcMax.Data(), c.srcC, neg);
+        SetSrc32fTo8u(src32f, srcMin.Data(), srcMax.Data(), c.srcC, neg, comp, NULL, NULL, src8u);
+        FillDstStat(p, neg, comp, weight, bias, params, src32f, buf32f, dst32f, dstMin.Data(), dstMax.Data(), NULL, NULL);
+        const float* stats[4] = { srcMin.Data(), srcMax.Data(), dstMin.Data(), dstMax.Data() };
+
+        size_t threads = SimdGetThreadNumber();
+        for (size_t number = 1; number <= 8 && result; number *= 2)
+        {
+            SimdSetThreadNumber(number);
+            void* context = ::SimdSynetConvolution8iInit(p.batch, &p.conv, comp);
+            if (context == NULL)
+            {
+                TEST_LOG_SS(Error, "Can't create convolution context!");
+                result = false;
+                break;
+            }
+            buf8u.Extend({ ::SimdSynetConvolution8iExternalBufferSize(context) });
+            ::SimdSynetConvolution8iSetParams(context, weight.Data(), bias.Data(), params.Data(), stats);
+            Tensor8u& dst = number == 1 ? dst8u1 : dst8u2;
+            size_t count = 0;
+            double time = ExecuteForTime([&]() { ::SimdSynetConvolution8iForward(context, src8u.Data(), buf8u.Data(), dst.Data()); return true; }, count);
+            ::SimdRelease(context);
+            TEST_LOG_SS(Info, "Threads: " << number << ", speed: " << ToString(flop * count / time / 1000000000.0, 1, false) << " GFlops.");
+            if (number > 1)
+                result = result && Compare(dst8u1, dst8u2, 0, true, 64);
+        }
+        SimdSetThreadNumber(threads);
+
+        return result;
+    }
+
+    bool SynetConvolution8iThreadsAutoTest()
+    {
+        bool result = true;
+
+        const Size _0(0, 0), _1(1, 1), _3(3, 3);
+        const SimdTensorDataType u8 = SimdTensorData8u;
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu;
+        const SimdSynetCompatibilityType n = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iNarrowed | SimdSynetCompatibilityFmaUse);
+
+        result = result && SynetConvolution8iThreadsAutoTest(Param(1, 64, 56, 56, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), 0, n);
+        result = result && SynetConvolution8iThreadsAutoTest(Param(1, 256, 14, 14, 256, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), 0, n);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetConvolution8iPackedWeightAutoTest(const Param& p, int neg, SimdSynetCompatibilityType comp)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c = p.conv;
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution8iSetPackedParams" << p.Decription("-int8") << ".");
+
+        Tensor32f weight(p.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c.dstC });
+        FillRandom(params.Data(), params.Size(), -3.0f, 3.0f);
+
+        Tensor32f srcMin({ c.srcC }), srcMax({ c.srcC }), dstMin({ c.dstC }), dstMax({ c.dstC });
+        Tensor32f src32f(p.SrcShape(), c.srcF), dst32f(p.DstShape(), c.dstF), buf32f;
+        Tensor8u src8u(p.SrcShape(), c.srcF), dst1(p.DstShape(), c.dstF), dst2(p.DstShape(), c.dstF), dst3(p.DstShape(), c.dstF);
+
+        FillRandom(src32f, srcMin.Data(), srcMax.Data(), c.srcC, neg);
+        SetSrc32fTo8u(src32f, srcMin.Data(), srcMax.Data(), c.srcC, neg, comp, NULL, NULL, src8u);
+        FillDstStat(p, neg, comp, weight, bias, params, src32f, buf32f, dst32f, dstMin.Data(), dstMax.Data(), NULL, NULL);
+        const float* stats[4] = { srcMin.Data(), srcMax.Data(), dstMin.Data(), dstMax.Data() };
+
+        void* context1 = ::SimdSynetConvolution8iInit(p.batch, &p.conv, comp);
+        ::SimdSynetConvolution8iSetParams(context1, weight.Data(), bias.Data(), params.Data(), stats);
+        ::SimdSynetConvolution8iForward(context1, src8u.Data(), NULL, dst1.Data());
+        void* packed = ::SimdSynetConvolution8iExportWeight(context1);
+        ::SimdRelease(context1);
+
+        const String path = TempPath("packed_weight_8i.bin");
+        result = result && ::SimdSynetPackedWeightSave(packed, path.c_str()) == SimdTrue;
+
+        void* context2 = ::SimdSynetConvolution8iInit(p.batch, &p.conv, comp);
+        result = result && ::SimdSynetConvolution8iSetPackedParams(context2, packed, weight.Data(), bias.Data(), params.Data(), stats) == SimdTrue;
+        ::SimdRelease(packed);
+        if (result)
+        {
+            ::SimdSynetConvolution8iForward(context2, src8u.Data(), NULL, dst2.Data());
+            result = result && Compare(dst1, dst2, 0, true, 64, "exported");
+        }
+        ::SimdRelease(context2);
+
+        void* loaded = ::SimdSynetPackedWeightLoad(path.c_str());
+        void* context3 = ::SimdSynetConvolution8iInit(p.batch, &p.conv, comp);
+        result = result && loaded && ::SimdSynetConvolution8iSetPackedParams(context3, loaded, weight.Data(), bias.Data(), params.Data(), stats) == SimdTrue;
+        if (result)
+        {
+            ::SimdSynetConvolution8iForward(context3, src8u.Data(), NULL, dst3.Data());
+            result = result && Compare(dst1, dst3, 0, true, 64, "loaded");
+        }
+        ::SimdRelease(context3);
+        if (loaded)
+            ::SimdRelease(loaded);
+        ::remove(path.c_str());
+
+        if (!result)
+            TEST_LOG_SS(Error, "Packed weight test failed!");
+
+        return result;
+    }
+
+    bool SynetConvolution8iPackedWeightAutoTest()
+    {
+        bool result = true;
+
+        const Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        const SimdTensorDataType u8 = SimdTensorData8u;
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu;
+        const SimdSynetCompatibilityType n = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iNarrowed | SimdSynetCompatibilityFmaUse);
+
+        result = result && SynetConvolution8iPackedWeightAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), 0, n);
+        result = result && SynetConvolution8iPackedWeightAutoTest(Param(1, 32, 20, 20, 48, _1, _1, _1, _0, _0, 1, a, SimdTrue, u8, u8), 0, n);
+        result = result && SynetConvolution8iPackedWeightAutoTest(Param(1, 3, 40, 40, 16, _3, _1, _2, _1, _1, 1, a, SimdTrue, u8, u8), 0, n);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetConvolution8iReshapeAutoTest(const Param& p1, const Param& p2, int neg, SimdSynetCompatibilityType comp)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c1 = p1.conv, & c2 = p2.conv;
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution8iReshape" << p1.Decription("-int8") << " -> " << p2.batch << "x" << c2.srcH << "x" << c2.srcW << ".");
+
+        Tensor32f weight(p1.WeightShape());
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c1.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c1.dstC });
+        FillRandom(params.Data(), params.Size(), -3.0f, 3.0f);
+
+        Tensor32f srcMin({ c1.srcC }), srcMax({ c1.srcC }), dstMin({ c1.dstC }), dstMax({ c1.dstC }), tmpMin({ c2.srcC }), tmpMax({ c2.srcC });
+        Tensor32f src32f1(p1.SrcShape(), c1.srcF), src32f2(p2.SrcShape(), c2.srcF), dst32f(p1.DstShape(), c1.dstF), buf32f;
+        Tensor8u src1(p1.SrcShape(), c1.srcF), src2(p2.SrcShape(), c2.srcF), buf8u;
+        Tensor8u dst1(p1.DstShape(), c1.dstF), dst2(p2.DstShape(), c2.dstF), dst3(p2.DstShape(), c2.dstF), dst4(p1.DstShape(), c1.dstF);
+
+        FillRandom(src32f1, srcMin.Data(), srcMax.Data(), c1.srcC, neg);
+        SetSrc32fTo8u(src32f1, srcMin.Data(), srcMax.Data(), c1.srcC, neg, comp, NULL, NULL, src1);
+        FillRandom(src32f2, tmpMin.Data(), tmpMax.Data(), c2.srcC, neg);
+        SetSrc32fTo8u(src32f2, srcMin.Data(), srcMax.Data(), c2.srcC, neg, comp, NULL, NULL, src2);
+        FillDstStat(p1, neg, comp, weight, bias, params, src32f1, buf32f, dst32f, dstMin.Data(), dstMax.Data(), NULL, NULL);
+        const float* stats[4] = { srcMin.Data(), srcMax.Data(), dstMin.Data(), dstMax.Data() };
+
+        void* context1 = ::SimdSynetConvolution8iInit(p1.batch, &p1.conv, comp);
+        ::SimdSynetConvolution8iSetParams(context1, weight.Data(), bias.Data(), params.Data(), stats);
+        ::SimdSynetConvolution8iForward(context1, src1.Data(), NULL, dst1.Data());
+        String desc = ::SimdSynetConvolution8iInfo(context1);
+        bool expected = desc.find("::NhwcDirect") != String::npos || desc.find("::Winograd") != String::npos;
+        bool reshaped = ::SimdSynetConvolution8iReshape(context1, p2.batch, c2.srcH, c2.srcW) == SimdTrue;
+        if (reshaped != expected)
+        {
+            TEST_LOG_SS(Error, "Algorithm " << desc << (expected ? " must support" : " must not support") << " reshaping!");
+            result = false;
+        }
+        if (reshaped)
+        {
+            buf8u.Extend({ ::SimdSynetConvolution8iExternalBufferSize(context1) });
+            ::SimdSynetConvolution8iForward(context1, src2.Data(), buf8u.Data(), dst2.Data());
+
+            void* context2 = ::SimdSynetConvolution8iInit(p2.batch, &p2.conv, comp);
+            ::SimdSynetConvolution8iSetParams(context2, weight.Data(), bias.Data(), params.Data(), stats);
+            ::SimdSynetConvolution8iForward(context2, src2.Data(), NULL, dst3.Data());
+            ::SimdRelease(context2);
+
+            result = result && Compare(dst2, dst3, 0, true, 64, "reshaped");
+        }
+        else
+        {
+            ::SimdSynetConvolution8iForward(context1, src1.Data(), NULL, dst4.Data());
+            result = result && Compare(dst1, dst4, 0, true, 64, "unchanged");
+        }
+        ::SimdRelease(context1);
+
+        return result;
+    }
+
+    bool SynetConvolution8iReshapeAutoTest()
+    {
+        bool result = true;
+
+        const Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3);
+        const SimdTensorDataType u8 = SimdTensorData8u;
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu;
+        const SimdSynetCompatibilityType n = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iNarrowed | SimdSynetCompatibilityFmaUse);
+        const SimdSynetCompatibilityType p = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iPrecise | SimdSynetCompatibilityFmaUse);
+
+        result = result && SynetConvolution8iReshapeAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), Param(1, 64, 40, 36, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), 0, n);
+        result = result && SynetConvolution8iReshapeAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), Param(3, 64, 20, 24, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), 0, n);
+        result = result && SynetConvolution8iReshapeAutoTest(Param(1, 64, 28, 28, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), Param(2, 64, 19, 23, 64, _3, _1, _1, _1, _1, 1, a, SimdTrue, u8, u8), 0, p);
+        result = result && SynetConvolution8iReshapeAutoTest(Param(1, 32, 20, 20, 48, _1, _1, _1, _0, _0, 1, a, SimdTrue, u8, u8), Param(2, 32, 30, 18, 48, _1, _1, _1, _0, _0, 1, a, SimdTrue, u8, u8), 0, n);
+        result = result && SynetConvolution8iReshapeAutoTest(Param(1, 3, 40, 40, 16, _3, _1, _2, _1, _1, 1, a, SimdTrue, u8, u8), Param(1, 3, 57, 61, 16, _3, _1, _2, _1, _1, 1, a, SimdTrue, u8, u8), 0, n);
+        result = result && SynetConvolution8iReshapeAutoTest(Param(1, 32, 30, 30, 32, _3, _1, _1, _1, _1, 32, a, SimdTrue, u8, u8), Param(2, 32, 22, 34, 32, _3, _1, _1, _1, _1, 32, a, SimdTrue, u8, u8), 0, n);
+
+        return result;
+    }
 #endif
 }
@@ -25,6 +25,7 @@
 #define __TestSynetConvolutionParam_h__
 
 #include "Test/TestConfig.h"
+#include "Test/TestRandom.h"
 
 namespace Test
 {
@@ -155,6 +156,23 @@ namespace Test
             }
         }
     };
+
+    //-------------------------------------------------------------------------------------------------
+
+    inline void SetSparse(size_t K, size_t N, SimdBool trans, float sparse, float* weight)
+    {
+        for (size_t k = 0; k < K; k += 4)
+        {
+            for (size_t n = 0; n < N; n += 16)
+            {
+                if (Random() >= sparse)
+                    continue;
+                for (size_t kk = k, kE = Simd::Min(k + 4, K); kk < kE; ++kk)
+                    for (size_t nn = n, nE = Simd::Min(n + 16, N); nn < nE; ++nn)
+                        weight[trans ? nn * K + kk : kk * N + nn] = 0.0f;
+            }
+        }
+    }
 }
 
 #endif//__TestSynetConvolutionParam_h__
@@ -203,5 +203,77 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetDeconvolution32fReshapeAutoTest(const Param& p1, const Param& p2)
+    {
+        bool result = true;
+
+        const SimdConvolutionParameters& c1 = p1.conv, & c2 = p2.conv;
+        TEST_LOG_SS(Info, "Test SimdSynetDeconvolution32fReshape" << p1.Decription() << " -> " << p2.batch << "x" << c2.srcH << "x" << c2.srcW << ".");
+
+        Tensor32f src1({ p1.batch, p1.trans ? c1.srcH : c1.srcC, p1.trans ? c1.srcW : c1.srcH, p1.trans ? c1.srcC : c1.srcW });
+        Tensor32f src2({ p2.batch, p2.trans ? c2.srcH : c2.srcC, p2.trans ? c2.srcW : c2.srcH, p2.trans ? c2.srcC : c2.srcW });
+        FillRandom(src1.Data(), src1.Size(), -1.0, 1.0f);
+        FillRandom(src2.Data(), src2.Size(), -1.0, 1.0f);
+        Tensor32f weight({ c1.srcC, p1.trans ? c1.kernelY : c1.dstC / c1.group, p1.trans ? c1.kernelX : c1.kernelY, p1.trans ? c1.dstC / c1.group : c1.kernelX });
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c1.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f params({ c1.dstC });
+        FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+
+        Tensor32f dst1({ p1.batch, p1.trans ? c1.dstH : c1.dstC, p1.trans ? c1.dstW : c1.dstH, p1.trans ? c1.dstC : c1.dstW });
+        Tensor32f dst2({ p2.batch, p2.trans ? c2.dstH : c2.dstC, p2.trans ? c2.dstW : c2.dstH, p2.trans ? c2.dstC : c2.dstW });
+        Tensor32f dst3(dst2.Shape()), dst4(dst1.Shape()), buf;
+
+        void* context1 = ::SimdSynetDeconvolution32fInit(p1.batch, &p1.conv, SimdSynetCompatibilityDefault);
+        ::SimdSynetDeconvolution32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
+        ::SimdSynetDeconvolution32fForward(context1, src1.Data(), NULL, dst1.Data());
+        String desc = ::SimdSynetDeconvolution32fInfo(context1);
+        bool expected = desc.find("::NhwcDirect2x2") != String::npos;
+        bool reshaped = ::SimdSynetDeconvolution32fReshape(context1, p2.batch, c2.srcH, c2.srcW) == SimdTrue;
+        if (reshaped != expected)
+        {
+            TEST_LOG_SS(Error, "Algorithm " << desc << (expected ? " must support" : " must not support") << " reshaping!");
+            result = false;
+        }
+        if (reshaped)
+        {
+            buf.Extend({ ::SimdSynetDeconvolution32fExternalBufferSize(context1) });
+            ::SimdSynetDeconvolution32fForward(context1, src2.Data(), buf.Data(), dst2.Data());
+
+            void* context2 = ::SimdSynetDeconvolution32fInit(p2.batch, &p2.conv, SimdSynetCompatibilityDefault);
+            ::SimdSynetDeconvolution32fSetParams(context2, weight.Data(), NULL, bias.Data(), params.Data());
+            ::SimdSynetDeconvolution32fForward(context2, src2.Data(), NULL, dst3.Data());
+            ::SimdRelease(context2);
+
+            result = result && Compare(dst2, dst3, 0.001f, true, 64, DifferenceBoth, "reshaped");
+        }
+        else
+        {
+            ::SimdSynetDeconvolution32fForward(context1, src1.Data(), NULL, dst4.Data());
+            result = result && Compare(dst1, dst4, 0.0f, true, 64, DifferenceAbsolute, "unchanged");
+        }
+        ::SimdRelease(context1);
+
+        return result;
+    }
+
+    bool SynetDeconvolution32fReshapeAutoTest()
+    {
+        bool result = true;
+
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _4(4, 4);
+        ::SimdConvolutionActivationType a = ::SimdConvolutionActivationPrelu;
+
+        result = result && SynetDeconvolution32fReshapeAutoTest(Param(1, 24, 11, 20, 24, _2, _1, _2, _0, _0, 1, a, SimdTrue), Param(1, 24, 17, 13, 24, _2, _1, _2, _0, _0, 1, a, SimdTrue));
+        result = result && SynetDeconvolution32fReshapeAutoTest(Param(1, 64, 22, 40, 32, _2, _1, _2, _0, _0, 1, a, SimdTrue), Param(3, 64, 12, 20, 32, _2, _1, _2, _0, _0, 1, a, SimdTrue));
+        result = result && SynetDeconvolution32fReshapeAutoTest(Param(1, 16, 10, 12, 8, _4, _1, _2, _1, _1, 1, a, SimdTrue), Param(2, 16, 14, 9, 8, _4, _1, _2, _1, _1, 1, a, SimdTrue));
+        result = result && SynetDeconvolution32fReshapeAutoTest(Param(1, 24, 11, 20, 24, _2, _1, _2, _0, _0, 1, a, SimdFalse), Param(2, 24, 15, 9, 24, _2, _1, _2, _0, _0, 1, a, SimdFalse));
+
+        return result;
+    }
 #endif
 }
@@ -26,9 +26,12 @@
 #include "Test/TestTensor.h"
 #include "Test/TestString.h"
 #include "Test/TestRandom.h"
+#include "Test/TestUtils.h"
+#include "Test/TestSynetConvolutionParam.h"
 
 #include "Simd/SimdSynet.h"
 #include "Simd/SimdSynetInnerProduct32f.h"
+#include "Simd/SimdSynetGemm8i.h"
 
 namespace Test
 {
@@ -38,15 +41,24 @@ namespace Test
         struct FuncIP32F
         {
             typedef void* (*FuncPtr)(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
+            typedef void* (*FuncV2Ptr)(size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
 
             FuncPtr func;
+            FuncV2Ptr funcV2;
+            SimdSynetCompatibilityType comp;
             String desc;
 
-            FuncIP32F(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+            FuncIP32F(const FuncPtr& f, const String& d) : func(f), funcV2(NULL), comp(SimdSynetCompatibilityDefault), desc(d) {}
+            FuncIP32F(const FuncV2Ptr& f, SimdSynetCompatibilityType c, const String& d) : func(NULL), funcV2(f), comp(c), desc(d) {}
 
             void Update(size_t b, size_t i, size_t o, SimdBool t, SimdConvolutionActivationType a)
             {
-                desc = desc + "[" + ToString(b) + "-" + ToString(i) + "-" + ToString(o) + "-" + ToString((int)t) + "]";
+                desc = desc + "[" + ToString(b) + "-" + ToString(i) + "-" + ToString(o) + "-" + ToString((int)t) + (Simd::Base::Fp16Soft(comp) ? "-fp16" : "") + "]";
+            }
+
+            void* Init(size_t b, size_t i, size_t o, SimdBool t, SimdConvolutionActivationType a) const
+            {
+                return funcV2 ? funcV2(b, i, o, t, a, comp) : func(b, i, o, t, a);
             }
 
             void Call(void* context, const Tensor32f& src, Tensor32f& dst) const
@@ -60,12 +72,20 @@ namespace Test
 #define FUNC_IP32F(function) \
     FuncIP32F(function, std::string(#function))
 
-    bool SynetInnerProduct32fForwardAutoTest(float eps, size_t b, size_t i, size_t o, SimdBool t, SimdConvolutionActivationType a, FuncIP32F f1, FuncIP32F f2)
+#define FUNC_IP32F_V2(function, compatibility) \
+    FuncIP32F(function, compatibility, std::string(#function))
+
+    bool SynetInnerProduct32fForwardAutoTest(float eps, size_t b, size_t i, size_t o, SimdBool t, SimdConvolutionActivationType a, FuncIP32F f1, FuncIP32F f2, float sparse = 0.0f)
     {
         bool result = true;
 
         f1.Update(b, i, o, t, a);
         f2.Update(b, i, o, t, a);
+        if (sparse > 0.0f)
+        {
+            f1.desc += "-s" + ToString(int(sparse * 100));
+            f2.desc += "-s" + ToString(int(sparse * 100));
+        }
 
         TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << ".");
 
@@ -74,6 +94,8 @@ namespace Test
 
         Tensor32f weight({ t ? o : i, t ? i : o });
         FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        if (sparse > 0.0f)
+            SetSparse(i, o, t, sparse, weight.Data());
 
         Tensor32f bias({ o });
         FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
@@ -102,8 +124,8 @@ namespace Test
         ::SimdFill32f(dst1.Data(), dst1.Size(), params.Data() + 0);
         ::SimdFill32f(dst2.Data(), dst2.Size(), params.Data() + 1);
 
-        void* context1 = f1.func(b, i, o, t, a);
-        void* context2 = f2.func(b, i, o, t, a);
+        void* context1 = f1.Init(b, i, o, t, a);
+        void* context2 = f2.Init(b, i, o, t, a);
 
         ::SimdSynetInnerProduct32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
         ::SimdSynetInnerProduct32fSetParams(context2, weight.Data(), NULL, bias.Data(), params.Data());
@@ -160,6 +182,13 @@ namespace Test
         //result = result && SynetInnerProduct32fForwardAutoTest(eps, 49, 32, 49, f, a, f1, f2);
         result = result && SynetInnerProduct32fForwardAutoTest(eps, 49, 49, 32, f, a, f1, f2);
 #endif
+#if 1
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 1, 4096, 4096, t, a, f1, f2, 0.00f);
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 1, 4096, 4096, t, a, f1, f2, 0.75f);
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 64, 1024, 1024, t, a, f1, f2, 0.00f);
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 64, 1024, 1024, t, a, f1, f2, 0.75f);
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 17, 99, 70, f, a, f1, f2, 0.90f);
+#endif
 #if 0
         result = result && SynetInnerProduct32fForwardAutoTest(eps, 10, 1024, 4096, f, a, f1, f2);
         result = result && SynetInnerProduct32fForwardAutoTest(eps, 10, 256, 1024, f, a, f1, f2);       
@@ -177,6 +206,7 @@ namespace Test
 #endif
 #else
         result = result && SynetInnerProduct32fForwardAutoTest(eps, 49, 49, 32, f, a, f1, f2);
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 17, 99, 70, f, a, f1, f2, 0.90f);
         //result = result && SynetInnerProduct32fForwardAutoTest(eps, 100, 1024, 4096, t, a, f1, f2);
         //result = result && SynetInnerProduct32fForwardAutoTest(eps, 100, 4096, 1024, t, a, f1, f2);
 #endif
@@ -219,6 +249,55 @@ namespace Test
         return result;
     }
 
+    bool SynetInnerProduct32fFp16AutoTest(float eps, const FuncIP32F& f1, const FuncIP32F& f2)
+    {
+        bool result = true;
+
+        SimdBool t = SimdTrue, f = SimdFalse;
+        SimdConvolutionActivationType a = SimdConvolutionActivationIdentity;
+
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 1, 1000, 999, t, a, f1, f2);
+        result = result && SynetInnerProduct32fForwardAutoTest(eps, 17, 99, 70, f, a, f1, f2);
+
+        return result;
+    }
+
+    bool SynetInnerProduct32fFp16AutoTest()
+    {
+        const float EPS = 0.001f;
+        const SimdSynetCompatibilityType h = SimdSynetCompatibility16fpSoft;
+        bool result = true;
+
+        result = result && SynetInnerProduct32fFp16AutoTest(EPS, FUNC_IP32F_V2(Simd::Base::SynetInnerProduct32fInitV2, h), FUNC_IP32F_V2(SimdSynetInnerProduct32fInitV2, h));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && SynetInnerProduct32fFp16AutoTest(EPS, FUNC_IP32F_V2(Simd::Sse41::SynetInnerProduct32fInitV2, h), FUNC_IP32F_V2(SimdSynetInnerProduct32fInitV2, h));
+#endif 
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+            result = result && SynetInnerProduct32fFp16AutoTest(EPS, FUNC_IP32F_V2(Simd::Avx::SynetInnerProduct32fInitV2, h), FUNC_IP32F_V2(SimdSynetInnerProduct32fInitV2, h));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetInnerProduct32fFp16AutoTest(EPS, FUNC_IP32F_V2(Simd::Avx2::SynetInnerProduct32fInitV2, h), FUNC_IP32F_V2(SimdSynetInnerProduct32fInitV2, h));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetInnerProduct32fFp16AutoTest(EPS, FUNC_IP32F_V2(Simd::Avx512bw::SynetInnerProduct32fInitV2, h), FUNC_IP32F_V2(SimdSynetInnerProduct32fInitV2, h));
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && SynetInnerProduct32fFp16AutoTest(EPS, FUNC_IP32F_V2(Simd::Neon::SynetInnerProduct32fInitV2, h), FUNC_IP32F_V2(SimdSynetInnerProduct32fInitV2, h));
+#endif
+
+        return result;
+    }
+
     //-------------------------------------------------------------------------
 
     namespace
@@ -428,5 +507,250 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncG8I
+        {
+            typedef void*(*FuncPtr)(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType activation, SimdSynetCompatibilityType compatibility);
+
+            FuncPtr func;
+            String desc;
+
+            FuncG8I(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, SimdConvolutionActivationType a)
+            {
+                desc = desc + "[" + ToString(M) + "x" + ToString(N) + "x" + ToString(K) + "-"
+                    + (srcT == SimdTensorData32f ? "f" : "u") + (dstT == SimdTensorData32f ? "f" : "u") + "-" + ToString(int(a)) + "]";
+            }
+
+            void Call(void* context, const uint8_t* src, uint8_t* buf, uint8_t* dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                ::SimdSynetGemm8iForward(context, src, buf, dst);
+            }
+        };
+    }
+
+#define FUNC_G8I(function) FuncG8I(function, #function)
+
+    bool SynetGemm8iForwardAutoTest(size_t M, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT, 
+        SimdConvolutionActivationType a, SimdSynetCompatibilityType c, FuncG8I f1, FuncG8I f2)
+    {
+        bool result = true;
+
+        f1.Update(M, N, K, srcT, dstT, a);
+        f2.Update(M, N, K, srcT, dstT, a);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc);
+
+        Tensor32f weight(Shp(K, N)), bias(Shp(N)), params(Shp(2));
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        params.Data()[0] = 0.1f;
+        params.Data()[1] = 1.1f;
+
+        Tensor32f srcMin(Shp(K)), srcMax(Shp(K)), dstMin(Shp(N)), dstMax(Shp(N));
+        Tensor32f src32f(Shp(1, M, K), SimdTensorFormatNhwc), dst32f1(Shp(1, M, N), SimdTensorFormatNhwc), dst32f2(Shp(1, M, N), SimdTensorFormatNhwc);
+        Tensor8u src8u(Shp(1, M, K), SimdTensorFormatNhwc), dst8u1(Shp(1, M, N), SimdTensorFormatNhwc), dst8u2(Shp(1, M, N), SimdTensorFormatNhwc);
+        FillRandom(src32f, srcMin.Data(), srcMax.Data(), K, 0);
+        SetSrc32fTo8u(src32f, srcMin.Data(), srcMax.Data(), K, 0, c, NULL, NULL, src8u);
+
+        const float alpha = 1.0f, beta = 1.0f, slope = 0.0f;
+        for (size_t i = 0; i < M; ++i)
+            memcpy(dst32f1.Data() + i * N, bias.Data(), N * sizeof(float));
+        ::SimdGemm32fNN(M, N, K, &alpha, src32f.Data(), K, weight.Data(), N, &beta, dst32f1.Data(), N);
+        if (a == SimdConvolutionActivationRelu)
+            ::SimdSynetRelu32f(dst32f1.Data(), dst32f1.Size(), &slope, dst32f1.Data());
+        SetDstStat(N, 0, c, dst32f1, dstMin.Data(), dstMax.Data(), NULL, NULL);
+
+        const float* stats[4] = { srcMin.Data(), srcMax.Data(), dstMin.Data(), dstMax.Data() };
+        const uint8_t* src = srcT == SimdTensorData32f ? (uint8_t*)src32f.Data() : src8u.Data();
+        uint8_t* dst1 = dstT == SimdTensorData32f ? (uint8_t*)dst32f1.Data() : dst8u1.Data();
+        uint8_t* dst2 = dstT == SimdTensorData32f ? (uint8_t*)dst32f2.Data() : dst8u2.Data();
+
+        Fill(dst32f1, 0.1f);
+        Fill(dst32f2, 1.1f);
+        Fill(dst8u1, uint8_t(1));
+        Fill(dst8u2, uint8_t(2));
+
+        void* context1 = f1.func(M, N, K, srcT, dstT, a, c);
+        void* context2 = f2.func(M, N, K, srcT, dstT, a, c);
+
+        ::SimdSynetGemm8iSetParams(context1, weight.Data(), bias.Data(), params.Data(), stats);
+        ::SimdSynetGemm8iSetParams(context2, weight.Data(), bias.Data(), params.Data(), stats);
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(context1, src, NULL, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(context2, src, NULL, dst2));
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        if (dstT == SimdTensorData32f)
+            result = result && Compare(dst32f1, dst32f2, EPS, true, 64, DifferenceBoth);
+        else
+            result = result && Compare(dst8u1, dst8u2, 1, true, 64);
+
+        return result;
+    }
+
+    bool SynetGemm8iForwardAutoTest(const FuncG8I& f1, const FuncG8I& f2)
+    {
+        bool result = true;
+
+        const SimdTensorDataType f32 = SimdTensorData32f, u8 = SimdTensorData8u;
+        const SimdConvolutionActivationType aId = SimdConvolutionActivationIdentity, aRe = SimdConvolutionActivationRelu;
+        SimdSynetCompatibilityType c = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iNarrowed | SimdSynetCompatibilityFmaUse);
+
+        result = result && SynetGemm8iForwardAutoTest(1, 256, 1024, u8, f32, aRe, c, f1, f2);
+        result = result && SynetGemm8iForwardAutoTest(10, 130, 255, f32, u8, aId, c, f1, f2);
+        result = result && SynetGemm8iForwardAutoTest(33, 64, 512, u8, u8, aRe, c, f1, f2);
+
+        return result;
+    }
+
+    bool SynetGemm8iForwardAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetGemm8iForwardAutoTest(FUNC_G8I(Simd::Base::SynetGemm8iInit), FUNC_G8I(SimdSynetGemm8iInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && SynetGemm8iForwardAutoTest(FUNC_G8I(Simd::Sse41::SynetGemm8iInit), FUNC_G8I(SimdSynetGemm8iInit));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetGemm8iForwardAutoTest(FUNC_G8I(Simd::Avx2::SynetGemm8iInit), FUNC_G8I(SimdSynetGemm8iInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetGemm8iForwardAutoTest(FUNC_G8I(Simd::Avx512bw::SynetGemm8iInit), FUNC_G8I(SimdSynetGemm8iInit));
+#endif
+
+#if defined(SIMD_AVX512VNNI_ENABLE) && !defined(SIMD_AMX_EMULATE)
+        if (Simd::Avx512vnni::Enable)
+            result = result && SynetGemm8iForwardAutoTest(FUNC_G8I(Simd::Avx512vnni::SynetGemm8iInit), FUNC_G8I(SimdSynetGemm8iInit));
+#endif
+
+#if defined(SIMD_AMXBF16_ENABLE) || (defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_AMX_EMULATE))
+        if (Simd::AmxBf16::Enable)
+            result = result && SynetGemm8iForwardAutoTest(FUNC_G8I(Simd::AmxBf16::SynetGemm8iInit), FUNC_G8I(SimdSynetGemm8iInit));
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && SynetGemm8iForwardAutoTest(FUNC_G8I(Simd::Neon::SynetGemm8iInit), FUNC_G8I(SimdSynetGemm8iInit));
+#endif
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool SynetGemm8iReshapeAutoTest(size_t M1, size_t M2, size_t N, size_t K, SimdTensorDataType srcT, SimdTensorDataType dstT,
+        SimdConvolutionActivationType a, SimdSynetCompatibilityType c)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdSynetGemm8iReshape [" << M1 << "x" << N << "x" << K << "-" << (srcT == SimdTensorData32f ? "f" : "u") 
+            << (dstT == SimdTensorData32f ? "f" : "u") << "] -> " << M2 << ".");
+
+        Tensor32f weight(Shp(K, N)), bias(Shp(N)), params(Shp(2));
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        params.Data()[0] = 0.1f;
+        params.Data()[1] = 1.1f;
+
+        Tensor32f srcMin(Shp(K)), srcMax(Shp(K)), dstMin(Shp(N)), dstMax(Shp(N)), tmpMin(Shp(K)), tmpMax(Shp(K));
+        Tensor32f src32f1(Shp(1, M1, K), SimdTensorFormatNhwc), src32f2(Shp(1, M2, K), SimdTensorFormatNhwc);
+        Tensor8u src8u1(Shp(1, M1, K), SimdTensorFormatNhwc), src8u2(Shp(1, M2, K), SimdTensorFormatNhwc);
+        FillRandom(src32f1, srcMin.Data(), srcMax.Data(), K, 0);
+        SetSrc32fTo8u(src32f1, srcMin.Data(), srcMax.Data(), K, 0, c, NULL, NULL, src8u1);
+        FillRandom(src32f2, tmpMin.Data(), tmpMax.Data(), K, 0);
+        SetSrc32fTo8u(src32f2, srcMin.Data(), srcMax.Data(), K, 0, c, NULL, NULL, src8u2);
+
+        Tensor32f ref(Shp(1, M1, N), SimdTensorFormatNhwc);
+        const float alpha = 1.0f, beta = 1.0f, slope = 0.0f;
+        for (size_t i = 0; i < M1; ++i)
+            memcpy(ref.Data() + i * N, bias.Data(), N * sizeof(float));
+        ::SimdGemm32fNN(M1, N, K, &alpha, src32f1.Data(), K, weight.Data(), N, &beta, ref.Data(), N);
+        if (a == SimdConvolutionActivationRelu)
+            ::SimdSynetRelu32f(ref.Data(), ref.Size(), &slope, ref.Data());
+        SetDstStat(N, 0, c, ref, dstMin.Data(), dstMax.Data(), NULL, NULL);
+        const float* stats[4] = { srcMin.Data(), srcMax.Data(), dstMin.Data(), dstMax.Data() };
+
+        Tensor32f dst32f1(Shp(1, M1, N), SimdTensorFormatNhwc), dst32f2(Shp(1, M2, N), SimdTensorFormatNhwc);
+        Tensor32f dst32f3(dst32f2.Shape(), SimdTensorFormatNhwc), dst32f4(dst32f1.Shape(), SimdTensorFormatNhwc);
+        Tensor8u dst8u1(Shp(1, M1, N), SimdTensorFormatNhwc), dst8u2(Shp(1, M2, N), SimdTensorFormatNhwc);
+        Tensor8u dst8u3(dst8u2.Shape(), SimdTensorFormatNhwc), dst8u4(dst8u1.Shape(), SimdTensorFormatNhwc);
+        const bool f32 = srcT == SimdTensorData32f, d32 = dstT == SimdTensorData32f;
+        const uint8_t* src1 = f32 ? (uint8_t*)src32f1.Data() : src8u1.Data();
+        const uint8_t* src2 = f32 ? (uint8_t*)src32f2.Data() : src8u2.Data();
+        uint8_t* dst1 = d32 ? (uint8_t*)dst32f1.Data() : dst8u1.Data();
+        uint8_t* dst2 = d32 ? (uint8_t*)dst32f2.Data() : dst8u2.Data();
+        uint8_t* dst3 = d32 ? (uint8_t*)dst32f3.Data() : dst8u3.Data();
+        uint8_t* dst4 = d32 ? (uint8_t*)dst32f4.Data() : dst8u4.Data();
+
+        void* context1 = ::SimdSynetGemm8iInit(M1, N, K, srcT, dstT, a, c);
+        ::SimdSynetGemm8iSetParams(context1, weight.Data(), bias.Data(), params.Data(), stats);
+        ::SimdSynetGemm8iForward(context1, src1, NULL, dst1);
+        String desc = ::SimdSynetGemm8iInfo(context1);
+        bool expected = desc.find("::NhwcDirect") != String::npos;
+        bool reshaped = ::SimdSynetGemm8iReshape(context1, M2) == SimdTrue;
+        if (reshaped != expected)
+        {
+            TEST_LOG_SS(Error, "Algorithm " << desc << (expected ? " must support" : " must not support") << " reshaping!");
+            result = false;
+        }
+        if (reshaped)
+        {
+            ::SimdSynetGemm8iForward(context1, src2, NULL, dst2);
+
+            void* context2 = ::SimdSynetGemm8iInit(M2, N, K, srcT, dstT, a, c);
+            ::SimdSynetGemm8iSetParams(context2, weight.Data(), bias.Data(), params.Data(), stats);
+            ::SimdSynetGemm8iForward(context2, src2, NULL, dst3);
+            ::SimdRelease(context2);
+
+            if (d32)
+                result = result && Compare(dst32f2, dst32f3, EPS, true, 64, DifferenceBoth, "reshaped");
+            else
+                result = result && Compare(dst8u2, dst8u3, 0, true, 64, "reshaped");
+        }
+        else
+        {
+            ::SimdSynetGemm8iForward(context1, src1, NULL, dst4);
+            if (d32)
+                result = result && Compare(dst32f1, dst32f4, 0.0f, true, 64, DifferenceAbsolute, "unchanged");
+            else
+                result = result && Compare(dst8u1, dst8u4, 0, true, 64, "unchanged");
+        }
+        ::SimdRelease(context1);
+
+        return result;
+    }
+
+    bool SynetGemm8iReshapeAutoTest()
+    {
+        bool result = true;
+
+        const SimdTensorDataType f32 = SimdTensorData32f, u8 = SimdTensorData8u;
+        const SimdConvolutionActivationType aId = SimdConvolutionActivationIdentity, aRe = SimdConvolutionActivationRelu;
+        SimdSynetCompatibilityType c = (SimdSynetCompatibilityType)(SimdSynetCompatibility8iNarrowed | SimdSynetCompatibilityFmaUse);
+
+        result = result && SynetGemm8iReshapeAutoTest(1, 17, 256, 1024, u8, f32, aRe, c);
+        result = result && SynetGemm8iReshapeAutoTest(10, 3, 130, 255, f32, u8, aId, c);
+        result = result && SynetGemm8iReshapeAutoTest(33, 64, 64, 512, u8, u8, aRe, c);
+
+        return result;
+    }
 #endif
 }
@@ -0,0 +1,153 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2023 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestTensor.h"
+#include "Test/TestString.h"
+#include "Test/TestRandom.h"
+
+#include "Simd/SimdSynetMatMul32f.h"
+#include "Simd/SimdSynet.h"
+
+namespace Test
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace
+    {
+        struct FuncMM
+        {
+            typedef void*(*FuncPtr)(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility);
+
+            FuncPtr func;
+            String desc;
+
+            FuncMM(const FuncPtr & f, const String & d) : func(f), desc(d) {}
+
+            void Update(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility)
+            {
+                std::stringstream ss;
+                ss << desc << "[" << batchA << "/" << batchB << "x" << M << "x" << N << "x" << K << "-" << transB;
+                ss << (Simd::Base::Bf16Soft(compatibility) ? "-bf16" : "") << "]";
+                desc = ss.str();
+            }
+
+            void Call(void * context, const float * A, const float * B, float * C) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                SimdSynetMatMul32fForward(context, A, B, C);
+            }
+        };
+    }
+
+#define FUNC_MM(function) FuncMM(function, #function)
+
+    bool SynetMatMul32fForwardAutoTest(size_t batchA, size_t batchB, size_t M, size_t N, size_t K, SimdBool transB, SimdSynetCompatibilityType compatibility, FuncMM f1, FuncMM f2)
+    {
+        bool result = true;
+
+        f1.Update(batchA, batchB, M, N, K, transB, compatibility);
+        f2.Update(batchA, batchB, M, N, K, transB, compatibility);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " .");
+
+        size_t batch = Simd::Max(batchA, batchB);
+        Tensor32f A(Shp(batchA, M, K));
+        Tensor32f B(transB ? Shp(batchB, N, K) : Shp(batchB, K, N));
+        Tensor32f C1(Shp(batch, M, N), SimdTensorFormatUnknown, 1.0f);
+        Tensor32f C2(Shp(batch, M, N), SimdTensorFormatUnknown, 2.0f);
+
+        FillRandom(A.Data(), A.Size(), -1.0, 1.0);
+        FillRandom(B.Data(), B.Size(), -1.0, 1.0);
+
+        void* context1 = f1.func(batchA, batchB, M, N, K, transB, compatibility);
+        void* context2 = f2.func(batchA, batchB, M, N, K, transB, compatibility);
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(context1, A.Data(), B.Data(), C1.Data()));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(context2, A.Data(), B.Data(), C2.Data()));
+
+        ::SimdRelease(context1);
+        ::SimdRelease(context2);
+
+        result = result && Compare(C1, C2, EPS, true, 64, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetMatMul32fForwardAutoTest(SimdSynetCompatibilityType c, const FuncMM& f1, const FuncMM& f2)
+    {
+        bool result = true;
+
+        result = result && SynetMatMul32fForwardAutoTest(1, 1, 127, 129, 131, SimdFalse, c, f1, f2);
+        result = result && SynetMatMul32fForwardAutoTest(12, 12, 197, 197, 64, SimdTrue, c, f1, f2);
+        result = result && SynetMatMul32fForwardAutoTest(12, 12, 197, 64, 197, SimdFalse, c, f1, f2);
+        result = result && SynetMatMul32fForwardAutoTest(8, 1, 128, 768, 768, SimdTrue, c, f1, f2);
+        result = result && SynetMatMul32fForwardAutoTest(1, 5, 33, 17, 65, SimdFalse, c, f1, f2);
+
+        return result;
+    }
+
+    bool SynetMatMul32fForwardAutoTest(const FuncMM& f1, const FuncMM& f2)
+    {
+        bool result = true;
+
+        result = result && SynetMatMul32fForwardAutoTest(SimdSynetCompatibilityDefault, f1, f2);
+        result = result && SynetMatMul32fForwardAutoTest(SimdSynetCompatibility16bfSoft, f1, f2);
+
+        return result;
+    }
+
+    bool SynetMatMul32fForwardAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetMatMul32fForwardAutoTest(FUNC_MM(Simd::Base::SynetMatMul32fInit), FUNC_MM(SimdSynetMatMul32fInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && SynetMatMul32fForwardAutoTest(FUNC_MM(Simd::Sse41::SynetMatMul32fInit), FUNC_MM(SimdSynetMatMul32fInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetMatMul32fForwardAutoTest(FUNC_MM(Simd::Avx2::SynetMatMul32fInit), FUNC_MM(SimdSynetMatMul32fInit));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetMatMul32fForwardAutoTest(FUNC_MM(Simd::Avx512bw::SynetMatMul32fInit), FUNC_MM(SimdSynetMatMul32fInit));
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && SynetMatMul32fForwardAutoTest(FUNC_MM(Simd::Neon::SynetMatMul32fInit), FUNC_MM(SimdSynetMatMul32fInit));
+#endif 
+
+        return result;
+    }
+#endif
+}
@@ -38,10 +38,11 @@ namespace Test
         struct Cnv
         {
             SimdConvolutionActivationType a;
-            Size k, s;
+            Size k, s, l;
             size_t d;
-            Cnv(SimdConvolutionActivationType a_, size_t k_, size_t s_, size_t d_ = - 1) : a(a_), k(k_, k_), s(s_, s_), d(d_) {}
-            Cnv(SimdConvolutionActivationType a_, Size k_, Size s_, size_t d_ = -1) : a(a_), k(k_), s(s_), d(d_) {}
+            Cnv(SimdConvolutionActivationType a_, size_t k_, size_t s_, size_t d_ = - 1) : a(a_), k(k_, k_), s(s_, s_), l(1, 1), d(d_) {}
+            Cnv(SimdConvolutionActivationType a_, Size k_, Size s_, size_t d_ = -1) : a(a_), k(k_), s(s_), l(1, 1), d(d_) {}
+            Cnv(SimdConvolutionActivationType a_, Size k_, Size s_, Size l_, size_t d_ = -1) : a(a_), k(k_), s(s_), l(l_), d(d_) {}
         };
 
         struct Param
@@ -81,18 +82,19 @@ namespace Test
                 conv[0].dstC = c.d == -1 ? conv[0].srcC : c.d;
                 conv[0].kernelY = c.k.y;
                 conv[0].kernelX = c.k.x;
-                conv[0].dilationY = 1;
-                conv[0].dilationX = 1;
+                conv[0].dilationY = c.l.y;
+                conv[0].dilationX = c.l.x;
                 conv[0].strideY = c.s.y;
                 conv[0].strideX = c.s.x;
-                conv[0].padY = c.s.y == 1 || (conv[0].srcH & 1) ? (c.k.y - 1) / 2 : (c.k.y - 1) / 2 - 1;
-                conv[0].padX = c.s.x == 1 || (conv[0].srcW & 1) ? (c.k.x - 1) / 2 : (c.k.x - 1) / 2 - 1;
-                conv[0].padH = (c.k.y - 1) / 2;
-                conv[0].padW = (c.k.x - 1) / 2;
+                size_t kY = (c.k.y - 1) * c.l.y + 1, kX = (c.k.x - 1) * c.l.x + 1;
+                conv[0].padY = c.s.y == 1 || (conv[0].srcH & 1) ? (kY - 1) / 2 : (kY - 1) / 2 - 1;
+                conv[0].padX = c.s.x == 1 || (conv[0].srcW & 1) ? (kX - 1) / 2 : (kX - 1) / 2 - 1;
+                conv[0].padH = (kY - 1) / 2;
+                conv[0].padW = (kX - 1) / 2;
                 conv[0].group = c.d == -1 ? conv[0].srcC : 1;
                 conv[0].activation = c.a;
-                conv[0].dstH = (conv[0].srcH + conv[0].padY + conv[0].padH - conv[0].kernelY) / conv[0].strideY + 1;
-                conv[0].dstW = (conv[0].srcW + conv[0].padX + conv[0].padW - conv[0].kernelX) / conv[0].strideX + 1;
+                conv[0].dstH = (conv[0].srcH + conv[0].padY + conv[0].padH - kY) / conv[0].strideY + 1;
+                conv[0].dstW = (conv[0].srcW + conv[0].padX + conv[0].padW - kX) / conv[0].strideX + 1;
                 conv[0].srcT = SimdTensorData32f;
                 conv[0].srcF = SimdTensorFormatNhwc;
                 conv[0].dstT = SimdTensorData32f;
@@ -115,7 +117,15 @@ namespace Test
                 ss << description;
                 ss << "[" << p.count << ":" << p.batch << "x" << p.conv[0].srcC << "x" << p.conv[0].srcH << "x" << p.conv[0].srcW;
                 for (size_t i = 0; i < p.count; ++i)
-                    ss << "-" << (p.conv[i].group != 1 ? String("") : ToString(p.conv[i].dstC) + "x") << p.conv[i].kernelY << "x" << p.conv[i].strideY;
+                {
+                    const SimdConvolutionParameters& cv = p.conv[i];
+                    ss << "-" << (cv.group != 1 ? String("") : ToString(cv.dstC) + "x") << cv.kernelY;
+                    if (cv.kernelX != cv.kernelY)
+                        ss << "_" << cv.kernelX;
+                    if (cv.dilationY != 1 || cv.dilationX != 1)
+                        ss << "d" << cv.dilationY;
+                    ss << "x" << cv.strideY;
+                }
                 ss << (Simd::Base::Bf16Soft(c) ? "-bf16" : "-fp32") << "]";
                 description = ss.str();
             }
@@ -294,6 +304,12 @@ namespace Test
         result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 1280, 12, 21), Cnv(a0, 1, 1, 256), Cnv(a1, 3, 2)), c, f1, f2);
         result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 48, 70, 81), Cnv(a0, 3, 2), Cnv(a1, 1, 1, 64)), c, f1, f2);
 #endif
+#if 1
+        result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 32, 33, 47), Cnv(a0, 1, 1, 64), Cnv(a1, Size(3, 3), Size(1, 1), Size(2, 2)), Cnv(a2, 1, 1, 32), f), c, f1, f2);
+        result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 48, 29, 31), Cnv(a0, 1, 1, 96), Cnv(a1, Size(3, 3), Size(1, 1), Size(4, 4)), Cnv(a2, 1, 1, 48), t), c, f1, f2);
+        result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 24, 29, 37), Cnv(a0, 1, 1, 40), Cnv(a1, Size(5, 3), Size(1, 1))), c, f1, f2);
+        result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 32, 30, 40), Cnv(a0, Size(3, 3), Size(2, 2), Size(3, 3)), Cnv(a1, 1, 1, 48)), c, f1, f2);
+#endif
 #if 0
         result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 64, 10, 6), Cnv(a0, 1, 1, 256), Cnv(a1, 3, 1), Cnv(a2, 1, 1, 64), t), c, f1, f2);
         result = result && SynetMergedConvolution32fForwardAutoTest(eps, Param(Shp(1, 256, 10, 6), Cnv(a0, 1, 1, 64), Cnv(a1, 3, 2), Cnv(a2, 1, 1, 256), f), c, f1, f2);
@@ -385,5 +401,168 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetMergedConvolution32fThreadsAutoTest(const Param& p)
+    {
+        bool result = true;
+
+        FuncMC f(SimdSynetMergedConvolution32fInit, "SimdSynetMergedConvolution32fForward");
+        f.Update(p, SimdSynetCompatibilityDefault);
+        TEST_LOG_SS(Info, "Test " << f.description << " by thread number.");
+
+        double flop = 0;
+        for (size_t i = 0; i < p.count; ++i)
+        {
+            const SimdConvolutionParameters& c = p.conv[i];
+            flop += double(p.batch) * c.dstH * c.dstW * c.dstC * c.kernelY * c.kernelX * c.srcC / c.group * 2;
+        }
+
+        Tensor32f src(Shp(p.batch, p.conv[0].srcH, p.conv[0].srcW, p.conv[0].srcC));
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+        Tensor32f weight[3], bias[3], params[3];
+        for (size_t i = 0; i < p.count; ++i)
+        {
+            weight[i].Reshape(Shp(p.conv[i].kernelY, p.conv[i].kernelX, p.conv[i].srcC / p.conv[i].group, p.conv[i].dstC));
+            FillRandom(weight[i].Data(), weight[i].Size(), -1.0, 1.0f);
+            p.weight[i] = weight[i].Data();
+            bias[i].Reshape(Shp(p.conv[i].dstC));
+            FillRandom(bias[i].Data(), bias[i].Size(), -1.0, 1.0f);
+            p.bias[i] = bias[i].Data();
+            params[i].Reshape(Shp(Simd::Max<size_t>(2, p.conv[i].dstC)));
+            params[i].Data()[0] = 0.0f + 0.1f * float(i);
+            params[i].Data()[1] = 1.0f + 0.1f * float(i);
+            p.params[i] = params[i].Data();
+        }
+
+        const SimdConvolutionParameters& end = p.conv[p.count - 1];
+        Tensor32f dst1(Shp(p.batch, end.dstH, end.dstW, end.dstC)), dst2(Shp(p.batch, end.dstH, end.dstW, end.dstC)), buf;
+
+        size_t threads = SimdGetThreadNumber();
+        for (size_t number = 1; number <= 8 && result; number *= 2)
+        {
+            SimdSetThreadNumber(number);
+            void* context = ::SimdSynetMergedConvolution32fInit(p.batch, p.conv, p.count, p.add, SimdSynetCompatibilityDefault);
+            if (context == NULL)
+            {
+                TEST_LOG_SS(Error, "Can't create merged convolution context!");
+                result = false;
+                break;
+            }
+            buf.Extend({ ::SimdSynetMergedConvolution32fExternalBufferSize(context) });
+            ::SimdSynetMergedConvolution32fSetParams(context, p.weight, NULL, p.bias, p.params);
+            Tensor32f& dst = number == 1 ? dst1 : dst2;
+            size_t count = 0;
+            double time = ExecuteForTime([&]() { f.Call(context, src, buf, dst, p.add); return true; }, count);
+            ::SimdRelease(context);
+            TEST_LOG_SS(Info, "Threads: " << number << ", speed: " << ToString(flop * count / time / 1000000000.0, 1, false) << " GFlops.");
+            if (number > 1)
+                result = result && Compare(dst1, dst2, 0.001f, true, 64, DifferenceBoth);
+        }
+        SimdSetThreadNumber(threads);
+
+        return result;
+    }
+
+    bool SynetMergedConvolution32fThreadsAutoTest()
+    {
+        bool result = true;
+
+        const SimdBool t = SimdTrue, f = SimdFalse;
+        const ::SimdConvolutionActivationType a0 = ::SimdConvolutionActivationRelu, a1 = ::SimdConvolutionActivationRestrictRange, a2 = ::SimdConvolutionActivationIdentity;
+
+        result = result && SynetMergedConvolution32fThreadsAutoTest(Param(Shp(1, 32, 112, 112), Cnv(a0, 1, 1, 192), Cnv(a1, 3, 1), Cnv(a2, 1, 1, 32), t));
+        result = result && SynetMergedConvolution32fThreadsAutoTest(Param(Shp(1, 64, 56, 56), Cnv(a0, 1, 1, 384), Cnv(a1, 3, 2), Cnv(a2, 1, 1, 96), f));
+        result = result && SynetMergedConvolution32fThreadsAutoTest(Param(Shp(1, 32, 112, 112), Cnv(a0, 1, 1, 96), Cnv(a1, 3, 1)));
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SynetMergedConvolution32fReshapeAutoTest(const Param& p1, const Param& p2)
+    {
+        bool result = true;
+
+        FuncMC f(SimdSynetMergedConvolution32fInit, "SimdSynetMergedConvolution32fReshape");
+        f.Update(p1, SimdSynetCompatibilityDefault);
+        TEST_LOG_SS(Info, "Test " << f.description << " -> " << p2.batch << "x" << p2.conv[0].srcH << "x" << p2.conv[0].srcW << ".");
+
+        Tensor32f src1(Shp(p1.batch, p1.conv[0].srcH, p1.conv[0].srcW, p1.conv[0].srcC));
+        Tensor32f src2(Shp(p2.batch, p2.conv[0].srcH, p2.conv[0].srcW, p2.conv[0].srcC));
+        FillRandom(src1.Data(), src1.Size(), -1.0, 1.0f);
+        FillRandom(src2.Data(), src2.Size(), -1.0, 1.0f);
+        Tensor32f weight[3], bias[3], params[3];
+        for (size_t i = 0; i < p1.count; ++i)
+        {
+            weight[i].Reshape(Shp(p1.conv[i].kernelY, p1.conv[i].kernelX, p1.conv[i].srcC / p1.conv[i].group, p1.conv[i].dstC));
+            FillRandom(weight[i].Data(), weight[i].Size(), -1.0, 1.0f);
+            p1.weight[i] = weight[i].Data();
+            bias[i].Reshape(Shp(p1.conv[i].dstC));
+            FillRandom(bias[i].Data(), bias[i].Size(), -1.0, 1.0f);
+            p1.bias[i] = bias[i].Data();
+            params[i].Reshape(Shp(Simd::Max<size_t>(2, p1.conv[i].dstC)));
+            params[i].Data()[0] = 0.0f + 0.1f * float(i);
+            params[i].Data()[1] = 1.0f + 0.1f * float(i);
+            p1.params[i] = params[i].Data();
+        }
+
+        const SimdConvolutionParameters& end1 = p1.conv[p1.count - 1], & end2 = p2.conv[p2.count - 1];
+        Tensor32f dst1(Shp(p1.batch, end1.dstH, end1.dstW, end1.dstC)), dst4(dst1.Shape());
+        Tensor32f dst2(Shp(p2.batch, end2.dstH, end2.dstW, end2.dstC)), dst3(dst2.Shape()), buf;
+
+        void* context1 = ::SimdSynetMergedConvolution32fInit(p1.batch, p1.conv, p1.count, p1.add, SimdSynetCompatibilityDefault);
+        ::SimdSynetMergedConvolution32fSetParams(context1, p1.weight, NULL, p1.bias, p1.params);
+        f.Call(context1, src1, buf, dst1, p1.add);
+        String desc = ::SimdSynetMergedConvolution32fInfo(context1);
+        bool expected = desc.find("-fp32") != String::npos;
+        bool reshaped = ::SimdSynetMergedConvolution32fReshape(context1, p2.batch, p2.conv[0].srcH, p2.conv[0].srcW) == SimdTrue;
+        if (reshaped != expected)
+        {
+            TEST_LOG_SS(Error, "Algorithm " << desc << (expected ? " must support" : " must not support") << " reshaping!");
+            result = false;
+        }
+        if (reshaped)
+        {
+            buf.Extend({ ::SimdSynetMergedConvolution32fExternalBufferSize(context1) });
+            f.Call(context1, src2, buf, dst2, p2.add);
+
+            void* context2 = ::SimdSynetMergedConvolution32fInit(p2.batch, p2.conv, p2.count, p2.add, SimdSynetCompatibilityDefault);
+            ::SimdSynetMergedConvolution32fSetParams(context2, p1.weight, NULL, p1.bias, p1.params);
+            buf.Extend({ ::SimdSynetMergedConvolution32fExternalBufferSize(context2) });
+            f.Call(context2, src2, buf, dst3, p2.add);
+            ::SimdRelease(context2);
+
+            result = result && Compare(dst2, dst3, 0.001f, true, 64, DifferenceBoth, "reshaped");
+        }
+        else
+        {
+            f.Call(context1, src1, buf, dst4, p1.add);
+            result = result && Compare(dst1, dst4, 0.0f, true, 64, DifferenceAbsolute, "unchanged");
+        }
+        ::SimdRelease(context1);
+
+        return result;
+    }
+
+    bool SynetMergedConvolution32fReshapeAutoTest()
+    {
+        bool result = true;
+
+        const SimdBool t = SimdTrue, f = SimdFalse;
+        const ::SimdConvolutionActivationType a0 = ::SimdConvolutionActivationRelu, a1 = ::SimdConvolutionActivationRestrictRange, a2 = ::SimdConvolutionActivationIdentity;
+
+        result = result && SynetMergedConvolution32fReshapeAutoTest(Param(Shp(1, 24, 40, 40), Cnv(a0, 1, 1, 144), Cnv(a1, 3, 1), Cnv(a2, 1, 1, 24), t),
+            Param(Shp(2, 24, 30, 52), Cnv(a0, 1, 1, 144), Cnv(a1, 3, 1), Cnv(a2, 1, 1, 24), t));
+        result = result && SynetMergedConvolution32fReshapeAutoTest(Param(Shp(1, 32, 48, 48), Cnv(a0, 1, 1, 192), Cnv(a1, 3, 2), Cnv(a2, 1, 1, 64), f),
+            Param(Shp(1, 32, 36, 64), Cnv(a0, 1, 1, 192), Cnv(a1, 3, 2), Cnv(a2, 1, 1, 64), f));
+        result = result && SynetMergedConvolution32fReshapeAutoTest(Param(Shp(1, 48, 35, 41), Cnv(a0, 3, 2), Cnv(a1, 1, 1, 64)),
+            Param(Shp(3, 48, 21, 27), Cnv(a0, 3, 2), Cnv(a1, 1, 1, 64)));
+        result = result && SynetMergedConvolution32fReshapeAutoTest(Param(Shp(1, 19, 32, 40), Cnv(a0, 1, 1, 51), Cnv(a1, 3, 1)),
+            Param(Shp(2, 19, 24, 30), Cnv(a0, 1, 1, 51), Cnv(a1, 3, 1)));
+
+        return result;
+    }
 #endif
 }
@@ -39,8 +39,10 @@ namespace Test
         struct Cnv
         {
             SimdConvolutionActivationType a;
-            size_t k, s, d;
-            Cnv(SimdConvolutionActivationType a_, size_t k_, size_t s_, size_t d_ = - 1) : a(a_), k(k_), s(s_), d(d_) {}
+            Size k;
+            size_t s, d, l;
+            Cnv(SimdConvolutionActivationType a_, size_t k_, size_t s_, size_t d_ = - 1, size_t l_ = 1) : a(a_), k(k_, k_), s(s_), d(d_), l(l_) {}
+            Cnv(SimdConvolutionActivationType a_, Size k_, size_t s_, size_t d_ = -1, size_t l_ = 1) : a(a_), k(k_), s(s_), d(d_), l(l_) {}
         };
 
         struct Param
@@ -83,20 +85,21 @@ namespace Test
                 conv[0].srcH = s.empty() ? conv[-1].dstH : s[2];
                 conv[0].srcW = s.empty() ? conv[-1].dstW : s[3];
                 conv[0].dstC = c.d == -1 ? conv[0].srcC : c.d;
-                conv[0].kernelY = c.k;
-                conv[0].kernelX = c.k;
-                conv[0].dilationY = 1;
-                conv[0].dilationX = 1;
+                conv[0].kernelY = c.k.y;
+                conv[0].kernelX = c.k.x;
+                conv[0].dilationY = c.l;
+                conv[0].dilationX = c.l;
                 conv[0].strideY = c.s;
                 conv[0].strideX = c.s;
-                conv[0].padY = c.s == 1 || (conv[0].srcH & 1) ? (c.k - 1) / 2 : (c.k - 1) / 2 - 1;
-                conv[0].padX = c.s == 1 || (conv[0].srcW & 1) ? (c.k - 1) / 2 : (c.k - 1) / 2 - 1;
-                conv[0].padH = (c.k - 1) / 2;
-                conv[0].padW = (c.k - 1) / 2;
+                size_t kY = (c.k.y - 1) * c.l + 1, kX = (c.k.x - 1) * c.l + 1;
+                conv[0].padY = c.s == 1 || (conv[0].srcH & 1) ? (kY - 1) / 2 : (kY - 1) / 2 - 1;
+                conv[0].padX = c.s == 1 || (conv[0].srcW & 1) ? (kX - 1) / 2 : (kX - 1) / 2 - 1;
+                conv[0].padH = (kY - 1) / 2;
+                conv[0].padW = (kX - 1) / 2;
                 conv[0].group = c.d == -1 ? conv[0].srcC : 1;
                 conv[0].activation = c.a;
-                conv[0].dstH = (conv[0].srcH + conv[0].padY + conv[0].padH - conv[0].kernelY) / conv[0].strideY + 1;
-                conv[0].dstW = (conv[0].srcW + conv[0].padX + conv[0].padW - conv[0].kernelX) / conv[0].strideX + 1;
+                conv[0].dstH = (conv[0].srcH + conv[0].padY + conv[0].padH - kY) / conv[0].strideY + 1;
+                conv[0].dstW = (conv[0].srcW + conv[0].padX + conv[0].padW - kX) / conv[0].strideX + 1;
                 conv[0].srcT = SimdTensorData32f;
                 conv[0].srcF = SimdTensorFormatNhwc;
                 conv[0].dstT = SimdTensorData32f;
@@ -119,7 +122,9 @@ namespace Test
                 ss << desc;
                 ss << "[" << p.count << ":" << p.batch << "x" << p.conv[0].srcC << "x" << p.conv[0].srcH << "x" << p.conv[0].srcW;
                 for (size_t i = 0; i < p.count; ++i)
-                    ss << "-" << (p.conv[i].group != 1 ? String("") : ToString(p.conv[i].dstC) + "x") << p.conv[i].kernelY << "x" << p.conv[i].strideY;
+                    ss << "-" << (p.conv[i].group != 1 ? String("") : ToString(p.conv[i].dstC) + "x") << p.conv[i].kernelY
+                        << (p.conv[i].kernelX != p.conv[i].kernelY ? "_" + ToString(p.conv[i].kernelX) : String(""))
+                        << (p.conv[i].dilationY != 1 ? "d" + ToString(p.conv[i].dilationY) : String("")) << "x" << p.conv[i].strideY;
                 ss << "-" << (p.conv[0].srcT == SimdTensorData32f ? "f" : "u") << (p.conv[p.count - 1].dstT == SimdTensorData32f ? "f" : "u");
                 ss << "-" << ((Simd::Base::Overflow(p.comp) ? "o" : Simd::Base::Narrowed(p.comp) ? "n" : "p")) << "]";
                 desc = ss.str();
@@ -315,6 +320,14 @@ namespace Test
         //result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 96, 16, 26), Cnv(a0, 1, 1, 576), Cnv(a1, 3, 1), Cnv(a2, 1, 1, 96), f32, f32, 1, n), f1, f2);
         result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 3, 320, 320), Cnv(a0, 3, 2, 16), Cnv(a1, 3, 1), Cnv(a2, 1, 1, 8), f32, u8, 1, n), f1, f2);
 #endif
+#if 1
+        result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 64, 33, 29), Cnv(a0, 1, 1, 128), Cnv(a1, 3, 1, -1, 2), Cnv(a2, 1, 1, 64), u8, u8, 1, n), f1, f2);
+        result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 32, 40, 23), Cnv(a0, 1, 1, 64), Cnv(a1, 3, 2, -1, 3), f32, u8, 1, n), f1, f2);
+        result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 64, 24, 20), Cnv(a0, 3, 1, -1, 4), Cnv(a1, 1, 1, 48), u8, f32, 0, o), f1, f2);
+        result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 48, 19, 27), Cnv(a0, 1, 1, 96), Cnv(a1, Size(5, 3), 1), Cnv(a2, 1, 1, 48), u8, u8, 1, n), f1, f2);
+        result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 32, 26, 22), Cnv(a0, 1, 1, 64), Cnv(a1, Size(3, 7), 2), f32, u8, 1, n), f1, f2);
+        result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 64, 20, 24), Cnv(a0, Size(7, 5), 1, -1, 2), Cnv(a1, 1, 1, 32), u8, f32, 0, o), f1, f2);
+#endif
 #if 0
         result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 64, 8, 32), Cnv(a0, 1, 1, 32), Cnv(a1, 3, 1), u8, u8, 1, n), f1, f2);
         result = result && SynetMergedConvolution8iForwardAutoTest(eps, Param(Shp(1, 128, 8, 32), Cnv(a0, 1, 1, 60), Cnv(a1, 3, 1), u8, u8, 1, n), f1, f2);
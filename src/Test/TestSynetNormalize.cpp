@@ -263,5 +263,192 @@ namespace Test
         return result;
     }
 
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct FuncLN32f
+    {
+        typedef void(*FuncPtr)(const float* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, float* dst);
+
+        FuncPtr func;
+        String desc;
+
+        FuncLN32f(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+        void Update(size_t outer, size_t size)
+        {
+            desc = desc + "[" + ToString(outer) + "x" + ToString(size) + "]";
+        }
+
+        void Call(const Tensor32f& src, size_t outer, size_t size, const Tensor32f& scale, const Tensor32f& shift, float eps, Tensor32f& dst) const
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            func(src.Data(), outer, size, scale.Data(), shift.Data(), &eps, dst.Data());
+        }
+    };
+
+#define FUNC_LN32F(function) FuncLN32f(function, #function)
+
+    bool SynetLayerNorm32fAutoTest(size_t outer, size_t size, FuncLN32f f1, FuncLN32f f2)
+    {
+        bool result = true;
+
+        f1.Update(outer, size);
+        f2.Update(outer, size);
+
+        const float eps = 0.00001f;
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << outer << ", " << size << "].");
+
+        Tensor32f src(Shp(outer, size));
+        Tensor32f scale(Shp(size));
+        Tensor32f shift(Shp(size));
+        Tensor32f dst1(Shp(outer, size));
+        Tensor32f dst2(Shp(outer, size));
+
+        FillRandom(src.Data(), src.Size(), -10.0, 10.0);
+        FillRandom(scale.Data(), scale.Size(), -10.0, 10.0);
+        FillRandom(shift.Data(), shift.Size(), -10.0, 10.0);
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, outer, size, scale, shift, eps, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, outer, size, scale, shift, eps, dst2));
+
+        result = result && Compare(dst1, dst2, EPS, true, 32, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetLayerNorm32fAutoTest(const FuncLN32f& f1, const FuncLN32f& f2)
+    {
+        bool result = true;
+
+        result = result && SynetLayerNorm32fAutoTest(197, 768, f1, f2);
+        result = result && SynetLayerNorm32fAutoTest(64, 1024, f1, f2);
+        result = result && SynetLayerNorm32fAutoTest(15, 333, f1, f2);
+
+        return result;
+    }
+
+    bool SynetLayerNorm32fAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetLayerNorm32fAutoTest(FUNC_LN32F(Simd::Base::SynetLayerNorm32f), FUNC_LN32F(SimdSynetLayerNorm32f));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && SynetLayerNorm32fAutoTest(FUNC_LN32F(Simd::Sse41::SynetLayerNorm32f), FUNC_LN32F(SimdSynetLayerNorm32f));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetLayerNorm32fAutoTest(FUNC_LN32F(Simd::Avx2::SynetLayerNorm32f), FUNC_LN32F(SimdSynetLayerNorm32f));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetLayerNorm32fAutoTest(FUNC_LN32F(Simd::Avx512bw::SynetLayerNorm32f), FUNC_LN32F(SimdSynetLayerNorm32f));
+#endif 
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct FuncLN16b
+    {
+        typedef void(*FuncPtr)(const uint16_t* src, size_t outer, size_t size, const float* scale, const float* shift, const float* eps, uint16_t* dst);
+
+        FuncPtr func;
+        String desc;
+
+        FuncLN16b(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+        void Update(size_t outer, size_t size)
+        {
+            desc = desc + "[" + ToString(outer) + "x" + ToString(size) + "]";
+        }
+
+        void Call(const Tensor16u& src, size_t outer, size_t size, const Tensor32f& scale, const Tensor32f& shift, float eps, Tensor16u& dst) const
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            func(src.Data(), outer, size, scale.Data(), shift.Data(), &eps, dst.Data());
+        }
+    };
+
+#define FUNC_LN16B(function) FuncLN16b(function, #function)
+
+    bool SynetLayerNorm16bAutoTest(size_t outer, size_t size, FuncLN16b f1, FuncLN16b f2)
+    {
+        bool result = true;
+
+        f1.Update(outer, size);
+        f2.Update(outer, size);
+
+        const float eps = 0.00001f;
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc << " [" << outer << ", " << size << "].");
+
+        Tensor32f src32f(Shp(outer, size));
+        Tensor16u src(Shp(outer, size));
+        Tensor32f scale(Shp(size));
+        Tensor32f shift(Shp(size));
+        Tensor16u dst1(Shp(outer, size));
+        Tensor16u dst2(Shp(outer, size));
+        Tensor32f dst1f(Shp(outer, size));
+        Tensor32f dst2f(Shp(outer, size));
+
+        FillRandom(src32f.Data(), src32f.Size(), -10.0, 10.0);
+        FillRandom(scale.Data(), scale.Size(), -10.0, 10.0);
+        FillRandom(shift.Data(), shift.Size(), -10.0, 10.0);
+        SimdFloat32ToBFloat16(src32f.Data(), src32f.Size(), src.Data());
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, outer, size, scale, shift, eps, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, outer, size, scale, shift, eps, dst2));
+
+        SimdBFloat16ToFloat32(dst1.Data(), dst1.Size(), dst1f.Data());
+        SimdBFloat16ToFloat32(dst2.Data(), dst2.Size(), dst2f.Data());
+
+        result = result && Compare(dst1f, dst2f, 0.01f, true, 32, DifferenceBoth);
+
+        return result;
+    }
+
+    bool SynetLayerNorm16bAutoTest(const FuncLN16b& f1, const FuncLN16b& f2)
+    {
+        bool result = true;
+
+        result = result && SynetLayerNorm16bAutoTest(197, 768, f1, f2);
+        result = result && SynetLayerNorm16bAutoTest(15, 333, f1, f2);
+
+        return result;
+    }
+
+    bool SynetLayerNorm16bAutoTest()
+    {
+        bool result = true;
+
+        result = result && SynetLayerNorm16bAutoTest(FUNC_LN16B(Simd::Base::SynetLayerNorm16b), FUNC_LN16B(SimdSynetLayerNorm16b));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && SynetLayerNorm16bAutoTest(FUNC_LN16B(Simd::Sse41::SynetLayerNorm16b), FUNC_LN16B(SimdSynetLayerNorm16b));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && SynetLayerNorm16bAutoTest(FUNC_LN16B(Simd::Avx2::SynetLayerNorm16b), FUNC_LN16B(SimdSynetLayerNorm16b));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && SynetLayerNorm16bAutoTest(FUNC_LN16B(Simd::Avx512bw::SynetLayerNorm16b), FUNC_LN16B(SimdSynetLayerNorm16b));
+#endif 
+
+        return result;
+    }
+
 #endif
 }